@@ -26,7 +26,7 @@ function build {
     # Compile the Library
     make -j $(if [ "$(uname -s)" = "Darwin" ]; then sysctl -n hw.ncpu; else nproc; fi) SvtAv1EncApp SvtAv1DecApp
     if [ "$2" = "test" ]; then    
-        make -j $(if [ "$(uname -s)" = "Darwin" ]; then sysctl -n hw.ncpu; else nproc; fi) SvtAv1UnitTests SvtAv1ApiTests SvtAv1E2ETests
+        make -j $(if [ "$(uname -s)" = "Darwin" ]; then sysctl -n hw.ncpu; else nproc; fi) SvtAv1UnitTests SvtAv1ApiTests SvtAv1E2ETests SvtAv1KernelBench
         # Copy test conformance dependency
         if [ "$(uname -s)" = "Darwin" ]; then
             cp ../../../third_party/aom/lib/mac/*.dylib ../../../Bin/$build_type/
@@ -20,13 +20,142 @@ extern "C" {
 #define EB_HME_SEARCH_AREA_ROW_MAX_COUNT            2
 
 #define MAX_ENC_PRESET                              8
+#define EB_INPUT_BUFFER_BORDER                      68 // luma border required around zero-copy input pictures
 
 #define EB_BUFFERFLAG_EOS           0x00000001  // signals the last packet of the stream
 #define EB_BUFFERFLAG_SHOW_EXT      0x00000002  // signals that the packet contains a show existing frame at the end
 #define EB_BUFFERFLAG_HAS_TD        0x00000004  // signals that the packet contains a show existing frame at the end
+#define EB_BUFFERFLAG_PASS_STATS    0x00000008  // signals that the packet contains first pass statistics, not a bitstream
+#define EB_BUFFERFLAG_LAST_FRAGMENT 0x00000010  // signals the packet that completes a picture, see tile_group_output
 
 // Will contain the EbEncApi which will live in the EncHandle class
 // Only modifiable during config-time.
+/* Encoder pipeline stages, in pipeline order. */
+typedef enum EbPipelineStage
+{
+    EB_STAGE_RESOURCE_COORDINATION = 0,
+    EB_STAGE_PICTURE_ANALYSIS,
+    EB_STAGE_PICTURE_DECISION,
+    EB_STAGE_MOTION_ESTIMATION,
+    EB_STAGE_INITIAL_RATE_CONTROL,
+    EB_STAGE_SOURCE_BASED_OPERATIONS,
+    EB_STAGE_PICTURE_MANAGER,
+    EB_STAGE_RATE_CONTROL,
+    EB_STAGE_MODE_DECISION_CONFIGURATION,
+    EB_STAGE_ENC_DEC,
+    EB_STAGE_DLF,
+    EB_STAGE_CDEF,
+    EB_STAGE_REST,
+    EB_STAGE_ENTROPY_CODING,
+    EB_STAGE_PACKETIZATION,
+    EB_PIPELINE_STAGE_COUNT
+} EbPipelineStage;
+
+/* Histogram bin i counts durations in [2^i, 2^(i+1)) microseconds, bin 0
+ * also counts shorter ones and the last bin counts all longer ones. */
+#define EB_LATENCY_HISTOGRAM_BIN_COUNT  24
+
+typedef struct EbPipelineStageStats
+{
+    uint32_t                 thread_count;          // kernel threads of the stage
+    uint64_t                 task_count;            // objects taken from the input queue
+    uint64_t                 busy_time_us;          // summed over the threads
+    uint64_t                 max_task_time_us;
+    uint64_t                 task_time_histogram[EB_LATENCY_HISTOGRAM_BIN_COUNT];
+    uint32_t                 queue_depth;           // objects waiting in the input queue now
+    uint32_t                 max_queue_depth;       // largest backlog seen when a task started
+} EbPipelineStageStats;
+
+typedef struct EbSvtAv1EncStats
+{
+    uint64_t                 elapsed_time_us;       // since eb_init_encoder()
+    uint64_t                 picture_count;         // pictures output by Packetization
+    uint64_t                 max_picture_latency_us;
+    uint64_t                 picture_latency_histogram[EB_LATENCY_HISTOGRAM_BIN_COUNT];
+    EbPipelineStageStats     stage[EB_PIPELINE_STAGE_COUNT];
+} EbSvtAv1EncStats;
+
+// Scheduling of the encoder kernel threads
+typedef enum EbThreadPolicy
+{
+    EB_THREAD_POLICY_NORMAL   = 0,  // OS default scheduling, priority is ignored
+    EB_THREAD_POLICY_NICE     = 1,  // default scheduling with priority as nice value [-20, 19]
+    EB_THREAD_POLICY_REALTIME = 2   // SCHED_FIFO with priority [1, 99]
+} EbThreadPolicy;
+
+typedef struct EbThreadPriority
+{
+    EbThreadPolicy           policy;
+    int32_t                  priority;
+} EbThreadPriority;
+
+typedef struct EbStageThreadPriority
+{
+    EbThreadPriority         requested;
+    EbThreadPriority         applied;               // requested, or as set by the first thread of the stage that fell short of it
+} EbStageThreadPriority;
+
+// Allocations of an encoder instance, grouped by what they belong to
+typedef enum EbMemoryCategory
+{
+    EB_MEMORY_SEQUENCE_CONTROL_SET = 0,
+    EB_MEMORY_PICTURE_CONTROL_SET_PARENT,
+    EB_MEMORY_PICTURE_CONTROL_SET,
+    EB_MEMORY_REFERENCE_PICTURES,
+    EB_MEMORY_PA_REFERENCE_PICTURES,
+    EB_MEMORY_INPUT_OUTPUT_BUFFERS,       // input, output stream and recon buffers
+    EB_MEMORY_PIPELINE_QUEUES,            // inter-kernel result and task fifos
+    EB_MEMORY_KERNEL_CONTEXTS,            // per-thread contexts
+    EB_MEMORY_OTHER,
+    EB_MEMORY_CATEGORY_COUNT
+} EbMemoryCategory;
+
+typedef struct EbMemoryUsage
+{
+    uint64_t                 total_bytes;
+    uint64_t                 category_bytes[EB_MEMORY_CATEGORY_COUNT];
+    uint32_t                 category_allocation_count[EB_MEMORY_CATEGORY_COUNT];
+} EbMemoryUsage;
+
+// Worker pool shared by several encoders of a process, see eb_svt_host_context_create()
+typedef struct EbSvtHostContext EbSvtHostContext;
+
+#define EB_HOST_DEFAULT_WEIGHT      100
+#define EB_HOST_MAX_WEIGHT          10000
+
+typedef struct EbSvtHostConfiguration
+{
+    /* Kernel threads of all the attached encoders allowed to run at once.
+     *
+     * 0 = the number of logical processors. */
+    uint32_t                 worker_count;
+
+    /* Number of encoders expected to attach. Each one then creates the kernel
+     * threads of twice its weighted share of worker_count, enough to take over
+     * the workers the others leave idle, instead of threads for the whole pool.
+     *
+     * 0 = every encoder creates threads for the whole pool. */
+    uint32_t                 channel_count;
+
+    /* Kernel threads all the attached encoders may create. Every encoder needs
+     * at least one thread per pipeline stage; eb_init_encoder() fails with
+     * EB_ErrorInsufficientResources when the threads of an encoder would go
+     * over the limit.
+     *
+     * 0 = twice worker_count, plus one thread per stage for each of the
+     * channel_count encoders. */
+    uint32_t                 max_thread_count;
+} EbSvtHostConfiguration;
+
+// Instruction set of a kernel implementation, see eb_svt_kernel_override()
+typedef enum EbKernelIsa
+{
+    EB_KERNEL_ISA_C,
+    EB_KERNEL_ISA_SSE,                    // SSE2 to SSE4.2 and AVX
+    EB_KERNEL_ISA_AVX2,
+    EB_KERNEL_ISA_COUNT
+} EbKernelIsa;
+
 typedef struct EbSvtAv1EncConfiguration
 {
     // Encoding preset
@@ -207,6 +336,24 @@ typedef struct EbSvtAv1EncConfiguration
      * Default is 0. */
     EbBool                   disable_dlf_flag;
 
+    /* Run the in-loop filters by superblock rows: deblocking of a row is done
+     * in Encode Decode and the CDEF search starts once the rows below it are
+     * deblocked, instead of waiting for the whole picture at each stage. The
+     * pictures whose deblocking level is searched on the full picture are
+     * still filtered one picture at a time.
+     *
+     * Default is 0. */
+    EbBool                   filter_row_pipeline;
+
+    /* Start Encode Decode of a picture as soon as the superblock rows of the
+     * reference coded last that its motion vectors can reach are final,
+     * instead of waiting for this reference to be complete. The vertical
+     * motion vectors into it are limited so that the encoded stream does not
+     * depend on the timing.
+     *
+     * Default is 0. */
+    EbBool                   inter_picture_wavefront;
+
     /* Denoise the input picture when noise levels are too high
     * Flag to enable the denoising
     *
@@ -296,6 +443,18 @@ typedef struct EbSvtAv1EncConfiguration
      *
      * Default is 0. */
     uint32_t                 min_qp_allowed;
+    /* Two pass encoding.
+     *
+     * 0 = Single pass.
+     * 1 = First pass: motion estimation only, the output packets carry the
+     *     statistics of each picture (EB_BUFFERFLAG_PASS_STATS) instead of a
+     *     bitstream. Rate control is off.
+     * 2 = Second pass: the statistics of the first pass, given through
+     *     eb_svt_enc_set_pass_stats(), spread the bit rate across the
+     *     pictures. Only used with rate control mode 2 (VBR).
+     *
+     * Default is 0. */
+    uint32_t                 pass;
     /* Flag to signal the content being a screen sharing content type
     *
     * Default is 2. */
@@ -371,6 +530,59 @@ typedef struct EbSvtAv1EncConfiguration
      * Default is -1. */
     int32_t                 target_socket;
 
+    /* Split one budget of logical_processors threads between the stages with
+     * fixed per-stage weights, instead of sizing every stage independently
+     * from the core count. Each stage still runs its own threads, which are
+     * not shared with the other stages. Reduces the number of idle threads and
+     * per-thread contexts on many-core systems.
+     *
+     * Default is 0. */
+    EbBool                  unified_thread_pool;
+
+    /* Scheduling policy of the kernel threads, see EbThreadPolicy.
+     *
+     * Default is 0 (EB_THREAD_POLICY_NORMAL). */
+    uint32_t                thread_policy;
+
+    /* Nice value [-20, 19] for EB_THREAD_POLICY_NICE, priority [1, 99] for
+     * EB_THREAD_POLICY_REALTIME. Without CAP_SYS_NICE a request above what
+     * RLIMIT_NICE / RLIMIT_RTPRIO grant is lowered to that limit, and the
+     * threads keep the default scheduling if nothing is granted. The result
+     * is reported by eb_svt_enc_get_thread_priority().
+     *
+     * Default is 0. */
+    int32_t                 thread_priority;
+
+    /* Per-stage priority boost [-99, 99], indexed by EbPipelineStage. A
+     * positive boost is subtracted from the nice value or added to the
+     * real-time priority, e.g. to let EntropyCoding and Packetization outrank
+     * the look-ahead analysis. The result is clamped to the policy range.
+     *
+     * Default is 0 for all stages. */
+    int32_t                 stage_priority_boost[EB_PIPELINE_STAGE_COUNT];
+
+    /* NUMA placement of the large buffers (picture pools, per-thread
+     * contexts), Linux only. Smaller allocations follow first touch.
+     *
+     * 0 = OS default (first touch).
+     * 1 = Bind to the NUMA node(s) of target_socket, which must be set. With
+     *     the threads already bound to that socket, the whole encoder instance
+     *     stays on one node.
+     * 2 = Interleave across the NUMA nodes of all sockets, for instances
+     *     running on both sockets.
+     *
+     * Default is 0. */
+    uint32_t                numa_memory_policy;
+
+    /* Size the per-picture and per-superblock arrays and the inter-kernel
+     * queues from the source resolution and superblock size instead of the
+     * largest supported picture, for many low resolution instances per host.
+     * The resulting footprint is logged at init and reported by
+     * eb_svt_enc_get_memory_usage().
+     *
+     * Default is 0. */
+    EbBool                  low_memory;
+
     // Debug tools
 
     /* Output reconstructed yuv used for debug purposes. The value is set through
@@ -378,12 +590,33 @@ typedef struct EbSvtAv1EncConfiguration
      *
      * Default is 0. */
     uint32_t                 recon_enabled;
+
+    /* Collect per-stage pipeline statistics, read through eb_svt_enc_get_stats().
+     *
+     * 0 = OFF.
+     * 1 = Task time and queue depth counters per kernel.
+     * 2 = Counters and a trace of the latest tasks, written by
+     *     eb_svt_enc_write_trace().
+     *
+     * Default is 0. */
+    uint32_t                 pipeline_stats;
 #if TILES
     /* Log 2 Tile Rows and colums . 0 means no tiling,1 means that we split the dimension
         * into 2
         * Default is 0. */
     int32_t                  tile_columns;
     int32_t                  tile_rows;
+
+    /* Output the tiles of a picture as soon as they are entropy coded, as
+     * OBU_TILE_GROUP packets after the frame header, instead of one packet
+     * per picture. The packet that completes a picture carries
+     * EB_BUFFERFLAG_LAST_FRAGMENT. Tiles are only output once the previous
+     * pictures in decode order are complete. The tiles are entropy coded
+     * after the in-loop filters of the whole picture, so only the entropy
+     * coding and packetization of the later tiles are saved on the latency.
+     *
+     * Default is 0. */
+    EbBool                   tile_group_output;
 #endif
 
 /* To be deprecated.
@@ -439,6 +672,34 @@ typedef struct EbSvtAv1EncConfiguration
         void* p_app_data,
         EbSvtAv1EncConfiguration  *config_ptr); // config_ptr will be loaded with default params from the library
 
+    /* OPTIONAL: Create a host context. The encoders attached to it share
+     * worker_count workers: a kernel thread runs only while it holds one, and
+     * gives it back at the end of each task or when it blocks. A freed worker
+     * goes to the encoder that used the least worker time relative to its
+     * weight.
+     *
+     * Parameter:
+     * @ **host_context      Created host context.
+     * @ *config_ptr         Host configuration. */
+    EB_API EbErrorType eb_svt_host_context_create(
+        EbSvtHostContext               **host_context,
+        const EbSvtHostConfiguration    *config_ptr);
+
+    /* OPTIONAL: Attach the encoder to a host context. Must be called after
+     * eb_init_handle() and before eb_svt_enc_set_parameter(). The kernel threads
+     * are then sized from the host, see EbSvtHostConfiguration, and split
+     * between the stages as with unified_thread_pool.
+     *
+     * Parameter:
+     * @ *svt_enc_component  Encoder handler.
+     * @ *host_context       Host context.
+     * @ weight              Share of the workers [1, EB_HOST_MAX_WEIGHT], relative
+     *                       to EB_HOST_DEFAULT_WEIGHT. */
+    EB_API EbErrorType eb_svt_enc_attach_host_context(
+        EbComponentType         *svt_enc_component,
+        EbSvtHostContext        *host_context,
+        uint32_t                 weight);
+
     /* STEP 2: Set all configuration parameters.
      *
      * Parameter:
@@ -448,6 +709,63 @@ typedef struct EbSvtAv1EncConfiguration
         EbComponentType           *svt_enc_component,
         EbSvtAv1EncConfiguration   *pComponentParameterStructure); // pComponentParameterStructure contents will be copied to the library
 
+    /* OPTIONAL: Change the rate, GOP or resolution of a running encoder, after
+     * eb_init_encoder(). Only the fields below are read, the others are ignored.
+     *
+     * - target_bit_rate: used from the next picture sent (rate_control_mode 1..3).
+     * - intra_period_length: used from the next key frame, or right away when
+     *   there was none (-1). Only with rate_control_mode 0, the rate control
+     *   intervals are laid out from the first picture.
+     * - source_width, source_height: pictures sent from now on have this size,
+     *   the first one is encoded as a key frame starting a new sequence. The
+     *   size must be a multiple of 8, at least 64 and at most the size given to
+     *   eb_svt_enc_set_parameter(), which sizes the buffers and must be a
+     *   multiple of 8 too. Not supported with film grain denoising or two-pass
+     *   encoding. Resolution changes should be spaced by more than
+     *   look_ahead_distance pictures, the encoder holds a few sequence control
+     *   sets only.
+     *
+     * Parameter:
+     * @ *svt_enc_component              Encoder handler.
+     * @ *pComponentParameterStructure  New configuration. */
+    EB_API EbErrorType eb_svt_enc_reconfigure(
+        EbComponentType           *svt_enc_component,
+        EbSvtAv1EncConfiguration   *pComponentParameterStructure);
+
+    /* OPTIONAL: Make the encoder a rendition of an ABR ladder led by another
+     * encoder of the same source, e.g. at a higher resolution or rate. The
+     * rendition then cuts scenes where the leader detects them instead of
+     * running its own scene change detection, so all the renditions share
+     * their key frames and GOP structure. Only the scene change decisions are
+     * shared: each rendition still runs picture analysis, decimation and
+     * motion estimation on its own input. Must be called after
+     * eb_svt_enc_set_parameter() of both encoders and before any picture is
+     * sent to either. The leader needs scene_change_detection, and the
+     * rendition its intra_period_length, intra_refresh_type,
+     * hierarchical_levels and pred_structure. A rendition waits for the
+     * leader to decide each picture, so the leader must be sent every
+     * picture no later than its renditions, and deinitialized last.
+     *
+     * Parameter:
+     * @ *svt_enc_component  Encoder handler of the rendition.
+     * @ *leader_component   Encoder handler of the leader. */
+    EB_API EbErrorType eb_svt_enc_attach_ladder(
+        EbComponentType           *svt_enc_component,
+        EbComponentType           *leader_component);
+
+    /* OPTIONAL: Give the statistics of a first pass to a second pass (pass 2),
+     * before eb_init_encoder(). They are the concatenated payloads of the
+     * EB_BUFFERFLAG_PASS_STATS packets of the first pass, over the same input.
+     *
+     * Parameter:
+     * @ *svt_enc_component  Encoder handler.
+     * @ *stats              First pass statistics, read by eb_init_encoder().
+     * @ size                Size of the statistics in bytes. */
+    EB_API EbErrorType eb_svt_enc_set_pass_stats(
+        EbComponentType           *svt_enc_component,
+        const uint8_t             *stats,
+        uint64_t                   size);
+
     /* STEP 3: Initialize encoder and allocates memory to necessary buffers.
      *
      * Parameter:
@@ -473,6 +791,35 @@ typedef struct EbSvtAv1EncConfiguration
         EbComponentType           *svt_enc_component,
         EbBufferHeaderType       **output_stream_ptr);
 
+    /* Callback returning an input picture to the application once the
+     * library no longer references its planes (zero-copy input mode).
+     *
+     * Parameter:
+     * @ *input_buffer       Header that was passed to eb_svt_enc_send_picture().
+     * @ *priv_data          Private data given to eb_svt_enc_set_input_buffer_callbacks(). */
+    typedef void (*eb_release_input_buffer)(
+        EbBufferHeaderType  *input_buffer,
+        void                *priv_data);
+
+    /* OPTIONAL: Enable zero-copy input. Must be called before eb_init_encoder().
+     *
+     * 8-bit pictures are then read in place instead of being copied into the
+     * library pool. Each EbSvtIOFormat plane must be surrounded by a writable
+     * border of at least EB_INPUT_BUFFER_BORDER luma samples (half that for
+     * chroma) beyond the picture size rounded up to a multiple of 8, the
+     * library pads and may filter the picture inside that area. The header
+     * and its planes must stay valid until release_buffer is called for it.
+     * 10-bit pictures are still copied and are returned right away.
+     *
+     * Parameter:
+     * @ *svt_enc_component  Encoder handler.
+     * @ release_buffer      Callback function to return an input picture.
+     * @ priv_data           Private data passed to release_buffer. */
+    EB_API EbErrorType eb_svt_enc_set_input_buffer_callbacks(
+        EbComponentType             *svt_enc_component,
+        eb_release_input_buffer      release_buffer,
+        void                        *priv_data);
+
     /* STEP 4: Send the picture.
      *
      * Parameter:
@@ -487,6 +834,7 @@ typedef struct EbSvtAv1EncConfiguration
     * @ *svt_enc_component  Encoder handler.
      * @ **p_buffer          Header pointer to return packet with.
      * @ pic_send_done       Flag to signal that all input pictures have been sent, this call becomes locking one this signal is 1.
+     *                       An application reading the packets from its own thread can always set it, to wait for the next packet.
      * Non-locking call, returns EB_ErrorMax for an encode error, EB_NoErrorEmptyQueue when the library does not have any available packets.*/
     EB_API EbErrorType eb_svt_get_packet(
         EbComponentType      *svt_enc_component,
@@ -509,6 +857,45 @@ typedef struct EbSvtAv1EncConfiguration
         EbComponentType      *svt_enc_component,
         EbBufferHeaderType   *p_buffer);
 
+    /* OPTIONAL: Read the pipeline statistics, pipeline_stats must be set.
+     * Can be called at any time after eb_init_encoder().
+     *
+     * Parameter:
+     * @ *svt_enc_component  Encoder handler.
+     * @ *stats              Filled with a snapshot of the statistics. */
+    EB_API EbErrorType eb_svt_enc_get_stats(
+        EbComponentType      *svt_enc_component,
+        EbSvtAv1EncStats     *stats);
+
+    /* OPTIONAL: Read the scheduling requested for and applied by the kernel
+     * threads of every stage. Can be called after eb_init_encoder().
+     *
+     * Parameter:
+     * @ *svt_enc_component       Encoder handler.
+     * @ *stage_priority_array    EB_PIPELINE_STAGE_COUNT entries, indexed by EbPipelineStage. */
+    EB_API EbErrorType eb_svt_enc_get_thread_priority(
+        EbComponentType         *svt_enc_component,
+        EbStageThreadPriority   *stage_priority_array);
+
+    /* OPTIONAL: Read the memory allocated by eb_init_encoder(), per category.
+     *
+     * Parameter:
+     * @ *svt_enc_component  Encoder handler.
+     * @ *memory_usage       Filled with the allocated bytes. */
+    EB_API EbErrorType eb_svt_enc_get_memory_usage(
+        EbComponentType      *svt_enc_component,
+        EbMemoryUsage        *memory_usage);
+
+    /* OPTIONAL: Write the latest kernel tasks as a Chrome trace (JSON), viewable
+     * in chrome://tracing or Perfetto. pipeline_stats must be 2.
+     *
+     * Parameter:
+     * @ *svt_enc_component  Encoder handler.
+     * @ *file_name          Output file. */
+    EB_API EbErrorType eb_svt_enc_write_trace(
+        EbComponentType      *svt_enc_component,
+        const char           *file_name);
+
     /* STEP 6: Deinitialize encoder library.
      *
      * Parameter:
@@ -523,6 +910,52 @@ typedef struct EbSvtAv1EncConfiguration
     EB_API EbErrorType eb_deinit_handle(
         EbComponentType  *svt_enc_component);
 
+    /* OPTIONAL: Destroy a host context, once all its encoders are
+     * deinitialized.
+     *
+     * Parameter:
+     * @ *host_context       Host context. */
+    EB_API EbErrorType eb_svt_host_context_destroy(
+        EbSvtHostContext        *host_context);
+
+    /* OPTIONAL: Kernel dispatch. The kernel implementations are chosen once per
+     * process, by the first call to eb_init_encoder() or to the functions below,
+     * and shared read-only by all the encoders: an encoder initialized later
+     * with another asm_type runs on the same implementations. */
+
+    /* Name of the index-th dispatched kernel, NULL past the last one.
+     *
+     * Parameter:
+     * @ index               Kernel index, from 0. */
+    EB_API const char *eb_svt_kernel_name(
+        uint32_t                 index);
+
+    /* Get the implementation a kernel runs.
+     *
+     * Parameter:
+     * @ *kernel_name        Kernel name, see eb_svt_kernel_name().
+     * @ *isa_ptr            Instruction set of the implementation in use.
+     * @ *available_mask     Bit (1 << isa) set for each instruction set the
+     *                       kernel has an implementation for, may be NULL. */
+    EB_API EbErrorType eb_svt_kernel_query(
+        const char              *kernel_name,
+        EbKernelIsa             *isa_ptr,
+        uint32_t                *available_mask);
+
+    /* Switch a kernel to its implementation for an instruction set, for all the
+     * encoders of the process initialized afterwards with the same asm_type.
+     * Returns EB_ErrorUndefined while an encoder is initialized: call it before
+     * eb_init_encoder() or once every encoder is deinitialized. Fails with
+     * EB_ErrorBadParameter if the kernel has no implementation for isa or if
+     * the CPU does not support isa.
+     *
+     * Parameter:
+     * @ *kernel_name        Kernel name, see eb_svt_kernel_name().
+     * @ isa                 Instruction set of the implementation to use. */
+    EB_API EbErrorType eb_svt_kernel_override(
+        const char              *kernel_name,
+        EbKernelIsa              isa);
+
 #ifdef __cplusplus
 }
 #endif // __cplusplus
@@ -9,6 +9,7 @@
 
 #include "EbAppConfig.h"
 #include "EbAppInputy4m.h"
+#include "EbAppInputReader.h"
 
 #ifdef _WIN32
 #else
@@ -31,6 +32,9 @@
 #define HEIGHT_TOKEN                    "-h"
 #define NUMBER_OF_PICTURES_TOKEN        "-n"
 #define BUFFERED_INPUT_TOKEN            "-nb"
+#define INPUT_READER_TOKEN              "-input-reader"
+#define IO_BENCH_TOKEN                  "-io-bench"
+#define ASYNC_IO_TOKEN                  "-async-io"
 #define BASE_LAYER_SWITCH_MODE_TOKEN    "-base-layer-switch-mode" // no Eval
 #define QP_TOKEN                        "-q"
 #define USE_QP_FILE_TOKEN               "-use-q-file"
@@ -53,6 +57,8 @@
 #define SEPERATE_FILDS_TOKEN            "-separate-fields"
 #define INTRA_REFRESH_TYPE_TOKEN        "-irefresh-type" // no Eval
 #define LOOP_FILTER_DISABLE_TOKEN       "-dlf"
+#define FILTER_ROW_PIPELINE_TOKEN       "-filter-row-pipeline"
+#define INTER_PIC_WAVEFRONT_TOKEN       "-inter-pic-wavefront"
 #define LOCAL_WARPED_ENABLE_TOKEN       "-local-warp"
 #define USE_DEFAULT_ME_HME_TOKEN        "-use-default-me-hme"
 #define HME_ENABLE_TOKEN                "-hme"
@@ -82,9 +88,12 @@
 #define MAX_QP_TOKEN                    "-max-qp"
 #define MIN_QP_TOKEN                    "-min-qp"
 #define LOOK_AHEAD_DIST_TOKEN           "-lad"
+#define PASS_TOKEN                      "-pass"
+#define STATS_FILE_TOKEN                "-stats"
 #define SUPER_BLOCK_SIZE_TOKEN          "-sb-size"
 #define TILE_ROW_TOKEN                   "-tile-rows"
 #define TILE_COL_TOKEN                   "-tile-columns"
+#define TILE_GROUP_OUTPUT_TOKEN          "-tile-group-output"
 
 #define SCENE_CHANGE_DETECTION_TOKEN    "-scd"
 #define INJECTOR_TOKEN                  "-inj"  // no Eval
@@ -93,6 +102,16 @@
 #define ASM_TYPE_TOKEN                  "-asm"
 #define THREAD_MGMNT                    "-lp"
 #define TARGET_SOCKET                   "-ss"
+#define UNIFIED_THREAD_POOL_TOKEN       "-unified-pool"
+#define NUMA_MEMORY_POLICY_TOKEN        "-numa-policy"
+#define LOW_MEMORY_TOKEN                "-low-memory"
+#define THREAD_POLICY_TOKEN             "-thread-policy"
+#define THREAD_PRIORITY_TOKEN           "-thread-priority"
+#define SHARED_WORKERS_TOKEN            "-shared-workers"
+#define CHANNEL_WEIGHT_TOKEN            "-channel-weight"
+#define LADDER_TOKEN                    "-ladder"
+#define PIPELINE_STATS_TOKEN            "-pipeline-stats"
+#define TRACE_FILE_TOKEN                "-trace-file"
 #define CONFIG_FILE_COMMENT_CHAR    '#'
 #define CONFIG_FILE_NEWLINE_CHAR    '\n'
 #define CONFIG_FILE_RETURN_CHAR     '\r'
@@ -123,6 +142,7 @@ static void SetCfgInputFile                     (const char *value, EbConfig *cf
     else {
         FOPEN(cfg->input_file, value, "rb");
     }
+    EB_STRCPY(cfg->input_file_name, MAX_FILE_NAME_LENGTH, value);
 
     /* if input is a YUV4MPEG2 (y4m) file, read header and parse parameters */
     if(cfg->input_file!=NULL){
@@ -162,6 +182,9 @@ static void SetSeperateFields                   (const char *value, EbConfig *cf
 static void SetCfgSourceHeight                  (const char *value, EbConfig *cfg) {cfg->source_height = strtoul(value, NULL, 0) >> cfg->separate_fields;};
 static void SetCfgFramesToBeEncoded             (const char *value, EbConfig *cfg) {cfg->frames_to_be_encoded = strtol(value,  NULL, 0) << cfg->separate_fields;};
 static void SetBufferedInput                    (const char *value, EbConfig *cfg) {cfg->buffered_input = (strtol(value, NULL, 0) != -1 && cfg->separate_fields) ? strtol(value, NULL, 0) << cfg->separate_fields : strtol(value, NULL, 0);};
+static void SetInputReader                      (const char *value, EbConfig *cfg) {cfg->input_reader = (uint32_t)strtoul(value, NULL, 0);};
+static void SetIoBench                          (const char *value, EbConfig *cfg) {cfg->io_bench = (EbBool)strtol(value, NULL, 0);};
+static void SetAsyncIo                          (const char *value, EbConfig *cfg) {cfg->async_io = (EbBool)strtol(value, NULL, 0);};
 static void SetFrameRate                        (const char *value, EbConfig *cfg) {
     cfg->frame_rate = strtoul(value, NULL, 0);
     if (cfg->frame_rate > 1000 ){
@@ -186,11 +209,14 @@ static void SetCfgQp                            (const char *value, EbConfig *cf
 static void SetCfgUseQpFile                     (const char *value, EbConfig *cfg) {cfg->use_qp_file = (EbBool)strtol(value, NULL, 0); };
 static void SetCfgFilmGrain                     (const char *value, EbConfig *cfg) { cfg->film_grain_denoise_strength = strtol(value, NULL, 0); };  //not bool to enable possible algorithm extension in the future
 static void SetDisableDlfFlag                   (const char *value, EbConfig *cfg) {cfg->disable_dlf_flag = (EbBool)strtoul(value, NULL, 0);};
+static void SetFilterRowPipeline                (const char *value, EbConfig *cfg) {cfg->filter_row_pipeline = (EbBool)strtoul(value, NULL, 0);};
+static void SetInterPictureWavefront            (const char *value, EbConfig *cfg) {cfg->inter_picture_wavefront = (EbBool)strtoul(value, NULL, 0);};
 static void SetEnableLocalWarpedMotionFlag      (const char *value, EbConfig *cfg) {cfg->enable_warped_motion = (EbBool)strtoul(value, NULL, 0);};
 static void SetEnableHmeFlag                    (const char *value, EbConfig *cfg) {cfg->enable_hme_flag = (EbBool)strtoul(value, NULL, 0);};
 static void SetEnableHmeLevel0Flag              (const char *value, EbConfig *cfg) {cfg->enable_hme_level0_flag = (EbBool)strtoul(value, NULL, 0);};
 static void SetTileRow                          (const char *value, EbConfig *cfg) { cfg->tile_rows = strtoul(value, NULL, 0); };
 static void SetTileCol                          (const char *value, EbConfig *cfg) { cfg->tile_columns = strtoul(value, NULL, 0); };
+static void SetTileGroupOutput                  (const char *value, EbConfig *cfg) { cfg->tile_group_output = (EbBool)strtoul(value, NULL, 0); };
 
 static void SetSceneChangeDetection             (const char *value, EbConfig *cfg) {cfg->scene_change_detection = strtoul(value, NULL, 0);};
 static void SetLookAheadDistance                (const char *value, EbConfig *cfg) {cfg->look_ahead_distance = strtoul(value, NULL, 0);};
@@ -198,6 +224,8 @@ static void SetRateControlMode                  (const char *value, EbConfig *cf
 static void SetTargetBitRate                    (const char *value, EbConfig *cfg) {cfg->target_bit_rate = strtoul(value, NULL, 0);};
 static void SetMaxQpAllowed                     (const char *value, EbConfig *cfg) {cfg->max_qp_allowed = strtoul(value, NULL, 0);};
 static void SetMinQpAllowed                     (const char *value, EbConfig *cfg) {cfg->min_qp_allowed = strtoul(value, NULL, 0);};
+static void SetPass                             (const char *value, EbConfig *cfg) {cfg->pass = strtoul(value, NULL, 0);};
+static void SetStatsFile                        (const char *value, EbConfig *cfg) {EB_STRCPY(cfg->stats_file_name, MAX_FILE_NAME_LENGTH, value);};
 static void SetEnableHmeLevel1Flag              (const char *value, EbConfig *cfg) {cfg->enable_hme_level1_flag  = (EbBool)strtoul(value, NULL, 0);};
 static void SetEnableHmeLevel2Flag              (const char *value, EbConfig *cfg) {cfg->enable_hme_level2_flag  = (EbBool)strtoul(value, NULL, 0);};
 static void SetCfgSearchAreaWidth               (const char *value, EbConfig *cfg) {cfg->search_area_width = strtoul(value, NULL, 0);};
@@ -242,6 +270,16 @@ static void SetLatencyMode                      (const char *value, EbConfig *cf
 static void SetAsmType                          (const char *value, EbConfig *cfg)  {cfg->asm_type                   = (uint32_t)strtoul(value, NULL, 0);};
 static void SetLogicalProcessors                (const char *value, EbConfig *cfg)  {cfg->logical_processors         = (uint32_t)strtoul(value, NULL, 0);};
 static void SetTargetSocket                     (const char *value, EbConfig *cfg)  {cfg->target_socket              = (int32_t)strtol(value, NULL, 0);};
+static void SetUnifiedThreadPool                (const char *value, EbConfig *cfg)  {cfg->unified_thread_pool        = (EbBool)strtol(value, NULL, 0);};
+static void SetNumaMemoryPolicy                 (const char *value, EbConfig *cfg)  {cfg->numa_memory_policy         = (uint32_t)strtoul(value, NULL, 0);};
+static void SetLowMemory                        (const char *value, EbConfig *cfg)  {cfg->low_memory                 = (EbBool)strtol(value, NULL, 0);};
+static void SetThreadPolicy                     (const char *value, EbConfig *cfg)  {cfg->thread_policy              = (uint32_t)strtoul(value, NULL, 0);};
+static void SetThreadPriority                   (const char *value, EbConfig *cfg)  {cfg->thread_priority            = (int32_t)strtol(value, NULL, 0);};
+static void SetSharedWorkers                    (const char *value, EbConfig *cfg)  {cfg->shared_workers             = (uint32_t)strtoul(value, NULL, 0);};
+static void SetChannelWeight                    (const char *value, EbConfig *cfg)  {cfg->channel_weight             = (uint32_t)strtoul(value, NULL, 0);};
+static void SetLadder                           (const char *value, EbConfig *cfg)  {cfg->ladder                     = (EbBool)strtol(value, NULL, 0);};
+static void SetPipelineStats                    (const char *value, EbConfig *cfg)  {cfg->pipeline_stats             = (uint32_t)strtoul(value, NULL, 0);};
+static void SetTraceFile                        (const char *value, EbConfig *cfg)  {EB_STRCPY(cfg->trace_file_name, MAX_FILE_NAME_LENGTH, value);};
 
 enum cfg_type{
     SINGLE_INPUT,   // Configuration parameters that have only 1 value input
@@ -281,6 +319,9 @@ config_entry_t config_entry[] = {
     // Prediction Structure
     { SINGLE_INPUT, NUMBER_OF_PICTURES_TOKEN, "FrameToBeEncoded", SetCfgFramesToBeEncoded },
     { SINGLE_INPUT, BUFFERED_INPUT_TOKEN, "BufferedInput", SetBufferedInput },
+    { SINGLE_INPUT, INPUT_READER_TOKEN, "InputReader", SetInputReader },
+    { SINGLE_INPUT, IO_BENCH_TOKEN, "IoBench", SetIoBench },
+    { SINGLE_INPUT, ASYNC_IO_TOKEN, "AsyncIo", SetAsyncIo },
     { SINGLE_INPUT, BASE_LAYER_SWITCH_MODE_TOKEN, "BaseLayerSwitchMode", SetBaseLayerSwitchMode },
     { SINGLE_INPUT, ENCMODE_TOKEN, "EncoderMode", SetencMode},
     { SINGLE_INPUT, INTRA_PERIOD_TOKEN, "IntraPeriod", SetCfgIntraPeriod },
@@ -296,6 +337,7 @@ config_entry_t config_entry[] = {
 
      { SINGLE_INPUT, TILE_ROW_TOKEN, "TileRow", SetTileRow},
      { SINGLE_INPUT, TILE_COL_TOKEN, "TileCol", SetTileCol},
+     { SINGLE_INPUT, TILE_GROUP_OUTPUT_TOKEN, "TileGroupOutput", SetTileGroupOutput},
 
     // Rate Control
     { SINGLE_INPUT, SCENE_CHANGE_DETECTION_TOKEN, "SceneChangeDetection", SetSceneChangeDetection},
@@ -306,9 +348,13 @@ config_entry_t config_entry[] = {
     { SINGLE_INPUT, TARGET_BIT_RATE_TOKEN, "TargetBitRate", SetTargetBitRate },
     { SINGLE_INPUT, MAX_QP_TOKEN, "MaxQpAllowed", SetMaxQpAllowed },
     { SINGLE_INPUT, MIN_QP_TOKEN, "MinQpAllowed", SetMinQpAllowed },
+    { SINGLE_INPUT, PASS_TOKEN, "Pass", SetPass },
+    { SINGLE_INPUT, STATS_FILE_TOKEN, "StatsFile", SetStatsFile },
 
     // DLF
     { SINGLE_INPUT, LOOP_FILTER_DISABLE_TOKEN, "LoopFilterDisable", SetDisableDlfFlag },
+    { SINGLE_INPUT, FILTER_ROW_PIPELINE_TOKEN, "FilterRowPipeline", SetFilterRowPipeline },
+    { SINGLE_INPUT, INTER_PIC_WAVEFRONT_TOKEN, "InterPictureWavefront", SetInterPictureWavefront },
 
     // LOCAL WARPED MOTION
     { SINGLE_INPUT, LOCAL_WARPED_ENABLE_TOKEN, "LocalWarpedMotion", SetEnableLocalWarpedMotionFlag },
@@ -339,6 +385,18 @@ config_entry_t config_entry[] = {
     // Thread Management
     { SINGLE_INPUT, THREAD_MGMNT, "logicalProcessors", SetLogicalProcessors },
     { SINGLE_INPUT, TARGET_SOCKET, "TargetSocket", SetTargetSocket },
+    { SINGLE_INPUT, UNIFIED_THREAD_POOL_TOKEN, "UnifiedThreadPool", SetUnifiedThreadPool },
+    { SINGLE_INPUT, NUMA_MEMORY_POLICY_TOKEN, "NumaMemoryPolicy", SetNumaMemoryPolicy },
+    { SINGLE_INPUT, LOW_MEMORY_TOKEN, "LowMemory", SetLowMemory },
+    { SINGLE_INPUT, THREAD_POLICY_TOKEN, "ThreadPolicy", SetThreadPolicy },
+    { SINGLE_INPUT, THREAD_PRIORITY_TOKEN, "ThreadPriority", SetThreadPriority },
+    { SINGLE_INPUT, SHARED_WORKERS_TOKEN, "SharedWorkers", SetSharedWorkers },
+    { SINGLE_INPUT, CHANNEL_WEIGHT_TOKEN, "ChannelWeight", SetChannelWeight },
+    { SINGLE_INPUT, LADDER_TOKEN, "Ladder", SetLadder },
+
+    // Pipeline Statistics
+    { SINGLE_INPUT, PIPELINE_STATS_TOKEN, "PipelineStats", SetPipelineStats },
+    { SINGLE_INPUT, TRACE_FILE_TOKEN, "TraceFile", SetTraceFile },
 
     // Optional Features
 
@@ -379,6 +437,7 @@ void eb_config_ctor(EbConfig *config_ptr)
 {
     config_ptr->config_file                           = NULL;
     config_ptr->input_file                            = NULL;
+    config_ptr->input_file_name[0]                    = '\0';
     config_ptr->bitstream_file                        = NULL;
     config_ptr->recon_file                            = NULL;
     config_ptr->error_log_file                         = stderr;
@@ -397,6 +456,10 @@ void eb_config_ctor(EbConfig *config_ptr)
     config_ptr->frames_to_be_encoded                 = 0;
     config_ptr->buffered_input                        = -1;
     config_ptr->sequence_buffer                       = 0;
+    config_ptr->input_reader                          = 0;
+    config_ptr->input_reader_ptr                      = NULL;
+    config_ptr->io_bench                              = EB_FALSE;
+    config_ptr->async_io                              = EB_TRUE;
     config_ptr->latency_mode                          = 0;
 
     // Interlaced Video
@@ -415,6 +478,9 @@ void eb_config_ctor(EbConfig *config_ptr)
 #else
     config_ptr->min_qp_allowed                       = 0;
 #endif
+    config_ptr->pass                                  = 0;
+    config_ptr->stats_file_name[0]                    = '\0';
+    config_ptr->stats_file                            = (FILE *)NULL;
     config_ptr->base_layer_switch_mode               = 0;
     config_ptr->enc_mode                              = MAX_ENC_PRESET;
     config_ptr->intra_period                          = -2;
@@ -422,6 +488,8 @@ void eb_config_ctor(EbConfig *config_ptr)
     config_ptr->hierarchical_levels                   = 4;
     config_ptr->pred_structure                        = 2;
     config_ptr->disable_dlf_flag                     = EB_FALSE;
+    config_ptr->filter_row_pipeline                  = EB_FALSE;
+    config_ptr->inter_picture_wavefront              = EB_FALSE;
     config_ptr->enable_warped_motion                 = EB_FALSE;
     config_ptr->ext_block_flag                       = EB_FALSE;
     config_ptr->in_loop_me_flag                      = EB_TRUE;
@@ -493,6 +561,8 @@ void eb_config_ctor(EbConfig *config_ptr)
     config_ptr->performance_context.startu_time        = 0;
     config_ptr->performance_context.max_latency        = 0;
     config_ptr->performance_context.total_latency      = 0;
+    config_ptr->performance_context.total_first_fragment_latency = 0;
+    config_ptr->performance_context.first_fragment_received = EB_FALSE;
     config_ptr->performance_context.byte_count         = 0;
 
     // ASM Type
@@ -501,10 +571,22 @@ void eb_config_ctor(EbConfig *config_ptr)
     config_ptr->stop_encoder                          = 0;
     config_ptr->logical_processors                    = 0;
     config_ptr->target_socket                         = -1;
+    config_ptr->unified_thread_pool                   = EB_FALSE;
+    config_ptr->numa_memory_policy                    = 0;
+    config_ptr->low_memory                            = EB_FALSE;
+    config_ptr->thread_policy                         = 0;
+    config_ptr->thread_priority                       = 0;
+    config_ptr->shared_workers                        = 0;
+    config_ptr->channel_weight                        = EB_HOST_DEFAULT_WEIGHT;
+    config_ptr->host_context_ptr                      = NULL;
+    config_ptr->ladder                                = EB_FALSE;
+    config_ptr->pipeline_stats                        = 0;
+    config_ptr->trace_file_name[0]                    = '\0';
     config_ptr->processed_frame_count                  = 0;
     config_ptr->processed_byte_count                   = 0;
     config_ptr->tile_rows                            = 0;
     config_ptr->tile_columns                         = 0;
+    config_ptr->tile_group_output                    = EB_FALSE;
 
     config_ptr->byte_count_since_ivf                 = 0;
     config_ptr->ivf_count                            = 0;
@@ -523,6 +605,7 @@ void eb_config_dtor(EbConfig *config_ptr)
         config_ptr->config_file = (FILE *) NULL;
     }
 
+    input_reader_close(config_ptr);
     if (config_ptr->input_file) {
         if (config_ptr->input_file != stdin) fclose(config_ptr->input_file);
         config_ptr->input_file = (FILE *) NULL;
@@ -548,6 +631,11 @@ void eb_config_dtor(EbConfig *config_ptr)
         config_ptr->qp_file = (FILE *)NULL;
     }
 
+    if (config_ptr->stats_file) {
+        fclose(config_ptr->stats_file);
+        config_ptr->stats_file = (FILE *)NULL;
+    }
+
     return;
 }
 
@@ -782,6 +870,21 @@ static EbErrorType VerifySettings(EbConfig *config, uint32_t channelNumber)
         return_error = EB_ErrorBadParameter;
     }
 
+    if (config->input_reader > 2) {
+        fprintf(config->error_log_file, "Error instance %u: Invalid InputReader [0 - 2], your input: %u\n", channelNumber + 1, config->input_reader);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->io_bench != 0 && config->io_bench != 1) {
+        fprintf(config->error_log_file, "Error instance %u: Invalid IoBench flag [0 - 1], your input: %d\n", channelNumber + 1, config->io_bench);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->async_io != 0 && config->async_io != 1) {
+        fprintf(config->error_log_file, "Error instance %u: Invalid AsyncIo flag [0 - 1], your input: %d\n", channelNumber + 1, config->async_io);
+        return_error = EB_ErrorBadParameter;
+    }
+
     if (config->buffered_input > config->frames_to_be_encoded) {
         fprintf(config->error_log_file, "Error instance %u: Invalid buffered_input. buffered_input must be less or equal to the number of frames to be encoded\n",channelNumber+1);
         return_error = EB_ErrorBadParameter;
@@ -828,6 +931,73 @@ static EbErrorType VerifySettings(EbConfig *config, uint32_t channelNumber)
         return_error = EB_ErrorBadParameter;
     }
 
+    // unified_thread_pool
+    if (config->unified_thread_pool != 0 && config->unified_thread_pool != 1) {
+        fprintf(config->error_log_file, "Error instance %u: Invalid unified thread pool flag [0 - 1], your input: %d\n", channelNumber + 1, config->unified_thread_pool);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    // numa_memory_policy
+    if (config->numa_memory_policy > 2) {
+        fprintf(config->error_log_file, "Error instance %u: Invalid NUMA memory policy [0 - 2], your input: %u\n", channelNumber + 1, config->numa_memory_policy);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->numa_memory_policy == 1 && config->target_socket == -1) {
+        fprintf(config->error_log_file, "Error instance %u: NUMA memory policy 1 requires TargetSocket to be set\n", channelNumber + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    // low_memory
+    if (config->low_memory != 0 && config->low_memory != 1) {
+        fprintf(config->error_log_file, "Error instance %u: Invalid LowMemory flag [0 - 1], your input: %d\n", channelNumber + 1, config->low_memory);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    // thread_policy
+    if (config->thread_policy > 2) {
+        fprintf(config->error_log_file, "Error instance %u: Invalid thread policy [0 - 2], your input: %u\n", channelNumber + 1, config->thread_policy);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->thread_policy == 1 && (config->thread_priority < -20 || config->thread_priority > 19)) {
+        fprintf(config->error_log_file, "Error instance %u: Invalid thread priority, the nice value must be [-20 - 19], your input: %d\n", channelNumber + 1, config->thread_priority);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->thread_policy == 2 && (config->thread_priority < 1 || config->thread_priority > 99)) {
+        fprintf(config->error_log_file, "Error instance %u: Invalid thread priority, the real-time priority must be [1 - 99], your input: %d\n", channelNumber + 1, config->thread_priority);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    // channel_weight
+    if (config->channel_weight < 1 || config->channel_weight > EB_HOST_MAX_WEIGHT) {
+        fprintf(config->error_log_file, "Error instance %u: Invalid channel weight [1 - %u], your input: %u\n", channelNumber + 1, EB_HOST_MAX_WEIGHT, config->channel_weight);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    // pipeline_stats
+    if (config->pipeline_stats > 2) {
+        fprintf(config->error_log_file, "Error instance %u: Invalid pipeline stats level [0 - 2], your input: %u\n", channelNumber + 1, config->pipeline_stats);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->trace_file_name[0] != '\0' && config->pipeline_stats != 2) {
+        fprintf(config->error_log_file, "Error instance %u: TraceFile requires PipelineStats to be 2\n", channelNumber + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    // pass
+    if (config->pass > 2) {
+        fprintf(config->error_log_file, "Error instance %u: Invalid pass [0 - 2], your input: %u\n", channelNumber + 1, config->pass);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->pass != 0 && config->stats_file_name[0] == '\0') {
+        fprintf(config->error_log_file, "Error instance %u: Pass %u requires a StatsFile\n", channelNumber + 1, config->pass);
+        return_error = EB_ErrorBadParameter;
+    }
+
     // Local Warped Motion
     if (config->enable_warped_motion != 0 && config->enable_warped_motion != 1) {
         fprintf(config->error_log_file, "Error instance %u: Invalid warped motion flag [0 - 1], your input: %d\n", channelNumber + 1, config->target_socket);
@@ -157,6 +157,7 @@ extern rsize_t strnlen_ss(const char *s, rsize_t smax);
 
 #define MAX_CHANNEL_NUMBER      6
 #define MAX_NUM_TOKENS          200
+#define MAX_FILE_NAME_LENGTH    1024
 
 #ifdef _MSC_VER
 #define FOPEN(f,s,m) fopen_s(&f,s,m)
@@ -178,6 +179,9 @@ typedef struct EbPerformanceContext {
 
     uint64_t                  total_latency;
     uint32_t                  max_latency;
+    // Tile group output: latency of the first packet of each picture
+    uint64_t                  total_first_fragment_latency;
+    EbBool                    first_fragment_received;
 
     uint64_t                  starts_time;
     uint64_t                  startu_time;
@@ -197,6 +201,7 @@ typedef struct EbConfig
      ****************************************/
     FILE                    *config_file;
     FILE                    *input_file;
+    char                     input_file_name[MAX_FILE_NAME_LENGTH];
     FILE                    *bitstream_file;
     FILE                    *recon_file;
     FILE                    *error_log_file;
@@ -228,6 +233,10 @@ typedef struct EbConfig
     int32_t                  frames_encoded;
     int32_t                  buffered_input;
     uint8_t                **sequence_buffer;
+    uint32_t                 input_reader;
+    struct EbInputReader    *input_reader_ptr;
+    EbBool                   io_bench;
+    EbBool                   async_io;
 
     uint8_t                  latency_mode;
 
@@ -261,6 +270,8 @@ typedef struct EbConfig
      * DLF
      ****************************************/
     EbBool                  disable_dlf_flag;
+    EbBool                  filter_row_pipeline;
+    EbBool                  inter_picture_wavefront;
 
     /****************************************
      * Local Warped Motion
@@ -311,6 +322,7 @@ typedef struct EbConfig
 
     int32_t                  tile_columns;
     int32_t                  tile_rows;
+    EbBool                   tile_group_output;
 
     /****************************************
      * Rate Control
@@ -322,6 +334,13 @@ typedef struct EbConfig
     uint32_t                 max_qp_allowed;
     uint32_t                 min_qp_allowed;
 
+    /****************************************
+     * Two Pass
+     ****************************************/
+    uint32_t                 pass;
+    char                     stats_file_name[MAX_FILE_NAME_LENGTH];
+    FILE                    *stats_file;          // first pass output
+
     /****************************************
      * Optional Features
      ****************************************/
@@ -359,8 +378,23 @@ typedef struct EbConfig
     uint32_t                active_channel_count;
     uint32_t                logical_processors;
     int32_t                 target_socket;
+    EbBool                  unified_thread_pool;
+    uint32_t                numa_memory_policy;
+    EbBool                  low_memory;
+    uint32_t                thread_policy;
+    int32_t                 thread_priority;
+    uint32_t                shared_workers;       // read from the first channel
+    uint32_t                channel_weight;
+    EbSvtHostContext       *host_context_ptr;
+    EbBool                  ladder;               // read from the first channel
     EbBool                 stop_encoder;         // to signal CTRL+C Event, need to stop encoding.
 
+    /****************************************
+    * Pipeline Statistics
+    ****************************************/
+    uint32_t                pipeline_stats;
+    char                    trace_file_name[MAX_FILE_NAME_LENGTH];
+
     uint64_t                processed_frame_count;
     uint64_t                processed_byte_count;
 
@@ -11,6 +11,7 @@
 
 #include "EbAppContext.h"
 #include "EbAppConfig.h"
+#include "EbAppInputReader.h"
 
 
 #define INPUT_SIZE_576p_TH                0x90000        // 0.58 Million
@@ -175,6 +176,7 @@ EbErrorType CopyConfigurationParameters(
     callback_data->eb_enc_parameters.ext_block_flag = config->ext_block_flag;
     callback_data->eb_enc_parameters.tile_rows = config->tile_rows;
     callback_data->eb_enc_parameters.tile_columns = config->tile_columns;
+    callback_data->eb_enc_parameters.tile_group_output = config->tile_group_output;
 
     callback_data->eb_enc_parameters.scene_change_detection = config->scene_change_detection;
     callback_data->eb_enc_parameters.look_ahead_distance = config->look_ahead_distance;
@@ -183,9 +185,12 @@ EbErrorType CopyConfigurationParameters(
     callback_data->eb_enc_parameters.target_bit_rate = config->target_bit_rate;
     callback_data->eb_enc_parameters.max_qp_allowed = config->max_qp_allowed;
     callback_data->eb_enc_parameters.min_qp_allowed = config->min_qp_allowed;
+    callback_data->eb_enc_parameters.pass = config->pass;
     callback_data->eb_enc_parameters.qp = config->qp;
     callback_data->eb_enc_parameters.use_qp_file = (EbBool)config->use_qp_file;
     callback_data->eb_enc_parameters.disable_dlf_flag = (EbBool)config->disable_dlf_flag;
+    callback_data->eb_enc_parameters.filter_row_pipeline = (EbBool)config->filter_row_pipeline;
+    callback_data->eb_enc_parameters.inter_picture_wavefront = (EbBool)config->inter_picture_wavefront;
     callback_data->eb_enc_parameters.enable_warped_motion = (EbBool)config->enable_warped_motion;
     callback_data->eb_enc_parameters.use_default_me_hme = (EbBool)config->use_default_me_hme;
     callback_data->eb_enc_parameters.enable_hme_flag = (EbBool)config->enable_hme_flag;
@@ -215,6 +220,12 @@ EbErrorType CopyConfigurationParameters(
     callback_data->eb_enc_parameters.asm_type = config->asm_type;
     callback_data->eb_enc_parameters.logical_processors = config->logical_processors;
     callback_data->eb_enc_parameters.target_socket = config->target_socket;
+    callback_data->eb_enc_parameters.unified_thread_pool = config->unified_thread_pool;
+    callback_data->eb_enc_parameters.numa_memory_policy = config->numa_memory_policy;
+    callback_data->eb_enc_parameters.low_memory = config->low_memory;
+    callback_data->eb_enc_parameters.thread_policy = config->thread_policy;
+    callback_data->eb_enc_parameters.thread_priority = config->thread_priority;
+    callback_data->eb_enc_parameters.pipeline_stats = config->pipeline_stats;
     callback_data->eb_enc_parameters.recon_enabled = config->recon_file ? EB_TRUE : EB_FALSE;
 
     for (hmeRegionIndex = 0; hmeRegionIndex < callback_data->eb_enc_parameters.number_hme_search_region_in_width; ++hmeRegionIndex) {
@@ -310,26 +321,35 @@ EbErrorType AllocateInputBuffers(
     EbAppContext            *callback_data)
 {
     EbErrorType   return_error = EB_ErrorNone;
-    {
-        EB_APP_MALLOC(EbBufferHeaderType*, callback_data->input_buffer_pool, sizeof(EbBufferHeaderType), EB_N_PTR, EB_ErrorInsufficientResources);
+    // The reader thread of AsyncIo fills several frames ahead of the encoder
+    const uint32_t slot_count = config->async_io ? APP_INPUT_QUEUE_DEPTH : 1;
+    uint32_t       slot_index;
+
+    for (slot_index = 0; slot_index < slot_count; ++slot_index) {
+        EbBufferHeaderType *header_ptr;
+
+        EB_APP_MALLOC(EbBufferHeaderType*, header_ptr, sizeof(EbBufferHeaderType), EB_N_PTR, EB_ErrorInsufficientResources);
 
         // Initialize Header
-        callback_data->input_buffer_pool->size                       = sizeof(EbBufferHeaderType);
+        header_ptr->size                       = sizeof(EbBufferHeaderType);
 
-        EB_APP_MALLOC(uint8_t*, callback_data->input_buffer_pool->p_buffer, sizeof(EbSvtIOFormat), EB_N_PTR, EB_ErrorInsufficientResources);
+        EB_APP_MALLOC(uint8_t*, header_ptr->p_buffer, sizeof(EbSvtIOFormat), EB_N_PTR, EB_ErrorInsufficientResources);
 
         if (config->buffered_input == -1) {
 
             // Allocate frame buffer for the p_buffer
             AllocateFrameBuffer(
                     config,
-                    callback_data->input_buffer_pool->p_buffer);
+                    header_ptr->p_buffer);
         }
 
         // Assign the variables
-        callback_data->input_buffer_pool->p_app_private = NULL;
-        callback_data->input_buffer_pool->pic_type   = EB_AV1_INVALID_PICTURE;
+        header_ptr->p_app_private = NULL;
+        header_ptr->pic_type   = EB_AV1_INVALID_PICTURE;
+
+        callback_data->input_slot_array[slot_index] = header_ptr;
     }
+    callback_data->input_buffer_pool = callback_data->input_slot_array[0];
 
     return return_error;
 }
@@ -551,6 +571,42 @@ EbErrorType PreloadFramesIntoRam(
     return return_error;
 }
 
+/***********************************
+ * Reads the whole stats file of a
+ * first pass
+ ***********************************/
+static EbErrorType read_pass_stats(
+    EbConfig              *config,
+    uint8_t              **pass_stats,
+    uint64_t              *pass_stats_size)
+{
+    FILE    *stats_file;
+    int64_t  file_size;
+
+    FOPEN(stats_file, config->stats_file_name, "rb");
+    if (stats_file == NULL) {
+        fprintf(config->error_log_file, "Error: could not open the stats file %s\n", config->stats_file_name);
+        return EB_ErrorBadParameter;
+    }
+
+    fseeko64(stats_file, 0, SEEK_END);
+    file_size = ftello64(stats_file);
+    fseeko64(stats_file, 0, SEEK_SET);
+
+    *pass_stats = file_size > 0 ? (uint8_t*)malloc((size_t)file_size) : NULL;
+    if (*pass_stats == NULL || fread(*pass_stats, 1, (size_t)file_size, stats_file) != (size_t)file_size) {
+        fprintf(config->error_log_file, "Error: could not read the stats file %s\n", config->stats_file_name);
+        free(*pass_stats);
+        *pass_stats = NULL;
+        fclose(stats_file);
+        return EB_ErrorBadParameter;
+    }
+    *pass_stats_size = (uint64_t)file_size;
+
+    fclose(stats_file);
+    return EB_ErrorNone;
+}
+
 /***************************************
 * Functions Implementation
 ***************************************/
@@ -564,6 +620,8 @@ EbErrorType init_encoder(
     uint32_t                 instance_idx)
 {
     EbErrorType        return_error = EB_ErrorNone;
+    uint8_t           *pass_stats = NULL;
+    uint64_t           pass_stats_size = 0;
 
     // Allocate a memory table hosting all allocated pointers
     AllocateMemoryTable(instance_idx);
@@ -576,6 +634,18 @@ EbErrorType init_encoder(
         return return_error;
     }
 
+    // Share the workers of the host context with the other channels
+    if (config->host_context_ptr) {
+        return_error = eb_svt_enc_attach_host_context(
+            callback_data->svt_encoder_handle,
+            config->host_context_ptr,
+            config->channel_weight);
+
+        if (return_error != EB_ErrorNone) {
+            return return_error;
+        }
+    }
+
     // STEP 3: Copy all configuration parameters into the callback structure
     return_error = CopyConfigurationParameters(
                     config,
@@ -596,14 +666,53 @@ EbErrorType init_encoder(
         return return_error;
     }
 
+    // Second pass: the library reads the first pass statistics in eb_init_encoder()
+    if (config->pass == 2) {
+        return_error = read_pass_stats(
+            config,
+            &pass_stats,
+            &pass_stats_size);
+
+        if (return_error != EB_ErrorNone) {
+            return return_error;
+        }
+
+        return_error = eb_svt_enc_set_pass_stats(
+            callback_data->svt_encoder_handle,
+            pass_stats,
+            pass_stats_size);
+
+        if (return_error != EB_ErrorNone) {
+            free(pass_stats);
+            return return_error;
+        }
+    }
+
     // STEP 5: Init Encoder
     return_error = eb_init_encoder(callback_data->svt_encoder_handle);
+    free(pass_stats);
     if (return_error != EB_ErrorNone) { return return_error; }
 
+    // First pass: the output packets go to the stats file
+    if (config->pass == 1) {
+        FOPEN(config->stats_file, config->stats_file_name, "wb");
+        if (config->stats_file == NULL) {
+            fprintf(config->error_log_file, "Error: could not open the stats file %s\n", config->stats_file_name);
+            return EB_ErrorBadParameter;
+        }
+    }
+
     ///************************* LIBRARY INIT [END] *********************///
 
     ///********************** APPLICATION INIT [START] ******************///
 
+    // Map the input file when InputReader asks for it
+    return_error = input_reader_open(config);
+
+    if (return_error != EB_ErrorNone) {
+        return return_error;
+    }
+
     // STEP 6: Allocate input buffers carrying the yuv frames in
     return_error = AllocateInputBuffers(
         config,
@@ -652,6 +761,43 @@ EbErrorType init_encoder(
     return return_error;
 }
 
+/***********************************
+ * Initialize the input path only,
+ * for the input bench
+ ***********************************/
+EbErrorType init_input_bench(
+    EbConfig              *config,
+    EbAppContext          *callback_data,
+    uint32_t                 instance_idx)
+{
+    EbErrorType        return_error = EB_ErrorNone;
+
+    AllocateMemoryTable(instance_idx);
+    callback_data->svt_encoder_handle = NULL;
+
+    return_error = input_reader_open(config);
+    if (return_error != EB_ErrorNone) {
+        return return_error;
+    }
+
+    return_error = AllocateInputBuffers(
+        config,
+        callback_data);
+    if (return_error != EB_ErrorNone) {
+        return return_error;
+    }
+
+    if (config->buffered_input != -1) {
+        PreloadFramesIntoRam(
+            config);
+    }
+    else {
+        config->sequence_buffer = 0;
+    }
+
+    return return_error;
+}
+
 /***********************************
  * Deinit Components
  ***********************************/
@@ -687,7 +833,8 @@ EbErrorType de_init_encoder(
     free(appMemoryMapAllChannels[instance_index]);
 
     // Destruct the component
-    eb_deinit_handle(callback_data_ptr->svt_encoder_handle);
+    if (callback_data_ptr->svt_encoder_handle != NULL)
+        eb_deinit_handle(callback_data_ptr->svt_encoder_handle);
 
     return return_error;
 }
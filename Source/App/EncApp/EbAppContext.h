@@ -8,6 +8,23 @@
 
 #include "EbSvtAv1Enc.h"
 #include "EbAppConfig.h"
+#include "EbAppThreads.h"
+
+#define APP_INPUT_QUEUE_DEPTH   4   // frames read ahead of the encoder per channel
+
+/***************************************
+ * Time spent on I/O and in the library
+ * by the channel threads, in us
+ ***************************************/
+typedef struct EbAppIoStats {
+    uint64_t                           read_time_us;            // reading the input frames
+    uint64_t                           read_blocked_time_us;    // reader waiting for a free input slot
+    uint64_t                           send_time_us;            // inside eb_svt_enc_send_picture
+    uint64_t                           send_starved_time_us;    // feeder waiting for the reader
+    uint64_t                           get_packet_time_us;      // inside eb_svt_get_packet
+    uint64_t                           write_time_us;           // writing the bitstream
+    uint64_t                           recon_write_time_us;     // writing the recon file
+} EbAppIoStats;
 
 /***************************************
 
@@ -30,6 +47,20 @@ typedef struct EbAppContext {
     // Instance Index
     uint8_t                            instance_idx;
 
+    // Channel threads (AsyncIo)
+    EbConfig                          *config;
+    EbBufferHeaderType                *input_slot_array[APP_INPUT_QUEUE_DEPTH];
+    AppQueue                           input_free_queue;
+    AppQueue                           input_ready_queue;
+    AppThread                          reader_thread;
+    AppThread                          feeder_thread;
+    AppThread                          writer_thread;
+    AppThread                          recon_thread;
+    AppExitConditionType               input_exit_condition;
+    AppExitConditionType               output_exit_condition;
+    AppExitConditionType               recon_exit_condition;
+    EbAppIoStats                       io_stats;
+
 } EbAppContext;
 
 
@@ -38,5 +69,6 @@ typedef struct EbAppContext {
  ********************************/
 extern EbErrorType init_encoder(EbConfig *config, EbAppContext *callback_data, uint32_t instance_idx);
 extern EbErrorType de_init_encoder(EbAppContext *callback_data_ptr, uint32_t instance_index);
+extern EbErrorType init_input_bench(EbConfig *config, EbAppContext *callback_data, uint32_t instance_idx);
 
 #endif // EbAppContext_h
\ No newline at end of file
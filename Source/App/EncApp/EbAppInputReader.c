@@ -0,0 +1,365 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#ifdef __linux__
+#define _GNU_SOURCE     // O_DIRECT
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "EbAppInputReader.h"
+
+#ifdef _WIN32
+#include <io.h>         /* _get_osfhandle() */
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#endif
+
+#define Y4M_FRAME_DELIMITER_MAX 10
+
+/***************************************
+ * Maps the whole input file read only
+ ***************************************/
+static EbErrorType map_input_file(
+    EbInputReader  *reader,
+    FILE           *input_file)
+{
+#ifdef _WIN32
+    HANDLE file_handle = (HANDLE)_get_osfhandle(_fileno(input_file));
+
+    reader->mapping_handle = CreateFileMapping(file_handle, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (reader->mapping_handle == NULL)
+        return EB_ErrorInsufficientResources;
+    reader->map_ptr = (uint8_t*)MapViewOfFile(reader->mapping_handle, FILE_MAP_READ, 0, 0, 0);
+    if (reader->map_ptr == NULL) {
+        CloseHandle(reader->mapping_handle);
+        reader->mapping_handle = NULL;
+        return EB_ErrorInsufficientResources;
+    }
+#else
+    void *map_ptr = mmap(NULL, (size_t)reader->file_size, PROT_READ, MAP_PRIVATE, fileno(input_file), 0);
+    if (map_ptr == MAP_FAILED)
+        return EB_ErrorInsufficientResources;
+    // Frames are consumed once, front to back: aggressive readahead
+    madvise(map_ptr, (size_t)reader->file_size, MADV_SEQUENTIAL);
+    reader->map_ptr = (uint8_t*)map_ptr;
+#endif
+    return EB_ErrorNone;
+}
+
+/***************************************
+ * Opens a second, uncached descriptor of
+ * the input file and its aligned buffer
+ ***************************************/
+static EbErrorType open_direct_input_file(
+    EbInputReader  *reader,
+    const char     *file_name,
+    uint64_t        frame_size)
+{
+#if defined(__linux__)
+    reader->direct_fd = open(file_name, O_RDONLY | O_DIRECT);
+#elif defined(__APPLE__)
+    reader->direct_fd = open(file_name, O_RDONLY);
+    if (reader->direct_fd >= 0 && fcntl(reader->direct_fd, F_NOCACHE, 1) == -1) {
+        close(reader->direct_fd);
+        reader->direct_fd = -1;
+    }
+#else
+    (void)reader;
+    (void)file_name;
+    (void)frame_size;
+    return EB_ErrorBadParameter;
+#endif
+#if defined(__linux__) || defined(__APPLE__)
+    if (reader->direct_fd < 0)
+        return EB_ErrorBadParameter;
+
+    // A whole frame plus the misalignment of its first byte, and room to
+    // read ahead in large blocks
+    reader->block_buffer_size = ((frame_size + INPUT_READER_DIRECT_ALIGNMENT - 1) & ~(uint64_t)(INPUT_READER_DIRECT_ALIGNMENT - 1)) +
+        INPUT_READER_DIRECT_ALIGNMENT + INPUT_READER_DIRECT_BLOCK_SIZE;
+    if (posix_memalign((void**)&reader->block_buffer, INPUT_READER_DIRECT_ALIGNMENT, (size_t)reader->block_buffer_size) != 0) {
+        reader->block_buffer = NULL;
+        close(reader->direct_fd);
+        reader->direct_fd = -1;
+        return EB_ErrorInsufficientResources;
+    }
+    return EB_ErrorNone;
+#endif
+}
+
+/***************************************
+ * Refills the aligned buffer so that it
+ * covers [position, position + size)
+ ***************************************/
+static const uint8_t *get_direct(
+    EbInputReader  *reader,
+    uint64_t        size)
+{
+    const uint64_t end = reader->position + size;
+
+    if (reader->position < reader->block_offset || end > reader->block_offset + reader->block_filled) {
+#if defined(__linux__) || defined(__APPLE__)
+        const uint64_t base = reader->position & ~(uint64_t)(INPUT_READER_DIRECT_ALIGNMENT - 1);
+        uint64_t kept = 0;
+
+        // Keep the aligned part of the buffer that is still ahead of base
+        if (base >= reader->block_offset && base < reader->block_offset + reader->block_filled) {
+            kept = (reader->block_offset + reader->block_filled - base) & ~(uint64_t)(INPUT_READER_DIRECT_ALIGNMENT - 1);
+            memmove(reader->block_buffer, reader->block_buffer + (base - reader->block_offset), (size_t)kept);
+        }
+        reader->block_offset = base;
+        reader->block_filled = kept;
+
+        while (reader->block_filled < reader->block_buffer_size) {
+            ssize_t read_size = pread(
+                reader->direct_fd,
+                reader->block_buffer + reader->block_filled,
+                (size_t)(reader->block_buffer_size - reader->block_filled),
+                (off_t)(reader->block_offset + reader->block_filled));
+            if (read_size <= 0)
+                break;
+            reader->block_filled += (uint64_t)read_size;
+            // A partial block is only returned at the end of the file
+            if ((uint64_t)read_size & (INPUT_READER_DIRECT_ALIGNMENT - 1))
+                break;
+        }
+#endif
+        if (end > reader->block_offset + reader->block_filled)
+            return NULL;
+    }
+
+    reader->position = end;
+    return reader->block_buffer + (end - size - reader->block_offset);
+}
+
+/***************************************
+ * Size of one frame in the input file,
+ * all planes stored back to back
+ ***************************************/
+uint64_t input_reader_frame_size(
+    EbConfig   *config)
+{
+    const uint64_t  color_format_shift = 3 - config->encoder_color_format;
+    const uint8_t   is16bit = (uint8_t)(config->encoder_bit_depth > 8);
+    uint64_t        luma_size = (uint64_t)config->input_padded_width * config->input_padded_height;
+
+    if (is16bit && config->compressed_ten_bit_format == 1) {
+        const uint64_t nbit_luma_size = (uint64_t)(config->input_padded_width / 4) * config->input_padded_height;
+        return luma_size + 2 * (luma_size >> color_format_shift) +
+            nbit_luma_size + 2 * (nbit_luma_size >> color_format_shift);
+    }
+    luma_size <<= is16bit;
+    return luma_size + 2 * (luma_size >> color_format_shift);
+}
+
+/***************************************
+ * Opens the reader selected by InputReader.
+ * Falls back to the stdio reader when the
+ * input cannot be mapped.
+ ***************************************/
+EbErrorType input_reader_open(
+    EbConfig   *config)
+{
+    EbInputReader  *reader;
+    InputReaderMode mode = (InputReaderMode)config->input_reader;
+
+    config->input_reader_ptr = NULL;
+    if (mode == INPUT_READER_STDIO)
+        return EB_ErrorNone;
+
+    // Frames are handed in place, so they must be stored whole and in order
+    if (config->input_file == stdin || config->separate_fields || config->buffered_input != -1) {
+        fprintf(config->error_log_file, "Warning instance %u: InputReader %u needs a progressive input file read frame by frame, using fread\n",
+            config->channel_id + 1, (uint32_t)mode);
+        return EB_ErrorNone;
+    }
+
+    reader = (EbInputReader*)calloc(1, sizeof(EbInputReader));
+    if (reader == NULL)
+        return EB_ErrorInsufficientResources;
+#ifndef _WIN32
+    reader->direct_fd = -1;
+    reader->page_size = (uint64_t)sysconf(_SC_PAGESIZE);
+#endif
+
+    reader->data_offset = (uint64_t)ftello64(config->input_file);
+    fseeko64(config->input_file, 0L, SEEK_END);
+    reader->file_size = (uint64_t)ftello64(config->input_file);
+    fseeko64(config->input_file, (long)reader->data_offset, SEEK_SET);
+    reader->position = reader->data_offset;
+
+    if (mode == INPUT_READER_DIRECT && open_direct_input_file(reader, config->input_file_name, input_reader_frame_size(config)) != EB_ErrorNone) {
+        fprintf(config->error_log_file, "Warning instance %u: direct I/O is not available for the input file, using mmap\n",
+            config->channel_id + 1);
+        mode = INPUT_READER_MMAP;
+    }
+    if (mode == INPUT_READER_MMAP && map_input_file(reader, config->input_file) != EB_ErrorNone) {
+        fprintf(config->error_log_file, "Warning instance %u: the input file cannot be mapped, using fread\n",
+            config->channel_id + 1);
+        free(reader);
+        return EB_ErrorNone;
+    }
+
+    reader->mode = mode;
+    config->input_reader_ptr = reader;
+    return EB_ErrorNone;
+}
+
+void input_reader_close(
+    EbConfig   *config)
+{
+    EbInputReader *reader = config->input_reader_ptr;
+
+    if (reader == NULL)
+        return;
+#ifdef _WIN32
+    if (reader->map_ptr)
+        UnmapViewOfFile(reader->map_ptr);
+    if (reader->mapping_handle)
+        CloseHandle(reader->mapping_handle);
+#else
+    if (reader->map_ptr)
+        munmap(reader->map_ptr, (size_t)reader->file_size);
+    if (reader->direct_fd >= 0)
+        close(reader->direct_fd);
+#endif
+    free(reader->block_buffer);
+    free(reader);
+    config->input_reader_ptr = NULL;
+}
+
+/***************************************
+ * Returns the next size bytes of the
+ * input and moves past them, NULL when
+ * fewer than size bytes are left
+ ***************************************/
+const uint8_t *input_reader_get(
+    EbInputReader  *reader,
+    uint64_t        size)
+{
+    const uint8_t *data_ptr;
+
+    if (reader->position + size > reader->file_size)
+        return NULL;
+    if (reader->mode == INPUT_READER_DIRECT)
+        return get_direct(reader, size);
+
+    data_ptr = reader->map_ptr + reader->position;
+    reader->position += size;
+#ifndef _WIN32
+    // Start reading the next frame in while this one is copied
+    if (size > reader->page_size && reader->position < reader->file_size) {
+        const uint64_t ahead = reader->position & ~(reader->page_size - 1);
+        const uint64_t ahead_size = (reader->file_size - ahead < size) ? reader->file_size - ahead : size;
+        madvise(reader->map_ptr + ahead, (size_t)ahead_size, MADV_WILLNEED);
+    }
+#endif
+    return data_ptr;
+}
+
+void input_reader_rewind(
+    EbInputReader  *reader)
+{
+    reader->position = reader->data_offset;
+}
+
+/***************************************
+ * Same check as read_y4m_frame_delimiter()
+ ***************************************/
+EbErrorType input_reader_skip_y4m_frame_delimiter(
+    EbInputReader  *reader,
+    FILE           *error_log_file)
+{
+    char           delimiter[Y4M_FRAME_DELIMITER_MAX];
+    uint32_t       length = 0;
+    const uint8_t *byte_ptr;
+
+    while (length < Y4M_FRAME_DELIMITER_MAX - 1 && (byte_ptr = input_reader_get(reader, 1)) != NULL) {
+        delimiter[length++] = (char)*byte_ptr;
+        if (*byte_ptr == '\n')
+            break;
+    }
+    if (length == 0)
+        return EB_ErrorNone;
+    delimiter[length] = '\0';
+
+    if (EB_STRCMP(delimiter, "FRAME\n") != 0) {
+        fprintf(error_log_file, "Failed to read proper y4m frame delimeter. Read broken.\n");
+        return EB_ErrorBadParameter;
+    }
+    return EB_ErrorNone;
+}
+
+/***************************************
+ * Sets the input buffer to the next frame,
+ * looping over the file like the fread path.
+ * The planes are stored back to back with
+ * the strides of the fread path, so a mapped
+ * frame is handed to the encoder in place.
+ * The aligned buffer of INPUT_READER_DIRECT
+ * is refilled by the next reads while the
+ * AsyncIo queue still holds this frame, so
+ * it is copied into the frame buffer of
+ * header_ptr instead.
+ ***************************************/
+void input_reader_read_frame(
+    EbConfig           *config,
+    uint8_t             is16bit,
+    EbBufferHeaderType *header_ptr)
+{
+    EbInputReader  *reader = config->input_reader_ptr;
+    EbSvtIOFormat  *input_ptr = (EbSvtIOFormat*)header_ptr->p_buffer;
+    const uint8_t   color_format = config->encoder_color_format;
+    const uint8_t   compressed10bit = (uint8_t)(is16bit && config->compressed_ten_bit_format == 1);
+    const uint64_t  frame_size = input_reader_frame_size(config);
+    const uint64_t  luma_size = ((uint64_t)config->input_padded_width * config->input_padded_height) << (is16bit && !compressed10bit);
+    const uint64_t  chroma_size = luma_size >> (3 - color_format);
+    const uint64_t  nbit_luma_size = compressed10bit ? (uint64_t)(config->input_padded_width / 4) * config->input_padded_height : 0;
+    const uint64_t  nbit_chroma_size = nbit_luma_size >> (3 - color_format);
+    const uint8_t  *frame_ptr;
+
+    if (config->y4m_input == EB_TRUE)
+        input_reader_skip_y4m_frame_delimiter(reader, config->error_log_file);
+    frame_ptr = input_reader_get(reader, frame_size);
+
+    if (frame_ptr == NULL) {
+        input_reader_rewind(reader);
+        if (config->y4m_input == EB_TRUE)
+            input_reader_skip_y4m_frame_delimiter(reader, config->error_log_file);
+        frame_ptr = input_reader_get(reader, frame_size);
+        if (frame_ptr == NULL) {
+            header_ptr->n_filled_len = 0;
+            return;
+        }
+    }
+
+    if (reader->mode == INPUT_READER_DIRECT) {
+        memcpy(input_ptr->luma, frame_ptr, (size_t)luma_size);
+        memcpy(input_ptr->cb, frame_ptr + luma_size, (size_t)chroma_size);
+        memcpy(input_ptr->cr, frame_ptr + luma_size + chroma_size, (size_t)chroma_size);
+        if (compressed10bit) {
+            const uint8_t *nbit_ptr = frame_ptr + luma_size + 2 * chroma_size;
+            memcpy(input_ptr->luma_ext, nbit_ptr, (size_t)nbit_luma_size);
+            memcpy(input_ptr->cb_ext, nbit_ptr + nbit_luma_size, (size_t)nbit_chroma_size);
+            memcpy(input_ptr->cr_ext, nbit_ptr + nbit_luma_size + nbit_chroma_size, (size_t)nbit_chroma_size);
+        }
+    }
+    else {
+        input_ptr->luma = (uint8_t*)frame_ptr;
+        input_ptr->cb   = input_ptr->luma + luma_size;
+        input_ptr->cr   = input_ptr->cb + chroma_size;
+        if (compressed10bit) {
+            input_ptr->luma_ext = input_ptr->cr + chroma_size;
+            input_ptr->cb_ext   = input_ptr->luma_ext + nbit_luma_size;
+            input_ptr->cr_ext   = input_ptr->cb_ext + nbit_chroma_size;
+        }
+    }
+    header_ptr->n_filled_len = (uint32_t)frame_size;
+}
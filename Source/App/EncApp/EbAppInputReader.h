@@ -0,0 +1,71 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#ifndef EbAppInputReader_h
+#define EbAppInputReader_h
+
+#include <stdint.h>
+
+#include "EbAppConfig.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+/** The InputReaderMode type selects how the raw input frames are read.
+*/
+typedef enum InputReaderMode
+{
+    INPUT_READER_STDIO  = 0,    // fread() into the app frame buffer
+    INPUT_READER_MMAP   = 1,    // memory mapped file, frames handed in place
+    INPUT_READER_DIRECT = 2     // O_DIRECT large block reads into an aligned buffer, frames copied out
+} InputReaderMode;
+
+#define INPUT_READER_DIRECT_ALIGNMENT   4096
+#define INPUT_READER_DIRECT_BLOCK_SIZE  (8 << 20)
+
+/** The EbInputReader type hands out the next bytes of the input file as a
+pointer, without copying them into the app frame buffer. The pointers of
+INPUT_READER_DIRECT are only valid until the next read.
+*/
+typedef struct EbInputReader
+{
+    InputReaderMode           mode;
+    uint64_t                  file_size;
+    uint64_t                  data_offset;        // first byte after the y4m stream header
+    uint64_t                  position;
+
+#ifdef _WIN32
+    HANDLE                    mapping_handle;
+#else
+    int32_t                   direct_fd;
+    uint64_t                  page_size;
+#endif
+    // INPUT_READER_MMAP
+    uint8_t                  *map_ptr;
+
+    // INPUT_READER_DIRECT: block_buffer holds the file bytes
+    // [block_offset, block_offset + block_filled)
+    uint8_t                  *block_buffer;
+    uint64_t                  block_buffer_size;
+    uint64_t                  block_offset;
+    uint64_t                  block_filled;
+} EbInputReader;
+
+extern uint64_t input_reader_frame_size(EbConfig *config);
+
+extern EbErrorType input_reader_open(EbConfig *config);
+
+extern void input_reader_close(EbConfig *config);
+
+extern const uint8_t *input_reader_get(EbInputReader *reader, uint64_t size);
+
+extern void input_reader_rewind(EbInputReader *reader);
+
+extern EbErrorType input_reader_skip_y4m_frame_delimiter(EbInputReader *reader, FILE *error_log_file);
+
+extern void input_reader_read_frame(EbConfig *config, uint8_t is16bit, EbBufferHeaderType *header_ptr);
+
+#endif // EbAppInputReader_h
@@ -43,6 +43,18 @@ extern AppExitConditionType ProcessInputBuffer(
     EbConfig             *config,
     EbAppContext         *appCallBack);
 
+extern EbErrorType ProcessInputBench(
+    EbConfig             *config,
+    EbAppContext         *appCallBack);
+
+extern EbErrorType StartChannelThreads(
+    EbConfig             *config,
+    EbAppContext         *appCallBack);
+
+extern AppExitConditionType WaitChannelThreads(
+    EbConfig             *config,
+    EbAppContext         *appCallBack);
+
 extern AppExitConditionType ProcessOutputReconBuffer(
     EbConfig             *config,
     EbAppContext         *appCallBack);
@@ -76,6 +88,86 @@ void AssignAppThreadGroup(uint8_t target_socket) {
 #endif
 }
 
+static const char *pipeline_stage_names[EB_PIPELINE_STAGE_COUNT] = {
+    "ResourceCoordination",
+    "PictureAnalysis",
+    "PictureDecision",
+    "MotionEstimation",
+    "InitialRateControl",
+    "SourceBasedOperations",
+    "PictureManager",
+    "RateControl",
+    "ModeDecisionConfig",
+    "EncDec",
+    "Dlf",
+    "Cdef",
+    "Rest",
+    "EntropyCoding",
+    "Packetization"
+};
+
+/***************************************
+ * Print the per-stage pipeline statistics
+ * and write the trace file if requested
+ ***************************************/
+static void PrintPipelineStats(
+    EbConfig             *config,
+    EbAppContext         *appCallBack)
+{
+    EbSvtAv1EncStats stats;
+    uint32_t         stage;
+
+    if (eb_svt_enc_get_stats(appCallBack->svt_encoder_handle, &stats) != EB_ErrorNone)
+        return;
+
+    printf("\nChannel %u Pipeline Statistics (elapsed %.0f ms, %llu pictures, max picture latency %.1f ms)\n",
+        (uint32_t)(config->channel_id + 1),
+        (double)stats.elapsed_time_us / 1000,
+        (unsigned long long)stats.picture_count,
+        (double)stats.max_picture_latency_us / 1000);
+    printf("%-22s %8s %10s %10s %10s %10s %8s\n",
+        "Stage", "Threads", "Tasks", "Util %", "Avg ms", "Max ms", "MaxQ");
+    for (stage = 0; stage < EB_PIPELINE_STAGE_COUNT; ++stage) {
+        EbPipelineStageStats *stage_stats = &stats.stage[stage];
+        double capacity_us = (double)stats.elapsed_time_us * stage_stats->thread_count;
+        printf("%-22s %8u %10llu %10.1f %10.3f %10.3f %8u\n",
+            pipeline_stage_names[stage],
+            stage_stats->thread_count,
+            (unsigned long long)stage_stats->task_count,
+            capacity_us > 0 ? 100.0 * (double)stage_stats->busy_time_us / capacity_us : 0.0,
+            stage_stats->task_count ? (double)stage_stats->busy_time_us / (1000.0 * stage_stats->task_count) : 0.0,
+            (double)stage_stats->max_task_time_us / 1000,
+            stage_stats->max_queue_depth);
+    }
+
+    if (config->trace_file_name[0] != '\0' &&
+        eb_svt_enc_write_trace(appCallBack->svt_encoder_handle, config->trace_file_name) != EB_ErrorNone)
+        printf("Error channel %u: could not write the trace file %s\n", (uint32_t)(config->channel_id + 1), config->trace_file_name);
+    fflush(stdout);
+}
+
+/***************************************
+ * Print where the channel threads spent
+ * their time: file I/O or the library
+ ***************************************/
+static void PrintIoSummary(
+    EbConfig             *config,
+    EbAppContext         *appCallBack)
+{
+    const EbAppIoStats *io_stats = &appCallBack->io_stats;
+
+    printf("\nChannel %u I/O Summary (ms)\n", (uint32_t)(config->channel_id + 1));
+    printf("Reading input               %10.0f   reader blocked on a full input queue  %10.0f\n",
+        (double)io_stats->read_time_us / 1000, (double)io_stats->read_blocked_time_us / 1000);
+    printf("Writing bitstream           %10.0f   writing recon                         %10.0f\n",
+        (double)io_stats->write_time_us / 1000, (double)io_stats->recon_write_time_us / 1000);
+    printf("In eb_svt_enc_send_picture  %10.0f   encoder waiting for the reader        %10.0f\n",
+        (double)io_stats->send_time_us / 1000, (double)io_stats->send_starved_time_us / 1000);
+    printf("In eb_svt_get_packet        %10.0f\n",
+        (double)io_stats->get_packet_time_us / 1000);
+    fflush(stdout);
+}
+
 /***************************************
  * Encoder App Main
  ***************************************/
@@ -97,12 +189,14 @@ int32_t main(int32_t argc, char* argv[])
 
 
     EbBool                 channelActive[MAX_CHANNEL_NUMBER];
+    EbBool                 channelThreaded[MAX_CHANNEL_NUMBER];
 
     EbConfig             *configs[MAX_CHANNEL_NUMBER];        // Encoder Configuration
 
     uint32_t                num_channels = 0;
     uint32_t                instanceCount=0;
     EbAppContext         *appCallbacks[MAX_CHANNEL_NUMBER];   // Instances App callback data
+    EbSvtHostContext     *host_context = NULL;                // Workers shared by the channels
     signal(SIGINT, EventHandler);
     printf("-------------------------------------------\n");
     printf("SVT-AV1 Encoder\n");
@@ -136,6 +230,7 @@ int32_t main(int32_t argc, char* argv[])
             exitConditionsRecon[instanceCount] = APP_ExitConditionError;         // Processing loop exit condition
             exitConditionsInput[instanceCount] = APP_ExitConditionError;         // Processing loop exit condition
             channelActive[instanceCount] = EB_FALSE;
+            channelThreaded[instanceCount] = EB_FALSE;
         }
 
         // Read all configuration files.
@@ -143,12 +238,38 @@ int32_t main(int32_t argc, char* argv[])
 
         // Process any command line options, including the configuration file
 
-        if (return_error == EB_ErrorNone) {
+        if (return_error == EB_ErrorNone && configs[0]->io_bench) {
+
+            // Measure the input path only, one channel after the other
+            for (instanceCount = 0; instanceCount < num_channels; ++instanceCount) {
+                if (return_errors[instanceCount] != EB_ErrorNone)
+                    continue;
+                configs[instanceCount]->channel_id = instanceCount;
+                return_errors[instanceCount] = init_input_bench(configs[instanceCount], appCallbacks[instanceCount], instanceCount);
+                if (return_errors[instanceCount] == EB_ErrorNone)
+                    return_errors[instanceCount] = ProcessInputBench(configs[instanceCount], appCallbacks[instanceCount]);
+                de_init_encoder(appCallbacks[instanceCount], instanceCount);
+                return_error = (EbErrorType)(return_error | return_errors[instanceCount]);
+            }
+        }
+        else if (return_error == EB_ErrorNone) {
 
             // Set main thread affinity
             if (configs[0]->target_socket != -1)
                 AssignAppThreadGroup(configs[0]->target_socket);
 
+            // All the channels run on a single pool of workers
+            if (configs[0]->shared_workers) {
+                EbSvtHostConfiguration host_config;
+                host_config.worker_count = configs[0]->shared_workers;
+                host_config.channel_count = num_channels;
+                host_config.max_thread_count = 0;
+                if (eb_svt_host_context_create(&host_context, &host_config) != EB_ErrorNone)
+                    printf("Could not create the shared workers, every channel runs its own threads\n");
+                for (instanceCount = 0; instanceCount < num_channels; ++instanceCount)
+                    configs[instanceCount]->host_context_ptr = host_context;
+            }
+
             // Init the Encoder
             for (instanceCount = 0; instanceCount < num_channels; ++instanceCount) {
                 if (return_errors[instanceCount] == EB_ErrorNone) {
@@ -166,6 +287,16 @@ int32_t main(int32_t argc, char* argv[])
                 }
             }
 
+            // The other channels are renditions of the first one, they take its scene changes
+            if (configs[0]->ladder && return_errors[0] == EB_ErrorNone) {
+                for (instanceCount = 1; instanceCount < num_channels; ++instanceCount) {
+                    if (return_errors[instanceCount] == EB_ErrorNone) {
+                        return_errors[instanceCount] = eb_svt_enc_attach_ladder(appCallbacks[instanceCount]->svt_encoder_handle, appCallbacks[0]->svt_encoder_handle);
+                        return_error = (EbErrorType)(return_error | return_errors[instanceCount]);
+                    }
+                }
+            }
+
             {
                 // Start the Encoder
                 for (instanceCount = 0; instanceCount < num_channels; ++instanceCount) {
@@ -193,6 +324,18 @@ int32_t main(int32_t argc, char* argv[])
                 printf("Encoding          ");
                 fflush(stdout);
 
+                // AsyncIo channels run on their own threads, the loop below polls the others
+                for (instanceCount = 0; instanceCount < num_channels; ++instanceCount) {
+                    if (channelActive[instanceCount] == EB_TRUE && configs[instanceCount]->async_io) {
+                        channelActive[instanceCount] = EB_FALSE;
+                        return_errors[instanceCount] = StartChannelThreads(configs[instanceCount], appCallbacks[instanceCount]);
+                        if (return_errors[instanceCount] == EB_ErrorNone)
+                            channelThreaded[instanceCount] = EB_TRUE;
+                        else
+                            exitConditions[instanceCount] = APP_ExitConditionError;
+                    }
+                }
+
                 while (exitCondition == APP_ExitConditionNone) {
                     exitCondition = APP_ExitConditionFinished;
                     for (instanceCount = 0; instanceCount < num_channels; ++instanceCount) {
@@ -227,6 +370,11 @@ int32_t main(int32_t argc, char* argv[])
                     }
                 }
 
+                for (instanceCount = 0; instanceCount < num_channels; ++instanceCount) {
+                    if (channelThreaded[instanceCount] == EB_TRUE)
+                        exitConditions[instanceCount] = WaitChannelThreads(configs[instanceCount], appCallbacks[instanceCount]);
+                }
+
                 for (instanceCount = 0; instanceCount < num_channels; ++instanceCount) {
                     if (exitConditions[instanceCount] == APP_ExitConditionFinished && return_errors[instanceCount] == EB_ErrorNone) {
                         double frame_rate;
@@ -289,10 +437,18 @@ int32_t main(int32_t argc, char* argv[])
                                 (uint32_t)(configs[instanceCount]->performance_context.max_latency));
 
                         }
+                        // Tile group output: how much earlier a picture starts to come out
+                        if (configs[instanceCount]->tile_group_output && configs[instanceCount]->performance_context.frame_count)
+                            printf("Average First Tile Group Latency:\t%.0f ms\n",
+                                (double)configs[instanceCount]->performance_context.total_first_fragment_latency / configs[instanceCount]->performance_context.frame_count);
                     }
                     else {
                         printf("\nChannel %u Encoding Interrupted\n", (uint32_t)(instanceCount + 1));
                     }
+                    if (channelThreaded[instanceCount] == EB_TRUE)
+                        PrintIoSummary(configs[instanceCount], appCallbacks[instanceCount]);
+                    if (configs[instanceCount]->pipeline_stats)
+                        PrintPipelineStats(configs[instanceCount], appCallbacks[instanceCount]);
                 }
                 else if (return_errors[instanceCount] == EB_ErrorInsufficientResources) {
                     printf("Could not allocate enough memory for channel %u\n", instanceCount + 1);
@@ -307,6 +463,8 @@ int32_t main(int32_t argc, char* argv[])
                 if (return_errors[instanceCount - 1] == EB_ErrorNone)
                     return_errors[instanceCount - 1] = de_init_encoder(appCallbacks[instanceCount - 1], instanceCount - 1);
             }
+            if (host_context)
+                eb_svt_host_context_destroy(host_context);
         }
         else {
             printf("Error in configuration, could not begin encoding! ... \n");
@@ -14,6 +14,7 @@
 #include "EbAppConfig.h"
 #include "EbSvtAv1ErrorCodes.h"
 #include "EbAppInputy4m.h"
+#include "EbAppInputReader.h"
 
 #include "EbSvtAv1Time.h"
 
@@ -776,6 +777,14 @@ void ReadInputFrames(
     inputPtr->cr_stride = input_padded_width >> subsampling_x;
     inputPtr->cb_stride = input_padded_width >> subsampling_x;
 
+    if (config->input_reader_ptr) {
+        input_reader_read_frame(
+            config,
+            is16bit,
+            headerPtr);
+        return;
+    }
+
     if (config->buffered_input == -1) {
         if (is16bit == 0 || (is16bit == 1 && config->compressed_ten_bit_format == 0)) {
             readSize = (uint64_t)SIZE_OF_ONE_FRAME_IN_BYTES(input_padded_width, input_padded_height, color_format, is16bit);
@@ -960,21 +969,13 @@ void SendQpOnTheFly(
     return;
 }
 
-//************************************/
-// ProcessInputBuffer
-// Reads yuv frames from file and copy
-// them into the input buffer
-/************************************/
-AppExitConditionType ProcessInputBuffer(
-    EbConfig             *config,
-    EbAppContext         *appCallBack)
+/******************************************************
+* Returns EB_TRUE while there are frames left to send
+******************************************************/
+static EbBool HasInputRemaining(
+    EbConfig             *config)
 {
     uint8_t                 is16bit = (uint8_t)(config->encoder_bit_depth > 8);
-    EbBufferHeaderType     *headerPtr = appCallBack->input_buffer_pool;
-    EbComponentType        *componentHandle = (EbComponentType*)appCallBack->svt_encoder_handle;
-
-    AppExitConditionType    return_value = APP_ExitConditionNone;
-
     const uint8_t color_format = config->encoder_color_format;
     const int64_t input_padded_width = config->input_padded_width;
     const int64_t input_padded_height = config->input_padded_height;
@@ -984,61 +985,99 @@ AppExitConditionType ProcessInputBuffer(
     uint32_t compressed10bitFrameSize = (uint32_t)((input_padded_width*input_padded_height) + 2 * ((input_padded_width*input_padded_width) >> (3 - color_format)));
     compressed10bitFrameSize += compressed10bitFrameSize / 4;
 
+    totalBytesToProcessCount = (frames_to_be_encoded < 0) ? -1 : (config->encoder_bit_depth == 10 && config->compressed_ten_bit_format == 1) ?
+        frames_to_be_encoded * (int64_t)compressed10bitFrameSize:
+        frames_to_be_encoded * SIZE_OF_ONE_FRAME_IN_BYTES(input_padded_width, input_padded_height, color_format, is16bit);
+
+    remainingByteCount       = (totalBytesToProcessCount < 0) ?   -1 :  totalBytesToProcessCount - (int64_t)config->processed_byte_count;
+
+    return (EbBool)(remainingByteCount != 0 && config->stop_encoder == EB_FALSE);
+}
+
+/******************************************************
+* Reads the next frame and fills in the header.
+* Returns EB_TRUE for the last picture of the stream
+******************************************************/
+static EbBool ReadInputPicture(
+    EbConfig             *config,
+    EbBufferHeaderType   *headerPtr)
+{
+    uint8_t                 is16bit = (uint8_t)(config->encoder_bit_depth > 8);
+
     if (config->injector && config->processed_frame_count)
     {
         EbInjector(config->processed_frame_count, config->injector_frame_rate);
     }
 
-    totalBytesToProcessCount = (frames_to_be_encoded < 0) ? -1 : (config->encoder_bit_depth == 10 && config->compressed_ten_bit_format == 1) ?
-        frames_to_be_encoded * (int64_t)compressed10bitFrameSize:
-        frames_to_be_encoded * SIZE_OF_ONE_FRAME_IN_BYTES(input_padded_width, input_padded_height, color_format, is16bit);
+    ReadInputFrames(
+        config,
+        is16bit,
+        headerPtr);
 
-    remainingByteCount       = (totalBytesToProcessCount < 0) ?   -1 :  totalBytesToProcessCount - (int64_t)config->processed_byte_count;
+    // Update the context parameters
+    config->processed_byte_count += headerPtr->n_filled_len;
+    headerPtr->p_app_private          = (EbPtr)EB_NULL;
+    config->frames_encoded           = (int32_t)(++config->processed_frame_count);
 
-    // If there are bytes left to encode, configure the header
-    if (remainingByteCount != 0 && config->stop_encoder == EB_FALSE) {
-        ReadInputFrames(
+    // Configuration parameters changed on the fly
+    if (config->use_qp_file && config->qp_file)
+        SendQpOnTheFly(
             config,
-            is16bit,
             headerPtr);
 
-        // Update the context parameters
-        config->processed_byte_count += headerPtr->n_filled_len;
-        headerPtr->p_app_private          = (EbPtr)EB_NULL;
-        config->frames_encoded           = (int32_t)(++config->processed_frame_count);
+    if (keepRunning == 0 && !config->stop_encoder) {
+        config->stop_encoder = EB_TRUE;
+    }
 
-        // Configuration parameters changed on the fly
-        if (config->use_qp_file && config->qp_file)
-            SendQpOnTheFly(
-                config,
-                headerPtr);
+    // Fill in Buffers Header control data
+    headerPtr->pts          = config->processed_frame_count-1;
+    headerPtr->pic_type    = EB_AV1_INVALID_PICTURE;
 
-        if (keepRunning == 0 && !config->stop_encoder) {
-            config->stop_encoder = EB_TRUE;
-        }
+    headerPtr->flags = 0;
 
-        // Fill in Buffers Header control data
-        headerPtr->pts          = config->processed_frame_count-1;
-        headerPtr->pic_type    = EB_AV1_INVALID_PICTURE;
+    return (EbBool)((config->processed_frame_count == (uint64_t)config->frames_to_be_encoded) || config->stop_encoder);
+}
 
-        headerPtr->flags = 0;
+static void SendEndOfStream(
+    EbComponentType      *componentHandle,
+    EbBufferHeaderType   *headerPtr)
+{
+    headerPtr->n_alloc_len    = 0;
+    headerPtr->n_filled_len   = 0;
+    headerPtr->n_tick_count   = 0;
+    headerPtr->p_app_private  = NULL;
+    headerPtr->flags       = EB_BUFFERFLAG_EOS;
+    headerPtr->p_buffer      = NULL;
+    headerPtr->pic_type    = EB_AV1_INVALID_PICTURE;
+
+    eb_svt_enc_send_picture(componentHandle, headerPtr);
+}
 
-        // Send the picture
-        eb_svt_enc_send_picture(componentHandle, headerPtr);
+//************************************/
+// ProcessInputBuffer
+// Reads yuv frames from file and copy
+// them into the input buffer
+/************************************/
+AppExitConditionType ProcessInputBuffer(
+    EbConfig             *config,
+    EbAppContext         *appCallBack)
+{
+    EbBufferHeaderType     *headerPtr = appCallBack->input_buffer_pool;
+    EbComponentType        *componentHandle = (EbComponentType*)appCallBack->svt_encoder_handle;
 
-        if ((config->processed_frame_count == (uint64_t)config->frames_to_be_encoded) || config->stop_encoder) {
+    AppExitConditionType    return_value = APP_ExitConditionNone;
 
-            headerPtr->n_alloc_len    = 0;
-            headerPtr->n_filled_len   = 0;
-            headerPtr->n_tick_count   = 0;
-            headerPtr->p_app_private  = NULL;
-            headerPtr->flags       = EB_BUFFERFLAG_EOS;
-            headerPtr->p_buffer      = NULL;
-            headerPtr->pic_type    = EB_AV1_INVALID_PICTURE;
+    // If there are bytes left to encode, configure the header
+    if (HasInputRemaining(config)) {
+        const EbBool lastPicture = ReadInputPicture(
+            config,
+            headerPtr);
 
-            eb_svt_enc_send_picture(componentHandle, headerPtr);
+        // Send the picture
+        eb_svt_enc_send_picture(componentHandle, headerPtr);
 
-        }
+        if (lastPicture)
+            SendEndOfStream(componentHandle, headerPtr);
 
         return_value = (headerPtr->flags == EB_BUFFERFLAG_EOS) ? APP_ExitConditionFinished : return_value;
 
@@ -1047,6 +1086,77 @@ AppExitConditionType ProcessInputBuffer(
     return return_value;
 }
 
+//************************************/
+// ProcessInputBench
+// Reads the input frames and copies them
+// once, as the encoder input stage does,
+// without encoding, and reports the
+// ingest throughput
+/************************************/
+EbErrorType ProcessInputBench(
+    EbConfig             *config,
+    EbAppContext         *appCallBack)
+{
+    static const char      *readerNames[] = { "fread", "mmap", "direct" };
+    uint8_t                 is16bit = (uint8_t)(config->encoder_bit_depth > 8);
+    EbBufferHeaderType     *headerPtr = appCallBack->input_buffer_pool;
+    EbSvtIOFormat          *inputPtr = (EbSvtIOFormat*)headerPtr->p_buffer;
+    const uint8_t           color_format = config->encoder_color_format;
+    const uint8_t           compressed10bit = (uint8_t)(is16bit && config->compressed_ten_bit_format == 1);
+    const uint64_t          frameSize = input_reader_frame_size(config);
+    const uint64_t          lumaSize = ((uint64_t)config->input_padded_width * config->input_padded_height) << (is16bit && !compressed10bit);
+    const uint64_t          chromaSize = lumaSize >> (3 - color_format);
+    const uint64_t          nbitLumaSize = compressed10bit ? (uint64_t)(config->input_padded_width / 4) * config->input_padded_height : 0;
+    const uint64_t          nbitChromaSize = nbitLumaSize >> (3 - color_format);
+    const InputReaderMode   mode = config->input_reader_ptr ? config->input_reader_ptr->mode : INPUT_READER_STDIO;
+    uint8_t                *copyBuffer;
+    uint64_t                startSeconds, startUSeconds, finishSeconds, finishUSeconds;
+    double                  duration;
+
+    copyBuffer = (uint8_t*)malloc((size_t)frameSize);
+    if (copyBuffer == NULL)
+        return EB_ErrorInsufficientResources;
+
+    EbStartTime(&startSeconds, &startUSeconds);
+    while (config->processed_frame_count < (uint64_t)config->frames_to_be_encoded && keepRunning) {
+        ReadInputFrames(
+            config,
+            is16bit,
+            headerPtr);
+
+        memcpy(copyBuffer, inputPtr->luma, (size_t)lumaSize);
+        memcpy(copyBuffer + lumaSize, inputPtr->cb, (size_t)chromaSize);
+        memcpy(copyBuffer + lumaSize + chromaSize, inputPtr->cr, (size_t)chromaSize);
+        if (compressed10bit) {
+            uint8_t *extPtr = copyBuffer + lumaSize + 2 * chromaSize;
+            memcpy(extPtr, inputPtr->luma_ext, (size_t)nbitLumaSize);
+            memcpy(extPtr + nbitLumaSize, inputPtr->cb_ext, (size_t)nbitChromaSize);
+            memcpy(extPtr + nbitLumaSize + nbitChromaSize, inputPtr->cr_ext, (size_t)nbitChromaSize);
+        }
+
+        config->processed_byte_count += headerPtr->n_filled_len;
+        config->processed_frame_count++;
+    }
+    EbFinishTime(&finishSeconds, &finishUSeconds);
+    EbComputeOverallElapsedTime(startSeconds, startUSeconds, finishSeconds, finishUSeconds, &duration);
+
+    printf("\nChannel %u Input Bench (%s): %llu frames, %.3f GB in %.3f sec",
+        (uint32_t)(config->channel_id + 1),
+        readerNames[mode],
+        (unsigned long long)config->processed_frame_count,
+        (double)config->processed_byte_count / 1e9,
+        duration);
+    if (duration > 0)
+        printf(", %.2f GB/s, %.1f fps",
+            (double)config->processed_byte_count / (1e9 * duration),
+            (double)config->processed_frame_count / duration);
+    printf("\n");
+    fflush(stdout);
+
+    free(copyBuffer);
+    return EB_ErrorNone;
+}
+
 #define LONG_ENCODE_FRAME_ENCODE    4000
 #define SPEED_MEASUREMENT_INTERVAL  2000
 #define START_STEADY_STATE          1000
@@ -1159,9 +1269,11 @@ AppExitConditionType ProcessOutputStreamBuffer(
     // Local variables
     uint64_t                finishsTime     = 0;
     uint64_t                finishuTime     = 0;
+    uint64_t                startTimeUs     = app_get_time_us();
 
     // non-blocking call until all input frames are sent
     stream_status = eb_svt_get_packet(componentHandle, &headerPtr, pic_send_done);
+    appCallBack->io_stats.get_packet_time_us += app_get_time_us() - startTimeUs;
 
     if (stream_status == EB_ErrorMax) {
         printf("\n");
@@ -1173,9 +1285,20 @@ AppExitConditionType ProcessOutputStreamBuffer(
     else if (stream_status != EB_NoErrorEmptyQueue) {
         EbBool   has_tiles                = (EbBool)(appCallBack->eb_enc_parameters.tile_columns || appCallBack->eb_enc_parameters.tile_rows);
         uint8_t  obu_frame_header_size    = has_tiles ? OBU_FRAME_HEADER_SIZE + 1 : OBU_FRAME_HEADER_SIZE;
-        ++(config->performance_context.frame_count);
-        *total_latency += (uint64_t)headerPtr->n_tick_count;
-        *max_latency = (headerPtr->n_tick_count > *max_latency) ? headerPtr->n_tick_count : *max_latency;
+        // With tile group output, a picture can take several packets
+        EbBool   picture_done             = (EbBool)(!config->tile_group_output ||
+            (headerPtr->flags & (EB_BUFFERFLAG_LAST_FRAGMENT | EB_BUFFERFLAG_PASS_STATS)));
+
+        if (config->tile_group_output && !config->performance_context.first_fragment_received) {
+            config->performance_context.total_first_fragment_latency += (uint64_t)headerPtr->n_tick_count;
+            config->performance_context.first_fragment_received = EB_TRUE;
+        }
+        if (picture_done) {
+            config->performance_context.first_fragment_received = EB_FALSE;
+            ++(config->performance_context.frame_count);
+            *total_latency += (uint64_t)headerPtr->n_tick_count;
+            *max_latency = (headerPtr->n_tick_count > *max_latency) ? headerPtr->n_tick_count : *max_latency;
+        }
 
         EbFinishTime((uint64_t*)&finishsTime, (uint64_t*)&finishuTime);
 
@@ -1196,8 +1319,15 @@ AppExitConditionType ProcessOutputStreamBuffer(
             &config->performance_context.total_encode_time);
 
         // Write Stream Data to file
-        if (streamFile) {
-            if (config->performance_context.frame_count == 1){
+        startTimeUs = app_get_time_us();
+        if (headerPtr->flags & EB_BUFFERFLAG_PASS_STATS) {
+            // First pass: the statistics of one picture, no bitstream
+            if (config->stats_file)
+                fwrite(headerPtr->p_buffer, 1, headerPtr->n_filled_len, config->stats_file);
+        }
+        else if (streamFile) {
+            // Before the first packet, which may be a tile group of the first picture
+            if (config->performance_context.byte_count == 0){
                 write_ivf_stream_header(config);
             }
 
@@ -1256,6 +1386,7 @@ AppExitConditionType ProcessOutputStreamBuffer(
                     break;
             }
         }
+        appCallBack->io_stats.write_time_us += app_get_time_us() - startTimeUs;
         config->performance_context.byte_count += headerPtr->n_filled_len;
 
         // Update Output Port Activity State
@@ -1265,6 +1396,9 @@ AppExitConditionType ProcessOutputStreamBuffer(
         // Release the output buffer
         eb_svt_release_out_buffer(&headerPtr);
 
+        if (!picture_done)
+            return return_value;
+
 #if DEADLOCK_DEBUG
         ++frame_count;
 #else
@@ -1309,6 +1443,7 @@ AppExitConditionType ProcessOutputReconBuffer(
         return APP_ExitConditionError;
     }
     else if (recon_status != EB_NoErrorEmptyQueue) {
+        const uint64_t startTimeUs = app_get_time_us();
         //Sets the File position to the beginning of the file.
         rewind(config->recon_file);
         uint64_t frameNum = headerPtr->pts;
@@ -1323,6 +1458,7 @@ AppExitConditionType ProcessOutputReconBuffer(
         }
 
         fwrite(headerPtr->p_buffer, 1, headerPtr->n_filled_len, config->recon_file);
+        appCallBack->io_stats.recon_write_time_us += app_get_time_us() - startTimeUs;
 
         // Update Output Port Activity State
         return_value = (headerPtr->flags & EB_BUFFERFLAG_EOS) ? APP_ExitConditionFinished : APP_ExitConditionNone;
@@ -1330,3 +1466,149 @@ AppExitConditionType ProcessOutputReconBuffer(
     return return_value;
 }
 
+/***************************************
+ * Channel threads (AsyncIo)
+ *   reader : input file -> input_ready_queue
+ *   feeder : input_ready_queue -> eb_svt_enc_send_picture
+ *   writer : blocking eb_svt_get_packet -> bitstream file
+ *   recon  : eb_svt_get_recon -> recon file
+ * A slow file of one channel only stalls the
+ * threads of that channel.
+ ***************************************/
+static void* InputReaderKernel(void *input_ptr)
+{
+    EbAppContext           *appCallBack = (EbAppContext*)input_ptr;
+    EbConfig               *config = appCallBack->config;
+    EbBufferHeaderType     *headerPtr;
+    EbBool                  lastPicture = EB_FALSE;
+
+    while (!lastPicture && HasInputRemaining(config)) {
+        uint64_t startTimeUs;
+
+        // Blocks while the encoder is INPUT_QUEUE_DEPTH frames behind
+        appCallBack->io_stats.read_blocked_time_us += app_queue_pop(&appCallBack->input_free_queue, (void**)&headerPtr);
+
+        startTimeUs = app_get_time_us();
+        lastPicture = ReadInputPicture(
+            config,
+            headerPtr);
+        appCallBack->io_stats.read_time_us += app_get_time_us() - startTimeUs;
+
+        app_queue_push(&appCallBack->input_ready_queue, headerPtr);
+    }
+
+    // NULL ends the stream
+    app_queue_push(&appCallBack->input_ready_queue, NULL);
+    return NULL;
+}
+
+static void* InputFeederKernel(void *input_ptr)
+{
+    EbAppContext           *appCallBack = (EbAppContext*)input_ptr;
+    EbComponentType        *componentHandle = (EbComponentType*)appCallBack->svt_encoder_handle;
+    EbBufferHeaderType     *headerPtr;
+    EbBufferHeaderType      eosHeader;
+
+    for (;;) {
+        uint64_t startTimeUs;
+
+        appCallBack->io_stats.send_starved_time_us += app_queue_pop(&appCallBack->input_ready_queue, (void**)&headerPtr);
+        if (headerPtr == NULL)
+            break;
+
+        // The picture is copied into the encoder pool before returning
+        startTimeUs = app_get_time_us();
+        eb_svt_enc_send_picture(componentHandle, headerPtr);
+        appCallBack->io_stats.send_time_us += app_get_time_us() - startTimeUs;
+
+        app_queue_push(&appCallBack->input_free_queue, headerPtr);
+    }
+
+    memset(&eosHeader, 0, sizeof(EbBufferHeaderType));
+    eosHeader.size = sizeof(EbBufferHeaderType);
+    SendEndOfStream(componentHandle, &eosHeader);
+    appCallBack->input_exit_condition = APP_ExitConditionFinished;
+    return NULL;
+}
+
+static void* OutputWriterKernel(void *input_ptr)
+{
+    EbAppContext           *appCallBack = (EbAppContext*)input_ptr;
+    EbConfig               *config = appCallBack->config;
+    AppExitConditionType    exitCondition = APP_ExitConditionNone;
+
+    // Blocking get_packet: the thread sleeps until the next packet
+    while (exitCondition == APP_ExitConditionNone)
+        exitCondition = ProcessOutputStreamBuffer(config, appCallBack, 1);
+
+    // Stop feeding an encoder that failed
+    if (exitCondition == APP_ExitConditionError)
+        config->stop_encoder = EB_TRUE;
+    appCallBack->output_exit_condition = exitCondition;
+    return NULL;
+}
+
+static void* ReconWriterKernel(void *input_ptr)
+{
+    EbAppContext           *appCallBack = (EbAppContext*)input_ptr;
+    EbConfig               *config = appCallBack->config;
+    AppExitConditionType    exitCondition = APP_ExitConditionNone;
+
+    // eb_svt_get_recon does not block, poll it without spinning
+    while (exitCondition == APP_ExitConditionNone) {
+        appCallBack->recon_buffer->n_filled_len = 0;
+        exitCondition = ProcessOutputReconBuffer(config, appCallBack);
+        if (exitCondition == APP_ExitConditionNone && appCallBack->recon_buffer->n_filled_len == 0)
+            EbSleep(1);
+    }
+    appCallBack->recon_exit_condition = exitCondition;
+    return NULL;
+}
+
+EbErrorType StartChannelThreads(
+    EbConfig             *config,
+    EbAppContext         *appCallBack)
+{
+    EbErrorType     return_error;
+    uint32_t        slotIndex;
+
+    appCallBack->config = config;
+    appCallBack->input_exit_condition = APP_ExitConditionError;
+    appCallBack->output_exit_condition = APP_ExitConditionError;
+    appCallBack->recon_exit_condition = config->recon_file ? APP_ExitConditionError : APP_ExitConditionFinished;
+    memset(&appCallBack->io_stats, 0, sizeof(EbAppIoStats));
+
+    return_error = app_queue_ctor(&appCallBack->input_free_queue, APP_INPUT_QUEUE_DEPTH);
+    if (return_error == EB_ErrorNone)
+        return_error = app_queue_ctor(&appCallBack->input_ready_queue, APP_INPUT_QUEUE_DEPTH);
+    if (return_error != EB_ErrorNone)
+        return return_error;
+    for (slotIndex = 0; slotIndex < APP_INPUT_QUEUE_DEPTH; ++slotIndex)
+        app_queue_push(&appCallBack->input_free_queue, appCallBack->input_slot_array[slotIndex]);
+
+    return_error = app_thread_create(&appCallBack->writer_thread, OutputWriterKernel, appCallBack);
+    if (return_error == EB_ErrorNone && config->recon_file)
+        return_error = app_thread_create(&appCallBack->recon_thread, ReconWriterKernel, appCallBack);
+    if (return_error == EB_ErrorNone)
+        return_error = app_thread_create(&appCallBack->feeder_thread, InputFeederKernel, appCallBack);
+    if (return_error == EB_ErrorNone)
+        return_error = app_thread_create(&appCallBack->reader_thread, InputReaderKernel, appCallBack);
+
+    return return_error;
+}
+
+AppExitConditionType WaitChannelThreads(
+    EbConfig             *config,
+    EbAppContext         *appCallBack)
+{
+    app_thread_join(appCallBack->reader_thread);
+    app_thread_join(appCallBack->feeder_thread);
+    app_thread_join(appCallBack->writer_thread);
+    if (config->recon_file)
+        app_thread_join(appCallBack->recon_thread);
+
+    app_queue_dtor(&appCallBack->input_ready_queue);
+    app_queue_dtor(&appCallBack->input_free_queue);
+
+    return (AppExitConditionType)(appCallBack->input_exit_condition | appCallBack->output_exit_condition | appCallBack->recon_exit_condition);
+}
@@ -0,0 +1,159 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#include <stdlib.h>
+#include <time.h>
+
+#include "EbAppThreads.h"
+
+/***************************************
+ * Monotonic time in us
+ ***************************************/
+uint64_t app_get_time_us(void)
+{
+#ifdef _WIN32
+    static LARGE_INTEGER    frequency;
+    LARGE_INTEGER           count;
+
+    if (frequency.QuadPart == 0)
+        QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&count);
+    return (uint64_t)(count.QuadPart / frequency.QuadPart) * 1000000 +
+        (uint64_t)(count.QuadPart % frequency.QuadPart) * 1000000 / (uint64_t)frequency.QuadPart;
+#else
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000 + (uint64_t)now.tv_nsec / 1000;
+#endif
+}
+
+/***************************************
+ * Threads
+ ***************************************/
+EbErrorType app_thread_create(
+    AppThread  *thread_ptr,
+    void     *(*thread_function)(void *),
+    void       *thread_context)
+{
+#ifdef _WIN32
+    *thread_ptr = CreateThread(NULL, 0, (LPTHREAD_START_ROUTINE)thread_function, thread_context, 0, NULL);
+    return (*thread_ptr != NULL) ? EB_ErrorNone : EB_ErrorInsufficientResources;
+#else
+    return pthread_create(thread_ptr, NULL, thread_function, thread_context) == 0 ?
+        EB_ErrorNone : EB_ErrorInsufficientResources;
+#endif
+}
+
+void app_thread_join(
+    AppThread   thread)
+{
+#ifdef _WIN32
+    WaitForSingleObject(thread, INFINITE);
+    CloseHandle(thread);
+#else
+    pthread_join(thread, NULL);
+#endif
+}
+
+/***************************************
+ * Bounded blocking queue
+ ***************************************/
+EbErrorType app_queue_ctor(
+    AppQueue   *queue_ptr,
+    uint32_t    depth)
+{
+    if (depth == 0 || depth > APP_QUEUE_MAX_DEPTH)
+        return EB_ErrorBadParameter;
+
+    queue_ptr->depth = depth;
+    queue_ptr->head = 0;
+    queue_ptr->count = 0;
+#ifdef _WIN32
+    InitializeSRWLock(&queue_ptr->mutex);
+    InitializeConditionVariable(&queue_ptr->not_empty);
+    InitializeConditionVariable(&queue_ptr->not_full);
+#else
+    if (pthread_mutex_init(&queue_ptr->mutex, NULL) != 0)
+        return EB_ErrorInsufficientResources;
+    if (pthread_cond_init(&queue_ptr->not_empty, NULL) != 0) {
+        pthread_mutex_destroy(&queue_ptr->mutex);
+        return EB_ErrorInsufficientResources;
+    }
+    if (pthread_cond_init(&queue_ptr->not_full, NULL) != 0) {
+        pthread_cond_destroy(&queue_ptr->not_empty);
+        pthread_mutex_destroy(&queue_ptr->mutex);
+        return EB_ErrorInsufficientResources;
+    }
+#endif
+    return EB_ErrorNone;
+}
+
+void app_queue_dtor(
+    AppQueue   *queue_ptr)
+{
+#ifndef _WIN32
+    pthread_cond_destroy(&queue_ptr->not_full);
+    pthread_cond_destroy(&queue_ptr->not_empty);
+    pthread_mutex_destroy(&queue_ptr->mutex);
+#else
+    (void)queue_ptr;
+#endif
+}
+
+#ifdef _WIN32
+#define APP_QUEUE_LOCK(queue_ptr)           AcquireSRWLockExclusive(&(queue_ptr)->mutex)
+#define APP_QUEUE_UNLOCK(queue_ptr)         ReleaseSRWLockExclusive(&(queue_ptr)->mutex)
+#define APP_QUEUE_WAIT(queue_ptr, cond)     SleepConditionVariableSRW(&(queue_ptr)->cond, &(queue_ptr)->mutex, INFINITE, 0)
+#define APP_QUEUE_SIGNAL(queue_ptr, cond)   WakeConditionVariable(&(queue_ptr)->cond)
+#else
+#define APP_QUEUE_LOCK(queue_ptr)           pthread_mutex_lock(&(queue_ptr)->mutex)
+#define APP_QUEUE_UNLOCK(queue_ptr)         pthread_mutex_unlock(&(queue_ptr)->mutex)
+#define APP_QUEUE_WAIT(queue_ptr, cond)     pthread_cond_wait(&(queue_ptr)->cond, &(queue_ptr)->mutex)
+#define APP_QUEUE_SIGNAL(queue_ptr, cond)   pthread_cond_signal(&(queue_ptr)->cond)
+#endif
+
+uint64_t app_queue_push(
+    AppQueue   *queue_ptr,
+    void       *entry_ptr)
+{
+    uint64_t blocked_time_us = 0;
+
+    APP_QUEUE_LOCK(queue_ptr);
+    if (queue_ptr->count == queue_ptr->depth) {
+        const uint64_t start_time_us = app_get_time_us();
+        while (queue_ptr->count == queue_ptr->depth)
+            APP_QUEUE_WAIT(queue_ptr, not_full);
+        blocked_time_us = app_get_time_us() - start_time_us;
+    }
+    queue_ptr->entry_array[(queue_ptr->head + queue_ptr->count) % queue_ptr->depth] = entry_ptr;
+    queue_ptr->count++;
+    APP_QUEUE_SIGNAL(queue_ptr, not_empty);
+    APP_QUEUE_UNLOCK(queue_ptr);
+
+    return blocked_time_us;
+}
+
+uint64_t app_queue_pop(
+    AppQueue   *queue_ptr,
+    void      **entry_dbl_ptr)
+{
+    uint64_t blocked_time_us = 0;
+
+    APP_QUEUE_LOCK(queue_ptr);
+    if (queue_ptr->count == 0) {
+        const uint64_t start_time_us = app_get_time_us();
+        while (queue_ptr->count == 0)
+            APP_QUEUE_WAIT(queue_ptr, not_empty);
+        blocked_time_us = app_get_time_us() - start_time_us;
+    }
+    *entry_dbl_ptr = queue_ptr->entry_array[queue_ptr->head];
+    queue_ptr->head = (queue_ptr->head + 1) % queue_ptr->depth;
+    queue_ptr->count--;
+    APP_QUEUE_SIGNAL(queue_ptr, not_full);
+    APP_QUEUE_UNLOCK(queue_ptr);
+
+    return blocked_time_us;
+}
@@ -0,0 +1,58 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#ifndef EbAppThreads_h
+#define EbAppThreads_h
+
+#include <stdint.h>
+
+#include "EbSvtAv1Enc.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+#ifdef _WIN32
+typedef HANDLE              AppThread;
+typedef SRWLOCK             AppMutex;
+typedef CONDITION_VARIABLE  AppCondition;
+#else
+typedef pthread_t           AppThread;
+typedef pthread_mutex_t     AppMutex;
+typedef pthread_cond_t      AppCondition;
+#endif
+
+#define APP_QUEUE_MAX_DEPTH 16
+
+/** The AppQueue type is a bounded, blocking FIFO of pointers shared by two
+threads of a channel.
+*/
+typedef struct AppQueue
+{
+    AppMutex                  mutex;
+    AppCondition              not_empty;
+    AppCondition              not_full;
+    void                     *entry_array[APP_QUEUE_MAX_DEPTH];
+    uint32_t                  depth;
+    uint32_t                  head;
+    uint32_t                  count;
+} AppQueue;
+
+extern uint64_t app_get_time_us(void);
+
+extern EbErrorType app_thread_create(AppThread *thread_ptr, void *(*thread_function)(void *), void *thread_context);
+extern void app_thread_join(AppThread thread);
+
+extern EbErrorType app_queue_ctor(AppQueue *queue_ptr, uint32_t depth);
+extern void app_queue_dtor(AppQueue *queue_ptr);
+
+// Both block while the queue is full (push) or empty (pop), and return the
+// time spent blocked in us
+extern uint64_t app_queue_push(AppQueue *queue_ptr, void *entry_ptr);
+extern uint64_t app_queue_pop(AppQueue *queue_ptr, void **entry_dbl_ptr);
+
+#endif // EbAppThreads_h
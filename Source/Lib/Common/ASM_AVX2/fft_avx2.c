@@ -14,10 +14,54 @@
 #include "EbDefinitions.h"
 #include "fft_common.h"
 
-extern void aom_transpose_float_sse2(const float *A, float *B, int32_t n);
 extern void aom_fft_unpack_2d_output_sse2(const float *col_fft, float *output,
     int32_t n);
 
+static INLINE void transpose8x8(const float *A, float *B, const int32_t lda,
+    const int32_t ldb) {
+    const __m256 r0 = _mm256_load_ps(&A[0 * lda]);
+    const __m256 r1 = _mm256_load_ps(&A[1 * lda]);
+    const __m256 r2 = _mm256_load_ps(&A[2 * lda]);
+    const __m256 r3 = _mm256_load_ps(&A[3 * lda]);
+    const __m256 r4 = _mm256_load_ps(&A[4 * lda]);
+    const __m256 r5 = _mm256_load_ps(&A[5 * lda]);
+    const __m256 r6 = _mm256_load_ps(&A[6 * lda]);
+    const __m256 r7 = _mm256_load_ps(&A[7 * lda]);
+    const __m256 t0 = _mm256_unpacklo_ps(r0, r1);
+    const __m256 t1 = _mm256_unpackhi_ps(r0, r1);
+    const __m256 t2 = _mm256_unpacklo_ps(r2, r3);
+    const __m256 t3 = _mm256_unpackhi_ps(r2, r3);
+    const __m256 t4 = _mm256_unpacklo_ps(r4, r5);
+    const __m256 t5 = _mm256_unpackhi_ps(r4, r5);
+    const __m256 t6 = _mm256_unpacklo_ps(r6, r7);
+    const __m256 t7 = _mm256_unpackhi_ps(r6, r7);
+    const __m256 s0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+    const __m256 s1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+    const __m256 s2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+    const __m256 s3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+    const __m256 s4 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(1, 0, 1, 0));
+    const __m256 s5 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(3, 2, 3, 2));
+    const __m256 s6 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(1, 0, 1, 0));
+    const __m256 s7 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(3, 2, 3, 2));
+    _mm256_store_ps(&B[0 * ldb], _mm256_permute2f128_ps(s0, s4, 0x20));
+    _mm256_store_ps(&B[1 * ldb], _mm256_permute2f128_ps(s1, s5, 0x20));
+    _mm256_store_ps(&B[2 * ldb], _mm256_permute2f128_ps(s2, s6, 0x20));
+    _mm256_store_ps(&B[3 * ldb], _mm256_permute2f128_ps(s3, s7, 0x20));
+    _mm256_store_ps(&B[4 * ldb], _mm256_permute2f128_ps(s0, s4, 0x31));
+    _mm256_store_ps(&B[5 * ldb], _mm256_permute2f128_ps(s1, s5, 0x31));
+    _mm256_store_ps(&B[6 * ldb], _mm256_permute2f128_ps(s2, s6, 0x31));
+    _mm256_store_ps(&B[7 * ldb], _mm256_permute2f128_ps(s3, s7, 0x31));
+}
+
+// n is a multiple of 8
+static void transpose_float_avx2(const float *A, float *B, int32_t n) {
+    for (int32_t y = 0; y < n; y += 8) {
+        for (int32_t x = 0; x < n; x += 8) {
+            transpose8x8(A + y * n + x, B + x * n + y, n, n);
+        }
+    }
+}
+
 // Generate the 1d forward transforms for float using _mm256
 GEN_FFT_8(static INLINE void, avx2, float, __m256, _mm256_load_ps,
     _mm256_store_ps, _mm256_set1_ps, _mm256_add_ps, _mm256_sub_ps,
@@ -31,17 +75,17 @@ GEN_FFT_32(static INLINE void, avx2, float, __m256, _mm256_load_ps,
 
 void aom_fft8x8_float_avx2(const float *input, float *temp, float *output) {
     aom_fft_2d_gen(input, temp, output, 8, aom_fft1d_8_avx2,
-        aom_transpose_float_sse2, aom_fft_unpack_2d_output_sse2, 8);
+        transpose_float_avx2, aom_fft_unpack_2d_output_sse2, 8);
 }
 
 void aom_fft16x16_float_avx2(const float *input, float *temp, float *output) {
     aom_fft_2d_gen(input, temp, output, 16, aom_fft1d_16_avx2,
-        aom_transpose_float_sse2, aom_fft_unpack_2d_output_sse2, 8);
+        transpose_float_avx2, aom_fft_unpack_2d_output_sse2, 8);
 }
 
 void aom_fft32x32_float_avx2(const float *input, float *temp, float *output) {
     aom_fft_2d_gen(input, temp, output, 32, aom_fft1d_32_avx2,
-        aom_transpose_float_sse2, aom_fft_unpack_2d_output_sse2, 8);
+        transpose_float_avx2, aom_fft_unpack_2d_output_sse2, 8);
 }
 
 // Generate the 1d inverse transforms for float using _mm256
@@ -57,17 +101,17 @@ GEN_IFFT_32(static INLINE void, avx2, float, __m256, _mm256_load_ps,
 
 void aom_ifft8x8_float_avx2(const float *input, float *temp, float *output) {
     aom_ifft_2d_gen(input, temp, output, 8, aom_fft1d_8_float, aom_fft1d_8_avx2,
-        aom_ifft1d_8_avx2, aom_transpose_float_sse2, 8);
+        aom_ifft1d_8_avx2, transpose_float_avx2, 8);
 }
 
 void aom_ifft16x16_float_avx2(const float *input, float *temp, float *output) {
     aom_ifft_2d_gen(input, temp, output, 16, aom_fft1d_16_float,
         aom_fft1d_16_avx2, aom_ifft1d_16_avx2,
-        aom_transpose_float_sse2, 8);
+        transpose_float_avx2, 8);
 }
 
 void aom_ifft32x32_float_avx2(const float *input, float *temp, float *output) {
     aom_ifft_2d_gen(input, temp, output, 32, aom_fft1d_32_float,
         aom_fft1d_32_avx2, aom_ifft1d_32_avx2,
-        aom_transpose_float_sse2, 8);
+        transpose_float_avx2, 8);
 }
@@ -0,0 +1,229 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+// The kernels of the film grain denoising and noise modeling match their C
+// versions bit for bit: every lane does the operations of one C iteration in
+// the same order, and no product is fused into an addition (the file is built
+// without floating point contraction, see CMakeLists.txt).
+
+#include <immintrin.h>
+
+#include "EbDefinitions.h"
+#include "aom_dsp_rtcd.h"
+
+#define FLAT_BLOCK_MAX_SIZE 64
+
+void aom_noise_tx_filter_block_avx2(float *tx_block, const float *psd, int32_t n) {
+    const float kBeta = 1.1f;
+    const float kEps = 1e-6f;
+    const __m256 beta = _mm256_set1_ps(kBeta);
+    const __m256 eps = _mm256_set1_ps(kEps);
+    const __m256 attenuation = _mm256_set1_ps((kBeta - 1.0f) / kBeta);
+    int32_t i = 0;
+
+    // 8 complex coefficients, interleaved real and imaginary parts
+    for (; i + 8 <= n; i += 8) {
+        const __m256 c0 = _mm256_loadu_ps(tx_block + 2 * i);
+        const __m256 c1 = _mm256_loadu_ps(tx_block + 2 * i + 8);
+        // Powers in the order 0 1 4 5 2 3 6 7, as are the PSD and the gains
+        const __m256 p = _mm256_hadd_ps(_mm256_mul_ps(c0, c0), _mm256_mul_ps(c1, c1));
+        const __m256 q = _mm256_castpd_ps(_mm256_permute4x64_pd(
+            _mm256_castps_pd(_mm256_loadu_ps(psd + i)), 0xd8));
+        const __m256 filter = _mm256_and_ps(
+            _mm256_cmp_ps(p, _mm256_mul_ps(beta, q), _CMP_GT_OQ),
+            _mm256_cmp_ps(p, eps, _CMP_GT_OQ));
+        const __m256 gain = _mm256_blendv_ps(attenuation,
+            _mm256_div_ps(_mm256_sub_ps(p, q), _mm256_max_ps(p, eps)), filter);
+
+        _mm256_storeu_ps(tx_block + 2 * i, _mm256_mul_ps(c0, _mm256_unpacklo_ps(gain, gain)));
+        _mm256_storeu_ps(tx_block + 2 * i + 8, _mm256_mul_ps(c1, _mm256_unpackhi_ps(gain, gain)));
+    }
+    if (i < n)
+        aom_noise_tx_filter_block_c(tx_block + 2 * i, psd + i, n - i);
+}
+
+void aom_noise_window_block_avx2(const double *block_d, const float *window,
+    float *block, int32_t n) {
+    int32_t i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        const __m256 b = _mm256_insertf128_ps(
+            _mm256_castps128_ps256(_mm256_cvtpd_ps(_mm256_loadu_pd(block_d + i))),
+            _mm256_cvtpd_ps(_mm256_loadu_pd(block_d + i + 4)), 1);
+        _mm256_storeu_ps(block + i, _mm256_mul_ps(b, _mm256_loadu_ps(window + i)));
+    }
+    if (i < n)
+        aom_noise_window_block_c(block_d + i, window + i, block + i, n - i);
+}
+
+void aom_noise_accumulate_block_avx2(const float *block, const double *plane_d,
+    const float *window, int32_t block_size, float *result,
+    int32_t result_stride) {
+    if (block_size & 7) {
+        aom_noise_accumulate_block_c(block, plane_d, window, block_size, result,
+            result_stride);
+        return;
+    }
+    for (int32_t y = 0; y < block_size; ++y) {
+        for (int32_t x = 0; x < block_size; x += 8) {
+            const int32_t i = y * block_size + x;
+            const __m256 w = _mm256_loadu_ps(window + i);
+            const __m256 plane = _mm256_mul_ps(_mm256_insertf128_ps(
+                _mm256_castps128_ps256(_mm256_cvtpd_ps(_mm256_loadu_pd(plane_d + i))),
+                _mm256_cvtpd_ps(_mm256_loadu_pd(plane_d + i + 4)), 1), w);
+            const __m256 sum = _mm256_mul_ps(
+                _mm256_add_ps(_mm256_loadu_ps(block + i), plane), w);
+            float *r = result + y * result_stride + x;
+
+            _mm256_storeu_ps(r, _mm256_add_ps(_mm256_loadu_ps(r), sum));
+        }
+    }
+}
+
+void aom_flat_block_fit_plane_avx2(const double *A, const double *AtA_inv,
+    double *plane, double *block, int32_t n) {
+    // A has the 3 columns of the planar model
+    const __m128i columns = _mm_setr_epi32(0, 3, 6, 9);
+    __m256d sum = _mm256_setzero_pd();
+    double AtA_inv_b[4];
+    double plane_coords[3];
+    __m256d coords[3];
+    int32_t i, j;
+
+    if (n <= 0)
+        return;
+
+    // A' * block, a lane per parameter. The 4th lane reads the next row of A,
+    // or nothing for the last one.
+    for (i = 0; i < n - 1; ++i)
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(_mm256_set1_pd(block[i]),
+            _mm256_loadu_pd(A + 3 * i)));
+    sum = _mm256_add_pd(sum, _mm256_mul_pd(_mm256_set1_pd(block[n - 1]),
+        _mm256_maskload_pd(A + 3 * (n - 1), _mm256_setr_epi64x(-1, -1, -1, 0))));
+    _mm256_storeu_pd(AtA_inv_b, sum);
+
+    for (i = 0; i < 3; ++i) {
+        plane_coords[i] = 0;
+        for (j = 0; j < 3; ++j)
+            plane_coords[i] += AtA_inv[i * 3 + j] * AtA_inv_b[j];
+        coords[i] = _mm256_set1_pd(plane_coords[i]);
+    }
+
+    // A * plane_coords, a lane per row
+    for (i = 0; i + 4 <= n; i += 4) {
+        __m256d p = _mm256_add_pd(_mm256_setzero_pd(),
+            _mm256_mul_pd(_mm256_i32gather_pd(A + 3 * i + 0, columns, 8), coords[0]));
+        p = _mm256_add_pd(p,
+            _mm256_mul_pd(_mm256_i32gather_pd(A + 3 * i + 1, columns, 8), coords[1]));
+        p = _mm256_add_pd(p,
+            _mm256_mul_pd(_mm256_i32gather_pd(A + 3 * i + 2, columns, 8), coords[2]));
+        _mm256_storeu_pd(plane + i, p);
+        _mm256_storeu_pd(block + i, _mm256_sub_pd(_mm256_loadu_pd(block + i), p));
+    }
+    for (; i < n; ++i) {
+        double p = 0;
+        for (j = 0; j < 3; ++j)
+            p += A[i * 3 + j] * plane_coords[j];
+        plane[i] = p;
+        block[i] -= p;
+    }
+}
+
+// Row y of the 4 blocks, interleaved sample by sample
+static INLINE void interleave_rows_x4(const double *const *blocks, int32_t block_size,
+    int32_t y, double *row) {
+    for (int32_t x = 0; x < block_size; x += 4) {
+        const __m256d b0 = _mm256_loadu_pd(blocks[0] + y * block_size + x);
+        const __m256d b1 = _mm256_loadu_pd(blocks[1] + y * block_size + x);
+        const __m256d b2 = _mm256_loadu_pd(blocks[2] + y * block_size + x);
+        const __m256d b3 = _mm256_loadu_pd(blocks[3] + y * block_size + x);
+        const __m256d t0 = _mm256_unpacklo_pd(b0, b1);
+        const __m256d t1 = _mm256_unpackhi_pd(b0, b1);
+        const __m256d t2 = _mm256_unpacklo_pd(b2, b3);
+        const __m256d t3 = _mm256_unpackhi_pd(b2, b3);
+
+        _mm256_store_pd(row + 4 * (x + 0), _mm256_permute2f128_pd(t0, t2, 0x20));
+        _mm256_store_pd(row + 4 * (x + 1), _mm256_permute2f128_pd(t1, t3, 0x20));
+        _mm256_store_pd(row + 4 * (x + 2), _mm256_permute2f128_pd(t0, t2, 0x31));
+        _mm256_store_pd(row + 4 * (x + 3), _mm256_permute2f128_pd(t1, t3, 0x31));
+    }
+}
+
+void aom_flat_block_stats_x4_avx2(const double *const *blocks, int32_t block_size,
+    double *stats) {
+    // The 3 rows around the current one, a lane per block
+    DECLARE_ALIGNED(32, double, rows[3][4 * FLAT_BLOCK_MAX_SIZE]);
+    const __m256d half = _mm256_set1_pd(0.5);
+    __m256d Gxx = _mm256_setzero_pd();
+    __m256d Gxy = _mm256_setzero_pd();
+    __m256d Gyy = _mm256_setzero_pd();
+    __m256d mean = _mm256_setzero_pd();
+    __m256d var = _mm256_setzero_pd();
+    double sums[5][4];
+
+    if ((block_size & 3) || block_size > FLAT_BLOCK_MAX_SIZE) {
+        aom_flat_block_stats_x4_c(blocks, block_size, stats);
+        return;
+    }
+
+    interleave_rows_x4(blocks, block_size, 0, rows[0]);
+    interleave_rows_x4(blocks, block_size, 1, rows[1]);
+    for (int32_t yi = 1; yi < block_size - 1; ++yi) {
+        const double *above = rows[(yi - 1) % 3];
+        const double *row = rows[yi % 3];
+        const double *below = rows[(yi + 1) % 3];
+
+        interleave_rows_x4(blocks, block_size, yi + 1, rows[(yi + 1) % 3]);
+        for (int32_t xi = 1; xi < block_size - 1; ++xi) {
+            // (a - b) / 2 is (a - b) * 0.5 exactly
+            const __m256d v = _mm256_load_pd(row + 4 * xi);
+            const __m256d gx = _mm256_mul_pd(_mm256_sub_pd(
+                _mm256_load_pd(row + 4 * (xi + 1)), _mm256_load_pd(row + 4 * (xi - 1))), half);
+            const __m256d gy = _mm256_mul_pd(_mm256_sub_pd(
+                _mm256_load_pd(below + 4 * xi), _mm256_load_pd(above + 4 * xi)), half);
+
+            Gxx = _mm256_add_pd(Gxx, _mm256_mul_pd(gx, gx));
+            Gxy = _mm256_add_pd(Gxy, _mm256_mul_pd(gx, gy));
+            Gyy = _mm256_add_pd(Gyy, _mm256_mul_pd(gy, gy));
+            mean = _mm256_add_pd(mean, v);
+            var = _mm256_add_pd(var, _mm256_mul_pd(v, v));
+        }
+    }
+
+    _mm256_storeu_pd(sums[0], Gxx);
+    _mm256_storeu_pd(sums[1], Gxy);
+    _mm256_storeu_pd(sums[2], Gyy);
+    _mm256_storeu_pd(sums[3], mean);
+    _mm256_storeu_pd(sums[4], var);
+    for (int32_t k = 0; k < 4; ++k) {
+        for (int32_t s = 0; s < 5; ++s)
+            stats[5 * k + s] = sums[s][k];
+    }
+}
+
+void aom_noise_add_observation_avx2(const double *buffer, double val,
+    double norm_sq, int32_t n, double *A, double *b) {
+    const __m256d norm = _mm256_set1_pd(norm_sq);
+    const __m256d v = _mm256_set1_pd(val);
+    int32_t i, j;
+
+    for (i = 0; i < n; ++i) {
+        const __m256d bi = _mm256_set1_pd(buffer[i]);
+        double *row = A + i * n;
+
+        for (j = 0; j + 4 <= n; j += 4) {
+            _mm256_storeu_pd(row + j, _mm256_add_pd(_mm256_loadu_pd(row + j),
+                _mm256_div_pd(_mm256_mul_pd(bi, _mm256_loadu_pd(buffer + j)), norm)));
+        }
+        for (; j < n; ++j)
+            row[j] += (buffer[i] * buffer[j]) / norm_sq;
+    }
+    for (i = 0; i + 4 <= n; i += 4) {
+        _mm256_storeu_pd(b + i, _mm256_add_pd(_mm256_loadu_pd(b + i),
+            _mm256_div_pd(_mm256_mul_pd(_mm256_loadu_pd(buffer + i), v), norm)));
+    }
+    for (; i < n; ++i)
+        b[i] += (buffer[i] * val) / norm_sq;
+}
@@ -108,20 +108,29 @@ EbErrorType output_bitstream_rbsp_to_payload(
 /********************************************************************************************************************************/
 /********************************************************************************************************************************/
 // daalaboolwriter.c
-void aom_daala_start_encode(DaalaWriter *br, uint8_t *source) {
+void aom_daala_start_encode(DaalaWriter *br, uint8_t *source, uint32_t buffer_size) {
     br->buffer = source;
+    br->buffer_size = buffer_size;
     br->pos = 0;
     od_ec_enc_init(&br->ec, 62025);
 }
 
+/* Returns the number of bits coded, or -1 when they did not fit in the
+   buffer (nothing is written then) */
 int32_t aom_daala_stop_encode(DaalaWriter *br) {
     int32_t nb_bits;
     uint32_t daala_bytes;
     uint8_t *daala_data;
     daala_data = od_ec_enc_done(&br->ec, &daala_bytes);
     nb_bits = od_ec_enc_tell(&br->ec);
-    memcpy(br->buffer, daala_data, daala_bytes);
-    br->pos = daala_bytes;
+    if (daala_data == NULL || daala_bytes > br->buffer_size) {
+        br->pos = 0;
+        nb_bits = -1;
+    }
+    else {
+        memcpy(br->buffer, daala_data, daala_bytes);
+        br->pos = daala_bytes;
+    }
     od_ec_enc_clear(&br->ec);
     return nb_bits;
 }
@@ -244,13 +244,14 @@ on a larger type, you can speed up the decoder by using it here.*/
     struct DaalaWriter {
         uint32_t pos;
         uint8_t *buffer;
+        uint32_t buffer_size;   // bytes available at buffer
         OdEcEnc ec;
         uint8_t allow_update_cdf;
     };
 
     typedef struct DaalaWriter DaalaWriter;
 
-    void aom_daala_start_encode(DaalaWriter *w, uint8_t *buffer);
+    void aom_daala_start_encode(DaalaWriter *w, uint8_t *buffer, uint32_t buffer_size);
     int32_t aom_daala_stop_encode(DaalaWriter *w);
 
     static INLINE void aom_daala_write(DaalaWriter *w, int32_t bit, int32_t prob) {
@@ -294,8 +295,8 @@ on a larger type, you can speed up the decoder by using it here.*/
         token_stats->cost = 0;
     }
 
-    static INLINE void aom_start_encode(AomWriter *bc, uint8_t *buffer) {
-        aom_daala_start_encode(bc, buffer);
+    static INLINE void aom_start_encode(AomWriter *bc, uint8_t *buffer, uint32_t buffer_size) {
+        aom_daala_start_encode(bc, buffer, buffer_size);
     }
 
     static INLINE int32_t aom_stop_encode(AomWriter *bc) {
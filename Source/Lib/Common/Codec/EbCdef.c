@@ -468,10 +468,76 @@ static INLINE void copy_rect(uint16_t *dst, int32_t dstride, const uint16_t *src
     }
 }
 
+/* Saves the CDEF_VBORDER unfiltered lines above and below the first 64x64 row
+   of a segment, so that the segments of a picture are filtered in any order. */
+void av1_cdef_save_boundary_lines(
+    SequenceControlSet           *sequence_control_set_ptr,
+    PictureControlSet            *pCs,
+    int32_t                       fb_row,
+    uint16_t                    **above,
+    uint16_t                    **below,
+    int32_t                       boundary_stride){
+
+    struct PictureParentControlSet     *pPcs = pCs->parent_pcs_ptr;
+    Av1Common*   cm = pPcs->av1_cm;
+    EbBool       is16bit = (EbBool)(sequence_control_set_ptr->static_config.encoder_bit_depth > EB_8BIT);
+    EbPictureBufferDesc  * recon_picture_ptr;
+
+    if (pPcs->is_used_as_reference_flag == EB_TRUE)
+        recon_picture_ptr = is16bit ?
+            ((EbReferenceObject*)pPcs->reference_picture_wrapper_ptr->object_ptr)->reference_picture16bit :
+            ((EbReferenceObject*)pPcs->reference_picture_wrapper_ptr->object_ptr)->reference_picture;
+    else
+        recon_picture_ptr = is16bit ? pCs->recon_picture16bit_ptr : pCs->recon_picture_ptr;
+
+    for (int32_t pli = 0; pli < 3; pli++) {
+        const int32_t subsampling = (pli == 0) ? 0 : 1;
+        const int32_t row = (MI_SIZE_64X64 << (MI_SIZE_LOG2 - subsampling)) * fb_row;
+        const int32_t width = cm->mi_cols << (MI_SIZE_LOG2 - subsampling);
+        EbByte   recBuff = 0;
+        uint32_t recStride = 0;
+        uint32_t offset;
+
+        switch (pli) {
+        case 0:
+            recBuff = recon_picture_ptr->buffer_y;
+            recStride = recon_picture_ptr->stride_y;
+            break;
+        case 1:
+            recBuff = recon_picture_ptr->buffer_cb;
+            recStride = recon_picture_ptr->stride_cb;
+            break;
+        case 2:
+            recBuff = recon_picture_ptr->buffer_cr;
+            recStride = recon_picture_ptr->stride_cr;
+            break;
+        }
+        offset = (recon_picture_ptr->origin_x >> subsampling) + (recon_picture_ptr->origin_y >> subsampling) * recStride;
+
+        if (is16bit) {
+            copy_sb16_16(above[pli], boundary_stride, (uint16_t*)recBuff + offset,
+                row - CDEF_VBORDER, 0, recStride, CDEF_VBORDER, width);
+            copy_sb16_16(below[pli], boundary_stride, (uint16_t*)recBuff + offset,
+                row, 0, recStride, CDEF_VBORDER, width);
+        }
+        else {
+            copy_sb8_16(above[pli], boundary_stride, recBuff + offset,
+                row - CDEF_VBORDER, 0, recStride, CDEF_VBORDER, width);
+            copy_sb8_16(below[pli], boundary_stride, recBuff + offset,
+                row, 0, recStride, CDEF_VBORDER, width);
+        }
+    }
+}
+
 void av1_cdef_frame(
     EncDecContext                *context_ptr,
     SequenceControlSet           *sequence_control_set_ptr,
-    PictureControlSet            *pCs){
+    PictureControlSet            *pCs,
+    int32_t                       fb_row_start,
+    int32_t                       fb_row_end,
+    uint16_t                    **boundary_above,
+    uint16_t                    **boundary_below,
+    int32_t                       boundary_stride){
     (void)context_ptr;
 
     struct PictureParentControlSet     *pPcs = pCs->parent_pcs_ptr;
@@ -533,7 +599,15 @@ void av1_cdef_frame(
         colbuf[pli] = (uint16_t *)aom_malloc(sizeof(*colbuf)  * ((CDEF_BLOCKSIZE << mi_high_l2[pli]) + 2 * CDEF_VBORDER) * CDEF_HBORDER);
     }
 
-    for (int32_t fbr = 0; fbr < nvfb; fbr++) {
+    /* The rows above the segment may be filtered already, take the lines
+       saved before any segment was filtered. */
+    if (fb_row_start > 0) {
+        for (int32_t pli = 0; pli < num_planes; pli++)
+            copy_rect(linebuf[pli], stride, boundary_above[pli], boundary_stride,
+                CDEF_VBORDER, (cm->mi_cols << mi_wide_l2[pli]));
+    }
+
+    for (int32_t fbr = fb_row_start; fbr < fb_row_end; fbr++) {
 
         for (int32_t pli = 0; pli < num_planes; pli++) {
             const int32_t block_height =
@@ -668,6 +742,10 @@ void av1_cdef_frame(
                     CDEF_BSTRIDE, recBuff/*xd->plane[pli].dst.buf*/,
                     (MI_SIZE_64X64 << mi_high_l2[pli]) * fbr, coffset + cstart,
                     recStride/*xd->plane[pli].dst.stride*/, rend, cend - cstart);
+                /* Same for the rows below the segment. */
+                if (fbr == fb_row_end - 1 && fbr != nvfb - 1)
+                    copy_rect(&src[(CDEF_VBORDER + vsize) * CDEF_BSTRIDE + CDEF_HBORDER + cstart], CDEF_BSTRIDE,
+                        &boundary_below[pli][coffset + cstart], boundary_stride, CDEF_VBORDER, cend - cstart);
                 if (!prev_row_cdef[fbc]) {
                     copy_sb8_16(//cm,
                         &src[CDEF_HBORDER], CDEF_BSTRIDE,
@@ -799,7 +877,12 @@ void av1_cdef_frame(
 void av1_cdef_frame16bit(
     EncDecContext                *context_ptr,
     SequenceControlSet           *sequence_control_set_ptr,
-    PictureControlSet            *pCs){
+    PictureControlSet            *pCs,
+    int32_t                       fb_row_start,
+    int32_t                       fb_row_end,
+    uint16_t                    **boundary_above,
+    uint16_t                    **boundary_below,
+    int32_t                       boundary_stride){
     (void)context_ptr;
     struct PictureParentControlSet     *pPcs = pCs->parent_pcs_ptr;
     Av1Common*   cm = pPcs->av1_cm;
@@ -859,7 +942,15 @@ void av1_cdef_frame16bit(
         colbuf[pli] = (uint16_t *)aom_malloc(sizeof(*colbuf)  * ((CDEF_BLOCKSIZE << mi_high_l2[pli]) + 2 * CDEF_VBORDER) * CDEF_HBORDER);
     }
 
-    for (int32_t fbr = 0; fbr < nvfb; fbr++) {
+    /* The rows above the segment may be filtered already, take the lines
+       saved before any segment was filtered. */
+    if (fb_row_start > 0) {
+        for (int32_t pli = 0; pli < num_planes; pli++)
+            copy_rect(linebuf[pli], stride, boundary_above[pli], boundary_stride,
+                CDEF_VBORDER, (cm->mi_cols << mi_wide_l2[pli]));
+    }
+
+    for (int32_t fbr = fb_row_start; fbr < fb_row_end; fbr++) {
 
         for (int32_t pli = 0; pli < num_planes; pli++) {
             const int32_t block_height =
@@ -995,6 +1086,10 @@ void av1_cdef_frame16bit(
                     CDEF_BSTRIDE, recBuff/*xd->plane[pli].dst.buf*/,
                     (MI_SIZE_64X64 << mi_high_l2[pli]) * fbr, coffset + cstart,
                     recStride/*xd->plane[pli].dst.stride*/, rend, cend - cstart);
+                /* Same for the rows below the segment. */
+                if (fbr == fb_row_end - 1 && fbr != nvfb - 1)
+                    copy_rect(&src[(CDEF_VBORDER + vsize) * CDEF_BSTRIDE + CDEF_HBORDER + cstart], CDEF_BSTRIDE,
+                        &boundary_below[pli][coffset + cstart], boundary_stride, CDEF_VBORDER, cend - cstart);
 
 
 
@@ -46,12 +46,37 @@ void finish_cdef_search(
 void av1_cdef_frame16bit(
     EncDecContext                *context_ptr,
     SequenceControlSet           *sequence_control_set_ptr,
-    PictureControlSet            *pCs);
+    PictureControlSet            *pCs,
+    int32_t                       fb_row_start,
+    int32_t                       fb_row_end,
+    uint16_t                    **boundary_above,
+    uint16_t                    **boundary_below,
+    int32_t                       boundary_stride);
 void av1_cdef_frame(
     EncDecContext                *context_ptr,
     SequenceControlSet           *sequence_control_set_ptr,
-    PictureControlSet            *pCs);
+    PictureControlSet            *pCs,
+    int32_t                       fb_row_start,
+    int32_t                       fb_row_end,
+    uint16_t                    **boundary_above,
+    uint16_t                    **boundary_below,
+    int32_t                       boundary_stride);
+void av1_cdef_save_boundary_lines(
+    SequenceControlSet           *sequence_control_set_ptr,
+    PictureControlSet            *pCs,
+    int32_t                       fb_row,
+    uint16_t                    **above,
+    uint16_t                    **below,
+    int32_t                       boundary_stride);
 void av1_loop_restoration_save_boundary_lines(const Yv12BufferConfig *frame, Av1Common *cm, int32_t after_cdef);
+void pad_ref_rows(
+    PictureControlSet    *picture_control_set_ptr,
+    SequenceControlSet   *sequence_control_set_ptr,
+    uint32_t              row_start,
+    uint32_t              row_end);
+
+static void cdef_process_segment(void *thread_context_ptr, void *owner_context_ptr, uint32_t segment_index);
+static void cdef_fill_helper_task(void *owner_context_ptr, void *task_ptr);
 
 
 /******************************************************
@@ -61,12 +86,14 @@ EbErrorType cdef_context_ctor(
     CdefContext_t          **context_dbl_ptr,
     EbFifo                *cdef_input_fifo_ptr,
     EbFifo                *cdef_output_fifo_ptr ,
+    EbFifo                *cdef_feedback_fifo_ptr,
     EbBool                  is16bit,
     uint32_t                max_input_luma_width,
-    uint32_t                max_input_luma_height){
+    uint32_t                max_input_luma_height,
+    uint32_t                segment_row_count,
+    uint32_t                helper_count){
 
     (void)is16bit;
-    (void)max_input_luma_width;
     (void)max_input_luma_height;
 
 
@@ -77,6 +104,25 @@ EbErrorType cdef_context_ctor(
     // Input/Output System Resource Manager FIFOs
     context_ptr->cdef_input_fifo_ptr = cdef_input_fifo_ptr;
     context_ptr->cdef_output_fifo_ptr = cdef_output_fifo_ptr;
+    context_ptr->cdef_feedback_fifo_ptr = cdef_feedback_fifo_ptr;
+
+    // Filtering job
+    context_ptr->segment_row_count = MAX(segment_row_count, 1);
+    context_ptr->job_pcs_ptr = (PictureControlSet*)EB_NULL;
+    if (eb_segment_job_ctor(
+            &context_ptr->segment_job,
+            context_ptr,
+            cdef_feedback_fifo_ptr,
+            helper_count,
+            context_ptr->segment_row_count,
+            cdef_process_segment,
+            cdef_fill_helper_task) != EB_ErrorNone)
+        return EB_ErrorInsufficientResources;
+    context_ptr->boundary_stride = (int32_t)((max_input_luma_width + 63) & ~63);
+    for (int32_t pli = 0; pli < 3; pli++) {
+        EB_MALLOC(uint16_t*, context_ptr->boundary_above[pli], sizeof(uint16_t) * CDEF_VBORDER * context_ptr->boundary_stride * context_ptr->segment_row_count, EB_N_PTR);
+        EB_MALLOC(uint16_t*, context_ptr->boundary_below[pli], sizeof(uint16_t) * CDEF_VBORDER * context_ptr->boundary_stride * context_ptr->segment_row_count, EB_N_PTR);
+    }
 
 
     return EB_ErrorNone;
@@ -427,6 +473,145 @@ void cdef_seg_search16bit(
 }
 
 
+/******************************************************
+ * Cdef Post Ready Rows
+ *   Pads the rows of the segment in the reference and
+ *   hands the rows of the segments done in order over
+ *   to the pictures using it, see inter_picture_wavefront
+ ******************************************************/
+static void cdef_post_ready_rows(
+    CdefContext_t                *owner_ptr,
+    uint32_t                      segment_index)
+{
+    PictureControlSet  *picture_control_set_ptr = owner_ptr->job_pcs_ptr;
+    SequenceControlSet *sequence_control_set_ptr = (SequenceControlSet*)picture_control_set_ptr->sequence_control_set_wrapper_ptr->object_ptr;
+    Av1Common          *cm = picture_control_set_ptr->parent_pcs_ptr->av1_cm;
+    const int32_t       nvfb = (cm->mi_rows + MI_SIZE_64X64 - 1) / MI_SIZE_64X64;
+    const uint32_t      segment_count = owner_ptr->segment_job.segment_count;
+    uint32_t            ready_segment_count;
+
+    pad_ref_rows(
+        picture_control_set_ptr,
+        sequence_control_set_ptr,
+        MIN(SEGMENT_START_IDX(segment_index, nvfb, segment_count) * 64, sequence_control_set_ptr->luma_height),
+        MIN(SEGMENT_END_IDX(segment_index, nvfb, segment_count) * 64, sequence_control_set_ptr->luma_height));
+
+    // The posts of two threads may cross, the reference keeps the largest
+    ready_segment_count = eb_segment_job_done_in_order(&owner_ptr->segment_job, segment_index);
+    if (ready_segment_count)
+        eb_reference_object_post_rows(
+            (EbReferenceObject*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr,
+            MIN(SEGMENT_END_IDX(ready_segment_count - 1, nvfb, segment_count) * 64, sequence_control_set_ptr->luma_height));
+}
+
+/******************************************************
+ * Cdef Process Segment
+ *   Filters the 64x64 rows of one segment
+ ******************************************************/
+static void cdef_process_segment(
+    void                         *thread_context_ptr,
+    void                         *owner_context_ptr,
+    uint32_t                      segment_index)
+{
+    CdefContext_t      *owner_ptr = (CdefContext_t*)owner_context_ptr;
+    PictureControlSet  *picture_control_set_ptr = owner_ptr->job_pcs_ptr;
+    SequenceControlSet *sequence_control_set_ptr = (SequenceControlSet*)picture_control_set_ptr->sequence_control_set_wrapper_ptr->object_ptr;
+    Av1Common          *cm = picture_control_set_ptr->parent_pcs_ptr->av1_cm;
+    const int32_t       nvfb = (cm->mi_rows + MI_SIZE_64X64 - 1) / MI_SIZE_64X64;
+    const size_t        boundary_size = CDEF_VBORDER * owner_ptr->boundary_stride;
+    uint16_t           *boundary_above[3];
+    uint16_t           *boundary_below[3];
+
+    for (int32_t pli = 0; pli < 3; pli++) {
+        boundary_above[pli] = owner_ptr->boundary_above[pli] + segment_index * boundary_size;
+        boundary_below[pli] = owner_ptr->boundary_below[pli] + segment_index * boundary_size;
+    }
+
+    if (sequence_control_set_ptr->static_config.encoder_bit_depth > EB_8BIT)
+        av1_cdef_frame16bit(
+            0,
+            sequence_control_set_ptr,
+            picture_control_set_ptr,
+            SEGMENT_START_IDX(segment_index, nvfb, owner_ptr->segment_job.segment_count),
+            SEGMENT_END_IDX(segment_index, nvfb, owner_ptr->segment_job.segment_count),
+            boundary_above,
+            boundary_below,
+            owner_ptr->boundary_stride);
+    else
+        av1_cdef_frame(
+            0,
+            sequence_control_set_ptr,
+            picture_control_set_ptr,
+            SEGMENT_START_IDX(segment_index, nvfb, owner_ptr->segment_job.segment_count),
+            SEGMENT_END_IDX(segment_index, nvfb, owner_ptr->segment_job.segment_count),
+            boundary_above,
+            boundary_below,
+            owner_ptr->boundary_stride);
+
+    if (picture_control_set_ptr->cdef_pads_reference)
+        cdef_post_ready_rows(
+            owner_ptr,
+            segment_index);
+}
+
+/******************************************************
+ * Cdef Fill Helper Task
+ *   The feedback tasks come from the pool DLF feeds
+ *   CDEF from
+ ******************************************************/
+static void cdef_fill_helper_task(
+    void                         *owner_context_ptr,
+    void                         *task_ptr)
+{
+    DlfResults *helper_ptr = (DlfResults*)task_ptr;
+
+    helper_ptr->picture_control_set_wrapper_ptr = (EbObjectWrapper*)EB_NULL;
+    helper_ptr->input_type = CDEF_TASKS_CDEF_INPUT;
+    helper_ptr->cdef_context_ptr = owner_context_ptr;
+}
+
+/******************************************************
+ * Cdef Run Segments
+ *   Filters the picture in segments of 64x64 rows, see
+ *   eb_segment_job_run(). The lines around the segment
+ *   boundaries are saved first, so a segment never reads
+ *   rows filtered by its neighbours.
+ ******************************************************/
+static void cdef_run_segments(
+    CdefContext_t                *context_ptr,
+    SequenceControlSet           *sequence_control_set_ptr,
+    PictureControlSet            *picture_control_set_ptr)
+{
+    Av1Common          *cm = picture_control_set_ptr->parent_pcs_ptr->av1_cm;
+    const int32_t       nvfb = (cm->mi_rows + MI_SIZE_64X64 - 1) / MI_SIZE_64X64;
+    const uint32_t      segment_count = MIN(context_ptr->segment_row_count, (uint32_t)nvfb);
+    const size_t        boundary_size = CDEF_VBORDER * context_ptr->boundary_stride;
+    uint32_t            segment_index;
+
+    // The previous job is drained, helpers still queued find no segment until the job is set
+    for (segment_index = 1; segment_index < segment_count; ++segment_index) {
+        uint16_t *above[3];
+        uint16_t *below[3];
+        for (int32_t pli = 0; pli < 3; pli++) {
+            above[pli] = context_ptr->boundary_above[pli] + segment_index * boundary_size;
+            below[pli] = context_ptr->boundary_below[pli] + (segment_index - 1) * boundary_size;
+        }
+        av1_cdef_save_boundary_lines(
+            sequence_control_set_ptr,
+            picture_control_set_ptr,
+            SEGMENT_START_IDX(segment_index, nvfb, segment_count),
+            above,
+            below,
+            context_ptr->boundary_stride);
+    }
+
+    context_ptr->job_pcs_ptr = picture_control_set_ptr;
+
+    eb_segment_job_run(
+        &context_ptr->segment_job,
+        segment_count);
+}
+
 /******************************************************
  * CDEF Kernel
  ******************************************************/
@@ -456,6 +641,16 @@ void* cdef_kernel(void *input_ptr)
             &dlf_results_wrapper_ptr);
 
         dlf_results_ptr = (DlfResults*)dlf_results_wrapper_ptr->object_ptr;
+
+        // Segments of the picture of another CDEF thread
+        if (dlf_results_ptr->input_type == CDEF_TASKS_CDEF_INPUT) {
+            eb_segment_job_help(
+                &((CdefContext_t*)dlf_results_ptr->cdef_context_ptr)->segment_job,
+                context_ptr);
+            eb_release_object(dlf_results_wrapper_ptr);
+            continue;
+        }
+
         picture_control_set_ptr = (PictureControlSet*)dlf_results_ptr->picture_control_set_wrapper_ptr->object_ptr;
         sequence_control_set_ptr = (SequenceControlSet*)picture_control_set_ptr->sequence_control_set_wrapper_ptr->object_ptr;
 
@@ -492,6 +687,11 @@ void* cdef_kernel(void *input_ptr)
 
 
 
+        // Without restoration, the rows of the reference are final once filtered
+        picture_control_set_ptr->cdef_pads_reference = (EbBool)(sequence_control_set_ptr->static_config.inter_picture_wavefront &&
+            picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag &&
+            !sequence_control_set_ptr->enable_restoration);
+
         if (sequence_control_set_ptr->enable_cdef && picture_control_set_ptr->parent_pcs_ptr->cdef_filter_mode) {
                 finish_cdef_search(
                     0,
@@ -502,16 +702,10 @@ void* cdef_kernel(void *input_ptr)
 #if CDEF_OFF_NON_REF
                 if (sequence_control_set_ptr->enable_restoration != 0 || picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag || sequence_control_set_ptr->static_config.recon_enabled){
 #endif
-                    if (is16bit)
-                        av1_cdef_frame16bit(
-                            0,
-                            sequence_control_set_ptr,
-                            picture_control_set_ptr);
-                    else
-                        av1_cdef_frame(
-                            0,
-                            sequence_control_set_ptr,
-                            picture_control_set_ptr);
+                    cdef_run_segments(
+                        context_ptr,
+                        sequence_control_set_ptr,
+                        picture_control_set_ptr);
 #if CDEF_OFF_NON_REF
                 }
 #endif
@@ -523,6 +717,17 @@ void* cdef_kernel(void *input_ptr)
             picture_control_set_ptr->parent_pcs_ptr->cdef_strengths[0] = 0;
             picture_control_set_ptr->parent_pcs_ptr->nb_cdef_strengths = 1;
             picture_control_set_ptr->parent_pcs_ptr->cdef_uv_strengths[0] = 0;
+
+            if (picture_control_set_ptr->cdef_pads_reference) {
+                pad_ref_rows(
+                    picture_control_set_ptr,
+                    sequence_control_set_ptr,
+                    0,
+                    sequence_control_set_ptr->luma_height);
+                eb_reference_object_post_rows(
+                    (EbReferenceObject*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr,
+                    sequence_control_set_ptr->luma_height);
+            }
         }
 
         //restoration prep
@@ -560,6 +765,7 @@ void* cdef_kernel(void *input_ptr)
             cdef_results_ptr = (struct CdefResults*)cdef_results_wrapper_ptr->object_ptr;
             cdef_results_ptr->picture_control_set_wrapper_ptr = dlf_results_ptr->picture_control_set_wrapper_ptr;
             cdef_results_ptr->segment_index = segment_index;
+            cdef_results_ptr->input_type = REST_TASKS_CDEF_INPUT;
             // Post Cdef Results
             eb_post_full_object(cdef_results_wrapper_ptr);
 
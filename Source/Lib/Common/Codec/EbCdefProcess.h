@@ -14,6 +14,7 @@
 #include "EbUtility.h"
 #include "EbPsnr.h"
 #include "EbPictureControlSet.h"
+#include "EbSegmentJob.h"
 
 /**************************************
  * Cdef Context
@@ -22,6 +23,17 @@ typedef struct CdefContext_s
 {
     EbFifo                       *cdef_input_fifo_ptr;
     EbFifo                       *cdef_output_fifo_ptr;
+    EbFifo                       *cdef_feedback_fifo_ptr;
+
+    // Filtering job of this context, the 64x64-row segments are shared with
+    // the helper CDEF threads posted through the feedback fifo
+    EbSegmentJob                  segment_job;
+    uint32_t                      segment_row_count;
+    uint16_t                     *boundary_above[3];   // unfiltered lines above segment i, per plane
+    uint16_t                     *boundary_below[3];   // unfiltered lines below segment i, per plane
+    int32_t                       boundary_stride;
+
+    PictureControlSet            *job_pcs_ptr;
 } CdefContext_t;
 
 /**************************************
@@ -31,9 +43,12 @@ extern EbErrorType cdef_context_ctor(
     CdefContext_t **context_dbl_ptr,
     EbFifo                       *cdef_input_fifo_ptr,
     EbFifo                       *cdef_output_fifo_ptr,
+    EbFifo                       *cdef_feedback_fifo_ptr,
     EbBool                  is16bit,
     uint32_t                max_input_luma_width,
-    uint32_t                max_input_luma_height
+    uint32_t                max_input_luma_height,
+    uint32_t                segment_row_count,
+    uint32_t                helper_count
    );
 
 extern void* cdef_kernel(void *input_ptr);
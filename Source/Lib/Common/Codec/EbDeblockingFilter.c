@@ -1391,13 +1391,10 @@ void av1_loop_filter_frame(
 }
 extern int16_t av1_ac_quant_Q3(int32_t qindex, int32_t delta, AomBitDepth bit_depth);
 
-void EbCopyBuffer(
+void EbCopyBufferLayout(
     EbPictureBufferDesc  *srcBuffer,
-    EbPictureBufferDesc  *dstBuffer,
-    PictureControlSet    *pcs_ptr,
-    uint8_t                   plane) {
+    EbPictureBufferDesc  *dstBuffer) {
 
-    EbBool is16bit = (EbBool)(pcs_ptr->parent_pcs_ptr->sequence_control_set_ptr->static_config.encoder_bit_depth > EB_8BIT);
     dstBuffer->origin_x = srcBuffer->origin_x;
     dstBuffer->origin_y = srcBuffer->origin_y;
     dstBuffer->width = srcBuffer->width;
@@ -1409,17 +1406,37 @@ void EbCopyBuffer(
     dstBuffer->chroma_size = srcBuffer->chroma_size;
     dstBuffer->packedFlag = srcBuffer->packedFlag;
 
+    dstBuffer->stride_y = srcBuffer->stride_y;
+    dstBuffer->stride_bit_inc_y = srcBuffer->stride_bit_inc_y;
+    dstBuffer->stride_cb = srcBuffer->stride_cb;
+    dstBuffer->stride_bit_inc_cb = srcBuffer->stride_bit_inc_cb;
+    dstBuffer->stride_cr = srcBuffer->stride_cr;
+    dstBuffer->stride_bit_inc_cr = srcBuffer->stride_bit_inc_cr;
+}
+
+/* Copies the luma rows [row_start, row_end) of one plane, or the
+   corresponding chroma rows. Both buffers must share the same layout,
+   see EbCopyBufferLayout(). */
+void EbCopyBuffer(
+    EbPictureBufferDesc  *srcBuffer,
+    EbPictureBufferDesc  *dstBuffer,
+    PictureControlSet    *pcs_ptr,
+    uint8_t                   plane,
+    uint32_t                  row_start,
+    uint32_t                  row_end) {
+
+    EbBool is16bit = (EbBool)(pcs_ptr->parent_pcs_ptr->sequence_control_set_ptr->static_config.encoder_bit_depth > EB_8BIT);
+
     uint32_t   lumaBufferOffset = (srcBuffer->origin_x + srcBuffer->origin_y*srcBuffer->stride_y) << is16bit;
     uint16_t   luma_width = (uint16_t)(srcBuffer->width - pcs_ptr->parent_pcs_ptr->sequence_control_set_ptr->pad_right) << is16bit;
     uint16_t   luma_height = (uint16_t)(srcBuffer->height - pcs_ptr->parent_pcs_ptr->sequence_control_set_ptr->pad_bottom);
     uint16_t   chroma_width = (luma_width >> 1);
+    int32_t    row_first = (int32_t)row_start;
+    int32_t    row_last = (int32_t)MIN(row_end, luma_height);
     if (plane == 0) {
         uint16_t stride_y = srcBuffer->stride_y << is16bit;
 
-        dstBuffer->stride_y = srcBuffer->stride_y;
-        dstBuffer->stride_bit_inc_y = srcBuffer->stride_bit_inc_y;
-
-        for (int32_t inputRowIndex = 0; inputRowIndex < luma_height; inputRowIndex++) {
+        for (int32_t inputRowIndex = row_first; inputRowIndex < row_last; inputRowIndex++) {
             EB_MEMCPY((dstBuffer->buffer_y + lumaBufferOffset + stride_y * inputRowIndex),
                 (srcBuffer->buffer_y + lumaBufferOffset + stride_y * inputRowIndex),
                 luma_width);
@@ -1428,12 +1445,10 @@ void EbCopyBuffer(
     }
     else if (plane == 1) {
         uint16_t stride_cb = srcBuffer->stride_cb << is16bit;
-        dstBuffer->stride_cb = srcBuffer->stride_cb;
-        dstBuffer->stride_bit_inc_cb = srcBuffer->stride_bit_inc_cb;
 
         uint32_t   chromaBufferOffset = (srcBuffer->origin_x / 2 + srcBuffer->origin_y / 2 * srcBuffer->stride_cb) << is16bit;
 
-        for (int32_t inputRowIndex = 0; inputRowIndex < luma_height >> 1; inputRowIndex++) {
+        for (int32_t inputRowIndex = row_first >> 1; inputRowIndex < row_last >> 1; inputRowIndex++) {
             EB_MEMCPY((dstBuffer->buffer_cb + chromaBufferOffset + stride_cb * inputRowIndex),
                 (srcBuffer->buffer_cb + chromaBufferOffset + stride_cb * inputRowIndex),
                 chroma_width);
@@ -1443,12 +1458,9 @@ void EbCopyBuffer(
     else if (plane == 2) {
         uint16_t stride_cr = srcBuffer->stride_cr << is16bit;
 
-        dstBuffer->stride_cr = srcBuffer->stride_cr;
-        dstBuffer->stride_bit_inc_cr = srcBuffer->stride_bit_inc_cr;
-
         uint32_t   chromaBufferOffset = (srcBuffer->origin_x / 2 + srcBuffer->origin_y / 2 * srcBuffer->stride_cr) << is16bit;
 
-        for (int32_t inputRowIndex = 0; inputRowIndex < luma_height >> 1; inputRowIndex++) {
+        for (int32_t inputRowIndex = row_first >> 1; inputRowIndex < row_last >> 1; inputRowIndex++) {
             EB_MEMCPY((dstBuffer->buffer_cr + chromaBufferOffset + stride_cr * inputRowIndex),
                 (srcBuffer->buffer_cr + chromaBufferOffset + stride_cr * inputRowIndex),
                 chroma_width);
@@ -1468,14 +1480,22 @@ void EbCopyBuffer(
 //    }
 //}
 
+/* Sum of squared errors of the luma rows [row_start, row_end) of one
+   plane, or of the corresponding chroma rows. */
 uint64_t PictureSseCalculations(
     PictureControlSet    *picture_control_set_ptr,
     EbPictureBufferDesc *recon_ptr,
-    int32_t plane)
+    int32_t plane,
+    uint32_t row_start,
+    uint32_t row_end)
 
 {
     SequenceControlSet   *sequence_control_set_ptr = picture_control_set_ptr->parent_pcs_ptr->sequence_control_set_ptr;
     EbBool is16bit = (sequence_control_set_ptr->static_config.encoder_bit_depth > EB_8BIT);
+    uint32_t luma_row_end = MIN(row_end, (uint32_t)sequence_control_set_ptr->luma_height);
+    uint32_t chroma_row_start = row_start >> 1;
+    uint32_t chroma_row_end = (luma_row_end == sequence_control_set_ptr->luma_height) ?
+        (uint32_t)sequence_control_set_ptr->chroma_height : luma_row_end >> 1;
 
     if (!is16bit) {
 
@@ -1487,12 +1507,12 @@ uint64_t PictureSseCalculations(
         EbByte  inputBuffer;
         EbByte  reconCoeffBuffer;
         if (plane == 0) {
-            reconCoeffBuffer = &((recon_ptr->buffer_y)[recon_ptr->origin_x + recon_ptr->origin_y * recon_ptr->stride_y]);
-            inputBuffer = &((input_picture_ptr->buffer_y)[input_picture_ptr->origin_x + input_picture_ptr->origin_y * input_picture_ptr->stride_y]);
+            reconCoeffBuffer = &((recon_ptr->buffer_y)[recon_ptr->origin_x + (recon_ptr->origin_y + row_start) * recon_ptr->stride_y]);
+            inputBuffer = &((input_picture_ptr->buffer_y)[input_picture_ptr->origin_x + (input_picture_ptr->origin_y + row_start) * input_picture_ptr->stride_y]);
 
             residualDistortion = 0;
-
-            while (row_index < sequence_control_set_ptr->luma_height) {
+            row_index = row_start;
+            while (row_index < luma_row_end) {
 
                 columnIndex = 0;
                 while (columnIndex < sequence_control_set_ptr->luma_width) {
@@ -1509,12 +1529,12 @@ uint64_t PictureSseCalculations(
 
         else if (plane == 1) {
 
-            reconCoeffBuffer = &((recon_ptr->buffer_cb)[recon_ptr->origin_x / 2 + recon_ptr->origin_y / 2 * recon_ptr->stride_cb]);
-            inputBuffer = &((input_picture_ptr->buffer_cb)[input_picture_ptr->origin_x / 2 + input_picture_ptr->origin_y / 2 * input_picture_ptr->stride_cb]);
+            reconCoeffBuffer = &((recon_ptr->buffer_cb)[recon_ptr->origin_x / 2 + (recon_ptr->origin_y / 2 + chroma_row_start) * recon_ptr->stride_cb]);
+            inputBuffer = &((input_picture_ptr->buffer_cb)[input_picture_ptr->origin_x / 2 + (input_picture_ptr->origin_y / 2 + chroma_row_start) * input_picture_ptr->stride_cb]);
 
             residualDistortion = 0;
-            row_index = 0;
-            while (row_index < sequence_control_set_ptr->chroma_height) {
+            row_index = chroma_row_start;
+            while (row_index < chroma_row_end) {
 
                 columnIndex = 0;
                 while (columnIndex < sequence_control_set_ptr->chroma_width) {
@@ -1530,12 +1550,12 @@ uint64_t PictureSseCalculations(
             return residualDistortion;
         }
         else if (plane == 2) {
-            reconCoeffBuffer = &((recon_ptr->buffer_cr)[recon_ptr->origin_x / 2 + recon_ptr->origin_y / 2 * recon_ptr->stride_cr]);
-            inputBuffer = &((input_picture_ptr->buffer_cr)[input_picture_ptr->origin_x / 2 + input_picture_ptr->origin_y / 2 * input_picture_ptr->stride_cr]);
+            reconCoeffBuffer = &((recon_ptr->buffer_cr)[recon_ptr->origin_x / 2 + (recon_ptr->origin_y / 2 + chroma_row_start) * recon_ptr->stride_cr]);
+            inputBuffer = &((input_picture_ptr->buffer_cr)[input_picture_ptr->origin_x / 2 + (input_picture_ptr->origin_y / 2 + chroma_row_start) * input_picture_ptr->stride_cr]);
             residualDistortion = 0;
-            row_index = 0;
+            row_index = chroma_row_start;
 
-            while (row_index < sequence_control_set_ptr->chroma_height) {
+            while (row_index < chroma_row_end) {
 
                 columnIndex = 0;
                 while (columnIndex < sequence_control_set_ptr->chroma_width) {
@@ -1561,12 +1581,12 @@ uint64_t PictureSseCalculations(
         uint16_t*  inputBuffer;
         uint16_t*  reconCoeffBuffer;
         if (plane == 0) {
-            reconCoeffBuffer = (uint16_t*)&((recon_ptr->buffer_y)[(recon_ptr->origin_x + recon_ptr->origin_y * recon_ptr->stride_y) << is16bit]);
-            inputBuffer = (uint16_t*)&((input_picture_ptr->buffer_y)[(input_picture_ptr->origin_x + input_picture_ptr->origin_y * input_picture_ptr->stride_y) << is16bit]);
+            reconCoeffBuffer = (uint16_t*)&((recon_ptr->buffer_y)[(recon_ptr->origin_x + (recon_ptr->origin_y + row_start) * recon_ptr->stride_y) << is16bit]);
+            inputBuffer = (uint16_t*)&((input_picture_ptr->buffer_y)[(input_picture_ptr->origin_x + (input_picture_ptr->origin_y + row_start) * input_picture_ptr->stride_y) << is16bit]);
 
             residualDistortion = 0;
-
-            while (row_index < sequence_control_set_ptr->luma_height) {
+            row_index = row_start;
+            while (row_index < luma_row_end) {
 
                 columnIndex = 0;
                 while (columnIndex < sequence_control_set_ptr->luma_width) {
@@ -1584,12 +1604,12 @@ uint64_t PictureSseCalculations(
 
         else if (plane == 1) {
 
-            reconCoeffBuffer = (uint16_t*)&((recon_ptr->buffer_cb)[(recon_ptr->origin_x / 2 + recon_ptr->origin_y / 2 * recon_ptr->stride_cb) << is16bit]);
-            inputBuffer = (uint16_t*)&((input_picture_ptr->buffer_cb)[(input_picture_ptr->origin_x / 2 + input_picture_ptr->origin_y / 2 * input_picture_ptr->stride_cb) << is16bit]);
+            reconCoeffBuffer = (uint16_t*)&((recon_ptr->buffer_cb)[(recon_ptr->origin_x / 2 + (recon_ptr->origin_y / 2 + chroma_row_start) * recon_ptr->stride_cb) << is16bit]);
+            inputBuffer = (uint16_t*)&((input_picture_ptr->buffer_cb)[(input_picture_ptr->origin_x / 2 + (input_picture_ptr->origin_y / 2 + chroma_row_start) * input_picture_ptr->stride_cb) << is16bit]);
 
             residualDistortion = 0;
-            row_index = 0;
-            while (row_index < sequence_control_set_ptr->chroma_height) {
+            row_index = chroma_row_start;
+            while (row_index < chroma_row_end) {
 
                 columnIndex = 0;
                 while (columnIndex < sequence_control_set_ptr->chroma_width) {
@@ -1605,12 +1625,12 @@ uint64_t PictureSseCalculations(
             return residualDistortion;
         }
         else if (plane == 2) {
-            reconCoeffBuffer = (uint16_t*)&((recon_ptr->buffer_cr)[(recon_ptr->origin_x / 2 + recon_ptr->origin_y / 2 * recon_ptr->stride_cr) << is16bit]);
-            inputBuffer = (uint16_t*)&((input_picture_ptr->buffer_cr)[(input_picture_ptr->origin_x / 2 + input_picture_ptr->origin_y / 2 * input_picture_ptr->stride_cr) << is16bit]);
+            reconCoeffBuffer = (uint16_t*)&((recon_ptr->buffer_cr)[(recon_ptr->origin_x / 2 + (recon_ptr->origin_y / 2 + chroma_row_start) * recon_ptr->stride_cr) << is16bit]);
+            inputBuffer = (uint16_t*)&((input_picture_ptr->buffer_cr)[(input_picture_ptr->origin_x / 2 + (input_picture_ptr->origin_y / 2 + chroma_row_start) * input_picture_ptr->stride_cr) << is16bit]);
             residualDistortion = 0;
-            row_index = 0;
+            row_index = chroma_row_start;
 
-            while (row_index < sequence_control_set_ptr->chroma_height) {
+            while (row_index < chroma_row_end) {
 
                 columnIndex = 0;
                 while (columnIndex < sequence_control_set_ptr->chroma_width) {
@@ -1634,7 +1654,7 @@ static int64_t try_filter_frame(
     //const Yv12BufferConfig *sd,
     //Av1Comp *const cpi,
     const EbPictureBufferDesc *sd,
-    EbPictureBufferDesc  *tempLfReconBuffer,
+    DlfContext  *context_ptr,
     PictureControlSet *pcs_ptr,
     int32_t filt_level,
     int32_t partial_frame, int32_t plane, int32_t dir) {
@@ -1642,6 +1662,7 @@ static int64_t try_filter_frame(
     (void)partial_frame;
     (void)sd;
     int64_t filt_err;
+    uint64_t sse;
 
     assert(plane >= 0 && plane <= 2);
     int32_t filter_level[2] = { filt_level, filt_level };
@@ -1674,21 +1695,18 @@ static int64_t try_filter_frame(
     case 2: pcs_ptr->parent_pcs_ptr->lf.filter_level_v = filter_level[0]; break;
     }
 
-    av1_loop_filter_frame(recon_buffer, pcs_ptr, plane, plane + 1);
-
-    filt_err = PictureSseCalculations(pcs_ptr, recon_buffer, plane);
-
+    // Filter, then measure and re-instate the unfiltered frame, one SB-row segment per DLF thread
+    dlf_run_segments(context_ptr, pcs_ptr, recon_buffer, DLF_STEP_FILTER, plane, plane + 1, NULL);
 
-
-    // Re-instate the unfiltered frame
-    EbCopyBuffer(tempLfReconBuffer/*cpi->last_frame_uf*/, recon_buffer /*cm->frame_to_show*/, pcs_ptr, (uint8_t)plane);
+    dlf_run_segments(context_ptr, pcs_ptr, recon_buffer, DLF_STEP_SSE_RESTORE, plane, plane + 1, &sse);
+    filt_err = (int64_t)sse;
 
     return filt_err;
 }
 static int32_t search_filter_level(
     //const Yv12BufferConfig *sd, Av1Comp *cpi,
     EbPictureBufferDesc *sd, // source
-    EbPictureBufferDesc  *tempLfReconBuffer,
+    DlfContext  *context_ptr,
     PictureControlSet *pcs_ptr,
     int32_t partial_frame,
     const int32_t *last_frame_filter_level,
@@ -1734,9 +1752,10 @@ static int32_t search_filter_level(
     // Set each entry to -1
     memset(ss_err, 0xFF, sizeof(ss_err));
     // make a copy of recon_buffer
-    EbCopyBuffer(recon_buffer/*cm->frame_to_show*/, tempLfReconBuffer/*&cpi->last_frame_uf*/, pcs_ptr, (uint8_t)plane);
+    EbCopyBufferLayout(recon_buffer/*cm->frame_to_show*/, is16bit ? context_ptr->temp_lf_recon_picture16bit_ptr : context_ptr->temp_lf_recon_picture_ptr);
+    dlf_run_segments(context_ptr, pcs_ptr, recon_buffer, DLF_STEP_BACKUP, plane, plane + 1, NULL);
 
-    best_err = try_filter_frame(sd, tempLfReconBuffer, pcs_ptr, filt_mid, partial_frame, plane, dir);
+    best_err = try_filter_frame(sd, context_ptr, pcs_ptr, filt_mid, partial_frame, plane, dir);
     filt_best = filt_mid;
     ss_err[filt_mid] = best_err;
 
@@ -1758,7 +1777,7 @@ static int32_t search_filter_level(
             // Get Low filter error score
             if (ss_err[filt_low] < 0) {
                 ss_err[filt_low] =
-                    try_filter_frame(sd, tempLfReconBuffer, pcs_ptr, filt_low, partial_frame, plane, dir);
+                    try_filter_frame(sd, context_ptr, pcs_ptr, filt_low, partial_frame, plane, dir);
             }
             // If value is close to the best so far then bias towards a lower loop
             // filter value.
@@ -1775,7 +1794,7 @@ static int32_t search_filter_level(
         if (filt_direction >= 0 && filt_high != filt_mid) {
             if (ss_err[filt_high] < 0) {
                 ss_err[filt_high] =
-                    try_filter_frame(sd, tempLfReconBuffer, pcs_ptr, filt_high, partial_frame, plane, dir);
+                    try_filter_frame(sd, context_ptr, pcs_ptr, filt_high, partial_frame, plane, dir);
             }
             // If value is significantly better than previous best, bias added against
             // raising filter value
@@ -1804,7 +1823,7 @@ static int32_t search_filter_level(
                 // Get Low filter error score
                 if (ss_err[filt_low] < 0) {
                     ss_err[filt_low] =
-                        try_filter_frame(sd, tempLfReconBuffer, pcs_ptr, filt_low, partial_frame, plane, dir);
+                        try_filter_frame(sd, context_ptr, pcs_ptr, filt_low, partial_frame, plane, dir);
                 }
                 // If value is close to the best so far then bias towards a lower loop
                 // filter value.
@@ -1821,7 +1840,7 @@ static int32_t search_filter_level(
             if (filt_direction >= 0 && filt_high != filt_mid) {
                 if (ss_err[filt_high] < 0) {
                     ss_err[filt_high] =
-                        try_filter_frame(sd, tempLfReconBuffer, pcs_ptr, filt_high, partial_frame, plane, dir);
+                        try_filter_frame(sd, context_ptr, pcs_ptr, filt_high, partial_frame, plane, dir);
                 }
                 // If value is significantly better than previous best, bias added against
                 // raising filter value
@@ -1914,18 +1933,16 @@ void av1_pick_filter_level(
             lf->filter_level[1],
             lf->filter_level_u,
             lf->filter_level_v };
-        EbPictureBufferDesc  *tempLfReconBuffer = (scs_ptr->static_config.encoder_bit_depth != EB_8BIT) ? context_ptr->temp_lf_recon_picture16bit_ptr : context_ptr->temp_lf_recon_picture_ptr;
-
         lf->filter_level[0] = lf->filter_level[1] =
-            search_filter_level(srcBuffer, tempLfReconBuffer, pcs_ptr, method == LPF_PICK_FROM_SUBIMAGE,
+            search_filter_level(srcBuffer, context_ptr, pcs_ptr, method == LPF_PICK_FROM_SUBIMAGE,
                 last_frame_filter_level, NULL, 0, 2);
 
         if (num_planes > 1) {
             lf->filter_level_u =
-                search_filter_level(srcBuffer, tempLfReconBuffer, pcs_ptr, method == LPF_PICK_FROM_SUBIMAGE,
+                search_filter_level(srcBuffer, context_ptr, pcs_ptr, method == LPF_PICK_FROM_SUBIMAGE,
                     last_frame_filter_level, NULL, 1, 0);
             lf->filter_level_v =
-                search_filter_level(srcBuffer, tempLfReconBuffer, pcs_ptr, method == LPF_PICK_FROM_SUBIMAGE,
+                search_filter_level(srcBuffer, context_ptr, pcs_ptr, method == LPF_PICK_FROM_SUBIMAGE,
                     last_frame_filter_level, NULL, 2, 0);
         }
     }
@@ -103,6 +103,25 @@ extern "C" {
         PictureControlSet     *pcs_ptr,
         LpfPickMethod          method);
 
+    void EbCopyBufferLayout(
+        EbPictureBufferDesc   *srcBuffer,
+        EbPictureBufferDesc   *dstBuffer);
+
+    void EbCopyBuffer(
+        EbPictureBufferDesc   *srcBuffer,
+        EbPictureBufferDesc   *dstBuffer,
+        PictureControlSet     *pcs_ptr,
+        uint8_t                plane,
+        uint32_t               row_start,
+        uint32_t               row_end);
+
+    uint64_t PictureSseCalculations(
+        PictureControlSet     *picture_control_set_ptr,
+        EbPictureBufferDesc   *recon_ptr,
+        int32_t                plane,
+        uint32_t               row_start,
+        uint32_t               row_end);
+
 
     void av1_filter_block_plane_vert(
         const PictureControlSet *const  pcs_ptr,
@@ -53,6 +53,10 @@ extern "C" {
 #define MEM_MAP_OPT                       1
 #endif
 
+#ifndef LOCK_FREE_FIFO
+#define LOCK_FREE_FIFO                    1 // Lock-free MPMC ring with spin-then-park blocking for EbFifo / EbMuxingQueue
+#endif
+
 #define SHUT_LOOKAHEAD                    0
 #define MINI_GOP_PCS                      0
 #define CHECK_MEM_REDUCTION               0
@@ -351,6 +355,9 @@ enum {
 // Maximum number of tile rows and tile columns
 #define MAX_TILE_ROWS 1024
 #define MAX_TILE_COLS 1024
+#define MAX_TILE_WIDTH (4096)        // Max Tile width in pixels
+#define MAX_TILE_AREA (4096 * 2304)  // Maximum tile area in pixels
+#define AV1_MIN_TILE_SIZE_BYTES 1
 #define MAX_VARTX_DEPTH 2
 #define MI_SIZE_64X64 (64 >> MI_SIZE_LOG2)
 #define MI_SIZE_128X128 (128 >> MI_SIZE_LOG2)
@@ -2333,6 +2340,8 @@ typedef struct EbMemoryMapEntry
     EbPtrType                ptr_type;       // pointer type
 #if MEM_MAP_OPT
     EbPtr                    prev_entry;     // pointer to the prev entry
+    uint64_t                 alloc_size;     // requested bytes
+    uint32_t                 category;       // EbMemoryCategory
 #endif
 } EbMemoryMapEntry;
 
@@ -2371,6 +2380,15 @@ extern    uint32_t                   lib_mutex_count;
 
 extern    uint32_t                   app_malloc_count;
 
+// EbMemoryCategory recorded with the library allocations
+extern    uint32_t                   memory_map_category;
+
+// NUMA placement of large library allocations, that of the instance the
+// memory map belongs to, see eb_numa_placement_init()
+struct EbNumaPlacement;
+extern    struct EbNumaPlacement    *numa_placement;
+extern    void                       eb_numa_place_memory(const struct EbNumaPlacement *placement, void *ptr, size_t size);
+
 #define ALVALUE 32
 #define EB_APP_MALLOC(type, pointer, n_elements, pointer_class, return_type) \
 pointer = (type)malloc(n_elements); \
@@ -2430,6 +2448,8 @@ app_malloc_count++;
         node->ptr_type         = pointer_class; \
         node->ptr              = (EbPtr)pointer;\
         node->prev_entry       = (EbPtr)memory_map;   \
+        node->alloc_size       = (uint64_t)(n_elements); \
+        node->category         = memory_map_category; \
         memory_map             = node;          \
         (*memory_map_index)++; \
         if (n_elements % 8 == 0) \
@@ -2449,12 +2469,15 @@ app_malloc_count++;
         node->ptr_type         = pointer_class; \
         node->ptr              = (EbPtr)pointer;\
         node->prev_entry       = (EbPtr)memory_map;   \
+        node->alloc_size       = (uint64_t)(n_elements); \
+        node->category         = memory_map_category; \
         memory_map             = node;          \
         (*memory_map_index)++; \
         if (n_elements % 8 == 0) \
             *total_lib_memory += ((n_elements) + sizeof(EbMemoryMapEntry)); \
         else \
             *total_lib_memory += (((n_elements)+(8 - ((n_elements) % 8))) + sizeof(EbMemoryMapEntry)); \
+        eb_numa_place_memory(numa_placement, pointer, n_elements); \
         lib_malloc_count++; \
     }
 #endif
@@ -2468,12 +2491,15 @@ app_malloc_count++;
         node->ptr_type         = pointer_class; \
         node->ptr              = (EbPtr)pointer;\
         node->prev_entry       = (EbPtr)memory_map;   \
+        node->alloc_size       = (uint64_t)(n_elements); \
+        node->category         = memory_map_category; \
         memory_map             = node;          \
         (*memory_map_index)++; \
         if (n_elements % 8 == 0) \
             *total_lib_memory += ((n_elements) + sizeof(EbMemoryMapEntry)); \
         else \
             *total_lib_memory += (((n_elements)+(8 - ((n_elements) % 8))) + sizeof(EbMemoryMapEntry)); \
+        eb_numa_place_memory(numa_placement, pointer, n_elements); \
         lib_malloc_count++; \
     }
 
@@ -2487,12 +2513,15 @@ app_malloc_count++;
         node->ptr_type         = pointer_class; \
         node->ptr              = (EbPtr)pointer;\
         node->prev_entry       = (EbPtr)memory_map;   \
+        node->alloc_size       = (uint64_t)(n_elements) * (size); \
+        node->category         = memory_map_category; \
         memory_map             = node;          \
         (*memory_map_index)++; \
         if (n_elements % 8 == 0) \
             *total_lib_memory += ((n_elements) + sizeof(EbMemoryMapEntry)); \
         else \
             *total_lib_memory += (((n_elements)+(8 - ((n_elements) % 8))) + sizeof(EbMemoryMapEntry)); \
+        eb_numa_place_memory(numa_placement, pointer, (n_elements) * (size)); \
         lib_malloc_count++; \
     }
 
@@ -2506,6 +2535,8 @@ app_malloc_count++;
         node->ptr_type         = pointer_class; \
         node->ptr              = (EbPtr)pointer;\
         node->prev_entry       = (EbPtr)memory_map;   \
+        node->alloc_size       = (uint64_t)(n_elements); \
+        node->category         = memory_map_category; \
         memory_map             = node;          \
         (*memory_map_index)++;                  \
         if (n_elements % 8 == 0)                \
@@ -2524,6 +2555,8 @@ app_malloc_count++;
             node->ptr_type         = pointer_class; \
             node->ptr              = (EbPtr)pointer;\
             node->prev_entry       = (EbPtr)memory_map;   \
+            node->alloc_size       = (uint64_t)(n_elements); \
+            node->category         = memory_map_category; \
             memory_map             = node;          \
             (*memory_map_index)++; \
         if (n_elements % 8 == 0) \
@@ -22,8 +22,13 @@
 #include "EbReferenceObject.h"
 
 #include "EbDeblockingFilter.h"
+#include "EbCdef.h"
 
 void av1_loop_restoration_save_boundary_lines(const Yv12BufferConfig *frame, Av1Common *cm, int32_t after_cdef);
+void av1_loop_restoration_save_boundary_rows(const Yv12BufferConfig *frame, Av1Common *cm, int32_t after_cdef, int32_t luma_row_start, int32_t luma_row_end);
+
+static void dlf_process_segment(void *thread_context_ptr, void *owner_context_ptr, uint32_t segment_index);
+static void dlf_fill_helper_task(void *owner_context_ptr, void *task_ptr);
 
 /******************************************************
  * Dlf Context Constructor
@@ -32,20 +37,45 @@ EbErrorType dlf_context_ctor(
     DlfContext **context_dbl_ptr,
     EbFifo                *dlf_input_fifo_ptr,
     EbFifo                *dlf_output_fifo_ptr ,
+    EbFifo                *dlf_feedback_fifo_ptr,
     EbBool                  is16bit,
     EbColorFormat           color_format,
     uint32_t                max_input_luma_width,
-    uint32_t                max_input_luma_height
+    uint32_t                max_input_luma_height,
+    uint32_t                segment_row_count,
+    uint32_t                helper_count
    )
 {
     EbErrorType return_error = EB_ErrorNone;
     DlfContext *context_ptr;
+    uint32_t segment_index;
     EB_MALLOC(DlfContext*, context_ptr, sizeof(DlfContext), EB_N_PTR);
     *context_dbl_ptr = context_ptr;
 
     // Input/Output System Resource Manager FIFOs
     context_ptr->dlf_input_fifo_ptr = dlf_input_fifo_ptr;
     context_ptr->dlf_output_fifo_ptr = dlf_output_fifo_ptr;
+    context_ptr->dlf_feedback_fifo_ptr = dlf_feedback_fifo_ptr;
+
+    // Segment job
+    context_ptr->segment_row_count = MAX(segment_row_count, 1);
+    context_ptr->job_pcs_ptr = (PictureControlSet*)EB_NULL;
+    context_ptr->job_recon_ptr = (EbPictureBufferDesc*)EB_NULL;
+    context_ptr->job_sse = 0;
+    return_error = eb_segment_job_ctor(
+        &context_ptr->segment_job,
+        context_ptr,
+        dlf_feedback_fifo_ptr,
+        helper_count,
+        0,
+        dlf_process_segment,
+        dlf_fill_helper_task);
+    if (return_error != EB_ErrorNone)
+        return return_error;
+    EB_MALLOC(EbHandle*, context_ptr->segment_row_semaphore_array, sizeof(EbHandle) * context_ptr->segment_row_count, EB_N_PTR);
+    for (segment_index = 0; segment_index < context_ptr->segment_row_count; ++segment_index) {
+        EB_CREATESEMAPHORE(EbHandle, context_ptr->segment_row_semaphore_array[segment_index], sizeof(EbHandle), EB_SEMAPHORE, 0, 0x7FFFFFFF);
+    }
 
 
 
@@ -81,6 +111,386 @@ EbErrorType dlf_context_ctor(
     return return_error;
 }
 
+/******************************************************
+ * Dlf Filter Segment
+ *   Deblocks the SB rows of one segment. The horizontal
+ *   edges on top of a segment modify the last rows of
+ *   the segment above, so the first row of a segment
+ *   follows the last row of the segment above in a
+ *   wavefront: one semaphore post per SB column whose
+ *   horizontal edges are done.
+ ******************************************************/
+static void dlf_filter_segment(
+    DlfContext              *owner_ptr,
+    uint32_t                 segment_index)
+{
+    PictureControlSet   *picture_control_set_ptr = owner_ptr->job_pcs_ptr;
+    SequenceControlSet  *sequence_control_set_ptr = (SequenceControlSet*)picture_control_set_ptr->sequence_control_set_wrapper_ptr->object_ptr;
+    uint8_t              sb_size_log2 = (uint8_t)Log2f(sequence_control_set_ptr->sb_size_pix);
+    uint32_t             picture_width_in_sb = (sequence_control_set_ptr->luma_width + sequence_control_set_ptr->sb_size_pix - 1) / sequence_control_set_ptr->sb_size_pix;
+    uint32_t             picture_height_in_sb = (sequence_control_set_ptr->luma_height + sequence_control_set_ptr->sb_size_pix - 1) / sequence_control_set_ptr->sb_size_pix;
+    uint32_t             y_sb_start = SEGMENT_START_IDX(segment_index, picture_height_in_sb, owner_ptr->segment_job.segment_count);
+    uint32_t             y_sb_end = SEGMENT_END_IDX(segment_index, picture_height_in_sb, owner_ptr->segment_job.segment_count);
+    EbBool               wait_above = (EbBool)(segment_index > 0);
+    EbBool               post_below = (EbBool)(segment_index < owner_ptr->segment_job.segment_count - 1);
+    uint32_t             waited_count = 0;
+    uint32_t             posted_count = 0;
+    uint32_t             x_sb_index;
+    uint32_t             y_sb_index;
+
+    for (y_sb_index = y_sb_start; y_sb_index < y_sb_end; ++y_sb_index) {
+        for (x_sb_index = 0; x_sb_index < picture_width_in_sb; ++x_sb_index) {
+            EbBool   end_of_row_flag = (x_sb_index == picture_width_in_sb - 1) ? EB_TRUE : EB_FALSE;
+            // Horizontal edges of the columns before x_sb_index (all columns at the end of the row) are filtered by this SB
+            uint32_t horz_done_count = end_of_row_flag ? picture_width_in_sb : x_sb_index;
+
+            if (wait_above && y_sb_index == y_sb_start) {
+                while (waited_count < horz_done_count) {
+                    eb_block_on_semaphore(owner_ptr->segment_row_semaphore_array[segment_index - 1]);
+                    ++waited_count;
+                }
+            }
+
+            loop_filter_sb(
+                owner_ptr->job_recon_ptr,
+                picture_control_set_ptr,
+                NULL,
+                (y_sb_index << sb_size_log2) >> 2,
+                (x_sb_index << sb_size_log2) >> 2,
+                owner_ptr->job_plane_start,
+                owner_ptr->job_plane_end,
+                end_of_row_flag);
+
+            if (post_below && y_sb_index == y_sb_end - 1) {
+                while (posted_count < horz_done_count) {
+                    eb_post_semaphore(owner_ptr->segment_row_semaphore_array[segment_index]);
+                    ++posted_count;
+                }
+            }
+        }
+    }
+}
+
+/******************************************************
+ * Dlf Process Segment
+ ******************************************************/
+static void dlf_process_segment(
+    void                    *thread_context_ptr,
+    void                    *owner_context_ptr,
+    uint32_t                 segment_index)
+{
+    DlfContext          *owner_ptr = (DlfContext*)owner_context_ptr;
+    PictureControlSet   *picture_control_set_ptr = owner_ptr->job_pcs_ptr;
+    SequenceControlSet  *sequence_control_set_ptr = (SequenceControlSet*)picture_control_set_ptr->sequence_control_set_wrapper_ptr->object_ptr;
+    EbPictureBufferDesc *temp_lf_recon_buffer = (sequence_control_set_ptr->static_config.encoder_bit_depth > EB_8BIT) ?
+        owner_ptr->temp_lf_recon_picture16bit_ptr :
+        owner_ptr->temp_lf_recon_picture_ptr;
+    uint32_t             picture_height_in_sb = (sequence_control_set_ptr->luma_height + sequence_control_set_ptr->sb_size_pix - 1) / sequence_control_set_ptr->sb_size_pix;
+    uint32_t             row_start = SEGMENT_START_IDX(segment_index, picture_height_in_sb, owner_ptr->segment_job.segment_count) * sequence_control_set_ptr->sb_size_pix;
+    uint32_t             row_end = SEGMENT_END_IDX(segment_index, picture_height_in_sb, owner_ptr->segment_job.segment_count) * sequence_control_set_ptr->sb_size_pix;
+    uint64_t             sse;
+    int32_t              plane;
+
+    switch (owner_ptr->job_step) {
+    case DLF_STEP_FILTER:
+        dlf_filter_segment(owner_ptr, segment_index);
+        break;
+    case DLF_STEP_BACKUP:
+        for (plane = owner_ptr->job_plane_start; plane < owner_ptr->job_plane_end; ++plane)
+            EbCopyBuffer(owner_ptr->job_recon_ptr, temp_lf_recon_buffer, picture_control_set_ptr, (uint8_t)plane, row_start, row_end);
+        break;
+    case DLF_STEP_SSE_RESTORE:
+        sse = 0;
+        for (plane = owner_ptr->job_plane_start; plane < owner_ptr->job_plane_end; ++plane) {
+            sse += PictureSseCalculations(picture_control_set_ptr, owner_ptr->job_recon_ptr, plane, row_start, row_end);
+            EbCopyBuffer(temp_lf_recon_buffer, owner_ptr->job_recon_ptr, picture_control_set_ptr, (uint8_t)plane, row_start, row_end);
+        }
+        eb_block_on_mutex(owner_ptr->segment_job.mutex);
+        owner_ptr->job_sse += sse;
+        eb_release_mutex(owner_ptr->segment_job.mutex);
+        break;
+    default:
+        break;
+    }
+}
+
+/******************************************************
+ * Dlf Fill Helper Task
+ *   The feedback tasks come from the pool EncDec feeds
+ *   DLF from
+ ******************************************************/
+static void dlf_fill_helper_task(
+    void                    *owner_context_ptr,
+    void                    *task_ptr)
+{
+    EncDecResults *helper_ptr = (EncDecResults*)task_ptr;
+
+    helper_ptr->picture_control_set_wrapper_ptr = (EbObjectWrapper*)EB_NULL;
+    helper_ptr->input_type = DLF_TASKS_DLF_INPUT;
+    helper_ptr->dlf_context_ptr = owner_context_ptr;
+}
+
+/******************************************************
+ * Dlf Run Segments
+ *   Splits one step of the deblocking of a picture into
+ *   SB-row segments and returns when all segments are
+ *   done, see eb_segment_job_run().
+ ******************************************************/
+void dlf_run_segments(
+    DlfContext              *context_ptr,
+    PictureControlSet       *picture_control_set_ptr,
+    EbPictureBufferDesc     *recon_buffer,
+    DlfSegmentStep           step,
+    int32_t                  plane_start,
+    int32_t                  plane_end,
+    uint64_t                *sse)
+{
+    SequenceControlSet  *sequence_control_set_ptr = (SequenceControlSet*)picture_control_set_ptr->sequence_control_set_wrapper_ptr->object_ptr;
+    uint32_t             picture_height_in_sb = (sequence_control_set_ptr->luma_height + sequence_control_set_ptr->sb_size_pix - 1) / sequence_control_set_ptr->sb_size_pix;
+
+    if (step == DLF_STEP_FILTER)
+        av1_loop_filter_frame_init(picture_control_set_ptr, plane_start, plane_end);
+
+    context_ptr->job_pcs_ptr = picture_control_set_ptr;
+    context_ptr->job_recon_ptr = recon_buffer;
+    context_ptr->job_step = step;
+    context_ptr->job_plane_start = plane_start;
+    context_ptr->job_plane_end = plane_end;
+    context_ptr->job_sse = 0;
+
+    eb_segment_job_run(
+        &context_ptr->segment_job,
+        MIN(context_ptr->segment_row_count, picture_height_in_sb));
+
+    if (sse)
+        *sse = context_ptr->job_sse;
+}
+
+/******************************************************
+ * Recon picture the in-loop filters work on
+ ******************************************************/
+static EbPictureBufferDesc *get_dlf_recon_picture(
+    PictureControlSet            *picture_control_set_ptr,
+    EbBool                        is16bit)
+{
+    if (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE) {
+        EbReferenceObject *reference_object = (EbReferenceObject*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr;
+        return is16bit ? reference_object->reference_picture16bit : reference_object->reference_picture;
+    }
+    return is16bit ? picture_control_set_ptr->recon_picture16bit_ptr : picture_control_set_ptr->recon_picture_ptr;
+}
+
+/******************************************************
+ * Sets the CDEF segments and the frame to show of
+ * the picture, before any row is passed to CDEF
+ ******************************************************/
+static void dlf_init_cdef(
+    SequenceControlSet           *sequence_control_set_ptr,
+    PictureControlSet            *picture_control_set_ptr,
+    EbPictureBufferDesc          *recon_picture_ptr)
+{
+    link_eb_to_aom_buffer_desc(
+        recon_picture_ptr,
+        picture_control_set_ptr->parent_pcs_ptr->av1_cm->frame_to_show);
+
+    picture_control_set_ptr->cdef_segments_column_count = sequence_control_set_ptr->cdef_segment_column_count;
+    picture_control_set_ptr->cdef_segments_row_count    = sequence_control_set_ptr->cdef_segment_row_count;
+    picture_control_set_ptr->cdef_segments_total_count  = (uint16_t)(picture_control_set_ptr->cdef_segments_column_count  * picture_control_set_ptr->cdef_segments_row_count);
+    picture_control_set_ptr->tot_seg_searched_cdef      = 0;
+}
+
+/******************************************************
+ * Prepares the luma rows [row_start, row_end) of the
+ * deblocked recon and of the input for the CDEF search
+ ******************************************************/
+static void dlf_prepare_cdef_rows(
+    SequenceControlSet           *sequence_control_set_ptr,
+    PictureControlSet            *picture_control_set_ptr,
+    EbPictureBufferDesc          *recon_picture_ptr,
+    uint32_t                      row_start,
+    uint32_t                      row_end)
+{
+    EbBool is16bit = (EbBool)(sequence_control_set_ptr->static_config.encoder_bit_depth > EB_8BIT);
+
+    if (!sequence_control_set_ptr->enable_cdef || !picture_control_set_ptr->parent_pcs_ptr->cdef_filter_mode)
+        return;
+
+    if (is16bit)
+    {
+        picture_control_set_ptr->src[0] = (uint16_t*)recon_picture_ptr->buffer_y + (recon_picture_ptr->origin_x + recon_picture_ptr->origin_y     * recon_picture_ptr->stride_y);
+        picture_control_set_ptr->src[1] = (uint16_t*)recon_picture_ptr->buffer_cb + (recon_picture_ptr->origin_x / 2 + recon_picture_ptr->origin_y / 2 * recon_picture_ptr->stride_cb);
+        picture_control_set_ptr->src[2] = (uint16_t*)recon_picture_ptr->buffer_cr + (recon_picture_ptr->origin_x / 2 + recon_picture_ptr->origin_y / 2 * recon_picture_ptr->stride_cr);
+
+        EbPictureBufferDesc *input_picture_ptr = picture_control_set_ptr->input_frame16bit;
+        picture_control_set_ptr->ref_coeff[0] = (uint16_t*)input_picture_ptr->buffer_y + (input_picture_ptr->origin_x + input_picture_ptr->origin_y * input_picture_ptr->stride_y);
+        picture_control_set_ptr->ref_coeff[1] = (uint16_t*)input_picture_ptr->buffer_cb + (input_picture_ptr->origin_x / 2 + input_picture_ptr->origin_y / 2 * input_picture_ptr->stride_cb);
+        picture_control_set_ptr->ref_coeff[2] = (uint16_t*)input_picture_ptr->buffer_cr + (input_picture_ptr->origin_x / 2 + input_picture_ptr->origin_y / 2 * input_picture_ptr->stride_cr);
+
+    }
+    else
+    {
+        //these copies should go!
+        EbByte  rec_ptr = &((recon_picture_ptr->buffer_y)[recon_picture_ptr->origin_x + recon_picture_ptr->origin_y * recon_picture_ptr->stride_y]);
+        EbByte  rec_ptr_cb = &((recon_picture_ptr->buffer_cb)[recon_picture_ptr->origin_x / 2 + recon_picture_ptr->origin_y / 2 * recon_picture_ptr->stride_cb]);
+        EbByte  rec_ptr_cr = &((recon_picture_ptr->buffer_cr)[recon_picture_ptr->origin_x / 2 + recon_picture_ptr->origin_y / 2 * recon_picture_ptr->stride_cr]);
+
+        EbPictureBufferDesc *input_picture_ptr = (EbPictureBufferDesc*)picture_control_set_ptr->parent_pcs_ptr->enhanced_picture_ptr;
+        EbByte  enh_ptr = &((input_picture_ptr->buffer_y)[input_picture_ptr->origin_x + input_picture_ptr->origin_y * input_picture_ptr->stride_y]);
+        EbByte  enh_ptr_cb = &((input_picture_ptr->buffer_cb)[input_picture_ptr->origin_x / 2 + input_picture_ptr->origin_y / 2 * input_picture_ptr->stride_cb]);
+        EbByte  enh_ptr_cr = &((input_picture_ptr->buffer_cr)[input_picture_ptr->origin_x / 2 + input_picture_ptr->origin_y / 2 * input_picture_ptr->stride_cr]);
+
+        uint32_t chroma_row_start = row_start / 2;
+        uint32_t chroma_row_end = (row_end == sequence_control_set_ptr->luma_height) ? sequence_control_set_ptr->luma_height / 2 : row_end / 2;
+
+        for (uint32_t r = row_start; r < row_end; ++r) {
+            for (int c = 0; c < sequence_control_set_ptr->luma_width; ++c) {
+                picture_control_set_ptr->src[0]      [r * sequence_control_set_ptr->luma_width + c] = rec_ptr[r * recon_picture_ptr->stride_y + c];
+                picture_control_set_ptr->ref_coeff[0][r * sequence_control_set_ptr->luma_width + c] = enh_ptr[r * input_picture_ptr->stride_y + c];
+            }
+        }
+
+        for (uint32_t r = chroma_row_start; r < chroma_row_end; ++r) {
+            for (int c = 0; c < sequence_control_set_ptr->luma_width/2; ++c) {
+                picture_control_set_ptr->src[1][r * sequence_control_set_ptr->luma_width/2 + c] = rec_ptr_cb[r * recon_picture_ptr->stride_cb + c];
+                picture_control_set_ptr->ref_coeff[1][r * sequence_control_set_ptr->luma_width/2 + c] = enh_ptr_cb[r * input_picture_ptr->stride_cb + c];
+                picture_control_set_ptr->src[2][r * sequence_control_set_ptr->luma_width / 2 + c] = rec_ptr_cr[r * recon_picture_ptr->stride_cr + c];
+                picture_control_set_ptr->ref_coeff[2][r * sequence_control_set_ptr->luma_width / 2 + c] = enh_ptr_cr[r * input_picture_ptr->stride_cr + c];
+            }
+        }
+    }
+}
+
+/******************************************************
+ * Posts the CDEF search segments of the segment rows
+ * [segment_row_start, segment_row_end). The picture
+ * may be done with and reused once its last segment
+ * is posted, so it is not read after the posts.
+ ******************************************************/
+static void dlf_post_cdef_segments(
+    DlfContext                   *context_ptr,
+    PictureControlSet            *picture_control_set_ptr,
+    EbObjectWrapper              *picture_control_set_wrapper_ptr,
+    uint32_t                      segment_row_start,
+    uint32_t                      segment_row_end)
+{
+    EbObjectWrapper   *dlf_results_wrapper_ptr;
+    struct DlfResults *dlf_results_ptr;
+    uint32_t           segment_index;
+    const uint32_t     segment_index_end = segment_row_end * picture_control_set_ptr->cdef_segments_column_count;
+
+    for (segment_index = segment_row_start * picture_control_set_ptr->cdef_segments_column_count; segment_index < segment_index_end; ++segment_index)
+    {
+        // Get Empty DLF Results to Cdef
+        eb_get_empty_object(
+            context_ptr->dlf_output_fifo_ptr,
+            &dlf_results_wrapper_ptr);
+        dlf_results_ptr = (struct DlfResults*)dlf_results_wrapper_ptr->object_ptr;
+        dlf_results_ptr->picture_control_set_wrapper_ptr = picture_control_set_wrapper_ptr;
+        dlf_results_ptr->segment_index = segment_index;
+        dlf_results_ptr->input_type = CDEF_TASKS_DLF_INPUT;
+        // Post DLF Results
+        eb_post_full_object(dlf_results_wrapper_ptr);
+    }
+}
+
+/******************************************************
+ * Row pipeline (filter_row_pipeline): the SB rows come
+ * from EncDec deblocked, by batches in any order and
+ * on any DLF thread. A row is final once the row below
+ * is encoded, as the deblocking of the top edge of an
+ * SB changes the rows above it. The final rows are
+ * prepared for the CDEF search and its segments are
+ * posted once their rows, and the CDEF border below,
+ * are final. The batch handled last completes the
+ * picture.
+ ******************************************************/
+static void dlf_stream_rows(
+    DlfContext                   *context_ptr,
+    SequenceControlSet           *sequence_control_set_ptr,
+    PictureControlSet            *picture_control_set_ptr,
+    EncDecResults                *enc_dec_results_ptr)
+{
+    EbBool               is16bit = (EbBool)(sequence_control_set_ptr->static_config.encoder_bit_depth > EB_8BIT);
+    EbPictureBufferDesc *recon_picture_ptr = get_dlf_recon_picture(picture_control_set_ptr, is16bit);
+    Av1Common           *cm = picture_control_set_ptr->parent_pcs_ptr->av1_cm;
+    uint32_t             sb_size = sequence_control_set_ptr->sb_size_pix;
+    uint32_t             picture_height_in_sb = (sequence_control_set_ptr->luma_height + sb_size - 1) / sb_size;
+    uint32_t             picture_height_in_b64 = (sequence_control_set_ptr->luma_height + 64 - 1) / 64;
+    uint32_t             final_count;
+    uint32_t             final_luma_rows;
+    uint32_t             segment_row_start;
+    uint32_t             segment_row_end;
+
+    eb_block_on_mutex(picture_control_set_ptr->filter_row_mutex);
+
+    if (picture_control_set_ptr->filter_row_started == EB_FALSE) {
+        dlf_init_cdef(
+            sequence_control_set_ptr,
+            picture_control_set_ptr,
+            recon_picture_ptr);
+        picture_control_set_ptr->filter_row_started = EB_TRUE;
+    }
+
+    ++picture_control_set_ptr->filter_row_handled_count;
+    picture_control_set_ptr->filter_row_available_count = (uint16_t)MAX(
+        picture_control_set_ptr->filter_row_available_count,
+        enc_dec_results_ptr->completed_lcu_row_index_start + enc_dec_results_ptr->completed_lcu_row_count);
+
+    // Once the last row is in, the post count of EncDec is final. The last
+    // row is held back until all the posts are handled, so that the last CDEF
+    // segments are posted by the last DLF thread to touch the picture.
+    if (picture_control_set_ptr->filter_row_available_count == picture_height_in_sb)
+        final_count = (picture_control_set_ptr->filter_row_handled_count == picture_control_set_ptr->filter_row_post_count) ?
+            picture_height_in_sb :
+            picture_height_in_sb - 1;
+    else
+        final_count = picture_control_set_ptr->filter_row_available_count > 0 ? picture_control_set_ptr->filter_row_available_count - 1 : 0;
+
+    if (final_count > picture_control_set_ptr->filter_row_final_count) {
+        uint32_t row_start = picture_control_set_ptr->filter_row_final_count * sb_size;
+        uint32_t row_end = MIN(final_count * sb_size, sequence_control_set_ptr->luma_height);
+
+        if (sequence_control_set_ptr->enable_restoration)
+            av1_loop_restoration_save_boundary_rows(cm->frame_to_show, cm, 0, row_start, row_end);
+
+        dlf_prepare_cdef_rows(
+            sequence_control_set_ptr,
+            picture_control_set_ptr,
+            recon_picture_ptr,
+            row_start,
+            row_end);
+
+        picture_control_set_ptr->filter_row_final_count = (uint16_t)final_count;
+    }
+
+    // A segment row is searched on its rows, completed up to the SB boundary
+    // for the 128x128 filter blocks, and CDEF_VBORDER chroma lines below
+    final_luma_rows = MIN(picture_control_set_ptr->filter_row_final_count * sb_size, sequence_control_set_ptr->luma_height);
+    segment_row_end = picture_control_set_ptr->filter_cdef_seg_row_count;
+    while (segment_row_end < picture_control_set_ptr->cdef_segments_row_count) {
+        uint32_t b64_row_end = SEGMENT_END_IDX(segment_row_end, picture_height_in_b64, picture_control_set_ptr->cdef_segments_row_count);
+        uint32_t needed_rows = ((b64_row_end * 64 + sb_size - 1) / sb_size) * sb_size + 2 * CDEF_VBORDER;
+        if (final_luma_rows < MIN(needed_rows, sequence_control_set_ptr->luma_height))
+            break;
+        ++segment_row_end;
+    }
+
+    segment_row_start = picture_control_set_ptr->filter_cdef_seg_row_count;
+    picture_control_set_ptr->filter_cdef_seg_row_count = (uint8_t)segment_row_end;
+
+    eb_release_mutex(picture_control_set_ptr->filter_row_mutex);
+
+    // Posted last, see dlf_post_cdef_segments()
+    if (segment_row_end > segment_row_start) {
+        dlf_post_cdef_segments(
+            context_ptr,
+            picture_control_set_ptr,
+            enc_dec_results_ptr->picture_control_set_wrapper_ptr,
+            segment_row_start,
+            segment_row_end);
+    }
+}
+
 /******************************************************
  * Dlf Kernel
  ******************************************************/
@@ -95,10 +505,6 @@ void* dlf_kernel(void *input_ptr)
     EbObjectWrapper                       *enc_dec_results_wrapper_ptr;
     EncDecResults                         *enc_dec_results_ptr;
 
-    //// Output
-    EbObjectWrapper                       *dlf_results_wrapper_ptr;
-    struct DlfResults*                     dlf_results_ptr;
-
     // SB Loop variables
     for (;;) {
 
@@ -108,6 +514,16 @@ void* dlf_kernel(void *input_ptr)
             &enc_dec_results_wrapper_ptr);
 
         enc_dec_results_ptr         = (EncDecResults*)enc_dec_results_wrapper_ptr->object_ptr;
+
+        // Segments of the picture of another DLF thread
+        if (enc_dec_results_ptr->input_type == DLF_TASKS_DLF_INPUT) {
+            eb_segment_job_help(
+                &((DlfContext*)enc_dec_results_ptr->dlf_context_ptr)->segment_job,
+                context_ptr);
+            eb_release_object(enc_dec_results_wrapper_ptr);
+            continue;
+        }
+
         picture_control_set_ptr     = (PictureControlSet*)enc_dec_results_ptr->picture_control_set_wrapper_ptr->object_ptr;
         sequence_control_set_ptr    = (SequenceControlSet*)picture_control_set_ptr->sequence_control_set_wrapper_ptr->object_ptr;
 
@@ -158,102 +574,49 @@ void* dlf_kernel(void *input_ptr)
             picture_control_set_ptr->parent_pcs_ptr->lf.filter_level_u = 0;
             picture_control_set_ptr->parent_pcs_ptr->lf.filter_level_v = 0;
 #endif
-                av1_loop_filter_frame(
-                    recon_buffer,
+                dlf_run_segments(
+                    context_ptr,
                     picture_control_set_ptr,
+                    recon_buffer,
+                    DLF_STEP_FILTER,
                     0,
-                    3);
+                    3,
+                    NULL);
             }
 
-        //pre-cdef prep
-        {
-            Av1Common* cm = picture_control_set_ptr->parent_pcs_ptr->av1_cm;
-            EbPictureBufferDesc  * recon_picture_ptr;
-            if (is16bit) {
-                if (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE)
-                    recon_picture_ptr = ((EbReferenceObject*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr)->reference_picture16bit;
-                else
-                    recon_picture_ptr = picture_control_set_ptr->recon_picture16bit_ptr;
-            }
-            else {
-                if (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE)
-                    recon_picture_ptr = ((EbReferenceObject*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr)->reference_picture;
-                else
-                    recon_picture_ptr = picture_control_set_ptr->recon_picture_ptr;
-            }
+        if (picture_control_set_ptr->parent_pcs_ptr->filter_row_pipeline) {
+            dlf_stream_rows(
+                context_ptr,
+                sequence_control_set_ptr,
+                picture_control_set_ptr,
+                enc_dec_results_ptr);
+        }
+        else {
+            EbPictureBufferDesc *recon_picture_ptr = get_dlf_recon_picture(picture_control_set_ptr, is16bit);
 
-            link_eb_to_aom_buffer_desc(
-                recon_picture_ptr,
-                cm->frame_to_show);
+            //pre-cdef prep
+            dlf_init_cdef(
+                sequence_control_set_ptr,
+                picture_control_set_ptr,
+                recon_picture_ptr);
 
             if (sequence_control_set_ptr->enable_restoration) {
-                av1_loop_restoration_save_boundary_lines(cm->frame_to_show, cm, 0);
+                av1_loop_restoration_save_boundary_lines(picture_control_set_ptr->parent_pcs_ptr->av1_cm->frame_to_show, picture_control_set_ptr->parent_pcs_ptr->av1_cm, 0);
             }
 
-            if (sequence_control_set_ptr->enable_cdef && picture_control_set_ptr->parent_pcs_ptr->cdef_filter_mode)
-            {
-
-                if (is16bit)
-                {
-                    picture_control_set_ptr->src[0] = (uint16_t*)recon_picture_ptr->buffer_y + (recon_picture_ptr->origin_x + recon_picture_ptr->origin_y     * recon_picture_ptr->stride_y);
-                    picture_control_set_ptr->src[1] = (uint16_t*)recon_picture_ptr->buffer_cb + (recon_picture_ptr->origin_x / 2 + recon_picture_ptr->origin_y / 2 * recon_picture_ptr->stride_cb);
-                    picture_control_set_ptr->src[2] = (uint16_t*)recon_picture_ptr->buffer_cr + (recon_picture_ptr->origin_x / 2 + recon_picture_ptr->origin_y / 2 * recon_picture_ptr->stride_cr);
-
-                    EbPictureBufferDesc *input_picture_ptr = picture_control_set_ptr->input_frame16bit;
-                    picture_control_set_ptr->ref_coeff[0] = (uint16_t*)input_picture_ptr->buffer_y + (input_picture_ptr->origin_x + input_picture_ptr->origin_y * input_picture_ptr->stride_y);
-                    picture_control_set_ptr->ref_coeff[1] = (uint16_t*)input_picture_ptr->buffer_cb + (input_picture_ptr->origin_x / 2 + input_picture_ptr->origin_y / 2 * input_picture_ptr->stride_cb);
-                    picture_control_set_ptr->ref_coeff[2] = (uint16_t*)input_picture_ptr->buffer_cr + (input_picture_ptr->origin_x / 2 + input_picture_ptr->origin_y / 2 * input_picture_ptr->stride_cr);
-
-                }
-                else
-                {
-                    //these copies should go!
-                    EbByte  rec_ptr = &((recon_picture_ptr->buffer_y)[recon_picture_ptr->origin_x + recon_picture_ptr->origin_y * recon_picture_ptr->stride_y]);
-                    EbByte  rec_ptr_cb = &((recon_picture_ptr->buffer_cb)[recon_picture_ptr->origin_x / 2 + recon_picture_ptr->origin_y / 2 * recon_picture_ptr->stride_cb]);
-                    EbByte  rec_ptr_cr = &((recon_picture_ptr->buffer_cr)[recon_picture_ptr->origin_x / 2 + recon_picture_ptr->origin_y / 2 * recon_picture_ptr->stride_cr]);
-
-                    EbPictureBufferDesc *input_picture_ptr = (EbPictureBufferDesc*)picture_control_set_ptr->parent_pcs_ptr->enhanced_picture_ptr;
-                    EbByte  enh_ptr = &((input_picture_ptr->buffer_y)[input_picture_ptr->origin_x + input_picture_ptr->origin_y * input_picture_ptr->stride_y]);
-                    EbByte  enh_ptr_cb = &((input_picture_ptr->buffer_cb)[input_picture_ptr->origin_x / 2 + input_picture_ptr->origin_y / 2 * input_picture_ptr->stride_cb]);
-                    EbByte  enh_ptr_cr = &((input_picture_ptr->buffer_cr)[input_picture_ptr->origin_x / 2 + input_picture_ptr->origin_y / 2 * input_picture_ptr->stride_cr]);
-
-                    for (int r = 0; r < sequence_control_set_ptr->luma_height; ++r) {
-                        for (int c = 0; c < sequence_control_set_ptr->luma_width; ++c) {
-                        picture_control_set_ptr->src[0]      [r * sequence_control_set_ptr->luma_width + c] = rec_ptr[r * recon_picture_ptr->stride_y + c];
-                        picture_control_set_ptr->ref_coeff[0][r * sequence_control_set_ptr->luma_width + c] = enh_ptr[r * input_picture_ptr->stride_y + c];
-                        }
-                    }
-
-                for (int r = 0; r < sequence_control_set_ptr->luma_height/2; ++r) {
-                    for (int c = 0; c < sequence_control_set_ptr->luma_width/2; ++c) {
-                        picture_control_set_ptr->src[1][r * sequence_control_set_ptr->luma_width/2 + c] = rec_ptr_cb[r * recon_picture_ptr->stride_cb + c];
-                        picture_control_set_ptr->ref_coeff[1][r * sequence_control_set_ptr->luma_width/2 + c] = enh_ptr_cb[r * input_picture_ptr->stride_cb + c];
-                            picture_control_set_ptr->src[2][r * sequence_control_set_ptr->luma_width / 2 + c] = rec_ptr_cr[r * recon_picture_ptr->stride_cr + c];
-                            picture_control_set_ptr->ref_coeff[2][r * sequence_control_set_ptr->luma_width / 2 + c] = enh_ptr_cr[r * input_picture_ptr->stride_cr + c];
-                        }
-                    }
-                }
-            }
-
-        }
+            dlf_prepare_cdef_rows(
+                sequence_control_set_ptr,
+                picture_control_set_ptr,
+                recon_picture_ptr,
+                0,
+                sequence_control_set_ptr->luma_height);
 
-        picture_control_set_ptr->cdef_segments_column_count =  sequence_control_set_ptr->cdef_segment_column_count;
-        picture_control_set_ptr->cdef_segments_row_count    = sequence_control_set_ptr->cdef_segment_row_count;
-        picture_control_set_ptr->cdef_segments_total_count  = (uint16_t)(picture_control_set_ptr->cdef_segments_column_count  * picture_control_set_ptr->cdef_segments_row_count);
-        picture_control_set_ptr->tot_seg_searched_cdef      = 0;
-        uint32_t segment_index;
-
-        for (segment_index = 0; segment_index < picture_control_set_ptr->cdef_segments_total_count; ++segment_index)
-        {
-            // Get Empty DLF Results to Cdef
-            eb_get_empty_object(
-                context_ptr->dlf_output_fifo_ptr,
-                &dlf_results_wrapper_ptr);
-            dlf_results_ptr = (struct DlfResults*)dlf_results_wrapper_ptr->object_ptr;
-            dlf_results_ptr->picture_control_set_wrapper_ptr = enc_dec_results_ptr->picture_control_set_wrapper_ptr;
-            dlf_results_ptr->segment_index = segment_index;
-            // Post DLF Results
-            eb_post_full_object(dlf_results_wrapper_ptr);
+            dlf_post_cdef_segments(
+                context_ptr,
+                picture_control_set_ptr,
+                enc_dec_results_ptr->picture_control_set_wrapper_ptr,
+                0,
+                picture_control_set_ptr->cdef_segments_row_count);
         }
 
 
@@ -14,6 +14,17 @@
 #include "EbUtility.h"
 #include "EbPsnr.h"
 #include "EbPictureControlSet.h"
+#include "EbSegmentJob.h"
+
+/**************************************
+ * Dlf Segment Steps
+ **************************************/
+typedef enum DlfSegmentStep
+{
+    DLF_STEP_FILTER,        // deblock the rows of the segment
+    DLF_STEP_BACKUP,        // save the unfiltered rows to the temporary buffer
+    DLF_STEP_SSE_RESTORE    // sse of the filtered rows, then restore the unfiltered rows
+} DlfSegmentStep;
 
 /**************************************
  * Dlf Context
@@ -22,8 +33,22 @@ typedef struct DlfContext
 {
     EbFifo              *dlf_input_fifo_ptr;
     EbFifo              *dlf_output_fifo_ptr;
+    EbFifo              *dlf_feedback_fifo_ptr;
     EbPictureBufferDesc *temp_lf_recon_picture_ptr;
     EbPictureBufferDesc *temp_lf_recon_picture16bit_ptr;
+
+    // Segment job of this context, the SB-row segments are shared with
+    // the helper DLF threads posted through the feedback fifo
+    EbSegmentJob         segment_job;
+    EbHandle            *segment_row_semaphore_array;   // bottom row of segment i done, per SB column
+    uint32_t             segment_row_count;
+
+    PictureControlSet   *job_pcs_ptr;
+    EbPictureBufferDesc *job_recon_ptr;
+    DlfSegmentStep       job_step;
+    int32_t              job_plane_start;
+    int32_t              job_plane_end;
+    uint64_t             job_sse;
 } DlfContext;
 
 /**************************************
@@ -33,12 +58,24 @@ extern EbErrorType dlf_context_ctor(
     DlfContext **context_dbl_ptr,
     EbFifo                       *dlf_input_fifo_ptr,
     EbFifo                       *dlf_output_fifo_ptr,
+    EbFifo                       *dlf_feedback_fifo_ptr,
     EbBool                  is16bit,
     EbColorFormat           color_format,
     uint32_t                max_input_luma_width,
-    uint32_t                max_input_luma_height
+    uint32_t                max_input_luma_height,
+    uint32_t                segment_row_count,
+    uint32_t                helper_count
    );
 
+extern void dlf_run_segments(
+    DlfContext              *context_ptr,
+    PictureControlSet       *picture_control_set_ptr,
+    EbPictureBufferDesc     *recon_buffer,
+    DlfSegmentStep           step,
+    int32_t                  plane_start,
+    int32_t                  plane_end,
+    uint64_t                *sse);
+
 extern void* dlf_kernel(void *input_ptr);
 
 #endif // EbEntropyCodingProcess_h
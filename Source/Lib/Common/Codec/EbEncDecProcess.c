@@ -18,6 +18,7 @@
 
 #include "EbEncDecTasks.h"
 #include "EbEncDecResults.h"
+#include "EbPictureDemuxResults.h"
 #include "EbDefinitions.h"
 #include "EbCodingLoop.h"
 #include "EbSvtAv1ErrorCodes.h"
@@ -86,7 +87,9 @@ EbErrorType enc_dec_context_ctor(
     EbBool                  is16bit,
     EbColorFormat           color_format,
     uint32_t                max_input_luma_width,
-    uint32_t                max_input_luma_height){
+    uint32_t                max_input_luma_height,
+    uint32_t                sb_total_count,
+    uint32_t                max_block_count){
 
     (void)max_input_luma_width;
     (void)max_input_luma_height;
@@ -104,6 +107,8 @@ EbErrorType enc_dec_context_ctor(
     context_ptr->enc_dec_feedback_fifo_ptr = feedback_fifo_ptr;
     context_ptr->picture_demux_output_fifo_ptr = picture_demux_fifo_ptr;
 
+    EB_MALLOC(uint8_t*, context_ptr->intra_coded_area_sb, sizeof(uint8_t) * sb_total_count, EB_N_PTR);
+
     // Trasform Scratch Memory
     EB_MALLOC(int16_t*, context_ptr->transform_inner_array_ptr, 3152, EB_N_PTR); //refer to EbInvTransform_SSE2.as. case 32x32
     // MD rate Estimation tables
@@ -203,7 +208,7 @@ EbErrorType enc_dec_context_ctor(
         }
     }
     // Mode Decision Context
-    return_error = mode_decision_context_ctor(&context_ptr->md_context, color_format, 0, 0);
+    return_error = mode_decision_context_ctor(&context_ptr->md_context, color_format, 0, 0, max_block_count);
 
     if (return_error == EB_ErrorInsufficientResources) {
         return EB_ErrorInsufficientResources;
@@ -598,8 +603,8 @@ void ReconOutput(
         }
 
         // End running the film grain
-        // Y Recon Samples
-        sampleTotalCount = ((recon_ptr->max_width - sequence_control_set_ptr->max_input_pad_right) * (recon_ptr->max_height - sequence_control_set_ptr->max_input_pad_bottom)) << is16bit;
+        // Y Recon Samples, at the size of the picture, see eb_svt_enc_reconfigure()
+        sampleTotalCount = ((recon_ptr->width - sequence_control_set_ptr->pad_right) * (recon_ptr->height - sequence_control_set_ptr->pad_bottom)) << is16bit;
         reconReadPtr = recon_ptr->buffer_y + (recon_ptr->origin_y << is16bit) * recon_ptr->stride_y + (recon_ptr->origin_x << is16bit);
         reconWritePtr = &(outputReconPtr->p_buffer[outputReconPtr->n_filled_len]);
 
@@ -613,7 +618,7 @@ void ReconOutput(
             reconReadPtr,
             recon_ptr->stride_y,
             reconWritePtr,
-            recon_ptr->max_width - sequence_control_set_ptr->max_input_pad_right,
+            recon_ptr->width - sequence_control_set_ptr->pad_right,
             recon_ptr->width - sequence_control_set_ptr->pad_right,
             recon_ptr->height - sequence_control_set_ptr->pad_bottom,
             1 << is16bit);
@@ -621,7 +626,7 @@ void ReconOutput(
         outputReconPtr->n_filled_len += sampleTotalCount;
 
         // U Recon Samples
-        sampleTotalCount = ((recon_ptr->max_width - sequence_control_set_ptr->max_input_pad_right) * (recon_ptr->max_height - sequence_control_set_ptr->max_input_pad_bottom) >> 2) << is16bit;
+        sampleTotalCount = ((recon_ptr->width - sequence_control_set_ptr->pad_right) * (recon_ptr->height - sequence_control_set_ptr->pad_bottom) >> 2) << is16bit;
         reconReadPtr = recon_ptr->buffer_cb + ((recon_ptr->origin_y << is16bit) >> 1) * recon_ptr->stride_cb + ((recon_ptr->origin_x << is16bit) >> 1);
         reconWritePtr = &(outputReconPtr->p_buffer[outputReconPtr->n_filled_len]);
 
@@ -635,14 +640,14 @@ void ReconOutput(
             reconReadPtr,
             recon_ptr->stride_cb,
             reconWritePtr,
-            (recon_ptr->max_width - sequence_control_set_ptr->max_input_pad_right) >> 1,
+            (recon_ptr->width - sequence_control_set_ptr->pad_right) >> 1,
             (recon_ptr->width - sequence_control_set_ptr->pad_right) >> 1,
             (recon_ptr->height - sequence_control_set_ptr->pad_bottom) >> 1,
             1 << is16bit);
         outputReconPtr->n_filled_len += sampleTotalCount;
 
         // V Recon Samples
-        sampleTotalCount = ((recon_ptr->max_width - sequence_control_set_ptr->max_input_pad_right) * (recon_ptr->max_height - sequence_control_set_ptr->max_input_pad_bottom) >> 2) << is16bit;
+        sampleTotalCount = ((recon_ptr->width - sequence_control_set_ptr->pad_right) * (recon_ptr->height - sequence_control_set_ptr->pad_bottom) >> 2) << is16bit;
         reconReadPtr = recon_ptr->buffer_cr + ((recon_ptr->origin_y << is16bit) >> 1) * recon_ptr->stride_cr + ((recon_ptr->origin_x << is16bit) >> 1);
         reconWritePtr = &(outputReconPtr->p_buffer[outputReconPtr->n_filled_len]);
 
@@ -657,7 +662,7 @@ void ReconOutput(
             reconReadPtr,
             recon_ptr->stride_cr,
             reconWritePtr,
-            (recon_ptr->max_width - sequence_control_set_ptr->max_input_pad_right) >> 1,
+            (recon_ptr->width - sequence_control_set_ptr->pad_right) >> 1,
             (recon_ptr->width - sequence_control_set_ptr->pad_right) >> 1,
             (recon_ptr->height - sequence_control_set_ptr->pad_bottom) >> 1,
             1 << is16bit);
@@ -1030,9 +1035,13 @@ void PsnrCalculations(
     }
 }
 
-void PadRefAndSetFlags(
+/* Pads the rows [row_start, row_end) of the reference picture, see
+   generate_padding_rows(), so that the rows are padded in parallel. */
+void pad_ref_rows(
     PictureControlSet    *picture_control_set_ptr,
-    SequenceControlSet   *sequence_control_set_ptr
+    SequenceControlSet   *sequence_control_set_ptr,
+    uint32_t              row_start,
+    uint32_t              row_end
 )
 {
 
@@ -1043,98 +1052,125 @@ void PadRefAndSetFlags(
 
     if (!is16bit) {
         // Y samples
-        generate_padding(
+        generate_padding_rows(
             refPicPtr->buffer_y,
             refPicPtr->stride_y,
             refPicPtr->width,
             refPicPtr->height,
             refPicPtr->origin_x,
-            refPicPtr->origin_y);
+            refPicPtr->origin_y,
+            row_start,
+            row_end);
 
         // Cb samples
-        generate_padding(
+        generate_padding_rows(
             refPicPtr->buffer_cb,
             refPicPtr->stride_cb,
             refPicPtr->width >> 1,
             refPicPtr->height >> 1,
             refPicPtr->origin_x >> 1,
-            refPicPtr->origin_y >> 1);
+            refPicPtr->origin_y >> 1,
+            row_start >> 1,
+            row_end >> 1);
 
         // Cr samples
-        generate_padding(
+        generate_padding_rows(
             refPicPtr->buffer_cr,
             refPicPtr->stride_cr,
             refPicPtr->width >> 1,
             refPicPtr->height >> 1,
             refPicPtr->origin_x >> 1,
-            refPicPtr->origin_y >> 1);
+            refPicPtr->origin_y >> 1,
+            row_start >> 1,
+            row_end >> 1);
     }
 
     //We need this for MCP
     if (is16bit) {
         // Y samples
-        generate_padding16_bit(
+        generate_padding16_bit_rows(
             refPic16BitPtr->buffer_y,
             refPic16BitPtr->stride_y << 1,
             refPic16BitPtr->width << 1,
             refPic16BitPtr->height,
             refPic16BitPtr->origin_x << 1,
-            refPic16BitPtr->origin_y);
+            refPic16BitPtr->origin_y,
+            row_start,
+            row_end);
 
         // Cb samples
-        generate_padding16_bit(
+        generate_padding16_bit_rows(
             refPic16BitPtr->buffer_cb,
             refPic16BitPtr->stride_cb << 1,
             refPic16BitPtr->width,
             refPic16BitPtr->height >> 1,
             refPic16BitPtr->origin_x,
-            refPic16BitPtr->origin_y >> 1);
+            refPic16BitPtr->origin_y >> 1,
+            row_start >> 1,
+            row_end >> 1);
 
         // Cr samples
-        generate_padding16_bit(
+        generate_padding16_bit_rows(
             refPic16BitPtr->buffer_cr,
             refPic16BitPtr->stride_cr << 1,
             refPic16BitPtr->width,
             refPic16BitPtr->height >> 1,
             refPic16BitPtr->origin_x,
-            refPic16BitPtr->origin_y >> 1);
+            refPic16BitPtr->origin_y >> 1,
+            row_start >> 1,
+            row_end >> 1);
 
 #if UNPACK_REF_POST_EP 
+        // Rows of the padded picture: the first rows take the top padding, the last rows the bottom one
+        const uint32_t pad_row_start = row_start ? refPicPtr->origin_y + row_start : 0;
+        const uint32_t pad_row_end = (row_end == refPic16BitPtr->height) ?
+            (uint32_t)(refPic16BitPtr->height + (refPicPtr->origin_y << 1)) :
+            (uint32_t)(refPicPtr->origin_y + row_end);
+
         // Hsan: unpack ref samples (to be used @ MD) 
         un_pack2d(
-            (uint16_t*) refPic16BitPtr->buffer_y,
+            (uint16_t*)refPic16BitPtr->buffer_y + pad_row_start * refPic16BitPtr->stride_y,
             refPic16BitPtr->stride_y,
-            refPicPtr->buffer_y,
+            refPicPtr->buffer_y + pad_row_start * refPicPtr->stride_y,
             refPicPtr->stride_y,
-            refPicPtr->buffer_bit_inc_y,
+            refPicPtr->buffer_bit_inc_y + pad_row_start * refPicPtr->stride_bit_inc_y,
             refPicPtr->stride_bit_inc_y,
             refPic16BitPtr->width  + (refPicPtr->origin_x << 1),
-            refPic16BitPtr->height + (refPicPtr->origin_y << 1),
+            pad_row_end - pad_row_start,
             sequence_control_set_ptr->static_config.asm_type);
 
         un_pack2d(
-            (uint16_t*)refPic16BitPtr->buffer_cb,
+            (uint16_t*)refPic16BitPtr->buffer_cb + (pad_row_start >> 1) * refPic16BitPtr->stride_cb,
             refPic16BitPtr->stride_cb,
-            refPicPtr->buffer_cb,
+            refPicPtr->buffer_cb + (pad_row_start >> 1) * refPicPtr->stride_cb,
             refPicPtr->stride_cb,
-            refPicPtr->buffer_bit_inc_cb,
+            refPicPtr->buffer_bit_inc_cb + (pad_row_start >> 1) * refPicPtr->stride_bit_inc_cb,
             refPicPtr->stride_bit_inc_cb,
             (refPic16BitPtr->width + (refPicPtr->origin_x << 1)) >> 1,
-            (refPic16BitPtr->height + (refPicPtr->origin_y << 1)) >> 1,
+            (pad_row_end >> 1) - (pad_row_start >> 1),
             sequence_control_set_ptr->static_config.asm_type);
 
         un_pack2d(
-            (uint16_t*)refPic16BitPtr->buffer_cr,
+            (uint16_t*)refPic16BitPtr->buffer_cr + (pad_row_start >> 1) * refPic16BitPtr->stride_cr,
             refPic16BitPtr->stride_cr,
-            refPicPtr->buffer_cr,
+            refPicPtr->buffer_cr + (pad_row_start >> 1) * refPicPtr->stride_cr,
             refPicPtr->stride_cr,
-            refPicPtr->buffer_bit_inc_cr,
+            refPicPtr->buffer_bit_inc_cr + (pad_row_start >> 1) * refPicPtr->stride_bit_inc_cr,
             refPicPtr->stride_bit_inc_cr,
             (refPic16BitPtr->width + (refPicPtr->origin_x << 1)) >> 1,
-            (refPic16BitPtr->height + (refPicPtr->origin_y << 1)) >> 1,
+            (pad_row_end >> 1) - (pad_row_start >> 1),
             sequence_control_set_ptr->static_config.asm_type);
 #endif
     }
+}
+
+/* Sets up the TMVP flag, POC, QP and slice type of the reference picture */
+void set_ref_flags(
+    PictureControlSet    *picture_control_set_ptr
+)
+{
+    EbReferenceObject   *referenceObject = (EbReferenceObject*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr;
+
 #if !OPT_LOSSLESS_1
     // set up TMVP flag for the reference picture
 
@@ -1193,10 +1229,6 @@ void CopyStatisticsToRefObject(
     ((EbReferenceObject*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr)->tmp_layer_idx = (uint8_t)picture_control_set_ptr->temporal_layer_index;
     ((EbReferenceObject*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr)->is_scene_change = picture_control_set_ptr->parent_pcs_ptr->scene_change_flag;
 
-    ((EbReferenceObject*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr)->cdef_frame_strength = picture_control_set_ptr->parent_pcs_ptr->cdef_frame_strength;
-
-    Av1Common* cm = picture_control_set_ptr->parent_pcs_ptr->av1_cm;
-    ((EbReferenceObject*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr)->sg_frame_ep = cm->sg_frame_ep;
 }
 
 #if !MEMORY_FOOTPRINT_OPT  
@@ -1691,6 +1723,136 @@ void av1_estimate_syntax_rate___partial(
     MdRateEstimationContext        *md_rate_estimation_array,
     FRAME_CONTEXT                  *fc);
 #endif
+/******************************************************
+ * Post Filter Rows
+ *   Marks an SB row encoded, and posts the rows
+ *   encoded above it since the last post for the
+ *   in-loop filters to start on. The last row is
+ *   posted with the end of the picture.
+ *   Without a free result the rows go with a later
+ *   post, at the latest with the end of the picture,
+ *   rather than stall the encoding of the picture.
+ ******************************************************/
+static void post_filter_rows(
+    EncDecContext                *context_ptr,
+    SequenceControlSet           *sequence_control_set_ptr,
+    EbObjectWrapper              *picture_control_set_wrapper_ptr,
+    uint32_t                      row_index)
+{
+    PictureControlSet *picture_control_set_ptr = (PictureControlSet*)picture_control_set_wrapper_ptr->object_ptr;
+    uint32_t           picture_height_in_sb = (sequence_control_set_ptr->luma_height + sequence_control_set_ptr->sb_size_pix - 1) / sequence_control_set_ptr->sb_size_pix;
+    uint32_t           row_start;
+    uint32_t           row_end;
+    EbObjectWrapper   *enc_dec_results_wrapper_ptr = (EbObjectWrapper*)EB_NULL;
+    EncDecResults     *enc_dec_results_ptr;
+
+    eb_block_on_mutex(picture_control_set_ptr->filter_row_mutex);
+    picture_control_set_ptr->filter_row_encoded_array[row_index] = EB_TRUE;
+    row_start = row_end = picture_control_set_ptr->filter_row_encoded_count;
+    while (row_end + 1 < picture_height_in_sb && picture_control_set_ptr->filter_row_encoded_array[row_end])
+        ++row_end;
+    if (row_end > row_start) {
+        eb_get_empty_object_non_blocking(
+            context_ptr->enc_dec_output_fifo_ptr,
+            &enc_dec_results_wrapper_ptr);
+        if (enc_dec_results_wrapper_ptr != (EbObjectWrapper*)EB_NULL) {
+            picture_control_set_ptr->filter_row_encoded_count = (uint16_t)row_end;
+            ++picture_control_set_ptr->filter_row_post_count;
+        }
+    }
+    eb_release_mutex(picture_control_set_ptr->filter_row_mutex);
+
+    if (enc_dec_results_wrapper_ptr != (EbObjectWrapper*)EB_NULL) {
+        enc_dec_results_ptr = (EncDecResults*)enc_dec_results_wrapper_ptr->object_ptr;
+        enc_dec_results_ptr->picture_control_set_wrapper_ptr = picture_control_set_wrapper_ptr;
+        enc_dec_results_ptr->input_type = DLF_TASKS_ENCDEC_INPUT;
+        enc_dec_results_ptr->completed_lcu_row_index_start = row_start;
+        enc_dec_results_ptr->completed_lcu_row_count = row_end - row_start;
+        eb_post_full_object(enc_dec_results_wrapper_ptr);
+    }
+}
+
+// Luma rows below a superblock reached by its motion vectors in the
+// references, see inter_picture_wavefront
+#define INTER_PIC_WAVEFRONT_ROW_MARGIN      128
+
+/******************************************************
+ * Wait Reference Rows
+ *   Blocks until the rows of the wavefront reference
+ *   read by the superblock are final, and returns them,
+ *   ~0 when the superblock may read all of them. The
+ *   other references are complete, see
+ *   wavefront_ref_frame_mask
+ ******************************************************/
+static uint32_t wait_reference_rows(
+    SequenceControlSet           *sequence_control_set_ptr,
+    PictureControlSet            *picture_control_set_ptr,
+    uint32_t                      sb_origin_y)
+{
+    uint32_t row_limit = sb_origin_y + sequence_control_set_ptr->sb_size_pix + INTER_PIC_WAVEFRONT_ROW_MARGIN;
+    uint8_t  list_index;
+    uint8_t  ref_index;
+
+    // The in-loop ME searches its window in full
+    if (row_limit >= sequence_control_set_ptr->luma_height || picture_control_set_ptr->parent_pcs_ptr->enable_in_loop_motion_estimation_flag)
+        row_limit = (uint32_t)~0;
+
+    for (list_index = REF_LIST_0; list_index < ((picture_control_set_ptr->slice_type == B_SLICE) ? 2 : 1); ++list_index) {
+        const uint8_t ref_count = (list_index == REF_LIST_0) ?
+            picture_control_set_ptr->parent_pcs_ptr->ref_list0_count :
+            picture_control_set_ptr->parent_pcs_ptr->ref_list1_count;
+
+        for (ref_index = 0; ref_index < ref_count; ++ref_index) {
+            if ((picture_control_set_ptr->wavefront_ref_frame_mask >> svt_get_ref_frame_type(list_index, ref_index)) & 1)
+                eb_reference_object_wait_rows(
+                    (EbReferenceObject*)picture_control_set_ptr->ref_pic_ptr_array[list_index][ref_index]->object_ptr,
+                    MIN(row_limit, (uint32_t)sequence_control_set_ptr->luma_height));
+        }
+    }
+
+    return row_limit;
+}
+
+/******************************************************
+ * Post Reference Rows
+ *   Hands the reference over to Picture Manager once its
+ *   last superblock is coded. The picture level data
+ *   read before Encode Decode by the pictures using it
+ *   is final, they then wait for the rows as the filters
+ *   complete them, see inter_picture_wavefront
+ ******************************************************/
+static void post_reference_rows(
+    EncDecContext                *context_ptr,
+    SequenceControlSet           *sequence_control_set_ptr,
+    PictureControlSet            *picture_control_set_ptr)
+{
+    EbObjectWrapper     *picture_demux_results_wrapper_ptr;
+    PictureDemuxResults *picture_demux_results_ptr;
+
+    // copy stat to ref object (intra_coded_area, Luminance, Scene change detection flags)
+    CopyStatisticsToRefObject(
+        picture_control_set_ptr,
+        sequence_control_set_ptr);
+
+    // Set up TMVP flag and ref POC
+    set_ref_flags(
+        picture_control_set_ptr);
+
+    // Get Empty PicMgr Results
+    eb_get_empty_object(
+        context_ptr->picture_demux_output_fifo_ptr,
+        &picture_demux_results_wrapper_ptr);
+
+    picture_demux_results_ptr = (PictureDemuxResults*)picture_demux_results_wrapper_ptr->object_ptr;
+    picture_demux_results_ptr->reference_picture_wrapper_ptr = picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr;
+    picture_demux_results_ptr->sequence_control_set_wrapper_ptr = picture_control_set_ptr->sequence_control_set_wrapper_ptr;
+    picture_demux_results_ptr->picture_number = picture_control_set_ptr->picture_number;
+    picture_demux_results_ptr->picture_type = EB_PIC_REFERENCE_ROWS;
+
+    // Post Reference Picture
+    eb_post_full_object(picture_demux_results_wrapper_ptr);
+}
+
 /******************************************************
  * EncDec Kernel
  ******************************************************/
@@ -1820,6 +1982,9 @@ void* enc_dec_kernel(void *input_ptr)
                     lcuRowIndexCount = (x_lcu_index == picture_width_in_sb - 1) ? lcuRowIndexCount + 1 : lcuRowIndexCount;
                     mdcPtr = &picture_control_set_ptr->mdc_sb_array[sb_index];
                     context_ptr->sb_index = sb_index;
+                    context_ptr->md_context->ref_row_limit = picture_control_set_ptr->wavefront_ref_frame_mask ?
+                        wait_reference_rows(sequence_control_set_ptr, picture_control_set_ptr, sb_origin_y) :
+                        (uint32_t)~0;
                     context_ptr->md_context->cu_use_ref_src_flag = (picture_control_set_ptr->parent_pcs_ptr->use_src_ref) && (picture_control_set_ptr->parent_pcs_ptr->edge_results_ptr[sb_index].edge_block_num == EB_FALSE || picture_control_set_ptr->parent_pcs_ptr->sb_flat_noise_array[sb_index]) ? EB_TRUE : EB_FALSE;
 
 #if CABAC_UP
@@ -2008,14 +2173,24 @@ void* enc_dec_kernel(void *input_ptr)
                         ((EbReferenceObject*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr)->intra_coded_area_sb[sb_index] = (uint8_t)((100 * context_ptr->intra_coded_area_sb[sb_index]) / (64 * 64));
                     }
 
+                    if (endOfRowFlag && picture_control_set_ptr->parent_pcs_ptr->filter_row_pipeline)
+                        post_filter_rows(
+                            context_ptr,
+                            sequence_control_set_ptr,
+                            encDecTasksPtr->picture_control_set_wrapper_ptr,
+                            y_lcu_index);
+
                 }
                 xLcuStartIndex = (xLcuStartIndex > 0) ? xLcuStartIndex - 1 : 0;
             }
-        }
 
-        eb_block_on_mutex(picture_control_set_ptr->intra_mutex);
-        picture_control_set_ptr->intra_coded_area += (uint32_t)context_ptr->tot_intra_coded_area;
-        eb_release_mutex(picture_control_set_ptr->intra_mutex);
+            // Added before the segments depending on this one are assigned, so the
+            // area is complete once the last superblock is coded
+            eb_block_on_mutex(picture_control_set_ptr->intra_mutex);
+            picture_control_set_ptr->intra_coded_area += (uint32_t)context_ptr->tot_intra_coded_area;
+            eb_release_mutex(picture_control_set_ptr->intra_mutex);
+            context_ptr->tot_intra_coded_area = 0;
+        }
 
         if (lastLcuFlag) {
 
@@ -2035,7 +2210,11 @@ void* enc_dec_kernel(void *input_ptr)
             EB_MEMCPY(picture_control_set_ptr->parent_pcs_ptr->av1x->wiener_restore_cost, context_ptr->md_rate_estimation_ptr->wiener_restore_fac_bits, 2 * sizeof(int32_t));
             picture_control_set_ptr->parent_pcs_ptr->av1x->rdmult = context_ptr->full_lambda;
 
-
+            if (sequence_control_set_ptr->static_config.inter_picture_wavefront && picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE)
+                post_reference_rows(
+                    context_ptr,
+                    sequence_control_set_ptr,
+                    picture_control_set_ptr);
         }
 
 
@@ -2049,9 +2228,17 @@ void* enc_dec_kernel(void *input_ptr)
                 &encDecResultsWrapperPtr);
             encDecResultsPtr = (EncDecResults*)encDecResultsWrapperPtr->object_ptr;
             encDecResultsPtr->picture_control_set_wrapper_ptr = encDecTasksPtr->picture_control_set_wrapper_ptr;
-            //CHKN these are not needed for DLF
+            encDecResultsPtr->input_type = DLF_TASKS_ENCDEC_INPUT;
             encDecResultsPtr->completed_lcu_row_index_start = 0;
             encDecResultsPtr->completed_lcu_row_count = ((sequence_control_set_ptr->luma_height + sequence_control_set_ptr->sb_size_pix - 1) >> lcuSizeLog2);
+            // The rows not posted yet by post_filter_rows()
+            if (picture_control_set_ptr->parent_pcs_ptr->filter_row_pipeline) {
+                eb_block_on_mutex(picture_control_set_ptr->filter_row_mutex);
+                encDecResultsPtr->completed_lcu_row_index_start = picture_control_set_ptr->filter_row_encoded_count;
+                encDecResultsPtr->completed_lcu_row_count -= picture_control_set_ptr->filter_row_encoded_count;
+                ++picture_control_set_ptr->filter_row_post_count;
+                eb_release_mutex(picture_control_set_ptr->filter_row_mutex);
+            }
             // Post EncDec Results
             eb_post_full_object(encDecResultsWrapperPtr);
 
@@ -11,6 +11,13 @@
 #ifdef __cplusplus
 extern "C" {
 #endif
+#define DLF_TASKS_ENCDEC_INPUT      0
+#define DLF_TASKS_DLF_INPUT         1
+#define CDEF_TASKS_DLF_INPUT        0
+#define CDEF_TASKS_CDEF_INPUT       1
+#define REST_TASKS_CDEF_INPUT       0
+#define REST_TASKS_REST_INPUT       1
+
     /**************************************
      * Process Results
      **************************************/
@@ -19,6 +26,8 @@ extern "C" {
         EbObjectWrapper *picture_control_set_wrapper_ptr;
         uint32_t         completed_lcu_row_index_start;
         uint32_t         completed_lcu_row_count;
+        uint32_t         input_type;
+        EbPtr            dlf_context_ptr;  // DLF context owning the segment job (DLF_TASKS_DLF_INPUT)
 
     } EncDecResults;
 
@@ -26,12 +35,16 @@ extern "C" {
     {
         EbObjectWrapper *picture_control_set_wrapper_ptr;
         uint32_t         segment_index;
+        uint32_t         input_type;
+        EbPtr            cdef_context_ptr; // CDEF context owning the segment job (CDEF_TASKS_CDEF_INPUT)
     } DlfResults;
 
     typedef struct CdefResults
     {
         EbObjectWrapper *picture_control_set_wrapper_ptr;
         uint32_t         segment_index;
+        uint32_t         input_type;
+        EbPtr            rest_context_ptr; // Rest context owning the segment job (REST_TASKS_REST_INPUT)
     } CdefResults;
 
     typedef struct RestResults
@@ -39,6 +52,7 @@ extern "C" {
         EbObjectWrapper *picture_control_set_wrapper_ptr;
         uint32_t         completed_lcu_row_index_start;
         uint32_t         completed_lcu_row_count;
+        uint16_t         tile_index;
     } RestResults;
 
     typedef struct EncDecResultsInitData {
@@ -38,6 +38,8 @@ EbErrorType encode_context_ctor(
     // Output Buffer Fifos
     encode_context_ptr->stream_output_fifo_ptr = (EbFifo*)EB_NULL;
     encode_context_ptr->recon_output_fifo_ptr = (EbFifo*)EB_NULL;
+    encode_context_ptr->fragment_output_fifo_ptr = (EbFifo*)EB_NULL;
+    encode_context_ptr->pipeline_stats_ptr = (struct EbPipelineStats*)EB_NULL;
 
     // Picture Buffer Fifos
     encode_context_ptr->reference_picture_pool_fifo_ptr = (EbFifo*)EB_NULL;
@@ -221,6 +223,14 @@ EbErrorType encode_context_ctor(
 
     EB_CREATEMUTEX(EbHandle, encode_context_ptr->shared_reference_mutex, sizeof(EbHandle), EB_MUTEX);
 
+    EB_CREATEMUTEX(EbHandle, encode_context_ptr->first_pass_mutex, sizeof(EbHandle), EB_MUTEX);
+    encode_context_ptr->pass_stats_ptr = (struct EbPassStats*)EB_NULL;
+
+    EB_CREATEMUTEX(EbHandle, encode_context_ptr->tile_group_output_mutex, sizeof(EbHandle), EB_MUTEX);
+
+    encode_context_ptr->ladder_ptr = (struct EbLadderContext*)EB_NULL;
+    encode_context_ptr->ladder_rendition_ptr = (struct EbLadderRendition*)EB_NULL;
+
     return EB_ErrorNone;
 }
 
@@ -53,6 +53,10 @@ typedef struct EncodeContext
     EbFifo                                        *stream_output_fifo_ptr;
     EbFifo                                        *recon_output_fifo_ptr;
     EbFifo                                        *statistics_output_fifo_ptr;
+    EbFifo                                        *fragment_output_fifo_ptr;    // tile group output, from the stream output pool
+
+    // Pipeline statistics, NULL when pipeline_stats is off
+    struct EbPipelineStats                        *pipeline_stats_ptr;
 
     // Picture Buffer Fifos
     EbFifo                                        *reference_picture_pool_fifo_ptr;
@@ -147,6 +151,26 @@ typedef struct EncodeContext
     EbObjectWrapper                                  *previous_picture_control_set_wrapper_ptr;
     EbHandle                                          shared_reference_mutex;
 
+    // Two pass encoding
+    EbHandle                                          first_pass_mutex;     // first pass output reordering
+    struct EbPassStats                               *pass_stats_ptr;       // second pass, NULL otherwise
+
+    // Tile group output
+    EbHandle                                          tile_group_output_mutex;
+
+    // Runtime reconfiguration, set by eb_svt_enc_reconfigure() under the
+    // config mutex. The rate applies from the next picture to reach Picture
+    // Decision, the intra period from the next intra period position 0.
+    uint32_t                                          target_bit_rate;
+    int32_t                                           intra_period_length;          // requested
+    int32_t                                           active_intra_period_length;   // used by Picture Decision
+
+    // ABR ladder, see eb_svt_enc_attach_ladder(). The leader posts its scene
+    // changes, a rendition takes them instead of detecting its own; nothing
+    // else is shared.
+    struct EbLadderContext                           *ladder_ptr;           // leader, NULL otherwise
+    struct EbLadderRendition                         *ladder_rendition_ptr; // rendition, NULL otherwise
+
 } EncodeContext;
 
 typedef struct EncodeContextInitData {
@@ -1431,7 +1431,9 @@ EbErrorType encode_slice_finish(
 {
     EbErrorType return_error = EB_ErrorNone;
 
-    aom_stop_encode(&entropy_coder_ptr->ec_writer);
+    // The coded data overflows the bitstream buffer
+    if (aom_stop_encode(&entropy_coder_ptr->ec_writer) < 0)
+        return_error = EB_ErrorInsufficientResources;
 
     return return_error;
 }
@@ -3322,8 +3324,6 @@ static void write_tile_info_max_tile(const PictureParentControlSet *const pcs_pt
     }
 }
 
-#define MAX_TILE_WIDTH (4096)        // Max Tile width in pixels
-#define MAX_TILE_AREA (4096 * 2304)  // Maximum tile area in pixels
 // Find smallest k>=0 such that (blk_size << k) >= target
 static int32_t tile_log2(int32_t blk_size, int32_t target) {
     int32_t k;
@@ -4715,6 +4715,38 @@ static uint32_t WriteFrameHeaderObu(
     return totalSize;
 }
 
+/**************************************************
+* Copies the EC streams of the tiles start_tile to
+* end_tile, every tile but the last one preceded by
+* its size (tile_size_bytes = 4)
+**************************************************/
+static int32_t write_tile_data(
+    uint8_t           *data,
+    PictureControlSet *pcs_ptr,
+    uint16_t           start_tile,
+    uint16_t           end_tile)
+{
+    int32_t  currDataSize = 0;
+    uint16_t tile_idx;
+
+    for (tile_idx = start_tile; tile_idx <= end_tile; ++tile_idx) {
+        EntropyCoder *tile_entropy_coder_ptr = pcs_ptr->entropy_coding_info[tile_idx]->entropy_coder_ptr;
+        OutputBitstreamUnit *ec_output_bitstream_ptr = (OutputBitstreamUnit*)tile_entropy_coder_ptr->ec_output_bitstream_ptr;
+        const int32_t tileSize = tile_entropy_coder_ptr->ec_writer.pos;
+
+        if (tile_idx < end_tile) {
+            mem_put_le32(data + currDataSize, tileSize - AV1_MIN_TILE_SIZE_BYTES);
+            currDataSize += 4;
+        }
+        //****************************************************************//
+        // Copy from EC stream to frame stream
+        memcpy(data + currDataSize, ec_output_bitstream_ptr->buffer_begin_av1, tileSize);
+        currDataSize += (tileSize);
+    }
+
+    return currDataSize;
+}
+
 /**************************************************
 * EncodeFrameHeaderHeader
 **************************************************/
@@ -4751,14 +4783,9 @@ EbErrorType write_frame_header_av1(
         0, n_log2_tiles, tile_start_and_end_present_flag);
 
     if (!showExisting) {
-        // Add data from EC stream to Picture Stream.
-        int32_t frameSize = parent_pcs_ptr->av1_cm->tile_cols*parent_pcs_ptr->av1_cm->tile_rows==1 ? pcs_ptr->entropy_coder_ptr->ec_writer.pos : pcs_ptr->entropy_coder_ptr->ec_frame_size;
-
-        OutputBitstreamUnit *ec_output_bitstream_ptr = (OutputBitstreamUnit*)pcs_ptr->entropy_coder_ptr->ec_output_bitstream_ptr;
-        //****************************************************************//
-        // Copy from EC stream to frame stream
-        memcpy(data + currDataSize, ec_output_bitstream_ptr->buffer_begin_av1, frameSize);
-        currDataSize += (frameSize);
+        // Add data from the EC stream of each tile to Picture Stream.
+        const uint16_t tile_cnt = (uint16_t)(parent_pcs_ptr->av1_cm->tile_cols * parent_pcs_ptr->av1_cm->tile_rows);
+        currDataSize += write_tile_data(data + currDataSize, pcs_ptr, 0, tile_cnt - 1);
     }
     const uint32_t obuPayloadSize = currDataSize - obuHeaderSize;
     const size_t lengthFieldSize =
@@ -4774,6 +4801,76 @@ EbErrorType write_frame_header_av1(
     return return_error;
 }
 
+/**************************************************
+* write_frame_header_obu_av1
+*   Frame header alone, the tiles follow in
+*   OBU_TILE_GROUPs
+**************************************************/
+EbErrorType write_frame_header_obu_av1(
+    Bitstream *bitstream_ptr,
+    SequenceControlSet *scs_ptr,
+    PictureControlSet *pcs_ptr)
+{
+    EbErrorType                 return_error = EB_ErrorNone;
+    OutputBitstreamUnit       *output_bitstream_ptr = (OutputBitstreamUnit*)bitstream_ptr->output_bitstream_ptr;
+    uint8_t                     *data = output_bitstream_ptr->buffer_av1;
+    uint32_t obuHeaderSize = 0;
+    uint32_t obuPayloadSize = 0;
+
+    obuHeaderSize = WriteObuHeader(OBU_FRAME_HEADER, 0, data);
+    obuPayloadSize = WriteFrameHeaderObu(scs_ptr, pcs_ptr->parent_pcs_ptr, data + obuHeaderSize, 0, 1);
+
+    const size_t lengthFieldSize = ObuMemMove(obuHeaderSize, obuPayloadSize, data);
+    if (WriteUlebObuSize(obuHeaderSize, obuPayloadSize, data) !=
+        AOM_CODEC_OK) {
+        assert(0);
+    }
+
+    data += obuHeaderSize + obuPayloadSize + lengthFieldSize;
+    output_bitstream_ptr->buffer_av1 = data;
+    return return_error;
+}
+
+/**************************************************
+* write_tile_group_obu_av1
+*   Tiles start_tile to end_tile of a picture
+*   with more than one tile
+**************************************************/
+EbErrorType write_tile_group_obu_av1(
+    Bitstream *bitstream_ptr,
+    PictureControlSet *pcs_ptr,
+    uint16_t start_tile,
+    uint16_t end_tile)
+{
+    EbErrorType                 return_error = EB_ErrorNone;
+    OutputBitstreamUnit       *output_bitstream_ptr = (OutputBitstreamUnit*)bitstream_ptr->output_bitstream_ptr;
+    Av1Common                 *cm = pcs_ptr->parent_pcs_ptr->av1_cm;
+    uint8_t                     *data = output_bitstream_ptr->buffer_av1;
+    uint32_t obuHeaderSize = 0;
+    int32_t currDataSize = 0;
+
+    assert(cm->tile_cols * cm->tile_rows > 1 && start_tile <= end_tile);
+
+    currDataSize = WriteObuHeader(OBU_TILE_GROUP, 0, data);
+    obuHeaderSize = currDataSize;
+
+    currDataSize += write_tile_group_header(data + currDataSize, start_tile,
+        end_tile, cm->log2_tile_rows + cm->log2_tile_cols, 1);
+    currDataSize += write_tile_data(data + currDataSize, pcs_ptr, start_tile, end_tile);
+
+    const uint32_t obuPayloadSize = currDataSize - obuHeaderSize;
+    const size_t lengthFieldSize =
+        ObuMemMove(obuHeaderSize, obuPayloadSize, data);
+    if (WriteUlebObuSize(obuHeaderSize, obuPayloadSize, data) !=
+        AOM_CODEC_OK) {
+        assert(0);
+    }
+    currDataSize += (int32_t)lengthFieldSize;
+
+    output_bitstream_ptr->buffer_av1 = data + currDataSize;
+    return return_error;
+}
+
 /**************************************************
 * encode_sps_av1
 **************************************************/
@@ -4865,6 +4962,7 @@ static void Av1writeDeltaQindex(
 static void write_cdef(
     SequenceControlSet     *seqCSetPtr,
     PictureControlSet     *p_pcs_ptr,
+    int32_t               *cdef_preset,
     //Av1Common *cm,
     MacroBlockD *const xd,
     AomWriter *w,
@@ -4892,8 +4990,8 @@ static void write_cdef(
 // Initialise when at top left part of the superblock
     if (!(mi_row & (seqCSetPtr->mib_size - 1)) &&
         !(mi_col & (seqCSetPtr->mib_size - 1))) {  // Top left?
-        p_pcs_ptr->cdef_preset[0] = p_pcs_ptr->cdef_preset[1] = p_pcs_ptr->cdef_preset[2] =
-            p_pcs_ptr->cdef_preset[3] = -1;
+        cdef_preset[0] = cdef_preset[1] = cdef_preset[2] =
+            cdef_preset[3] = -1;
     }
 
     // Emit CDEF param at first non-skip coding block
@@ -4902,9 +5000,9 @@ static void write_cdef(
         ? !!(mi_col & mask) + 2 * !!(mi_row & mask)
         : 0;
 
-    if (p_pcs_ptr->cdef_preset[index] == -1 && !skip) {
+    if (cdef_preset[index] == -1 && !skip) {
         aom_write_literal(w, mi->mbmi.cdef_strength, p_pcs_ptr->parent_pcs_ptr->cdef_bits);
-        p_pcs_ptr->cdef_preset[index] = mi->mbmi.cdef_strength;
+        cdef_preset[index] = mi->mbmi.cdef_strength;
 
 
     }
@@ -4912,10 +5010,10 @@ static void write_cdef(
 }
 
 
-void av1_reset_loop_restoration(PictureControlSet     *piCSetPtr) {
+void av1_reset_loop_restoration(EntropyTileInfo *tile_ptr) {
     for (int32_t p = 0; p < 3; ++p) {
-        set_default_wiener(piCSetPtr->wiener_info + p);
-        set_default_sgrproj(piCSetPtr->sgrproj_info + p);
+        set_default_wiener(tile_ptr->wiener_info + p);
+        set_default_sgrproj(tile_ptr->sgrproj_info + p);
     }
 }
 static void write_wiener_filter(int32_t wiener_win, const WienerInfo *wiener_info,
@@ -4993,7 +5091,7 @@ static void write_sgrproj_filter(const SgrprojInfo *sgrproj_info,
 
     memcpy(ref_sgrproj_info, sgrproj_info, sizeof(*sgrproj_info));
 }
-static void loop_restoration_write_sb_coeffs(PictureControlSet     *piCSetPtr, FRAME_CONTEXT           *frameContext, const Av1Common *const cm,
+static void loop_restoration_write_sb_coeffs(EntropyTileInfo     *tile_ptr, FRAME_CONTEXT           *frameContext, const Av1Common *const cm,
     //MacroBlockD *xd,
     const RestorationUnitInfo *rui,
     AomWriter *const w, int32_t plane/*,
@@ -5007,8 +5105,8 @@ static void loop_restoration_write_sb_coeffs(PictureControlSet     *piCSetPtr, F
 //    assert(!cm->all_lossless);
 
     const int32_t wiener_win = (plane > 0) ? WIENER_WIN_CHROMA : WIENER_WIN;
-    WienerInfo *wiener_info = piCSetPtr->wiener_info + plane;
-    SgrprojInfo *sgrproj_info = piCSetPtr->sgrproj_info + plane;
+    WienerInfo *wiener_info = tile_ptr->wiener_info + plane;
+    SgrprojInfo *sgrproj_info = tile_ptr->sgrproj_info + plane;
     RestorationType unit_rtype = rui->restoration_type;
 
     assert(unit_rtype < CDF_SIZE(RESTORE_SWITCHABLE_TYPES));
@@ -5070,17 +5168,18 @@ EbErrorType ec_update_neighbors(
     EbPictureBufferDesc   *coeff_ptr)
 {
     UNUSED(coeff_ptr);
+    UNUSED(picture_control_set_ptr);
     EbErrorType return_error = EB_ErrorNone;
-    NeighborArrayUnit     *mode_type_neighbor_array = picture_control_set_ptr->mode_type_neighbor_array;
-    NeighborArrayUnit     *partition_context_neighbor_array = picture_control_set_ptr->partition_context_neighbor_array;
-    NeighborArrayUnit     *skip_flag_neighbor_array = picture_control_set_ptr->skip_flag_neighbor_array;
-    NeighborArrayUnit     *skip_coeff_neighbor_array = picture_control_set_ptr->skip_coeff_neighbor_array;
-    NeighborArrayUnit     *luma_dc_sign_level_coeff_neighbor_array = picture_control_set_ptr->luma_dc_sign_level_coeff_neighbor_array;
-    NeighborArrayUnit     *cr_dc_sign_level_coeff_neighbor_array = picture_control_set_ptr->cr_dc_sign_level_coeff_neighbor_array;
-    NeighborArrayUnit     *cb_dc_sign_level_coeff_neighbor_array = picture_control_set_ptr->cb_dc_sign_level_coeff_neighbor_array;
-    NeighborArrayUnit     *inter_pred_dir_neighbor_array = picture_control_set_ptr->inter_pred_dir_neighbor_array;
-    NeighborArrayUnit     *ref_frame_type_neighbor_array = picture_control_set_ptr->ref_frame_type_neighbor_array;
-    NeighborArrayUnit32   *interpolation_type_neighbor_array = picture_control_set_ptr->interpolation_type_neighbor_array;
+    NeighborArrayUnit     *mode_type_neighbor_array = context_ptr->entropy_tile_ptr->mode_type_neighbor_array;
+    NeighborArrayUnit     *partition_context_neighbor_array = context_ptr->entropy_tile_ptr->partition_context_neighbor_array;
+    NeighborArrayUnit     *skip_flag_neighbor_array = context_ptr->entropy_tile_ptr->skip_flag_neighbor_array;
+    NeighborArrayUnit     *skip_coeff_neighbor_array = context_ptr->entropy_tile_ptr->skip_coeff_neighbor_array;
+    NeighborArrayUnit     *luma_dc_sign_level_coeff_neighbor_array = context_ptr->entropy_tile_ptr->luma_dc_sign_level_coeff_neighbor_array;
+    NeighborArrayUnit     *cr_dc_sign_level_coeff_neighbor_array = context_ptr->entropy_tile_ptr->cr_dc_sign_level_coeff_neighbor_array;
+    NeighborArrayUnit     *cb_dc_sign_level_coeff_neighbor_array = context_ptr->entropy_tile_ptr->cb_dc_sign_level_coeff_neighbor_array;
+    NeighborArrayUnit     *inter_pred_dir_neighbor_array = context_ptr->entropy_tile_ptr->inter_pred_dir_neighbor_array;
+    NeighborArrayUnit     *ref_frame_type_neighbor_array = context_ptr->entropy_tile_ptr->ref_frame_type_neighbor_array;
+    NeighborArrayUnit32   *interpolation_type_neighbor_array = context_ptr->entropy_tile_ptr->interpolation_type_neighbor_array;
     const BlockGeom         *blk_geom = get_blk_geom_mds(cu_ptr->mds_idx);
     EbBool                   skipCoeff = EB_FALSE;
     PartitionContext         partition;
@@ -5336,15 +5435,15 @@ EbErrorType write_modes_b(
     AomWriter              *ec_writer = &entropy_coder_ptr->ec_writer;
     SequenceControlSet     *sequence_control_set_ptr = (SequenceControlSet*)picture_control_set_ptr->sequence_control_set_wrapper_ptr->object_ptr;
 
-    NeighborArrayUnit     *mode_type_neighbor_array = picture_control_set_ptr->mode_type_neighbor_array;
-    NeighborArrayUnit     *intra_luma_mode_neighbor_array = picture_control_set_ptr->intra_luma_mode_neighbor_array;
-    NeighborArrayUnit     *skip_flag_neighbor_array = picture_control_set_ptr->skip_flag_neighbor_array;
-    NeighborArrayUnit     *skip_coeff_neighbor_array = picture_control_set_ptr->skip_coeff_neighbor_array;
-    NeighborArrayUnit     *luma_dc_sign_level_coeff_neighbor_array = picture_control_set_ptr->luma_dc_sign_level_coeff_neighbor_array;
-    NeighborArrayUnit     *cr_dc_sign_level_coeff_neighbor_array = picture_control_set_ptr->cr_dc_sign_level_coeff_neighbor_array;
-    NeighborArrayUnit     *cb_dc_sign_level_coeff_neighbor_array = picture_control_set_ptr->cb_dc_sign_level_coeff_neighbor_array;
-    NeighborArrayUnit     *ref_frame_type_neighbor_array = picture_control_set_ptr->ref_frame_type_neighbor_array;
-    NeighborArrayUnit32   *interpolation_type_neighbor_array = picture_control_set_ptr->interpolation_type_neighbor_array;
+    NeighborArrayUnit     *mode_type_neighbor_array = context_ptr->entropy_tile_ptr->mode_type_neighbor_array;
+    NeighborArrayUnit     *intra_luma_mode_neighbor_array = context_ptr->entropy_tile_ptr->intra_luma_mode_neighbor_array;
+    NeighborArrayUnit     *skip_flag_neighbor_array = context_ptr->entropy_tile_ptr->skip_flag_neighbor_array;
+    NeighborArrayUnit     *skip_coeff_neighbor_array = context_ptr->entropy_tile_ptr->skip_coeff_neighbor_array;
+    NeighborArrayUnit     *luma_dc_sign_level_coeff_neighbor_array = context_ptr->entropy_tile_ptr->luma_dc_sign_level_coeff_neighbor_array;
+    NeighborArrayUnit     *cr_dc_sign_level_coeff_neighbor_array = context_ptr->entropy_tile_ptr->cr_dc_sign_level_coeff_neighbor_array;
+    NeighborArrayUnit     *cb_dc_sign_level_coeff_neighbor_array = context_ptr->entropy_tile_ptr->cb_dc_sign_level_coeff_neighbor_array;
+    NeighborArrayUnit     *ref_frame_type_neighbor_array = context_ptr->entropy_tile_ptr->ref_frame_type_neighbor_array;
+    NeighborArrayUnit32   *interpolation_type_neighbor_array = context_ptr->entropy_tile_ptr->interpolation_type_neighbor_array;
 
     const BlockGeom          *blk_geom = get_blk_geom_mds(cu_ptr->mds_idx);
     uint32_t blkOriginX = context_ptr->sb_origin_x + blk_geom->origin_x;
@@ -5392,6 +5491,7 @@ assert(bsize < BlockSizeS_ALL);
         write_cdef(
             sequence_control_set_ptr,
             picture_control_set_ptr,
+            context_ptr->entropy_tile_ptr->cdef_preset,
             cu_ptr->av1xd,
             ec_writer,
             skipCoeff,
@@ -5531,6 +5631,7 @@ assert(bsize < BlockSizeS_ALL);
         write_cdef(
             sequence_control_set_ptr,
             picture_control_set_ptr, /*cm,*/
+            context_ptr->entropy_tile_ptr->cdef_preset,
             cu_ptr->av1xd,
             ec_writer,
             cu_ptr->skip_flag ? 1 : skipCoeff,
@@ -5831,7 +5932,7 @@ EB_EXTERN EbErrorType write_sb(
     FRAME_CONTEXT           *frameContext = entropy_coder_ptr->fc;
     AomWriter              *ec_writer = &entropy_coder_ptr->ec_writer;
     SequenceControlSet     *sequence_control_set_ptr = (SequenceControlSet*)picture_control_set_ptr->sequence_control_set_wrapper_ptr->object_ptr;
-    NeighborArrayUnit     *partition_context_neighbor_array = picture_control_set_ptr->partition_context_neighbor_array;
+    NeighborArrayUnit     *partition_context_neighbor_array = context_ptr->entropy_tile_ptr->partition_context_neighbor_array;
 
     // CU Varaiables
     const BlockGeom          *blk_geom;
@@ -5898,7 +5999,7 @@ EB_EXTERN EbErrorType write_sb(
                                 const int32_t runit_idx = tile_tl_idx + rcol + rrow * rstride;
                                 const RestorationUnitInfo *rui =
                                     &cm->rst_info[plane].unit_info[runit_idx];
-                                loop_restoration_write_sb_coeffs(picture_control_set_ptr, frameContext, cm, /*xd,*/ rui, ec_writer, plane);
+                                loop_restoration_write_sb_coeffs(context_ptr->entropy_tile_ptr, frameContext, cm, /*xd,*/ rui, ec_writer, plane);
                             }
                         }
                     }
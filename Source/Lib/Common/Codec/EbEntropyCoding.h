@@ -274,6 +274,15 @@ extern "C" {
         SequenceControlSet *scs_ptr,
         PictureControlSet *pcs_ptr,
         uint8_t showExisting);
+    extern EbErrorType write_frame_header_obu_av1(
+        Bitstream *bitstream_ptr,
+        SequenceControlSet *scs_ptr,
+        PictureControlSet *pcs_ptr);
+    extern EbErrorType write_tile_group_obu_av1(
+        Bitstream *bitstream_ptr,
+        PictureControlSet *pcs_ptr,
+        uint16_t start_tile,
+        uint16_t end_tile);
     extern EbErrorType encode_td_av1(
         uint8_t *bitstream_ptr);
     extern EbErrorType encode_sps_av1(
@@ -20,9 +20,10 @@
 #include "EbEncDecResults.h"
 #include "EbEntropyCodingResults.h"
 #include "EbRateControlTasks.h"
+#include "EbPacketizationProcess.h"
+#include "EbSvtAv1ErrorCodes.h"
 
-#define  AV1_MIN_TILE_SIZE_BYTES 1
-void av1_reset_loop_restoration(PictureControlSet     *piCSetPtr);
+void av1_reset_loop_restoration(EntropyTileInfo *tile_ptr);
 void av1_tile_set_col(TileInfo *tile, PictureParentControlSet * pcs_ptr, int col);
 void av1_tile_set_row(TileInfo *tile, PictureParentControlSet * pcs_ptr, int row);
 
@@ -54,26 +55,63 @@ EbErrorType entropy_coding_context_ctor(
 /***********************************************
  * Entropy Coding Reset Neighbor Arrays
  ***********************************************/
-static void EntropyCodingResetNeighborArrays(PictureControlSet *picture_control_set_ptr)
+static void EntropyCodingResetNeighborArrays(EntropyTileInfo *tile_ptr)
 {
-    neighbor_array_unit_reset(picture_control_set_ptr->mode_type_neighbor_array);
+    neighbor_array_unit_reset(tile_ptr->mode_type_neighbor_array);
 
-    neighbor_array_unit_reset(picture_control_set_ptr->partition_context_neighbor_array);
+    neighbor_array_unit_reset(tile_ptr->partition_context_neighbor_array);
 
-    neighbor_array_unit_reset(picture_control_set_ptr->skip_flag_neighbor_array);
+    neighbor_array_unit_reset(tile_ptr->skip_flag_neighbor_array);
 
-    neighbor_array_unit_reset(picture_control_set_ptr->skip_coeff_neighbor_array);
-    neighbor_array_unit_reset(picture_control_set_ptr->luma_dc_sign_level_coeff_neighbor_array);
-    neighbor_array_unit_reset(picture_control_set_ptr->cb_dc_sign_level_coeff_neighbor_array);
-    neighbor_array_unit_reset(picture_control_set_ptr->cr_dc_sign_level_coeff_neighbor_array);
-    neighbor_array_unit_reset(picture_control_set_ptr->inter_pred_dir_neighbor_array);
-    neighbor_array_unit_reset(picture_control_set_ptr->ref_frame_type_neighbor_array);
+    neighbor_array_unit_reset(tile_ptr->skip_coeff_neighbor_array);
+    neighbor_array_unit_reset(tile_ptr->luma_dc_sign_level_coeff_neighbor_array);
+    neighbor_array_unit_reset(tile_ptr->cb_dc_sign_level_coeff_neighbor_array);
+    neighbor_array_unit_reset(tile_ptr->cr_dc_sign_level_coeff_neighbor_array);
+    neighbor_array_unit_reset(tile_ptr->inter_pred_dir_neighbor_array);
+    neighbor_array_unit_reset(tile_ptr->ref_frame_type_neighbor_array);
 
-    neighbor_array_unit_reset(picture_control_set_ptr->intra_luma_mode_neighbor_array);
-    neighbor_array_unit_reset32(picture_control_set_ptr->interpolation_type_neighbor_array);
+    neighbor_array_unit_reset(tile_ptr->intra_luma_mode_neighbor_array);
+    neighbor_array_unit_reset32(tile_ptr->interpolation_type_neighbor_array);
     return;
 }
 
+/***********************************************
+ * Entropy Coding Set Neighbor Arrays Origin
+ *   The neighbor arrays of a tile start at its
+ *   top left corner, in luma samples.
+ ***********************************************/
+static void entropy_coding_set_neighbor_arrays_origin(
+    EntropyTileInfo *tile_ptr,
+    uint16_t         origin_x,
+    uint16_t         origin_y,
+    uint16_t         subsampling_x,
+    uint16_t         subsampling_y)
+{
+    NeighborArrayUnit *luma_arrays[] = {
+        tile_ptr->mode_type_neighbor_array,
+        tile_ptr->partition_context_neighbor_array,
+        tile_ptr->skip_flag_neighbor_array,
+        tile_ptr->skip_coeff_neighbor_array,
+        tile_ptr->luma_dc_sign_level_coeff_neighbor_array,
+        tile_ptr->inter_pred_dir_neighbor_array,
+        tile_ptr->ref_frame_type_neighbor_array,
+        tile_ptr->intra_luma_mode_neighbor_array };
+    uint32_t i;
+
+    for (i = 0; i < sizeof(luma_arrays) / sizeof(luma_arrays[0]); ++i) {
+        luma_arrays[i]->origin_x = origin_x;
+        luma_arrays[i]->origin_y = origin_y;
+    }
+    tile_ptr->interpolation_type_neighbor_array->origin_x = origin_x;
+    tile_ptr->interpolation_type_neighbor_array->origin_y = origin_y;
+
+    // The dc sign arrays of the chroma are indexed in chroma samples
+    tile_ptr->cb_dc_sign_level_coeff_neighbor_array->origin_x = origin_x >> subsampling_x;
+    tile_ptr->cb_dc_sign_level_coeff_neighbor_array->origin_y = origin_y >> subsampling_y;
+    tile_ptr->cr_dc_sign_level_coeff_neighbor_array->origin_x = origin_x >> subsampling_x;
+    tile_ptr->cr_dc_sign_level_coeff_neighbor_array->origin_y = origin_y >> subsampling_y;
+}
+
 void av1_get_syntax_rate_from_cdf(
     int32_t                      *costs,
     const AomCdfProb       *cdf,
@@ -232,7 +270,8 @@ static void ResetEntropyCodingPicture(
     picture_control_set_ptr->entropy_coder_ptr->ec_writer.allow_update_cdf = !picture_control_set_ptr->parent_pcs_ptr->large_scale_tile;
     picture_control_set_ptr->entropy_coder_ptr->ec_writer.allow_update_cdf =
         picture_control_set_ptr->entropy_coder_ptr->ec_writer.allow_update_cdf && !picture_control_set_ptr->parent_pcs_ptr->disable_cdf_update;
-    aom_start_encode(&picture_control_set_ptr->entropy_coder_ptr->ec_writer, data);
+    aom_start_encode(&picture_control_set_ptr->entropy_coder_ptr->ec_writer, data,
+        output_bitstream_ptr->size - (uint32_t)(data - output_bitstream_ptr->buffer_begin_av1));
 
     // ADD Reset here
 
@@ -242,21 +281,23 @@ static void ResetEntropyCodingPicture(
         entropyCodingQp,
         picture_control_set_ptr->slice_type);
 
-    EntropyCodingResetNeighborArrays(picture_control_set_ptr);
+    EntropyCodingResetNeighborArrays(context_ptr->entropy_tile_ptr);
 
 
     return;
 }
 
-
+/**************************************************
+ * Reset Entropy Coding Tile
+ *   Each tile is coded from the start of the
+ *   bitstream of its own entropy coder.
+ **************************************************/
 static void reset_ec_tile(
-    uint32_t  total_size,
-    uint32_t  is_last_tile_in_tg,
     EntropyCodingContext  *context_ptr,
     PictureControlSet     *picture_control_set_ptr,
     SequenceControlSet    *sequence_control_set_ptr)
 {
-    reset_bitstream(entropy_coder_get_bitstream_ptr(picture_control_set_ptr->entropy_coder_ptr));
+    reset_bitstream(entropy_coder_get_bitstream_ptr(context_ptr->entropy_tile_ptr->entropy_coder_ptr));
 
     uint32_t                       entropy_coding_qp;
 
@@ -302,29 +343,26 @@ static void reset_ec_tile(
 #endif
 
     // pass the ent
-    OutputBitstreamUnit *output_bitstream_ptr = (OutputBitstreamUnit*)(picture_control_set_ptr->entropy_coder_ptr->ec_output_bitstream_ptr);
+    OutputBitstreamUnit *output_bitstream_ptr = (OutputBitstreamUnit*)(context_ptr->entropy_tile_ptr->entropy_coder_ptr->ec_output_bitstream_ptr);
     //****************************************************************//
 
-    uint8_t *data = output_bitstream_ptr->buffer_av1 + total_size;
-    picture_control_set_ptr->entropy_coder_ptr->ec_writer.allow_update_cdf = !picture_control_set_ptr->parent_pcs_ptr->large_scale_tile;
-    picture_control_set_ptr->entropy_coder_ptr->ec_writer.allow_update_cdf =
-        picture_control_set_ptr->entropy_coder_ptr->ec_writer.allow_update_cdf && !picture_control_set_ptr->parent_pcs_ptr->disable_cdf_update;
-
+    uint8_t *data = output_bitstream_ptr->buffer_av1;
+    context_ptr->entropy_tile_ptr->entropy_coder_ptr->ec_writer.allow_update_cdf = !picture_control_set_ptr->parent_pcs_ptr->large_scale_tile;
+    context_ptr->entropy_tile_ptr->entropy_coder_ptr->ec_writer.allow_update_cdf =
+        context_ptr->entropy_tile_ptr->entropy_coder_ptr->ec_writer.allow_update_cdf && !picture_control_set_ptr->parent_pcs_ptr->disable_cdf_update;
 
-    //if not last tile, advance buffer by 4B to leave space for tile Size
-    if (is_last_tile_in_tg == 0)
-        data += 4;
 
-    aom_start_encode(&picture_control_set_ptr->entropy_coder_ptr->ec_writer, data);
+    aom_start_encode(&context_ptr->entropy_tile_ptr->entropy_coder_ptr->ec_writer, data,
+        output_bitstream_ptr->size - (uint32_t)(data - output_bitstream_ptr->buffer_begin_av1));
 
     //reset probabilities
     reset_entropy_coder(
         sequence_control_set_ptr->encode_context_ptr,
-        picture_control_set_ptr->entropy_coder_ptr,
+        context_ptr->entropy_tile_ptr->entropy_coder_ptr,
         entropy_coding_qp,
         picture_control_set_ptr->slice_type);
 
-    EntropyCodingResetNeighborArrays(picture_control_set_ptr);
+    EntropyCodingResetNeighborArrays(context_ptr->entropy_tile_ptr);
 
 
     return;
@@ -510,8 +548,8 @@ void* entropy_coding_kernel(void *input_ptr)
     SequenceControlSet                    *sequence_control_set_ptr;
 
     // Input
-    EbObjectWrapper                       *encDecResultsWrapperPtr;
-    EncDecResults                         *encDecResultsPtr;
+    EbObjectWrapper                       *restResultsWrapperPtr;
+    RestResults                           *restResultsPtr;
 
     // Output
     EbObjectWrapper                       *entropyCodingResultsWrapperPtr;
@@ -534,12 +572,12 @@ void* entropy_coding_kernel(void *input_ptr)
     EbBool                                  initialProcessCall;
     for (;;) {
 
-        // Get Mode Decision Results
+        // Get Rest Results
         eb_get_full_object(
             context_ptr->enc_dec_input_fifo_ptr,
-            &encDecResultsWrapperPtr);
-        encDecResultsPtr = (EncDecResults*)encDecResultsWrapperPtr->object_ptr;
-        picture_control_set_ptr = (PictureControlSet*)encDecResultsPtr->picture_control_set_wrapper_ptr->object_ptr;
+            &restResultsWrapperPtr);
+        restResultsPtr = (RestResults*)restResultsWrapperPtr->object_ptr;
+        picture_control_set_ptr = (PictureControlSet*)restResultsPtr->picture_control_set_wrapper_ptr->object_ptr;
         sequence_control_set_ptr = (SequenceControlSet*)picture_control_set_ptr->sequence_control_set_wrapper_ptr->object_ptr;
 #if !RC 
         lastLcuFlag = EB_FALSE;
@@ -555,14 +593,19 @@ void* entropy_coding_kernel(void *input_ptr)
 
         {
             initialProcessCall = EB_TRUE;
-            y_lcu_index = encDecResultsPtr->completed_lcu_row_index_start;
+            y_lcu_index = restResultsPtr->completed_lcu_row_index_start;
 
             // LCU-loops
-            while (UpdateEntropyCodingRows(picture_control_set_ptr, &y_lcu_index, encDecResultsPtr->completed_lcu_row_count, &initialProcessCall) == EB_TRUE)
+            while (UpdateEntropyCodingRows(picture_control_set_ptr, &y_lcu_index, restResultsPtr->completed_lcu_row_count, &initialProcessCall) == EB_TRUE)
             {
                 uint32_t rowTotalBits = 0;
 
+                // A single tile picture is coded with the state of the first tile
+                context_ptr->entropy_tile_ptr = picture_control_set_ptr->entropy_coding_info[0];
+
                 if (y_lcu_index == 0) {
+                    entropy_coding_set_neighbor_arrays_origin(context_ptr->entropy_tile_ptr, 0, 0,
+                        sequence_control_set_ptr->subsampling_x, sequence_control_set_ptr->subsampling_y);
                     ResetEntropyCodingPicture(
                         context_ptr,
                         picture_control_set_ptr,
@@ -585,7 +628,7 @@ void* entropy_coding_kernel(void *input_ptr)
                     lastLcuFlag = (sb_index == sequence_control_set_ptr->sb_tot_cnt - 1) ? EB_TRUE : EB_FALSE;
 #endif
                     if (sb_index == 0)
-                        av1_reset_loop_restoration(picture_control_set_ptr);
+                        av1_reset_loop_restoration(context_ptr->entropy_tile_ptr);
                     // Configure the LCU
                     EntropyCodingConfigureLcu(
                         context_ptr,
@@ -651,7 +694,10 @@ void* entropy_coding_kernel(void *input_ptr)
 
                         picture_control_set_ptr->entropy_coding_pic_done = EB_TRUE;
 
-                        encode_slice_finish(picture_control_set_ptr->entropy_coder_ptr);
+                        CHECK_REPORT_ERROR(
+                            encode_slice_finish(picture_control_set_ptr->entropy_coder_ptr) == EB_ErrorNone,
+                            sequence_control_set_ptr->encode_context_ptr->app_callback_ptr,
+                            EB_ENC_EC_ERROR18);
 
                         // Release the List 0 Reference Pictures
                         for (ref_idx = 0; ref_idx < picture_control_set_ptr->parent_pcs_ptr->ref_list0_count; ++ref_idx) {
@@ -689,7 +735,7 @@ void* entropy_coding_kernel(void *input_ptr)
                             context_ptr->entropy_coding_output_fifo_ptr,
                             &entropyCodingResultsWrapperPtr);
                         entropyCodingResultsPtr = (EntropyCodingResults*)entropyCodingResultsWrapperPtr->object_ptr;
-                        entropyCodingResultsPtr->picture_control_set_wrapper_ptr = encDecResultsPtr->picture_control_set_wrapper_ptr;
+                        entropyCodingResultsPtr->picture_control_set_wrapper_ptr = restResultsPtr->picture_control_set_wrapper_ptr;
 
                         // Post EntropyCoding Results
                         eb_post_full_object(entropyCodingResultsWrapperPtr);
@@ -704,159 +750,153 @@ void* entropy_coding_kernel(void *input_ptr)
         }
         else
         {
-
-             struct PictureParentControlSet     *ppcs_ptr = picture_control_set_ptr->parent_pcs_ptr;
-             Av1Common *const cm = ppcs_ptr->av1_cm;           
-             uint32_t total_size = 0;
-             int tile_row, tile_col;
-             const int tile_cols = ppcs_ptr->av1_cm->tile_cols;
-             const int tile_rows = ppcs_ptr->av1_cm->tile_rows;
-
-             //Entropy Tile Loop
-             for (tile_row = 0; tile_row < tile_rows; tile_row++)
-             {
-                 
-                 TileInfo tile_info;
-                 av1_tile_set_row(&tile_info, ppcs_ptr, tile_row);
-
-                 for (tile_col = 0; tile_col < tile_cols; tile_col++)
-                 { 
-                     const int tile_idx = tile_row * tile_cols + tile_col;
-                     uint32_t is_last_tile_in_tg = 0;
-
-                     if ( tile_idx == (tile_cols * tile_rows - 1)) {
-                         is_last_tile_in_tg = 1;                       
-                     }
-                     else {
-                         is_last_tile_in_tg = 0;                        
-                     }
-
-                     reset_ec_tile(
-                         total_size,
-                         is_last_tile_in_tg,
-                         context_ptr,
-                         picture_control_set_ptr,
-                         sequence_control_set_ptr);
-
-                     av1_tile_set_col(&tile_info, ppcs_ptr, tile_col);
-   
-                     av1_reset_loop_restoration(picture_control_set_ptr);
-                   
-                     for (y_lcu_index = cm->tile_row_start_sb[tile_row]; y_lcu_index < (uint32_t)cm->tile_row_start_sb[tile_row + 1]; ++y_lcu_index)
-                     {
-                         for (x_lcu_index = cm->tile_col_start_sb[tile_col]; x_lcu_index < (uint32_t)cm->tile_col_start_sb[tile_col + 1]; ++x_lcu_index)
-                         {
-                             
-                             int sb_index = (uint16_t)(x_lcu_index + y_lcu_index * picture_width_in_sb);
-                             sb_ptr = picture_control_set_ptr->sb_ptr_array[sb_index];
-                             sb_origin_x = x_lcu_index << lcuSizeLog2;
-                             sb_origin_y = y_lcu_index << lcuSizeLog2;
-                             context_ptr->sb_origin_x = sb_origin_x;
-                             context_ptr->sb_origin_y = sb_origin_y;
+            // Each tile is posted separately by the Rest process and coded
+            // into the entropy coder of its EntropyTileInfo, the tiles are
+            // stitched together with their sizes in Packetization
+            struct PictureParentControlSet     *ppcs_ptr = picture_control_set_ptr->parent_pcs_ptr;
+            Av1Common *const cm = ppcs_ptr->av1_cm;
+            const uint16_t tile_idx = restResultsPtr->tile_index;
+            const uint16_t tile_cnt = (uint16_t)(cm->tile_cols * cm->tile_rows);
+            const int tile_row = tile_idx / cm->tile_cols;
+            const int tile_col = tile_idx % cm->tile_cols;
+            uint64_t tile_coeff_bits = 0;
+            EbBool picture_done;
+            TileInfo tile_info;
+
+            // The tiles are allocated for the configured grid over the largest picture
+            CHECK_REPORT_ERROR(
+                tile_cnt <= picture_control_set_ptr->entropy_coding_tile_count,
+                sequence_control_set_ptr->encode_context_ptr->app_callback_ptr,
+                EB_ENC_EC_ERROR17);
+            context_ptr->entropy_tile_ptr = picture_control_set_ptr->entropy_coding_info[tile_idx];
+            CHECK_REPORT_ERROR(
+                ((uint32_t)(cm->tile_col_start_sb[tile_col + 1] - cm->tile_col_start_sb[tile_col]) << lcuSizeLog2) <= context_ptr->entropy_tile_ptr->max_tile_width &&
+                ((uint32_t)(cm->tile_row_start_sb[tile_row + 1] - cm->tile_row_start_sb[tile_row]) << lcuSizeLog2) <= context_ptr->entropy_tile_ptr->max_tile_height,
+                sequence_control_set_ptr->encode_context_ptr->app_callback_ptr,
+                EB_ENC_EC_ERROR17);
+            entropy_coding_set_neighbor_arrays_origin(
+                context_ptr->entropy_tile_ptr,
+                (uint16_t)(cm->tile_col_start_sb[tile_col] << lcuSizeLog2),
+                (uint16_t)(cm->tile_row_start_sb[tile_row] << lcuSizeLog2),
+                sequence_control_set_ptr->subsampling_x,
+                sequence_control_set_ptr->subsampling_y);
+
+            reset_ec_tile(
+                context_ptr,
+                picture_control_set_ptr,
+                sequence_control_set_ptr);
+
+            av1_tile_set_row(&tile_info, ppcs_ptr, tile_row);
+            av1_tile_set_col(&tile_info, ppcs_ptr, tile_col);
+
+            av1_reset_loop_restoration(context_ptr->entropy_tile_ptr);
+
+            for (y_lcu_index = cm->tile_row_start_sb[tile_row]; y_lcu_index < (uint32_t)cm->tile_row_start_sb[tile_row + 1]; ++y_lcu_index)
+            {
+                for (x_lcu_index = cm->tile_col_start_sb[tile_col]; x_lcu_index < (uint32_t)cm->tile_col_start_sb[tile_col + 1]; ++x_lcu_index)
+                {
+                    int sb_index = (uint16_t)(x_lcu_index + y_lcu_index * picture_width_in_sb);
+                    sb_ptr = picture_control_set_ptr->sb_ptr_array[sb_index];
+                    sb_origin_x = x_lcu_index << lcuSizeLog2;
+                    sb_origin_y = y_lcu_index << lcuSizeLog2;
+                    context_ptr->sb_origin_x = sb_origin_x;
+                    context_ptr->sb_origin_y = sb_origin_y;
 #if !RC
-                             lastLcuFlag = (sb_index == sequence_control_set_ptr->sb_tot_cnt - 1) ? EB_TRUE : EB_FALSE;
-#endif                            
-                             // Configure the LCU
-                             EntropyCodingConfigureLcu(
-                                 context_ptr,
-                                 sb_ptr,
-                                 picture_control_set_ptr);                           
+                    lastLcuFlag = (sb_index == sequence_control_set_ptr->sb_tot_cnt - 1) ? EB_TRUE : EB_FALSE;
+#endif
+                    // Configure the LCU
+                    EntropyCodingConfigureLcu(
+                        context_ptr,
+                        sb_ptr,
+                        picture_control_set_ptr);
 #if RC
-                             sb_ptr->total_bits = 0;
-                             uint32_t prev_pos = sb_index ? picture_control_set_ptr->entropy_coder_ptr->ec_writer.ec.offs : 0;//residual_bc.pos
-                             EbPictureBufferDesc *coeff_picture_ptr = sb_ptr->quantized_coeff;
-                             write_sb(
-                                 context_ptr,
-                                 sb_ptr,
-                                 picture_control_set_ptr,
-                                 picture_control_set_ptr->entropy_coder_ptr,
-                                 coeff_picture_ptr);
-                             sb_ptr->total_bits = (picture_control_set_ptr->entropy_coder_ptr->ec_writer.ec.offs - prev_pos) << 3;
-                             picture_control_set_ptr->parent_pcs_ptr->quantized_coeff_num_bits += sb_ptr->total_bits;
+                    EntropyCoder *tile_entropy_coder_ptr = context_ptr->entropy_tile_ptr->entropy_coder_ptr;
+                    sb_ptr->total_bits = 0;
+                    uint32_t prev_pos = tile_entropy_coder_ptr->ec_writer.ec.offs;//residual_bc.pos
+                    EbPictureBufferDesc *coeff_picture_ptr = sb_ptr->quantized_coeff;
+                    write_sb(
+                        context_ptr,
+                        sb_ptr,
+                        picture_control_set_ptr,
+                        tile_entropy_coder_ptr,
+                        coeff_picture_ptr);
+                    sb_ptr->total_bits = (tile_entropy_coder_ptr->ec_writer.ec.offs - prev_pos) << 3;
+                    tile_coeff_bits += sb_ptr->total_bits;
 #else
-                             // Entropy Coding
-                             EntropyCodingLcu(
-                                 context_ptr,
-                                 sb_ptr,
-                                 picture_control_set_ptr,
-                                 sequence_control_set_ptr,
-                                 sb_origin_x,
-                                 sb_origin_y,
-                                 lastLcuFlag,
-                                 0,
-                                 0);
+                    // Entropy Coding
+                    EntropyCodingLcu(
+                        context_ptr,
+                        sb_ptr,
+                        picture_control_set_ptr,
+                        sequence_control_set_ptr,
+                        sb_origin_x,
+                        sb_origin_y,
+                        lastLcuFlag,
+                        0,
+                        0);
 #endif
-                         }
-                     }
-                                         
-                     encode_slice_finish(picture_control_set_ptr->entropy_coder_ptr);
-                    
-                     int tile_size = picture_control_set_ptr->entropy_coder_ptr->ec_writer.pos;
-                     assert(tile_size >= AV1_MIN_TILE_SIZE_BYTES);
-                    
-                     if (!is_last_tile_in_tg) {
-                         
-                         OutputBitstreamUnit *output_bitstream_ptr = (OutputBitstreamUnit*)(picture_control_set_ptr->entropy_coder_ptr->ec_output_bitstream_ptr);
-                         uint8_t *buf_data = output_bitstream_ptr->buffer_av1 + total_size;
-                         mem_put_le32(buf_data, tile_size - AV1_MIN_TILE_SIZE_BYTES);
-                     }                   
-
-                     if (is_last_tile_in_tg==0)                     
-                         total_size += 4;                     
-
-                     total_size += tile_size;
-
-                 }
-
-             }
-
-             //the picture is complete, terminate the slice            
-             {
-                 uint32_t ref_idx;         
-                 picture_control_set_ptr->entropy_coder_ptr->ec_frame_size = total_size;
-
-                 // Release the List 0 Reference Pictures
-                 for (ref_idx = 0; ref_idx < picture_control_set_ptr->parent_pcs_ptr->ref_list0_count; ++ref_idx) {
+                }
+            }
+
+            CHECK_REPORT_ERROR(
+                encode_slice_finish(context_ptr->entropy_tile_ptr->entropy_coder_ptr) == EB_ErrorNone,
+                sequence_control_set_ptr->encode_context_ptr->app_callback_ptr,
+                EB_ENC_EC_ERROR18);
+            assert(context_ptr->entropy_tile_ptr->entropy_coder_ptr->ec_writer.pos >= AV1_MIN_TILE_SIZE_BYTES);
+
+            if (sequence_control_set_ptr->static_config.tile_group_output)
+                packetization_tile_done(picture_control_set_ptr, tile_idx);
+
+            // The last tile to complete terminates the picture
+            eb_block_on_mutex(picture_control_set_ptr->entropy_coding_mutex);
+            ppcs_ptr->quantized_coeff_num_bits += tile_coeff_bits;
+            picture_done = (EbBool)(++picture_control_set_ptr->entropy_coding_tile_done_count == tile_cnt);
+            eb_release_mutex(picture_control_set_ptr->entropy_coding_mutex);
+
+            if (picture_done)
+            {
+                uint32_t ref_idx;
+
+                // Release the List 0 Reference Pictures
+                for (ref_idx = 0; ref_idx < picture_control_set_ptr->parent_pcs_ptr->ref_list0_count; ++ref_idx) {
 #if MRP_MD
-                     if (picture_control_set_ptr->ref_pic_ptr_array[0][ref_idx] != EB_NULL) {
-                         eb_release_object(picture_control_set_ptr->ref_pic_ptr_array[0][ref_idx]);
-                     }
+                    if (picture_control_set_ptr->ref_pic_ptr_array[0][ref_idx] != EB_NULL) {
+                        eb_release_object(picture_control_set_ptr->ref_pic_ptr_array[0][ref_idx]);
+                    }
 #else
-                     if (picture_control_set_ptr->ref_pic_ptr_array[0] != EB_NULL) {
-                         eb_release_object(picture_control_set_ptr->ref_pic_ptr_array[0]);
-                     }
+                    if (picture_control_set_ptr->ref_pic_ptr_array[0] != EB_NULL) {
+                        eb_release_object(picture_control_set_ptr->ref_pic_ptr_array[0]);
+                    }
 #endif
-                 }
+                }
 
-                 // Release the List 1 Reference Pictures
-                 for (ref_idx = 0; ref_idx < picture_control_set_ptr->parent_pcs_ptr->ref_list1_count; ++ref_idx) {
+                // Release the List 1 Reference Pictures
+                for (ref_idx = 0; ref_idx < picture_control_set_ptr->parent_pcs_ptr->ref_list1_count; ++ref_idx) {
 #if MRP_MD
-                     if (picture_control_set_ptr->ref_pic_ptr_array[1][ref_idx] != EB_NULL) {
-                         eb_release_object(picture_control_set_ptr->ref_pic_ptr_array[1][ref_idx]);
-                     }
+                    if (picture_control_set_ptr->ref_pic_ptr_array[1][ref_idx] != EB_NULL) {
+                        eb_release_object(picture_control_set_ptr->ref_pic_ptr_array[1][ref_idx]);
+                    }
 #else
-                     if (picture_control_set_ptr->ref_pic_ptr_array[1] != EB_NULL) {
-                         eb_release_object(picture_control_set_ptr->ref_pic_ptr_array[1]);
-                     }
+                    if (picture_control_set_ptr->ref_pic_ptr_array[1] != EB_NULL) {
+                        eb_release_object(picture_control_set_ptr->ref_pic_ptr_array[1]);
+                    }
 #endif
-                 }
-
-                 // Get Empty Entropy Coding Results
-                 eb_get_empty_object(
-                     context_ptr->entropy_coding_output_fifo_ptr,
-                     &entropyCodingResultsWrapperPtr);
-                 entropyCodingResultsPtr = (EntropyCodingResults*)entropyCodingResultsWrapperPtr->object_ptr;
-                 entropyCodingResultsPtr->picture_control_set_wrapper_ptr = encDecResultsPtr->picture_control_set_wrapper_ptr;
-
-                 // Post EntropyCoding Results
-                 eb_post_full_object(entropyCodingResultsWrapperPtr);
+                }
 
-             } 
+                // Get Empty Entropy Coding Results
+                eb_get_empty_object(
+                    context_ptr->entropy_coding_output_fifo_ptr,
+                    &entropyCodingResultsWrapperPtr);
+                entropyCodingResultsPtr = (EntropyCodingResults*)entropyCodingResultsWrapperPtr->object_ptr;
+                entropyCodingResultsPtr->picture_control_set_wrapper_ptr = restResultsPtr->picture_control_set_wrapper_ptr;
 
+                // Post EntropyCoding Results
+                eb_post_full_object(entropyCodingResultsWrapperPtr);
+            }
         }
 
         // Release Mode Decision Results
-        eb_release_object(encDecResultsWrapperPtr);
+        eb_release_object(restResultsWrapperPtr);
 
     }
 
@@ -40,6 +40,9 @@ typedef struct EntropyCodingContext
     // Coding Unit Workspace---------------------------
     EbPictureBufferDesc           *coeff_buffer_sb;                              //Used to hold quantized coeff for one TB in EncPass.
 
+    // Tile being coded: neighbor arrays, CDEF / LR references and bitstream
+    EntropyTileInfo                *entropy_tile_ptr;
+
     //  Context Variables---------------------------------
     CodingUnit                     *cu_ptr;
     const CodedUnitStats           *cu_stats;
@@ -0,0 +1,277 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#include <stdlib.h>
+
+#include "EbHostContext.h"
+#include "EbThreads.h"
+#include "EbPipelineStats.h"
+#include "EbUtility.h"
+
+#ifdef _WIN32
+#define EB_THREAD_LOCAL __declspec(thread)
+#else
+#define EB_THREAD_LOCAL __thread
+#endif
+
+// Worker held by the calling kernel thread
+static EB_THREAD_LOCAL EbHostChannel   *held_channel_ptr = NULL;
+static EB_THREAD_LOCAL uint64_t         held_start_us = 0;
+
+/**************************************
+ * eb_host_context_ctor
+ **************************************/
+EbErrorType eb_host_context_ctor(
+    EbSvtHostContext        **host_context_dbl_ptr,
+    uint32_t                  worker_count,
+    uint32_t                  expected_channel_count,
+    uint32_t                  max_thread_count)
+{
+    EbSvtHostContext *host_context_ptr;
+
+    *host_context_dbl_ptr = (EbSvtHostContext*)EB_NULL;
+    if (worker_count == 0)
+        return EB_ErrorBadParameter;
+
+    host_context_ptr = (EbSvtHostContext*)calloc(1, sizeof(EbSvtHostContext));
+    if (host_context_ptr == (EbSvtHostContext*)EB_NULL)
+        return EB_ErrorInsufficientResources;
+
+    host_context_ptr->mutex = eb_create_mutex();
+    if (host_context_ptr->mutex == (EbHandle)EB_NULL) {
+        free(host_context_ptr);
+        return EB_ErrorInsufficientResources;
+    }
+    host_context_ptr->worker_count = worker_count;
+    host_context_ptr->free_worker_count = worker_count;
+    host_context_ptr->expected_channel_count = expected_channel_count;
+    host_context_ptr->max_thread_count = max_thread_count ? max_thread_count :
+        2 * worker_count + EB_HOST_MIN_CHANNEL_THREADS * MAX(expected_channel_count, 1);
+
+    *host_context_dbl_ptr = host_context_ptr;
+    return EB_ErrorNone;
+}
+
+/**************************************
+ * eb_host_context_dtor
+ **************************************/
+EbErrorType eb_host_context_dtor(
+    EbSvtHostContext         *host_context_ptr)
+{
+    if (host_context_ptr->channel_list != (EbHostChannel*)EB_NULL)
+        return EB_ErrorBadParameter;
+
+    eb_destroy_mutex(host_context_ptr->mutex);
+    free(host_context_ptr);
+    return EB_ErrorNone;
+}
+
+/**************************************
+ * Hands the free workers to the waiting
+ * channels, lowest virtual time first.
+ * Called with the mutex held.
+ **************************************/
+static void hand_over_free_workers(
+    EbSvtHostContext         *host_context_ptr)
+{
+    while (host_context_ptr->free_worker_count > 0) {
+        EbHostChannel *next_channel_ptr = (EbHostChannel*)EB_NULL;
+        EbHostChannel *channel_ptr;
+
+        for (channel_ptr = host_context_ptr->channel_list; channel_ptr; channel_ptr = channel_ptr->next_ptr) {
+            if (channel_ptr->waiting_count &&
+                (next_channel_ptr == (EbHostChannel*)EB_NULL || channel_ptr->virtual_time < next_channel_ptr->virtual_time))
+                next_channel_ptr = channel_ptr;
+        }
+        if (next_channel_ptr == (EbHostChannel*)EB_NULL)
+            return;
+
+        // Counted as running before the thread wakes up, see eb_host_channel_detach()
+        host_context_ptr->free_worker_count--;
+        next_channel_ptr->waiting_count--;
+        next_channel_ptr->running_count++;
+        host_context_ptr->virtual_time = next_channel_ptr->virtual_time;
+        eb_post_semaphore(next_channel_ptr->wake_semaphore);
+    }
+}
+
+/**************************************
+ * eb_host_channel_attach
+ **************************************/
+EbErrorType eb_host_channel_attach(
+    EbSvtHostContext         *host_context_ptr,
+    uint32_t                  weight,
+    EbHostChannel           **channel_dbl_ptr)
+{
+    EbHostChannel *channel_ptr;
+
+    *channel_dbl_ptr = (EbHostChannel*)EB_NULL;
+    if (weight == 0 || weight > EB_HOST_MAX_WEIGHT)
+        return EB_ErrorBadParameter;
+
+    channel_ptr = (EbHostChannel*)calloc(1, sizeof(EbHostChannel));
+    if (channel_ptr == (EbHostChannel*)EB_NULL)
+        return EB_ErrorInsufficientResources;
+
+    channel_ptr->wake_semaphore = eb_create_semaphore(0, host_context_ptr->worker_count);
+    if (channel_ptr->wake_semaphore == (EbHandle)EB_NULL) {
+        free(channel_ptr);
+        return EB_ErrorInsufficientResources;
+    }
+    channel_ptr->host_context_ptr = host_context_ptr;
+    channel_ptr->weight = weight;
+
+    eb_block_on_mutex(host_context_ptr->mutex);
+    channel_ptr->virtual_time = host_context_ptr->virtual_time;
+    channel_ptr->next_ptr = host_context_ptr->channel_list;
+    host_context_ptr->channel_list = channel_ptr;
+    eb_release_mutex(host_context_ptr->mutex);
+
+    *channel_dbl_ptr = channel_ptr;
+    return EB_ErrorNone;
+}
+
+/**************************************
+ * eb_host_channel_detach
+ *   The kernel threads were cancelled,
+ *   possibly while holding or waiting
+ *   for a worker: whatever the channel
+ *   still counts goes back to the pool.
+ **************************************/
+void eb_host_channel_detach(
+    EbHostChannel            *channel_ptr)
+{
+    EbSvtHostContext *host_context_ptr = channel_ptr->host_context_ptr;
+    EbHostChannel   **link_dbl_ptr;
+
+    eb_block_on_mutex(host_context_ptr->mutex);
+    for (link_dbl_ptr = &host_context_ptr->channel_list; *link_dbl_ptr; link_dbl_ptr = &(*link_dbl_ptr)->next_ptr) {
+        if (*link_dbl_ptr == channel_ptr) {
+            *link_dbl_ptr = channel_ptr->next_ptr;
+            break;
+        }
+    }
+    host_context_ptr->free_worker_count += channel_ptr->running_count;
+    host_context_ptr->thread_count -= channel_ptr->thread_count;
+    hand_over_free_workers(host_context_ptr);
+    eb_release_mutex(host_context_ptr->mutex);
+
+    eb_destroy_semaphore(channel_ptr->wake_semaphore);
+    free(channel_ptr);
+}
+
+/**************************************
+ * eb_host_channel_thread_budget
+ *   Twice the weighted share of the
+ *   workers, so that a channel can take
+ *   over the workers others leave idle.
+ **************************************/
+uint32_t eb_host_channel_thread_budget(
+    EbHostChannel            *channel_ptr)
+{
+    EbSvtHostContext *host_context_ptr = channel_ptr->host_context_ptr;
+    uint64_t          budget;
+
+    if (host_context_ptr->expected_channel_count == 0)
+        return host_context_ptr->worker_count;
+
+    budget = 2 * (uint64_t)host_context_ptr->worker_count * channel_ptr->weight /
+        ((uint64_t)host_context_ptr->expected_channel_count * EB_HOST_DEFAULT_WEIGHT);
+
+    return (uint32_t)CLIP3((uint64_t)1, (uint64_t)host_context_ptr->worker_count, budget);
+}
+
+/**************************************
+ * eb_host_channel_reserve_threads
+ **************************************/
+EbErrorType eb_host_channel_reserve_threads(
+    EbHostChannel            *channel_ptr,
+    uint32_t                  thread_count)
+{
+    EbSvtHostContext *host_context_ptr = channel_ptr->host_context_ptr;
+    EbErrorType       return_error = EB_ErrorNone;
+
+    eb_block_on_mutex(host_context_ptr->mutex);
+    if (host_context_ptr->thread_count + thread_count > host_context_ptr->max_thread_count)
+        return_error = EB_ErrorInsufficientResources;
+    else {
+        host_context_ptr->thread_count += thread_count;
+        channel_ptr->thread_count += thread_count;
+    }
+    eb_release_mutex(host_context_ptr->mutex);
+
+    return return_error;
+}
+
+/**************************************
+ * eb_host_worker_acquire
+ **************************************/
+void eb_host_worker_acquire(
+    EbHostChannel            *channel_ptr)
+{
+    EbSvtHostContext *host_context_ptr = channel_ptr->host_context_ptr;
+    EbBool            wait_for_worker;
+
+    if (held_channel_ptr == channel_ptr)
+        return;
+
+    eb_block_on_mutex(host_context_ptr->mutex);
+    // An idle channel does not bank the worker time it did not use
+    if (channel_ptr->running_count == 0 && channel_ptr->waiting_count == 0 &&
+        channel_ptr->virtual_time < host_context_ptr->virtual_time)
+        channel_ptr->virtual_time = host_context_ptr->virtual_time;
+
+    wait_for_worker = (EbBool)(host_context_ptr->free_worker_count == 0);
+    if (wait_for_worker)
+        channel_ptr->waiting_count++;
+    else {
+        host_context_ptr->free_worker_count--;
+        channel_ptr->running_count++;
+    }
+    eb_release_mutex(host_context_ptr->mutex);
+
+    // The worker is already counted in running_count when this returns
+    if (wait_for_worker)
+        eb_block_on_semaphore(channel_ptr->wake_semaphore);
+
+    held_channel_ptr = channel_ptr;
+    held_start_us = eb_pipeline_stats_time_us();
+}
+
+/**************************************
+ * eb_host_worker_release
+ **************************************/
+void eb_host_worker_release(
+    EbHostChannel            *channel_ptr)
+{
+    EbSvtHostContext *host_context_ptr = channel_ptr->host_context_ptr;
+    uint64_t          worker_time_us;
+
+    if (held_channel_ptr != channel_ptr)
+        return;
+    // Cleared before taking the mutex, eb_block_on_mutex() would release again
+    held_channel_ptr = (EbHostChannel*)EB_NULL;
+    worker_time_us = eb_pipeline_stats_time_us() - held_start_us;
+
+    eb_block_on_mutex(host_context_ptr->mutex);
+    channel_ptr->running_count--;
+    channel_ptr->virtual_time += worker_time_us * EB_HOST_DEFAULT_WEIGHT / channel_ptr->weight;
+    host_context_ptr->free_worker_count++;
+    hand_over_free_workers(host_context_ptr);
+    eb_release_mutex(host_context_ptr->mutex);
+}
+
+/**************************************
+ * eb_host_worker_suspend
+ **************************************/
+EbHostChannel *eb_host_worker_suspend(void)
+{
+    EbHostChannel *channel_ptr = held_channel_ptr;
+
+    if (channel_ptr)
+        eb_host_worker_release(channel_ptr);
+
+    return channel_ptr;
+}
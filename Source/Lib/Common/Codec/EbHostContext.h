@@ -0,0 +1,109 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#ifndef EbHostContext_h
+#define EbHostContext_h
+
+#include "EbDefinitions.h"
+#include "EbSvtAv1Enc.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Kernel threads of an encoder with one thread per stage
+#define EB_HOST_MIN_CHANNEL_THREADS     15
+
+    /**************************************
+     * Host channel: one encoder attached
+     * to a host context
+     **************************************/
+    typedef struct EbHostChannel
+    {
+        struct EbSvtHostContext  *host_context_ptr;
+        struct EbHostChannel     *next_ptr;
+        uint32_t                  weight;
+        // Kernel threads created, counted in the thread_count of the host
+        uint32_t                  thread_count;
+
+        // Workers held by the kernel threads of the channel, or handed to
+        // threads still waiting on wake_semaphore
+        uint32_t                  running_count;
+        // Kernel threads waiting for a worker
+        uint32_t                  waiting_count;
+        // Worker time used in us, scaled by EB_HOST_DEFAULT_WEIGHT / weight
+        uint64_t                  virtual_time;
+        EbHandle                  wake_semaphore;
+    } EbHostChannel;
+
+    /**************************************
+     * Host context: at most worker_count
+     * kernel threads of all the attached
+     * channels run at once. A freed worker
+     * goes to the waiting channel with the
+     * lowest virtual time.
+     **************************************/
+    struct EbSvtHostContext
+    {
+        EbHandle                  mutex;
+        uint32_t                  worker_count;
+        uint32_t                  free_worker_count;
+        uint32_t                  expected_channel_count;
+        uint32_t                  max_thread_count;
+        // Kernel threads of the attached channels
+        uint32_t                  thread_count;
+        // Virtual time of the last channel given a worker
+        uint64_t                  virtual_time;
+        EbHostChannel            *channel_list;
+    };
+
+    /**************************************
+     * Extern Function Declarations
+     **************************************/
+    extern EbErrorType eb_host_context_ctor(
+        EbSvtHostContext        **host_context_dbl_ptr,
+        uint32_t                  worker_count,
+        uint32_t                  expected_channel_count,
+        uint32_t                  max_thread_count);
+
+    extern EbErrorType eb_host_context_dtor(
+        EbSvtHostContext         *host_context_ptr);
+
+    extern EbErrorType eb_host_channel_attach(
+        EbSvtHostContext         *host_context_ptr,
+        uint32_t                  weight,
+        EbHostChannel           **channel_dbl_ptr);
+
+    // Called once the kernel threads of the channel are destroyed, returns
+    // the workers they still held
+    extern void eb_host_channel_detach(
+        EbHostChannel            *channel_ptr);
+
+    // Kernel threads to create for the channel
+    extern uint32_t eb_host_channel_thread_budget(
+        EbHostChannel            *channel_ptr);
+
+    // Counts the thread_count kernel threads of the channel against the
+    // max_thread_count of the host, fails when they do not fit
+    extern EbErrorType eb_host_channel_reserve_threads(
+        EbHostChannel            *channel_ptr,
+        uint32_t                  thread_count);
+
+    // Blocks the calling kernel thread until it gets a worker
+    extern void eb_host_worker_acquire(
+        EbHostChannel            *channel_ptr);
+
+    // Gives back the worker of the calling thread, if it holds one
+    extern void eb_host_worker_release(
+        EbHostChannel            *channel_ptr);
+
+    // Gives back the worker of the calling thread before it blocks, returns
+    // the channel to acquire again from, NULL if it held none
+    extern EbHostChannel *eb_host_worker_suspend(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // EbHostContext_h
@@ -2032,16 +2032,27 @@ void* initial_rate_control_kernel(void *input_ptr)
                         sequence_control_set_ptr,
                         picture_control_set_ptr);
 
-                    // Get Empty Reference Picture Object
-                    eb_get_empty_object(
-                        sequence_control_set_ptr->encode_context_ptr->reference_picture_pool_fifo_ptr,
-                        &reference_picture_wrapper_ptr);
-                    ((PictureParentControlSet*)(queueEntryPtr->parent_pcs_wrapper_ptr->object_ptr))->reference_picture_wrapper_ptr = reference_picture_wrapper_ptr;
-
-                    // Give the new Reference a nominal live_count of 1
-                    eb_object_inc_live_count(
-                        ((PictureParentControlSet*)(queueEntryPtr->parent_pcs_wrapper_ptr->object_ptr))->reference_picture_wrapper_ptr,
-                        1);
+                    // The first pass stops before Picture Manager, see eb_first_pass_picture_done()
+                    if (sequence_control_set_ptr->static_config.pass == 1)
+                        ((PictureParentControlSet*)(queueEntryPtr->parent_pcs_wrapper_ptr->object_ptr))->reference_picture_wrapper_ptr = (EbObjectWrapper*)EB_NULL;
+                    else {
+                        // Get Empty Reference Picture Object
+                        eb_get_empty_object(
+                            sequence_control_set_ptr->encode_context_ptr->reference_picture_pool_fifo_ptr,
+                            &reference_picture_wrapper_ptr);
+                        ((PictureParentControlSet*)(queueEntryPtr->parent_pcs_wrapper_ptr->object_ptr))->reference_picture_wrapper_ptr = reference_picture_wrapper_ptr;
+                        eb_reference_object_set_size(
+                            (EbReferenceObject*)reference_picture_wrapper_ptr->object_ptr,
+                            (uint16_t)sequence_control_set_ptr->luma_width,
+                            (uint16_t)sequence_control_set_ptr->luma_height);
+                        eb_reference_object_reset_rows(
+                            (EbReferenceObject*)reference_picture_wrapper_ptr->object_ptr);
+
+                        // Give the new Reference a nominal live_count of 1
+                        eb_object_inc_live_count(
+                            ((PictureParentControlSet*)(queueEntryPtr->parent_pcs_wrapper_ptr->object_ptr))->reference_picture_wrapper_ptr,
+                            1);
+                    }
                     //OPTION 1:  get the output stream buffer in ressource coordination
                     eb_get_empty_object(
                         sequence_control_set_ptr->encode_context_ptr->stream_output_fifo_ptr,
@@ -0,0 +1,227 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "EbLadderContext.h"
+#include "EbThreads.h"
+
+#define LADDER_NOT_WAITING              ((uint64_t)~0)
+#define LADDER_INITIAL_PICTURE_COUNT    1024
+
+/**************************************
+ * eb_ladder_context_ctor
+ *   Created for the leader, which holds
+ *   the first reference
+ **************************************/
+EbErrorType eb_ladder_context_ctor(
+    EbLadderContext         **ladder_dbl_ptr)
+{
+    EbLadderContext *ladder_ptr;
+
+    *ladder_dbl_ptr = (EbLadderContext*)EB_NULL;
+
+    ladder_ptr = (EbLadderContext*)calloc(1, sizeof(EbLadderContext));
+    if (ladder_ptr == (EbLadderContext*)EB_NULL)
+        return EB_ErrorInsufficientResources;
+
+    ladder_ptr->scene_change_array = (uint8_t*)calloc(LADDER_INITIAL_PICTURE_COUNT, sizeof(uint8_t));
+    ladder_ptr->mutex = eb_create_mutex();
+    if (ladder_ptr->scene_change_array == (uint8_t*)EB_NULL || ladder_ptr->mutex == (EbHandle)EB_NULL) {
+        if (ladder_ptr->mutex)
+            eb_destroy_mutex(ladder_ptr->mutex);
+        free(ladder_ptr->scene_change_array);
+        free(ladder_ptr);
+        return EB_ErrorInsufficientResources;
+    }
+    ladder_ptr->scene_change_array_size = LADDER_INITIAL_PICTURE_COUNT;
+    ladder_ptr->reference_count = 1;
+
+    *ladder_dbl_ptr = ladder_ptr;
+    return EB_ErrorNone;
+}
+
+/**************************************
+ * Drops a reference, the last one frees
+ * the context. Called with the mutex
+ * held, which it releases.
+ **************************************/
+static void ladder_context_release(
+    EbLadderContext          *ladder_ptr)
+{
+    EbBool free_flag = (EbBool)(--ladder_ptr->reference_count == 0);
+
+    eb_release_mutex(ladder_ptr->mutex);
+    if (free_flag) {
+        eb_destroy_mutex(ladder_ptr->mutex);
+        free(ladder_ptr->scene_change_array);
+        free(ladder_ptr);
+    }
+}
+
+/**************************************
+ * Wakes the renditions waiting for a
+ * picture the leader decided. Called
+ * with the mutex held.
+ **************************************/
+static void wake_renditions(
+    EbLadderContext          *ladder_ptr)
+{
+    EbLadderRendition *rendition_ptr;
+
+    for (rendition_ptr = ladder_ptr->rendition_list; rendition_ptr; rendition_ptr = rendition_ptr->next_ptr) {
+        if (rendition_ptr->wait_picture_number != LADDER_NOT_WAITING &&
+            (rendition_ptr->wait_picture_number < ladder_ptr->decided_count || ladder_ptr->end_of_sequence)) {
+            rendition_ptr->wait_picture_number = LADDER_NOT_WAITING;
+            eb_post_semaphore(rendition_ptr->wake_semaphore);
+        }
+    }
+}
+
+/**************************************
+ * eb_ladder_rendition_attach
+ **************************************/
+EbErrorType eb_ladder_rendition_attach(
+    EbLadderContext          *ladder_ptr,
+    EbLadderRendition       **rendition_dbl_ptr)
+{
+    EbLadderRendition *rendition_ptr;
+
+    *rendition_dbl_ptr = (EbLadderRendition*)EB_NULL;
+
+    rendition_ptr = (EbLadderRendition*)calloc(1, sizeof(EbLadderRendition));
+    if (rendition_ptr == (EbLadderRendition*)EB_NULL)
+        return EB_ErrorInsufficientResources;
+
+    rendition_ptr->wake_semaphore = eb_create_semaphore(0, 1);
+    if (rendition_ptr->wake_semaphore == (EbHandle)EB_NULL) {
+        free(rendition_ptr);
+        return EB_ErrorInsufficientResources;
+    }
+    rendition_ptr->ladder_ptr = ladder_ptr;
+    rendition_ptr->wait_picture_number = LADDER_NOT_WAITING;
+
+    eb_block_on_mutex(ladder_ptr->mutex);
+    rendition_ptr->next_ptr = ladder_ptr->rendition_list;
+    ladder_ptr->rendition_list = rendition_ptr;
+    ladder_ptr->reference_count++;
+    eb_release_mutex(ladder_ptr->mutex);
+
+    *rendition_dbl_ptr = rendition_ptr;
+    return EB_ErrorNone;
+}
+
+/**************************************
+ * eb_ladder_rendition_detach
+ **************************************/
+void eb_ladder_rendition_detach(
+    EbLadderRendition        *rendition_ptr)
+{
+    EbLadderContext    *ladder_ptr = rendition_ptr->ladder_ptr;
+    EbLadderRendition **link_dbl_ptr;
+
+    eb_block_on_mutex(ladder_ptr->mutex);
+    for (link_dbl_ptr = &ladder_ptr->rendition_list; *link_dbl_ptr; link_dbl_ptr = &(*link_dbl_ptr)->next_ptr) {
+        if (*link_dbl_ptr == rendition_ptr) {
+            *link_dbl_ptr = rendition_ptr->next_ptr;
+            break;
+        }
+    }
+    ladder_context_release(ladder_ptr);
+
+    eb_destroy_semaphore(rendition_ptr->wake_semaphore);
+    free(rendition_ptr);
+}
+
+/**************************************
+ * eb_ladder_leader_detach
+ **************************************/
+void eb_ladder_leader_detach(
+    EbLadderContext          *ladder_ptr)
+{
+    eb_block_on_mutex(ladder_ptr->mutex);
+    ladder_ptr->end_of_sequence = EB_TRUE;
+    wake_renditions(ladder_ptr);
+    ladder_context_release(ladder_ptr);
+}
+
+/**************************************
+ * eb_ladder_post_scene_change
+ **************************************/
+void eb_ladder_post_scene_change(
+    EbLadderContext          *ladder_ptr,
+    uint64_t                  picture_number,
+    EbBool                    scene_change_flag)
+{
+    eb_block_on_mutex(ladder_ptr->mutex);
+
+    // One byte per picture, the renditions may lag behind by any amount
+    if (picture_number >= ladder_ptr->scene_change_array_size) {
+        uint64_t  array_size = ladder_ptr->scene_change_array_size;
+        uint8_t  *scene_change_array;
+
+        while (picture_number >= array_size)
+            array_size <<= 1;
+        scene_change_array = (uint8_t*)realloc(ladder_ptr->scene_change_array, (size_t)array_size);
+        if (scene_change_array == (uint8_t*)EB_NULL) {
+            // The renditions detect nothing from here on
+            ladder_ptr->end_of_sequence = EB_TRUE;
+            wake_renditions(ladder_ptr);
+            eb_release_mutex(ladder_ptr->mutex);
+            return;
+        }
+        memset(scene_change_array + ladder_ptr->scene_change_array_size, 0, (size_t)(array_size - ladder_ptr->scene_change_array_size));
+        ladder_ptr->scene_change_array = scene_change_array;
+        ladder_ptr->scene_change_array_size = array_size;
+    }
+
+    ladder_ptr->scene_change_array[picture_number] = (uint8_t)scene_change_flag;
+    if (picture_number >= ladder_ptr->decided_count)
+        ladder_ptr->decided_count = picture_number + 1;
+    wake_renditions(ladder_ptr);
+
+    eb_release_mutex(ladder_ptr->mutex);
+}
+
+/**************************************
+ * eb_ladder_post_end_of_sequence
+ **************************************/
+void eb_ladder_post_end_of_sequence(
+    EbLadderContext          *ladder_ptr)
+{
+    eb_block_on_mutex(ladder_ptr->mutex);
+    ladder_ptr->end_of_sequence = EB_TRUE;
+    wake_renditions(ladder_ptr);
+    eb_release_mutex(ladder_ptr->mutex);
+}
+
+/**************************************
+ * eb_ladder_get_scene_change
+ *   Pictures beyond the end of the
+ *   sequence of the leader are no
+ *   scene change
+ **************************************/
+EbBool eb_ladder_get_scene_change(
+    EbLadderRendition        *rendition_ptr,
+    uint64_t                  picture_number)
+{
+    EbLadderContext *ladder_ptr = rendition_ptr->ladder_ptr;
+    EbBool           scene_change_flag;
+
+    eb_block_on_mutex(ladder_ptr->mutex);
+    while (picture_number >= ladder_ptr->decided_count && !ladder_ptr->end_of_sequence) {
+        rendition_ptr->wait_picture_number = picture_number;
+        eb_release_mutex(ladder_ptr->mutex);
+        eb_block_on_semaphore(rendition_ptr->wake_semaphore);
+        eb_block_on_mutex(ladder_ptr->mutex);
+    }
+    scene_change_flag = (picture_number < ladder_ptr->decided_count) ?
+        (EbBool)ladder_ptr->scene_change_array[picture_number] :
+        EB_FALSE;
+    eb_release_mutex(ladder_ptr->mutex);
+
+    return scene_change_flag;
+}
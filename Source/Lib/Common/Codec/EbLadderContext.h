@@ -0,0 +1,84 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#ifndef EbLadderContext_h
+#define EbLadderContext_h
+
+#include "EbDefinitions.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    /**************************************
+     * Ladder rendition: an encoder taking
+     * the scene changes of the leader
+     **************************************/
+    typedef struct EbLadderRendition
+    {
+        struct EbLadderContext   *ladder_ptr;
+        struct EbLadderRendition *next_ptr;
+        // Picture waited for by Picture Decision, ~0 when not waiting
+        uint64_t                  wait_picture_number;
+        EbHandle                  wake_semaphore;
+    } EbLadderRendition;
+
+    /**************************************
+     * Ladder context: the scene changes
+     * of the leader, one per picture in
+     * display order. Freed with the last
+     * of the leader and its renditions.
+     **************************************/
+    typedef struct EbLadderContext
+    {
+        EbHandle                  mutex;
+        uint32_t                  reference_count;
+        uint8_t                  *scene_change_array;
+        uint64_t                  scene_change_array_size;
+        // Pictures decided by the leader
+        uint64_t                  decided_count;
+        // The leader decides no more pictures
+        EbBool                    end_of_sequence;
+        EbLadderRendition        *rendition_list;
+    } EbLadderContext;
+
+    /**************************************
+     * Extern Function Declarations
+     **************************************/
+    extern EbErrorType eb_ladder_context_ctor(
+        EbLadderContext         **ladder_dbl_ptr);
+
+    extern EbErrorType eb_ladder_rendition_attach(
+        EbLadderContext          *ladder_ptr,
+        EbLadderRendition       **rendition_dbl_ptr);
+
+    // Called once the kernel threads of the rendition are destroyed
+    extern void eb_ladder_rendition_detach(
+        EbLadderRendition        *rendition_ptr);
+
+    // Called by the leader once its kernel threads are destroyed, the
+    // renditions still running get no more scene changes
+    extern void eb_ladder_leader_detach(
+        EbLadderContext          *ladder_ptr);
+
+    // Leader Picture Decision, pictures in display order
+    extern void eb_ladder_post_scene_change(
+        EbLadderContext          *ladder_ptr,
+        uint64_t                  picture_number,
+        EbBool                    scene_change_flag);
+
+    // Leader Picture Decision, at the end of the sequence
+    extern void eb_ladder_post_end_of_sequence(
+        EbLadderContext          *ladder_ptr);
+
+    // Rendition Picture Decision, blocks until the leader decided the picture
+    extern EbBool eb_ladder_get_scene_change(
+        EbLadderRendition        *rendition_ptr,
+        uint64_t                  picture_number);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // EbLadderContext_h
@@ -126,6 +126,28 @@ extern "C" {
         uint32_t            padding_width,
         uint32_t            padding_height);
 
+    // Pads the rows [row_start, row_end) of the picture, with the top padding
+    // when row_start is 0 and the bottom padding when row_end is the height
+    extern void generate_padding_rows(
+        EbByte              src_pic,
+        uint32_t            src_stride,
+        uint32_t            original_src_width,
+        uint32_t            original_src_height,
+        uint32_t            padding_width,
+        uint32_t            padding_height,
+        uint32_t            row_start,
+        uint32_t            row_end);
+
+    extern void generate_padding16_bit_rows(
+        EbByte              src_pic,
+        uint32_t            src_stride,
+        uint32_t            original_src_width,
+        uint32_t            original_src_height,
+        uint32_t            padding_width,
+        uint32_t            padding_height,
+        uint32_t            row_start,
+        uint32_t            row_end);
+
     extern void pad_input_picture(
         EbByte              src_pic,
         uint32_t            src_stride,
@@ -36,6 +36,8 @@
 #define  INCRMENT_CAND_TOTAL_COUNT(cnt) cnt++; if(cnt>=MODE_DECISION_CANDIDATE_MAX_COUNT) printf(" ERROR: reaching limit for MODE_DECISION_CANDIDATE_MAX_COUNT %i\n",cnt);
 #endif
 int8_t av1_ref_frame_type(const MvReferenceFrame *const rf);
+void av1_set_ref_frame(MvReferenceFrame *rf,
+    int8_t ref_frame_type);
 /********************************************
 * Constants
 ********************************************/
@@ -2133,6 +2135,163 @@ void inject_warped_motion_candidates(
 
     *candTotCnt = canIdx;
 }
+/***************************************
+* Screen content: injects one NEWMV candidate per
+* reference, the exact match of the source block
+* in the hash table of the reference which is the
+* closest to the block
+***************************************/
+static void inject_hash_inter_candidates(
+    PictureControlSet            *picture_control_set_ptr,
+    ModeDecisionContext          *context_ptr,
+    const SequenceControlSet     *sequence_control_set_ptr,
+    uint32_t                     *candidateTotalCnt)
+{
+    uint32_t                   canTotalCnt = *candidateTotalCnt;
+    ModeDecisionCandidate     *candidateArray = context_ptr->fast_candidate_array;
+    EbPictureBufferDesc       *input_picture_ptr = picture_control_set_ptr->parent_pcs_ptr->enhanced_picture_ptr;
+    const int                  block_size = context_ptr->blk_geom->bwidth;
+    const int                  x_pos = context_ptr->cu_origin_x;
+    const int                  y_pos = context_ptr->cu_origin_y;
+    uint32_t                   hash_value_buffer[2][2][(64 >> 1) * (64 >> 1)];
+    uint32_t                   hash_value1, hash_value2;
+    IntMv                      bestPredmv[2] = { {0}, {0} };
+    IntraBcContext             x_st;
+    IntraBcContext            *x = &x_st;
+
+    // The tables hold the square blocks fully inside the picture
+    if (context_ptr->blk_geom->bwidth != context_ptr->blk_geom->bheight || block_size < 8 || block_size > 64)
+        return;
+    if (x_pos + block_size > sequence_control_set_ptr->luma_width || y_pos + block_size > sequence_control_set_ptr->luma_height)
+        return;
+
+    for (int i = 0; i < 2; i++)
+        for (int j = 0; j < 2; j++)
+            x->hash_value_buffer[i][j] = hash_value_buffer[i][j];
+    x->crc_calculator1 = picture_control_set_ptr->crc_calculator1;
+    x->crc_calculator2 = picture_control_set_ptr->crc_calculator2;
+
+    av1_get_block_hash_value(
+        input_picture_ptr->buffer_y + (input_picture_ptr->origin_y + y_pos) * input_picture_ptr->stride_y + input_picture_ptr->origin_x + x_pos,
+        input_picture_ptr->stride_y,
+        block_size,
+        &hash_value1,
+        &hash_value2,
+        0,
+        picture_control_set_ptr,
+        x);
+
+    const uint8_t list_count = (picture_control_set_ptr->parent_pcs_ptr->reference_mode == SINGLE_REFERENCE) ? 1 : 2;
+    for (uint8_t list_index = REF_LIST_0; list_index < list_count; ++list_index) {
+        const uint8_t ref_count = (list_index == REF_LIST_0) ?
+            picture_control_set_ptr->parent_pcs_ptr->ref_list0_count :
+            picture_control_set_ptr->parent_pcs_ptr->ref_list1_count;
+
+        for (uint8_t ref_index = 0; ref_index < ref_count; ++ref_index) {
+            EbReferenceObject *reference_object = (EbReferenceObject*)picture_control_set_ptr->ref_pic_ptr_array[list_index][ref_index]->object_ptr;
+
+            if (!reference_object->hash_table_valid)
+                continue;
+
+            const int32_t count = av1_hash_table_count(&reference_object->hash_table, hash_value1);
+            int32_t best_distance = INT32_MAX;
+            int16_t best_mv_x = 0;
+            int16_t best_mv_y = 0;
+            Iterator iterator = av1_hash_get_first_iterator(&reference_object->hash_table, hash_value1);
+            for (int32_t i = 0; i < count; i++, iterator_increment(&iterator)) {
+                const block_hash ref_block_hash = *(block_hash*)(iterator_get(&iterator));
+                const int32_t mv_x = ref_block_hash.x - x_pos;
+                const int32_t mv_y = ref_block_hash.y - y_pos;
+                const int32_t distance = ABS(mv_x) + ABS(mv_y);
+
+                if (hash_value2 != ref_block_hash.hash_value2 || distance >= best_distance)
+                    continue;
+                if ((mv_x << 3) <= MV_LOW || (mv_x << 3) >= MV_UPP || (mv_y << 3) <= MV_LOW || (mv_y << 3) >= MV_UPP)
+                    continue;
+                best_distance = distance;
+                best_mv_x = (int16_t)(mv_x << 3);
+                best_mv_y = (int16_t)(mv_y << 3);
+            }
+
+            // No match, or the co-located block which the zero MV candidates cover
+            if (best_distance == INT32_MAX || best_distance == 0)
+                continue;
+
+            const uint8_t to_inject_ref_type = svt_get_ref_frame_type(list_index, ref_index);
+            if (list_index == REF_LIST_0) {
+                if (context_ptr->injected_mv_count_l0 && mrp_is_already_injected_mv_l0(context_ptr, best_mv_x, best_mv_y, to_inject_ref_type))
+                    continue;
+            }
+            else if (context_ptr->injected_mv_count_l1 && mrp_is_already_injected_mv_l1(context_ptr, best_mv_x, best_mv_y, to_inject_ref_type))
+                continue;
+
+            candidateArray[canTotalCnt].type = INTER_MODE;
+            candidateArray[canTotalCnt].distortion_ready = 0;
+            candidateArray[canTotalCnt].use_intrabc = 0;
+            candidateArray[canTotalCnt].merge_flag = EB_FALSE;
+            candidateArray[canTotalCnt].prediction_direction[0] = (EbPredDirection)list_index;
+            candidateArray[canTotalCnt].inter_mode = NEWMV;
+            candidateArray[canTotalCnt].pred_mode = NEWMV;
+            candidateArray[canTotalCnt].motion_mode = SIMPLE_TRANSLATION;
+            candidateArray[canTotalCnt].is_compound = 0;
+            candidateArray[canTotalCnt].is_new_mv = 1;
+            candidateArray[canTotalCnt].is_zero_mv = 0;
+            candidateArray[canTotalCnt].drl_index = 0;
+            candidateArray[canTotalCnt].ref_mv_index = 0;
+            candidateArray[canTotalCnt].pred_mv_weight = 0;
+            candidateArray[canTotalCnt].ref_frame_type = to_inject_ref_type;
+            candidateArray[canTotalCnt].transform_type[PLANE_TYPE_Y] = DCT_DCT;
+            candidateArray[canTotalCnt].transform_type[PLANE_TYPE_UV] = DCT_DCT;
+
+            if (list_index == REF_LIST_0) {
+                candidateArray[canTotalCnt].motion_vector_xl0 = best_mv_x;
+                candidateArray[canTotalCnt].motion_vector_yl0 = best_mv_y;
+                candidateArray[canTotalCnt].ref_frame_index_l0 = ref_index;
+                candidateArray[canTotalCnt].ref_frame_index_l1 = -1;
+            }
+            else {
+                candidateArray[canTotalCnt].motion_vector_xl1 = best_mv_x;
+                candidateArray[canTotalCnt].motion_vector_yl1 = best_mv_y;
+                candidateArray[canTotalCnt].ref_frame_index_l0 = -1;
+                candidateArray[canTotalCnt].ref_frame_index_l1 = ref_index;
+            }
+
+            ChooseBestAv1MvPred(
+                context_ptr,
+                candidateArray[canTotalCnt].md_rate_estimation_ptr,
+                context_ptr->cu_ptr,
+                candidateArray[canTotalCnt].ref_frame_type,
+                candidateArray[canTotalCnt].is_compound,
+                candidateArray[canTotalCnt].pred_mode,
+                best_mv_x,
+                best_mv_y,
+                0, 0,
+                &candidateArray[canTotalCnt].drl_index,
+                bestPredmv);
+
+            candidateArray[canTotalCnt].motion_vector_pred_x[list_index] = bestPredmv[0].as_mv.col;
+            candidateArray[canTotalCnt].motion_vector_pred_y[list_index] = bestPredmv[0].as_mv.row;
+
+            INCRMENT_CAND_TOTAL_COUNT(canTotalCnt);
+
+            if (list_index == REF_LIST_0) {
+                context_ptr->injected_mv_x_l0_array[context_ptr->injected_mv_count_l0] = best_mv_x;
+                context_ptr->injected_mv_y_l0_array[context_ptr->injected_mv_count_l0] = best_mv_y;
+                context_ptr->injected_ref_type_l0_array[context_ptr->injected_mv_count_l0] = to_inject_ref_type;
+                ++context_ptr->injected_mv_count_l0;
+            }
+            else {
+                context_ptr->injected_mv_x_l1_array[context_ptr->injected_mv_count_l1] = best_mv_x;
+                context_ptr->injected_mv_y_l1_array[context_ptr->injected_mv_count_l1] = best_mv_y;
+                context_ptr->injected_ref_type_l1_array[context_ptr->injected_mv_count_l1] = to_inject_ref_type;
+                ++context_ptr->injected_mv_count_l1;
+            }
+        }
+    }
+
+    *candidateTotalCnt = canTotalCnt;
+}
+
 #if MD_INJECTION
 void  inject_inter_candidates(
     PictureControlSet            *picture_control_set_ptr,
@@ -2822,6 +2981,13 @@ void  inject_inter_candidates(
             }
         }
 
+    if (inject_newmv_candidate && picture_control_set_ptr->parent_pcs_ptr->sc_content_detected)
+        inject_hash_inter_candidates(
+            picture_control_set_ptr,
+            context_ptr,
+            sequence_control_set_ptr,
+            &canTotalCnt);
+
 // update the total number of candidates injected
 (*candidateTotalCnt) = canTotalCnt;
 
@@ -4315,6 +4481,77 @@ void ProductInitMdCandInjection(
     return;
 }
 #endif
+/***************************************
+* Inter picture wavefront: keeps the inter
+* candidates reading the rows of the wavefront
+* reference the superblock waited for. The
+* NEWMV vectors into it are pulled up to the
+* last of these rows, the other modes signal
+* their vectors implicitly and are dropped.
+* The vectors into the other references, which
+* are complete, are kept.
+***************************************/
+static void limit_inter_candidate_rows(
+    PictureControlSet            *picture_control_set_ptr,
+    ModeDecisionContext          *context_ptr,
+    uint32_t                     *candidateTotalCnt)
+{
+    ModeDecisionCandidate     *candidateArray = context_ptr->fast_candidate_array;
+    const uint8_t              wavefront_mask = picture_control_set_ptr->wavefront_ref_frame_mask;
+    // Rows read below the block by the interpolation filters, the chroma of
+    // the blocks smaller than 8x8 also takes the vectors of the blocks above
+    const int32_t              block_bottom = context_ptr->cu_origin_y + context_ptr->blk_geom->bheight + 2 * AOM_INTERP_EXTEND + 8;
+    const int32_t              mv_y_max = ((int32_t)context_ptr->ref_row_limit - block_bottom) * 8;
+    uint32_t                   canIdx;
+    uint32_t                   keepCnt = context_ptr->fast_candidate_intra_count;
+
+    for (canIdx = context_ptr->fast_candidate_intra_count; canIdx < *candidateTotalCnt; ++canIdx) {
+        ModeDecisionCandidate *candidate_ptr = &candidateArray[canIdx];
+        const EbPredDirection  direction = candidate_ptr->prediction_direction[0];
+        MvReferenceFrame       rf[2];
+        EbBool                 wavefront_l0;
+        EbBool                 wavefront_l1;
+        EbBool                 keep;
+
+        // rf[0] goes with the list 1 vector of the uni-prediction from list 1
+        av1_set_ref_frame(rf, candidate_ptr->ref_frame_type);
+        wavefront_l0 = (EbBool)(direction != UNI_PRED_LIST_1 && ((wavefront_mask >> rf[0]) & 1));
+        wavefront_l1 = (EbBool)(direction == UNI_PRED_LIST_1 ? ((wavefront_mask >> rf[0]) & 1) :
+            direction == BI_PRED && ((wavefront_mask >> rf[1]) & 1));
+
+        if (!wavefront_l0 && !wavefront_l1)
+            keep = EB_TRUE;
+        else if (candidate_ptr->motion_mode == WARPED_CAUSAL)
+            keep = EB_FALSE;
+        else if ((candidate_ptr->pred_mode == GLOBALMV || candidate_ptr->pred_mode == GLOBAL_GLOBALMV) &&
+            ((wavefront_l0 && picture_control_set_ptr->parent_pcs_ptr->global_motion[rf[0]].wmtype > TRANSLATION) ||
+            (wavefront_l1 && picture_control_set_ptr->parent_pcs_ptr->global_motion[direction == BI_PRED ? rf[1] : rf[0]].wmtype > TRANSLATION)))
+            keep = EB_FALSE;
+        else {
+            keep = (EbBool)((!wavefront_l0 || candidate_ptr->motion_vector_yl0 <= mv_y_max) &&
+                (!wavefront_l1 || candidate_ptr->motion_vector_yl1 <= mv_y_max));
+
+            if (!keep && candidate_ptr->pred_mode == NEWMV) {
+                // Full pel, valid whatever the precision of the vectors
+                if (direction == UNI_PRED_LIST_0)
+                    candidate_ptr->motion_vector_yl0 = (int16_t)mv_y_max;
+                else
+                    candidate_ptr->motion_vector_yl1 = (int16_t)mv_y_max;
+                candidate_ptr->distortion_ready = 0;
+                keep = EB_TRUE;
+            }
+        }
+
+        if (keep) {
+            if (keepCnt != canIdx)
+                candidateArray[keepCnt] = *candidate_ptr;
+            ++keepCnt;
+        }
+    }
+
+    *candidateTotalCnt = keepCnt;
+}
+
 /***************************************
 * ProductGenerateMdCandidatesCu
 *   Creates list of initial modes to
@@ -4416,6 +4653,12 @@ EbErrorType ProductGenerateMdCandidatesCu(
                 &canTotalCnt,
                 leaf_index);
 #endif
+
+        if (context_ptr->ref_row_limit != (uint32_t)~0)
+            limit_inter_candidate_rows(
+                picture_control_set_ptr,
+                context_ptr,
+                &canTotalCnt);
     }
     *candidateTotalCountPtr = canTotalCnt;
     return EB_ErrorNone;
@@ -610,6 +610,18 @@ void SetSliceAndPictureChromaQpOffsets(
 
 }
 
+/******************************************************
+* The filter strengths of the wavefront reference are
+* only final once its rows are, so they are not used
+* as a starting point, see inter_picture_wavefront
+******************************************************/
+static EbBool is_wavefront_reference(
+    PictureControlSet                    *picture_control_set_ptr,
+    MvReferenceFrame                      ref_frame)
+{
+    return (EbBool)((picture_control_set_ptr->wavefront_ref_frame_mask >> ref_frame) & 1);
+}
+
 /******************************************************
 * Set the reference sg ep for a given picture
 ******************************************************/
@@ -636,8 +648,8 @@ void set_reference_sg_ep(
         refObjL0 = (EbReferenceObject*)picture_control_set_ptr->ref_pic_ptr_array[REF_LIST_0]->object_ptr;
         refObjL1 = (EbReferenceObject*)picture_control_set_ptr->ref_pic_ptr_array[REF_LIST_1]->object_ptr;
 #endif
-        cm->sg_ref_frame_ep[0] = refObjL0->sg_frame_ep;
-        cm->sg_ref_frame_ep[1] = refObjL1->sg_frame_ep;
+        cm->sg_ref_frame_ep[0] = is_wavefront_reference(picture_control_set_ptr, LAST_FRAME) ? -1 : refObjL0->sg_frame_ep;
+        cm->sg_ref_frame_ep[1] = is_wavefront_reference(picture_control_set_ptr, BWDREF_FRAME) ? -1 : refObjL1->sg_frame_ep;
         break;
     case P_SLICE:
 #if MRP_MD
@@ -645,8 +657,8 @@ void set_reference_sg_ep(
 #else
         refObjL0 = (EbReferenceObject*)picture_control_set_ptr->ref_pic_ptr_array[REF_LIST_0]->object_ptr;
 #endif
-        cm->sg_ref_frame_ep[0] = refObjL0->sg_frame_ep;
-        cm->sg_ref_frame_ep[1] = 0;
+        cm->sg_ref_frame_ep[0] = is_wavefront_reference(picture_control_set_ptr, LAST_FRAME) ? -1 : refObjL0->sg_frame_ep;
+        cm->sg_ref_frame_ep[1] = is_wavefront_reference(picture_control_set_ptr, LAST_FRAME) ? -1 : 0;
         break;
     default:
         printf("SG: Not supported picture type");
@@ -676,9 +688,16 @@ void set_reference_cdef_strength(
         refObjL0 = (EbReferenceObject*)picture_control_set_ptr->ref_pic_ptr_array[REF_LIST_0]->object_ptr;
         refObjL1 = (EbReferenceObject*)picture_control_set_ptr->ref_pic_ptr_array[REF_LIST_1]->object_ptr;
 #endif
-        strength = (refObjL0->cdef_frame_strength + refObjL1->cdef_frame_strength) / 2;
-        picture_control_set_ptr->parent_pcs_ptr->use_ref_frame_cdef_strength = 1;
-        picture_control_set_ptr->parent_pcs_ptr->cdf_ref_frame_strenght = strength;
+        if (is_wavefront_reference(picture_control_set_ptr, LAST_FRAME) && is_wavefront_reference(picture_control_set_ptr, BWDREF_FRAME))
+            strength = -1;
+        else if (is_wavefront_reference(picture_control_set_ptr, LAST_FRAME))
+            strength = refObjL1->cdef_frame_strength;
+        else if (is_wavefront_reference(picture_control_set_ptr, BWDREF_FRAME))
+            strength = refObjL0->cdef_frame_strength;
+        else
+            strength = (refObjL0->cdef_frame_strength + refObjL1->cdef_frame_strength) / 2;
+        picture_control_set_ptr->parent_pcs_ptr->use_ref_frame_cdef_strength = (strength < 0) ? 0 : 1;
+        picture_control_set_ptr->parent_pcs_ptr->cdf_ref_frame_strenght = (strength < 0) ? 0 : strength;
         break;
     case P_SLICE:
 #if MRP_MD
@@ -686,9 +705,9 @@ void set_reference_cdef_strength(
 #else
         refObjL0 = (EbReferenceObject*)picture_control_set_ptr->ref_pic_ptr_array[REF_LIST_0]->object_ptr;
 #endif
-        strength = refObjL0->cdef_frame_strength;
-        picture_control_set_ptr->parent_pcs_ptr->use_ref_frame_cdef_strength = 1;
-        picture_control_set_ptr->parent_pcs_ptr->cdf_ref_frame_strenght = strength;
+        strength = is_wavefront_reference(picture_control_set_ptr, LAST_FRAME) ? -1 : (int32_t)refObjL0->cdef_frame_strength;
+        picture_control_set_ptr->parent_pcs_ptr->use_ref_frame_cdef_strength = (strength < 0) ? 0 : 1;
+        picture_control_set_ptr->parent_pcs_ptr->cdf_ref_frame_strenght = (strength < 0) ? 0 : strength;
         break;
     default:
         printf("CDEF: Not supported picture type");
@@ -2203,6 +2222,86 @@ void forward_all_c_blocks_to_md(
 
     picture_control_set_ptr->parent_pcs_ptr->average_qp = (uint8_t)picture_control_set_ptr->parent_pcs_ptr->picture_qp;
 }
+/******************************************************
+ * Adds the square blocks of the source picture to a
+ * hash table, the crc calculators of the picture
+ * must be set
+ ******************************************************/
+static void generate_source_hash_table(
+    PictureControlSet                  *picture_control_set_ptr,
+    HashTable                          *hash_table)
+{
+    const int pic_width = picture_control_set_ptr->parent_pcs_ptr->sequence_control_set_ptr->luma_width;
+    const int pic_height = picture_control_set_ptr->parent_pcs_ptr->sequence_control_set_ptr->luma_height;
+    uint32_t *block_hash_values[2][2];
+    int8_t *is_block_same[2][3];
+    int k, j;
+
+    for (k = 0; k < 2; k++) {
+        for (j = 0; j < 2; j++) {
+            block_hash_values[k][j] = malloc(sizeof(uint32_t) * pic_width * pic_height);
+        }
+
+        for (j = 0; j < 3; j++) {
+            is_block_same[k][j] = malloc(sizeof(int8_t) * pic_width * pic_height);
+        }
+    }
+
+    Yv12BufferConfig cpi_source;
+    link_Eb_to_aom_buffer_desc_8bit(
+        picture_control_set_ptr->parent_pcs_ptr->enhanced_picture_ptr,
+        &cpi_source);
+
+    av1_generate_block_2x2_hash_value(&cpi_source, block_hash_values[0],
+        is_block_same[0], picture_control_set_ptr);
+    av1_generate_block_hash_value(&cpi_source, 4, block_hash_values[0],
+        block_hash_values[1], is_block_same[0],
+        is_block_same[1], picture_control_set_ptr);
+    av1_add_to_hash_map_by_row_with_precal_data(
+        hash_table, block_hash_values[1], is_block_same[1][2],
+        pic_width, pic_height, 4);
+    av1_generate_block_hash_value(&cpi_source, 8, block_hash_values[1],
+        block_hash_values[0], is_block_same[1],
+        is_block_same[0], picture_control_set_ptr);
+    av1_add_to_hash_map_by_row_with_precal_data(
+        hash_table, block_hash_values[0], is_block_same[0][2],
+        pic_width, pic_height, 8);
+    av1_generate_block_hash_value(&cpi_source, 16, block_hash_values[0],
+        block_hash_values[1], is_block_same[0],
+        is_block_same[1], picture_control_set_ptr);
+    av1_add_to_hash_map_by_row_with_precal_data(
+        hash_table, block_hash_values[1], is_block_same[1][2],
+        pic_width, pic_height, 16);
+    av1_generate_block_hash_value(&cpi_source, 32, block_hash_values[1],
+        block_hash_values[0], is_block_same[1],
+        is_block_same[0], picture_control_set_ptr);
+    av1_add_to_hash_map_by_row_with_precal_data(
+        hash_table, block_hash_values[0], is_block_same[0][2],
+        pic_width, pic_height, 32);
+    av1_generate_block_hash_value(&cpi_source, 64, block_hash_values[0],
+        block_hash_values[1], is_block_same[0],
+        is_block_same[1], picture_control_set_ptr);
+    av1_add_to_hash_map_by_row_with_precal_data(
+        hash_table, block_hash_values[1], is_block_same[1][2],
+        pic_width, pic_height, 64);
+    av1_generate_block_hash_value(&cpi_source, 128, block_hash_values[1],
+        block_hash_values[0], is_block_same[1],
+        is_block_same[0], picture_control_set_ptr);
+    av1_add_to_hash_map_by_row_with_precal_data(
+        hash_table, block_hash_values[0], is_block_same[0][2],
+        pic_width, pic_height, 128);
+
+    for (k = 0; k < 2; k++) {
+        for (j = 0; j < 2; j++) {
+            free(block_hash_values[k][j]);
+        }
+
+        for (j = 0; j < 3; j++) {
+            free(is_block_same[k][j]);
+        }
+    }
+}
+
 /******************************************************
  * Mode Decision Configuration Kernel
  ******************************************************/
@@ -2492,87 +2591,33 @@ void* mode_decision_configuration_kernel(void *input_ptr)
                 sf->max_exaustive_pct = intrabc_max_mesh_pct[mesh_speed];
             }
 
-            {
-                // add to hash table
-                const int pic_width = picture_control_set_ptr->parent_pcs_ptr->sequence_control_set_ptr->luma_width;
-                const int pic_height = picture_control_set_ptr->parent_pcs_ptr->sequence_control_set_ptr->luma_height;
-                uint32_t *block_hash_values[2][2];
-                int8_t *is_block_same[2][3];
-                int k, j;
-
-                for (k = 0; k < 2; k++) {
-                    for (j = 0; j < 2; j++) {
-                        block_hash_values[k][j] = malloc(sizeof(uint32_t) * pic_width * pic_height);
-                    }
+            av1_crc_calculator_init(&picture_control_set_ptr->crc_calculator1, 24, 0x5D6DCB);
+            av1_crc_calculator_init(&picture_control_set_ptr->crc_calculator2, 24, 0x864CFB);
+            generate_source_hash_table(
+                picture_control_set_ptr,
+                &picture_control_set_ptr->hash_table);
 
-                    for (j = 0; j < 3; j++) {
-                        is_block_same[k][j] = malloc(sizeof(int8_t) * pic_width * pic_height);
-                    }
-                }
+            av1_init3smotion_compensation(&picture_control_set_ptr->ss_cfg, picture_control_set_ptr->parent_pcs_ptr->enhanced_picture_ptr->stride_y);
+        }
 
-                //picture_control_set_ptr->hash_table.p_lookup_table = NULL;
-                //av1_hash_table_create(&picture_control_set_ptr->hash_table);
-
-                Yv12BufferConfig cpi_source;
-                link_Eb_to_aom_buffer_desc_8bit(
-                    picture_control_set_ptr->parent_pcs_ptr->enhanced_picture_ptr,
-                    &cpi_source);
-
-                av1_crc_calculator_init(&picture_control_set_ptr->crc_calculator1, 24, 0x5D6DCB);
-                av1_crc_calculator_init(&picture_control_set_ptr->crc_calculator2, 24, 0x864CFB);
-
-                av1_generate_block_2x2_hash_value(&cpi_source, block_hash_values[0],
-                    is_block_same[0], picture_control_set_ptr);
-                av1_generate_block_hash_value(&cpi_source, 4, block_hash_values[0],
-                    block_hash_values[1], is_block_same[0],
-                    is_block_same[1], picture_control_set_ptr);
-                av1_add_to_hash_map_by_row_with_precal_data(
-                    &picture_control_set_ptr->hash_table, block_hash_values[1], is_block_same[1][2],
-                    pic_width, pic_height, 4);
-                av1_generate_block_hash_value(&cpi_source, 8, block_hash_values[1],
-                    block_hash_values[0], is_block_same[1],
-                    is_block_same[0], picture_control_set_ptr);
-                av1_add_to_hash_map_by_row_with_precal_data(
-                    &picture_control_set_ptr->hash_table, block_hash_values[0], is_block_same[0][2],
-                    pic_width, pic_height, 8);
-                av1_generate_block_hash_value(&cpi_source, 16, block_hash_values[0],
-                    block_hash_values[1], is_block_same[0],
-                    is_block_same[1], picture_control_set_ptr);
-                av1_add_to_hash_map_by_row_with_precal_data(
-                    &picture_control_set_ptr->hash_table, block_hash_values[1], is_block_same[1][2],
-                    pic_width, pic_height, 16);
-                av1_generate_block_hash_value(&cpi_source, 32, block_hash_values[1],
-                    block_hash_values[0], is_block_same[1],
-                    is_block_same[0], picture_control_set_ptr);
-                av1_add_to_hash_map_by_row_with_precal_data(
-                    &picture_control_set_ptr->hash_table, block_hash_values[0], is_block_same[0][2],
-                    pic_width, pic_height, 32);
-                av1_generate_block_hash_value(&cpi_source, 64, block_hash_values[0],
-                    block_hash_values[1], is_block_same[0],
-                    is_block_same[1], picture_control_set_ptr);
-                av1_add_to_hash_map_by_row_with_precal_data(
-                    &picture_control_set_ptr->hash_table, block_hash_values[1], is_block_same[1][2],
-                    pic_width, pic_height, 64);
-
-                av1_generate_block_hash_value(&cpi_source, 128, block_hash_values[1],
-                    block_hash_values[0], is_block_same[1],
-                    is_block_same[0], picture_control_set_ptr);
-                av1_add_to_hash_map_by_row_with_precal_data(
-                    &picture_control_set_ptr->hash_table, block_hash_values[0], is_block_same[0][2],
-                    pic_width, pic_height, 128);
-
-                for (k = 0; k < 2; k++) {
-                    for (j = 0; j < 2; j++) {
-                        free(block_hash_values[k][j]);
-                    }
+        // Screen content: the inter pictures look their source blocks up in the hash
+        // tables of the references, which are kept with the reconstructed pictures
+        if (picture_control_set_ptr->parent_pcs_ptr->sc_content_detected && !picture_control_set_ptr->parent_pcs_ptr->allow_intrabc) {
+            av1_crc_calculator_init(&picture_control_set_ptr->crc_calculator1, 24, 0x5D6DCB);
+            av1_crc_calculator_init(&picture_control_set_ptr->crc_calculator2, 24, 0x864CFB);
+        }
+        if (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag) {
+            EbReferenceObject *reference_object = (EbReferenceObject*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr;
 
-                    for (j = 0; j < 3; j++) {
-                        free(is_block_same[k][j]);
-                    }
-                }
+            // The reference objects are recycled, the table of a previous picture is dropped
+            reference_object->hash_table_valid = EB_FALSE;
+            if (reference_object->hash_table.p_lookup_table != NULL && picture_control_set_ptr->parent_pcs_ptr->sc_content_detected) {
+                av1_hash_table_create(&reference_object->hash_table);
+                generate_source_hash_table(
+                    picture_control_set_ptr,
+                    &reference_object->hash_table);
+                reference_object->hash_table_valid = EB_TRUE;
             }
-
-            av1_init3smotion_compensation(&picture_control_set_ptr->ss_cfg, picture_control_set_ptr->parent_pcs_ptr->enhanced_picture_ptr->stride_y);
         }
 
         // Derive MD parameters
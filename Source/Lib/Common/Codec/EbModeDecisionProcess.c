@@ -17,7 +17,8 @@ EbErrorType mode_decision_context_ctor(
     ModeDecisionContext  **context_dbl_ptr,
     EbColorFormat         color_format,
     EbFifo                *mode_decision_configuration_input_fifo_ptr,
-    EbFifo                *mode_decision_output_fifo_ptr){
+    EbFifo                *mode_decision_output_fifo_ptr,
+    uint32_t               max_block_count){
 
     uint32_t bufferIndex;
     uint32_t candidateIndex;
@@ -32,6 +33,7 @@ EbErrorType mode_decision_context_ctor(
     // Input/Output System Resource Manager FIFOs
     context_ptr->mode_decision_configuration_input_fifo_ptr = mode_decision_configuration_input_fifo_ptr;
     context_ptr->mode_decision_output_fifo_ptr = mode_decision_output_fifo_ptr;
+    context_ptr->ref_row_limit = (uint32_t)~0;
 
     // Trasform Scratch Memory
     EB_MALLOC(int16_t*, context_ptr->transform_inner_array_ptr, 3120, EB_N_PTR); //refer to EbInvTransform_SSE2.as. case 32x32
@@ -99,7 +101,12 @@ EbErrorType mode_decision_context_ctor(
     }
     uint32_t codedLeafIndex, tu_index;
 
-    for (codedLeafIndex = 0; codedLeafIndex < BLOCK_MAX_COUNT_SB_128; ++codedLeafIndex) {
+    // Per-block arrays, sized for the SB size in use (BLOCK_MAX_COUNT_SB_64 or BLOCK_MAX_COUNT_SB_128)
+    EB_MALLOC(MdCodingUnit*, context_ptr->md_local_cu_unit, sizeof(MdCodingUnit) * max_block_count, EB_N_PTR);
+    EB_MALLOC(CodingUnit*, context_ptr->md_cu_arr_nsq, sizeof(CodingUnit) * max_block_count, EB_N_PTR);
+    EB_MALLOC(MdEncPassCuData*, context_ptr->md_ep_pipe_sb, sizeof(MdEncPassCuData) * max_block_count, EB_N_PTR);
+
+    for (codedLeafIndex = 0; codedLeafIndex < max_block_count; ++codedLeafIndex) {
 
         for (tu_index = 0; tu_index < TRANSFORM_UNIT_MAX_COUNT; ++tu_index) {
             context_ptr->md_cu_arr_nsq[codedLeafIndex].transform_unit_array[tu_index].tu_index = tu_index;
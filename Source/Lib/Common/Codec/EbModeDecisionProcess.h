@@ -102,8 +102,8 @@ extern "C" {
         ModeDecisionCandidateBuffer **candidate_buffer_ptr_array;
         MdRateEstimationContext      *md_rate_estimation_ptr;
         InterPredictionContext       *inter_prediction_context;
-        MdCodingUnit                  md_local_cu_unit[BLOCK_MAX_COUNT_SB_128];
-        CodingUnit                    md_cu_arr_nsq[BLOCK_MAX_COUNT_SB_128];
+        MdCodingUnit                 *md_local_cu_unit;    // max_block_count entries
+        CodingUnit                   *md_cu_arr_nsq;       // max_block_count entries
 
         NeighborArrayUnit            *intra_luma_mode_neighbor_array;
         NeighborArrayUnit            *intra_chroma_mode_neighbor_array;
@@ -163,7 +163,7 @@ extern "C" {
 
         // Entropy Coder
         EntropyCoder                 *coeff_est_entropy_coder_ptr;
-        MdEncPassCuData               md_ep_pipe_sb[BLOCK_MAX_COUNT_SB_128];
+        MdEncPassCuData              *md_ep_pipe_sb;       // max_block_count entries
 #if !OPT_LOSSLESS_0
         uint8_t                         group_of8x8_blocks_count;
         uint8_t                         group_of16x16_blocks_count;
@@ -180,6 +180,9 @@ extern "C" {
         uint8_t                         sb_sz;
         uint32_t                        sb_origin_x;
         uint32_t                        sb_origin_y;
+        // Luma rows of the references the superblock may read, ~0 when all
+        // of them, see inter_picture_wavefront
+        uint32_t                        ref_row_limit;
         uint32_t                        round_origin_x;
         uint32_t                        round_origin_y;
         uint16_t                        pu_origin_x;
@@ -298,7 +301,8 @@ extern "C" {
         ModeDecisionContext      **context_dbl_ptr,
         EbColorFormat              color_format,
         EbFifo                    *mode_decision_configuration_input_fifo_ptr,
-        EbFifo                    *mode_decision_output_fifo_ptr);
+        EbFifo                    *mode_decision_output_fifo_ptr,
+        uint32_t                   max_block_count);
 
     extern void reset_mode_decision_neighbor_arrays(
         PictureControlSet *picture_control_set_ptr);
@@ -9316,7 +9316,7 @@ EbErrorType motion_estimate_lcu(
 
     }
 
-    if (sequence_control_set_ptr->static_config.rate_control_mode) {
+    if (sequence_control_set_ptr->static_config.rate_control_mode || sequence_control_set_ptr->static_config.pass == 1) {
 
         // Compute the sum of the distortion of all 16 16x16 (best) blocks in the LCU
         picture_control_set_ptr->rc_me_distortion[sb_index] = 0;
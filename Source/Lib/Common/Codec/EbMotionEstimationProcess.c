@@ -260,6 +260,9 @@ EbErrorType signal_derivation_me_kernel_oq(
     else {
         context_ptr->me_context_ptr->fractional_search_model = 2;
     }
+    // The first pass statistics use the integer search only
+    if (sequence_control_set_ptr->static_config.pass == 1)
+        context_ptr->me_context_ptr->fractional_search_model = 2;
 #endif
 
 
@@ -35,6 +35,8 @@ EbErrorType neighbor_array_unit_ctor32(
     na_unit_ptr->left_array_size = (uint16_t)((type_mask & NEIGHBOR_ARRAY_UNIT_LEFT_MASK) ? max_picture_height >> na_unit_ptr->granularity_normal_log2 : 0);
     na_unit_ptr->top_array_size = (uint16_t)((type_mask & NEIGHBOR_ARRAY_UNIT_TOP_MASK) ? max_picture_width >> na_unit_ptr->granularity_normal_log2 : 0);
     na_unit_ptr->top_left_array_size = (uint16_t)((type_mask & NEIGHBOR_ARRAY_UNIT_TOPLEFT_MASK) ? (max_picture_width + max_picture_height) >> na_unit_ptr->granularity_top_left_log2 : 0);
+    na_unit_ptr->origin_x = 0;
+    na_unit_ptr->origin_y = 0;
 
     if (na_unit_ptr->left_array_size) {
         EB_MALLOC(uint32_t*, na_unit_ptr->left_array, na_unit_ptr->unit_size * na_unit_ptr->left_array_size, EB_N_PTR);
@@ -81,6 +83,8 @@ EbErrorType neighbor_array_unit_ctor(
     na_unit_ptr->left_array_size = (uint16_t)((type_mask & NEIGHBOR_ARRAY_UNIT_LEFT_MASK) ? max_picture_height >> na_unit_ptr->granularity_normal_log2 : 0);
     na_unit_ptr->top_array_size = (uint16_t)((type_mask & NEIGHBOR_ARRAY_UNIT_TOP_MASK) ? max_picture_width >> na_unit_ptr->granularity_normal_log2 : 0);
     na_unit_ptr->top_left_array_size = (uint16_t)((type_mask & NEIGHBOR_ARRAY_UNIT_TOPLEFT_MASK) ? (max_picture_width + max_picture_height) >> na_unit_ptr->granularity_top_left_log2 : 0);
+    na_unit_ptr->origin_x = 0;
+    na_unit_ptr->origin_y = 0;
 
     if (na_unit_ptr->left_array_size) {
         EB_MALLOC(uint8_t*, na_unit_ptr->left_array, na_unit_ptr->unit_size * na_unit_ptr->left_array_size, EB_N_PTR);
@@ -153,7 +157,7 @@ uint32_t GetNeighborArrayUnitTopLeftIndex32(
     int32_t               loc_x,
     int32_t               loc_y)
 {
-    return na_unit_ptr->left_array_size + (loc_x >> na_unit_ptr->granularity_top_left_log2) - (loc_y >> na_unit_ptr->granularity_top_left_log2);
+    return na_unit_ptr->left_array_size + ((loc_x - na_unit_ptr->origin_x) >> na_unit_ptr->granularity_top_left_log2) - ((loc_y - na_unit_ptr->origin_y) >> na_unit_ptr->granularity_top_left_log2);
 }
 
 uint32_t get_neighbor_array_unit_top_left_index(
@@ -161,7 +165,7 @@ uint32_t get_neighbor_array_unit_top_left_index(
     int32_t               loc_x,
     int32_t               loc_y)
 {
-    return na_unit_ptr->left_array_size + (loc_x >> na_unit_ptr->granularity_top_left_log2) - (loc_y >> na_unit_ptr->granularity_top_left_log2);
+    return na_unit_ptr->left_array_size + ((loc_x - na_unit_ptr->origin_x) >> na_unit_ptr->granularity_top_left_log2) - ((loc_y - na_unit_ptr->origin_y) >> na_unit_ptr->granularity_top_left_log2);
 }
 
 void update_recon_neighbor_array(
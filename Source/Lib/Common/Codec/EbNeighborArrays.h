@@ -42,6 +42,8 @@ extern "C" {
         uint16_t   left_array_size;
         uint16_t   top_array_size;
         uint16_t   top_left_array_size;
+        uint16_t   origin_x;                    // position of the first unit, non zero for
+        uint16_t   origin_y;                    // the arrays covering a tile of the picture
         uint8_t    unit_size;
         uint8_t    granularity_normal;
         uint8_t    granularity_normal_log2;
@@ -58,6 +60,8 @@ extern "C" {
         uint16_t   left_array_size;
         uint16_t   top_array_size;
         uint16_t   top_left_array_size;
+        uint16_t   origin_x;                    // position of the first unit, non zero for
+        uint16_t   origin_y;                    // the arrays covering a tile of the picture
         uint8_t    unit_size;
         uint8_t    granularity_normal;
         uint8_t    granularity_normal_log2;
@@ -97,14 +101,14 @@ extern "C" {
         NeighborArrayUnit32 *na_unit_ptr,
         uint32_t               loc_y)
     {
-        return (loc_y >> na_unit_ptr->granularity_normal_log2);
+        return ((loc_y - na_unit_ptr->origin_y) >> na_unit_ptr->granularity_normal_log2);
     }
 
     static INLINE uint32_t get_neighbor_array_unit_left_index(
         NeighborArrayUnit *na_unit_ptr,
         uint32_t               loc_y)
     {
-        return (loc_y >> na_unit_ptr->granularity_normal_log2);
+        return ((loc_y - na_unit_ptr->origin_y) >> na_unit_ptr->granularity_normal_log2);
     }
 
     /*************************************************
@@ -114,14 +118,14 @@ extern "C" {
         NeighborArrayUnit32 *na_unit_ptr,
         uint32_t               loc_x)
     {
-        return (loc_x >> na_unit_ptr->granularity_normal_log2);
+        return ((loc_x - na_unit_ptr->origin_x) >> na_unit_ptr->granularity_normal_log2);
     }
 
     static INLINE uint32_t get_neighbor_array_unit_top_index(
         NeighborArrayUnit *na_unit_ptr,
         uint32_t               loc_x)
     {
-        return (loc_x >> na_unit_ptr->granularity_normal_log2);
+        return ((loc_x - na_unit_ptr->origin_x) >> na_unit_ptr->granularity_normal_log2);
     }
 
     extern uint32_t get_neighbor_array_unit_top_left_index(
@@ -14,6 +14,7 @@
 #include "EbEntropyCoding.h"
 #include "EbRateControlTasks.h"
 #include "EbSvtAv1Time.h"
+#include "EbPipelineStats.h"
 #if RC
 #include "EbModeDecisionProcess.h"
 #endif
@@ -87,6 +88,134 @@ static void write_td (
                   TD_SIZE);
     }
 }
+
+/**************************************
+ * Outputs the coded tiles of the picture
+ * at the head of the reorder queue, one
+ * OBU_TILE_GROUP per call, the frame
+ * header (and TD, sequence header) with
+ * the first one. The last tile is left
+ * to the packet that completes the
+ * picture. Called with
+ * tile_group_output_mutex held.
+ **************************************/
+static void output_tile_group(
+    EncodeContext                *encode_context_ptr)
+{
+    PacketizationReorderEntry    *queue_entry_ptr = encode_context_ptr->packetization_reorder_queue[encode_context_ptr->packetization_reorder_queue_head_index];
+    PictureControlSet            *picture_control_set_ptr = queue_entry_ptr->fragment_pcs_ptr;
+    SequenceControlSet           *sequence_control_set_ptr;
+    EbObjectWrapper              *output_stream_wrapper_ptr;
+    EbBufferHeaderType           *output_stream_ptr;
+    uint16_t                      tile_cnt;
+    uint16_t                      start_tile;
+    uint16_t                      end_tile;
+    uint32_t                      td_size = 0;
+
+    if (picture_control_set_ptr == EB_NULL)
+        return;
+
+    tile_cnt = (uint16_t)(picture_control_set_ptr->parent_pcs_ptr->av1_cm->tile_rows * picture_control_set_ptr->parent_pcs_ptr->av1_cm->tile_cols);
+    start_tile = queue_entry_ptr->fragment_tile_count;
+    end_tile = start_tile;
+    while (end_tile + 1 < tile_cnt && picture_control_set_ptr->entropy_coding_info[end_tile]->tile_coded)
+        ++end_tile;
+    if (end_tile == start_tile)
+        return;
+
+    // Without a free output buffer the tiles go with a later packet
+    eb_get_empty_object_non_blocking(
+        encode_context_ptr->fragment_output_fifo_ptr,
+        &output_stream_wrapper_ptr);
+    if (output_stream_wrapper_ptr == EB_NULL)
+        return;
+
+    sequence_control_set_ptr = (SequenceControlSet*)picture_control_set_ptr->sequence_control_set_wrapper_ptr->object_ptr;
+    output_stream_ptr = (EbBufferHeaderType*)output_stream_wrapper_ptr->object_ptr;
+    output_stream_ptr->flags = 0;
+    output_stream_ptr->n_filled_len = 0;
+
+    if (start_tile == 0 && encode_context_ptr->td_needed == EB_TRUE) {
+        output_stream_ptr->flags |= (uint32_t)EB_BUFFERFLAG_HAS_TD;
+        encode_td_av1(output_stream_ptr->p_buffer);
+        encode_context_ptr->td_needed = EB_FALSE;
+        output_stream_ptr->n_filled_len = td_size = TD_SIZE;
+    }
+
+    reset_bitstream(
+        picture_control_set_ptr->bitstream_ptr->output_bitstream_ptr);
+
+    if (start_tile == 0) {
+        if (picture_control_set_ptr->parent_pcs_ptr->av1_frame_type == KEY_FRAME) {
+            encode_sps_av1(
+                picture_control_set_ptr->bitstream_ptr,
+                sequence_control_set_ptr);
+        }
+        write_frame_header_obu_av1(
+            picture_control_set_ptr->bitstream_ptr,
+            sequence_control_set_ptr,
+            picture_control_set_ptr);
+    }
+
+    write_tile_group_obu_av1(
+        picture_control_set_ptr->bitstream_ptr,
+        picture_control_set_ptr,
+        start_tile,
+        end_tile - 1);
+
+    copy_rbsp_bitstream_to_payload(
+        picture_control_set_ptr->bitstream_ptr,
+        output_stream_ptr->p_buffer,
+        (uint32_t*)&(output_stream_ptr->n_filled_len),
+        (uint32_t*)&(output_stream_ptr->n_alloc_len),
+        encode_context_ptr);
+
+    output_stream_ptr->pts = picture_control_set_ptr->parent_pcs_ptr->input_ptr->pts;
+    output_stream_ptr->dts = picture_control_set_ptr->parent_pcs_ptr->decode_order - (uint64_t)(1 << picture_control_set_ptr->parent_pcs_ptr->hierarchical_levels) + 1;
+    output_stream_ptr->pic_type = picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag ?
+        picture_control_set_ptr->parent_pcs_ptr->idr_flag ? EB_AV1_KEY_PICTURE :
+        picture_control_set_ptr->slice_type : EB_AV1_NON_REF_PICTURE;
+    output_stream_ptr->p_app_private = EB_NULL;
+
+    // Latency of the tile group in milliseconds
+    {
+        double latency = 0.0;
+        uint64_t finishTimeSeconds = 0;
+        uint64_t finishTimeuSeconds = 0;
+        EbFinishTime(&finishTimeSeconds, &finishTimeuSeconds);
+
+        EbComputeOverallElapsedTimeMs(
+            picture_control_set_ptr->parent_pcs_ptr->start_time_seconds,
+            picture_control_set_ptr->parent_pcs_ptr->start_time_u_seconds,
+            finishTimeSeconds,
+            finishTimeuSeconds,
+            &latency);
+        output_stream_ptr->n_tick_count = (uint32_t)latency;
+    }
+
+    queue_entry_ptr->fragment_tile_count = end_tile;
+    queue_entry_ptr->fragment_byte_count += output_stream_ptr->n_filled_len - td_size;
+    eb_post_full_object(output_stream_wrapper_ptr);
+}
+
+/**************************************
+ * packetization_tile_done
+ **************************************/
+void packetization_tile_done(
+    PictureControlSet            *picture_control_set_ptr,
+    uint16_t                      tile_idx)
+{
+    SequenceControlSet           *sequence_control_set_ptr = (SequenceControlSet*)picture_control_set_ptr->sequence_control_set_wrapper_ptr->object_ptr;
+    EncodeContext                *encode_context_ptr = sequence_control_set_ptr->encode_context_ptr;
+    PacketizationReorderEntry    *queue_entry_ptr = encode_context_ptr->packetization_reorder_queue[picture_control_set_ptr->parent_pcs_ptr->decode_order % PACKETIZATION_REORDER_QUEUE_MAX_DEPTH];
+
+    eb_block_on_mutex(encode_context_ptr->tile_group_output_mutex);
+    picture_control_set_ptr->entropy_coding_info[tile_idx]->tile_coded = EB_TRUE;
+    queue_entry_ptr->fragment_pcs_ptr = picture_control_set_ptr;
+    output_tile_group(encode_context_ptr);
+    eb_release_mutex(encode_context_ptr->tile_group_output_mutex);
+}
+
 #if  RC
 
 void update_rc_rate_tables(
@@ -267,6 +396,8 @@ void* packetization_kernel(void *input_ptr)
     int32_t                         queueEntryIndex;
     PacketizationReorderEntry    *queueEntryPtr;
     EbLinkedListNode               *appDataLLHeadTempPtr;
+    uint16_t                        fragment_tile_count;
+    uint32_t                        fragment_byte_count;
 
     context_ptr->tot_shown_frames = 0;
     context_ptr->disp_order_continuity_count = 0;
@@ -306,6 +437,20 @@ void* packetization_kernel(void *input_ptr)
             picture_control_set_ptr->slice_type : EB_AV1_NON_REF_PICTURE;
         output_stream_ptr->p_app_private = picture_control_set_ptr->parent_pcs_ptr->input_ptr->p_app_private;
 
+        // Tiles already output as tile groups, none can be output from now on
+        if (sequence_control_set_ptr->static_config.tile_group_output) {
+            output_stream_ptr->flags |= EB_BUFFERFLAG_LAST_FRAGMENT;
+            eb_block_on_mutex(encode_context_ptr->tile_group_output_mutex);
+            queueEntryPtr->fragment_pcs_ptr = (PictureControlSet*)EB_NULL;
+            fragment_tile_count = queueEntryPtr->fragment_tile_count;
+            fragment_byte_count = queueEntryPtr->fragment_byte_count;
+            eb_release_mutex(encode_context_ptr->tile_group_output_mutex);
+        }
+        else {
+            fragment_tile_count = 0;
+            fragment_byte_count = 0;
+        }
+
         // Get Empty Rate Control Input Tasks
         eb_get_empty_object(
             context_ptr->rate_control_tasks_output_fifo_ptr,
@@ -319,18 +464,28 @@ void* packetization_kernel(void *input_ptr)
         reset_bitstream(
             picture_control_set_ptr->bitstream_ptr->output_bitstream_ptr);
 
-        // Code the SPS
-        if (picture_control_set_ptr->parent_pcs_ptr->av1_frame_type == KEY_FRAME) {
-            encode_sps_av1(
+        if (fragment_tile_count) {
+            // The remaining tiles, the frame header went with the first tile group
+            write_tile_group_obu_av1(
                 picture_control_set_ptr->bitstream_ptr,
-                sequence_control_set_ptr);
+                picture_control_set_ptr,
+                fragment_tile_count,
+                (uint16_t)(picture_control_set_ptr->parent_pcs_ptr->av1_cm->tile_rows * picture_control_set_ptr->parent_pcs_ptr->av1_cm->tile_cols - 1));
         }
+        else {
+            // Code the SPS
+            if (picture_control_set_ptr->parent_pcs_ptr->av1_frame_type == KEY_FRAME) {
+                encode_sps_av1(
+                    picture_control_set_ptr->bitstream_ptr,
+                    sequence_control_set_ptr);
+            }
 
-        write_frame_header_av1(
-            picture_control_set_ptr->bitstream_ptr,
-            sequence_control_set_ptr,
-            picture_control_set_ptr,
-            0);
+            write_frame_header_av1(
+                picture_control_set_ptr->bitstream_ptr,
+                sequence_control_set_ptr,
+                picture_control_set_ptr,
+                0);
+        }
 
         // Copy Slice Header to the Output Bitstream
         copy_rbsp_bitstream_to_payload(
@@ -362,7 +517,7 @@ void* packetization_kernel(void *input_ptr)
         }
 
         // Send the number of bytes per frame to RC
-        picture_control_set_ptr->parent_pcs_ptr->total_num_bits = output_stream_ptr->n_filled_len << 3;
+        picture_control_set_ptr->parent_pcs_ptr->total_num_bits = (uint64_t)(output_stream_ptr->n_filled_len + fragment_byte_count) << 3;
 #if  RC
         queueEntryPtr->total_num_bits = picture_control_set_ptr->parent_pcs_ptr->total_num_bits;
         // update the rate tables used in RC based on the encoded bits of each sb
@@ -432,6 +587,7 @@ void* packetization_kernel(void *input_ptr)
         // Process the head of the queue
         //****************************************************
         // Look at head of queue and see if any picture is ready to go
+        eb_block_on_mutex(encode_context_ptr->tile_group_output_mutex);
         queueEntryPtr = encode_context_ptr->packetization_reorder_queue[encode_context_ptr->packetization_reorder_queue_head_index];
 
         while (queueEntryPtr->output_stream_wrapper_ptr != EB_NULL) {
@@ -593,6 +749,8 @@ void* packetization_kernel(void *input_ptr)
                 &latency);
 
             output_stream_ptr->n_tick_count = (uint32_t)latency;
+            if (encode_context_ptr->pipeline_stats_ptr)
+                eb_pipeline_stats_picture_done(encode_context_ptr->pipeline_stats_ptr, (uint64_t)(latency * 1000));
             output_stream_ptr->p_app_private = queueEntryPtr->out_meta_data;
             eb_post_full_object(output_stream_wrapper_ptr);
             queueEntryPtr->out_meta_data = (EbLinkedListNode *)EB_NULL;
@@ -600,6 +758,8 @@ void* packetization_kernel(void *input_ptr)
             // Reset the Reorder Queue Entry
             queueEntryPtr->picture_number += PACKETIZATION_REORDER_QUEUE_MAX_DEPTH;
             queueEntryPtr->output_stream_wrapper_ptr = (EbObjectWrapper *)EB_NULL;
+            queueEntryPtr->fragment_tile_count = 0;
+            queueEntryPtr->fragment_byte_count = 0;
 
             if (encode_context_ptr->statistics_port_active) {
                 queueEntryPtr->outputStatisticsWrapperPtr = (EbObjectWrapper *)EB_NULL;
@@ -612,6 +772,11 @@ void* packetization_kernel(void *input_ptr)
 
         }
 
+        // The new head may have tiles coded already
+        if (sequence_control_set_ptr->static_config.tile_group_output)
+            output_tile_group(encode_context_ptr);
+        eb_release_mutex(encode_context_ptr->tile_group_output_mutex);
+
     }
     return EB_NULL;
 }
@@ -8,6 +8,7 @@
 
 #include "EbDefinitions.h"
 #include "EbSystemResourceManager.h"
+#include "EbPictureControlSet.h"
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -46,6 +47,12 @@ extern "C" {
 
 
 
+    // Tile group output: called by Entropy Coding once a tile is coded,
+    // before the picture goes to Packetization
+    extern void packetization_tile_done(
+        PictureControlSet     *picture_control_set_ptr,
+        uint16_t               tile_idx);
+
     extern void* packetization_kernel(void *input_ptr);
 #ifdef __cplusplus
 }
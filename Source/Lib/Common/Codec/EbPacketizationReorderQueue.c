@@ -16,6 +16,9 @@ EbErrorType packetization_reorder_entry_ctor(
     (*entry_dbl_ptr)->output_stream_wrapper_ptr = (EbObjectWrapper *)EB_NULL;
     (*entry_dbl_ptr)->outputStatisticsWrapperPtr = (EbObjectWrapper *)EB_NULL;
     (*entry_dbl_ptr)->out_meta_data = (EbLinkedListNode*)EB_NULL;
+    (*entry_dbl_ptr)->fragment_pcs_ptr = (struct PictureControlSet*)EB_NULL;
+    (*entry_dbl_ptr)->fragment_tile_count = 0;
+    (*entry_dbl_ptr)->fragment_byte_count = 0;
 
     return EB_ErrorNone;
 }
@@ -43,6 +43,11 @@ extern "C" {
         EbBool                               has_show_existing;
         uint8_t                                 show_existing_loc;
 
+        // Tile group output, the picture at the head of the queue outputs its
+        // tiles as they are coded
+        struct PictureControlSet            *fragment_pcs_ptr;      // NULL once Packetization has the picture
+        uint16_t                             fragment_tile_count;   // tiles already output
+        uint32_t                             fragment_byte_count;   // bytes already output, TDs excluded
 
     } PacketizationReorderEntry;
 
@@ -0,0 +1,246 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#include <math.h>
+#include <string.h>
+
+#include "EbPassStats.h"
+#include "EbEncodeContext.h"
+#include "EbRateControlProcess.h"
+
+static void put_le16(uint8_t *buffer, uint32_t value)
+{
+    buffer[0] = (uint8_t)value;
+    buffer[1] = (uint8_t)(value >> 8);
+}
+
+static void put_le32(uint8_t *buffer, uint32_t value)
+{
+    put_le16(buffer, value);
+    put_le16(buffer + 2, value >> 16);
+}
+
+static void put_le64(uint8_t *buffer, uint64_t value)
+{
+    put_le32(buffer, (uint32_t)value);
+    put_le32(buffer + 4, (uint32_t)(value >> 32));
+}
+
+static uint32_t get_le16(const uint8_t *buffer)
+{
+    return (uint32_t)buffer[0] | ((uint32_t)buffer[1] << 8);
+}
+
+static uint32_t get_le32(const uint8_t *buffer)
+{
+    return get_le16(buffer) | (get_le16(buffer + 2) << 16);
+}
+
+static uint64_t get_le64(const uint8_t *buffer)
+{
+    return (uint64_t)get_le32(buffer) | ((uint64_t)get_le32(buffer + 4) << 32);
+}
+
+static uint32_t integer_sqrt(uint32_t value)
+{
+    uint32_t root = 0;
+    uint32_t bit = 1u << 30;
+
+    while (bit > value)
+        bit >>= 2;
+    while (bit) {
+        if (value >= root + bit) {
+            value -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else
+            root >>= 1;
+        bit >>= 2;
+    }
+    return root;
+}
+
+/**************************************
+ * eb_pass_stats_record_size
+ **************************************/
+uint32_t eb_pass_stats_record_size(
+    uint32_t                  sb_count)
+{
+    return PASS_STATS_HEADER_SIZE + sb_count * PASS_STATS_SB_SIZE;
+}
+
+/**************************************
+ * Writes the record of a picture, only
+ * from source based data so that the
+ * output does not depend on threading
+ **************************************/
+static void write_first_pass_record(
+    PictureParentControlSet  *picture_control_set_ptr,
+    uint8_t                  *buffer)
+{
+    const uint32_t sb_count = picture_control_set_ptr->sb_total_count;
+    uint64_t       intra_cost = 0;
+    uint64_t       inter_cost = 0;
+    uint32_t       sb_index;
+
+    for (sb_index = 0; sb_index < sb_count; ++sb_index) {
+        uint8_t *sb_buffer = buffer + PASS_STATS_HEADER_SIZE + sb_index * PASS_STATS_SB_SIZE;
+        uint32_t sb_intra_cost = MIN(integer_sqrt((uint32_t)picture_control_set_ptr->variance[sb_index][RASTER_SCAN_CU_INDEX_64x64] << 8), 0xFFFF);
+        uint32_t sb_inter_cost = sb_intra_cost;
+
+        // rc_me_distortion is the SAD of the 64x64 block
+        if (picture_control_set_ptr->slice_type != I_SLICE)
+            sb_inter_cost = MIN(picture_control_set_ptr->rc_me_distortion[sb_index] >> 8, 0xFFFF);
+
+        put_le16(sb_buffer, sb_intra_cost);
+        put_le16(sb_buffer + 2, sb_inter_cost);
+        intra_cost += sb_intra_cost;
+        inter_cost += sb_inter_cost;
+    }
+
+    put_le32(buffer, PASS_STATS_MAGIC);
+    put_le16(buffer + 4, PASS_STATS_VERSION);
+    put_le16(buffer + 6, sb_count);
+    put_le32(buffer + 8, (uint32_t)picture_control_set_ptr->picture_number);
+    buffer[12] = (uint8_t)picture_control_set_ptr->slice_type;
+    buffer[13] = picture_control_set_ptr->temporal_layer_index;
+    buffer[14] = (uint8_t)picture_control_set_ptr->scene_change_flag;
+    buffer[15] = 0;
+    put_le64(buffer + 16, intra_cost);
+    put_le64(buffer + 24, inter_cost);
+}
+
+/**************************************
+ * eb_first_pass_picture_done
+ *   Does what Packetization and Rate
+ *   Control do at the end of a picture,
+ *   none of the later kernels see it.
+ **************************************/
+void eb_first_pass_picture_done(
+    SequenceControlSet       *sequence_control_set_ptr,
+    PictureParentControlSet  *picture_control_set_ptr)
+{
+    EncodeContext             *encode_context_ptr = sequence_control_set_ptr->encode_context_ptr;
+    EbObjectWrapper           *output_stream_wrapper_ptr = picture_control_set_ptr->output_stream_wrapper_ptr;
+    EbBufferHeaderType        *output_stream_ptr = (EbBufferHeaderType*)output_stream_wrapper_ptr->object_ptr;
+    PacketizationReorderEntry *queue_entry_ptr;
+    const uint32_t             record_size = eb_pass_stats_record_size(picture_control_set_ptr->sb_total_count);
+
+    output_stream_ptr->flags = EB_BUFFERFLAG_PASS_STATS;
+    output_stream_ptr->flags |= (encode_context_ptr->terminating_sequence_flag_received == EB_TRUE && picture_control_set_ptr->decode_order == encode_context_ptr->terminating_picture_number) ? EB_BUFFERFLAG_EOS : 0;
+    output_stream_ptr->n_filled_len = 0;
+    output_stream_ptr->pts = picture_control_set_ptr->input_ptr->pts;
+    output_stream_ptr->dts = picture_control_set_ptr->decode_order - (uint64_t)(1 << picture_control_set_ptr->hierarchical_levels) + 1;
+    output_stream_ptr->pic_type = picture_control_set_ptr->is_used_as_reference_flag ?
+        picture_control_set_ptr->idr_flag ? EB_AV1_KEY_PICTURE :
+        picture_control_set_ptr->slice_type : EB_AV1_NON_REF_PICTURE;
+    output_stream_ptr->p_app_private = EB_NULL;
+    output_stream_ptr->n_tick_count = 0;
+
+    if (record_size <= output_stream_ptr->n_alloc_len) {
+        write_first_pass_record(picture_control_set_ptr, output_stream_ptr->p_buffer);
+        output_stream_ptr->n_filled_len = record_size;
+    }
+
+    // Same release as for an encoded picture, see rate_control_kernel() and
+    // picture_manager_kernel()
+    if (picture_control_set_ptr->is_used_as_reference_flag)
+        eb_release_object(picture_control_set_ptr->sequence_control_set_wrapper_ptr);
+    eb_release_object(picture_control_set_ptr->sequence_control_set_wrapper_ptr);
+    eb_release_object(picture_control_set_ptr->input_picture_wrapper_ptr);
+    eb_release_object(picture_control_set_ptr->p_pcs_wrapper_ptr);
+
+    // Output in decode order, the Packetization reorder queue is otherwise unused
+    eb_block_on_mutex(encode_context_ptr->first_pass_mutex);
+    queue_entry_ptr = encode_context_ptr->packetization_reorder_queue[picture_control_set_ptr->decode_order % PACKETIZATION_REORDER_QUEUE_MAX_DEPTH];
+    queue_entry_ptr->output_stream_wrapper_ptr = output_stream_wrapper_ptr;
+
+    queue_entry_ptr = encode_context_ptr->packetization_reorder_queue[encode_context_ptr->packetization_reorder_queue_head_index];
+    while (queue_entry_ptr->output_stream_wrapper_ptr != EB_NULL) {
+        eb_post_full_object(queue_entry_ptr->output_stream_wrapper_ptr);
+        queue_entry_ptr->output_stream_wrapper_ptr = (EbObjectWrapper*)EB_NULL;
+
+        encode_context_ptr->packetization_reorder_queue_head_index =
+            (encode_context_ptr->packetization_reorder_queue_head_index == PACKETIZATION_REORDER_QUEUE_MAX_DEPTH - 1) ? 0 : encode_context_ptr->packetization_reorder_queue_head_index + 1;
+        queue_entry_ptr = encode_context_ptr->packetization_reorder_queue[encode_context_ptr->packetization_reorder_queue_head_index];
+    }
+    eb_release_mutex(encode_context_ptr->first_pass_mutex);
+}
+
+/**************************************
+ * eb_pass_stats_ctor
+ **************************************/
+EbErrorType eb_pass_stats_ctor(
+    EbPassStats             **pass_stats_dbl_ptr,
+    const uint8_t            *buffer,
+    uint64_t                  size,
+    uint32_t                  sb_count)
+{
+    EbPassStats   *pass_stats_ptr;
+    const uint32_t record_size = eb_pass_stats_record_size(sb_count);
+    uint64_t       picture_count;
+    uint64_t       offset;
+    double        *complexity_array;
+    double         complexity_sum = 0;
+    uint64_t       picture_index;
+
+    *pass_stats_dbl_ptr = (EbPassStats*)EB_NULL;
+    if (buffer == NULL || size == 0 || size % record_size)
+        return EB_ErrorBadParameter;
+    picture_count = size / record_size;
+
+    complexity_array = (double*)malloc(sizeof(double) * picture_count);
+    if (complexity_array == NULL)
+        return EB_ErrorInsufficientResources;
+    for (picture_index = 0; picture_index < picture_count; ++picture_index)
+        complexity_array[picture_index] = -1;
+
+    // Records are in decode order, the weights in display order
+    for (offset = 0; offset < size; offset += record_size) {
+        const uint8_t *record = buffer + offset;
+        const uint64_t intra_cost = get_le64(record + 16);
+        const uint64_t inter_cost = get_le64(record + 24);
+
+        picture_index = get_le32(record + 8);
+        if (get_le32(record) != PASS_STATS_MAGIC || get_le16(record + 4) != PASS_STATS_VERSION ||
+            get_le16(record + 6) != sb_count || picture_index >= picture_count || complexity_array[picture_index] >= 0) {
+            free(complexity_array);
+            return EB_ErrorBadParameter;
+        }
+        complexity_array[picture_index] = pow((double)MIN(intra_cost, inter_cost) + 1, PASS_STATS_COMPLEXITY_EXPONENT / 100.0);
+        complexity_sum += complexity_array[picture_index];
+    }
+
+    EB_MALLOC(EbPassStats*, pass_stats_ptr, sizeof(EbPassStats), EB_N_PTR);
+    EB_MALLOC(uint32_t*, pass_stats_ptr->weight_array, sizeof(uint32_t) * picture_count, EB_N_PTR);
+    pass_stats_ptr->picture_count = picture_count;
+    for (picture_index = 0; picture_index < picture_count; ++picture_index)
+        pass_stats_ptr->weight_array[picture_index] = (uint32_t)(complexity_array[picture_index] * picture_count / complexity_sum * (1 << RC_PRECISION) + 0.5);
+    free(complexity_array);
+
+    *pass_stats_dbl_ptr = pass_stats_ptr;
+    return EB_ErrorNone;
+}
+
+/**************************************
+ * eb_pass_stats_window_bits
+ **************************************/
+uint64_t eb_pass_stats_window_bits(
+    const EbPassStats        *pass_stats_ptr,
+    uint64_t                  picture_number,
+    uint32_t                  frame_count,
+    uint64_t                  bits_per_frame)
+{
+    uint64_t weight_sum = 0;
+    uint32_t frame_index;
+
+    // Pictures past the first pass get the average
+    for (frame_index = 0; frame_index < frame_count; ++frame_index) {
+        weight_sum += (picture_number + frame_index < pass_stats_ptr->picture_count) ?
+            pass_stats_ptr->weight_array[picture_number + frame_index] : (1 << RC_PRECISION);
+    }
+
+    return (bits_per_frame * weight_sum) >> RC_PRECISION;
+}
@@ -0,0 +1,88 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#ifndef EbPassStats_h
+#define EbPassStats_h
+
+#include "EbDefinitions.h"
+#include "EbPictureControlSet.h"
+#include "EbSequenceControlSet.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    /**************************************
+     * First pass statistics: one record per
+     * picture, output in decode order, all
+     * fields little endian.
+     *
+     *  0  magic            4   "SVTS"
+     *  4  version          2
+     *  6  sb_count         2
+     *  8  picture_number   4
+     * 12  slice_type       1
+     * 13  temporal_layer   1
+     * 14  scene_change     1
+     * 15  reserved         1
+     * 16  intra_cost       8   sum of the SB intra costs
+     * 24  inter_cost       8   sum of the SB inter costs
+     * 32  sb_count x (intra cost 2, inter cost 2)
+     *
+     * SB costs are per pixel in 1/16 units:
+     * the standard deviation of the 64x64
+     * block for intra, its ME SAD for inter
+     * (the intra cost in I pictures).
+     **************************************/
+#define PASS_STATS_MAGIC                0x53545653
+#define PASS_STATS_VERSION              1
+#define PASS_STATS_HEADER_SIZE          32
+#define PASS_STATS_SB_SIZE              4
+
+    // Picture bits are spread as complexity ^ (PASS_STATS_COMPLEXITY_EXPONENT / 100)
+#define PASS_STATS_COMPLEXITY_EXPONENT  60
+
+    /**************************************
+     * Second pass bit allocation
+     **************************************/
+    typedef struct EbPassStats
+    {
+        uint64_t                  picture_count;
+        // Share of the bit rate of each picture, in display order, in
+        // 1 / (1 << RC_PRECISION), averaging 1 << RC_PRECISION
+        uint32_t                 *weight_array;
+    } EbPassStats;
+
+    /**************************************
+     * Extern Function Declarations
+     **************************************/
+    extern uint32_t eb_pass_stats_record_size(
+        uint32_t                  sb_count);
+
+    // Parses the records of a first pass with the same resolution
+    extern EbErrorType eb_pass_stats_ctor(
+        EbPassStats             **pass_stats_dbl_ptr,
+        const uint8_t            *buffer,
+        uint64_t                  size,
+        uint32_t                  sb_count);
+
+    // Bits for the frame_count pictures from picture_number, given the average
+    // bits per picture
+    extern uint64_t eb_pass_stats_window_bits(
+        const EbPassStats        *pass_stats_ptr,
+        uint64_t                  picture_number,
+        uint32_t                  frame_count,
+        uint64_t                  bits_per_frame);
+
+    // First pass: outputs the statistics of a picture once its motion
+    // estimation is done, and releases it
+    extern void eb_first_pass_picture_done(
+        SequenceControlSet       *sequence_control_set_ptr,
+        PictureParentControlSet  *picture_control_set_ptr);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // EbPassStats_h
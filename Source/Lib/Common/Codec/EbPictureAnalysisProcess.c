@@ -38,6 +38,9 @@
 #define SAMPLE_THRESHOLD_PRECENT_BORDER_LINE      15
 #define SAMPLE_THRESHOLD_PRECENT_TWO_BORDER_LINES 10
 
+static void picture_analysis_process_segment(void *thread_context_ptr, void *owner_context_ptr, uint32_t segment_index);
+static void picture_analysis_fill_helper_task(void *owner_context_ptr, void *task_ptr);
+
 /************************************************
 * Picture Analysis Context Constructor
 ************************************************/
@@ -46,14 +49,38 @@ EbErrorType picture_analysis_context_ctor(
     EbBool                         denoise_flag,
     PictureAnalysisContext **context_dbl_ptr,
     EbFifo *resource_coordination_results_input_fifo_ptr,
-    EbFifo *picture_analysis_results_output_fifo_ptr)
+    EbFifo *picture_analysis_results_output_fifo_ptr,
+    EbFifo *picture_analysis_feedback_fifo_ptr,
+    uint32_t segment_row_count,
+    uint32_t helper_count)
 {
     PictureAnalysisContext *context_ptr;
+    uint32_t plane;
     EB_MALLOC(PictureAnalysisContext*, context_ptr, sizeof(PictureAnalysisContext), EB_N_PTR);
     *context_dbl_ptr = context_ptr;
 
     context_ptr->resource_coordination_results_input_fifo_ptr = resource_coordination_results_input_fifo_ptr;
     context_ptr->picture_analysis_results_output_fifo_ptr = picture_analysis_results_output_fifo_ptr;
+    context_ptr->picture_analysis_feedback_fifo_ptr = picture_analysis_feedback_fifo_ptr;
+
+    // Analysis job
+    context_ptr->segment_row_count = MAX(segment_row_count, 1);
+    context_ptr->job_pcs_ptr = (PictureParentControlSet*)EB_NULL;
+    if (eb_segment_job_ctor(
+            &context_ptr->segment_job,
+            context_ptr,
+            picture_analysis_feedback_fifo_ptr,
+            helper_count,
+            0,
+            picture_analysis_process_segment,
+            picture_analysis_fill_helper_task) != EB_ErrorNone)
+        return EB_ErrorInsufficientResources;
+    EB_MALLOC(uint64_t*, context_ptr->job_variance_sum_array, sizeof(uint64_t) * context_ptr->segment_row_count, EB_N_PTR);
+    EB_MALLOC(uint64_t*, context_ptr->job_block_mean_sum_array, sizeof(uint64_t) * context_ptr->segment_row_count, EB_N_PTR);
+    EB_MALLOC(uint64_t*, context_ptr->job_sc_block_count_array, sizeof(uint64_t) * context_ptr->segment_row_count, EB_N_PTR);
+    for (plane = 0; plane < 3; ++plane) {
+        EB_MALLOC(uint64_t*, context_ptr->job_intensity_sum_array[plane], sizeof(uint64_t) * context_ptr->segment_row_count, EB_N_PTR);
+    }
 
     EbErrorType return_error = EB_ErrorNone;
 
@@ -3392,15 +3419,23 @@ EbErrorType DetectInputPictureNoise(
 
 }
 
+static void picture_analysis_run_denoise_segments(
+    void                          *runner_ctx,
+    void                         (*process)(void *job, int32_t index),
+    void                          *job,
+    int32_t                        count);
+
 static int32_t apply_denoise_2d(SequenceControlSet        *scs_ptr,
     PictureParentControlSet   *pcs_ptr,
+    PictureAnalysisContext    *context_ptr,
     EbPictureBufferDesc *inputPicturePointer,
     EbAsm asm_type) {
 
-
+    // The block rows are shared with the other picture analysis threads
     if (aom_denoise_and_model_run(pcs_ptr->denoise_and_model, inputPicturePointer,
         &pcs_ptr->film_grain_params,
-        scs_ptr->static_config.encoder_bit_depth > EB_8BIT, asm_type)) {
+        scs_ptr->static_config.encoder_bit_depth > EB_8BIT, asm_type,
+        picture_analysis_run_denoise_segments, context_ptr)) {
     }
     return 0;
 }
@@ -3409,6 +3444,7 @@ static int32_t apply_denoise_2d(SequenceControlSet        *scs_ptr,
 EbErrorType denoise_estimate_film_grain(
     SequenceControlSet        *sequence_control_set_ptr,
     PictureParentControlSet   *picture_control_set_ptr,
+    PictureAnalysisContext    *context_ptr,
     EbAsm asm_type)
 {
     EbErrorType return_error = EB_ErrorNone;
@@ -3417,7 +3453,7 @@ EbErrorType denoise_estimate_film_grain(
     picture_control_set_ptr->film_grain_params.apply_grain = 0;
 
     if (sequence_control_set_ptr->film_grain_denoise_strength) {
-        if (apply_denoise_2d(sequence_control_set_ptr, picture_control_set_ptr, input_picture_ptr, asm_type) < 0)
+        if (apply_denoise_2d(sequence_control_set_ptr, picture_control_set_ptr, context_ptr, input_picture_ptr, asm_type) < 0)
             return 1;
     }
 
@@ -4107,6 +4143,7 @@ void SetPictureParametersForStatisticsGathering(
  ************************************************/
 void PicturePreProcessingOperations(
     PictureParentControlSet       *picture_control_set_ptr,
+    PictureAnalysisContext        *context_ptr,
     EbPictureBufferDesc           *input_picture_ptr,
     SequenceControlSet            *sequence_control_set_ptr,
     EbPictureBufferDesc           *quarter_decimated_picture_ptr,
@@ -4123,6 +4160,7 @@ void PicturePreProcessingOperations(
         denoise_estimate_film_grain(
             sequence_control_set_ptr,
             picture_control_set_ptr,
+            context_ptr,
             asm_type);
     }
     else {
@@ -4140,11 +4178,14 @@ void PicturePreProcessingOperations(
 /**************************************************************
 * Generate picture histogram bins for YUV pixel intensity *
 * Calculation is done on a region based (Set previously, resolution dependent)
+* for the region rows [region_row_start, region_row_end)
 **************************************************************/
 void SubSampleLumaGeneratePixelIntensityHistogramBins(
     SequenceControlSet            *sequence_control_set_ptr,
     PictureParentControlSet       *picture_control_set_ptr,
     EbPictureBufferDesc           *input_picture_ptr,
+    uint32_t                           region_row_start,
+    uint32_t                           region_row_end,
     uint64_t                          *sumAverageIntensityTotalRegionsLuma,
     EbAsm                           asm_type) {
 
@@ -4162,7 +4203,7 @@ void SubSampleLumaGeneratePixelIntensityHistogramBins(
 
     // Loop over regions inside the picture
     for (regionInPictureWidthIndex = 0; regionInPictureWidthIndex < sequence_control_set_ptr->picture_analysis_number_of_regions_per_width; regionInPictureWidthIndex++) {  // loop over horizontal regions
-        for (regionInPictureHeightIndex = 0; regionInPictureHeightIndex < sequence_control_set_ptr->picture_analysis_number_of_regions_per_height; regionInPictureHeightIndex++) { // loop over vertical regions
+        for (regionInPictureHeightIndex = region_row_start; regionInPictureHeightIndex < region_row_end; regionInPictureHeightIndex++) { // loop over vertical regions
 
 
             // Initialize bins to 1
@@ -4202,6 +4243,8 @@ void SubSampleChromaGeneratePixelIntensityHistogramBins(
     SequenceControlSet            *sequence_control_set_ptr,
     PictureParentControlSet       *picture_control_set_ptr,
     EbPictureBufferDesc           *input_picture_ptr,
+    uint32_t                           region_row_start,
+    uint32_t                           region_row_end,
     uint64_t                          *sumAverageIntensityTotalRegionsCb,
     uint64_t                          *sumAverageIntensityTotalRegionsCr,
     EbAsm                           asm_type) {
@@ -4222,7 +4265,7 @@ void SubSampleChromaGeneratePixelIntensityHistogramBins(
 
     // Loop over regions inside the picture
     for (regionInPictureWidthIndex = 0; regionInPictureWidthIndex < sequence_control_set_ptr->picture_analysis_number_of_regions_per_width; regionInPictureWidthIndex++) {  // loop over horizontal regions
-        for (regionInPictureHeightIndex = 0; regionInPictureHeightIndex < sequence_control_set_ptr->picture_analysis_number_of_regions_per_height; regionInPictureHeightIndex++) { // loop over vertical regions
+        for (regionInPictureHeightIndex = region_row_start; regionInPictureHeightIndex < region_row_end; regionInPictureHeightIndex++) { // loop over vertical regions
 
 
             // Initialize bins to 1
@@ -4632,15 +4675,23 @@ void DetermineHomogeneousRegionInPicture(
  ** Compute Picture Variance
  ** Compute Block Mean for all blocks in the picture
  ************************************************/
-void ComputePictureSpatialStatistics(
+/************************************************
+ * Computes the block means and variances of the
+ * SB rows [sb_row_start, sb_row_end) and returns
+ * the sum of their 64x64 variances
+ ************************************************/
+uint64_t ComputeSegmentSpatialStatistics(
     SequenceControlSet            *sequence_control_set_ptr,
     PictureParentControlSet       *picture_control_set_ptr,
     EbPictureBufferDesc           *input_picture_ptr,
     EbPictureBufferDesc           *input_padded_picture_ptr,
-    uint32_t                           sb_total_count,
+    uint32_t                           sb_row_start,
+    uint32_t                           sb_row_end,
     EbAsm                           asm_type)
 {
+    uint32_t picture_width_in_sb = (sequence_control_set_ptr->luma_width + sequence_control_set_ptr->sb_sz - 1) / sequence_control_set_ptr->sb_sz;
     uint32_t sb_index;
+    uint32_t sb_index_end;
     uint32_t sb_origin_x;        // to avoid using child PCS
     uint32_t sb_origin_y;
     uint32_t inputLumaOriginIndex;
@@ -4651,7 +4702,8 @@ void ComputePictureSpatialStatistics(
     // Variance
     picTotVariance = 0;
 
-    for (sb_index = 0; sb_index < picture_control_set_ptr->sb_total_count; ++sb_index) {
+    sb_index_end = MIN(sb_row_end * picture_width_in_sb, picture_control_set_ptr->sb_total_count);
+    for (sb_index = sb_row_start * picture_width_in_sb; sb_index < sb_index_end; ++sb_index) {
         SbParams   *sb_params = &sequence_control_set_ptr->sb_params_array[sb_index];
 
         sb_origin_x = sb_params->origin_x;
@@ -4690,6 +4742,15 @@ void ComputePictureSpatialStatistics(
         picTotVariance += (picture_control_set_ptr->variance[sb_index][RASTER_SCAN_CU_INDEX_64x64]);
     }
 
+    return picTotVariance;
+}
+
+void ComputePictureSpatialStatistics(
+    SequenceControlSet            *sequence_control_set_ptr,
+    PictureParentControlSet       *picture_control_set_ptr,
+    uint64_t                           picTotVariance,
+    uint32_t                           sb_total_count)
+{
     picture_control_set_ptr->pic_avg_variance = (uint16_t)(picTotVariance / sb_total_count);
 
     // Calculate the variance of variance to determine Homogeneous regions. Note: Variance calculation should be on.
@@ -4710,38 +4771,57 @@ void ComputePictureSpatialStatistics(
     return;
 }
 
-void CalculateInputAverageIntensity(
+/************************************************
+ * Sums the means of the 8x8 luma blocks of the
+ * rows [row_start, row_end), SCD_MODE_0 only
+ ************************************************/
+uint64_t ComputeInputBlockMeanSum(
     SequenceControlSet            *sequence_control_set_ptr,
-    PictureParentControlSet       *picture_control_set_ptr,
     EbPictureBufferDesc           *input_picture_ptr,
-    uint64_t                           sumAverageIntensityTotalRegionsLuma,
-    uint64_t                           sumAverageIntensityTotalRegionsCb,
-    uint64_t                           sumAverageIntensityTotalRegionsCr,
+    uint32_t                           row_start,
+    uint32_t                           row_end,
     EbAsm                           asm_type)
 {
+    uint16_t blockIndexInWidth;
+    uint16_t blockIndexInHeight;
+    uint64_t mean = 0;
 
     if (sequence_control_set_ptr->scd_mode == SCD_MODE_0) {
-        uint16_t blockIndexInWidth;
-        uint16_t blockIndexInHeight;
-        uint64_t mean = 0;
-
-        (void)(asm_type);
         const uint16_t stride_y = input_picture_ptr->stride_y;
+        const uint16_t blockRowEnd = (uint16_t)(MIN(row_end, input_picture_ptr->height) >> 3);
         // Loop over 8x8 blocks and calculates the mean value
         if (sequence_control_set_ptr->block_mean_calc_prec == BLOCK_MEAN_PREC_FULL) {
-            for (blockIndexInHeight = 0; blockIndexInHeight < input_picture_ptr->height >> 3; ++blockIndexInHeight) {
+            for (blockIndexInHeight = (uint16_t)(row_start >> 3); blockIndexInHeight < blockRowEnd; ++blockIndexInHeight) {
                 for (blockIndexInWidth = 0; blockIndexInWidth < input_picture_ptr->width >> 3; ++blockIndexInWidth) {
                     mean += compute_mean_func[0][asm_type](&(input_picture_ptr->buffer_y[(blockIndexInWidth << 3) + (blockIndexInHeight << 3) * input_picture_ptr->stride_y]), input_picture_ptr->stride_y, 8, 8);
                 }
             }
         }
         else {
-            for (blockIndexInHeight = 0; blockIndexInHeight < input_picture_ptr->height >> 3; ++blockIndexInHeight) {
+            for (blockIndexInHeight = (uint16_t)(row_start >> 3); blockIndexInHeight < blockRowEnd; ++blockIndexInHeight) {
                 for (blockIndexInWidth = 0; blockIndexInWidth < input_picture_ptr->width >> 3; ++blockIndexInWidth) {
                     mean += compute_sub_mean8x8_sse2_intrin(&(input_picture_ptr->buffer_y[(blockIndexInWidth << 3) + (blockIndexInHeight << 3) * stride_y]), stride_y);
                 }
             }
         }
+    }
+
+    return mean;
+}
+
+void CalculateInputAverageIntensity(
+    SequenceControlSet            *sequence_control_set_ptr,
+    PictureParentControlSet       *picture_control_set_ptr,
+    EbPictureBufferDesc           *input_picture_ptr,
+    uint64_t                           sumAverageIntensityTotalRegionsLuma,
+    uint64_t                           sumAverageIntensityTotalRegionsCb,
+    uint64_t                           sumAverageIntensityTotalRegionsCr,
+    uint64_t                           sumBlockMean)
+{
+
+    if (sequence_control_set_ptr->scd_mode == SCD_MODE_0) {
+        uint64_t mean = sumBlockMean;
+
         mean = ((mean + ((input_picture_ptr->height* input_picture_ptr->width) >> 7)) / ((input_picture_ptr->height* input_picture_ptr->width) >> 6));
         mean = (mean + (1 << (MEAN_PRECISION - 1))) >> MEAN_PRECISION;
         picture_control_set_ptr->average_intensity[0] = (uint8_t)mean;
@@ -4758,43 +4838,36 @@ void CalculateInputAverageIntensity(
 
 /************************************************
  * Gathering statistics per picture
- ** Calculating the pixel intensity histogram bins per picture needed for SCD
+ ** Merging the sums of the segments of the analysis
  ** Computing Picture Variance
  ************************************************/
 void GatheringPictureStatistics(
     SequenceControlSet            *sequence_control_set_ptr,
     PictureParentControlSet       *picture_control_set_ptr,
+    PictureAnalysisContext        *context_ptr,
     EbPictureBufferDesc           *input_picture_ptr,
-    EbPictureBufferDesc           *input_padded_picture_ptr,
-    EbPictureBufferDesc            *sixteenth_decimated_picture_ptr,
     uint32_t                           sb_total_count,
-    EbAsm                           asm_type)
+    uint32_t                           row_segment_count,
+    uint32_t                           region_segment_count)
 {
 
     uint64_t                          sumAverageIntensityTotalRegionsLuma = 0;
     uint64_t                          sumAverageIntensityTotalRegionsCb = 0;
     uint64_t                          sumAverageIntensityTotalRegionsCr = 0;
+    uint64_t                          sumBlockMean = 0;
+    uint64_t                          picTotVariance = 0;
+    uint32_t                          segment_index;
 
-    // Histogram bins
-        // Use 1/16 Luma for Histogram generation
-        // 1/16 input ready
-    SubSampleLumaGeneratePixelIntensityHistogramBins(
-        sequence_control_set_ptr,
-        picture_control_set_ptr,
-        sixteenth_decimated_picture_ptr,
-        &sumAverageIntensityTotalRegionsLuma,
-        asm_type);
+    for (segment_index = 0; segment_index < row_segment_count; ++segment_index) {
+        picTotVariance += context_ptr->job_variance_sum_array[segment_index];
+        sumBlockMean += context_ptr->job_block_mean_sum_array[segment_index];
+    }
+    for (segment_index = 0; segment_index < region_segment_count; ++segment_index) {
+        sumAverageIntensityTotalRegionsLuma += context_ptr->job_intensity_sum_array[0][segment_index];
+        sumAverageIntensityTotalRegionsCb += context_ptr->job_intensity_sum_array[1][segment_index];
+        sumAverageIntensityTotalRegionsCr += context_ptr->job_intensity_sum_array[2][segment_index];
+    }
 
-    // Use 1/4 Chroma for Histogram generation
-    // 1/4 input not ready => perform operation on the fly
-    SubSampleChromaGeneratePixelIntensityHistogramBins(
-        sequence_control_set_ptr,
-        picture_control_set_ptr,
-        input_picture_ptr,
-        &sumAverageIntensityTotalRegionsCb,
-        &sumAverageIntensityTotalRegionsCr,
-        asm_type);
-    //
     // Calculate the LUMA average intensity
     CalculateInputAverageIntensity(
         sequence_control_set_ptr,
@@ -4803,16 +4876,14 @@ void GatheringPictureStatistics(
         sumAverageIntensityTotalRegionsLuma,
         sumAverageIntensityTotalRegionsCb,
         sumAverageIntensityTotalRegionsCr,
-        asm_type);
+        sumBlockMean);
 
 
     ComputePictureSpatialStatistics(
         sequence_control_set_ptr,
         picture_control_set_ptr,
-        input_picture_ptr,
-        input_padded_picture_ptr,
-        sb_total_count,
-        asm_type);
+        picTotVariance,
+        sb_total_count);
 
     return;
 }
@@ -4907,27 +4978,62 @@ void PadPictureToMultipleOfLcuDimensions(
 }
 
 /************************************************
-* 1/4 & 1/16 input picture decimation
+* 1/4 & 1/16 input picture decimation of the rows
+* [row_start, row_end), multiples of 4
 ************************************************/
 void DecimateInputPicture(
     PictureParentControlSet       *picture_control_set_ptr,
     EbPictureBufferDesc           *input_padded_picture_ptr,
     EbPictureBufferDesc           *quarter_decimated_picture_ptr,
-    EbPictureBufferDesc           *sixteenth_decimated_picture_ptr) {
+    EbPictureBufferDesc           *sixteenth_decimated_picture_ptr,
+    uint32_t                           row_start,
+    uint32_t                           row_end) {
 
+    row_end = MIN(row_end, input_padded_picture_ptr->height);
+    if (row_start >= row_end)
+        return;
 
     // Decimate input picture for HME L0 and L1
     if (picture_control_set_ptr->enable_hme_flag) {
 
         if (picture_control_set_ptr->enable_hme_level1_flag) {
             decimation_2d(
-                &input_padded_picture_ptr->buffer_y[input_padded_picture_ptr->origin_x + input_padded_picture_ptr->origin_y * input_padded_picture_ptr->stride_y],
+                &input_padded_picture_ptr->buffer_y[input_padded_picture_ptr->origin_x + (input_padded_picture_ptr->origin_y + row_start) * input_padded_picture_ptr->stride_y],
                 input_padded_picture_ptr->stride_y,
                 input_padded_picture_ptr->width,
-                input_padded_picture_ptr->height,
-                &quarter_decimated_picture_ptr->buffer_y[quarter_decimated_picture_ptr->origin_x + quarter_decimated_picture_ptr->origin_x*quarter_decimated_picture_ptr->stride_y],
+                row_end - row_start,
+                &quarter_decimated_picture_ptr->buffer_y[quarter_decimated_picture_ptr->origin_x + (quarter_decimated_picture_ptr->origin_x + (row_start >> 1))*quarter_decimated_picture_ptr->stride_y],
                 quarter_decimated_picture_ptr->stride_y,
                 2);
+        }
+
+        if (picture_control_set_ptr->enable_hme_level0_flag) {
+
+            // Sixteenth Input Picture Decimation
+            decimation_2d(
+                &input_padded_picture_ptr->buffer_y[input_padded_picture_ptr->origin_x + (input_padded_picture_ptr->origin_y + row_start) * input_padded_picture_ptr->stride_y],
+                input_padded_picture_ptr->stride_y,
+                input_padded_picture_ptr->width,
+                row_end - row_start,
+                &sixteenth_decimated_picture_ptr->buffer_y[sixteenth_decimated_picture_ptr->origin_x + (sixteenth_decimated_picture_ptr->origin_x + (row_start >> 2))*sixteenth_decimated_picture_ptr->stride_y],
+                sixteenth_decimated_picture_ptr->stride_y,
+                4);
+        }
+    }
+}
+
+/************************************************
+* 1/4 & 1/16 decimated picture padding, once all
+* the rows are decimated
+************************************************/
+void PadDecimatedInputPicture(
+    PictureParentControlSet       *picture_control_set_ptr,
+    EbPictureBufferDesc           *quarter_decimated_picture_ptr,
+    EbPictureBufferDesc           *sixteenth_decimated_picture_ptr) {
+
+    if (picture_control_set_ptr->enable_hme_flag) {
+
+        if (picture_control_set_ptr->enable_hme_level1_flag) {
             generate_padding(
                 &quarter_decimated_picture_ptr->buffer_y[0],
                 quarter_decimated_picture_ptr->stride_y,
@@ -4940,16 +5046,6 @@ void DecimateInputPicture(
 
         if (picture_control_set_ptr->enable_hme_level0_flag) {
 
-            // Sixteenth Input Picture Decimation
-            decimation_2d(
-                &input_padded_picture_ptr->buffer_y[input_padded_picture_ptr->origin_x + input_padded_picture_ptr->origin_y * input_padded_picture_ptr->stride_y],
-                input_padded_picture_ptr->stride_y,
-                input_padded_picture_ptr->width,
-                input_padded_picture_ptr->height,
-                &sixteenth_decimated_picture_ptr->buffer_y[sixteenth_decimated_picture_ptr->origin_x + sixteenth_decimated_picture_ptr->origin_x*sixteenth_decimated_picture_ptr->stride_y],
-                sixteenth_decimated_picture_ptr->stride_y,
-                4);
-
             generate_padding(
                 &sixteenth_decimated_picture_ptr->buffer_y[0],
                 sixteenth_decimated_picture_ptr->stride_y,
@@ -4978,16 +5074,18 @@ int av1_count_colors(const uint8_t *src, int stride, int rows, int cols,
     }
     return n;
 }
-// Estimate if the source frame is screen content, based on the portion of
-// blocks that have no more than 4 (experimentally selected) luma colors.
-static int is_screen_content(const uint8_t *src, int use_hbd,
-    int stride, int width, int height) {
+// Count the blocks of the rows [row_start, row_end) of the source frame that
+// have no more than 4 (experimentally selected) luma colors, the frame is
+// estimated as screen content from the count of all its rows.
+#define SC_BLOCK_SIZE 16
+static int count_screen_content_blocks(const uint8_t *src, int use_hbd,
+    int stride, int width, int row_start, int row_end) {
     assert(src != NULL);
     int counts = 0;
-    const int blk_w = 16;
-    const int blk_h = 16;
+    const int blk_w = SC_BLOCK_SIZE;
+    const int blk_h = SC_BLOCK_SIZE;
     const int limit = 4;
-    for (int r = 0; r + blk_h <= height; r += blk_h) {
+    for (int r = row_start; r + blk_h <= row_end; r += blk_h) {
         for (int c = 0; c + blk_w <= width; c += blk_w) {
             int count_buf[1 << 12];  // Maximum (1 << 12) color levels.
             const int n_colors =
@@ -4998,11 +5096,200 @@ static int is_screen_content(const uint8_t *src, int use_hbd,
             if (n_colors > 1 && n_colors <= limit) counts++;
         }
     }
-    // The threshold is 10%.
-    return counts * blk_h * blk_w * 10 > width * height;
+    return counts;
+}
+
+// Estimate if the source frame is screen content from its block count.
+// The threshold is 10%.
+static int is_screen_content(uint64_t counts, int width, int height) {
+    return counts * SC_BLOCK_SIZE * SC_BLOCK_SIZE * 10 > (uint64_t)width * height;
 }
 
 
+/************************************************
+ * Picture Analysis Process Segment
+ *   One segment of the current step of the job of
+ *   owner_context_ptr
+ ************************************************/
+static void picture_analysis_process_segment(
+    void                          *thread_context_ptr,
+    void                          *owner_context_ptr,
+    uint32_t                       segment_index)
+{
+    PictureAnalysisContext  *owner_ptr = (PictureAnalysisContext*)owner_context_ptr;
+    PictureParentControlSet *picture_control_set_ptr = owner_ptr->job_pcs_ptr;
+    SequenceControlSet      *sequence_control_set_ptr;
+    EbPaReferenceObject     *paReferenceObject;
+    EbPictureBufferDesc     *input_picture_ptr;
+    EbAsm                    asm_type;
+    uint32_t                 picture_width_in_sb;
+    uint32_t                 picture_height_in_sb;
+    uint32_t                 row_start;
+    uint32_t                 row_end;
+    uint32_t                 sample_row_end;
+    uint32_t                 sb_index;
+
+    // The block rows of the film grain model carry their own data
+    if (owner_ptr->job_step == PA_STEP_DENOISE) {
+        owner_ptr->job_process(owner_ptr->job_ptr, (int32_t)segment_index);
+        return;
+    }
+
+    sequence_control_set_ptr = (SequenceControlSet*)picture_control_set_ptr->sequence_control_set_wrapper_ptr->object_ptr;
+    paReferenceObject = (EbPaReferenceObject*)picture_control_set_ptr->pa_reference_picture_wrapper_ptr->object_ptr;
+    input_picture_ptr = picture_control_set_ptr->chroma_downsampled_picture_ptr; //420 input_picture_ptr
+    asm_type = sequence_control_set_ptr->encode_context_ptr->asm_type;
+    picture_width_in_sb = (sequence_control_set_ptr->luma_width + sequence_control_set_ptr->sb_sz - 1) / sequence_control_set_ptr->sb_sz;
+    picture_height_in_sb = (sequence_control_set_ptr->luma_height + sequence_control_set_ptr->sb_sz - 1) / sequence_control_set_ptr->sb_sz;
+
+    switch (owner_ptr->job_step) {
+    case PA_STEP_ROWS:
+        row_start = SEGMENT_START_IDX(segment_index, picture_height_in_sb, owner_ptr->segment_job.segment_count);
+        row_end = SEGMENT_END_IDX(segment_index, picture_height_in_sb, owner_ptr->segment_job.segment_count);
+        // The last segment takes the rows of the picture buffers below the last SB row
+        sample_row_end = (row_end == picture_height_in_sb) ? (uint32_t)~0 : row_end * sequence_control_set_ptr->sb_sz;
+
+        // 1/4 & 1/16 input picture decimation
+        DecimateInputPicture(
+            picture_control_set_ptr,
+            paReferenceObject->input_padded_picture_ptr,
+            paReferenceObject->quarter_decimated_picture_ptr,
+            paReferenceObject->sixteenth_decimated_picture_ptr,
+            row_start * sequence_control_set_ptr->sb_sz,
+            sample_row_end);
+
+        owner_ptr->job_block_mean_sum_array[segment_index] = ComputeInputBlockMeanSum(
+            sequence_control_set_ptr,
+            input_picture_ptr,
+            row_start * sequence_control_set_ptr->sb_sz,
+            sample_row_end,
+            asm_type);
+
+        owner_ptr->job_variance_sum_array[segment_index] = ComputeSegmentSpatialStatistics(
+            sequence_control_set_ptr,
+            picture_control_set_ptr,
+            input_picture_ptr,
+            paReferenceObject->input_padded_picture_ptr,
+            row_start,
+            row_end,
+            asm_type);
+
+        if (sequence_control_set_ptr->static_config.screen_content_mode == 2) { // auto detect
+            owner_ptr->job_sc_block_count_array[segment_index] = (uint64_t)count_screen_content_blocks(
+                picture_control_set_ptr->enhanced_picture_ptr->buffer_y + picture_control_set_ptr->enhanced_picture_ptr->origin_x + picture_control_set_ptr->enhanced_picture_ptr->origin_y * picture_control_set_ptr->enhanced_picture_ptr->stride_y,
+                0,
+                picture_control_set_ptr->enhanced_picture_ptr->stride_y,
+                sequence_control_set_ptr->luma_width,
+                row_start * sequence_control_set_ptr->sb_sz,
+                MIN(row_end * sequence_control_set_ptr->sb_sz, sequence_control_set_ptr->luma_height));
+        }
+
+        // Hold the 64x64 variance and mean in the reference frame
+        for (sb_index = row_start * picture_width_in_sb; sb_index < MIN(row_end * picture_width_in_sb, picture_control_set_ptr->sb_total_count); ++sb_index) {
+            paReferenceObject->variance[sb_index] = picture_control_set_ptr->variance[sb_index][ME_TIER_ZERO_PU_64x64];
+            paReferenceObject->y_mean[sb_index] = picture_control_set_ptr->y_mean[sb_index][ME_TIER_ZERO_PU_64x64];
+        }
+        break;
+
+    case PA_STEP_REGIONS:
+        row_start = SEGMENT_START_IDX(segment_index, sequence_control_set_ptr->picture_analysis_number_of_regions_per_height, owner_ptr->segment_job.segment_count);
+        row_end = SEGMENT_END_IDX(segment_index, sequence_control_set_ptr->picture_analysis_number_of_regions_per_height, owner_ptr->segment_job.segment_count);
+        owner_ptr->job_intensity_sum_array[0][segment_index] = 0;
+        owner_ptr->job_intensity_sum_array[1][segment_index] = 0;
+        owner_ptr->job_intensity_sum_array[2][segment_index] = 0;
+
+        // Histogram bins
+            // Use 1/16 Luma for Histogram generation
+            // 1/16 input ready
+        SubSampleLumaGeneratePixelIntensityHistogramBins(
+            sequence_control_set_ptr,
+            picture_control_set_ptr,
+            paReferenceObject->sixteenth_decimated_picture_ptr,
+            row_start,
+            row_end,
+            &owner_ptr->job_intensity_sum_array[0][segment_index],
+            asm_type);
+
+        // Use 1/4 Chroma for Histogram generation
+        // 1/4 input not ready => perform operation on the fly
+        SubSampleChromaGeneratePixelIntensityHistogramBins(
+            sequence_control_set_ptr,
+            picture_control_set_ptr,
+            input_picture_ptr,
+            row_start,
+            row_end,
+            &owner_ptr->job_intensity_sum_array[1][segment_index],
+            &owner_ptr->job_intensity_sum_array[2][segment_index],
+            asm_type);
+        break;
+
+    default:
+        break;
+    }
+}
+
+/************************************************
+ * Picture Analysis Fill Helper Task
+ *   The feedback tasks come from the pool Resource
+ *   Coordination feeds Picture Analysis from
+ ************************************************/
+static void picture_analysis_fill_helper_task(
+    void                          *owner_context_ptr,
+    void                          *task_ptr)
+{
+    ResourceCoordinationResults *helper_ptr = (ResourceCoordinationResults*)task_ptr;
+
+    helper_ptr->picture_control_set_wrapper_ptr = (EbObjectWrapper*)EB_NULL;
+    helper_ptr->input_type = PA_TASKS_PA_INPUT;
+    helper_ptr->picture_analysis_context_ptr = owner_context_ptr;
+}
+
+/************************************************
+ * Picture Analysis Run Segments
+ *   Splits one step of the analysis of a picture in
+ *   segment_count segments and returns when all are
+ *   done, see eb_segment_job_run()
+ ************************************************/
+static void picture_analysis_run_segments(
+    PictureAnalysisContext        *context_ptr,
+    PictureParentControlSet       *picture_control_set_ptr,
+    PaSegmentStep                  step,
+    uint32_t                       segment_count)
+{
+    context_ptr->job_pcs_ptr = picture_control_set_ptr;
+    context_ptr->job_step = step;
+
+    eb_segment_job_run(
+        &context_ptr->segment_job,
+        segment_count);
+}
+
+/************************************************
+ * Picture Analysis Run Denoise Segments
+ *   Runner of the block rows of the film grain
+ *   model, see aom_denoise_runner_t, one segment
+ *   per block row
+ ************************************************/
+static void picture_analysis_run_denoise_segments(
+    void                          *runner_ctx,
+    void                         (*process)(void *job, int32_t index),
+    void                          *job,
+    int32_t                        count)
+{
+    PictureAnalysisContext *context_ptr = (PictureAnalysisContext*)runner_ctx;
+
+    if (count <= 0)
+        return;
+    context_ptr->job_process = process;
+    context_ptr->job_ptr = job;
+
+    picture_analysis_run_segments(
+        context_ptr,
+        (PictureParentControlSet*)EB_NULL,
+        PA_STEP_DENOISE,
+        (uint32_t)count);
+}
+
 /************************************************
  * Picture Analysis Kernel
  * The Picture Analysis Process pads & decimates the input pictures.
@@ -5033,6 +5320,8 @@ void* picture_analysis_kernel(void *input_ptr)
     uint32_t                          picture_width_in_sb;
     uint32_t                          pictureHeighInLcu;
     uint32_t                          sb_total_count;
+    uint32_t                          row_segment_count;
+    uint32_t                          region_segment_count;
     EbAsm                          asm_type;
 
     for (;;) {
@@ -5043,6 +5332,16 @@ void* picture_analysis_kernel(void *input_ptr)
             &inputResultsWrapperPtr);
 
         inputResultsPtr = (ResourceCoordinationResults*)inputResultsWrapperPtr->object_ptr;
+
+        // Segments of the picture of another picture analysis thread
+        if (inputResultsPtr->input_type == PA_TASKS_PA_INPUT) {
+            eb_segment_job_help(
+                &((PictureAnalysisContext*)inputResultsPtr->picture_analysis_context_ptr)->segment_job,
+                context_ptr);
+            eb_release_object(inputResultsWrapperPtr);
+            continue;
+        }
+
         picture_control_set_ptr = (PictureParentControlSet*)inputResultsPtr->picture_control_set_wrapper_ptr->object_ptr;
         sequence_control_set_ptr = (SequenceControlSet*)picture_control_set_ptr->sequence_control_set_wrapper_ptr->object_ptr;
         input_picture_ptr = picture_control_set_ptr->enhanced_picture_ptr;
@@ -5073,6 +5372,7 @@ void* picture_analysis_kernel(void *input_ptr)
         // Pre processing operations performed on the input picture
         PicturePreProcessingOperations(
             picture_control_set_ptr,
+            context_ptr,
             input_picture_ptr,
             sequence_control_set_ptr,
             quarter_decimated_picture_ptr,
@@ -5094,27 +5394,43 @@ void* picture_analysis_kernel(void *input_ptr)
         PadPictureToMultipleOfLcuDimensions(
             input_padded_picture_ptr);
 
-        // 1/4 & 1/16 input picture decimation
-        DecimateInputPicture(
+        // 1/4 & 1/16 input picture decimation and block statistics, by SB rows
+        row_segment_count = MAX(MIN(MIN(context_ptr->segment_row_count, sequence_control_set_ptr->pa_segment_row_count), pictureHeighInLcu), 1);
+        picture_analysis_run_segments(
+            context_ptr,
+            picture_control_set_ptr,
+            PA_STEP_ROWS,
+            row_segment_count);
+
+        PadDecimatedInputPicture(
             picture_control_set_ptr,
-            input_padded_picture_ptr,
             quarter_decimated_picture_ptr,
             sixteenth_decimated_picture_ptr);
 
+        // Histogram bins, by region rows, on the decimated picture
+        region_segment_count = MIN(row_segment_count, sequence_control_set_ptr->picture_analysis_number_of_regions_per_height);
+        picture_analysis_run_segments(
+            context_ptr,
+            picture_control_set_ptr,
+            PA_STEP_REGIONS,
+            region_segment_count);
+
         // Gathering statistics of input picture, including Variance Calculation, Histogram Bins
         GatheringPictureStatistics(
             sequence_control_set_ptr,
             picture_control_set_ptr,
+            context_ptr,
             picture_control_set_ptr->chroma_downsampled_picture_ptr, //420 input_picture_ptr
-            input_padded_picture_ptr,
-            sixteenth_decimated_picture_ptr,
             sb_total_count,
-            asm_type);
+            row_segment_count,
+            region_segment_count);
         if (sequence_control_set_ptr->static_config.screen_content_mode == 2){ // auto detect
+            uint64_t sc_block_count = 0;
+            uint32_t segment_index;
+            for (segment_index = 0; segment_index < row_segment_count; ++segment_index)
+                sc_block_count += context_ptr->job_sc_block_count_array[segment_index];
             picture_control_set_ptr->sc_content_detected = is_screen_content(
-                input_picture_ptr->buffer_y + input_picture_ptr->origin_x + input_picture_ptr->origin_y*input_picture_ptr->stride_y,
-                0,
-                input_picture_ptr->stride_y,
+                sc_block_count,
                 sequence_control_set_ptr->luma_width, sequence_control_set_ptr->luma_height);
             if (picture_control_set_ptr->sc_content_detected) {
                 if (picture_control_set_ptr->pic_avg_variance > 1000)
@@ -5128,14 +5444,6 @@ void* picture_analysis_kernel(void *input_ptr)
 #if HARD_CODE_SC_SETTING
         picture_control_set_ptr->sc_content_detected = EB_TRUE;
 #endif
-        // Hold the 64x64 variance and mean in the reference frame
-        uint32_t sb_index;
-        for (sb_index = 0; sb_index < picture_control_set_ptr->sb_total_count; ++sb_index) {
-            paReferenceObject->variance[sb_index] = picture_control_set_ptr->variance[sb_index][ME_TIER_ZERO_PU_64x64];
-            paReferenceObject->y_mean[sb_index] = picture_control_set_ptr->y_mean[sb_index][ME_TIER_ZERO_PU_64x64];
-
-        }
-
         // Get Empty Results Object
         eb_get_empty_object(
             context_ptr->picture_analysis_results_output_fifo_ptr,
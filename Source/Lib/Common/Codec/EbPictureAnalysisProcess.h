@@ -8,8 +8,19 @@
 
 #include "EbDefinitions.h"
 #include "EbSystemResourceManager.h"
+#include "EbSegmentJob.h"
 #include "EbNoiseExtractAVX2.h"
 
+/**************************************
+ * Segment steps of the analysis of a picture
+ **************************************/
+typedef enum PaSegmentStep
+{
+    PA_STEP_ROWS,           // decimate and compute the block statistics of the SB rows of the segment
+    PA_STEP_REGIONS,        // build the histograms of the region rows of the segment
+    PA_STEP_DENOISE         // film grain denoise and flat block search, one block row per segment
+} PaSegmentStep;
+
 /**************************************
  * Context
  **************************************/
@@ -18,9 +29,26 @@ typedef struct PictureAnalysisContext
     EB_ALIGN(64) uint8_t            local_cache[64];
     EbFifo                     *resource_coordination_results_input_fifo_ptr;
     EbFifo                     *picture_analysis_results_output_fifo_ptr;
+    EbFifo                     *picture_analysis_feedback_fifo_ptr;
     EbPictureBufferDesc        *denoised_picture_ptr;
     EbPictureBufferDesc        *noise_picture_ptr;
     double                          pic_noise_variance_float;
+
+    // Analysis job of this context, the segments are shared with the
+    // helper picture analysis threads posted through the feedback fifo
+    EbSegmentJob                segment_job;
+    uint32_t                    segment_row_count;
+
+    struct PictureParentControlSet *job_pcs_ptr;
+    PaSegmentStep               job_step;
+    // Sums of the segments, merged once the step is done
+    uint64_t                   *job_variance_sum_array;     // 64x64 variances (PA_STEP_ROWS)
+    uint64_t                   *job_block_mean_sum_array;   // 8x8 means (PA_STEP_ROWS)
+    uint64_t                   *job_sc_block_count_array;   // screen content blocks (PA_STEP_ROWS)
+    uint64_t                   *job_intensity_sum_array[3]; // Y, Cb and Cr region sums (PA_STEP_REGIONS)
+    // Block rows of the film grain model (PA_STEP_DENOISE)
+    void                      (*job_process)(void *job, int32_t index);
+    void                       *job_ptr;
 } PictureAnalysisContext;
 
 /***************************************
@@ -31,7 +59,10 @@ extern EbErrorType picture_analysis_context_ctor(
     EbBool                         denoise_flag,
     PictureAnalysisContext     **context_dbl_ptr,
     EbFifo                      *resource_coordination_results_input_fifo_ptr,
-    EbFifo                      *picture_analysis_results_output_fifo_ptr);
+    EbFifo                      *picture_analysis_results_output_fifo_ptr,
+    EbFifo                      *picture_analysis_feedback_fifo_ptr,
+    uint32_t                     segment_row_count,
+    uint32_t                     helper_count);
 
 extern void* picture_analysis_kernel(void *input_ptr);
 
@@ -202,6 +202,24 @@ EbErrorType eb_recon_picture_buffer_desc_ctor(
 
     return EB_ErrorNone;
 }
+/*****************************************
+ * eb_picture_buffer_desc_set_size
+ *  Sets the picture size, which must not
+ *  exceed the size the buffers were
+ *  allocated for. The strides are kept.
+ *****************************************/
+void eb_picture_buffer_desc_set_size(
+    EbPictureBufferDesc *picture_buffer_desc_ptr,
+    uint16_t             width,
+    uint16_t             height)
+{
+    if (picture_buffer_desc_ptr == (EbPictureBufferDesc*)EB_NULL)
+        return;
+
+    picture_buffer_desc_ptr->width = AOMMIN(width, picture_buffer_desc_ptr->max_width);
+    picture_buffer_desc_ptr->height = AOMMIN(height, picture_buffer_desc_ptr->max_height);
+}
+
 void link_Eb_to_aom_buffer_desc_8bit(
     EbPictureBufferDesc          *picBuffDsc,
     Yv12BufferConfig             *aomBuffDsc
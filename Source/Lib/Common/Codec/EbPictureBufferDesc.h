@@ -316,6 +316,11 @@ extern "C" {
         EbPtr *object_dbl_ptr,
         EbPtr  object_init_data_ptr);
 
+    extern void eb_picture_buffer_desc_set_size(
+        EbPictureBufferDesc *picture_buffer_desc_ptr,
+        uint16_t             width,
+        uint16_t             height);
+
 #ifdef __cplusplus
 }
 #endif
@@ -19,6 +19,7 @@
 #include "EbDefinitions.h"
 #include "EbPictureControlSet.h"
 #include "EbPictureBufferDesc.h"
+#include "EbSequenceControlSet.h"
 
 void *aom_memalign(size_t align, size_t size);
 void aom_free(void *memblk);
@@ -110,6 +111,186 @@ EbErrorType me_sb_results_ctor(
     return EB_ErrorNone;
 }
 #endif
+
+/******************************************************
+ * Entropy Tile Info Constructor
+ *   The first tile codes into the picture entropy
+ *   coder, the other tiles get their own bitstream.
+ *   The neighbor arrays cover tile_width x tile_height
+ *   luma samples from the origin of the tile.
+ ******************************************************/
+static EbErrorType entropy_tile_info_ctor(
+    EntropyTileInfo **tile_info_dbl_ptr,
+    EntropyCoder     *entropy_coder_ptr,
+    uint32_t          buffer_size,
+    uint16_t          tile_width,
+    uint16_t          tile_height,
+    uint16_t          subsampling_x,
+    uint16_t          subsampling_y)
+{
+    EbErrorType      return_error = EB_ErrorNone;
+    EntropyTileInfo *tile_info_ptr;
+
+    EB_MALLOC(EntropyTileInfo*, tile_info_ptr, sizeof(EntropyTileInfo), EB_N_PTR);
+    *tile_info_dbl_ptr = tile_info_ptr;
+    tile_info_ptr->max_tile_width = tile_width;
+    tile_info_ptr->max_tile_height = tile_height;
+
+    if (entropy_coder_ptr)
+        tile_info_ptr->entropy_coder_ptr = entropy_coder_ptr;
+    else {
+        return_error = entropy_coder_ctor(
+            &tile_info_ptr->entropy_coder_ptr,
+            buffer_size);
+        if (return_error == EB_ErrorInsufficientResources) {
+            return EB_ErrorInsufficientResources;
+        }
+    }
+
+    // Entropy Coding Neighbor Arrays
+    return_error = neighbor_array_unit_ctor(
+        &tile_info_ptr->mode_type_neighbor_array,
+        tile_width,
+        tile_height,
+        sizeof(uint8_t),
+        PU_NEIGHBOR_ARRAY_GRANULARITY,
+        PU_NEIGHBOR_ARRAY_GRANULARITY,
+        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
+
+    if (return_error == EB_ErrorInsufficientResources) {
+        return EB_ErrorInsufficientResources;
+    }
+
+    return_error = neighbor_array_unit_ctor(
+        &tile_info_ptr->partition_context_neighbor_array,
+        tile_width,
+        tile_height,
+        sizeof(struct PartitionContext),
+        PU_NEIGHBOR_ARRAY_GRANULARITY,
+        PU_NEIGHBOR_ARRAY_GRANULARITY,
+        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
+
+    if (return_error == EB_ErrorInsufficientResources) {
+        return EB_ErrorInsufficientResources;
+    }
+
+    return_error = neighbor_array_unit_ctor(
+        &tile_info_ptr->skip_flag_neighbor_array,
+        tile_width,
+        tile_height,
+        sizeof(uint8_t),
+        PU_NEIGHBOR_ARRAY_GRANULARITY,
+        PU_NEIGHBOR_ARRAY_GRANULARITY,
+        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
+
+    if (return_error == EB_ErrorInsufficientResources) {
+        return EB_ErrorInsufficientResources;
+    }
+
+    return_error = neighbor_array_unit_ctor(
+        &tile_info_ptr->skip_coeff_neighbor_array,
+        tile_width,
+        tile_height,
+        sizeof(uint8_t),
+        PU_NEIGHBOR_ARRAY_GRANULARITY,
+        PU_NEIGHBOR_ARRAY_GRANULARITY,
+        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
+
+    if (return_error == EB_ErrorInsufficientResources) {
+        return EB_ErrorInsufficientResources;
+    }
+    // for each 4x4
+    return_error = neighbor_array_unit_ctor(
+        &tile_info_ptr->luma_dc_sign_level_coeff_neighbor_array,
+        tile_width,
+        tile_height,
+        sizeof(uint8_t),
+        PU_NEIGHBOR_ARRAY_GRANULARITY,
+        PU_NEIGHBOR_ARRAY_GRANULARITY,
+        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
+
+    if (return_error == EB_ErrorInsufficientResources) {
+        return EB_ErrorInsufficientResources;
+    }
+    // for each 4x4, in chroma samples
+    return_error = neighbor_array_unit_ctor(
+        &tile_info_ptr->cr_dc_sign_level_coeff_neighbor_array,
+        tile_width >> subsampling_x,
+        tile_height >> subsampling_y,
+        sizeof(uint8_t),
+        PU_NEIGHBOR_ARRAY_GRANULARITY,
+        PU_NEIGHBOR_ARRAY_GRANULARITY,
+        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
+
+    if (return_error == EB_ErrorInsufficientResources) {
+        return EB_ErrorInsufficientResources;
+    }
+    // for each 4x4, in chroma samples
+    return_error = neighbor_array_unit_ctor(
+        &tile_info_ptr->cb_dc_sign_level_coeff_neighbor_array,
+        tile_width >> subsampling_x,
+        tile_height >> subsampling_y,
+        sizeof(uint8_t),
+        PU_NEIGHBOR_ARRAY_GRANULARITY,
+        PU_NEIGHBOR_ARRAY_GRANULARITY,
+        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
+
+    if (return_error == EB_ErrorInsufficientResources) {
+        return EB_ErrorInsufficientResources;
+    }
+
+    return_error = neighbor_array_unit_ctor(
+        &tile_info_ptr->inter_pred_dir_neighbor_array,
+        tile_width,
+        tile_height,
+        sizeof(uint8_t),
+        PU_NEIGHBOR_ARRAY_GRANULARITY,
+        PU_NEIGHBOR_ARRAY_GRANULARITY,
+        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
+
+    if (return_error == EB_ErrorInsufficientResources) {
+        return EB_ErrorInsufficientResources;
+    }
+
+    return_error = neighbor_array_unit_ctor(
+        &tile_info_ptr->ref_frame_type_neighbor_array,
+        tile_width,
+        tile_height,
+        sizeof(uint8_t),
+        PU_NEIGHBOR_ARRAY_GRANULARITY,
+        PU_NEIGHBOR_ARRAY_GRANULARITY,
+        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
+
+    return_error = neighbor_array_unit_ctor32(
+        &tile_info_ptr->interpolation_type_neighbor_array,
+        tile_width,
+        tile_height,
+        sizeof(uint32_t),
+        PU_NEIGHBOR_ARRAY_GRANULARITY,
+        PU_NEIGHBOR_ARRAY_GRANULARITY,
+        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
+
+    if (return_error == EB_ErrorInsufficientResources) {
+        return EB_ErrorInsufficientResources;
+    }
+
+
+
+    return_error = neighbor_array_unit_ctor(
+        &tile_info_ptr->intra_luma_mode_neighbor_array,
+        tile_width,
+        tile_height,
+        sizeof(uint8_t),
+        PU_NEIGHBOR_ARRAY_GRANULARITY,
+        PU_NEIGHBOR_ARRAY_GRANULARITY,
+        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
+    if (return_error == EB_ErrorInsufficientResources) {
+        return EB_ErrorInsufficientResources;
+    }
+
+    return EB_ErrorNone;
+}
+
 EbErrorType picture_control_set_ctor(
     EbPtr *object_dbl_ptr,
     EbPtr object_init_data_ptr)
@@ -314,6 +495,12 @@ EbErrorType picture_control_set_ctor(
 #endif
     // Mode Decision Control config
     EB_MALLOC(MdcLcuData*, object_ptr->mdc_sb_array, object_ptr->sb_total_count * sizeof(MdcLcuData), EB_N_PTR);
+    {
+        EbMdcLeafData *leaf_data_array;
+        EB_MALLOC(EbMdcLeafData*, leaf_data_array, object_ptr->sb_total_count * initDataPtr->max_block_count * sizeof(EbMdcLeafData), EB_N_PTR);
+        for (sb_index = 0; sb_index < object_ptr->sb_total_count; ++sb_index)
+            object_ptr->mdc_sb_array[sb_index].leaf_data_array = leaf_data_array + sb_index * initDataPtr->max_block_count;
+    }
     object_ptr->qp_array_stride = (uint16_t)((initDataPtr->picture_width + MIN_BLOCK_SIZE - 1) / MIN_BLOCK_SIZE);
     object_ptr->qp_array_size = ((initDataPtr->picture_width + MIN_BLOCK_SIZE - 1) / MIN_BLOCK_SIZE) *
         ((initDataPtr->picture_height + MIN_BLOCK_SIZE - 1) / MIN_BLOCK_SIZE);
@@ -763,145 +950,39 @@ EbErrorType picture_control_set_ctor(
         return EB_ErrorInsufficientResources;
     }
 #endif
-    // Entropy Coding Neighbor Arrays
-    return_error = neighbor_array_unit_ctor(
-        &object_ptr->mode_type_neighbor_array,
-        MAX_PICTURE_WIDTH_SIZE,
-        MAX_PICTURE_HEIGHT_SIZE,
-        sizeof(uint8_t),
-        PU_NEIGHBOR_ARRAY_GRANULARITY,
-        PU_NEIGHBOR_ARRAY_GRANULARITY,
-        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
-
-    if (return_error == EB_ErrorInsufficientResources) {
-        return EB_ErrorInsufficientResources;
-    }
-
-    return_error = neighbor_array_unit_ctor(
-        &object_ptr->partition_context_neighbor_array,
-        MAX_PICTURE_WIDTH_SIZE,
-        MAX_PICTURE_HEIGHT_SIZE,
-        sizeof(struct PartitionContext),
-        PU_NEIGHBOR_ARRAY_GRANULARITY,
-        PU_NEIGHBOR_ARRAY_GRANULARITY,
-        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
-
-    if (return_error == EB_ErrorInsufficientResources) {
-        return EB_ErrorInsufficientResources;
-    }
-
-    return_error = neighbor_array_unit_ctor(
-        &object_ptr->skip_flag_neighbor_array,
-        MAX_PICTURE_WIDTH_SIZE,
-        MAX_PICTURE_HEIGHT_SIZE,
-        sizeof(uint8_t),
-        PU_NEIGHBOR_ARRAY_GRANULARITY,
-        PU_NEIGHBOR_ARRAY_GRANULARITY,
-        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
-
-    if (return_error == EB_ErrorInsufficientResources) {
-        return EB_ErrorInsufficientResources;
-    }
-
-    return_error = neighbor_array_unit_ctor(
-        &object_ptr->skip_coeff_neighbor_array,
-        MAX_PICTURE_WIDTH_SIZE,
-        MAX_PICTURE_HEIGHT_SIZE,
-        sizeof(uint8_t),
-        PU_NEIGHBOR_ARRAY_GRANULARITY,
-        PU_NEIGHBOR_ARRAY_GRANULARITY,
-        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
-
-    if (return_error == EB_ErrorInsufficientResources) {
-        return EB_ErrorInsufficientResources;
-    }
-    // for each 4x4
-    return_error = neighbor_array_unit_ctor(
-        &object_ptr->luma_dc_sign_level_coeff_neighbor_array,
-        MAX_PICTURE_WIDTH_SIZE,
-        MAX_PICTURE_HEIGHT_SIZE,
-        sizeof(uint8_t),
-        PU_NEIGHBOR_ARRAY_GRANULARITY,
-        PU_NEIGHBOR_ARRAY_GRANULARITY,
-        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
-
-    if (return_error == EB_ErrorInsufficientResources) {
-        return EB_ErrorInsufficientResources;
-    }
-    // for each 4x4
-    return_error = neighbor_array_unit_ctor(
-        &object_ptr->cr_dc_sign_level_coeff_neighbor_array,
-        MAX_PICTURE_WIDTH_SIZE,
-        MAX_PICTURE_HEIGHT_SIZE,
-        sizeof(uint8_t),
-        PU_NEIGHBOR_ARRAY_GRANULARITY,
-        PU_NEIGHBOR_ARRAY_GRANULARITY,
-        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
-
-    if (return_error == EB_ErrorInsufficientResources) {
-        return EB_ErrorInsufficientResources;
-    }
-    // for each 4x4
-    return_error = neighbor_array_unit_ctor(
-        &object_ptr->cb_dc_sign_level_coeff_neighbor_array,
-        MAX_PICTURE_WIDTH_SIZE,
-        MAX_PICTURE_HEIGHT_SIZE,
-        sizeof(uint8_t),
-        PU_NEIGHBOR_ARRAY_GRANULARITY,
-        PU_NEIGHBOR_ARRAY_GRANULARITY,
-        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
-
-    if (return_error == EB_ErrorInsufficientResources) {
-        return EB_ErrorInsufficientResources;
-    }
-
-    return_error = neighbor_array_unit_ctor(
-        &object_ptr->inter_pred_dir_neighbor_array,
-        MAX_PICTURE_WIDTH_SIZE,
-        MAX_PICTURE_HEIGHT_SIZE,
-        sizeof(uint8_t),
-        PU_NEIGHBOR_ARRAY_GRANULARITY,
-        PU_NEIGHBOR_ARRAY_GRANULARITY,
-        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
-
-    if (return_error == EB_ErrorInsufficientResources) {
-        return EB_ErrorInsufficientResources;
-    }
-
-    return_error = neighbor_array_unit_ctor(
-        &object_ptr->ref_frame_type_neighbor_array,
-        MAX_PICTURE_WIDTH_SIZE,
-        MAX_PICTURE_HEIGHT_SIZE,
-        sizeof(uint8_t),
-        PU_NEIGHBOR_ARRAY_GRANULARITY,
-        PU_NEIGHBOR_ARRAY_GRANULARITY,
-        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
-
-    return_error = neighbor_array_unit_ctor32(
-        &object_ptr->interpolation_type_neighbor_array,
-        MAX_PICTURE_WIDTH_SIZE,
-        MAX_PICTURE_HEIGHT_SIZE,
-        sizeof(uint32_t),
-        PU_NEIGHBOR_ARRAY_GRANULARITY,
-        PU_NEIGHBOR_ARRAY_GRANULARITY,
-        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
-
-    if (return_error == EB_ErrorInsufficientResources) {
-        return EB_ErrorInsufficientResources;
-    }
-
-
-
-    return_error = neighbor_array_unit_ctor(
-        &object_ptr->intra_luma_mode_neighbor_array,
-        MAX_PICTURE_WIDTH_SIZE,
-        MAX_PICTURE_HEIGHT_SIZE,
-        sizeof(uint8_t),
-        PU_NEIGHBOR_ARRAY_GRANULARITY,
-        PU_NEIGHBOR_ARRAY_GRANULARITY,
-        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
-    if (return_error == EB_ErrorInsufficientResources) {
-        return EB_ErrorInsufficientResources;
+    // Entropy Coding Tiles
+    {
+        uint16_t tile_idx;
+        // The first tile also codes the single tile pictures, it covers the whole picture
+        const uint16_t picture_width = (uint16_t)(picture_sb_w * initDataPtr->sb_size_pix);
+        const uint16_t picture_height = (uint16_t)(picture_sb_h * initDataPtr->sb_size_pix);
+        const uint16_t tile_width = MIN(initDataPtr->max_tile_width, picture_width);
+        const uint16_t tile_height = MIN(initDataPtr->max_tile_height, picture_height);
+        // The tiles other than the first code into their own bitstream. A tile codes into
+        // no more than the raw size of its samples, taken at 3 planes of luma size (4:4:4,
+        // the largest chroma format) and 2 bytes per sample above 8 bit. The bitstream unit
+        // allocates a quarter of the size it is given, hence the size of a uint32_t per byte.
+        const uint32_t tile_sample_count = (uint32_t)tile_width * tile_height * 3;
+        const uint32_t tile_bytes_per_sample = initDataPtr->bit_depth > EB_8BIT ? 2 : 1;
+        const uint32_t tile_raw_size = tile_sample_count * tile_bytes_per_sample;
+        const uint32_t tile_buffer_size = MIN(SEGMENT_ENTROPY_BUFFER_SIZE, tile_raw_size * (uint32_t)sizeof(uint32_t));
+
+        object_ptr->entropy_coding_tile_count = initDataPtr->tile_row_count * initDataPtr->tile_column_count;
+        object_ptr->entropy_coding_tile_done_count = 0;
+        EB_MALLOC(EntropyTileInfo**, object_ptr->entropy_coding_info, sizeof(EntropyTileInfo*) * object_ptr->entropy_coding_tile_count, EB_N_PTR);
+        for (tile_idx = 0; tile_idx < object_ptr->entropy_coding_tile_count; ++tile_idx) {
+            return_error = entropy_tile_info_ctor(
+                &object_ptr->entropy_coding_info[tile_idx],
+                tile_idx ? (EntropyCoder*)EB_NULL : object_ptr->entropy_coder_ptr,
+                tile_buffer_size,
+                tile_idx ? tile_width : picture_width,
+                tile_idx ? tile_height : picture_height,
+                subsampling_x,
+                subsampling_y);
+            if (return_error == EB_ErrorInsufficientResources) {
+                return EB_ErrorInsufficientResources;
+            }
+        }
     }
 
     // Note - non-zero offsets are not supported (to be fixed later in DLF chroma filtering)
@@ -934,6 +1015,8 @@ EbErrorType picture_control_set_ctor(
 
     EB_CREATEMUTEX(EbHandle, object_ptr->cdef_search_mutex, sizeof(EbHandle), EB_MUTEX);
 
+    EB_CREATEMUTEX(EbHandle, object_ptr->filter_row_mutex, sizeof(EbHandle), EB_MUTEX);
+
     //object_ptr->mse_seg[0] = (uint64_t(*)[64])aom_malloc(sizeof(**object_ptr->mse_seg) *  pictureLcuWidth * pictureLcuHeight);
    // object_ptr->mse_seg[1] = (uint64_t(*)[64])aom_malloc(sizeof(**object_ptr->mse_seg) *  pictureLcuWidth * pictureLcuHeight);
    
@@ -1238,7 +1321,7 @@ EbErrorType picture_parent_control_set_ctor(
 
     int32_t ntiles[2];
     for (int32_t is_uv = 0; is_uv < 2; ++is_uv)
-        ntiles[is_uv] = object_ptr->av1_cm->rst_info[is_uv].units_per_tile; //CHKN res_tiles_in_plane
+        ntiles[is_uv] = MAX(object_ptr->av1_cm->rst_info[is_uv].units_per_tile, RESTORATION_SMALL_FRAME_MAX_UNITS); //CHKN res_tiles_in_plane
 
     assert(ntiles[1] <= ntiles[0]);
 
@@ -1279,3 +1362,65 @@ EbErrorType picture_parent_control_set_ctor(
     return return_error;
 }
 
+/**************************************
+ * picture_control_set_resize
+ *   Sets the picture size of the active
+ *   SequenceControlSet, within the size
+ *   the picture was allocated for
+ **************************************/
+void picture_control_set_resize(
+    PictureControlSet         *picture_control_set_ptr,
+    struct SequenceControlSet *sequence_control_set_ptr)
+{
+    const uint16_t picture_width = (uint16_t)sequence_control_set_ptr->luma_width;
+    const uint16_t picture_height = (uint16_t)sequence_control_set_ptr->luma_height;
+    const uint16_t picture_sb_w = (uint16_t)((picture_width + sequence_control_set_ptr->sb_size_pix - 1) / sequence_control_set_ptr->sb_size_pix);
+    const uint16_t picture_sb_h = (uint16_t)((picture_height + sequence_control_set_ptr->sb_size_pix - 1) / sequence_control_set_ptr->sb_size_pix);
+    uint16_t       sb_index;
+
+    // recon_picture32bit_ptr is always allocated
+    if (picture_control_set_ptr->recon_picture32bit_ptr->width == picture_width &&
+        picture_control_set_ptr->recon_picture32bit_ptr->height == picture_height)
+        return;
+
+    picture_control_set_ptr->sb_total_count = sequence_control_set_ptr->sb_total_count;
+
+    // SB origins in raster scan order, as in picture_control_set_ctor()
+    for (sb_index = 0; sb_index < picture_sb_w * picture_sb_h; ++sb_index) {
+        picture_control_set_ptr->sb_ptr_array[sb_index]->origin_x = (uint16_t)((sb_index % picture_sb_w) * sequence_control_set_ptr->sb_size_pix);
+        picture_control_set_ptr->sb_ptr_array[sb_index]->origin_y = (uint16_t)((sb_index / picture_sb_w) * sequence_control_set_ptr->sb_size_pix);
+    }
+
+    eb_picture_buffer_desc_set_size(picture_control_set_ptr->recon_picture_ptr, picture_width, picture_height);
+    eb_picture_buffer_desc_set_size(picture_control_set_ptr->recon_picture16bit_ptr, picture_width, picture_height);
+    eb_picture_buffer_desc_set_size(picture_control_set_ptr->recon_picture32bit_ptr, picture_width, picture_height);
+    // Not with film grain, see eb_svt_enc_reconfigure()
+    if (sequence_control_set_ptr->static_config.encoder_bit_depth > EB_8BIT)
+        eb_picture_buffer_desc_set_size(picture_control_set_ptr->input_frame16bit, picture_width, picture_height);
+}
+
+/**************************************
+ * picture_parent_control_set_resize
+ **************************************/
+void picture_parent_control_set_resize(
+    PictureParentControlSet   *picture_control_set_ptr,
+    uint16_t                   picture_width,
+    uint16_t                   picture_height)
+{
+    Av1Common *cm = picture_control_set_ptr->av1_cm;
+
+    if (cm->width == picture_width && cm->height == picture_height)
+        return;
+
+    cm->width = picture_width;
+    cm->height = picture_height;
+    cm->superres_upscaled_width = picture_width;
+    cm->superres_upscaled_height = picture_height;
+    cm->mi_cols = picture_width >> MI_SIZE_LOG2;
+    cm->mi_rows = picture_height >> MI_SIZE_LOG2;
+
+    // The unit size depends on the frame size, the units fit the buffers of
+    // picture_parent_control_set_ctor() either way
+    set_restoration_unit_size(picture_width, picture_height, 1, 1, cm->rst_info);
+    av1_set_restoration_layout(cm);
+}
@@ -13656,7 +13656,7 @@ extern "C" {
         // ME Results
         uint64_t          treeblock_variance;
         uint32_t          leaf_count;
-        EbMdcLeafData   leaf_data_array[BLOCK_MAX_COUNT_SB_128];
+        EbMdcLeafData  *leaf_data_array;    // max_block_count entries
 
     } MdcLcuData;
 
@@ -13711,6 +13711,39 @@ extern "C" {
 
     } SpeedFeatures;
 
+    /**************************************
+     * Entropy Coding Tile
+     *   State written while entropy coding one
+     *   tile. Each tile owns a copy so that the
+     *   tiles of a picture can be coded by
+     *   different Entropy Coding threads.
+     **************************************/
+    typedef struct EntropyTileInfo
+    {
+        EntropyCoder                       *entropy_coder_ptr;
+
+        // Entropy Coding Neighbor Arrays
+        NeighborArrayUnit                  *mode_type_neighbor_array;
+        NeighborArrayUnit                  *partition_context_neighbor_array;
+        NeighborArrayUnit                  *intra_luma_mode_neighbor_array;
+        NeighborArrayUnit                  *skip_flag_neighbor_array;
+        NeighborArrayUnit                  *skip_coeff_neighbor_array;
+        NeighborArrayUnit                  *luma_dc_sign_level_coeff_neighbor_array; // Stored per 4x4. 8 bit: lower 6 bits (COEFF_CONTEXT_BITS), shows if there is at least one Coef. Top 2 bit store the sign of DC as follow: 0->0,1->-1,2-> 1
+        NeighborArrayUnit                  *cr_dc_sign_level_coeff_neighbor_array; // Stored per 4x4. 8 bit: lower 6 bits(COEFF_CONTEXT_BITS), shows if there is at least one Coef. Top 2 bit store the sign of DC as follow: 0->0,1->-1,2-> 1
+        NeighborArrayUnit                  *cb_dc_sign_level_coeff_neighbor_array; // Stored per 4x4. 8 bit: lower 6 bits(COEFF_CONTEXT_BITS), shows if there is at least one Coef. Top 2 bit store the sign of DC as follow: 0->0,1->-1,2-> 1
+        NeighborArrayUnit                  *inter_pred_dir_neighbor_array;
+        NeighborArrayUnit                  *ref_frame_type_neighbor_array;
+        NeighborArrayUnit32                *interpolation_type_neighbor_array;
+
+        int32_t                             cdef_preset[4];
+        WienerInfo                          wiener_info[MAX_MB_PLANE];
+        SgrprojInfo                         sgrproj_info[MAX_MB_PLANE];
+
+        EbBool                              tile_coded;     // set under tile_group_output_mutex
+        uint16_t                            max_tile_width;  // luma samples covered by the neighbor arrays
+        uint16_t                            max_tile_height;
+    } EntropyTileInfo;
+
     typedef struct PictureControlSet
     {
         EbObjectWrapper                    *sequence_control_set_wrapper_ptr;
@@ -13741,6 +13774,9 @@ extern "C" {
         uint8_t                               ref_pic_qp_array[MAX_NUM_OF_REF_PIC_LIST];
         EB_SLICE                              ref_slice_type_array[MAX_NUM_OF_REF_PIC_LIST];
 #endif
+        // Bit per MvReferenceFrame of the reference coded last, whose rows are
+        // read as they are completed, see inter_picture_wavefront
+        uint8_t                               wavefront_ref_frame_mask;
         // GOP
         uint64_t                              picture_number;
         uint8_t                               temporal_layer_index;
@@ -13762,9 +13798,23 @@ extern "C" {
         uint32_t                              tot_seg_searched_cdef;
         EbHandle                              cdef_search_mutex;
 
+        // In-loop Filter Rows (filter_row_pipeline)
+        EbBool                                filter_row_encoded_array[MAX_LCU_ROWS];
+        uint16_t                              filter_row_encoded_count;   // SB rows posted by EncDec
+        uint16_t                              filter_row_post_count;      // EncDec results posted
+        uint16_t                              filter_row_handled_count;   // EncDec results handled by DLF
+        uint16_t                              filter_row_available_count; // SB rows received by DLF
+        uint16_t                              filter_row_final_count;     // SB rows ready for CDEF
+        uint8_t                               filter_cdef_seg_row_count;  // CDEF segment rows posted
+        EbBool                                filter_row_started;
+        EbHandle                              filter_row_mutex;
+
         uint16_t                              cdef_segments_total_count;
         uint8_t                               cdef_segments_column_count;
         uint8_t                               cdef_segments_row_count;
+        // The rows of the reference are final after CDEF, which pads them and
+        // hands them over instead of the restoration, see inter_picture_wavefront
+        EbBool                                cdef_pads_reference;
 
         uint64_t(*mse_seg[2])[TOTAL_STRENGTHS];
 
@@ -13867,18 +13917,10 @@ extern "C" {
         NeighborArrayUnit                  *amvp_mv_merge_mv_neighbor_array;
         NeighborArrayUnit                  *amvp_mv_merge_mode_type_neighbor_array;
 #endif
-        // Entropy Coding Neighbor Arrays
-        NeighborArrayUnit                  *mode_type_neighbor_array;
-        NeighborArrayUnit                  *partition_context_neighbor_array;
-        NeighborArrayUnit                  *intra_luma_mode_neighbor_array;
-        NeighborArrayUnit                  *skip_flag_neighbor_array;
-        NeighborArrayUnit                  *skip_coeff_neighbor_array;
-        NeighborArrayUnit                  *luma_dc_sign_level_coeff_neighbor_array; // Stored per 4x4. 8 bit: lower 6 bits (COEFF_CONTEXT_BITS), shows if there is at least one Coef. Top 2 bit store the sign of DC as follow: 0->0,1->-1,2-> 1
-        NeighborArrayUnit                  *cr_dc_sign_level_coeff_neighbor_array; // Stored per 4x4. 8 bit: lower 6 bits(COEFF_CONTEXT_BITS), shows if there is at least one Coef. Top 2 bit store the sign of DC as follow: 0->0,1->-1,2-> 1
-        NeighborArrayUnit                  *cb_dc_sign_level_coeff_neighbor_array; // Stored per 4x4. 8 bit: lower 6 bits(COEFF_CONTEXT_BITS), shows if there is at least one Coef. Top 2 bit store the sign of DC as follow: 0->0,1->-1,2-> 1
-        NeighborArrayUnit                  *inter_pred_dir_neighbor_array;
-        NeighborArrayUnit                  *ref_frame_type_neighbor_array;
-        NeighborArrayUnit32                *interpolation_type_neighbor_array;
+        // Entropy Coding Tiles (neighbor arrays, bitstream and CDEF / LR references of each tile)
+        EntropyTileInfo                   **entropy_coding_info;
+        uint16_t                              entropy_coding_tile_count;        // allocated tiles
+        uint16_t                              entropy_coding_tile_done_count;   // tiles of the current picture already coded
 
         ModeInfo                            **mi_grid_base; //2 SB Rows of mi Data are enough
 
@@ -13909,9 +13951,6 @@ extern "C" {
         EB_FRAME_CARACTERICTICS               scene_caracteristic_id;
 #endif
         EbBool                                limit_intra;
-        int32_t                               cdef_preset[4];
-        WienerInfo                            wiener_info[MAX_MB_PLANE];
-        SgrprojInfo                           sgrproj_info[MAX_MB_PLANE];
         SpeedFeatures sf;
         SearchSiteConfig ss_cfg;//CHKN this might be a seq based
         HashTable hash_table;
@@ -14219,6 +14258,7 @@ extern "C" {
         // Multi-modes signal(s) 
         EbPictureDepthMode                    pic_depth_mode;
         uint8_t                               loop_filter_mode;
+        EbBool                                filter_row_pipeline;        // The SB rows are streamed to the in-loop filters
         uint8_t                               intra_pred_mode;
 #if M8_SKIP_BLK
         uint8_t                               skip_sub_blks;
@@ -14405,11 +14445,16 @@ extern "C" {
         uint32_t                           sb_size_pix;   //since we still have lot of code assuming 64x64 LCU, we add a new paramter supporting both128x128 and 64x64, 
                                                           //ultimately the fixed code supporting 64x64 should be upgraded to use 128x128 and the above could be removed.
         uint32_t                           max_depth;
+        uint32_t                           max_block_count;  // entries of the per-SB MDC leaf arrays
         //EbBool                             is16bit;
         uint32_t                           ten_bit_format;
         uint32_t                           compressed_ten_bit_format;
         uint16_t                           enc_dec_segment_col;
         uint16_t                           enc_dec_segment_row;
+        uint16_t                           tile_row_count;
+        uint16_t                           tile_column_count;
+        uint16_t                           max_tile_width;   // largest tile of any picture, in luma samples
+        uint16_t                           max_tile_height;
         EbEncMode                          enc_mode;
         uint8_t                            speed_control;
         uint16_t                           film_grain_noise_level;
@@ -14660,6 +14705,16 @@ extern "C" {
         EbPtr *object_dbl_ptr,
         EbPtr  object_init_data_ptr);
 
+    // Runtime resolution changes, see eb_svt_enc_reconfigure()
+    extern void picture_control_set_resize(
+        PictureControlSet         *picture_control_set_ptr,
+        struct SequenceControlSet *sequence_control_set_ptr);
+
+    extern void picture_parent_control_set_resize(
+        PictureParentControlSet   *picture_control_set_ptr,
+        uint16_t                   picture_width,
+        uint16_t                   picture_height);
+
 #if MRP_ME
     extern EbErrorType me_sb_results_ctor(
         MeLcuResults     **objectDblPtr,
@@ -15,6 +15,7 @@
 #include "EbPictureDecisionResults.h"
 #include "EbReferenceObject.h"
 #include "EbSvtAv1ErrorCodes.h"
+#include "EbLadderContext.h"
 
 /************************************************
  * Defines
@@ -1213,6 +1214,12 @@ EbErrorType signal_derivation_multi_processes_oq(
         picture_control_set_ptr->loop_filter_mode = 0;
     }
 
+    // The rows are streamed to the filters when Encode Decode deblocks each
+    // SB, the full picture level search of the other modes needs the whole
+    // picture and keeps the picture based filters
+    picture_control_set_ptr->filter_row_pipeline = (EbBool)(picture_control_set_ptr->sequence_control_set_ptr->static_config.filter_row_pipeline &&
+        picture_control_set_ptr->loop_filter_mode <= 1);
+
     // CDEF Level                                   Settings
     // 0                                            OFF
     // 1                                            1 step refinement
@@ -3346,7 +3353,13 @@ void* picture_decision_kernel(void *input_ptr)
                 context_ptr->last_solid_color_frame_poc = 0xFFFFFFFF;
 
             if (windowAvail == EB_TRUE) {
-                if (sequence_control_set_ptr->static_config.scene_change_detection) {
+                // A ladder rendition cuts where its leader does
+                if (encode_context_ptr->ladder_rendition_ptr) {
+                    picture_control_set_ptr->scene_change_flag = eb_ladder_get_scene_change(
+                        encode_context_ptr->ladder_rendition_ptr,
+                        picture_control_set_ptr->picture_number);
+                }
+                else if (sequence_control_set_ptr->static_config.scene_change_detection) {
 
                     picture_control_set_ptr->scene_change_flag = SceneTransitionDetector(
                         context_ptr,
@@ -3370,6 +3383,16 @@ void* picture_decision_kernel(void *input_ptr)
 
             if (windowAvail == EB_TRUE || framePasseThru == EB_TRUE)
             {
+                // The ladder renditions take the scene changes of the leader
+                if (encode_context_ptr->ladder_ptr) {
+                    eb_ladder_post_scene_change(
+                        encode_context_ptr->ladder_ptr,
+                        queueEntryPtr->picture_number,
+                        picture_control_set_ptr->scene_change_flag);
+                    if (picture_control_set_ptr->end_of_sequence_flag)
+                        eb_ladder_post_end_of_sequence(encode_context_ptr->ladder_ptr);
+                }
+
                 // Place the PCS into the Pre-Assignment Buffer
                 // P.S. The Pre-Assignment Buffer is used to store a whole pre-structure
                 encode_context_ptr->pre_assignment_buffer[encode_context_ptr->pre_assignment_buffer_count] = queueEntryPtr->parent_pcs_wrapper_ptr;
@@ -3388,28 +3411,36 @@ void* picture_decision_kernel(void *input_ptr)
 
                 picture_control_set_ptr->init_pred_struct_position_flag = EB_FALSE;
 
-                picture_control_set_ptr->target_bit_rate = sequence_control_set_ptr->static_config.target_bit_rate;
+                // Rate and intra period may be changed by eb_svt_enc_reconfigure()
+                picture_control_set_ptr->target_bit_rate = encode_context_ptr->target_bit_rate;
 
                 ReleasePrevPictureFromReorderQueue(
                     encode_context_ptr);
 
+                // A new intra period starts after the next intra, right away when there was none
+                if (encode_context_ptr->active_intra_period_length != encode_context_ptr->intra_period_length &&
+                    (encode_context_ptr->intra_period_position == 0 || encode_context_ptr->active_intra_period_length == -1)) {
+                    encode_context_ptr->active_intra_period_length = encode_context_ptr->intra_period_length;
+                    encode_context_ptr->intra_period_position = 0;
+                }
+
                 // If the Intra period length is 0, then introduce an intra for every picture
-                if (sequence_control_set_ptr->intra_period_length == 0) {
+                if (encode_context_ptr->active_intra_period_length == 0) {
                     picture_control_set_ptr->cra_flag = EB_TRUE;
                 }
                 // If an #IntraPeriodLength has passed since the last Intra, then introduce a CRA or IDR based on Intra Refresh type
-                else if (sequence_control_set_ptr->intra_period_length != -1) {
+                else if (encode_context_ptr->active_intra_period_length != -1) {
                     picture_control_set_ptr->cra_flag =
                         (sequence_control_set_ptr->intra_refresh_type != CRA_REFRESH) ?
                         picture_control_set_ptr->cra_flag :
-                        (encode_context_ptr->intra_period_position == (uint32_t)sequence_control_set_ptr->intra_period_length) ?
+                        (encode_context_ptr->intra_period_position == (uint32_t)encode_context_ptr->active_intra_period_length) ?
                         EB_TRUE :
                         picture_control_set_ptr->cra_flag;
 
                     picture_control_set_ptr->idr_flag =
                         (sequence_control_set_ptr->intra_refresh_type != IDR_REFRESH) ?
                         picture_control_set_ptr->idr_flag :
-                        (encode_context_ptr->intra_period_position == (uint32_t)sequence_control_set_ptr->intra_period_length) ?
+                        (encode_context_ptr->intra_period_position == (uint32_t)encode_context_ptr->active_intra_period_length) ?
                         EB_TRUE :
                         picture_control_set_ptr->idr_flag;
 
@@ -3425,12 +3456,12 @@ void* picture_decision_kernel(void *input_ptr)
                 if (sequence_control_set_ptr->static_config.rate_control_mode)
                 {
                     // Increment the Intra Period Position
-                    encode_context_ptr->intra_period_position = (encode_context_ptr->intra_period_position == (uint32_t)sequence_control_set_ptr->intra_period_length) ? 0 : encode_context_ptr->intra_period_position + 1;
+                    encode_context_ptr->intra_period_position = (encode_context_ptr->intra_period_position == (uint32_t)encode_context_ptr->active_intra_period_length) ? 0 : encode_context_ptr->intra_period_position + 1;
                 }
                 else
                 {
                     // Increment the Intra Period Position
-                    encode_context_ptr->intra_period_position = ((encode_context_ptr->intra_period_position == (uint32_t)sequence_control_set_ptr->intra_period_length) || (picture_control_set_ptr->scene_change_flag == EB_TRUE)) ? 0 : encode_context_ptr->intra_period_position + 1;
+                    encode_context_ptr->intra_period_position = ((encode_context_ptr->intra_period_position == (uint32_t)encode_context_ptr->active_intra_period_length) || (picture_control_set_ptr->scene_change_flag == EB_TRUE)) ? 0 : encode_context_ptr->intra_period_position + 1;
                 }
 
                 // Determine if Pictures can be released from the Pre-Assignment Buffer
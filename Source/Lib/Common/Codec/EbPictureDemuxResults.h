@@ -15,7 +15,10 @@ typedef enum EbPicType
 {
     EB_PIC_INVALID = 0,
     EB_PIC_INPUT = 1,
-    EB_PIC_REFERENCE = 2
+    EB_PIC_REFERENCE = 2,
+    // The frame level data of the reference is final and its rows are
+    // being completed, see inter_picture_wavefront
+    EB_PIC_REFERENCE_ROWS = 3
 } EbPicType;
 
 /**************************************
@@ -24,6 +24,7 @@
 void av1_tile_set_col(TileInfo *tile, PictureParentControlSet * pcs_ptr, int col);
 void av1_tile_set_row(TileInfo *tile, PictureParentControlSet * pcs_ptr, int row);
 void set_tile_info(PictureParentControlSet * pcs_ptr);
+MvReferenceFrame svt_get_ref_frame_type(uint8_t list, uint8_t ref_idx);
 
 
 /************************************************
@@ -77,6 +78,57 @@ EbErrorType picture_manager_context_ctor(
     return EB_ErrorNone;
 }
 
+/************************************************
+ * Wavefront Reference Decode Order
+ *   Returns the decode order of the reference of
+ *   the picture coded last. It is the only one
+ *   the picture may start on before it is complete,
+ *   see inter_picture_wavefront
+ ************************************************/
+static uint64_t wavefront_reference_decode_order(
+    EncodeContext                 *encode_context_ptr,
+    InputQueueEntry               *inputEntryPtr,
+    PictureParentControlSet       *entryPictureControlSetPtr)
+{
+    ReferenceQueueEntry *referenceEntryPtr;
+    uint64_t             decode_order = 0;
+    uint8_t              refIdx;
+
+    for (refIdx = 0; refIdx < entryPictureControlSetPtr->ref_list0_count; ++refIdx) {
+#if MRP_ME
+        referenceEntryPtr = encode_context_ptr->reference_picture_queue[CIRCULAR_ADD(
+            ((int32_t)inputEntryPtr->reference_entry_index) - inputEntryPtr->list0_ptr->reference_list[refIdx],
+            REFERENCE_QUEUE_MAX_DEPTH)];
+#else
+        referenceEntryPtr = encode_context_ptr->reference_picture_queue[CIRCULAR_ADD(
+            ((int32_t)inputEntryPtr->reference_entry_index) - inputEntryPtr->list0_ptr->reference_list,
+            REFERENCE_QUEUE_MAX_DEPTH)];
+#endif
+        decode_order = MAX(decode_order, referenceEntryPtr->decode_order);
+    }
+
+    if (entryPictureControlSetPtr->slice_type == B_SLICE) {
+        for (refIdx = 0; refIdx < entryPictureControlSetPtr->ref_list1_count; ++refIdx) {
+#if MRP_ME
+            if (inputEntryPtr->list1_ptr->reference_list[refIdx] == (int32_t)INVALID_POC)
+                continue;
+            referenceEntryPtr = encode_context_ptr->reference_picture_queue[CIRCULAR_ADD(
+                ((int32_t)inputEntryPtr->reference_entry_index) - inputEntryPtr->list1_ptr->reference_list[refIdx],
+                REFERENCE_QUEUE_MAX_DEPTH)];
+#else
+            if (inputEntryPtr->list1_ptr->reference_list == (int32_t)INVALID_POC)
+                continue;
+            referenceEntryPtr = encode_context_ptr->reference_picture_queue[CIRCULAR_ADD(
+                ((int32_t)inputEntryPtr->reference_entry_index) - inputEntryPtr->list1_ptr->reference_list,
+                REFERENCE_QUEUE_MAX_DEPTH)];
+#endif
+            decode_order = MAX(decode_order, referenceEntryPtr->decode_order);
+        }
+    }
+
+    return decode_order;
+}
+
 
 
 
@@ -127,6 +179,7 @@ void* picture_manager_kernel(void *input_ptr)
     ReferenceQueueEntry           *referenceEntryPtr;
     uint32_t                         referenceQueueIndex;
     uint64_t                         ref_poc;
+    uint64_t                         wavefrontDecodeOrder;
     uint32_t                         depIdx;
     uint64_t                         depPoc;
     uint32_t                         depListCount;
@@ -462,6 +515,7 @@ void* picture_manager_kernel(void *input_ptr)
                 // Create Reference Queue Entry even if picture will not be referenced
                 referenceEntryPtr = encode_context_ptr->reference_picture_queue[encode_context_ptr->reference_picture_queue_tail_index];
                 referenceEntryPtr->picture_number = picture_control_set_ptr->picture_number;
+                referenceEntryPtr->decode_order = picture_control_set_ptr->decode_order;
 #if BASE_LAYER_REF
                 referenceEntryPtr->slice_type = picture_control_set_ptr->slice_type;
                 referenceEntryPtr->temporal_layer_index = picture_control_set_ptr->temporal_layer_index;
@@ -470,6 +524,7 @@ void* picture_manager_kernel(void *input_ptr)
                 referenceEntryPtr->reference_object_ptr = (EbObjectWrapper*)EB_NULL;
                 referenceEntryPtr->release_enable = EB_TRUE;
                 referenceEntryPtr->reference_available = EB_FALSE;
+                referenceEntryPtr->reference_rows_available = EB_FALSE;
 #if RC_FEEDBACK
                 referenceEntryPtr->feedback_arrived = EB_FALSE;
 #endif
@@ -535,6 +590,7 @@ void* picture_manager_kernel(void *input_ptr)
             }
             break;
 
+        case EB_PIC_REFERENCE_ROWS:
         case EB_PIC_REFERENCE:
 
             sequence_control_set_ptr = (SequenceControlSet*)inputPictureDemuxPtr->sequence_control_set_wrapper_ptr->object_ptr;
@@ -558,8 +614,11 @@ void* picture_manager_kernel(void *input_ptr)
                     // Assign the reference object if there is a match
                     referenceEntryPtr->reference_object_ptr = inputPictureDemuxPtr->reference_picture_wrapper_ptr;
 
-                    // Set the reference availability
-                    referenceEntryPtr->reference_available = EB_TRUE;
+                    // Set the reference availability, the dependent pictures wait for the rows they read
+                    if (inputPictureDemuxPtr->picture_type == EB_PIC_REFERENCE)
+                        referenceEntryPtr->reference_available = EB_TRUE;
+                    else
+                        referenceEntryPtr->reference_rows_available = EB_TRUE;
                 }
 
                 // Increment the referenceQueueIndex Iterator
@@ -574,8 +633,9 @@ void* picture_manager_kernel(void *input_ptr)
                 EB_ENC_PM_ERROR8);
 
             //keep the relase of SCS here because we still need the encodeContext strucutre here
-            // Release the Reference's SequenceControlSet
-            eb_release_object(inputPictureDemuxPtr->sequence_control_set_wrapper_ptr);
+            // Release the Reference's SequenceControlSet, held until the reference is complete
+            if (inputPictureDemuxPtr->picture_type == EB_PIC_REFERENCE)
+                eb_release_object(inputPictureDemuxPtr->sequence_control_set_wrapper_ptr);
 
             break;
 
@@ -611,6 +671,10 @@ void* picture_manager_kernel(void *input_ptr)
                     entrySequenceControlSetPtr = (SequenceControlSet*)entryPictureControlSetPtr->sequence_control_set_wrapper_ptr->object_ptr;
 
                     availabilityFlag = EB_TRUE;
+                    wavefrontDecodeOrder = wavefront_reference_decode_order(
+                        encode_context_ptr,
+                        inputEntryPtr,
+                        entryPictureControlSetPtr);
 
                     // Check RefList0 Availability
 #if MRP_ME
@@ -649,7 +713,7 @@ void* picture_manager_kernel(void *input_ptr)
                                 (sequence_control_set_ptr->static_config.rate_control_mode && entryPictureControlSetPtr->slice_type != I_SLICE
                                     && entryPictureControlSetPtr->temporal_layer_index == 0 && !referenceEntryPtr->feedback_arrived)) ? EB_FALSE :
 #endif
-                                (referenceEntryPtr->reference_available) ? EB_TRUE :   // The Reference has been completed
+                                (referenceEntryPtr->reference_available || (referenceEntryPtr->reference_rows_available && referenceEntryPtr->decode_order == wavefrontDecodeOrder)) ? EB_TRUE :   // The Reference has been completed, or it is the wavefront reference and its rows are being completed
                                 EB_FALSE;     // The Reference has not been completed
                         }
                     }
@@ -686,7 +750,7 @@ void* picture_manager_kernel(void *input_ptr)
                             (sequence_control_set_ptr->static_config.rate_control_mode && entryPictureControlSetPtr->slice_type != I_SLICE 
                                 && entryPictureControlSetPtr->temporal_layer_index == 0 && !referenceEntryPtr->feedback_arrived)) ? EB_FALSE :
 #endif
-                            (referenceEntryPtr->reference_available) ? EB_TRUE :   // The Reference has been completed
+                            (referenceEntryPtr->reference_available || (referenceEntryPtr->reference_rows_available && referenceEntryPtr->decode_order == wavefrontDecodeOrder)) ? EB_TRUE :   // The Reference has been completed, or it is the wavefront reference and its rows are being completed
                             EB_FALSE;     // The Reference has not been completed
 
                     }
@@ -733,7 +797,7 @@ void* picture_manager_kernel(void *input_ptr)
                                         (sequence_control_set_ptr->static_config.rate_control_mode && entryPictureControlSetPtr->slice_type != I_SLICE
                                             && entryPictureControlSetPtr->temporal_layer_index == 0 && !referenceEntryPtr->feedback_arrived)) ? EB_FALSE :
 #endif
-                                        (referenceEntryPtr->reference_available) ? EB_TRUE :   // The Reference has been completed
+                                        (referenceEntryPtr->reference_available || (referenceEntryPtr->reference_rows_available && referenceEntryPtr->decode_order == wavefrontDecodeOrder)) ? EB_TRUE :   // The Reference has been completed, or it is the wavefront reference and its rows are being completed
                                         EB_FALSE;     // The Reference has not been completed
                                 }
                             }
@@ -774,7 +838,7 @@ void* picture_manager_kernel(void *input_ptr)
                                     (sequence_control_set_ptr->static_config.rate_control_mode && entryPictureControlSetPtr->slice_type != I_SLICE 
                                         && entryPictureControlSetPtr->temporal_layer_index == 0 && !referenceEntryPtr->feedback_arrived)) ? EB_FALSE :
 #endif
-                                    (referenceEntryPtr->reference_available) ? EB_TRUE :   // The Reference has been completed
+                                    (referenceEntryPtr->reference_available || (referenceEntryPtr->reference_rows_available && referenceEntryPtr->decode_order == wavefrontDecodeOrder)) ? EB_TRUE :   // The Reference has been completed, or it is the wavefront reference and its rows are being completed
                                     EB_FALSE;     // The Reference has not been completed
                             }
                         }
@@ -817,6 +881,10 @@ void* picture_manager_kernel(void *input_ptr)
                         ChildPictureControlSetPtr->enc_mode = entryPictureControlSetPtr->enc_mode;
 
                         //3.make all  init for ChildPCS
+                        picture_control_set_resize(
+                            ChildPictureControlSetPtr,
+                            entrySequenceControlSetPtr);
+
                         picture_width_in_sb = (uint8_t)((entrySequenceControlSetPtr->luma_width + entrySequenceControlSetPtr->sb_size_pix - 1) / entrySequenceControlSetPtr->sb_size_pix);
                         picture_height_in_sb = (uint8_t)((entrySequenceControlSetPtr->luma_height + entrySequenceControlSetPtr->sb_size_pix - 1) / entrySequenceControlSetPtr->sb_size_pix);
 
@@ -831,17 +899,36 @@ void* picture_manager_kernel(void *input_ptr)
                         // Entropy Coding Rows
                         {
                             unsigned row_index;
+                            uint16_t tile_index;
 
                             ChildPictureControlSetPtr->entropy_coding_current_row = 0;
                             ChildPictureControlSetPtr->entropy_coding_current_available_row = 0;
                             ChildPictureControlSetPtr->entropy_coding_row_count = picture_height_in_sb;
                             ChildPictureControlSetPtr->entropy_coding_in_progress = EB_FALSE;
+                            ChildPictureControlSetPtr->entropy_coding_tile_done_count = 0;
+                            for (tile_index = 0; tile_index < ChildPictureControlSetPtr->entropy_coding_tile_count; ++tile_index)
+                                ChildPictureControlSetPtr->entropy_coding_info[tile_index]->tile_coded = EB_FALSE;
 
                             for (row_index = 0; row_index < MAX_LCU_ROWS; ++row_index) {
                                 ChildPictureControlSetPtr->entropy_coding_row_array[row_index] = EB_FALSE;
                             }
                         }
 
+                        // In-loop Filter Rows
+                        {
+                            unsigned row_index;
+
+                            ChildPictureControlSetPtr->filter_row_encoded_count = 0;
+                            ChildPictureControlSetPtr->filter_row_post_count = 0;
+                            ChildPictureControlSetPtr->filter_row_handled_count = 0;
+                            ChildPictureControlSetPtr->filter_row_available_count = 0;
+                            ChildPictureControlSetPtr->filter_row_final_count = 0;
+                            ChildPictureControlSetPtr->filter_cdef_seg_row_count = 0;
+                            ChildPictureControlSetPtr->filter_row_started = EB_FALSE;
+                            for (row_index = 0; row_index < MAX_LCU_ROWS; ++row_index)
+                                ChildPictureControlSetPtr->filter_row_encoded_array[row_index] = EB_FALSE;
+                        }
+
                         ChildPictureControlSetPtr->parent_pcs_ptr->av1_cm->pcs_ptr = ChildPictureControlSetPtr;
 
                         set_tile_info(ChildPictureControlSetPtr->parent_pcs_ptr);
@@ -910,6 +997,7 @@ void* picture_manager_kernel(void *input_ptr)
 
                         EB_MEMSET(ChildPictureControlSetPtr->ref_slice_type_array, 0, 2 * sizeof(EB_SLICE));
 #endif
+                        ChildPictureControlSetPtr->wavefront_ref_frame_mask = 0;
                         // Configure List0
                         if ((entryPictureControlSetPtr->slice_type == P_SLICE) || (entryPictureControlSetPtr->slice_type == B_SLICE)) {
 
@@ -925,6 +1013,8 @@ void* picture_manager_kernel(void *input_ptr)
 
                                     // Set the Reference Object
                                     ChildPictureControlSetPtr->ref_pic_ptr_array[REF_LIST_0][refIdx] = referenceEntryPtr->reference_object_ptr;
+                                    if (entrySequenceControlSetPtr->static_config.inter_picture_wavefront && referenceEntryPtr->decode_order == wavefrontDecodeOrder)
+                                        ChildPictureControlSetPtr->wavefront_ref_frame_mask |= 1 << svt_get_ref_frame_type(REF_LIST_0, refIdx);
 
 #if ADD_DELTA_QP_SUPPORT
                                     ChildPictureControlSetPtr->ref_pic_qp_array[REF_LIST_0][refIdx] = (uint8_t)((EbReferenceObject_t*)referenceEntryPtr->reference_object_ptr->object_ptr)->qp;
@@ -958,6 +1048,8 @@ void* picture_manager_kernel(void *input_ptr)
 
                                 // Set the Reference Object
                                 ChildPictureControlSetPtr->ref_pic_ptr_array[REF_LIST_0] = referenceEntryPtr->reference_object_ptr;
+                                if (entrySequenceControlSetPtr->static_config.inter_picture_wavefront && referenceEntryPtr->decode_order == wavefrontDecodeOrder)
+                                    ChildPictureControlSetPtr->wavefront_ref_frame_mask |= 1 << LAST_FRAME;
 
 #if ADD_DELTA_QP_SUPPORT
                                 ChildPictureControlSetPtr->ref_pic_qp_array[REF_LIST_0] = (uint8_t)((EbReferenceObject*)referenceEntryPtr->reference_object_ptr->object_ptr)->qp;
@@ -998,6 +1090,8 @@ void* picture_manager_kernel(void *input_ptr)
 
                                     // Set the Reference Object
                                     ChildPictureControlSetPtr->ref_pic_ptr_array[REF_LIST_1][refIdx] = referenceEntryPtr->reference_object_ptr;
+                                    if (entrySequenceControlSetPtr->static_config.inter_picture_wavefront && referenceEntryPtr->decode_order == wavefrontDecodeOrder)
+                                        ChildPictureControlSetPtr->wavefront_ref_frame_mask |= 1 << svt_get_ref_frame_type(REF_LIST_1, refIdx);
 
                                     ChildPictureControlSetPtr->ref_pic_qp_array[REF_LIST_1][refIdx] = (uint8_t)((EbReferenceObject*)referenceEntryPtr->reference_object_ptr->object_ptr)->qp;
                                     ChildPictureControlSetPtr->ref_slice_type_array[REF_LIST_1][refIdx] = ((EbReferenceObject*)referenceEntryPtr->reference_object_ptr->object_ptr)->slice_type;
@@ -1028,6 +1122,8 @@ void* picture_manager_kernel(void *input_ptr)
 
                                 // Set the Reference Object
                                 ChildPictureControlSetPtr->ref_pic_ptr_array[REF_LIST_1] = referenceEntryPtr->reference_object_ptr;
+                                if (entrySequenceControlSetPtr->static_config.inter_picture_wavefront && referenceEntryPtr->decode_order == wavefrontDecodeOrder)
+                                    ChildPictureControlSetPtr->wavefront_ref_frame_mask |= 1 << BWDREF_FRAME;
 
                                 ChildPictureControlSetPtr->ref_pic_qp_array[REF_LIST_1] = (uint8_t)((EbReferenceObject*)referenceEntryPtr->reference_object_ptr->object_ptr)->qp;
                                 ChildPictureControlSetPtr->ref_slice_type_array[REF_LIST_1] = ((EbReferenceObject*)referenceEntryPtr->reference_object_ptr->object_ptr)->slice_type;
@@ -1111,6 +1207,7 @@ void* picture_manager_kernel(void *input_ptr)
 
                     referenceEntryPtr->reference_object_ptr = (EbObjectWrapper*)EB_NULL;
                     referenceEntryPtr->reference_available = EB_FALSE;
+                    referenceEntryPtr->reference_rows_available = EB_FALSE;
                     referenceEntryPtr->is_used_as_reference_flag = EB_FALSE;
                 }
 
@@ -39,6 +39,7 @@ EbErrorType reference_queue_entry_ctor(
     entryPtr->picture_number = ~0u;
     entryPtr->dependent_count = 0;
     entryPtr->reference_available = EB_FALSE;
+    entryPtr->reference_rows_available = EB_FALSE;
 
     EB_MALLOC(int32_t*, entryPtr->list0.list, sizeof(int32_t) * (1 << MAX_TEMPORAL_LAYERS), EB_N_PTR);
 
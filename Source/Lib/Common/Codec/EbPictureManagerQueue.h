@@ -44,6 +44,8 @@ extern "C" {
         uint32_t         dependent_count;
         EbBool           release_enable;
         EbBool           reference_available;
+        // The rows of the reference are being completed, see EB_PIC_REFERENCE_ROWS
+        EbBool           reference_rows_available;
         uint32_t         dep_list0_count;
         uint32_t         dep_list1_count;
         DependentList    list0;
@@ -0,0 +1,283 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#include <stdio.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#include "EbPipelineStats.h"
+#include "EbThreads.h"
+#include "EbUtility.h"
+
+static const char *pipeline_stage_name[EB_PIPELINE_STAGE_COUNT] = {
+    "ResourceCoordination",
+    "PictureAnalysis",
+    "PictureDecision",
+    "MotionEstimation",
+    "InitialRateControl",
+    "SourceBasedOperations",
+    "PictureManager",
+    "RateControl",
+    "ModeDecisionConfiguration",
+    "EncDec",
+    "Dlf",
+    "Cdef",
+    "Rest",
+    "EntropyCoding",
+    "Packetization"
+};
+
+const char *eb_pipeline_stage_name(
+    EbPipelineStage stage)
+{
+    return stage < EB_PIPELINE_STAGE_COUNT ? pipeline_stage_name[stage] : "Unknown";
+}
+
+/**************************************
+ * Monotonic time in microseconds
+ **************************************/
+uint64_t eb_pipeline_stats_time_us(void)
+{
+#ifdef _WIN32
+    LARGE_INTEGER frequency, counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (uint64_t)(counter.QuadPart / frequency.QuadPart) * 1000000 +
+        (uint64_t)(counter.QuadPart % frequency.QuadPart) * 1000000 / (uint64_t)frequency.QuadPart;
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000 + (uint64_t)now.tv_nsec / 1000;
+#endif
+}
+
+static uint32_t latency_histogram_bin(uint64_t time_us)
+{
+    uint32_t bin = 0;
+
+    while (time_us > 1 && bin < EB_LATENCY_HISTOGRAM_BIN_COUNT - 1) {
+        time_us >>= 1;
+        ++bin;
+    }
+    return bin;
+}
+
+/**************************************
+ * eb_pipeline_stats_ctor
+ *   stage_process_count holds the number
+ *   of kernel threads of every stage.
+ **************************************/
+EbErrorType eb_pipeline_stats_ctor(
+    EbPipelineStats         **stats_dbl_ptr,
+    uint32_t                  level,
+    const uint32_t           *stage_process_count)
+{
+    EbPipelineStats *stats_ptr;
+    uint32_t         stage;
+    uint32_t         process_index;
+    uint32_t         task_stats_index = 0;
+
+    EB_MALLOC(EbPipelineStats*, stats_ptr, sizeof(EbPipelineStats), EB_N_PTR);
+    *stats_dbl_ptr = stats_ptr;
+
+    memset(stats_ptr, 0, sizeof(EbPipelineStats));
+    stats_ptr->level = level;
+    stats_ptr->origin_us = eb_pipeline_stats_time_us();
+
+    for (stage = 0; stage < EB_PIPELINE_STAGE_COUNT; ++stage) {
+        stats_ptr->stage_task_stats_index[stage] = stats_ptr->task_stats_total_count;
+        stats_ptr->task_stats_total_count += stage_process_count[stage];
+    }
+    stats_ptr->stage_task_stats_index[EB_PIPELINE_STAGE_COUNT] = stats_ptr->task_stats_total_count;
+
+    EB_MALLOC(EbTaskStats*, stats_ptr->task_stats_array, sizeof(EbTaskStats) * stats_ptr->task_stats_total_count, EB_N_PTR);
+    memset(stats_ptr->task_stats_array, 0, sizeof(EbTaskStats) * stats_ptr->task_stats_total_count);
+
+    for (stage = 0; stage < EB_PIPELINE_STAGE_COUNT; ++stage) {
+        for (process_index = 0; process_index < stage_process_count[stage]; ++process_index) {
+            EbTaskStats *task_stats_ptr = &stats_ptr->task_stats_array[task_stats_index++];
+            task_stats_ptr->pipeline_stats_ptr = stats_ptr;
+            task_stats_ptr->stage = stage;
+            task_stats_ptr->process_index = process_index;
+        }
+    }
+
+    if (level > 1) {
+        EB_MALLOC(EbTraceEvent*, stats_ptr->trace_event_array, sizeof(EbTraceEvent) * PIPELINE_TRACE_EVENT_COUNT, EB_N_PTR);
+        memset(stats_ptr->trace_event_array, 0, sizeof(EbTraceEvent) * PIPELINE_TRACE_EVENT_COUNT);
+    }
+
+    return EB_ErrorNone;
+}
+
+/**************************************
+ * eb_pipeline_stats_attach
+ *   Hooks the statistics of a stage to
+ *   the input EbFifo of each of its
+ *   kernel threads.
+ **************************************/
+void eb_pipeline_stats_attach(
+    EbPipelineStats          *stats_ptr,
+    EbPipelineStage           stage,
+    EbFifo                  **input_fifo_ptr_array)
+{
+    uint32_t task_stats_index;
+
+    stats_ptr->stage_input_fifo_ptr[stage] = input_fifo_ptr_array[0];
+    for (task_stats_index = stats_ptr->stage_task_stats_index[stage]; task_stats_index < stats_ptr->stage_task_stats_index[stage + 1]; ++task_stats_index)
+        input_fifo_ptr_array[task_stats_index - stats_ptr->stage_task_stats_index[stage]]->task_stats_ptr = &stats_ptr->task_stats_array[task_stats_index];
+}
+
+void eb_task_stats_start(
+    EbTaskStats              *task_stats_ptr,
+    uint32_t                  queue_depth)
+{
+    task_stats_ptr->task_active = EB_TRUE;
+    task_stats_ptr->task_start_us = eb_pipeline_stats_time_us();
+    if (queue_depth > task_stats_ptr->max_queue_depth)
+        task_stats_ptr->max_queue_depth = queue_depth;
+}
+
+void eb_task_stats_end(
+    EbTaskStats              *task_stats_ptr)
+{
+    EbPipelineStats *stats_ptr = task_stats_ptr->pipeline_stats_ptr;
+    uint64_t         task_time_us;
+
+    if (task_stats_ptr->task_active == EB_FALSE)
+        return;
+    task_stats_ptr->task_active = EB_FALSE;
+
+    task_time_us = eb_pipeline_stats_time_us() - task_stats_ptr->task_start_us;
+    task_stats_ptr->task_count++;
+    task_stats_ptr->busy_time_us += task_time_us;
+    task_stats_ptr->max_task_time_us = MAX(task_stats_ptr->max_task_time_us, task_time_us);
+    task_stats_ptr->task_time_histogram[latency_histogram_bin(task_time_us)]++;
+
+    if (stats_ptr->trace_event_array) {
+        uint32_t      event_index = (uint32_t)eb_atomic_fetch_add(&stats_ptr->trace_event_index, 1);
+        EbTraceEvent *event_ptr = &stats_ptr->trace_event_array[event_index & (PIPELINE_TRACE_EVENT_COUNT - 1)];
+
+        event_ptr->stage = (uint16_t)task_stats_ptr->stage;
+        event_ptr->process_index = (uint16_t)task_stats_ptr->process_index;
+        event_ptr->start_us = task_stats_ptr->task_start_us - stats_ptr->origin_us;
+        event_ptr->duration_us = (uint32_t)MIN(task_time_us, 0xFFFFFFFF);
+    }
+}
+
+/**************************************
+ * eb_pipeline_stats_picture_done
+ *   Called by Packetization for every
+ *   output picture.
+ **************************************/
+void eb_pipeline_stats_picture_done(
+    EbPipelineStats          *stats_ptr,
+    uint64_t                  latency_us)
+{
+    stats_ptr->picture_count++;
+    stats_ptr->max_picture_latency_us = MAX(stats_ptr->max_picture_latency_us, latency_us);
+    stats_ptr->picture_latency_histogram[latency_histogram_bin(latency_us)]++;
+}
+
+/**************************************
+ * eb_pipeline_stats_get
+ *   Sums the thread statistics of every
+ *   stage. The counters are read while
+ *   the kernels run, so the snapshot is
+ *   not atomic.
+ **************************************/
+void eb_pipeline_stats_get(
+    EbPipelineStats          *stats_ptr,
+    EbSvtAv1EncStats         *enc_stats_ptr)
+{
+    uint32_t stage;
+    uint32_t task_stats_index;
+    uint32_t bin;
+
+    memset(enc_stats_ptr, 0, sizeof(EbSvtAv1EncStats));
+    enc_stats_ptr->elapsed_time_us = eb_pipeline_stats_time_us() - stats_ptr->origin_us;
+    enc_stats_ptr->picture_count = stats_ptr->picture_count;
+    enc_stats_ptr->max_picture_latency_us = stats_ptr->max_picture_latency_us;
+    for (bin = 0; bin < EB_LATENCY_HISTOGRAM_BIN_COUNT; ++bin)
+        enc_stats_ptr->picture_latency_histogram[bin] = stats_ptr->picture_latency_histogram[bin];
+
+    for (stage = 0; stage < EB_PIPELINE_STAGE_COUNT; ++stage) {
+        EbPipelineStageStats *stage_stats_ptr = &enc_stats_ptr->stage[stage];
+
+        stage_stats_ptr->thread_count = stats_ptr->stage_task_stats_index[stage + 1] - stats_ptr->stage_task_stats_index[stage];
+        if (stats_ptr->stage_input_fifo_ptr[stage])
+            stage_stats_ptr->queue_depth = eb_fifo_get_queue_depth(stats_ptr->stage_input_fifo_ptr[stage]);
+
+        for (task_stats_index = stats_ptr->stage_task_stats_index[stage]; task_stats_index < stats_ptr->stage_task_stats_index[stage + 1]; ++task_stats_index) {
+            EbTaskStats *task_stats_ptr = &stats_ptr->task_stats_array[task_stats_index];
+
+            stage_stats_ptr->task_count += task_stats_ptr->task_count;
+            stage_stats_ptr->busy_time_us += task_stats_ptr->busy_time_us;
+            stage_stats_ptr->max_task_time_us = MAX(stage_stats_ptr->max_task_time_us, task_stats_ptr->max_task_time_us);
+            stage_stats_ptr->max_queue_depth = MAX(stage_stats_ptr->max_queue_depth, task_stats_ptr->max_queue_depth);
+            for (bin = 0; bin < EB_LATENCY_HISTOGRAM_BIN_COUNT; ++bin)
+                stage_stats_ptr->task_time_histogram[bin] += task_stats_ptr->task_time_histogram[bin];
+        }
+    }
+}
+
+/**************************************
+ * eb_pipeline_stats_write_trace
+ *   Writes the trace ring in the Chrome
+ *   trace event format: one process, one
+ *   track per kernel thread, one complete
+ *   ("X") event per task.
+ **************************************/
+EbErrorType eb_pipeline_stats_write_trace(
+    EbPipelineStats          *stats_ptr,
+    FILE                     *trace_file)
+{
+    uint32_t event_total_count;
+    uint32_t event_count;
+    uint32_t event_index;
+    uint32_t task_stats_index;
+
+    if (stats_ptr->trace_event_array == NULL)
+        return EB_ErrorBadParameter;
+
+    event_total_count = (uint32_t)eb_atomic_load(&stats_ptr->trace_event_index);
+    event_count = MIN(event_total_count, PIPELINE_TRACE_EVENT_COUNT);
+
+    fprintf(trace_file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+
+    // Name the tracks after the kernels, sorted in pipeline order
+    for (task_stats_index = 0; task_stats_index < stats_ptr->task_stats_total_count; ++task_stats_index) {
+        EbTaskStats *task_stats_ptr = &stats_ptr->task_stats_array[task_stats_index];
+
+        fprintf(trace_file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s %u\"}},\n",
+            task_stats_index ? ",\n" : "",
+            task_stats_index,
+            pipeline_stage_name[task_stats_ptr->stage],
+            task_stats_ptr->process_index);
+        fprintf(trace_file, "{\"name\":\"thread_sort_index\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"sort_index\":%u}}",
+            task_stats_index,
+            task_stats_index);
+    }
+
+    // Oldest event first
+    for (event_index = event_total_count - event_count; event_index != event_total_count; ++event_index) {
+        EbTraceEvent *event_ptr = &stats_ptr->trace_event_array[event_index & (PIPELINE_TRACE_EVENT_COUNT - 1)];
+
+        fprintf(trace_file, ",\n{\"name\":\"%s\",\"cat\":\"kernel\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%llu,\"dur\":%u}",
+            pipeline_stage_name[event_ptr->stage],
+            stats_ptr->stage_task_stats_index[event_ptr->stage] + event_ptr->process_index,
+            (unsigned long long)event_ptr->start_us,
+            event_ptr->duration_us);
+    }
+
+    fprintf(trace_file, "\n]}\n");
+
+    return EB_ErrorNone;
+}
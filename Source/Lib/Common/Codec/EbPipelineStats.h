@@ -0,0 +1,116 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#ifndef EbPipelineStats_h
+#define EbPipelineStats_h
+
+#include <stdio.h>
+#include "EbDefinitions.h"
+#include "EbSvtAv1Enc.h"
+#include "EbSystemResourceManager.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PIPELINE_TRACE_EVENT_COUNT      (1 << 16)   // Must be a power of 2
+
+    /**************************************
+     * Trace event: one task of one kernel
+     **************************************/
+    typedef struct EbTraceEvent
+    {
+        uint16_t                  stage;
+        uint16_t                  process_index;
+        uint32_t                  duration_us;
+        uint64_t                  start_us;
+    } EbTraceEvent;
+
+    /**************************************
+     * Task statistics of one kernel thread.
+     * Attached to the thread's input EbFifo
+     * and only written by that thread.
+     **************************************/
+    typedef struct EbTaskStats
+    {
+        struct EbPipelineStats   *pipeline_stats_ptr;
+        uint32_t                  stage;
+        uint32_t                  process_index;
+
+        EbBool                    task_active;
+        uint64_t                  task_start_us;
+
+        uint64_t                  task_count;
+        uint64_t                  busy_time_us;
+        uint64_t                  max_task_time_us;
+        uint64_t                  task_time_histogram[EB_LATENCY_HISTOGRAM_BIN_COUNT];
+        uint32_t                  max_queue_depth;
+    } EbTaskStats;
+
+    /**************************************
+     * Pipeline statistics of an encoder
+     **************************************/
+    typedef struct EbPipelineStats
+    {
+        uint32_t                  level;
+        uint64_t                  origin_us;
+
+        // One entry per kernel thread, grouped by stage
+        EbTaskStats              *task_stats_array;
+        uint32_t                  task_stats_total_count;
+        uint32_t                  stage_task_stats_index[EB_PIPELINE_STAGE_COUNT + 1];
+        EbFifo                   *stage_input_fifo_ptr[EB_PIPELINE_STAGE_COUNT];
+
+        // End to end picture latency, written by Packetization only
+        uint64_t                  picture_count;
+        uint64_t                  max_picture_latency_us;
+        uint64_t                  picture_latency_histogram[EB_LATENCY_HISTOGRAM_BIN_COUNT];
+
+        // Trace ring, filled when level is 2
+        EbTraceEvent             *trace_event_array;
+        volatile int32_t          trace_event_index;
+    } EbPipelineStats;
+
+    /**************************************
+     * Extern Function Declarations
+     **************************************/
+    extern uint64_t eb_pipeline_stats_time_us(void);
+
+    extern const char *eb_pipeline_stage_name(
+        EbPipelineStage           stage);
+
+    extern EbErrorType eb_pipeline_stats_ctor(
+        EbPipelineStats         **stats_dbl_ptr,
+        uint32_t                  level,
+        const uint32_t           *stage_process_count);
+
+    extern void eb_pipeline_stats_attach(
+        EbPipelineStats          *stats_ptr,
+        EbPipelineStage           stage,
+        EbFifo                  **input_fifo_ptr_array);
+
+    extern void eb_task_stats_start(
+        EbTaskStats              *task_stats_ptr,
+        uint32_t                  queue_depth);
+
+    extern void eb_task_stats_end(
+        EbTaskStats              *task_stats_ptr);
+
+    extern void eb_pipeline_stats_picture_done(
+        EbPipelineStats          *stats_ptr,
+        uint64_t                  latency_us);
+
+    extern void eb_pipeline_stats_get(
+        EbPipelineStats          *stats_ptr,
+        EbSvtAv1EncStats         *enc_stats_ptr);
+
+    extern EbErrorType eb_pipeline_stats_write_trace(
+        EbPipelineStats          *stats_ptr,
+        FILE                     *trace_file);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // EbPipelineStats_h
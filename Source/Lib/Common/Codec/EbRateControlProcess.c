@@ -17,6 +17,7 @@
 
 #include "EbDefinitions.h"
 #include "EbRateControlProcess.h"
+#include "EbPassStats.h"
 #include "EbSystemResourceManager.h"
 #include "EbSequenceControlSet.h"
 #include "EbPictureControlSet.h"
@@ -315,6 +316,7 @@ EbErrorType rate_control_context_ctor(
     for (uint32_t base_qp = 0; base_qp < MAX_REF_QP_NUM; base_qp++) {
         context_ptr->qp_scaling_map_I_SLICE[base_qp] = 0;
     }
+    context_ptr->target_rate_picture_number = 0;
 
     EB_MALLOC(RateControlIntervalParamContext  **, context_ptr->rate_control_param_queue, sizeof(RateControlIntervalParamContext  *)*PARALLEL_GOP_MAX_NUMBER, EB_N_PTR);
 
@@ -611,7 +613,15 @@ void high_level_rc_input_picture_vbr(
                 high_level_rate_control_ptr->pred_bits_ref_qpPerSw[ref_qp_table_index] = 0;
             }
 
-            bit_constraint_per_sw = high_level_rate_control_ptr->bit_constraint_per_sw * picture_control_set_ptr->frames_in_sw / (sequence_control_set_ptr->static_config.look_ahead_distance + 1);
+            // Second pass: the share of the window in the first pass complexity
+            if (encode_context_ptr->pass_stats_ptr)
+                bit_constraint_per_sw = eb_pass_stats_window_bits(
+                    encode_context_ptr->pass_stats_ptr,
+                    picture_control_set_ptr->picture_number,
+                    picture_control_set_ptr->frames_in_sw,
+                    high_level_rate_control_ptr->channel_bit_rate_per_frame);
+            else
+                bit_constraint_per_sw = high_level_rate_control_ptr->bit_constraint_per_sw * picture_control_set_ptr->frames_in_sw / (sequence_control_set_ptr->static_config.look_ahead_distance + 1);
 
             // Update the target rate for the sliding window based on the status of RC    
             if ((context_ptr->extra_bits_gen > (int64_t)(context_ptr->virtual_buffer_size * 10))) {
@@ -3401,6 +3411,46 @@ void init_rc(
         }
     }
 }
+// Switch to the target rate set by eb_svt_enc_reconfigure(), the virtual
+// buffer keeps its fullness
+static void update_rc_target_rate(
+    RateControlContext      *context_ptr,
+    PictureParentControlSet *picture_control_set_ptr,
+    SequenceControlSet      *sequence_control_set_ptr) {
+
+    HighLevelRateControlContext *high_level_rate_control_ptr = context_ptr->high_level_rate_control_ptr;
+    const uint64_t               previous_virtual_buffer_size = context_ptr->virtual_buffer_size;
+
+    context_ptr->target_rate_picture_number = picture_control_set_ptr->picture_number;
+    high_level_rate_control_ptr->target_bit_rate = picture_control_set_ptr->target_bit_rate;
+    high_level_rate_control_ptr->channel_bit_rate_per_frame = (uint64_t)MAX((int64_t)1, (int64_t)((high_level_rate_control_ptr->target_bit_rate << RC_PRECISION) / high_level_rate_control_ptr->frame_rate));
+    high_level_rate_control_ptr->channel_bit_rate_per_sw = high_level_rate_control_ptr->channel_bit_rate_per_frame * (sequence_control_set_ptr->static_config.look_ahead_distance + 1);
+    high_level_rate_control_ptr->bit_constraint_per_sw = high_level_rate_control_ptr->channel_bit_rate_per_sw;
+#if RC_UPDATE_TARGET_RATE
+    high_level_rate_control_ptr->previous_updated_bit_constraint_per_sw = high_level_rate_control_ptr->channel_bit_rate_per_sw;
+#endif
+
+    if (sequence_control_set_ptr->static_config.rate_control_mode == 2)
+        context_ptr->virtual_buffer_size = ((high_level_rate_control_ptr->target_bit_rate * 3) << RC_PRECISION) / context_ptr->frame_rate;
+    else if (sequence_control_set_ptr->static_config.rate_control_mode == 3)
+        context_ptr->virtual_buffer_size = high_level_rate_control_ptr->target_bit_rate;
+    else
+        return;
+
+    if (previous_virtual_buffer_size) {
+        context_ptr->virtual_buffer_level = context_ptr->virtual_buffer_level * (int64_t)context_ptr->virtual_buffer_size / (int64_t)previous_virtual_buffer_size;
+        context_ptr->previous_virtual_buffer_level = context_ptr->previous_virtual_buffer_level * (int64_t)context_ptr->virtual_buffer_size / (int64_t)previous_virtual_buffer_size;
+    }
+    context_ptr->virtual_buffer_level_initial_value = context_ptr->virtual_buffer_size >> 1;
+    if (sequence_control_set_ptr->static_config.rate_control_mode == 2) {
+        context_ptr->vb_fill_threshold1 = (context_ptr->virtual_buffer_size * 6) >> 3;
+        context_ptr->vb_fill_threshold2 = (context_ptr->virtual_buffer_size << 3) >> 3;
+    }
+    else {
+        context_ptr->vb_fill_threshold1 = context_ptr->virtual_buffer_level_initial_value + (context_ptr->virtual_buffer_size / 4);
+        context_ptr->vb_fill_threshold2 = context_ptr->virtual_buffer_level_initial_value + (context_ptr->virtual_buffer_size / 3);
+    }
+}
 #endif
 static const uint8_t quantizer_to_qindex[] = {
     0, 4, 8, 12, 16, 20, 24, 28, 32, 36, 40, 44, 48,
@@ -3929,6 +3979,14 @@ void* rate_control_kernel(void *input_ptr)
                     sequence_control_set_ptr);
 
             }
+            // Pictures reach Rate Control out of display order, the ones sent before the
+            // new rate do not switch back to the previous one
+            else if (picture_control_set_ptr->parent_pcs_ptr->target_bit_rate != context_ptr->high_level_rate_control_ptr->target_bit_rate &&
+                picture_control_set_ptr->picture_number > context_ptr->target_rate_picture_number)
+                update_rc_target_rate(
+                    context_ptr,
+                    picture_control_set_ptr->parent_pcs_ptr,
+                    sequence_control_set_ptr);
             if (sequence_control_set_ptr->static_config.rate_control_mode)
             {
                 picture_control_set_ptr->parent_pcs_ptr->intra_selected_org_qp = 0;
@@ -242,6 +242,9 @@ typedef struct RateControlContext
     uint32_t                           qp_scaling_map[EB_MAX_TEMPORAL_LAYERS][MAX_REF_QP_NUM];
     uint32_t                           qp_scaling_map_I_SLICE[MAX_REF_QP_NUM];
 
+    // First picture with the current target rate, see update_rc_target_rate()
+    uint64_t                           target_rate_picture_number;
+
 } RateControlContext;
 #else
 typedef struct RateControlLayerContext
@@ -8,6 +8,7 @@
 
 #include "EbPictureBufferDesc.h"
 #include "EbReferenceObject.h"
+#include "EbThreads.h"
 
 void InitializeSamplesNeighboringReferencePicture16Bit(
     EbByte  reconSamplesBufferPtr,
@@ -221,8 +222,25 @@ EbErrorType eb_reference_object_ctor(
             return EB_ErrorInsufficientResources;
     }
 #endif
+    // Per-SB statistics
+    EB_MALLOC(uint8_t*, referenceObject->intra_coded_area_sb, sizeof(uint8_t) * ((EbReferenceObjectDescInitData*)object_init_data_ptr)->sb_total_count, EB_N_PTR);
+    EB_MALLOC(uint32_t*, referenceObject->non_moving_index_array, sizeof(uint32_t) * ((EbReferenceObjectDescInitData*)object_init_data_ptr)->sb_total_count, EB_N_PTR);
+
     memset(&referenceObject->film_grain_params, 0, sizeof(referenceObject->film_grain_params));
 
+    referenceObject->hash_table.p_lookup_table = NULL;
+    referenceObject->hash_table_valid = EB_FALSE;
+    if (((EbReferenceObjectDescInitData*)object_init_data_ptr)->hash_table_enable) {
+        return_error = av1_hash_table_create(&referenceObject->hash_table);
+        if (return_error == EB_ErrorInsufficientResources)
+            return EB_ErrorInsufficientResources;
+    }
+
+    referenceObject->ready_row_count = 0;
+    referenceObject->ready_row_waiter_count = 0;
+    EB_CREATEMUTEX(EbHandle, referenceObject->ready_row_mutex, sizeof(EbHandle), EB_MUTEX);
+    EB_CREATESEMAPHORE(EbHandle, referenceObject->ready_row_semaphore, sizeof(EbHandle), EB_SEMAPHORE, 0, 0x7FFFFFFF);
+
     return EB_ErrorNone;
 }
 
@@ -269,8 +287,88 @@ EbErrorType eb_pa_reference_object_ctor(
         return EB_ErrorInsufficientResources;
     }
 
+    // Per-SB statistics
+    EB_MALLOC(uint16_t*, paReferenceObject->variance, sizeof(uint16_t) * ((EbPaReferenceObjectDescInitData*)object_init_data_ptr)->sb_total_count, EB_N_PTR);
+    EB_MALLOC(uint8_t*, paReferenceObject->y_mean, sizeof(uint8_t) * ((EbPaReferenceObjectDescInitData*)object_init_data_ptr)->sb_total_count, EB_N_PTR);
+
     return EB_ErrorNone;
 }
 
+/*****************************************
+ * eb_reference_object_set_size
+ *  Sets the picture size of a reference
+ *  taken for a resized picture
+ *****************************************/
+void eb_reference_object_set_size(
+    EbReferenceObject  *reference_object_ptr,
+    uint16_t            width,
+    uint16_t            height)
+{
+    eb_picture_buffer_desc_set_size(reference_object_ptr->reference_picture, width, height);
+    if (reference_object_ptr->reference_picture->bit_depth > EB_8BIT)
+        eb_picture_buffer_desc_set_size(reference_object_ptr->reference_picture16bit, width, height);
+}
 
+/*****************************************
+ * eb_pa_reference_object_set_size
+ *****************************************/
+void eb_pa_reference_object_set_size(
+    EbPaReferenceObject *pa_reference_object_ptr,
+    uint16_t             width,
+    uint16_t             height)
+{
+    eb_picture_buffer_desc_set_size(pa_reference_object_ptr->input_padded_picture_ptr, width, height);
+    eb_picture_buffer_desc_set_size(pa_reference_object_ptr->quarter_decimated_picture_ptr, width >> 1, height >> 1);
+    eb_picture_buffer_desc_set_size(pa_reference_object_ptr->sixteenth_decimated_picture_ptr, width >> 2, height >> 2);
+}
 
+/*****************************************
+ * eb_reference_object_reset_rows
+ *  Called once the reference is taken for
+ *  a new picture, no picture reads it yet
+ *****************************************/
+void eb_reference_object_reset_rows(
+    EbReferenceObject  *reference_object_ptr)
+{
+    eb_block_on_mutex(reference_object_ptr->ready_row_mutex);
+    reference_object_ptr->ready_row_count = 0;
+    eb_release_mutex(reference_object_ptr->ready_row_mutex);
+}
+
+/*****************************************
+ * eb_reference_object_post_rows
+ *  The rows may be posted out of order by
+ *  the threads padding the reference
+ *****************************************/
+void eb_reference_object_post_rows(
+    EbReferenceObject  *reference_object_ptr,
+    uint32_t            row_count)
+{
+    eb_block_on_mutex(reference_object_ptr->ready_row_mutex);
+    if (row_count > reference_object_ptr->ready_row_count) {
+        reference_object_ptr->ready_row_count = row_count;
+        // Wake all the waiters, each checks its own row count
+        while (reference_object_ptr->ready_row_waiter_count) {
+            reference_object_ptr->ready_row_waiter_count--;
+            eb_post_semaphore(reference_object_ptr->ready_row_semaphore);
+        }
+    }
+    eb_release_mutex(reference_object_ptr->ready_row_mutex);
+}
+
+/*****************************************
+ * eb_reference_object_wait_rows
+ *****************************************/
+void eb_reference_object_wait_rows(
+    EbReferenceObject  *reference_object_ptr,
+    uint32_t            row_count)
+{
+    eb_block_on_mutex(reference_object_ptr->ready_row_mutex);
+    while (reference_object_ptr->ready_row_count < row_count) {
+        reference_object_ptr->ready_row_waiter_count++;
+        eb_release_mutex(reference_object_ptr->ready_row_mutex);
+        eb_block_on_semaphore(reference_object_ptr->ready_row_semaphore);
+        eb_block_on_mutex(reference_object_ptr->ready_row_mutex);
+    }
+    eb_release_mutex(reference_object_ptr->ready_row_mutex);
+}
@@ -28,8 +28,8 @@ typedef struct EbReferenceObject
 #endif
     EB_SLICE                        slice_type;
     uint8_t                         intra_coded_area;//percentage of intra coded area 0-100%
-    uint8_t                         intra_coded_area_sb[MAX_NUMBER_OF_TREEBLOCKS_PER_PICTURE];//percentage of intra coded area 0-100%
-    uint32_t                        non_moving_index_array[MAX_NUMBER_OF_TREEBLOCKS_PER_PICTURE];//array to hold non-moving blocks in reference frames
+    uint8_t                        *intra_coded_area_sb;//percentage of intra coded area 0-100%
+    uint32_t                       *non_moving_index_array;//array to hold non-moving blocks in reference frames
     uint32_t                        picSampleValue[MAX_NUMBER_OF_REGIONS_IN_WIDTH][MAX_NUMBER_OF_REGIONS_IN_HEIGHT][3];// [Y U V];
 #if !DISABLE_OIS_USE
     EbBool                          penalize_skipflag;
@@ -41,10 +41,22 @@ typedef struct EbReferenceObject
     aom_film_grain_t                film_grain_params; //Film grain parameters for a reference frame
     uint32_t                        cdef_frame_strength;
     int8_t                          sg_frame_ep;
+    // Source blocks of the reference, searched by the pictures using it
+    // for exact matches in screen content
+    HashTable                       hash_table;
+    EbBool                          hash_table_valid;
+    // Luma rows final and padded, read by the pictures started before the
+    // reference is complete, see inter_picture_wavefront
+    uint32_t                        ready_row_count;
+    uint32_t                        ready_row_waiter_count;
+    EbHandle                        ready_row_mutex;
+    EbHandle                        ready_row_semaphore;
 } EbReferenceObject;
 
 typedef struct EbReferenceObjectDescInitData {
     EbPictureBufferDescInitData   reference_picture_desc_init_data;
+    uint32_t                      sb_total_count;   // 64x64 blocks of the per-SB arrays
+    EbBool                        hash_table_enable;
 } EbReferenceObjectDescInitData;
 
 typedef struct EbPaReferenceObject 
@@ -52,8 +64,8 @@ typedef struct EbPaReferenceObject
     EbPictureBufferDesc          *input_padded_picture_ptr;
     EbPictureBufferDesc          *quarter_decimated_picture_ptr;
     EbPictureBufferDesc          *sixteenth_decimated_picture_ptr;
-    uint16_t                        variance[MAX_NUMBER_OF_TREEBLOCKS_PER_PICTURE];
-    uint8_t                         y_mean[MAX_NUMBER_OF_TREEBLOCKS_PER_PICTURE];
+    uint16_t                       *variance;
+    uint8_t                        *y_mean;
     EB_SLICE                        slice_type;
     uint32_t                        dependent_pictures_count; //number of pic using this reference frame
 #if !BUG_FIX_PCS_LIVE_COUNT
@@ -70,6 +82,7 @@ typedef struct EbPaReferenceObjectDescInitData
     EbPictureBufferDescInitData   reference_picture_desc_init_data;
     EbPictureBufferDescInitData   quarter_picture_desc_init_data;
     EbPictureBufferDescInitData   sixteenth_picture_desc_init_data;
+    uint32_t                      sb_total_count;   // 64x64 blocks of the per-SB arrays
 } EbPaReferenceObjectDescInitData;
 
 /**************************************
@@ -83,5 +96,29 @@ extern EbErrorType eb_pa_reference_object_ctor(
     EbPtr *object_dbl_ptr,
     EbPtr  object_init_data_ptr);
 
+// Runtime resolution changes, see eb_svt_enc_reconfigure()
+extern void eb_reference_object_set_size(
+    EbReferenceObject  *reference_object_ptr,
+    uint16_t            width,
+    uint16_t            height);
+
+extern void eb_pa_reference_object_set_size(
+    EbPaReferenceObject *pa_reference_object_ptr,
+    uint16_t             width,
+    uint16_t             height);
+
+// Rows of a reference in progress, see inter_picture_wavefront
+extern void eb_reference_object_reset_rows(
+    EbReferenceObject  *reference_object_ptr);
+
+extern void eb_reference_object_post_rows(
+    EbReferenceObject  *reference_object_ptr,
+    uint32_t            row_count);
+
+// Blocks until the first row_count luma rows are final
+extern void eb_reference_object_wait_rows(
+    EbReferenceObject  *reference_object_ptr,
+    uint32_t            row_count);
+
 
 #endif //EbReferenceObject_h
\ No newline at end of file
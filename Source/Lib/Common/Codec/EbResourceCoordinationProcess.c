@@ -434,8 +434,10 @@ void* resource_coordination_kernel(void *input_ptr)
 
     EbObjectWrapper               *input_picture_wrapper_ptr;
     EbObjectWrapper               *reference_picture_wrapper_ptr;
+    EbPictureBufferDesc           *input_picture_ptr;
 
     uint32_t                         instance_index;
+    EbBool                           resize_flag;
     EbBool                           end_of_sequence_flag = EB_FALSE;
     uint32_t                         aspectRatio;
 
@@ -452,13 +454,16 @@ void* resource_coordination_kernel(void *input_ptr)
             context_ptr->input_buffer_fifo_ptr,
             &ebInputWrapperPtr);
         ebInputPtr = (EbBufferHeaderType*)ebInputWrapperPtr->object_ptr;
+        input_picture_ptr = (EbPictureBufferDesc*)ebInputPtr->p_buffer;
         sequence_control_set_ptr = context_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr;
 
         // If config changes occured since the last picture began encoding, then
         //   prepare a new sequence_control_set_ptr containing the new changes and update the state
         //   of the previous Active SequenceControlSet
         eb_block_on_mutex(context_ptr->sequence_control_set_instance_array[instance_index]->config_mutex);
-        if (context_ptr->sequence_control_set_instance_array[instance_index]->encode_context_ptr->initial_picture) {
+        resize_flag = EB_FALSE;
+        if (context_ptr->sequence_control_set_instance_array[instance_index]->encode_context_ptr->initial_picture ||
+            input_picture_ptr->width != sequence_control_set_ptr->luma_width || input_picture_ptr->height != sequence_control_set_ptr->luma_height) {
 
             // Update picture width, picture height, cropping right offset, cropping bottom offset, and conformance windows
             if (context_ptr->sequence_control_set_instance_array[instance_index]->encode_context_ptr->initial_picture)
@@ -484,6 +489,19 @@ void* resource_coordination_kernel(void *input_ptr)
                 input_size = context_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->luma_width * context_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->luma_height;
             }
 
+            // The picture size is stamped on the input by eb_svt_enc_send_picture(),
+            //   a new size starts a new sequence, see eb_svt_enc_reconfigure()
+            resize_flag = (EbBool)(input_picture_ptr->width != sequence_control_set_ptr->luma_width || input_picture_ptr->height != sequence_control_set_ptr->luma_height);
+            if (resize_flag) {
+                // Resized pictures are multiples of 8, no padding
+                sequence_control_set_ptr->luma_width = input_picture_ptr->width;
+                sequence_control_set_ptr->luma_height = input_picture_ptr->height;
+                sequence_control_set_ptr->chroma_width = input_picture_ptr->width >> 1;
+                sequence_control_set_ptr->chroma_height = input_picture_ptr->height >> 1;
+
+                input_size = sequence_control_set_ptr->luma_width * sequence_control_set_ptr->luma_height;
+            }
+
 
             // Copy previous Active SequenceControlSetPtr to a place holder
             previousSequenceControlSetWrapperPtr = context_ptr->sequenceControlSetActiveArray[instance_index];
@@ -527,13 +545,15 @@ void* resource_coordination_kernel(void *input_ptr)
         sequence_control_set_ptr = (SequenceControlSet*)context_ptr->sequenceControlSetActiveArray[instance_index]->object_ptr;
 
         // Init SB Params
-        if (context_ptr->sequence_control_set_instance_array[instance_index]->encode_context_ptr->initial_picture) {
+        if (context_ptr->sequence_control_set_instance_array[instance_index]->encode_context_ptr->initial_picture || resize_flag) {
             derive_input_resolution(
                 sequence_control_set_ptr,
                 input_size);
 
             sb_params_init(sequence_control_set_ptr);
             sb_geom_init(sequence_control_set_ptr);
+            if (resize_flag)
+                derive_segment_counts(sequence_control_set_ptr, sequence_control_set_ptr->luma_width, sequence_control_set_ptr->luma_height);
 
             // Sep PM mode
             sequence_control_set_ptr->pm_mode = sequence_control_set_ptr->input_resolution < INPUT_SIZE_4K_RANGE ?
@@ -571,7 +591,7 @@ void* resource_coordination_kernel(void *input_ptr)
         picture_control_set_ptr->enc_mode = sequence_control_set_ptr->static_config.enc_mode;
 
         // Keep track of the previous input for the ZZ SADs computation
-        picture_control_set_ptr->previous_picture_control_set_wrapper_ptr = (context_ptr->sequence_control_set_instance_array[instance_index]->encode_context_ptr->initial_picture) ?
+        picture_control_set_ptr->previous_picture_control_set_wrapper_ptr = (context_ptr->sequence_control_set_instance_array[instance_index]->encode_context_ptr->initial_picture || resize_flag) ?
             picture_control_set_wrapper_ptr :
             sequence_control_set_ptr->encode_context_ptr->previous_picture_control_set_wrapper_ptr;
 
@@ -596,11 +616,15 @@ void* resource_coordination_kernel(void *input_ptr)
             1);
 #endif
         // Set Picture Control Flags
-        picture_control_set_ptr->idr_flag = sequence_control_set_ptr->encode_context_ptr->initial_picture || (picture_control_set_ptr->input_ptr->pic_type == EB_AV1_KEY_PICTURE);
+        picture_control_set_ptr->idr_flag = sequence_control_set_ptr->encode_context_ptr->initial_picture || resize_flag || (picture_control_set_ptr->input_ptr->pic_type == EB_AV1_KEY_PICTURE);
         picture_control_set_ptr->cra_flag = (picture_control_set_ptr->input_ptr->pic_type == EB_AV1_INTRA_ONLY_PICTURE) ? EB_TRUE : EB_FALSE;
         picture_control_set_ptr->scene_change_flag = EB_FALSE;
         picture_control_set_ptr->qp_on_the_fly = EB_FALSE;
         picture_control_set_ptr->sb_total_count = sequence_control_set_ptr->sb_total_count;
+        picture_parent_control_set_resize(
+            picture_control_set_ptr,
+            (uint16_t)sequence_control_set_ptr->luma_width,
+            (uint16_t)sequence_control_set_ptr->luma_height);
         picture_control_set_ptr->eos_coming = (ebInputPtr->flags & (EB_BUFFERFLAG_EOS << 1)) ? EB_TRUE : EB_FALSE;
 
         if (sequence_control_set_ptr->static_config.speed_control_flag) {
@@ -674,6 +698,12 @@ void* resource_coordination_kernel(void *input_ptr)
             2);
 #endif
         ((EbPaReferenceObject*)picture_control_set_ptr->pa_reference_picture_wrapper_ptr->object_ptr)->input_padded_picture_ptr->buffer_y = picture_control_set_ptr->enhanced_picture_ptr->buffer_y;
+        // Zero-copy input pictures carry the application stride
+        ((EbPaReferenceObject*)picture_control_set_ptr->pa_reference_picture_wrapper_ptr->object_ptr)->input_padded_picture_ptr->stride_y = picture_control_set_ptr->enhanced_picture_ptr->stride_y;
+        eb_pa_reference_object_set_size(
+            (EbPaReferenceObject*)picture_control_set_ptr->pa_reference_picture_wrapper_ptr->object_ptr,
+            (uint16_t)sequence_control_set_ptr->luma_width,
+            (uint16_t)sequence_control_set_ptr->luma_height);
         // Get Empty Output Results Object
         if (picture_control_set_ptr->picture_number > 0 && (prevPictureControlSetWrapperPtr != NULL))
         {
@@ -683,6 +713,7 @@ void* resource_coordination_kernel(void *input_ptr)
                 &outputWrapperPtr);
             outputResultsPtr = (ResourceCoordinationResults*)outputWrapperPtr->object_ptr;
             outputResultsPtr->picture_control_set_wrapper_ptr = prevPictureControlSetWrapperPtr;
+            outputResultsPtr->input_type = PA_TASKS_RC_INPUT;
 
             // Post the finished Results Object
             eb_post_full_object(outputWrapperPtr);
@@ -11,11 +11,16 @@
 #ifdef __cplusplus
 extern "C" {
 #endif
+#define PA_TASKS_RC_INPUT           0
+#define PA_TASKS_PA_INPUT           1
+
     /**************************************
      * Process Results
      **************************************/
     typedef struct ResourceCoordinationResults {
         EbObjectWrapper *picture_control_set_wrapper_ptr;
+        uint32_t         input_type;
+        EbPtr            picture_analysis_context_ptr; // Picture Analysis context owning the segment job (PA_TASKS_PA_INPUT)
     } ResourceCoordinationResults;
 
     typedef struct ResourceCoordinationResultInitData {
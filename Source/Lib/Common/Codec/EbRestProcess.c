@@ -27,17 +27,26 @@
 void ReconOutput(
     PictureControlSet    *picture_control_set_ptr,
     SequenceControlSet   *sequence_control_set_ptr);
-void av1_loop_restoration_filter_frame(Yv12BufferConfig *frame,
+void av1_loop_restoration_filter_frame_init(Yv12BufferConfig *frame,
     Av1Common *cm, int32_t optimized_lr);
+void av1_loop_restoration_filter_unit_rows(const Yv12BufferConfig *frame,
+    Yv12BufferConfig *data, Av1Common *cm, int32_t plane,
+    int32_t unit_row_start, int32_t unit_row_end, int32_t *tmpbuf);
+void av1_loop_restoration_copy_rows(Yv12BufferConfig *frame, Av1Common *cm,
+    int32_t plane, int32_t row_start, int32_t row_end);
 void CopyStatisticsToRefObject(
     PictureControlSet    *picture_control_set_ptr,
     SequenceControlSet   *sequence_control_set_ptr);
 void PsnrCalculations(
     PictureControlSet    *picture_control_set_ptr,
     SequenceControlSet   *sequence_control_set_ptr);
-void PadRefAndSetFlags(
+void pad_ref_rows(
     PictureControlSet    *picture_control_set_ptr,
-    SequenceControlSet   *sequence_control_set_ptr);
+    SequenceControlSet   *sequence_control_set_ptr,
+    uint32_t              row_start,
+    uint32_t              row_end);
+void set_ref_flags(
+    PictureControlSet    *picture_control_set_ptr);
 void generate_padding(
     EbByte              src_pic,
     uint32_t            src_stride,
@@ -54,6 +63,9 @@ void restoration_seg_search(
     uint32_t                segment_index);
 void rest_finish_search(Macroblock *x, Av1Common *const cm);
 
+static void rest_process_segment(void *thread_context_ptr, void *owner_context_ptr, uint32_t segment_index);
+static void rest_fill_helper_task(void *owner_context_ptr, void *task_ptr);
+
 /******************************************************
  * Rest Context Constructor
  ******************************************************/
@@ -62,10 +74,13 @@ EbErrorType rest_context_ctor(
     EbFifo                *rest_input_fifo_ptr,
     EbFifo                *rest_output_fifo_ptr ,
     EbFifo                *picture_demux_fifo_ptr,
+    EbFifo                *rest_feedback_fifo_ptr,
     EbBool                  is16bit,
     EbColorFormat           color_format,
     uint32_t                max_input_luma_width,
-    uint32_t                max_input_luma_height
+    uint32_t                max_input_luma_height,
+    uint32_t                segment_row_count,
+    uint32_t                helper_count
    )
 {
     EbErrorType return_error = EB_ErrorNone;
@@ -77,6 +92,21 @@ EbErrorType rest_context_ctor(
     context_ptr->rest_input_fifo_ptr = rest_input_fifo_ptr;
     context_ptr->rest_output_fifo_ptr = rest_output_fifo_ptr;
     context_ptr->picture_demux_fifo_ptr = picture_demux_fifo_ptr;
+    context_ptr->rest_feedback_fifo_ptr = rest_feedback_fifo_ptr;
+
+    // Application job
+    context_ptr->segment_row_count = MAX(segment_row_count, 1);
+    context_ptr->job_pcs_ptr = (PictureControlSet*)EB_NULL;
+    return_error = eb_segment_job_ctor(
+        &context_ptr->segment_job,
+        context_ptr,
+        rest_feedback_fifo_ptr,
+        helper_count,
+        context_ptr->segment_row_count,
+        rest_process_segment,
+        rest_fill_helper_task);
+    if (return_error != EB_ErrorNone)
+        return return_error;
 
 
     {
@@ -198,6 +228,179 @@ void   get_own_recon(
 }
 
 
+/******************************************************
+ * Rest Post Ready Rows
+ *   Hands the rows of the reference over to the pictures
+ *   using it once the segments above them are padded
+ ******************************************************/
+static void rest_post_ready_rows(
+    RestContext                  *owner_ptr,
+    uint32_t                      segment_index)
+{
+    PictureControlSet  *picture_control_set_ptr = owner_ptr->job_pcs_ptr;
+    SequenceControlSet *sequence_control_set_ptr = (SequenceControlSet*)picture_control_set_ptr->sequence_control_set_wrapper_ptr->object_ptr;
+    uint32_t            picture_height_in_sb = (sequence_control_set_ptr->luma_height + sequence_control_set_ptr->sb_size_pix - 1) / sequence_control_set_ptr->sb_size_pix;
+    uint32_t            ready_segment_count = eb_segment_job_done_in_order(&owner_ptr->segment_job, segment_index);
+
+    // The posts of two threads may cross, the reference keeps the largest
+    if (ready_segment_count)
+        eb_reference_object_post_rows(
+            (EbReferenceObject*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr,
+            MIN(SEGMENT_END_IDX(ready_segment_count - 1, picture_height_in_sb, owner_ptr->segment_job.segment_count) * sequence_control_set_ptr->sb_size_pix, sequence_control_set_ptr->luma_height));
+}
+
+/******************************************************
+ * Rest Process Segment
+ *   Runs on the thread of thread_context_ptr, whose recon
+ *   copy is the input of the restoration filter
+ ******************************************************/
+static void rest_process_segment(
+    void                         *thread_context_ptr,
+    void                         *owner_context_ptr,
+    uint32_t                      segment_index)
+{
+    RestContext        *context_ptr = (RestContext*)thread_context_ptr;
+    RestContext        *owner_ptr = (RestContext*)owner_context_ptr;
+    PictureControlSet  *picture_control_set_ptr = owner_ptr->job_pcs_ptr;
+    SequenceControlSet *sequence_control_set_ptr = (SequenceControlSet*)picture_control_set_ptr->sequence_control_set_wrapper_ptr->object_ptr;
+    Av1Common          *cm = picture_control_set_ptr->parent_pcs_ptr->av1_cm;
+    uint32_t            picture_height_in_sb = (sequence_control_set_ptr->luma_height + sequence_control_set_ptr->sb_size_pix - 1) / sequence_control_set_ptr->sb_size_pix;
+    uint32_t            row_start;
+    uint32_t            row_end;
+    int32_t             plane;
+
+    switch (owner_ptr->job_step) {
+    case REST_STEP_FILTER:
+    {
+        Yv12BufferConfig org_fts;
+        eb_picture_buffer_desc_set_size(context_ptr->org_rec_frame, (uint16_t)sequence_control_set_ptr->luma_width, (uint16_t)sequence_control_set_ptr->luma_height);
+        link_eb_to_aom_buffer_desc(
+            context_ptr->org_rec_frame,
+            &org_fts);
+
+        for (plane = 0; plane < 3; ++plane) {
+            const RestorationInfo *rsi = &cm->rst_info[plane];
+            if (rsi->frame_restoration_type == RESTORE_NONE)
+                continue;
+            av1_loop_restoration_filter_unit_rows(
+                cm->frame_to_show,
+                &org_fts,
+                cm,
+                plane,
+                SEGMENT_START_IDX(segment_index, rsi->vert_units_per_tile, owner_ptr->segment_job.segment_count),
+                SEGMENT_END_IDX(segment_index, rsi->vert_units_per_tile, owner_ptr->segment_job.segment_count),
+                context_ptr->rst_tmpbuf);
+        }
+        break;
+    }
+    case REST_STEP_COPY_PAD:
+        row_start = MIN(SEGMENT_START_IDX(segment_index, picture_height_in_sb, owner_ptr->segment_job.segment_count) * sequence_control_set_ptr->sb_size_pix, sequence_control_set_ptr->luma_height);
+        row_end = MIN(SEGMENT_END_IDX(segment_index, picture_height_in_sb, owner_ptr->segment_job.segment_count) * sequence_control_set_ptr->sb_size_pix, sequence_control_set_ptr->luma_height);
+        for (plane = 0; plane < 3; ++plane) {
+            if (cm->rst_info[plane].frame_restoration_type != RESTORE_NONE)
+                av1_loop_restoration_copy_rows(
+                    cm->frame_to_show,
+                    cm,
+                    plane,
+                    plane ? row_start >> 1 : row_start,
+                    plane ? row_end >> 1 : row_end);
+        }
+        // CDEF padded the rows when they were final after it
+        if (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE && !picture_control_set_ptr->cdef_pads_reference) {
+            pad_ref_rows(
+                picture_control_set_ptr,
+                sequence_control_set_ptr,
+                row_start,
+                row_end);
+            if (sequence_control_set_ptr->static_config.inter_picture_wavefront)
+                rest_post_ready_rows(
+                    owner_ptr,
+                    segment_index);
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+/******************************************************
+ * Rest Fill Helper Task
+ *   The feedback tasks come from the pool CDEF feeds
+ *   restoration from
+ ******************************************************/
+static void rest_fill_helper_task(
+    void                         *owner_context_ptr,
+    void                         *task_ptr)
+{
+    CdefResults *helper_ptr = (CdefResults*)task_ptr;
+
+    helper_ptr->picture_control_set_wrapper_ptr = (EbObjectWrapper*)EB_NULL;
+    helper_ptr->input_type = REST_TASKS_REST_INPUT;
+    helper_ptr->rest_context_ptr = owner_context_ptr;
+}
+
+/******************************************************
+ * Rest Run Segments
+ *   Splits one step of the application of a picture in
+ *   row segments and returns when all are done, see
+ *   eb_segment_job_run()
+ ******************************************************/
+static void rest_run_segments(
+    RestContext                  *context_ptr,
+    PictureControlSet            *picture_control_set_ptr,
+    RestSegmentStep               step)
+{
+    SequenceControlSet *sequence_control_set_ptr = (SequenceControlSet*)picture_control_set_ptr->sequence_control_set_wrapper_ptr->object_ptr;
+    Av1Common          *cm = picture_control_set_ptr->parent_pcs_ptr->av1_cm;
+    uint32_t            row_count = (sequence_control_set_ptr->luma_height + sequence_control_set_ptr->sb_size_pix - 1) / sequence_control_set_ptr->sb_size_pix;
+    uint32_t            segment_count;
+    int32_t             plane;
+
+    // The filter splits the rows of restoration units
+    if (step == REST_STEP_FILTER) {
+        row_count = 1;
+        for (plane = 0; plane < 3; ++plane) {
+            if (cm->rst_info[plane].frame_restoration_type != RESTORE_NONE)
+                row_count = MAX(row_count, (uint32_t)cm->rst_info[plane].vert_units_per_tile);
+        }
+    }
+    segment_count = MIN(context_ptr->segment_row_count, row_count);
+
+    context_ptr->job_pcs_ptr = picture_control_set_ptr;
+    context_ptr->job_step = step;
+
+    eb_segment_job_run(
+        &context_ptr->segment_job,
+        segment_count);
+}
+
+/******************************************************
+ * Rest Post Reference
+ *   Posts the reference to Picture Manager
+ ******************************************************/
+static void rest_post_reference(
+    RestContext                  *context_ptr,
+    PictureControlSet            *picture_control_set_ptr,
+    EbPicType                     picture_type)
+{
+    EbObjectWrapper     *picture_demux_results_wrapper_ptr;
+    PictureDemuxResults *picture_demux_results_rtr;
+
+    // Get Empty PicMgr Results
+    eb_get_empty_object(
+        context_ptr->picture_demux_fifo_ptr,
+        &picture_demux_results_wrapper_ptr);
+
+    picture_demux_results_rtr = (PictureDemuxResults*)picture_demux_results_wrapper_ptr->object_ptr;
+    picture_demux_results_rtr->reference_picture_wrapper_ptr = picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr;
+    picture_demux_results_rtr->sequence_control_set_wrapper_ptr = picture_control_set_ptr->sequence_control_set_wrapper_ptr;
+    picture_demux_results_rtr->picture_number = picture_control_set_ptr->picture_number;
+    picture_demux_results_rtr->picture_type = picture_type;
+
+    // Post Reference Picture
+    eb_post_full_object(picture_demux_results_wrapper_ptr);
+}
+
 /******************************************************
  * Rest Kernel
  ******************************************************/
@@ -215,8 +418,6 @@ void* rest_kernel(void *input_ptr)
     //// Output
     EbObjectWrapper                       *rest_results_wrapper_ptr;
     RestResults*                          rest_results_ptr;
-    EbObjectWrapper                       *picture_demux_results_wrapper_ptr;
-    PictureDemuxResults                   *picture_demux_results_rtr;
     // SB Loop variables
 
 
@@ -228,6 +429,16 @@ void* rest_kernel(void *input_ptr)
             &cdef_results_wrapper_ptr);
 
         cdef_results_ptr = (CdefResults*)cdef_results_wrapper_ptr->object_ptr;
+
+        // Segments of the picture of another rest thread
+        if (cdef_results_ptr->input_type == REST_TASKS_REST_INPUT) {
+            eb_segment_job_help(
+                &((RestContext*)cdef_results_ptr->rest_context_ptr)->segment_job,
+                context_ptr);
+            eb_release_object(cdef_results_wrapper_ptr);
+            continue;
+        }
+
         picture_control_set_ptr = (PictureControlSet*)cdef_results_ptr->picture_control_set_wrapper_ptr->object_ptr;
         sequence_control_set_ptr = (SequenceControlSet*)picture_control_set_ptr->sequence_control_set_wrapper_ptr->object_ptr;
         uint8_t lcuSizeLog2 = (uint8_t)Log2f(sequence_control_set_ptr->sb_size_pix);
@@ -237,6 +448,9 @@ void* rest_kernel(void *input_ptr)
 
         if (sequence_control_set_ptr->enable_restoration && picture_control_set_ptr->parent_pcs_ptr->allow_intrabc == 0)
         {
+            // Frames of the size of the picture, see eb_svt_enc_reconfigure()
+            eb_picture_buffer_desc_set_size(context_ptr->trial_frame_rst, (uint16_t)sequence_control_set_ptr->luma_width, (uint16_t)sequence_control_set_ptr->luma_height);
+            eb_picture_buffer_desc_set_size(context_ptr->org_rec_frame, (uint16_t)sequence_control_set_ptr->luma_width, (uint16_t)sequence_control_set_ptr->luma_height);
             get_own_recon(sequence_control_set_ptr, picture_control_set_ptr, context_ptr, is16bit);
 
             Yv12BufferConfig cpi_source;
@@ -278,10 +492,14 @@ void* rest_kernel(void *input_ptr)
                     cm->rst_info[1].frame_restoration_type != RESTORE_NONE ||
                     cm->rst_info[2].frame_restoration_type != RESTORE_NONE)
                 {
-                    av1_loop_restoration_filter_frame(
+                    av1_loop_restoration_filter_frame_init(
                         cm->frame_to_show,
                         cm,
                         0);
+                    rest_run_segments(
+                        context_ptr,
+                        picture_control_set_ptr,
+                        REST_STEP_FILTER);
                 }
             }
             else {
@@ -302,10 +520,17 @@ void* rest_kernel(void *input_ptr)
 
 
             if (picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr != NULL) {
-                // copy stat to ref object (intra_coded_area, Luminance, Scene change detection flags)
-                CopyStatisticsToRefObject(
-                    picture_control_set_ptr,
-                    sequence_control_set_ptr);
+                EbReferenceObject *referenceObject = (EbReferenceObject*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr;
+
+                referenceObject->cdef_frame_strength = picture_control_set_ptr->parent_pcs_ptr->cdef_frame_strength;
+                referenceObject->sg_frame_ep = cm->sg_frame_ep;
+
+                // copy stat to ref object (intra_coded_area, Luminance, Scene change detection flags),
+                // Encode Decode did it when it handed the reference over, see inter_picture_wavefront
+                if (!sequence_control_set_ptr->static_config.inter_picture_wavefront)
+                    CopyStatisticsToRefObject(
+                        picture_control_set_ptr,
+                        sequence_control_set_ptr);
             }
 
             //// PSNR Calculation
@@ -315,11 +540,19 @@ void* rest_kernel(void *input_ptr)
             //        sequence_control_set_ptr);
             //}
 
-            // Pad the reference picture and set up TMVP flag and ref POC
-            if (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE)
-                PadRefAndSetFlags(
+            // Set up TMVP flag and ref POC, then copy the restored rows back and pad the reference picture
+            if (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE && !sequence_control_set_ptr->static_config.inter_picture_wavefront)
+                set_ref_flags(
+                    picture_control_set_ptr);
+
+            if (cm->rst_info[0].frame_restoration_type != RESTORE_NONE ||
+                cm->rst_info[1].frame_restoration_type != RESTORE_NONE ||
+                cm->rst_info[2].frame_restoration_type != RESTORE_NONE ||
+                picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE)
+                rest_run_segments(
+                    context_ptr,
                     picture_control_set_ptr,
-                    sequence_control_set_ptr);
+                    REST_STEP_COPY_PAD);
 #if !OPT_LOSSLESS_1
             if (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE && picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr)
             {
@@ -387,36 +620,32 @@ void* rest_kernel(void *input_ptr)
 
 
             if (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag)
-            {
+                rest_post_reference(
+                    context_ptr,
+                    picture_control_set_ptr,
+                    EB_PIC_REFERENCE);
 
-                // Get Empty PicMgr Results
-                eb_get_empty_object(
-                    context_ptr->picture_demux_fifo_ptr,
-                    &picture_demux_results_wrapper_ptr);
 
-                picture_demux_results_rtr = (PictureDemuxResults*)picture_demux_results_wrapper_ptr->object_ptr;
-                picture_demux_results_rtr->reference_picture_wrapper_ptr = picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr;
-                picture_demux_results_rtr->sequence_control_set_wrapper_ptr = picture_control_set_ptr->sequence_control_set_wrapper_ptr;
-                picture_demux_results_rtr->picture_number = picture_control_set_ptr->picture_number;
-                picture_demux_results_rtr->picture_type = EB_PIC_REFERENCE;
 
-                // Post Reference Picture
-                eb_post_full_object(picture_demux_results_wrapper_ptr);
+            // Get Empty rest Results to EC, one per tile so that the tiles are entropy coded in parallel
+            {
+                const uint16_t tile_cnt = (uint16_t)(picture_control_set_ptr->parent_pcs_ptr->av1_cm->tile_rows * picture_control_set_ptr->parent_pcs_ptr->av1_cm->tile_cols);
+                uint16_t tile_idx;
+
+                for (tile_idx = 0; tile_idx < tile_cnt; ++tile_idx) {
+                    eb_get_empty_object(
+                        context_ptr->rest_output_fifo_ptr,
+                        &rest_results_wrapper_ptr);
+                    rest_results_ptr = (struct RestResults*)rest_results_wrapper_ptr->object_ptr;
+                    rest_results_ptr->picture_control_set_wrapper_ptr = cdef_results_ptr->picture_control_set_wrapper_ptr;
+                    rest_results_ptr->completed_lcu_row_index_start = 0;
+                    rest_results_ptr->completed_lcu_row_count = ((sequence_control_set_ptr->luma_height + sequence_control_set_ptr->sb_size_pix - 1) >> lcuSizeLog2);
+                    rest_results_ptr->tile_index = tile_idx;
+                    // Post Rest Results
+                    eb_post_full_object(rest_results_wrapper_ptr);
+                }
             }
 
-
-
-            // Get Empty rest Results to EC
-            eb_get_empty_object(
-                context_ptr->rest_output_fifo_ptr,
-                &rest_results_wrapper_ptr);
-            rest_results_ptr = (struct RestResults*)rest_results_wrapper_ptr->object_ptr;
-            rest_results_ptr->picture_control_set_wrapper_ptr = cdef_results_ptr->picture_control_set_wrapper_ptr;
-            rest_results_ptr->completed_lcu_row_index_start = 0;
-            rest_results_ptr->completed_lcu_row_count = ((sequence_control_set_ptr->luma_height + sequence_control_set_ptr->sb_size_pix - 1) >> lcuSizeLog2);
-            // Post Rest Results
-            eb_post_full_object(rest_results_wrapper_ptr);
-
         }
         eb_release_mutex(picture_control_set_ptr->rest_search_mutex);
 
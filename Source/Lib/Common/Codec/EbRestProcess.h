@@ -14,6 +14,16 @@
 #include "EbUtility.h"
 #include "EbPsnr.h"
 #include "EbPictureControlSet.h"
+#include "EbSegmentJob.h"
+
+/**************************************
+ * Rest Segment Steps
+ **************************************/
+typedef enum RestSegmentStep
+{
+    REST_STEP_FILTER,       // restore the unit rows of the segment to the restoration frame
+    REST_STEP_COPY_PAD      // copy the restored rows back, then pad the rows of the reference
+} RestSegmentStep;
 
 /**************************************
  * Rest Context
@@ -23,6 +33,7 @@ typedef struct RestContext
     EbFifo                       *rest_input_fifo_ptr;
     EbFifo                       *rest_output_fifo_ptr;
     EbFifo                       *picture_demux_fifo_ptr;
+    EbFifo                       *rest_feedback_fifo_ptr;
 
     EbPictureBufferDesc          *trial_frame_rst;
 
@@ -35,7 +46,13 @@ typedef struct RestContext
                                                     // later we can have a search version that does not need the exact right recon
     int32_t *rst_tmpbuf;
 
+    // Application job of this context, the segments are shared with the
+    // helper rest threads posted through the feedback fifo
+    EbSegmentJob                  segment_job;
+    uint32_t                      segment_row_count;
 
+    PictureControlSet            *job_pcs_ptr;
+    RestSegmentStep               job_step;
 } RestContext;
 
 /**************************************
@@ -46,10 +63,13 @@ extern EbErrorType rest_context_ctor(
     EbFifo                       *rest_input_fifo_ptr,
     EbFifo                       *rest_output_fifo_ptr,
     EbFifo                      *picture_demux_fifo_ptr,
+    EbFifo                       *rest_feedback_fifo_ptr,
     EbBool                  is16bit,
     EbColorFormat           color_format,
     uint32_t                max_input_luma_width,
-    uint32_t                max_input_luma_height
+    uint32_t                max_input_luma_height,
+    uint32_t                segment_row_count,
+    uint32_t                helper_count
    );
 
 extern void* rest_kernel(void *input_ptr);
@@ -231,13 +231,33 @@ EbErrorType av1_alloc_restoration_struct(struct Av1Common *cm, RestorationInfo *
 
 
 
-    EB_MALLOC(RestorationUnitInfo *, rsi->unit_info, sizeof(*rsi->unit_info) * nunits, EB_N_PTR)
+    EB_MALLOC(RestorationUnitInfo *, rsi->unit_info, sizeof(*rsi->unit_info) * AOMMAX(nunits, RESTORATION_SMALL_FRAME_MAX_UNITS), EB_N_PTR)
 
         return EB_ErrorNone;
 
 }
 
 
+void av1_set_restoration_layout(struct Av1Common *cm) {
+    const int32_t num_planes = 3;// av1_num_planes(cm);
+
+    for (int32_t p = 0; p < num_planes; ++p) {
+        RestorationInfo *rsi = &cm->rst_info[p];
+        const AV1PixelRect tile_rect = whole_frame_rect(cm, p > 0);
+        const int32_t hpertile = count_units_in_tile(rsi->restoration_unit_size, tile_rect.right - tile_rect.left);
+        const int32_t vpertile = count_units_in_tile(rsi->restoration_unit_size, tile_rect.bottom - tile_rect.top);
+        const int32_t ss_x = p > 0 && cm->subsampling_x;
+        const int32_t plane_w = ((cm->superres_upscaled_width + ss_x) >> ss_x) + 2 * RESTORATION_EXTRA_HORZ;
+
+        rsi->units_per_tile = hpertile * vpertile;
+        rsi->horz_units_per_tile = hpertile;
+        rsi->vert_units_per_tile = vpertile;
+        rsi->boundaries.stripe_boundary_stride = ALIGN_POWER_OF_TWO(plane_w, 5);
+    }
+
+    // Single tile row, see av1_alloc_restoration_buffers()
+    cm->rst_end_stripe[0] = (RESTORATION_UNIT_OFFSET + (cm->mi_rows << MI_SIZE_LOG2) + 63) / 64;
+}
 
 static void extend_frame_lowbd(uint8_t *data, int32_t width, int32_t height, int32_t stride,
     int32_t border_horz, int32_t border_vert) {
@@ -1273,15 +1293,11 @@ static void filter_frame_on_unit(const RestorationTileLimits *limits,
         ctxt->dst_stride, ctxt->tmpbuf, rsi->optimized_lr);
 }
 
-void av1_loop_restoration_filter_frame(Yv12BufferConfig *frame,
+/* Prepares the filtering of a frame by rows of restoration units: allocates
+   cm->rst_frame and extends the planes to filter. */
+void av1_loop_restoration_filter_frame_init(Yv12BufferConfig *frame,
     Av1Common *cm, int32_t optimized_lr) {
-    // assert(!cm->all_lossless);
     const int32_t num_planes = 3;// av1_num_planes(cm);
-    typedef void(*copy_fun)(const Yv12BufferConfig *src,
-        Yv12BufferConfig *dst);
-    static const copy_fun copy_funs[3] = { aom_yv12_copy_y_c, aom_yv12_copy_u_c, aom_yv12_copy_v_c };//CHKN SSE
-
-
     Yv12BufferConfig *dst = &cm->rst_frame;
 
     const int32_t frame_width = frame->crop_widths[0];
@@ -1292,44 +1308,140 @@ void av1_loop_restoration_filter_frame(Yv12BufferConfig *frame,
         cm->byte_alignment, NULL, NULL, NULL) < 0)
         printf("Failed to allocate restoration dst buffer\n");
 
-    RestorationLineBuffers rlbs;
-    const int32_t bit_depth = cm->bit_depth;
-    const int32_t highbd = cm->use_highbitdepth;
-
     for (int32_t plane = 0; plane < num_planes; ++plane) {
         RestorationInfo *rsi = &cm->rst_info[plane];
-        RestorationType rtype = rsi->frame_restoration_type;
         rsi->optimized_lr = optimized_lr;
 
-        if (rtype == RESTORE_NONE) {
+        if (rsi->frame_restoration_type == RESTORE_NONE) {
             continue;
         }
 
         const int32_t is_uv = plane > 0;
-        const int32_t plane_width = frame->crop_widths[is_uv];
-        const int32_t plane_height = frame->crop_heights[is_uv];
-
-        extend_frame(frame->buffers[plane], plane_width, plane_height,
+        extend_frame(frame->buffers[plane], frame->crop_widths[is_uv], frame->crop_heights[is_uv],
             frame->strides[is_uv], RESTORATION_BORDER, RESTORATION_BORDER,
-            highbd);
-
-        FilterFrameCtxt ctxt;
-        ctxt.rsi = rsi;
-        ctxt.rlbs = &rlbs;
-        ctxt.cm = cm;
-        ctxt.ss_x = is_uv && cm->subsampling_x;
-        ctxt.ss_y = is_uv && cm->subsampling_y;
-        ctxt.highbd = highbd;
-        ctxt.bit_depth = bit_depth;
-        ctxt.data8 = frame->buffers[plane];
-        ctxt.dst8 = dst->buffers[plane];
-        ctxt.data_stride = frame->strides[is_uv];
-        ctxt.dst_stride = dst->strides[is_uv];
-        ctxt.tmpbuf = cm->rst_tmpbuf;
-
-        av1_foreach_rest_unit_in_frame(cm, plane, filter_frame_on_tile, filter_frame_on_unit, &ctxt);
-
-        copy_funs[plane](dst, frame);
+            cm->use_highbitdepth);
+    }
+}
+
+/* Filters the rows [unit_row_start, unit_row_end) of restoration units of a
+   plane of frame into cm->rst_frame. The filter overwrites its input around
+   the processing stripe boundaries: when data is not frame, the input rows are
+   first copied to data, so the rows of a frame can be filtered concurrently. */
+void av1_loop_restoration_filter_unit_rows(const Yv12BufferConfig *frame,
+    Yv12BufferConfig *data, Av1Common *cm, int32_t plane,
+    int32_t unit_row_start, int32_t unit_row_end, int32_t *tmpbuf) {
+    const int32_t is_uv = plane > 0;
+    const int32_t highbd = cm->use_highbitdepth;
+    const RestorationInfo *rsi = &cm->rst_info[plane];
+    const AV1PixelRect tile_rect = whole_frame_rect(cm, is_uv);
+    const int32_t tile_w = tile_rect.right - tile_rect.left;
+    const int32_t tile_h = tile_rect.bottom - tile_rect.top;
+    const int32_t unit_size = rsi->restoration_unit_size;
+    const int32_t ext_size = unit_size * 3 / 2;
+    const int32_t voffset = RESTORATION_UNIT_OFFSET >> (is_uv && cm->subsampling_y);
+    Yv12BufferConfig *dst = &cm->rst_frame;
+
+    unit_row_end = AOMMIN(unit_row_end, rsi->vert_units_per_tile);
+    if (unit_row_start >= unit_row_end)
+        return;
+
+    if (data != frame) {
+        // Rows of the units, with the rows around the stripe boundaries
+        const int32_t row_start = AOMMAX(unit_row_start * unit_size - voffset, 0) - RESTORATION_BORDER;
+        const int32_t row_end = (unit_row_end == rsi->vert_units_per_tile ? tile_h : unit_row_end * unit_size - voffset) + RESTORATION_BORDER;
+        const int32_t col_start = -(RESTORATION_BORDER + RESTORATION_EXTRA_HORZ);
+        const int32_t width = tile_w + 2 * (RESTORATION_BORDER + RESTORATION_EXTRA_HORZ);
+        const uint8_t *src8 = REAL_PTR(highbd, frame->buffers[plane]);
+        uint8_t *data8 = REAL_PTR(highbd, data->buffers[plane]);
+
+        for (int32_t row = row_start; row < row_end; ++row)
+            memcpy(data8 + ((row * data->strides[is_uv] + col_start) << highbd),
+                src8 + ((row * frame->strides[is_uv] + col_start) << highbd),
+                width << highbd);
+    }
+
+    RestorationLineBuffers rlbs;
+    FilterFrameCtxt ctxt;
+    ctxt.rsi = rsi;
+    ctxt.rlbs = &rlbs;
+    ctxt.cm = cm;
+    ctxt.ss_x = is_uv && cm->subsampling_x;
+    ctxt.ss_y = is_uv && cm->subsampling_y;
+    ctxt.highbd = highbd;
+    ctxt.bit_depth = cm->bit_depth;
+    ctxt.data8 = data->buffers[plane];
+    ctxt.dst8 = dst->buffers[plane];
+    ctxt.data_stride = data->strides[is_uv];
+    ctxt.dst_stride = dst->strides[is_uv];
+    ctxt.tmpbuf = tmpbuf;
+
+    filter_frame_on_tile(0, 0, &ctxt);
+
+    int32_t y0 = unit_row_start * unit_size;
+    for (int32_t i = unit_row_start; i < unit_row_end; ++i) {
+        int32_t remaining_h = tile_h - y0;
+        int32_t h = (remaining_h < ext_size) ? remaining_h : unit_size;
+
+        RestorationTileLimits limits;
+        limits.v_start = AOMMAX(tile_rect.top, tile_rect.top + y0 - voffset);
+        limits.v_end = tile_rect.top + y0 + h;
+        if (limits.v_end < tile_rect.bottom) limits.v_end -= voffset;
+
+        int32_t x0 = 0, j = 0;
+        while (x0 < tile_w) {
+            int32_t remaining_w = tile_w - x0;
+            int32_t w = (remaining_w < ext_size) ? remaining_w : unit_size;
+
+            limits.h_start = tile_rect.left + x0;
+            limits.h_end = tile_rect.left + x0 + w;
+
+            filter_frame_on_unit(&limits, &tile_rect, i * rsi->horz_units_per_tile + j, &ctxt);
+
+            x0 += w;
+            ++j;
+        }
+
+        y0 += h;
+    }
+}
+
+/* Copies the rows [row_start, row_end) of a filtered plane from cm->rst_frame
+   back to frame. */
+void av1_loop_restoration_copy_rows(Yv12BufferConfig *frame, Av1Common *cm,
+    int32_t plane, int32_t row_start, int32_t row_end) {
+    const int32_t is_uv = plane > 0;
+    const int32_t highbd = cm->use_highbitdepth;
+    const Yv12BufferConfig *src = &cm->rst_frame;
+    const uint8_t *src8 = REAL_PTR(highbd, src->buffers[plane]);
+    uint8_t *dst8 = REAL_PTR(highbd, frame->buffers[plane]);
+
+    row_end = AOMMIN(row_end, src->heights[is_uv]);
+    for (int32_t row = row_start; row < row_end; ++row)
+        memcpy(dst8 + ((row * frame->strides[is_uv]) << highbd),
+            src8 + ((row * src->strides[is_uv]) << highbd),
+            src->widths[is_uv] << highbd);
+}
+
+void av1_loop_restoration_filter_frame(Yv12BufferConfig *frame,
+    Av1Common *cm, int32_t optimized_lr) {
+    // assert(!cm->all_lossless);
+    const int32_t num_planes = 3;// av1_num_planes(cm);
+    typedef void(*copy_fun)(const Yv12BufferConfig *src,
+        Yv12BufferConfig *dst);
+    static const copy_fun copy_funs[3] = { aom_yv12_copy_y_c, aom_yv12_copy_u_c, aom_yv12_copy_v_c };//CHKN SSE
+
+    av1_loop_restoration_filter_frame_init(frame, cm, optimized_lr);
+
+    for (int32_t plane = 0; plane < num_planes; ++plane) {
+        const RestorationInfo *rsi = &cm->rst_info[plane];
+
+        if (rsi->frame_restoration_type == RESTORE_NONE) {
+            continue;
+        }
+
+        av1_loop_restoration_filter_unit_rows(frame, frame, cm, plane, 0, rsi->vert_units_per_tile, cm->rst_tmpbuf);
+
+        copy_funs[plane](&cm->rst_frame, frame);
     }
 }
 
@@ -1668,9 +1780,18 @@ static void save_cdef_boundary_lines(const Yv12BufferConfig *frame,
         RESTORATION_EXTRA_HORZ, use_highbd);
 }
 
+// The lines starting at row are saved by the call whose rows hold the last of
+// them, so that consecutive row ranges save each line once
+static INLINE int32_t boundary_lines_in_rows(int32_t row, int32_t lines,
+    int32_t plane_height, int32_t row_start, int32_t row_end) {
+    const int32_t last_row = AOMMIN(row + lines, plane_height) - 1;
+    return last_row >= row_start && last_row < row_end;
+}
+
 static void save_tile_row_boundary_lines(const Yv12BufferConfig *frame,
     int32_t use_highbd, int32_t plane,
-    Av1Common *cm, int32_t after_cdef) {
+    Av1Common *cm, int32_t after_cdef, int32_t luma_row_start,
+    int32_t luma_row_end) {
     const int32_t is_uv = plane > 0;
     const int32_t ss_y = is_uv && cm->subsampling_y;
     const int32_t stripe_height = RESTORATION_PROC_UNIT_SIZE >> ss_y;
@@ -1684,6 +1805,8 @@ static void save_tile_row_boundary_lines(const Yv12BufferConfig *frame,
     RestorationStripeBoundaries *boundaries = &cm->rst_info[plane].boundaries;
 
     int32_t plane_height = ROUND_POWER_OF_TWO(cm->height, ss_y);
+    const int32_t row_start = luma_row_start >> ss_y;
+    const int32_t row_end = luma_row_end >= cm->height ? plane_height : luma_row_end >> ss_y;
 
     int32_t tile_stripe;
     for (tile_stripe = 0;; ++tile_stripe) {
@@ -1705,11 +1828,13 @@ static void save_tile_row_boundary_lines(const Yv12BufferConfig *frame,
 
         if (!after_cdef) {
             // Save deblocked context where needed.
-            if (use_deblock_above) {
+            if (use_deblock_above && boundary_lines_in_rows(y0 - RESTORATION_CTX_VERT,
+                RESTORATION_CTX_VERT, plane_height, row_start, row_end)) {
                 save_deblock_boundary_lines(frame, cm, plane, y0 - RESTORATION_CTX_VERT,
                     frame_stripe, use_highbd, 1, boundaries);
             }
-            if (use_deblock_below) {
+            if (use_deblock_below && boundary_lines_in_rows(y1,
+                RESTORATION_CTX_VERT, plane_height, row_start, row_end)) {
                 save_deblock_boundary_lines(frame, cm, plane, y1, frame_stripe,
                     use_highbd, 0, boundaries);
             }
@@ -1721,11 +1846,13 @@ static void save_tile_row_boundary_lines(const Yv12BufferConfig *frame,
             //
             // In addition, we need to save copies of the outermost line within
             // the tile, rather than using data from outside the tile.
-            if (!use_deblock_above) {
+            if (!use_deblock_above && boundary_lines_in_rows(y0, 1, plane_height,
+                row_start, row_end)) {
                 save_cdef_boundary_lines(frame, cm, plane, y0, frame_stripe, use_highbd,
                     1, boundaries);
             }
-            if (!use_deblock_below) {
+            if (!use_deblock_below && boundary_lines_in_rows(y1 - 1, 1, plane_height,
+                row_start, row_end)) {
                 save_cdef_boundary_lines(frame, cm, plane, y1 - 1, frame_stripe,
                     use_highbd, 0, boundaries);
             }
@@ -1733,16 +1860,26 @@ static void save_tile_row_boundary_lines(const Yv12BufferConfig *frame,
     }
 }
 
+// Saves the boundary lines that end in the luma rows [luma_row_start,
+// luma_row_end), the rows above being saved already. Lets the deblocked lines
+// be saved as the rows are deblocked, see filter_row_pipeline.
+void av1_loop_restoration_save_boundary_rows(const Yv12BufferConfig *frame,
+    Av1Common *cm, int32_t after_cdef, int32_t luma_row_start,
+    int32_t luma_row_end) {
+    const int32_t num_planes = 3;// av1_num_planes(cm);
+    const int32_t use_highbd = cm->use_highbitdepth;
+    for (int32_t p = 0; p < num_planes; ++p) {
+        save_tile_row_boundary_lines(frame, use_highbd, p, cm, after_cdef,
+            luma_row_start, luma_row_end);
+    }
+}
+
 // For each RESTORATION_PROC_UNIT_SIZE pixel high stripe, save 4 scan
 // lines to be used as boundary in the loop restoration process. The
 // lines are saved in rst_internal.stripe_boundary_lines
 void av1_loop_restoration_save_boundary_lines(const Yv12BufferConfig *frame,
     Av1Common *cm, int32_t after_cdef) {
-    const int32_t num_planes = 3;// av1_num_planes(cm);
-    const int32_t use_highbd = cm->use_highbitdepth;
-    for (int32_t p = 0; p < num_planes; ++p) {
-        save_tile_row_boundary_lines(frame, use_highbd, p, cm, after_cdef);
-    }
+    av1_loop_restoration_save_boundary_rows(frame, cm, after_cdef, 0, cm->height);
 }
 
 
@@ -79,6 +79,9 @@ extern "C" {
     RESTORATION_PADDING))
 
 #define RESTORATION_UNITSIZE_MAX 256
+// Most units of a luma frame up to 352x288, which gets half size units, with
+// dimensions multiple of 8 (96x1056): allocated so that a resized frame fits
+#define RESTORATION_SMALL_FRAME_MAX_UNITS 34
 #define RESTORATION_UNITPELS_HORZ_MAX \
   (RESTORATION_UNITSIZE_MAX * 3 / 2 + 2 * RESTORATION_BORDER_HORZ + 16)
 #define RESTORATION_UNITPELS_VERT_MAX                                \
@@ -278,6 +281,10 @@ extern "C" {
 
     //void av1_alloc_restoration_struct(struct Av1Common *cm, RestorationInfo *rsi,
     //                                  int32_t is_uv);
+    struct Av1Common;
+    // Sets the restoration units and stripes of the frame size and unit size of
+    // cm, which must not need more than the buffers were allocated for
+    void av1_set_restoration_layout(struct Av1Common *cm);
     void extend_frame(uint8_t *data, int32_t width, int32_t height, int32_t stride,
         int32_t border_horz, int32_t border_vert, int32_t highbd);
     void decode_xq(const int32_t *xqd, int32_t *xq, const SgrParamsType *params);
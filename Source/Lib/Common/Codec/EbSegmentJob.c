@@ -0,0 +1,161 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#include "EbSegmentJob.h"
+#include "EbThreads.h"
+#include "EbUtility.h"
+
+/******************************************************
+ * Segment Job Constructor
+ ******************************************************/
+EbErrorType eb_segment_job_ctor(
+    EbSegmentJob             *job_ptr,
+    void                     *owner_context_ptr,
+    EbFifo                   *helper_fifo_ptr,
+    uint32_t                  helper_count,
+    uint32_t                  max_segment_count,
+    EbSegmentProcessFn        process_segment,
+    EbSegmentHelperTaskFn     fill_helper_task)
+{
+    job_ptr->helper_fifo_ptr = helper_fifo_ptr;
+    job_ptr->helper_count = helper_count;
+    job_ptr->helpers_in_queue = 0;
+    job_ptr->segment_count = 0;
+    job_ptr->next_segment = 0;
+    job_ptr->owner_context_ptr = owner_context_ptr;
+    job_ptr->process_segment = process_segment;
+    job_ptr->fill_helper_task = fill_helper_task;
+    job_ptr->done_array = (EbBool*)EB_NULL;
+    job_ptr->done_in_order_count = 0;
+    if (max_segment_count) {
+        EB_MALLOC(EbBool*, job_ptr->done_array, sizeof(EbBool) * max_segment_count, EB_N_PTR);
+    }
+    EB_CREATEMUTEX(EbHandle, job_ptr->mutex, sizeof(EbHandle), EB_MUTEX);
+    EB_CREATESEMAPHORE(EbHandle, job_ptr->done_semaphore, sizeof(EbHandle), EB_SEMAPHORE, 0, 0x7FFFFFFF);
+
+    return EB_ErrorNone;
+}
+
+/******************************************************
+ * Segment Job Get Next Segment
+ *   Segments are handed out in increasing order, so the
+ *   segment above is always owned by a running thread.
+ ******************************************************/
+static EbBool segment_job_get_next_segment(
+    EbSegmentJob             *job_ptr,
+    uint32_t                 *segment_index)
+{
+    EbBool found = EB_FALSE;
+
+    eb_block_on_mutex(job_ptr->mutex);
+    if (job_ptr->next_segment < job_ptr->segment_count) {
+        *segment_index = job_ptr->next_segment++;
+        found = EB_TRUE;
+    }
+    eb_release_mutex(job_ptr->mutex);
+
+    return found;
+}
+
+/******************************************************
+ * eb_segment_job_help
+ *   Processes segments of the job until none is left.
+ *   Helpers arriving after the job was drained return
+ *   immediately.
+ ******************************************************/
+void eb_segment_job_help(
+    EbSegmentJob             *job_ptr,
+    void                     *thread_context_ptr)
+{
+    uint32_t segment_index;
+
+    eb_block_on_mutex(job_ptr->mutex);
+    job_ptr->helpers_in_queue--;
+    eb_release_mutex(job_ptr->mutex);
+
+    while (segment_job_get_next_segment(job_ptr, &segment_index) == EB_TRUE) {
+        job_ptr->process_segment(thread_context_ptr, job_ptr->owner_context_ptr, segment_index);
+        eb_post_semaphore(job_ptr->done_semaphore);
+    }
+}
+
+/******************************************************
+ * eb_segment_job_done_in_order
+ *   The segments complete in any order, the count
+ *   returned only grows
+ ******************************************************/
+uint32_t eb_segment_job_done_in_order(
+    EbSegmentJob             *job_ptr,
+    uint32_t                  segment_index)
+{
+    uint32_t done_in_order_count;
+
+    eb_block_on_mutex(job_ptr->mutex);
+    job_ptr->done_array[segment_index] = EB_TRUE;
+    while (job_ptr->done_in_order_count < job_ptr->segment_count &&
+        job_ptr->done_array[job_ptr->done_in_order_count])
+        job_ptr->done_in_order_count++;
+    done_in_order_count = job_ptr->done_in_order_count;
+    eb_release_mutex(job_ptr->mutex);
+
+    return done_in_order_count;
+}
+
+/******************************************************
+ * eb_segment_job_run
+ *   Shares the segments with up to helper_count other
+ *   threads of the stage. The calling thread processes
+ *   segments too, so the job completes even when no
+ *   helper is available.
+ ******************************************************/
+void eb_segment_job_run(
+    EbSegmentJob             *job_ptr,
+    uint32_t                  segment_count)
+{
+    EbObjectWrapper *helper_wrapper_ptr;
+    uint32_t         helper_post_count = 0;
+    uint32_t         own_segment_count = 0;
+    uint32_t         segment_index;
+
+    eb_block_on_mutex(job_ptr->mutex);
+    job_ptr->segment_count = segment_count;
+    job_ptr->next_segment = 0;
+    job_ptr->done_in_order_count = 0;
+    if (job_ptr->done_array)
+        EB_MEMSET(job_ptr->done_array, 0, sizeof(EbBool) * segment_count);
+    // Helpers still queued from a previous job will pick up this one
+    if (MIN(job_ptr->helper_count, segment_count - 1) > job_ptr->helpers_in_queue) {
+        helper_post_count = MIN(job_ptr->helper_count, segment_count - 1) - job_ptr->helpers_in_queue;
+        job_ptr->helpers_in_queue += helper_post_count;
+    }
+    eb_release_mutex(job_ptr->mutex);
+
+    // The feedback tasks come from the pool the previous stage feeds this one
+    // from: waiting for one here could wait on this very thread, so the helpers
+    // that find no free task are not posted and their segments are processed below
+    for (; helper_post_count > 0; --helper_post_count) {
+        eb_get_empty_object_non_blocking(
+            job_ptr->helper_fifo_ptr,
+            &helper_wrapper_ptr);
+        if (helper_wrapper_ptr == (EbObjectWrapper*)EB_NULL)
+            break;
+        job_ptr->fill_helper_task(job_ptr->owner_context_ptr, helper_wrapper_ptr->object_ptr);
+        eb_post_full_object(helper_wrapper_ptr);
+    }
+    if (helper_post_count) {
+        eb_block_on_mutex(job_ptr->mutex);
+        job_ptr->helpers_in_queue -= helper_post_count;
+        eb_release_mutex(job_ptr->mutex);
+    }
+
+    while (segment_job_get_next_segment(job_ptr, &segment_index) == EB_TRUE) {
+        job_ptr->process_segment(job_ptr->owner_context_ptr, job_ptr->owner_context_ptr, segment_index);
+        ++own_segment_count;
+    }
+
+    // Wait for the segments taken by the helpers
+    while (own_segment_count++ < segment_count)
+        eb_block_on_semaphore(job_ptr->done_semaphore);
+}
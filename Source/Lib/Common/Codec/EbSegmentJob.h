@@ -0,0 +1,85 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#ifndef EbSegmentJob_h
+#define EbSegmentJob_h
+
+#include "EbDefinitions.h"
+#include "EbSystemResourceManager.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    // Processes one segment of the job of owner_context_ptr on the thread of
+    // thread_context_ptr, the owner itself or a helper of the same stage
+    typedef void (*EbSegmentProcessFn)(
+        void                     *thread_context_ptr,
+        void                     *owner_context_ptr,
+        uint32_t                  segment_index);
+
+    // Fills the task of the feedback fifo that sends a helper thread to the
+    // job of owner_context_ptr
+    typedef void (*EbSegmentHelperTaskFn)(
+        void                     *owner_context_ptr,
+        void                     *task_ptr);
+
+    /**************************************
+     * Segment job: one step of the work of
+     * a picture split in segments, shared
+     * by the thread running it with up to
+     * helper_count threads of its stage.
+     * The job data of the owner is set
+     * before eb_segment_job_run(), helpers
+     * only read it once they get a segment.
+     **************************************/
+    typedef struct EbSegmentJob
+    {
+        EbHandle                  mutex;
+        EbHandle                  done_semaphore;   // posted for each segment done by a helper
+        EbFifo                   *helper_fifo_ptr;
+        uint32_t                  helper_count;
+        uint32_t                  helpers_in_queue;
+        uint32_t                  segment_count;
+        uint32_t                  next_segment;
+        void                     *owner_context_ptr;
+        EbSegmentProcessFn        process_segment;
+        EbSegmentHelperTaskFn     fill_helper_task;
+        EbBool                   *done_array;       // see eb_segment_job_done_in_order()
+        uint32_t                  done_in_order_count;
+    } EbSegmentJob;
+
+    /**************************************
+     * Extern Function Declarations
+     **************************************/
+    extern EbErrorType eb_segment_job_ctor(
+        EbSegmentJob             *job_ptr,
+        void                     *owner_context_ptr,
+        EbFifo                   *helper_fifo_ptr,
+        uint32_t                  helper_count,
+        uint32_t                  max_segment_count,   // of the jobs using eb_segment_job_done_in_order(), 0 if none
+        EbSegmentProcessFn        process_segment,
+        EbSegmentHelperTaskFn     fill_helper_task);
+
+    // Returns once the segment_count segments are done
+    extern void eb_segment_job_run(
+        EbSegmentJob             *job_ptr,
+        uint32_t                  segment_count);
+
+    // Marks a segment of the running job done and returns the number of leading
+    // segments all done, so that the results are handed over in segment order
+    extern uint32_t eb_segment_job_done_in_order(
+        EbSegmentJob             *job_ptr,
+        uint32_t                  segment_index);
+
+    // Runs a helper task of the feedback fifo on the thread of thread_context_ptr
+    extern void eb_segment_job_help(
+        EbSegmentJob             *job_ptr,
+        void                     *thread_context_ptr);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // EbSegmentJob_h
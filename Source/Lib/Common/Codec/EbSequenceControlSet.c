@@ -130,7 +130,8 @@ EbErrorType eb_sequence_control_set_ctor(
 
     // Initialize SB params
     sb_params_ctor(
-        sequence_control_set_ptr);
+        sequence_control_set_ptr,
+        scsInitData);
 
     sequence_control_set_ptr->num_bits_width = 16;
     sequence_control_set_ptr->num_bits_height = 16;
@@ -342,11 +343,13 @@ EbErrorType copy_sequence_control_set(
         dst->enc_dec_segment_row_count_array[i] = src->enc_dec_segment_row_count_array[i];
     }
 
+    dst->dlf_segment_row_count = src->dlf_segment_row_count;
     dst->cdef_segment_column_count = src->cdef_segment_column_count;
     dst->cdef_segment_row_count = src->cdef_segment_row_count;
 
     dst->rest_segment_column_count = src->rest_segment_column_count;
     dst->rest_segment_row_count = src->rest_segment_row_count;
+    dst->pa_segment_row_count = src->pa_segment_row_count;
 #if BASE_LAYER_REF
     dst->extra_frames_to_ref_islice = src->extra_frames_to_ref_islice;
     dst->max_frame_window_to_ref_islice = src->max_frame_window_to_ref_islice;
@@ -370,6 +373,58 @@ extern EbErrorType derive_input_resolution(
     return return_error;
 }
 
+/************************************************
+ * Segment counts of the picture processes, set
+ * from the input size at init and again when the
+ * resolution changes, never above the counts of
+ * the largest input which size the buffers
+ ************************************************/
+void derive_segment_counts(
+    SequenceControlSet *sequence_control_set_ptr,
+    uint32_t            luma_width,
+    uint32_t            luma_height)
+{
+    uint32_t encDecSegH = (sequence_control_set_ptr->static_config.super_block_size == 128) ?
+        ((luma_height + 64) / 128) :
+        ((luma_height + 32) / 64);
+    uint32_t encDecSegW = (sequence_control_set_ptr->static_config.super_block_size == 128) ?
+        ((luma_width + 64) / 128) :
+        ((luma_width + 32) / 64);
+    uint32_t meSegH = (((luma_height + 32) / BLOCK_SIZE_64) < 6) ? 1 : 6;
+    uint32_t meSegW = (((luma_width + 32) / BLOCK_SIZE_64) < 10) ? 1 : 10;
+    uint32_t layer_index;
+
+#if CABAC_SERIAL
+    encDecSegH = 1;
+    encDecSegW = 1;
+#endif
+
+    for (layer_index = 0; layer_index < MAX_TEMPORAL_LAYERS; ++layer_index) {
+        // ME segments
+        sequence_control_set_ptr->me_segment_row_count_array[layer_index] = meSegH;
+        sequence_control_set_ptr->me_segment_column_count_array[layer_index] = meSegW;
+
+        // EncDec segments
+        sequence_control_set_ptr->enc_dec_segment_row_count_array[layer_index] = encDecSegH;
+        sequence_control_set_ptr->enc_dec_segment_col_count_array[layer_index] = encDecSegW;
+    }
+
+    sequence_control_set_ptr->cdef_segment_column_count = meSegW;
+    sequence_control_set_ptr->cdef_segment_row_count = meSegH;
+
+    //since restoration unit size is same for Luma and Chroma, Luma segments and chroma segments do not correspond to the same area!
+    //to keep proper processing, segments have to be configured based on chroma resolution.
+    uint32_t unit_size = 256;
+    uint32_t rest_seg_w = MAX((luma_width / 2 + (unit_size >> 1)) / unit_size, 1);
+    uint32_t rest_seg_h = MAX((luma_height / 2 + (unit_size >> 1)) / unit_size, 1);
+    sequence_control_set_ptr->rest_segment_column_count = MIN(rest_seg_w, 6);
+    sequence_control_set_ptr->rest_segment_row_count = MIN(rest_seg_h, 4);
+
+    // Picture Analysis is split for the pictures of 4K and above only
+    uint32_t paSegH = (luma_height + 32) / BLOCK_SIZE_64;
+    sequence_control_set_ptr->pa_segment_row_count = (paSegH < 32) ? 1 : MIN(paSegH, 8);
+}
+
 EbErrorType eb_sequence_control_set_instance_ctor(
     EbSequenceControlSetInstance **object_dbl_ptr)
 {
@@ -388,6 +443,8 @@ EbErrorType eb_sequence_control_set_instance_ctor(
     scsInitData.encode_context_ptr = (*object_dbl_ptr)->encode_context_ptr;
 
     scsInitData.sb_size = 64;
+    scsInitData.max_picture_width = 0;
+    scsInitData.max_picture_height = 0;
 
     return_error = eb_sequence_control_set_ctor(
         (void **) &(*object_dbl_ptr)->sequence_control_set_ptr,
@@ -403,11 +460,21 @@ EbErrorType eb_sequence_control_set_instance_ctor(
 }
 
 extern EbErrorType sb_params_ctor(
-    SequenceControlSet *sequence_control_set_ptr) {
+    SequenceControlSet           *sequence_control_set_ptr,
+    EbSequenceControlSetInitData *scs_init_data_ptr) {
 
     EbErrorType return_error = EB_ErrorNone;
+    uint32_t    max_picture_width = MAX_PICTURE_WIDTH_SIZE;
+    uint32_t    max_picture_height = MAX_PICTURE_HEIGHT_SIZE;
 
-    EB_MALLOC(SbParams*, sequence_control_set_ptr->sb_params_array, sizeof(SbParams) * ((MAX_PICTURE_WIDTH_SIZE + sequence_control_set_ptr->sb_sz - 1) / sequence_control_set_ptr->sb_sz) * ((MAX_PICTURE_HEIGHT_SIZE + sequence_control_set_ptr->sb_sz - 1) / sequence_control_set_ptr->sb_sz), EB_N_PTR);
+    if (scs_init_data_ptr && scs_init_data_ptr->max_picture_width && scs_init_data_ptr->max_picture_height) {
+        max_picture_width = scs_init_data_ptr->max_picture_width;
+        max_picture_height = scs_init_data_ptr->max_picture_height;
+    }
+
+    EB_MALLOC(SbParams*, sequence_control_set_ptr->sb_params_array, sizeof(SbParams) * ((max_picture_width + sequence_control_set_ptr->sb_sz - 1) / sequence_control_set_ptr->sb_sz) * ((max_picture_height + sequence_control_set_ptr->sb_sz - 1) / sequence_control_set_ptr->sb_sz), EB_N_PTR);
+    // Allocated by the first sb_geom_init()
+    sequence_control_set_ptr->sb_geom = (SbGeom*)EB_NULL;
     return return_error;
 }
 
@@ -420,7 +487,9 @@ extern EbErrorType sb_params_init(
     uint16_t    md_scan_block_index;
     uint8_t   pictureLcuWidth = (uint8_t)((sequence_control_set_ptr->luma_width + sequence_control_set_ptr->sb_sz - 1) / sequence_control_set_ptr->sb_sz);
     uint8_t    pictureLcuHeight = (uint8_t)((sequence_control_set_ptr->luma_height + sequence_control_set_ptr->sb_sz - 1) / sequence_control_set_ptr->sb_sz);
-    EB_MALLOC(SbParams*, sequence_control_set_ptr->sb_params_array, sizeof(SbParams) * pictureLcuWidth * pictureLcuHeight, EB_N_PTR);
+
+    // sb_params_array is allocated by sb_params_ctor() for the largest picture,
+    // this runs again when the resolution changes
 
     for (sb_index = 0; sb_index < pictureLcuWidth * pictureLcuHeight; ++sb_index) {
         sequence_control_set_ptr->sb_params_array[sb_index].horizontal_index = (uint8_t)(sb_index % pictureLcuWidth);
@@ -544,8 +613,12 @@ EbErrorType sb_geom_init(SequenceControlSet * sequence_control_set_ptr)
     uint16_t   pictureLcuWidth = (sequence_control_set_ptr->luma_width + sequence_control_set_ptr->sb_size_pix - 1) / sequence_control_set_ptr->sb_size_pix;
     uint16_t    pictureLcuHeight = (sequence_control_set_ptr->luma_height + sequence_control_set_ptr->sb_size_pix - 1) / sequence_control_set_ptr->sb_size_pix;
 
-    EB_MALLOC(SbGeom*, sequence_control_set_ptr->sb_geom, sizeof(SbGeom) * pictureLcuWidth * pictureLcuHeight, EB_N_PTR);
-
+    // Sized for the largest input, this runs again when the resolution changes
+    if (sequence_control_set_ptr->sb_geom == (SbGeom*)EB_NULL) {
+        EB_MALLOC(SbGeom*, sequence_control_set_ptr->sb_geom, sizeof(SbGeom) *
+            ((sequence_control_set_ptr->max_input_luma_width + sequence_control_set_ptr->sb_size_pix - 1) / sequence_control_set_ptr->sb_size_pix) *
+            ((sequence_control_set_ptr->max_input_luma_height + sequence_control_set_ptr->sb_size_pix - 1) / sequence_control_set_ptr->sb_size_pix), EB_N_PTR);
+    }
 
     for (sb_index = 0; sb_index < pictureLcuWidth * pictureLcuHeight; ++sb_index) {
 
@@ -125,12 +125,16 @@ extern "C" {
         uint32_t                                me_segment_row_count_array[MAX_TEMPORAL_LAYERS];
         uint32_t                                enc_dec_segment_col_count_array[MAX_TEMPORAL_LAYERS];
         uint32_t                                enc_dec_segment_row_count_array[MAX_TEMPORAL_LAYERS];
+        uint32_t                                dlf_segment_row_count;
         uint32_t                                cdef_segment_column_count;
         uint32_t                                cdef_segment_row_count;
 
         uint32_t                                rest_segment_column_count;
         uint32_t                                rest_segment_row_count;
 
+        // Picture Analysis segments are SB rows of the picture, see picture_analysis_run_segments()
+        uint32_t                                pa_segment_row_count;
+
         // Buffers
         uint32_t                                picture_control_set_pool_init_count;
         uint32_t                                picture_control_set_pool_init_count_child;
@@ -164,6 +168,8 @@ extern "C" {
         uint32_t                                cdef_process_init_count;
         uint32_t                                rest_process_init_count;
         uint32_t                                total_process_init_count;
+        // Kernel threads given by the host context, 0 without one
+        uint32_t                                host_thread_budget;
         
         uint16_t                                film_grain_random_seed;
         SbParams                               *sb_params_array;
@@ -253,6 +259,9 @@ extern "C" {
     {
         EncodeContext            *encode_context_ptr;
         int32_t                     sb_size;
+        // Picture size the SB arrays are allocated for, 0 for the largest supported
+        uint32_t                    max_picture_width;
+        uint32_t                    max_picture_height;
     } EbSequenceControlSetInitData;
 
     typedef struct EbSequenceControlSetInstance
@@ -278,7 +287,8 @@ extern "C" {
         EbSequenceControlSetInstance **object_dbl_ptr);
 
     extern EbErrorType sb_params_ctor(
-        SequenceControlSet *sequence_control_set_ptr);
+        SequenceControlSet           *sequence_control_set_ptr,
+        EbSequenceControlSetInitData *scs_init_data_ptr);
 
     extern EbErrorType sb_params_init(
         SequenceControlSet *sequence_control_set_ptr);
@@ -289,6 +299,11 @@ extern "C" {
 
     EbErrorType sb_geom_init(SequenceControlSet *sequence_control_set_ptr);
 
+    extern void derive_segment_counts(
+        SequenceControlSet *sequence_control_set_ptr,
+        uint32_t            luma_width,
+        uint32_t            luma_height);
+
 #ifdef __cplusplus
 }
 #endif
@@ -14,6 +14,7 @@
 #include "EbInitialRateControlResults.h"
 #include "EbPictureDemuxResults.h"
 #include "EbMotionEstimationContext.h"
+#include "EbPassStats.h"
 #include "emmintrin.h"
 
 /**************************************
@@ -931,6 +932,15 @@ void* source_based_operations_kernel(void *input_ptr)
         picture_control_set_ptr = (PictureParentControlSet*)inputResultsPtr->picture_control_set_wrapper_ptr->object_ptr;
         sequence_control_set_ptr = (SequenceControlSet*)picture_control_set_ptr->sequence_control_set_wrapper_ptr->object_ptr;
 
+        // The first pass ends with motion estimation
+        if (sequence_control_set_ptr->static_config.pass == 1) {
+            eb_release_object(inputResultsWrapperPtr);
+            eb_first_pass_picture_done(
+                sequence_control_set_ptr,
+                picture_control_set_ptr);
+            continue;
+        }
+
         picture_control_set_ptr->dark_back_groundlight_fore_ground = EB_FALSE;
         context_ptr->picture_num_grass_sb = 0;
 
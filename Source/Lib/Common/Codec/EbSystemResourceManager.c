@@ -6,7 +6,217 @@
 #include <stdlib.h>
 
 #include "EbSystemResourceManager.h"
+#include "EbPipelineStats.h"
+#include "EbHostContext.h"
 
+#if LOCK_FREE_FIFO
+#define EB_FIFO_SPIN_COUNT              512
+
+/**************************************
+ * EbFifoCtor
+ **************************************/
+static EbErrorType EbFifoCtor(
+    EbFifo           *fifoPtr,
+    EbMuxingQueue    *queue_ptr)
+{
+    // Copy the Muxing Queue ptr this Fifo belongs to
+    fifoPtr->queue_ptr = queue_ptr;
+    fifoPtr->task_stats_ptr = (struct EbTaskStats*)EB_NULL;
+    fifoPtr->host_channel_ptr = (struct EbHostChannel*)EB_NULL;
+
+    return EB_ErrorNone;
+}
+
+/**************************************
+ * EbMuxingQueueCtor
+ **************************************/
+static EbErrorType EbMuxingQueueCtor(
+    EbMuxingQueue   **queueDblPtr,
+    uint32_t              object_total_count,
+    uint32_t              process_total_count,
+    EbFifo         ***processFifoPtrArrayPtr)
+{
+    EbMuxingQueue *queue_ptr;
+    uint32_t processIndex;
+    uint32_t cellIndex;
+    uint32_t cell_total_count = 2;
+    EbErrorType     return_error = EB_ErrorNone;
+
+    EB_MALLOC(EbMuxingQueue *, queue_ptr, sizeof(EbMuxingQueue), EB_N_PTR);
+    *queueDblPtr = queue_ptr;
+
+    queue_ptr->process_total_count = process_total_count;
+
+    // Lockout Mutex
+    EB_CREATEMUTEX(EbHandle, queue_ptr->lockout_mutex, sizeof(EbHandle), EB_MUTEX);
+
+    // Park Semaphore, only posted when a process is parked on it
+    EB_CREATESEMAPHORE(EbHandle, queue_ptr->park_semaphore, sizeof(EbHandle), EB_SEMAPHORE, 0, 0x7FFFFFFF);
+
+    // The ring holds every object of the resource, rounded up to a power of two
+    while (cell_total_count < object_total_count)
+        cell_total_count <<= 1;
+    queue_ptr->buffer_mask = cell_total_count - 1;
+
+    EB_MALLOC(EbLockFreeCell*, queue_ptr->cell_array, sizeof(EbLockFreeCell) * cell_total_count, EB_N_PTR);
+
+    for (cellIndex = 0; cellIndex < cell_total_count; ++cellIndex) {
+        queue_ptr->cell_array[cellIndex].sequence = (int32_t)cellIndex;
+        queue_ptr->cell_array[cellIndex].wrapper_ptr = (EbObjectWrapper*)EB_NULL;
+    }
+
+    queue_ptr->enqueue_pos = 0;
+    queue_ptr->dequeue_pos = 0;
+    queue_ptr->object_count = 0;
+
+    // Construct the Process Fifos
+    EB_MALLOC(EbFifo**, queue_ptr->process_fifo_ptr_array, sizeof(EbFifo*) * queue_ptr->process_total_count, EB_N_PTR);
+
+    for (processIndex = 0; processIndex < queue_ptr->process_total_count; ++processIndex) {
+        EB_MALLOC(EbFifo*, queue_ptr->process_fifo_ptr_array[processIndex], sizeof(EbFifo), EB_N_PTR);
+        return_error = EbFifoCtor(
+            queue_ptr->process_fifo_ptr_array[processIndex],
+            queue_ptr);
+        if (return_error == EB_ErrorInsufficientResources) {
+            return EB_ErrorInsufficientResources;
+        }
+    }
+
+    *processFifoPtrArrayPtr = queue_ptr->process_fifo_ptr_array;
+
+    return return_error;
+}
+
+/**************************************
+ * EbMuxingQueueEnqueue
+ *   Publishes the object in the next
+ *   free cell of the ring. The ring can
+ *   hold every object of the resource,
+ *   so a free cell always exists.
+ **************************************/
+static void EbMuxingQueueEnqueue(
+    EbMuxingQueue    *queue_ptr,
+    EbObjectWrapper  *wrapper_ptr)
+{
+    EbLockFreeCell *cell_ptr;
+    int32_t pos = eb_atomic_load(&queue_ptr->enqueue_pos);
+
+    for (;;) {
+        cell_ptr = &queue_ptr->cell_array[(uint32_t)pos & queue_ptr->buffer_mask];
+        int32_t diff = (int32_t)((uint32_t)eb_atomic_load(&cell_ptr->sequence) - (uint32_t)pos);
+
+        if (diff == 0) {
+            // Cell is free for this lap, claim it
+            if (eb_atomic_compare_exchange(&queue_ptr->enqueue_pos, pos, (int32_t)((uint32_t)pos + 1)))
+                break;
+        }
+        else if (diff < 0) {
+            // Cell still being drained by a consumer of the previous lap
+            eb_cpu_pause();
+        }
+        pos = eb_atomic_load(&queue_ptr->enqueue_pos);
+    }
+
+    cell_ptr->wrapper_ptr = wrapper_ptr;
+    eb_atomic_store(&cell_ptr->sequence, (int32_t)((uint32_t)pos + 1));
+}
+
+/**************************************
+ * EbMuxingQueueDequeue
+ *   Pops the object at the head of the
+ *   ring. Only called once an object
+ *   has been acquired through
+ *   object_count, so the head cell is
+ *   published or about to be.
+ **************************************/
+static void EbMuxingQueueDequeue(
+    EbMuxingQueue    *queue_ptr,
+    EbObjectWrapper **wrapper_dbl_ptr)
+{
+    EbLockFreeCell *cell_ptr;
+    int32_t pos = eb_atomic_load(&queue_ptr->dequeue_pos);
+
+    for (;;) {
+        cell_ptr = &queue_ptr->cell_array[(uint32_t)pos & queue_ptr->buffer_mask];
+        int32_t diff = (int32_t)((uint32_t)eb_atomic_load(&cell_ptr->sequence) - ((uint32_t)pos + 1));
+
+        if (diff == 0) {
+            // Cell holds a published object, claim it
+            if (eb_atomic_compare_exchange(&queue_ptr->dequeue_pos, pos, (int32_t)((uint32_t)pos + 1)))
+                break;
+        }
+        else if (diff < 0) {
+            // A producer claimed the cell but has not published it yet
+            eb_cpu_pause();
+        }
+        pos = eb_atomic_load(&queue_ptr->dequeue_pos);
+    }
+
+    *wrapper_dbl_ptr = cell_ptr->wrapper_ptr;
+    eb_atomic_store(&cell_ptr->sequence, (int32_t)((uint32_t)pos + queue_ptr->buffer_mask + 1));
+}
+
+/**************************************
+ * EbMuxingQueueTryAcquire
+ *   Takes one object from object_count
+ *   if any is available. Never blocks.
+ **************************************/
+static EbBool EbMuxingQueueTryAcquire(
+    EbMuxingQueue    *queue_ptr)
+{
+    int32_t count = eb_atomic_load(&queue_ptr->object_count);
+
+    while (count > 0) {
+        if (eb_atomic_compare_exchange(&queue_ptr->object_count, count, count - 1))
+            return EB_TRUE;
+        count = eb_atomic_load(&queue_ptr->object_count);
+    }
+
+    return EB_FALSE;
+}
+
+/**************************************
+ * EbMuxingQueueAcquire
+ *   Spins for a while on object_count,
+ *   then parks the calling process on
+ *   the park semaphore until a
+ *   producer hands it an object.
+ **************************************/
+static void EbMuxingQueueAcquire(
+    EbMuxingQueue    *queue_ptr)
+{
+    uint32_t spinIndex;
+
+    for (spinIndex = 0; spinIndex < EB_FIFO_SPIN_COUNT; ++spinIndex) {
+        if (EbMuxingQueueTryAcquire(queue_ptr))
+            return;
+        eb_cpu_pause();
+    }
+
+    if (eb_atomic_fetch_add(&queue_ptr->object_count, -1) <= 0)
+        eb_block_on_semaphore(queue_ptr->park_semaphore);
+}
+
+/**************************************
+ * EbMuxingQueueObjectPushBack
+ **************************************/
+static EbErrorType EbMuxingQueueObjectPushBack(
+    EbMuxingQueue    *queue_ptr,
+    EbObjectWrapper  *object_ptr)
+{
+    EbErrorType return_error = EB_ErrorNone;
+
+    EbMuxingQueueEnqueue(
+        queue_ptr,
+        object_ptr);
+
+    // Wake a parked process only if there is one
+    if (eb_atomic_fetch_add(&queue_ptr->object_count, 1) < 0)
+        eb_post_semaphore(queue_ptr->park_semaphore);
+
+    return return_error;
+}
+#else
 /**************************************
  * EbFifoCtor
  **************************************/
@@ -30,6 +240,8 @@ static EbErrorType EbFifoCtor(
 
     // Copy the Muxing Queue ptr this Fifo belongs to
     fifoPtr->queue_ptr = queue_ptr;
+    fifoPtr->task_stats_ptr = (struct EbTaskStats*)EB_NULL;
+    fifoPtr->host_channel_ptr = (struct EbHostChannel*)EB_NULL;
 
     return EB_ErrorNone;
 }
@@ -319,6 +531,8 @@ static EbErrorType EbMuxingQueueObjectPushFront(
     return return_error;
 }
 
+#endif
+
 /*********************************************************************
  * eb_object_release_enable
  *   Enables the release_enable member of EbObjectWrapper.  Used by
@@ -452,6 +666,8 @@ EbErrorType eb_system_resource_ctor(
     *resource_dbl_ptr = resource_ptr;
 
     resource_ptr->object_total_count = object_total_count;
+    resource_ptr->release_callback = (EbReleaseCallback)EB_NULL;
+    resource_ptr->release_callback_data = EB_NULL;
 
     // Allocate array for wrapper pointers
     EB_MALLOC(EbObjectWrapper**, resource_ptr->wrapper_ptr_pool, sizeof(EbObjectWrapper*) * resource_ptr->object_total_count, EB_N_PTR);
@@ -511,6 +727,7 @@ EbErrorType eb_system_resource_ctor(
 
 
 
+#if !LOCK_FREE_FIFO
 /*********************************************************************
  * EbSystemResourceReleaseProcess
  *********************************************************************/
@@ -531,6 +748,7 @@ static EbErrorType EbReleaseProcess(
 
     return return_error;
 }
+#endif
 
 /*********************************************************************
  * EbSystemResourcePostObject
@@ -551,6 +769,11 @@ EbErrorType eb_post_full_object(
 {
     EbErrorType return_error = EB_ErrorNone;
 
+#if LOCK_FREE_FIFO
+    EbMuxingQueueObjectPushBack(
+        object_ptr->system_resource_ptr->full_queue,
+        object_ptr);
+#else
     eb_block_on_mutex(object_ptr->system_resource_ptr->full_queue->lockout_mutex);
 
     EbMuxingQueueObjectPushBack(
@@ -558,6 +781,7 @@ EbErrorType eb_post_full_object(
         object_ptr);
 
     eb_release_mutex(object_ptr->system_resource_ptr->full_queue->lockout_mutex);
+#endif
 
     return return_error;
 }
@@ -576,6 +800,12 @@ EbErrorType eb_release_object(
     EbObjectWrapper   *object_ptr)
 {
     EbErrorType return_error = EB_ErrorNone;
+#if LOCK_FREE_FIFO
+    EbBool      release_object = EB_FALSE;
+#endif
+
+    EbSystemResource *resource_ptr = object_ptr->system_resource_ptr;
+    EbBool      call_release = EB_FALSE;
 
     eb_block_on_mutex(object_ptr->system_resource_ptr->empty_queue->lockout_mutex);
 
@@ -587,17 +817,67 @@ EbErrorType eb_release_object(
         // Set live_count to EB_ObjectWrapperReleasedValue
         object_ptr->live_count = EB_ObjectWrapperReleasedValue;
 
+        if (resource_ptr->release_callback) {
+            // The hook must run before the object can be reused, so the
+            // object is queued back only after the callback returns
+            call_release = EB_TRUE;
+        }
+        else {
+#if LOCK_FREE_FIFO
+            release_object = EB_TRUE;
+#else
+            EbMuxingQueueObjectPushFront(
+                object_ptr->system_resource_ptr->empty_queue,
+                object_ptr);
+#endif
+        }
+    }
+
+    eb_release_mutex(object_ptr->system_resource_ptr->empty_queue->lockout_mutex);
+
+    if (call_release) {
+        resource_ptr->release_callback(
+            object_ptr->object_ptr,
+            resource_ptr->release_callback_data);
+#if LOCK_FREE_FIFO
+        release_object = EB_TRUE;
+#else
+        eb_block_on_mutex(resource_ptr->empty_queue->lockout_mutex);
         EbMuxingQueueObjectPushFront(
-            object_ptr->system_resource_ptr->empty_queue,
+            resource_ptr->empty_queue,
             object_ptr);
-
+        eb_release_mutex(resource_ptr->empty_queue->lockout_mutex);
+#endif
     }
 
-    eb_release_mutex(object_ptr->system_resource_ptr->empty_queue->lockout_mutex);
+#if LOCK_FREE_FIFO
+    // The ring is lock-free, queue the object outside of the critical section.
+    // A ring only takes objects at its tail, so the released object is reused
+    // last instead of first as with the locked queue. The empty objects of a
+    // resource are interchangeable, only the cache reuse of the buffer differs.
+    if (release_object)
+        EbMuxingQueueObjectPushBack(
+            object_ptr->system_resource_ptr->empty_queue,
+            object_ptr);
+#endif
 
     return return_error;
 }
 
+/*********************************************************************
+ * eb_system_resource_set_release_callback
+ *********************************************************************/
+EbErrorType eb_system_resource_set_release_callback(
+    EbSystemResource  *resource_ptr,
+    EbReleaseCallback  release_callback,
+    EbPtr              callback_data)
+{
+    resource_ptr->release_callback = release_callback;
+    resource_ptr->release_callback_data = callback_data;
+
+    return EB_ErrorNone;
+}
+
 /*********************************************************************
  * EbSystemResourceGetEmptyObject
  *   Dequeues an empty EbObjectWrapper from the SystemResource.  This
@@ -619,6 +899,21 @@ EbErrorType eb_get_empty_object(
 {
     EbErrorType return_error = EB_ErrorNone;
 
+#if LOCK_FREE_FIFO
+    // Spin, then park, until an empty buffer is available
+    EbMuxingQueueAcquire(empty_fifo_ptr->queue_ptr);
+
+    // Get the empty object
+    EbMuxingQueueDequeue(
+        empty_fifo_ptr->queue_ptr,
+        wrapper_dbl_ptr);
+
+    // Reset the wrapper's live_count
+    (*wrapper_dbl_ptr)->live_count = 0;
+
+    // Object release enable
+    (*wrapper_dbl_ptr)->release_enable = EB_TRUE;
+#else
     // Queue the Fifo requesting the empty fifo
     EbReleaseProcess(empty_fifo_ptr);
 
@@ -641,6 +936,7 @@ EbErrorType eb_get_empty_object(
 
     // Release Mutex
     eb_release_mutex(empty_fifo_ptr->lockout_mutex);
+#endif
 
     return return_error;
 }
@@ -666,6 +962,22 @@ EbErrorType eb_get_full_object(
 {
     EbErrorType return_error = EB_ErrorNone;
 
+    // Asking for the next object ends the previous task of the process
+    if (full_fifo_ptr->task_stats_ptr)
+        eb_task_stats_end(full_fifo_ptr->task_stats_ptr);
+
+    // Every task is a scheduling point of the host context
+    if (full_fifo_ptr->host_channel_ptr)
+        eb_host_worker_release(full_fifo_ptr->host_channel_ptr);
+
+#if LOCK_FREE_FIFO
+    // Spin, then park, until a full buffer is available
+    EbMuxingQueueAcquire(full_fifo_ptr->queue_ptr);
+
+    EbMuxingQueueDequeue(
+        full_fifo_ptr->queue_ptr,
+        wrapper_dbl_ptr);
+#else
     // Queue the Fifo requesting the full fifo
     EbReleaseProcess(full_fifo_ptr);
 
@@ -681,10 +993,75 @@ EbErrorType eb_get_full_object(
 
     // Release Mutex
     eb_release_mutex(full_fifo_ptr->lockout_mutex);
+#endif
+
+    if (full_fifo_ptr->host_channel_ptr)
+        eb_host_worker_acquire(full_fifo_ptr->host_channel_ptr);
+
+    if (full_fifo_ptr->task_stats_ptr)
+        eb_task_stats_start(
+            full_fifo_ptr->task_stats_ptr,
+            eb_fifo_get_queue_depth(full_fifo_ptr));
+
+    return return_error;
+}
+
+/*********************************************************************
+ * eb_fifo_get_queue_depth
+ *********************************************************************/
+uint32_t eb_fifo_get_queue_depth(
+    EbFifo           *fifo_ptr)
+{
+#if LOCK_FREE_FIFO
+    // object_count is negative while processes are parked
+    int32_t object_count = eb_atomic_load(&fifo_ptr->queue_ptr->object_count);
+
+    return object_count > 0 ? (uint32_t)object_count : 0;
+#else
+    return fifo_ptr->queue_ptr->object_queue->current_count;
+#endif
+}
+
+#if LOCK_FREE_FIFO
+EbErrorType eb_get_full_object_non_blocking(
+    EbFifo   *full_fifo_ptr,
+    EbObjectWrapper **wrapper_dbl_ptr)
+{
+    EbErrorType return_error = EB_ErrorNone;
+
+    if (EbMuxingQueueTryAcquire(full_fifo_ptr->queue_ptr))
+        EbMuxingQueueDequeue(
+            full_fifo_ptr->queue_ptr,
+            wrapper_dbl_ptr);
+    else
+        *wrapper_dbl_ptr = (EbObjectWrapper*)EB_NULL;
 
     return return_error;
 }
 
+EbErrorType eb_get_empty_object_non_blocking(
+    EbFifo   *empty_fifo_ptr,
+    EbObjectWrapper **wrapper_dbl_ptr)
+{
+    EbErrorType return_error = EB_ErrorNone;
+
+    if (EbMuxingQueueTryAcquire(empty_fifo_ptr->queue_ptr)) {
+        EbMuxingQueueDequeue(
+            empty_fifo_ptr->queue_ptr,
+            wrapper_dbl_ptr);
+
+        // Reset the wrapper's live_count
+        (*wrapper_dbl_ptr)->live_count = 0;
+
+        // Object release enable
+        (*wrapper_dbl_ptr)->release_enable = EB_TRUE;
+    }
+    else
+        *wrapper_dbl_ptr = (EbObjectWrapper*)EB_NULL;
+
+    return return_error;
+}
+#else
 /**************************************
 * EbFifoPopFront
 **************************************/
@@ -728,4 +1105,33 @@ EbErrorType eb_get_full_object_non_blocking(
         *wrapper_dbl_ptr = (EbObjectWrapper*)EB_NULL;
 
     return return_error;
-}
\ No newline at end of file
+}
+
+EbErrorType eb_get_empty_object_non_blocking(
+    EbFifo   *empty_fifo_ptr,
+    EbObjectWrapper **wrapper_dbl_ptr)
+{
+    EbErrorType return_error = EB_ErrorNone;
+    EbBool      fifoEmpty;
+    // Queue the Fifo requesting the empty fifo
+    EbReleaseProcess(empty_fifo_ptr);
+
+    // Acquire lockout Mutex
+    eb_block_on_mutex(empty_fifo_ptr->lockout_mutex);
+
+    fifoEmpty = EbFifoPeakFront(
+        empty_fifo_ptr);
+
+    // Release Mutex
+    eb_release_mutex(empty_fifo_ptr->lockout_mutex);
+
+    if (fifoEmpty == EB_FALSE)
+        eb_get_empty_object(
+            empty_fifo_ptr,
+            wrapper_dbl_ptr);
+    else
+        *wrapper_dbl_ptr = (EbObjectWrapper*)EB_NULL;
+
+    return return_error;
+}
+#endif
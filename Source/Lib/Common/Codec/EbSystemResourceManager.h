@@ -47,6 +47,30 @@ extern "C" {
 
     } EbObjectWrapper;
 
+#if LOCK_FREE_FIFO
+    /*********************************************************************
+     * Fifo
+     *   Per-process handle onto a MuxingQueue. All the Fifos of a
+     *   MuxingQueue share its lock-free ring, so an object is handed to
+     *   whichever process dequeues it first.
+     *********************************************************************/
+    typedef struct EbFifo
+    {
+        // queue_ptr - pointer to MuxingQueue that the EbFifo is
+        //   associated with.
+        struct EbMuxingQueue *queue_ptr;
+
+        // task_stats_ptr - optional pipeline statistics of the process
+        //   consuming this EbFifo, updated by eb_get_full_object.
+        struct EbTaskStats   *task_stats_ptr;
+
+        // host_channel_ptr - optional host context channel of the process
+        //   consuming this EbFifo, which holds a worker between two calls
+        //   to eb_get_full_object.
+        struct EbHostChannel *host_channel_ptr;
+
+    } EbFifo;
+#else
     /*********************************************************************
      * Fifo
      *   Defines a static (i.e. no dynamic memory allocation) single
@@ -76,7 +100,17 @@ extern "C" {
         //   associated with.
         struct EbMuxingQueue *queue_ptr;
 
+        // task_stats_ptr - optional pipeline statistics of the process
+        //   consuming this EbFifo, updated by eb_get_full_object.
+        struct EbTaskStats   *task_stats_ptr;
+
+        // host_channel_ptr - optional host context channel of the process
+        //   consuming this EbFifo, which holds a worker between two calls
+        //   to eb_get_full_object.
+        struct EbHostChannel *host_channel_ptr;
+
     } EbFifo;
+#endif
 
     /*********************************************************************
      * CircularBuffer
@@ -91,6 +125,55 @@ extern "C" {
 
     } EbCircularBuffer;
 
+#if LOCK_FREE_FIFO
+#define EB_CACHE_LINE_SIZE              64
+
+    /*********************************************************************
+     * LockFreeCell
+     *   One slot of the bounded MPMC ring. The sequence number tells
+     *   producers and consumers whether the slot is free for the current
+     *   lap of the ring or holds a published object.
+     *********************************************************************/
+    typedef struct EbLockFreeCell
+    {
+        volatile int32_t   sequence;
+        EbObjectWrapper   *wrapper_ptr;
+
+    } EbLockFreeCell;
+
+    /*********************************************************************
+     * MuxingQueue
+     *   Bounded lock-free MPMC ring shared by all the process Fifos of
+     *   the queue. The ring is sized to hold every object of the
+     *   SystemResource so an enqueue never waits for room.
+     *   object_count acts as a user-space counting semaphore: it is the
+     *   number of objects available, or minus the number of processes
+     *   parked on park_semaphore, so posting an object only enters the
+     *   kernel when a consumer is actually parked.
+     *********************************************************************/
+    typedef struct EbMuxingQueue
+    {
+        // lockout_mutex - protects the live_count and release_enable
+        //   members of the EbObjectWrappers released to this queue.
+        EbHandle           lockout_mutex;
+        EbHandle           park_semaphore;
+        EbLockFreeCell    *cell_array;
+        uint32_t           buffer_mask;
+        uint32_t           process_total_count;
+        EbFifo           **process_fifo_ptr_array;
+
+        // Producer / consumer positions and the object count live on
+        //   separate cache lines to avoid false sharing.
+        uint8_t            pad0[EB_CACHE_LINE_SIZE];
+        volatile int32_t   enqueue_pos;
+        uint8_t            pad1[EB_CACHE_LINE_SIZE - sizeof(int32_t)];
+        volatile int32_t   dequeue_pos;
+        uint8_t            pad2[EB_CACHE_LINE_SIZE - sizeof(int32_t)];
+        volatile int32_t   object_count;
+        uint8_t            pad3[EB_CACHE_LINE_SIZE - sizeof(int32_t)];
+
+    } EbMuxingQueue;
+#else
     /*********************************************************************
      * MuxingQueue
      *********************************************************************/
@@ -103,6 +186,11 @@ extern "C" {
         EbFifo          **process_fifo_ptr_array;
 
     } EbMuxingQueue;
+#endif
+
+    typedef void(*EbReleaseCallback)(
+        EbPtr object_ptr,
+        EbPtr callback_data);
 
     /*********************************************************************
      * SystemResource
@@ -129,8 +217,30 @@ extern "C" {
         // The full FIFO contains a queue of completed buffers
         EbMuxingQueue     *full_queue;
 
+        // release_callback - Optional hook called with the object once its
+        //   live_count drops to zero, just before it re-enters the empty FIFO.
+        EbReleaseCallback  release_callback;
+        EbPtr              release_callback_data;
+
     } EbSystemResource;
 
+    /*********************************************************************
+     * eb_system_resource_set_release_callback
+     *   Installs a hook that is called each time an object of the
+     *   SystemResource is fully released.  The hook runs on the releasing
+     *   thread, outside of the emptyFifo lockout_mutex.
+     *
+     *   resource_ptr
+     *      pointer to the SystemResource.
+     *
+     *   release_callback
+     *      function called with the released object and callback_data.
+     *********************************************************************/
+    extern EbErrorType eb_system_resource_set_release_callback(
+        EbSystemResource  *resource_ptr,
+        EbReleaseCallback  release_callback,
+        EbPtr              callback_data);
+
     /*********************************************************************
      * eb_object_release_enable
      *   Enables the release_enable member of EbObjectWrapper.  Used by
@@ -298,10 +408,24 @@ extern "C" {
         EbFifo           *full_fifo_ptr,
         EbObjectWrapper **wrapper_dbl_ptr);
 
+    /*********************************************************************
+     * eb_fifo_get_queue_depth
+     *   Returns the number of full objects waiting in the MuxingQueue the
+     *   EbFifo belongs to. The value is a snapshot used for statistics.
+     *********************************************************************/
+    extern uint32_t eb_fifo_get_queue_depth(
+        EbFifo           *fifo_ptr);
+
     extern EbErrorType eb_get_full_object_non_blocking(
         EbFifo           *full_fifo_ptr,
         EbObjectWrapper **wrapper_dbl_ptr);
 
+    // Sets *wrapper_dbl_ptr to NULL instead of blocking when no empty object
+    // is available
+    extern EbErrorType eb_get_empty_object_non_blocking(
+        EbFifo           *empty_fifo_ptr,
+        EbObjectWrapper **wrapper_dbl_ptr);
+
     /*********************************************************************
      * EbSystemResourceReleaseObject
      *   Queues an empty EbObjectWrapper to the SystemResource. This
@@ -15,6 +15,7 @@
 #include <stdlib.h>
 #include "EbDefinitions.h"
 #include "EbThreads.h"
+#include "EbHostContext.h"
  /****************************************
   * Win32 Includes
   ****************************************/
@@ -28,6 +29,12 @@
 #include <semaphore.h>
 #include <time.h>
 #include <unistd.h>
+#include <sys/resource.h>
+#if defined(__linux__)
+#include <dirent.h>
+#include <string.h>
+#include <sys/syscall.h>
+#endif
 #else
 #error OS/Platform not supported.
 #endif // _WIN32
@@ -45,14 +52,112 @@ void printfTime(const char *fmt, ...)
 #endif
 #endif
 
+#if defined(__linux__) || defined(__APPLE__)
+/****************************************
+ * apply_thread_priority
+ *   Called by the new thread. Without
+ *   CAP_SYS_NICE the kernel only grants
+ *   priorities up to RLIMIT_RTPRIO and
+ *   nice values down to 20 - RLIMIT_NICE,
+ *   so a refused request is retried at
+ *   that limit before falling back.
+ ****************************************/
+static void apply_thread_priority(
+    const EbThreadPriority *requested_ptr,
+    EbThreadPriority       *applied_ptr)
+{
+    applied_ptr->policy = EB_THREAD_POLICY_NORMAL;
+    applied_ptr->priority = 0;
+
+    if (requested_ptr->policy == EB_THREAD_POLICY_REALTIME) {
+        struct sched_param param;
+        int32_t policy;
+        int32_t priority = requested_ptr->priority;
+        priority = priority < sched_get_priority_min(SCHED_FIFO) ? sched_get_priority_min(SCHED_FIFO) : priority;
+        priority = priority > sched_get_priority_max(SCHED_FIFO) ? sched_get_priority_max(SCHED_FIFO) : priority;
+
+        param.sched_priority = priority;
+        if (pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) != 0) {
+#ifdef RLIMIT_RTPRIO
+            struct rlimit limit;
+            if (getrlimit(RLIMIT_RTPRIO, &limit) == 0 && limit.rlim_cur > 0 && (rlim_t)priority > limit.rlim_cur) {
+                param.sched_priority = (int32_t)limit.rlim_cur;
+                pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+            }
+#endif
+        }
+
+        if (pthread_getschedparam(pthread_self(), &policy, &param) == 0 && policy == SCHED_FIFO) {
+            applied_ptr->policy = EB_THREAD_POLICY_REALTIME;
+            applied_ptr->priority = param.sched_priority;
+        }
+    }
+#if defined(__linux__)
+    else if (requested_ptr->policy == EB_THREAD_POLICY_NICE) {
+        // On Linux the nice value is per thread
+        struct rlimit limit;
+        pid_t   thread_id = (pid_t)syscall(SYS_gettid);
+        int32_t nice_value = requested_ptr->priority;
+        nice_value = nice_value < -20 ? -20 : nice_value > 19 ? 19 : nice_value;
+
+        if (setpriority(PRIO_PROCESS, (id_t)thread_id, nice_value) != 0 &&
+            getrlimit(RLIMIT_NICE, &limit) == 0 && limit.rlim_cur != RLIM_INFINITY) {
+            // Only retry when the limit still raises the inherited priority
+            int32_t nice_limit = 20 - (int32_t)limit.rlim_cur;
+            errno = 0;
+            int32_t inherited_nice_value = getpriority(PRIO_PROCESS, (id_t)thread_id);
+            if (errno == 0 && nice_value < nice_limit && nice_limit < inherited_nice_value)
+                setpriority(PRIO_PROCESS, (id_t)thread_id, nice_limit);
+        }
+
+        errno = 0;
+        nice_value = getpriority(PRIO_PROCESS, (id_t)thread_id);
+        if (errno == 0) {
+            applied_ptr->policy = nice_value ? EB_THREAD_POLICY_NICE : EB_THREAD_POLICY_NORMAL;
+            applied_ptr->priority = nice_value;
+        }
+    }
+#endif
+}
+
+typedef struct EbThreadStart
+{
+    void                *(*thread_function)(void *);
+    void                 *thread_context;
+    EbThreadPriority      requested;
+    EbThreadPriority      applied;
+    EbHandle              started_semaphore;
+} EbThreadStart;
+
+static void *thread_start(void *start_ptr)
+{
+    EbThreadStart *thread_start_ptr = (EbThreadStart*)start_ptr;
+    void *(*thread_function)(void *) = thread_start_ptr->thread_function;
+    void  *thread_context = thread_start_ptr->thread_context;
+
+    apply_thread_priority(&thread_start_ptr->requested, &thread_start_ptr->applied);
+
+    // The creator owns thread_start_ptr and returns once posted
+    eb_post_semaphore(thread_start_ptr->started_semaphore);
+
+    return thread_function(thread_context);
+}
+#endif
+
 /****************************************
  * eb_create_thread
  ****************************************/
 EbHandle eb_create_thread(
     void *thread_function(void *),
-    void *thread_context)
+    void *thread_context,
+    const EbThreadPriority *requested_ptr,
+    EbThreadPriority       *applied_ptr)
 {
     EbHandle thread_handle = NULL;
+    EbThreadPriority requested = { EB_THREAD_POLICY_NORMAL, 0 };
+
+    if (requested_ptr)
+        requested = *requested_ptr;
 
 #ifdef _WIN32
 
@@ -64,44 +169,69 @@ EbHandle eb_create_thread(
         0,                              // thread active when created
         NULL);                          // new thread ID
 
-#elif defined(__linux__) || defined(__APPLE__)
-
-    pthread_attr_t attr;
-    struct sched_param param = {
-        .sched_priority = 99
-    };
-    pthread_attr_init(&attr);
-    pthread_attr_setschedpolicy(&attr, SCHED_FIFO);
-    pthread_attr_setschedparam(&attr, &param);
+    if (thread_handle != NULL && requested.policy != EB_THREAD_POLICY_NORMAL) {
+        // Map onto the Windows priority levels
+        int32_t priority = requested.policy == EB_THREAD_POLICY_REALTIME ?
+            THREAD_PRIORITY_TIME_CRITICAL :
+            requested.priority <= -10 ? THREAD_PRIORITY_HIGHEST :
+            requested.priority < 0 ? THREAD_PRIORITY_ABOVE_NORMAL :
+            requested.priority >= 10 ? THREAD_PRIORITY_LOWEST :
+            requested.priority > 0 ? THREAD_PRIORITY_BELOW_NORMAL : THREAD_PRIORITY_NORMAL;
+        EbBool applied = SetThreadPriority((HANDLE)thread_handle, priority) ? EB_TRUE : EB_FALSE;
+        if (applied_ptr) {
+            applied_ptr->policy = applied ? requested.policy : EB_THREAD_POLICY_NORMAL;
+            applied_ptr->priority = applied ? requested.priority : 0;
+        }
+    }
+    else if (thread_handle != NULL && applied_ptr) {
+        applied_ptr->policy = EB_THREAD_POLICY_NORMAL;
+        applied_ptr->priority = 0;
+    }
 
-    pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+#elif defined(__linux__) || defined(__APPLE__)
 
     thread_handle = (pthread_t*)malloc(sizeof(pthread_t));
     if (thread_handle != NULL) {
-        int32_t ret = pthread_create(
-            (pthread_t*)thread_handle,      // Thread handle
-            &attr,                       // attributes
-            thread_function,                 // function to be run by new thread
-            thread_context);
-
-        if (ret != 0) {
-            if (ret == EPERM) {
-
-                pthread_cancel(*((pthread_t*)thread_handle));
-                free(thread_handle);
-
-                thread_handle = (pthread_t*)malloc(sizeof(pthread_t));
-                if (thread_handle != NULL) {
-                    pthread_create(
-                        (pthread_t*)thread_handle,      // Thread handle
-                        (const pthread_attr_t*)EB_NULL,                        // attributes
-                        thread_function,                 // function to be run by new thread
-                        thread_context);
+        int32_t ret;
+        if (requested.policy == EB_THREAD_POLICY_NORMAL) {
+            ret = pthread_create(
+                (pthread_t*)thread_handle,      // Thread handle
+                (const pthread_attr_t*)EB_NULL, // attributes
+                thread_function,                 // function to be run by new thread
+                thread_context);
+            if (ret == 0 && applied_ptr) {
+                applied_ptr->policy = EB_THREAD_POLICY_NORMAL;
+                applied_ptr->priority = 0;
+            }
+        }
+        else {
+            // The new thread sets its own scheduling, then releases the creator
+            EbThreadStart thread_start_data;
+            thread_start_data.thread_function = thread_function;
+            thread_start_data.thread_context = thread_context;
+            thread_start_data.requested = requested;
+            thread_start_data.started_semaphore = eb_create_semaphore(0, 1);
+            if (thread_start_data.started_semaphore == NULL)
+                ret = -1;
+            else {
+                ret = pthread_create(
+                    (pthread_t*)thread_handle,      // Thread handle
+                    (const pthread_attr_t*)EB_NULL, // attributes
+                    thread_start,                    // function to be run by new thread
+                    &thread_start_data);
+                if (ret == 0) {
+                    eb_block_on_semaphore(thread_start_data.started_semaphore);
+                    if (applied_ptr)
+                        *applied_ptr = thread_start_data.applied;
                 }
+                eb_destroy_semaphore(thread_start_data.started_semaphore);
             }
         }
+        if (ret != 0) {
+            free(thread_handle);
+            thread_handle = NULL;
+        }
     }
-    pthread_attr_destroy(&attr);
 #endif // _WIN32
 
     return thread_handle;
@@ -249,6 +379,8 @@ EbErrorType eb_block_on_semaphore(
     EbHandle semaphore_handle)
 {
     EbErrorType return_error = EB_ErrorNone;
+    // A kernel thread of a host context gives its worker back while blocked
+    EbHostChannel *host_channel_ptr = eb_host_worker_suspend();
 
 #ifdef _WIN32
     return_error = WaitForSingleObject((HANDLE)semaphore_handle, INFINITE) ? EB_ErrorSemaphoreUnresponsive : EB_ErrorNone;
@@ -256,6 +388,9 @@ EbErrorType eb_block_on_semaphore(
     return_error = sem_wait((sem_t*)semaphore_handle) ? EB_ErrorSemaphoreUnresponsive : EB_ErrorNone;
 #endif // _WIN32
 
+    if (host_channel_ptr)
+        eb_host_worker_acquire(host_channel_ptr);
+
     return return_error;
 }
 
@@ -329,6 +464,18 @@ EbErrorType eb_block_on_mutex(
     EbHandle mutex_handle)
 {
     EbErrorType return_error = EB_ErrorNone;
+    EbHostChannel *host_channel_ptr;
+
+    // A kernel thread of a host context gives its worker back while it waits,
+    // since the thread holding the mutex may itself wait for a worker
+#ifdef _WIN32
+    if (WaitForSingleObject((HANDLE)mutex_handle, 0) == WAIT_OBJECT_0)
+        return EB_ErrorNone;
+#elif defined(__linux__) || defined(__APPLE__)
+    if (pthread_mutex_trylock((pthread_mutex_t*)mutex_handle) == 0)
+        return EB_ErrorNone;
+#endif // _WIN32
+    host_channel_ptr = eb_host_worker_suspend();
 
 #ifdef _WIN32
     return_error = WaitForSingleObject((HANDLE)mutex_handle, INFINITE) ? EB_ErrorMutexUnresponsive : EB_ErrorNone;
@@ -336,6 +483,9 @@ EbErrorType eb_block_on_mutex(
     return_error = pthread_mutex_lock((pthread_mutex_t*)mutex_handle) ? EB_ErrorMutexUnresponsive : EB_ErrorNone;
 #endif // _WIN32
 
+    if (host_channel_ptr)
+        eb_host_worker_acquire(host_channel_ptr);
+
     return return_error;
 }
 
@@ -375,3 +525,105 @@ EbErrorType eb_destroy_mutex(
 
     return return_error;
 }
+
+/***************************************
+ * NUMA memory placement
+ ***************************************/
+#if defined(__linux__)
+// From <numaif.h>, defined here to avoid a libnuma dependency
+#define EB_MPOL_BIND                2
+#define EB_MPOL_INTERLEAVE          3
+#define EB_MPOL_MF_MOVE             (1 << 1)
+#endif
+
+/***************************************
+ * eb_numa_get_cpu_node_mask
+ *   Returns the NUMA nodes of the given
+ *   logical processors, 0 if unknown.
+ ***************************************/
+uint64_t eb_numa_get_cpu_node_mask(
+    const uint32_t *cpu_array,
+    uint32_t        cpu_count)
+{
+    uint64_t node_mask = 0;
+#if defined(__linux__)
+    char cpu_path[64];
+    for (uint32_t cpu_index = 0; cpu_index < cpu_count; ++cpu_index) {
+        DIR *cpu_dir;
+        struct dirent *entry;
+        snprintf(cpu_path, sizeof(cpu_path), "/sys/devices/system/cpu/cpu%u", cpu_array[cpu_index]);
+        cpu_dir = opendir(cpu_path);
+        if (cpu_dir == NULL)
+            continue;
+        // The cpu directory holds a nodeN link to its node
+        while ((entry = readdir(cpu_dir)) != NULL) {
+            if (strncmp(entry->d_name, "node", 4) == 0 && entry->d_name[4] >= '0' && entry->d_name[4] <= '9') {
+                uint32_t node = (uint32_t)strtoul(entry->d_name + 4, NULL, 10);
+                if (node < EB_NUMA_MAX_NODES)
+                    node_mask |= (uint64_t)1 << node;
+            }
+        }
+        closedir(cpu_dir);
+    }
+#else
+    (void)cpu_array;
+    (void)cpu_count;
+#endif
+    return node_mask;
+}
+
+/***************************************
+ * eb_numa_placement_init
+ *   Sets the placement of the buffers of
+ *   an encoder instance, applied by the
+ *   library allocation macros through
+ *   its memory map.
+ ***************************************/
+void eb_numa_placement_init(
+    EbNumaPlacement   *placement,
+    EbNumaMemoryPolicy policy,
+    uint64_t           node_mask)
+{
+    memset(placement->node_mask, 0, sizeof(placement->node_mask));
+    for (uint32_t node = 0; node < EB_NUMA_MAX_NODES; ++node) {
+        if (node_mask & ((uint64_t)1 << node))
+            placement->node_mask[node / (8 * sizeof(unsigned long))] |= 1UL << (node % (8 * sizeof(unsigned long)));
+    }
+    placement->policy = node_mask ? policy : EB_NUMA_POLICY_DEFAULT;
+}
+
+/***************************************
+ * eb_numa_place_memory
+ *   Applies the memory policy to the
+ *   whole pages of a large allocation.
+ *   Pages are placed when first touched,
+ *   whichever thread touches them.
+ ***************************************/
+void eb_numa_place_memory(const EbNumaPlacement *placement, void *ptr, size_t size)
+{
+#if defined(__linux__) && defined(SYS_mbind)
+    static uintptr_t page_size = 0;
+    uintptr_t start, end;
+
+    if (placement == (const EbNumaPlacement*)EB_NULL || placement->policy == EB_NUMA_POLICY_DEFAULT || size < EB_NUMA_MIN_PLACEMENT_SIZE)
+        return;
+
+    if (page_size == 0)
+        page_size = (uintptr_t)sysconf(_SC_PAGESIZE);
+
+    // The first and last pages may be shared with other allocations
+    start = ((uintptr_t)ptr + page_size - 1) & ~(page_size - 1);
+    end = ((uintptr_t)ptr + size) & ~(page_size - 1);
+    if (end <= start)
+        return;
+
+    // Best effort, the allocation stays usable if the kernel refuses
+    syscall(SYS_mbind, (void*)start, (unsigned long)(end - start),
+        placement->policy == EB_NUMA_POLICY_BIND ? EB_MPOL_BIND : EB_MPOL_INTERLEAVE,
+        placement->node_mask, (unsigned long)EB_NUMA_MAX_NODES + 1, EB_MPOL_MF_MOVE);
+#else
+    (void)placement;
+    (void)ptr;
+    (void)size;
+#endif
+}
@@ -22,9 +22,13 @@ extern "C" {
     /**************************************
      * Threads
      **************************************/
+    // The thread gets the scheduling of requested_ptr, the OS default when
+    // NULL, and writes what it could actually apply to applied_ptr
     extern EbHandle eb_create_thread(
         void *thread_function(void *),
-        void *thread_context);
+        void *thread_context,
+        const EbThreadPriority *requested_ptr,
+        EbThreadPriority       *applied_ptr);
 
     extern EbErrorType eb_start_thread(
         EbHandle thread_handle);
@@ -70,17 +74,91 @@ extern "C" {
     extern EbErrorType eb_destroy_mutex(
         EbHandle mutex_handle);
 
+    /**************************************
+     * NUMA memory placement
+     *   Linux only, no-ops elsewhere. Nodes
+     *   are given as a bit mask.
+     **************************************/
+#define EB_NUMA_MAX_NODES               64
+#define EB_NUMA_MIN_PLACEMENT_SIZE      (64 * 1024)     // smaller allocations follow first touch
+
+    typedef enum EbNumaMemoryPolicy
+    {
+        EB_NUMA_POLICY_DEFAULT    = 0,
+        EB_NUMA_POLICY_BIND       = 1,
+        EB_NUMA_POLICY_INTERLEAVE = 2
+    } EbNumaMemoryPolicy;
+
+    extern uint64_t eb_numa_get_cpu_node_mask(
+        const uint32_t *cpu_array,
+        uint32_t        cpu_count);
+
+    // Placement of the allocations of an encoder instance, see numa_placement
+    typedef struct EbNumaPlacement
+    {
+        EbNumaMemoryPolicy policy;
+        unsigned long      node_mask[(EB_NUMA_MAX_NODES + 8 * sizeof(unsigned long) - 1) / (8 * sizeof(unsigned long))];
+    } EbNumaPlacement;
+
+    extern void eb_numa_placement_init(
+        EbNumaPlacement   *placement,
+        EbNumaMemoryPolicy policy,
+        uint64_t           node_mask);
+
+    /**************************************
+     * Atomics
+     *   32-bit sequentially consistent
+     *   operations used by the lock-free
+     *   system resource queues.
+     **************************************/
+#ifdef _WIN32
+    static INLINE int32_t eb_atomic_load(volatile int32_t *ptr) {
+        return (int32_t)InterlockedOr((volatile LONG*)ptr, 0);
+    }
+    static INLINE void eb_atomic_store(volatile int32_t *ptr, int32_t value) {
+        InterlockedExchange((volatile LONG*)ptr, (LONG)value);
+    }
+    static INLINE int32_t eb_atomic_fetch_add(volatile int32_t *ptr, int32_t value) {
+        return (int32_t)InterlockedExchangeAdd((volatile LONG*)ptr, (LONG)value);
+    }
+    static INLINE EbBool eb_atomic_compare_exchange(volatile int32_t *ptr, int32_t expected, int32_t desired) {
+        return InterlockedCompareExchange((volatile LONG*)ptr, (LONG)desired, (LONG)expected) == (LONG)expected;
+    }
+    static INLINE void eb_cpu_pause(void) {
+        YieldProcessor();
+    }
+#else
+    static INLINE int32_t eb_atomic_load(volatile int32_t *ptr) {
+        return __atomic_load_n(ptr, __ATOMIC_SEQ_CST);
+    }
+    static INLINE void eb_atomic_store(volatile int32_t *ptr, int32_t value) {
+        __atomic_store_n(ptr, value, __ATOMIC_SEQ_CST);
+    }
+    static INLINE int32_t eb_atomic_fetch_add(volatile int32_t *ptr, int32_t value) {
+        return __atomic_fetch_add(ptr, value, __ATOMIC_SEQ_CST);
+    }
+    static INLINE EbBool eb_atomic_compare_exchange(volatile int32_t *ptr, int32_t expected, int32_t desired) {
+        return __atomic_compare_exchange_n(ptr, &expected, desired, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST) ? EB_TRUE : EB_FALSE;
+    }
+    static INLINE void eb_cpu_pause(void) {
+#if defined(__x86_64__) || defined(__i386__)
+        __asm__ __volatile__("pause");
+#endif
+    }
+#endif
+
     extern    EbMemoryMapEntry *memory_map;                // library Memory table
     extern    uint32_t         *memory_map_index;          // library memory index
     extern    uint64_t         *total_lib_memory;          // library Memory malloc'd
+    extern    uint32_t          memory_map_category;       // EbMemoryCategory of new entries
 #if MEM_MAP_OPT
 #ifdef _WIN32
     extern    GROUP_AFFINITY    group_affinity;
     extern    uint8_t           num_groups;
     extern    EbBool            alternate_groups;
 
-#define EB_CREATETHREAD(type, pointer, n_elements, pointer_class, thread_function, thread_context) \
-    pointer = eb_create_thread(thread_function, thread_context); \
+#define EB_CREATETHREAD(type, pointer, n_elements, pointer_class, thread_function, thread_context, requested_ptr, applied_ptr) \
+    pointer = eb_create_thread(thread_function, thread_context, requested_ptr, applied_ptr); \
     if (pointer == (type)EB_NULL) \
         return EB_ErrorInsufficientResources; \
     else { \
@@ -89,6 +167,8 @@ extern "C" {
         node->ptr_type         = pointer_class; \
         node->ptr              = (EbPtr)pointer;\
         node->prev_entry       = (EbPtr)memory_map;   \
+        node->alloc_size       = (uint64_t)(n_elements); \
+        node->category         = memory_map_category; \
         memory_map             = node;          \
         (*memory_map_index)++;                  \
         if (n_elements % 8 == 0) \
@@ -112,8 +192,8 @@ extern "C" {
 #include <sched.h>
 #include <pthread.h>
 extern    cpu_set_t                   group_affinity;
-#define EB_CREATETHREAD(type, pointer, n_elements, pointer_class, thread_function, thread_context) \
-    pointer = eb_create_thread(thread_function, thread_context); \
+#define EB_CREATETHREAD(type, pointer, n_elements, pointer_class, thread_function, thread_context, requested_ptr, applied_ptr) \
+    pointer = eb_create_thread(thread_function, thread_context, requested_ptr, applied_ptr); \
     if (pointer == (type)EB_NULL) { \
         return EB_ErrorInsufficientResources; \
     } \
@@ -124,6 +204,8 @@ extern    cpu_set_t                   group_affinity;
         node->ptr_type         = pointer_class; \
         node->ptr              = (EbPtr)pointer;\
         node->prev_entry       = (EbPtr)memory_map;   \
+        node->alloc_size       = (uint64_t)(n_elements); \
+        node->category         = memory_map_category; \
         memory_map             = node;          \
         (*memory_map_index)++; \
         if (n_elements % 8 == 0) \
@@ -134,8 +216,8 @@ extern    cpu_set_t                   group_affinity;
     }
     
 #else
-#define EB_CREATETHREAD(type, pointer, n_elements, pointer_class, thread_function, thread_context) \
-    pointer = eb_create_thread(thread_function, thread_context); \
+#define EB_CREATETHREAD(type, pointer, n_elements, pointer_class, thread_function, thread_context, requested_ptr, applied_ptr) \
+    pointer = eb_create_thread(thread_function, thread_context, requested_ptr, applied_ptr); \
     if (pointer == (type)EB_NULL) { \
         return EB_ErrorInsufficientResources; \
     } \
@@ -145,6 +227,8 @@ extern    cpu_set_t                   group_affinity;
         node->ptr_type         = pointer_class; \
         node->ptr              = (EbPtr)pointer;\
         node->prev_entry       = (EbPtr)memory_map;   \
+        node->alloc_size       = (uint64_t)(n_elements); \
+        node->category         = memory_map_category; \
         memory_map             = node;          \
         (*memory_map_index)++; \
         if (n_elements % 8 == 0) \
@@ -160,8 +244,8 @@ extern    cpu_set_t                   group_affinity;
     extern    uint8_t           num_groups;
     extern    EbBool            alternate_groups;
 
-#define EB_CREATETHREAD(type, pointer, n_elements, pointer_class, thread_function, thread_context) \
-    pointer = eb_create_thread(thread_function, thread_context); \
+#define EB_CREATETHREAD(type, pointer, n_elements, pointer_class, thread_function, thread_context, requested_ptr, applied_ptr) \
+    pointer = eb_create_thread(thread_function, thread_context, requested_ptr, applied_ptr); \
     if (pointer == (type)EB_NULL) { \
         return EB_ErrorInsufficientResources; \
     } \
@@ -195,8 +279,8 @@ extern    cpu_set_t                   group_affinity;
 #include <sched.h>
 #include <pthread.h>
 extern    cpu_set_t                   group_affinity;
-#define EB_CREATETHREAD(type, pointer, n_elements, pointer_class, thread_function, thread_context) \
-    pointer = eb_create_thread(thread_function, thread_context); \
+#define EB_CREATETHREAD(type, pointer, n_elements, pointer_class, thread_function, thread_context, requested_ptr, applied_ptr) \
+    pointer = eb_create_thread(thread_function, thread_context, requested_ptr, applied_ptr); \
     if (pointer == (type)EB_NULL) { \
         return EB_ErrorInsufficientResources; \
     } \
@@ -216,8 +300,8 @@ extern    cpu_set_t                   group_affinity;
     } \
     lib_thread_count++;
 #else
-#define EB_CREATETHREAD(type, pointer, n_elements, pointer_class, thread_function, thread_context) \
-    pointer = eb_create_thread(thread_function, thread_context); \
+#define EB_CREATETHREAD(type, pointer, n_elements, pointer_class, thread_function, thread_context, requested_ptr, applied_ptr) \
+    pointer = eb_create_thread(thread_function, thread_context, requested_ptr, applied_ptr); \
     if (pointer == (type)EB_NULL) { \
         return EB_ErrorInsufficientResources; \
     } \
@@ -1635,6 +1635,30 @@ extern "C" {
     void aom_fft8x8_float_avx2(const float *input, float *temp, float *output);
     RTCD_EXTERN void(*aom_fft8x8_float)(const float *input, float *temp, float *output);
 
+    void aom_noise_tx_filter_block_c(float *tx_block, const float *psd, int32_t n);
+    void aom_noise_tx_filter_block_avx2(float *tx_block, const float *psd, int32_t n);
+    RTCD_EXTERN void(*aom_noise_tx_filter_block)(float *tx_block, const float *psd, int32_t n);
+
+    void aom_noise_window_block_c(const double *block_d, const float *window, float *block, int32_t n);
+    void aom_noise_window_block_avx2(const double *block_d, const float *window, float *block, int32_t n);
+    RTCD_EXTERN void(*aom_noise_window_block)(const double *block_d, const float *window, float *block, int32_t n);
+
+    void aom_noise_accumulate_block_c(const float *block, const double *plane_d, const float *window, int32_t block_size, float *result, int32_t result_stride);
+    void aom_noise_accumulate_block_avx2(const float *block, const double *plane_d, const float *window, int32_t block_size, float *result, int32_t result_stride);
+    RTCD_EXTERN void(*aom_noise_accumulate_block)(const float *block, const double *plane_d, const float *window, int32_t block_size, float *result, int32_t result_stride);
+
+    void aom_flat_block_fit_plane_c(const double *A, const double *AtA_inv, double *plane, double *block, int32_t n);
+    void aom_flat_block_fit_plane_avx2(const double *A, const double *AtA_inv, double *plane, double *block, int32_t n);
+    RTCD_EXTERN void(*aom_flat_block_fit_plane)(const double *A, const double *AtA_inv, double *plane, double *block, int32_t n);
+
+    void aom_flat_block_stats_x4_c(const double *const *blocks, int32_t block_size, double *stats);
+    void aom_flat_block_stats_x4_avx2(const double *const *blocks, int32_t block_size, double *stats);
+    RTCD_EXTERN void(*aom_flat_block_stats_x4)(const double *const *blocks, int32_t block_size, double *stats);
+
+    void aom_noise_add_observation_c(const double *buffer, double val, double norm_sq, int32_t n, double *A, double *b);
+    void aom_noise_add_observation_avx2(const double *buffer, double val, double norm_sq, int32_t n, double *A, double *b);
+    RTCD_EXTERN void(*aom_noise_add_observation)(const double *buffer, double val, double norm_sq, int32_t n, double *A, double *b);
+
     void aom_highbd_dc_128_predictor_16x16_c(uint16_t *dst, ptrdiff_t y_stride, const uint16_t *above, const uint16_t *left, int32_t bd);
     void aom_highbd_dc_128_predictor_16x16_avx2(uint16_t *dst, ptrdiff_t y_stride, const uint16_t *above, const uint16_t *left, int32_t bd);
     RTCD_EXTERN void(*aom_highbd_dc_128_predictor_16x16)(uint16_t *dst, ptrdiff_t y_stride, const uint16_t *above, const uint16_t *left, int32_t bd);
@@ -2396,16 +2420,9 @@ extern "C" {
 
 #ifdef RTCD_C
 
-    static void setup_rtcd_internal(EbAsm asm_type)
+    //to use C: flags=0
+    static void setup_rtcd_flags(int32_t flags)
     {
-        int32_t flags = HAS_MMX | HAS_SSE | HAS_SSE2 | HAS_SSE3 | HAS_SSSE3 | HAS_SSE4_1 | HAS_SSE4_2 | HAS_AVX;
-
-        if (asm_type == ASM_AVX2)
-            flags |= HAS_AVX2;
-        //if (asm_type == ASM_NON_AVX2)
-        //    flags = ~HAS_AVX2;
-
-        //to use C: flags=0
 
         apply_selfguided_restoration = apply_selfguided_restoration_c;
         if (flags & HAS_AVX2) apply_selfguided_restoration = apply_selfguided_restoration_avx2;
@@ -3608,7 +3625,29 @@ extern "C" {
         /*if (flags & HAS_AVX2)*/ aom_ifft8x8_float = aom_ifft8x8_float_avx2;
         aom_ifft2x2_float = aom_ifft2x2_float_c;
         /*if (flags & HAS_SSE2)*/ aom_ifft4x4_float = aom_ifft4x4_float_sse2;
+        aom_noise_tx_filter_block = aom_noise_tx_filter_block_c;
+        if (flags & HAS_AVX2) aom_noise_tx_filter_block = aom_noise_tx_filter_block_avx2;
+        aom_noise_window_block = aom_noise_window_block_c;
+        if (flags & HAS_AVX2) aom_noise_window_block = aom_noise_window_block_avx2;
+        aom_noise_accumulate_block = aom_noise_accumulate_block_c;
+        if (flags & HAS_AVX2) aom_noise_accumulate_block = aom_noise_accumulate_block_avx2;
+        aom_flat_block_fit_plane = aom_flat_block_fit_plane_c;
+        if (flags & HAS_AVX2) aom_flat_block_fit_plane = aom_flat_block_fit_plane_avx2;
+        aom_flat_block_stats_x4 = aom_flat_block_stats_x4_c;
+        if (flags & HAS_AVX2) aom_flat_block_stats_x4 = aom_flat_block_stats_x4_avx2;
+        aom_noise_add_observation = aom_noise_add_observation_c;
+        if (flags & HAS_AVX2) aom_noise_add_observation = aom_noise_add_observation_avx2;
+
+    }
+
+    static void setup_rtcd_internal(EbAsm asm_type)
+    {
+        int32_t flags = HAS_MMX | HAS_SSE | HAS_SSE2 | HAS_SSE3 | HAS_SSSE3 | HAS_SSE4_1 | HAS_SSE4_2 | HAS_AVX;
+
+        if (asm_type == ASM_AVX2)
+            flags |= HAS_AVX2;
 
+        setup_rtcd_flags(flags);
     }
 #endif
 
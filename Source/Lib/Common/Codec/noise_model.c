@@ -15,6 +15,7 @@
 #include "noise_model.h"
 #include "noise_util.h"
 #include "mathutils.h"
+#include "aom_dsp_rtcd.h"
 
 #define kLowPolyNumParams 3
 
@@ -23,6 +24,17 @@ static const int32_t kMaxLag = 4;
 void *aom_memalign(size_t align, size_t size);
 void aom_free(void *memblk);
 
+// Processes the count block rows of job with runner, or here when it is NULL
+static void run_block_rows(aom_denoise_runner_t runner, void *runner_ctx,
+    void(*process)(void *job, int32_t index), void *job, int32_t count) {
+    if (runner) {
+        runner(runner_ctx, process, job, count);
+        return;
+    }
+    for (int32_t index = 0; index < count; ++index)
+        process(job, index);
+}
+
 void un_pack2d(
     uint16_t      *in16_bit_buffer,
     uint32_t       in_stride,
@@ -527,9 +539,7 @@ void aom_flat_block_finder_extract_block(
     const int32_t n = block_size * block_size;
     const double *A = block_finder->A;
     const double *AtA_inv = block_finder->AtA_inv;
-    double plane_coords[kLowPolyNumParams];
-    double AtA_inv_b[kLowPolyNumParams];
-    int32_t xi, yi, i;
+    int32_t xi, yi;
 
     if (block_finder->use_highbd) {
         const uint16_t *const data16 = (const uint16_t *const)data;
@@ -552,16 +562,57 @@ void aom_flat_block_finder_extract_block(
             }
         }
     }
+    aom_flat_block_fit_plane(A, AtA_inv, plane, block, n);
+}
+
+void aom_flat_block_fit_plane_c(const double *A, const double *AtA_inv,
+    double *plane, double *block, int32_t n) {
+    double plane_coords[kLowPolyNumParams];
+    double AtA_inv_b[kLowPolyNumParams];
+
     multiply_mat(block, A, AtA_inv_b, 1, n, kLowPolyNumParams);
     multiply_mat(AtA_inv, AtA_inv_b, plane_coords, kLowPolyNumParams,
         kLowPolyNumParams, 1);
     multiply_mat(A, plane_coords, plane, n, kLowPolyNumParams, 1);
 
-    for (i = 0; i < n; ++i) {
+    for (int32_t i = 0; i < n; ++i) {
         block[i] -= plane[i];
     }
 }
 
+void aom_flat_block_stats_x4_c(const double *const *blocks, int32_t block_size,
+    double *stats) {
+    for (int32_t k = 0; k < 4; ++k) {
+        const double *block = blocks[k];
+        // Gradient covariance matrix, mean and energy of the inner samples
+        double Gxx = 0, Gxy = 0, Gyy = 0;
+        double var = 0;
+        double mean = 0;
+
+        for (int32_t yi = 1; yi < block_size - 1; ++yi) {
+            for (int32_t xi = 1; xi < block_size - 1; ++xi) {
+                const double gx = (block[yi * block_size + xi + 1] -
+                    block[yi * block_size + xi - 1]) /
+                    2;
+                const double gy = (block[yi * block_size + xi + block_size] -
+                    block[yi * block_size + xi - block_size]) /
+                    2;
+                Gxx += gx * gx;
+                Gxy += gx * gy;
+                Gyy += gy * gy;
+
+                mean += block[yi * block_size + xi];
+                var += block[yi * block_size + xi] * block[yi * block_size + xi];
+            }
+        }
+        stats[5 * k + 0] = Gxx;
+        stats[5 * k + 1] = Gxy;
+        stats[5 * k + 2] = Gyy;
+        stats[5 * k + 3] = mean;
+        stats[5 * k + 4] = var;
+    }
+}
+
 typedef struct {
     int32_t index;
     float score;
@@ -577,66 +628,72 @@ static int32_t compare_scores(const void *a, const void *b) {
     return 0;
 }
 
-int32_t aom_flat_block_finder_run(const aom_flat_block_finder_t *block_finder,
-    const uint8_t *const data, int32_t w, int32_t h,
-    int32_t stride, uint8_t *flat_blocks) {
+// Flat block search of a picture, processed by block rows
+typedef struct {
+    const aom_flat_block_finder_t *block_finder;
+    const uint8_t *data;
+    int32_t w;
+    int32_t h;
+    int32_t stride;
+    int32_t num_blocks_w;
+    // 4 blocks and a plane per scratch, the block rows take them modulo
+    // scratch_count
+    double *scratch;
+    int32_t scratch_count;
+    uint8_t *flat_blocks;
+    index_and_score_t *scores;
+    int32_t *num_flat;  // Flat blocks of each block row
+} flat_block_finder_job_t;
+
+static void flat_block_finder_row(void *job, int32_t by) {
     // The gradient-based features used in this code are based on:
     //  A. Kokaram, D. Kelly, H. Denman and A. Crawford, "Measuring noise
     //  correlation for improved video denoising," 2012 19th, ICIP.
     // The thresholds are more lenient to allow for correct grain modeling
     // if extreme cases.
+    const flat_block_finder_job_t *finder_job = (const flat_block_finder_job_t *)job;
+    const aom_flat_block_finder_t *block_finder = finder_job->block_finder;
     const int32_t block_size = block_finder->block_size;
     const int32_t n = block_size * block_size;
+    const int32_t num_blocks_w = finder_job->num_blocks_w;
     const double kTraceThreshold = 0.15 / (32 * 32);
     const double kRatioThreshold = 1.25;
     const double kNormThreshold = 0.08 / (32 * 32);
     const double kVarThreshold = 0.005 / (double)n;
-    const int32_t num_blocks_w = (w + block_size - 1) / block_size;
-    const int32_t num_blocks_h = (h + block_size - 1) / block_size;
+    double *block[4];
+    double *plane;
     int32_t num_flat = 0;
-    int32_t bx = 0, by = 0;
-    double *plane = (double *)malloc(n * sizeof(*plane));
-    double *block = (double *)malloc(n * sizeof(*block));
-    index_and_score_t *scores = (index_and_score_t *)malloc(
-        num_blocks_w * num_blocks_h * sizeof(*scores));
-    if (plane == NULL || block == NULL || scores == NULL) {
-        fprintf(stderr, "Failed to allocate memory for block of size %d\n", n);
-        free(plane);
-        free(block);
-        free(scores);
-        return -1;
-    }
+    int32_t bx, k;
+
+    block[0] = finder_job->scratch + (by % finder_job->scratch_count) * 5 * n;
+    block[1] = block[0] + n;
+    block[2] = block[1] + n;
+    block[3] = block[2] + n;
+    plane = block[3] + n;
+
+    // The features of 4 blocks are computed together
+    for (bx = 0; bx < num_blocks_w; bx += 4) {
+        const int32_t block_count = AOMMIN(4, num_blocks_w - bx);
+        const double *blocks[4];
+        double stats[4 * 5];
+
+        for (k = 0; k < block_count; ++k) {
+            aom_flat_block_finder_extract_block(block_finder, finder_job->data,
+                finder_job->w, finder_job->h, finder_job->stride,
+                (bx + k) * block_size, by * block_size, plane, block[k]);
+        }
+        for (k = 0; k < 4; ++k)
+            blocks[k] = block[AOMMIN(k, block_count - 1)];
+        aom_flat_block_stats_x4(blocks, block_size, stats);
+
+        for (k = 0; k < block_count; ++k) {
+            const int32_t index = by * num_blocks_w + bx + k;
+            double Gxx = stats[5 * k + 0];
+            double Gxy = stats[5 * k + 1];
+            double Gyy = stats[5 * k + 2];
+            double mean = stats[5 * k + 3];
+            double var = stats[5 * k + 4];
 
-#ifdef NOISE_MODEL_LOG_SCORE
-    fprintf(stderr, "score = [");
-#endif
-    for (by = 0; by < num_blocks_h; ++by) {
-        for (bx = 0; bx < num_blocks_w; ++bx) {
-            // Compute gradient covariance matrix.
-            double Gxx = 0, Gxy = 0, Gyy = 0;
-            double var = 0;
-            double mean = 0;
-            int32_t xi, yi;
-            aom_flat_block_finder_extract_block(block_finder, data, w, h, stride,
-                bx * block_size, by * block_size,
-                plane, block);
-
-            for (yi = 1; yi < block_size - 1; ++yi) {
-                for (xi = 1; xi < block_size - 1; ++xi) {
-                    const double gx = (block[yi * block_size + xi + 1] -
-                        block[yi * block_size + xi - 1]) /
-                        2;
-                    const double gy = (block[yi * block_size + xi + block_size] -
-                        block[yi * block_size + xi - block_size]) /
-                        2;
-                    Gxx += gx * gx;
-                    Gxy += gx * gy;
-                    Gyy += gy * gy;
-
-                    mean += block[yi * block_size + xi];
-                    var += block[yi * block_size + xi] * block[yi * block_size + xi];
-                }
-            }
             mean /= (block_size - 2) * (block_size - 2);
 
             // Normalize gradients by BlockSize.
@@ -667,9 +724,9 @@ int32_t aom_flat_block_finder_run(const aom_flat_block_finder_t *block_finder,
                     (float)(1.0 / (1 + exp(-(weights[0] * var + weights[1] * ratio +
                         weights[2] * trace + weights[3] * norm +
                         weights[4]))));
-                flat_blocks[by * num_blocks_w + bx] = is_flat ? 255 : 0;
-                scores[by * num_blocks_w + bx].score = var > kVarThreshold ? score : 0;
-                scores[by * num_blocks_w + bx].index = by * num_blocks_w + bx;
+                finder_job->flat_blocks[index] = is_flat ? 255 : 0;
+                finder_job->scores[index].score = var > kVarThreshold ? score : 0;
+                finder_job->scores[index].index = index;
 #ifdef NOISE_MODEL_LOG_SCORE
                 fprintf(stderr, "%g %g %g %g %g %d ", score, var, ratio, trace, norm,
                     is_flat);
@@ -677,13 +734,60 @@ int32_t aom_flat_block_finder_run(const aom_flat_block_finder_t *block_finder,
                 num_flat += is_flat;
             }
         }
+    }
 #ifdef NOISE_MODEL_LOG_SCORE
-        fprintf(stderr, "\n");
+    fprintf(stderr, "\n");
 #endif
+    finder_job->num_flat[by] = num_flat;
+}
+
+int32_t aom_flat_block_finder_run(const aom_flat_block_finder_t *block_finder,
+    const uint8_t *const data, int32_t w, int32_t h,
+    int32_t stride, uint8_t *flat_blocks, aom_denoise_runner_t runner,
+    void *runner_ctx) {
+    const int32_t block_size = block_finder->block_size;
+    const int32_t n = block_size * block_size;
+    const int32_t num_blocks_w = (w + block_size - 1) / block_size;
+    const int32_t num_blocks_h = (h + block_size - 1) / block_size;
+    // Each block row has its scratch when they are shared out
+    const int32_t scratch_count = runner ? num_blocks_h : 1;
+    int32_t num_flat = 0;
+    flat_block_finder_job_t finder_job;
+    double *scratch = (double *)malloc(scratch_count * 5 * n * sizeof(*scratch));
+    int32_t *row_num_flat = (int32_t *)malloc(num_blocks_h * sizeof(*row_num_flat));
+    index_and_score_t *scores = (index_and_score_t *)malloc(
+        num_blocks_w * num_blocks_h * sizeof(*scores));
+    if (scratch == NULL || row_num_flat == NULL || scores == NULL) {
+        fprintf(stderr, "Failed to allocate memory for block of size %d\n", n);
+        free(scratch);
+        free(row_num_flat);
+        free(scores);
+        return -1;
     }
+
+    finder_job.block_finder = block_finder;
+    finder_job.data = data;
+    finder_job.w = w;
+    finder_job.h = h;
+    finder_job.stride = stride;
+    finder_job.num_blocks_w = num_blocks_w;
+    finder_job.scratch = scratch;
+    finder_job.scratch_count = scratch_count;
+    finder_job.flat_blocks = flat_blocks;
+    finder_job.scores = scores;
+    finder_job.num_flat = row_num_flat;
+
+#ifdef NOISE_MODEL_LOG_SCORE
+    fprintf(stderr, "score = [");
+#endif
+    run_block_rows(runner, runner_ctx, flat_block_finder_row, &finder_job,
+        num_blocks_h);
 #ifdef NOISE_MODEL_LOG_SCORE
     fprintf(stderr, "];\n");
 #endif
+    for (int32_t by = 0; by < num_blocks_h; ++by)
+        num_flat += row_num_flat[by];
+
     // Find the top-scored blocks (most likely to be flat) and set the flat blocks
     // be the union of the thresholded results and the top 10th percentile of the
     // scored results.
@@ -696,8 +800,8 @@ int32_t aom_flat_block_finder_run(const aom_flat_block_finder_t *block_finder,
             flat_blocks[scores[i].index] |= 1;
         }
     }
-    free(block);
-    free(plane);
+    free(scratch);
+    free(row_num_flat);
     free(scores);
     return num_flat;
 }
@@ -815,6 +919,16 @@ void aom_noise_model_free(aom_noise_model_t *model) {
 EXTRACT_AR_ROW(uint8_t, lowbd);
 EXTRACT_AR_ROW(uint16_t, highbd);
 
+void aom_noise_add_observation_c(const double *buffer, double val,
+    double norm_sq, int32_t n, double *A, double *b) {
+    for (int32_t i = 0; i < n; ++i) {
+        for (int32_t j = 0; j < n; ++j) {
+            A[i * n + j] += (buffer[i] * buffer[j]) / norm_sq;
+        }
+        b[i] += (buffer[i] * val) / norm_sq;
+    }
+}
+
 static int32_t add_block_observations(
     aom_noise_model_t *noise_model, int32_t c, const uint8_t *const data,
     const uint8_t *const denoised, int32_t w, int32_t h, int32_t stride, int32_t sub_log2[2],
@@ -866,13 +980,8 @@ static int32_t add_block_observations(
                             denoised, stride, sub_log2, alt_data,
                             alt_denoised, alt_stride, x + x_o,
                             y + y_o, buffer);
-                    for (int32_t i = 0; i < n; ++i) {
-                        for (int32_t j = 0; j < n; ++j) {
-                            A[i * n + j] +=
-                                (buffer[i] * buffer[j]) / (normalization * normalization);
-                        }
-                        b[i] += (buffer[i] * val) / (normalization * normalization);
-                    }
+                    aom_noise_add_observation(buffer, val,
+                        normalization * normalization, n, A, b);
                     noise_model->latest_state[c].num_observations++;
                 }
             }
@@ -1305,12 +1414,6 @@ int32_t aom_noise_model_get_grain_parameters(aom_noise_model_t *const noise_mode
     return 1;
 }
 
-static void pointwise_multiply(const float *a, float *b, int32_t n) {
-    for (int32_t i = 0; i < n; ++i) {
-        b[i] *= a[i];
-    }
-}
-
 static float *get_half_cos_window(int32_t block_size) {
     float *window_function =
         (float *)malloc(block_size * block_size * sizeof(*window_function));
@@ -1360,21 +1463,103 @@ static float *get_half_cos_window(int32_t block_size) {
 DITHER_AND_QUANTIZE(uint8_t, lowbd);
 DITHER_AND_QUANTIZE(uint16_t, highbd);
 
+void aom_noise_window_block_c(const double *block_d, const float *window,
+    float *block, int32_t n) {
+    for (int32_t i = 0; i < n; ++i) {
+        block[i] = (float)block_d[i];
+        block[i] *= window[i];
+    }
+}
+
+void aom_noise_accumulate_block_c(const float *block, const double *plane_d,
+    const float *window, int32_t block_size, float *result,
+    int32_t result_stride) {
+    for (int32_t y = 0; y < block_size; ++y) {
+        for (int32_t x = 0; x < block_size; ++x) {
+            const int32_t i = y * block_size + x;
+            float plane = (float)plane_d[i];
+            // Apply window function to the plane approximation (we will apply
+            // it to the sum of plane + block when composing the results).
+            plane *= window[i];
+            result[y * result_stride + x] += (block[i] + plane) * window[i];
+        }
+    }
+}
+
+// Buffers of the blocks of one block row
+typedef struct {
+    DECLARE_ALIGNED(32, float, *block);
+    double *block_d;
+    double *plane_d;
+    struct aom_noise_tx_t *tx_full;
+    struct aom_noise_tx_t *tx_chroma;
+} wiener_denoise_scratch_t;
+
+// One of the overlapped passes over a plane, processed by block rows. The
+// blocks of a pass don't overlap, so neither do the results of its rows.
+typedef struct {
+    const aom_flat_block_finder_t *block_finder;
+    const uint8_t *data;
+    int32_t w;
+    int32_t h;
+    int32_t stride;
+    int32_t block_size;
+    int32_t offsx;
+    int32_t offsy;
+    int32_t num_blocks_w;
+    int32_t use_chroma_tx;
+    const float *window_function;
+    const float *noise_psd;
+    float *result;
+    int32_t result_stride;
+    // The block rows take the scratches modulo scratch_count
+    wiener_denoise_scratch_t *scratch;
+    int32_t scratch_count;
+} wiener_denoise_pass_t;
+
+static void wiener_denoise_row(void *job, int32_t index) {
+    const wiener_denoise_pass_t *pass = (const wiener_denoise_pass_t *)job;
+    wiener_denoise_scratch_t *scratch = &pass->scratch[index % pass->scratch_count];
+    struct aom_noise_tx_t *tx =
+        pass->use_chroma_tx ? scratch->tx_chroma : scratch->tx_full;
+    const int32_t block_size = pass->block_size;
+    const int32_t pixels_per_block = block_size * block_size;
+    // Pad the boundary when processing each block-set.
+    const int32_t by = index - 1;
+
+    for (int32_t bx = -1; bx < pass->num_blocks_w; ++bx) {
+        aom_flat_block_finder_extract_block(
+            pass->block_finder, pass->data, pass->w, pass->h, pass->stride,
+            bx * block_size + pass->offsx, by * block_size + pass->offsy,
+            scratch->plane_d, scratch->block_d);
+        aom_noise_window_block(scratch->block_d, pass->window_function,
+            scratch->block, pixels_per_block);
+        aom_noise_tx_forward(tx, scratch->block);
+        aom_noise_tx_filter(tx, pass->noise_psd);
+        aom_noise_tx_inverse(tx, scratch->block);
+
+        aom_noise_accumulate_block(scratch->block, scratch->plane_d,
+            pass->window_function, block_size,
+            pass->result +
+            ((by + 1) * block_size + pass->offsy) * pass->result_stride +
+            (bx + 1) * block_size + pass->offsx,
+            pass->result_stride);
+    }
+}
+
 int32_t aom_wiener_denoise_2d(const uint8_t *const data[3], uint8_t *denoised[3],
     int32_t w, int32_t h, int32_t stride[3], int32_t chroma_sub[2],
     float *noise_psd[3], int32_t block_size, int32_t bit_depth,
-    int32_t use_highbd) {
-    float *plane = NULL, *window_full = NULL,
-        *window_chroma = NULL;
-    DECLARE_ALIGNED(32, float, *block);
-    block = NULL;
-    double *block_d = NULL, *plane_d = NULL;
-    struct aom_noise_tx_t *tx_full = NULL;
-    struct aom_noise_tx_t *tx_chroma = NULL;
+    int32_t use_highbd, aom_denoise_runner_t runner, void *runner_ctx) {
+    float *window_full = NULL, *window_chroma = NULL;
     const int32_t num_blocks_w = (w + block_size - 1) / block_size;
     const int32_t num_blocks_h = (h + block_size - 1) / block_size;
     const int32_t result_stride = (num_blocks_w + 2) * block_size;
     const int32_t result_height = (num_blocks_h + 2) * block_size;
+    // Each block row of a pass has its scratch when they are shared out
+    const int32_t scratch_count = runner ? num_blocks_h + 1 : 1;
+    wiener_denoise_scratch_t *scratch = NULL;
+    wiener_denoise_pass_t pass;
     float *result = NULL;
     int32_t init_success = 1;
     aom_flat_block_finder_t block_finder_full;
@@ -1390,84 +1575,69 @@ int32_t aom_wiener_denoise_2d(const uint8_t *const data[3], uint8_t *denoised[3]
         bit_depth, use_highbd);
     result = (float *)malloc((num_blocks_h + 2) * block_size * result_stride *
         sizeof(*result));
-    plane = (float *)malloc(block_size * block_size * sizeof(*plane));
-    block =
-        (float *)aom_memalign(32, 2 * block_size * block_size * sizeof(*block));
-    block_d = (double *)malloc(block_size * block_size * sizeof(*block_d));
-    plane_d = (double *)malloc(block_size * block_size * sizeof(*plane_d));
     window_full = get_half_cos_window(block_size);
-    tx_full = aom_noise_tx_malloc(block_size);
+    scratch = (wiener_denoise_scratch_t *)calloc(scratch_count, sizeof(*scratch));
+    init_success &= (int32_t)(scratch != NULL);
+    for (int32_t i = 0; init_success && i < scratch_count; ++i) {
+        scratch[i].block = (float *)aom_memalign(
+            32, 2 * block_size * block_size * sizeof(*scratch[i].block));
+        scratch[i].block_d =
+            (double *)malloc(block_size * block_size * sizeof(*scratch[i].block_d));
+        scratch[i].plane_d =
+            (double *)malloc(block_size * block_size * sizeof(*scratch[i].plane_d));
+        scratch[i].tx_full = aom_noise_tx_malloc(block_size);
+        scratch[i].tx_chroma = chroma_sub[0] != 0 ?
+            aom_noise_tx_malloc(block_size >> chroma_sub[0]) : scratch[i].tx_full;
+        init_success &= (int32_t)((scratch[i].block != NULL) &&
+            (scratch[i].block_d != NULL) && (scratch[i].plane_d != NULL) &&
+            (scratch[i].tx_full != NULL) && (scratch[i].tx_chroma != NULL));
+    }
 
     if (chroma_sub[0] != 0) {
         init_success &= aom_flat_block_finder_init(&block_finder_chroma,
             block_size >> chroma_sub[0],
             bit_depth, use_highbd);
         window_chroma = get_half_cos_window(block_size >> chroma_sub[0]);
-        tx_chroma = aom_noise_tx_malloc(block_size >> chroma_sub[0]);
     }
     else {
         window_chroma = window_full;
-        tx_chroma = tx_full;
     }
 
-    init_success &= (int32_t)((tx_full != NULL) && (tx_chroma != NULL) && (plane != NULL) &&
-        (plane_d != NULL) && (block != NULL) && (block_d != NULL) &&
-        (window_full != NULL) && (window_chroma != NULL) &&
+    init_success &= (int32_t)((window_full != NULL) && (window_chroma != NULL) &&
         (result != NULL));
     for (int32_t c = init_success ? 0 : 3; c < 3; ++c) {
         float *window_function = c == 0 ? window_full : window_chroma;
         aom_flat_block_finder_t *block_finder = &block_finder_full;
         const int32_t chroma_sub_h = c > 0 ? chroma_sub[1] : 0;
         const int32_t chroma_sub_w = c > 0 ? chroma_sub[0] : 0;
-        struct aom_noise_tx_t *tx =
-            (c > 0 && chroma_sub[0] > 0) ? tx_chroma : tx_full;
         if (!data[c] || !denoised[c]) continue;
         if (c > 0 && chroma_sub[0] != 0) {
             block_finder = &block_finder_chroma;
         }
         memset(result, 0, sizeof(*result) * result_stride * result_height);
-        // Do overlapped block processing (half overlapped). The block rows can
-        // easily be done in parallel
-        for (int32_t offsy = 0; offsy < (block_size >> chroma_sub_h);
-            offsy += (block_size >> chroma_sub_h) / 2) {
-            for (int32_t offsx = 0; offsx < (block_size >> chroma_sub_w);
-                offsx += (block_size >> chroma_sub_w) / 2) {
-                // Pad the boundary when processing each block-set.
-                for (int32_t by = -1; by < num_blocks_h; ++by) {
-                    for (int32_t bx = -1; bx < num_blocks_w; ++bx) {
-                        const int32_t pixels_per_block =
-                            (block_size >> chroma_sub_w) * (block_size >> chroma_sub_h);
-                        aom_flat_block_finder_extract_block(
-                            block_finder, data[c], w >> chroma_sub_w, h >> chroma_sub_h,
-                            stride[c], bx * (block_size >> chroma_sub_w) + offsx,
-                            by * (block_size >> chroma_sub_h) + offsy, plane_d, block_d);
-                        for (int32_t j = 0; j < pixels_per_block; ++j) {
-                            block[j] = (float)block_d[j];
-                            plane[j] = (float)plane_d[j];
-                        }
-                        pointwise_multiply(window_function, block, pixels_per_block);
-                        aom_noise_tx_forward(tx, block);
-                        aom_noise_tx_filter(tx, noise_psd[c]);
-                        aom_noise_tx_inverse(tx, block);
-
-                        // Apply window function to the plane approximation (we will apply
-                        // it to the sum of plane + block when composing the results).
-                        pointwise_multiply(window_function, plane, pixels_per_block);
-
-                        for (int32_t y = 0; y < (block_size >> chroma_sub_h); ++y) {
-                            const int32_t y_result =
-                                y + (by + 1) * (block_size >> chroma_sub_h) + offsy;
-                            for (int32_t x = 0; x < (block_size >> chroma_sub_w); ++x) {
-                                const int32_t x_result =
-                                    x + (bx + 1) * (block_size >> chroma_sub_w) + offsx;
-                                result[y_result * result_stride + x_result] +=
-                                    (block[y * (block_size >> chroma_sub_w) + x] +
-                                        plane[y * (block_size >> chroma_sub_w) + x]) *
-                                    window_function[y * (block_size >> chroma_sub_w) + x];
-                            }
-                        }
-                    }
-                }
+
+        pass.block_finder = block_finder;
+        pass.data = data[c];
+        pass.w = w >> chroma_sub_w;
+        pass.h = h >> chroma_sub_h;
+        pass.stride = stride[c];
+        pass.block_size = block_size >> chroma_sub_w;
+        pass.num_blocks_w = num_blocks_w;
+        pass.use_chroma_tx = c > 0 && chroma_sub[0] > 0;
+        pass.window_function = window_function;
+        pass.noise_psd = noise_psd[c];
+        pass.result = result;
+        pass.result_stride = result_stride;
+        pass.scratch = scratch;
+        pass.scratch_count = scratch_count;
+        // Do overlapped block processing (half overlapped). The block rows of a
+        // pass are done in parallel, the passes one after the other.
+        for (pass.offsy = 0; pass.offsy < (block_size >> chroma_sub_h);
+            pass.offsy += (block_size >> chroma_sub_h) / 2) {
+            for (pass.offsx = 0; pass.offsx < (block_size >> chroma_sub_w);
+                pass.offsx += (block_size >> chroma_sub_w) / 2) {
+                run_block_rows(runner, runner_ctx, wiener_denoise_row, &pass,
+                    num_blocks_h + 1);
             }
         }
         if (use_highbd) {
@@ -1482,19 +1652,21 @@ int32_t aom_wiener_denoise_2d(const uint8_t *const data[3], uint8_t *denoised[3]
         }
     }
     free(result);
-    free(plane);
-    aom_free(block);
-    free(plane_d);
-    free(block_d);
     free(window_full);
-
-    aom_noise_tx_free(tx_full);
+    for (int32_t i = 0; scratch && i < scratch_count; ++i) {
+        aom_free(scratch[i].block);
+        free(scratch[i].block_d);
+        free(scratch[i].plane_d);
+        if (scratch[i].tx_chroma != scratch[i].tx_full)
+            aom_noise_tx_free(scratch[i].tx_chroma);
+        aom_noise_tx_free(scratch[i].tx_full);
+    }
+    free(scratch);
 
     aom_flat_block_finder_free(&block_finder_full);
     if (chroma_sub[0] != 0) {
         aom_flat_block_finder_free(&block_finder_chroma);
         free(window_chroma);
-        aom_noise_tx_free(tx_chroma);
     }
     return init_success;
 }
@@ -1747,7 +1919,9 @@ int32_t aom_denoise_and_model_run(struct aom_denoise_and_model_t *ctx,
     EbPictureBufferDesc *sd,
     aom_film_grain_t *film_grain,
     int32_t use_highbd,
-    EbAsm asm_type) {
+    EbAsm asm_type,
+    aom_denoise_runner_t runner,
+    void *runner_ctx) {
 
     const int32_t block_size = ctx->block_size;
     uint8_t *raw_data[3];
@@ -1777,11 +1951,11 @@ int32_t aom_denoise_and_model_run(struct aom_denoise_and_model_t *ctx,
     const uint8_t *const data[3] = { raw_data[0], raw_data[1], raw_data[2] };
 
     aom_flat_block_finder_run(&ctx->flat_block_finder, data[0], sd->width,
-        sd->height, strides[0], ctx->flat_blocks);
+        sd->height, strides[0], ctx->flat_blocks, runner, runner_ctx);
 
     if (!aom_wiener_denoise_2d(data, ctx->denoised, sd->width, sd->height,
         strides, chroma_sub_log2, ctx->noise_psd,
-        block_size, ctx->bit_depth, use_highbd)) {
+        block_size, ctx->bit_depth, use_highbd, runner, runner_ctx)) {
         fprintf(stderr, "Unable to denoise image\n");
         return 0;
     }
@@ -1820,6 +1994,7 @@ int32_t aom_denoise_and_model_run(struct aom_denoise_and_model_t *ctx,
     aom_flat_block_finder_free(&ctx->flat_block_finder);
     aom_noise_model_free(&ctx->noise_model);
     free(ctx->flat_blocks);
+    ctx->flat_blocks = NULL;
 
     return 1;
 }
@@ -135,6 +135,15 @@ extern "C" {
         int32_t use_highbd;        // Whether input data should be interpreted as uint16
     } aom_flat_block_finder_t;
 
+    /*!\brief Runs process(job, index) for every index in [0, count) and
+     * returns once they are all done. The indices are independent of each other
+     * and may be processed in any order, on several threads. The functions
+     * taking a runner process the indices in order on the calling thread when
+     * it is NULL.
+     */
+    typedef void(*aom_denoise_runner_t)(void *runner_ctx,
+        void(*process)(void *job, int32_t index), void *job, int32_t count);
+
     /*!\brief Init the block_finder with the given block size, bit_depth */
     int32_t aom_flat_block_finder_init(aom_flat_block_finder_t *block_finder,
         int32_t block_size, int32_t bit_depth, int32_t use_highbd);
@@ -151,11 +160,12 @@ extern "C" {
      * Find flat blocks in the input image data. Returns a map of
      * flat_blocks, where the value of flat_blocks map will be non-zero
      * when a block is determined to be flat. A higher value indicates a bigger
-     * confidence in the decision.
+     * confidence in the decision. The block rows are shared out by runner.
      */
     int32_t aom_flat_block_finder_run(const aom_flat_block_finder_t *block_finder,
         const uint8_t *const data, int32_t w, int32_t h,
-        int32_t stride, uint8_t *flat_blocks);
+        int32_t stride, uint8_t *flat_blocks, aom_denoise_runner_t runner,
+        void *runner_ctx);
 
     // The noise shape indicates the allowed coefficients in the AR model.
     typedef enum {
@@ -298,11 +308,14 @@ extern "C" {
      * \param[in]     use_highbd      If true, uint8 pointers are interpreted as
      *                                uint16 and stride is measured in uint16.
      *                                This must be true when bit_depth >= 10.
+     * \param[in]     runner          Shares out the block rows of each of the
+     *                                overlapped passes, NULL to run them here
+     * \param[in]     runner_ctx      Context of runner
      */
     int32_t aom_wiener_denoise_2d(const uint8_t *const data[3], uint8_t *denoised[3],
         int32_t w, int32_t h, int32_t stride[3], int32_t chroma_sub_log2[2],
         float *noise_psd[3], int32_t block_size, int32_t bit_depth,
-        int32_t use_highbd);
+        int32_t use_highbd, aom_denoise_runner_t runner, void *runner_ctx);
 
     struct aom_denoise_and_model_t;
 
@@ -319,12 +332,16 @@ extern "C" {
      *                       noise estimate.
      * \param[in/out]   buf  The raw input buffer to be denoised.
      * \param[out]    grain  Output film grain parameters
+     * \param[in]     runner Shares out the block rows of the flat block search
+     *                       and of the denoising, NULL to run them here
      */
     int32_t aom_denoise_and_model_run(struct aom_denoise_and_model_t *ctx,
         EbPictureBufferDesc *sd,
         aom_film_grain_t *film_grain,
         int32_t use_highbd,
-        EbAsm asm_type);
+        EbAsm asm_type,
+        aom_denoise_runner_t runner,
+        void *runner_ctx);
 
     /*!\brief Allocates a context that can be used for denoising and noise modeling.
      *
@@ -90,27 +90,28 @@ void aom_noise_tx_forward(struct aom_noise_tx_t *noise_tx, const float *data) {
     noise_tx->fft(data, noise_tx->temp, noise_tx->tx_block);
 }
 
-void aom_noise_tx_filter(struct aom_noise_tx_t *noise_tx, const float *psd) {
-    const int32_t block_size = noise_tx->block_size;
+void aom_noise_tx_filter_block_c(float *tx_block, const float *psd, int32_t n) {
     const float kBeta = 1.1f;
     const float kEps = 1e-6f;
-    for (int32_t y = 0; y < block_size; ++y) {
-        for (int32_t x = 0; x < block_size; ++x) {
-            int32_t i = y * block_size + x;
-            float *c = noise_tx->tx_block + 2 * i;
-            const float p = c[0] * c[0] + c[1] * c[1];
-            if (p > kBeta * psd[i] && p > 1e-6) {
-                noise_tx->tx_block[2 * i + 0] *= (p - psd[i]) / AOMMAX(p, kEps);
-                noise_tx->tx_block[2 * i + 1] *= (p - psd[i]) / AOMMAX(p, kEps);
-            }
-            else {
-                noise_tx->tx_block[2 * i + 0] *= (kBeta - 1.0f) / kBeta;
-                noise_tx->tx_block[2 * i + 1] *= (kBeta - 1.0f) / kBeta;
-            }
+    for (int32_t i = 0; i < n; ++i) {
+        float *c = tx_block + 2 * i;
+        const float p = c[0] * c[0] + c[1] * c[1];
+        if (p > kBeta * psd[i] && p > 1e-6) {
+            tx_block[2 * i + 0] *= (p - psd[i]) / AOMMAX(p, kEps);
+            tx_block[2 * i + 1] *= (p - psd[i]) / AOMMAX(p, kEps);
+        }
+        else {
+            tx_block[2 * i + 0] *= (kBeta - 1.0f) / kBeta;
+            tx_block[2 * i + 1] *= (kBeta - 1.0f) / kBeta;
         }
     }
 }
 
+void aom_noise_tx_filter(struct aom_noise_tx_t *noise_tx, const float *psd) {
+    aom_noise_tx_filter_block(noise_tx->tx_block, psd,
+        noise_tx->block_size * noise_tx->block_size);
+}
+
 void aom_noise_tx_inverse(struct aom_noise_tx_t *noise_tx, float *data) {
     const int32_t n = noise_tx->block_size * noise_tx->block_size;
     noise_tx->ifft(noise_tx->tx_block, noise_tx->temp, data);
@@ -98,6 +98,8 @@
 #include "EbDlfProcess.h"
 #include "EbCdefProcess.h"
 #include "EbRestProcess.h"
+#include "EbKernelDispatch.h"
+#include "EbPassStats.h"
 
 
 #ifdef _WIN32
@@ -111,10 +113,6 @@
 #include <errno.h>
 #endif
 
-
-#define RTCD_C
-#include "aom_dsp_rtcd.h"
-
  /**************************************
   * Defines
   **************************************/
@@ -138,6 +136,7 @@
 #define EB_OUTPUTSTATISTICSBUFFERSIZE                                   0x30            // 6X8 (8 Bytes for Y, U, V, number of bits, picture number, QP)
 #define EOS_NAL_BUFFER_SIZE                                             0x0010 // Bitstream used to code EOS NAL
 #define EB_OUTPUTSTREAMBUFFERSIZE_MACRO(ResolutionSize)                ((ResolutionSize) < (INPUT_SIZE_1080i_TH) ? 0x1E8480 : (ResolutionSize) < (INPUT_SIZE_1080p_TH) ? 0x2DC6C0 : (ResolutionSize) < (INPUT_SIZE_4K_TH) ? 0x2DC6C0 : 0x2DC6C0  )
+#define EB_TILE_GROUP_OUTPUT_BUFFER_COUNT                               8      // Max extra output buffers for tile group output
 
 #define ENCDEC_INPUT_PORT_MDC                                0
 #define ENCDEC_INPUT_PORT_ENCDEC                             1
@@ -152,11 +151,13 @@
 EbMemoryMapEntry                 *memory_map;
 uint32_t                         *memory_map_index;
 uint64_t                         *total_lib_memory;
+EbNumaPlacement                  *numa_placement;
 
 uint32_t                         lib_malloc_count = 0;
 uint32_t                         lib_thread_count = 0;
 uint32_t                         lib_semaphore_count = 0;
 uint32_t                         lib_mutex_count = 0;
+uint32_t                         memory_map_category = EB_MEMORY_OTHER;
 
 uint8_t                          num_groups = 0;
 #ifdef _WIN32
@@ -396,23 +397,172 @@ void EbSetThreadManagementParameters(EbSvtAv1EncConfiguration   *config_ptr) {
     }
 #endif
 }
-void asmSetConvolveAsmTable(void);
-void asmSetConvolveHbdAsmTable(void);
-void init_intra_dc_predictors_c_internal(void);
-void init_intra_predictors_internal(void);
-void av1_init_me_luts(void);
 
-void SwitchToRealTime(){
-#if defined(__linux__) || defined(__APPLE__)
+/*****************************************
+ * EbSetNumaMemoryPolicy
+ *   Sets the NUMA placement of the large
+ *   buffers of the instance, before they
+ *   are allocated.
+ *****************************************/
+static void EbSetNumaMemoryPolicy(EbEncHandle *enc_handle_ptr, EbSvtAv1EncConfiguration *config_ptr) {
+    uint64_t node_mask = 0;
+#if defined(__linux__)
+    if (config_ptr->numa_memory_policy == EB_NUMA_POLICY_BIND && config_ptr->target_socket != -1)
+        node_mask = eb_numa_get_cpu_node_mask(lp_group[config_ptr->target_socket].group, lp_group[config_ptr->target_socket].num);
+    else if (config_ptr->numa_memory_policy == EB_NUMA_POLICY_INTERLEAVE) {
+        for (uint32_t socket_id = 0; socket_id < num_groups; ++socket_id)
+            node_mask |= eb_numa_get_cpu_node_mask(lp_group[socket_id].group, lp_group[socket_id].num);
+        // Interleaving over a single node is the default placement
+        if ((node_mask & (node_mask - 1)) == 0)
+            node_mask = 0;
+    }
+    if (config_ptr->numa_memory_policy != EB_NUMA_POLICY_DEFAULT && node_mask == 0)
+        SVT_LOG("SVT [WARNING]: NUMA memory policy %u has no effect on this system. \n", config_ptr->numa_memory_policy);
+#else
+    if (config_ptr->numa_memory_policy != EB_NUMA_POLICY_DEFAULT)
+        SVT_LOG("SVT [WARNING]: NUMA memory policy is only supported on Linux. \n");
+#endif
+    eb_numa_placement_init(&enc_handle_ptr->numa_placement, (EbNumaMemoryPolicy)config_ptr->numa_memory_policy, node_mask);
+}
+
+/*****************************************
+ * set_stage_thread_priority
+ *   Sets the scheduling requested for the
+ *   threads of a stage
+ *****************************************/
+static void set_stage_thread_priority(
+    EbEncHandle               *enc_handle_ptr,
+    EbSvtAv1EncConfiguration  *config_ptr,
+    EbPipelineStage            stage)
+{
+    EbStageThreadPriority *stage_priority_ptr = &enc_handle_ptr->stage_thread_priority[stage];
+    int32_t priority = config_ptr->thread_priority;
+
+    stage_priority_ptr->requested.policy = (EbThreadPolicy)config_ptr->thread_policy;
+    if (config_ptr->thread_policy == EB_THREAD_POLICY_NICE) {
+        priority -= config_ptr->stage_priority_boost[stage];
+        priority = CLIP3(-20, 19, priority);
+    }
+    else if (config_ptr->thread_policy == EB_THREAD_POLICY_REALTIME) {
+        priority += config_ptr->stage_priority_boost[stage];
+        priority = CLIP3(1, 99, priority);
+    }
+    else
+        priority = 0;
+    stage_priority_ptr->requested.priority = priority;
+}
+
+/*****************************************
+ * kernel_thread_priority
+ *   Where the next kernel thread of a
+ *   stage records the scheduling it could
+ *   apply
+ *****************************************/
+static EbThreadPriority *kernel_thread_priority(
+    EbEncHandle     *enc_handle_ptr,
+    EbPipelineStage  stage)
+{
+    EbKernelThreadPriority *thread_priority_ptr = &enc_handle_ptr->kernel_thread_priority_array[enc_handle_ptr->kernel_thread_count++];
+
+    thread_priority_ptr->stage = stage;
+    thread_priority_ptr->applied.policy = EB_THREAD_POLICY_NORMAL;
+    thread_priority_ptr->applied.priority = 0;
+    return &thread_priority_ptr->applied;
+}
+
+/*****************************************
+ * report_thread_priority
+ *   The applied scheduling of a stage is
+ *   the requested one, or the one of its
+ *   first thread that fell short of it
+ *****************************************/
+static void report_thread_priority(EbEncHandle *enc_handle_ptr) {
+    static const char *policy_name[] = { "normal", "nice", "real-time" };
+    for (uint32_t stage = 0; stage < EB_PIPELINE_STAGE_COUNT; ++stage) {
+        EbStageThreadPriority *stage_priority_ptr = &enc_handle_ptr->stage_thread_priority[stage];
+        uint32_t thread_count = 0;
+        uint32_t short_count = 0;
+
+        stage_priority_ptr->applied = stage_priority_ptr->requested;
+        for (uint32_t thread_index = 0; thread_index < enc_handle_ptr->kernel_thread_count; ++thread_index) {
+            const EbKernelThreadPriority *thread_priority_ptr = &enc_handle_ptr->kernel_thread_priority_array[thread_index];
+            if (thread_priority_ptr->stage != (EbPipelineStage)stage)
+                continue;
+            ++thread_count;
+            if (thread_priority_ptr->applied.policy != stage_priority_ptr->requested.policy ||
+                thread_priority_ptr->applied.priority != stage_priority_ptr->requested.priority) {
+                if (short_count++ == 0)
+                    stage_priority_ptr->applied = thread_priority_ptr->applied;
+            }
+        }
 
-    struct sched_param schedParam = {
-        .sched_priority = 99
-    };
+        if (stage_priority_ptr->requested.policy != EB_THREAD_POLICY_NORMAL && short_count)
+            SVT_LOG("SVT [WARNING]: %u of %u %s threads: requested %s priority %d, applied %s priority %d\n",
+                short_count, thread_count,
+                eb_pipeline_stage_name((EbPipelineStage)stage),
+                policy_name[stage_priority_ptr->requested.policy], stage_priority_ptr->requested.priority,
+                policy_name[stage_priority_ptr->applied.policy], stage_priority_ptr->applied.priority);
+    }
+}
 
-    int32_t retValue = pthread_setschedparam(pthread_self(), SCHED_FIFO, &schedParam);
-    UNUSED(retValue);
+/*****************************************
+ * Per-SB and per-block array sizes: the
+ * configured picture and SB size in the
+ * low memory mode, the largest supported
+ * otherwise
+ *****************************************/
+static uint32_t get_sb_total_count(SequenceControlSet *sequence_control_set_ptr) {
+    if (!sequence_control_set_ptr->static_config.low_memory)
+        return MAX_NUMBER_OF_TREEBLOCKS_PER_PICTURE;
+    return ((sequence_control_set_ptr->max_input_luma_width + BLOCK_SIZE_64 - 1) / BLOCK_SIZE_64) *
+        ((sequence_control_set_ptr->max_input_luma_height + BLOCK_SIZE_64 - 1) / BLOCK_SIZE_64);
+}
+
+static uint32_t get_max_block_count(SequenceControlSet *sequence_control_set_ptr) {
+    if (!sequence_control_set_ptr->static_config.low_memory || sequence_control_set_ptr->static_config.super_block_size == 128)
+        return BLOCK_MAX_COUNT_SB_128;
+    return BLOCK_MAX_COUNT_SB_64;
+}
+
+/*****************************************
+ * collect_memory_usage
+ *   Sums the allocations of the instance
+ *   by category, walking the memory map
+ *   back to the handle's first entry.
+ *****************************************/
+static void collect_memory_usage(EbEncHandle *enc_handle_ptr) {
+    EbMemoryUsage    *memory_usage_ptr = &enc_handle_ptr->memory_usage;
+
+    EB_MEMSET(memory_usage_ptr, 0, sizeof(EbMemoryUsage));
+#if MEM_MAP_OPT
+    EbMemoryMapEntry *memory_entry = memory_map;
+    while (memory_entry && memory_entry != enc_handle_ptr->memory_map_init_address) {
+        uint32_t category = memory_entry->category < EB_MEMORY_CATEGORY_COUNT ? memory_entry->category : EB_MEMORY_OTHER;
+        memory_usage_ptr->category_bytes[category] += memory_entry->alloc_size;
+        memory_usage_ptr->category_allocation_count[category]++;
+        memory_usage_ptr->total_bytes += memory_entry->alloc_size;
+        memory_entry = (EbMemoryMapEntry*)memory_entry->prev_entry;
+    }
+#else
+    memory_usage_ptr->total_bytes = enc_handle_ptr->total_lib_memory;
+    memory_usage_ptr->category_bytes[EB_MEMORY_OTHER] = enc_handle_ptr->total_lib_memory;
 #endif
 }
+
+static void report_memory_usage(EbEncHandle *enc_handle_ptr) {
+    static const char *category_name[EB_MEMORY_CATEGORY_COUNT] = {
+        "SequenceControlSet", "PictureParentControlSet", "PictureControlSet",
+        "ReferencePictures", "PaReferencePictures", "InputOutputBuffers",
+        "PipelineQueues", "KernelContexts", "Other" };
+    EbMemoryUsage *memory_usage_ptr = &enc_handle_ptr->memory_usage;
+
+    SVT_LOG("SVT [memory]: %-24s: %.2f MB\n", "Total", memory_usage_ptr->total_bytes / (1024.0 * 1024.0));
+    for (uint32_t category = 0; category < EB_MEMORY_CATEGORY_COUNT; ++category)
+        SVT_LOG("SVT [memory]: %-24s: %.2f MB in %u allocations\n", category_name[category],
+            memory_usage_ptr->category_bytes[category] / (1024.0 * 1024.0),
+            memory_usage_ptr->category_allocation_count[category]);
+}
+
 #define SINGLE_CORE_COUNT       1
 #define CONS_CORE_COUNT         16
 #define LOW_SERVER_CORE_COUNT   48
@@ -486,24 +636,59 @@ int32_t set_parent_pcs(EbSvtAv1EncConfiguration*   config, uint32_t core_count,
         return -1;
     }
 }
+/*********************************************************************************
+* Unified thread pool: the thread counts of the multi-threaded stages are
+* taken from a single budget of core_count threads, split with fixed weights
+* of the typical workload of each stage, instead of every stage being sized
+* independently from the core count (which spawns several hundred
+* mostly-blocked threads on many-core systems). The split is static: each
+* stage keeps its own threads, an idle stage does not lend them to a busy
+* one. Every stage keeps at least one thread so the pipeline can always
+* progress.
+*********************************************************************************/
+#define UNIFIED_POOL_STAGE_COUNT 9
+static void set_unified_thread_pool_process_count(
+    SequenceControlSet       *sequence_control_set_ptr,
+    uint32_t                  core_count)
+{
+    // PA, ME, SBO, MDC, EncDec, EC, DLF, CDEF, REST
+    static const uint32_t stage_weight[UNIFIED_POOL_STAGE_COUNT] = { 2, 4, 1, 1, 12, 1, 2, 4, 3 };
+    uint32_t *process_count[UNIFIED_POOL_STAGE_COUNT] = {
+        &sequence_control_set_ptr->picture_analysis_process_init_count,
+        &sequence_control_set_ptr->motion_estimation_process_init_count,
+        &sequence_control_set_ptr->source_based_operations_process_init_count,
+        &sequence_control_set_ptr->mode_decision_configuration_process_init_count,
+        &sequence_control_set_ptr->enc_dec_process_init_count,
+        &sequence_control_set_ptr->entropy_coding_process_init_count,
+        &sequence_control_set_ptr->dlf_process_init_count,
+        &sequence_control_set_ptr->cdef_process_init_count,
+        &sequence_control_set_ptr->rest_process_init_count };
+    uint32_t weight_sum = 0;
+    uint32_t assigned = 0;
+    uint32_t stage_index;
+
+    for (stage_index = 0; stage_index < UNIFIED_POOL_STAGE_COUNT; ++stage_index)
+        weight_sum += stage_weight[stage_index];
+
+    for (stage_index = 0; stage_index < UNIFIED_POOL_STAGE_COUNT; ++stage_index) {
+        *process_count[stage_index] = MAX(core_count * stage_weight[stage_index] / weight_sum, 1);
+        assigned += *process_count[stage_index];
+    }
+
+    // Rounding leftovers go to EncDec, the dominant stage
+    if (assigned < core_count) {
+        sequence_control_set_ptr->enc_dec_process_init_count += core_count - assigned;
+        assigned = core_count;
+    }
+
+    sequence_control_set_ptr->total_process_init_count += assigned;
+}
+
 EbErrorType load_default_buffer_configuration_settings(
     SequenceControlSet       *sequence_control_set_ptr){
 
     EbErrorType           return_error = EB_ErrorNone;
-    uint32_t encDecSegH = (sequence_control_set_ptr->static_config.super_block_size == 128) ?
-        ((sequence_control_set_ptr->max_input_luma_height + 64) / 128) :
-        ((sequence_control_set_ptr->max_input_luma_height + 32) / 64);
-    uint32_t encDecSegW = (sequence_control_set_ptr->static_config.super_block_size == 128) ?
-        ((sequence_control_set_ptr->max_input_luma_width + 64) / 128) :
-        ((sequence_control_set_ptr->max_input_luma_width + 32) / 64);
-
-#if CABAC_SERIAL
-    encDecSegH = 1;
-    encDecSegW = 1;
-#endif
-
-    uint32_t meSegH     = (((sequence_control_set_ptr->max_input_luma_height + 32) / BLOCK_SIZE_64) < 6) ? 1 : 6;
-    uint32_t meSegW     = (((sequence_control_set_ptr->max_input_luma_width + 32) / BLOCK_SIZE_64) < 10) ? 1 : 10;
+    uint32_t encDecSegH;
 
     unsigned int lp_count   = GetNumProcessors();
     unsigned int core_count = lp_count;
@@ -531,6 +716,9 @@ EbErrorType load_default_buffer_configuration_settings(
 #if CHECK_MEM_REDUCTION
     core_count = 4;
 #endif
+    // Attached to a host context, the encoder only runs on its share of the workers
+    if (sequence_control_set_ptr->host_thread_budget)
+        core_count = sequence_control_set_ptr->host_thread_budget;
     int32_t return_ppcs = set_parent_pcs(&sequence_control_set_ptr->static_config, 
                     core_count, sequence_control_set_ptr->input_resolution);
     if (return_ppcs == -1)
@@ -544,47 +732,23 @@ EbErrorType load_default_buffer_configuration_settings(
 #endif
     sequence_control_set_ptr->output_stream_buffer_fifo_init_count =
         sequence_control_set_ptr->input_buffer_fifo_init_count + 4;
+    // Tile groups of the picture at the head of the decode order, the tiles
+    // wait for the next packet when these are all in use
+    if (sequence_control_set_ptr->static_config.tile_group_output)
+        sequence_control_set_ptr->output_stream_buffer_fifo_init_count += MIN(
+            (1 << (sequence_control_set_ptr->static_config.tile_rows + sequence_control_set_ptr->static_config.tile_columns)) - 1,
+            EB_TILE_GROUP_OUTPUT_BUFFER_COUNT);
+
+    // Segments, the pictures of a smaller resolution set by eb_svt_enc_reconfigure()
+    // get fewer
+    derive_segment_counts(
+        sequence_control_set_ptr,
+        sequence_control_set_ptr->max_input_luma_width,
+        sequence_control_set_ptr->max_input_luma_height);
+    encDecSegH = sequence_control_set_ptr->enc_dec_segment_row_count_array[0];
 
-    // ME segments
-    sequence_control_set_ptr->me_segment_row_count_array[0] = meSegH;
-    sequence_control_set_ptr->me_segment_row_count_array[1] = meSegH;
-    sequence_control_set_ptr->me_segment_row_count_array[2] = meSegH;
-    sequence_control_set_ptr->me_segment_row_count_array[3] = meSegH;
-    sequence_control_set_ptr->me_segment_row_count_array[4] = meSegH;
-    sequence_control_set_ptr->me_segment_row_count_array[5] = meSegH;
-
-    sequence_control_set_ptr->me_segment_column_count_array[0] = meSegW;
-    sequence_control_set_ptr->me_segment_column_count_array[1] = meSegW;
-    sequence_control_set_ptr->me_segment_column_count_array[2] = meSegW;
-    sequence_control_set_ptr->me_segment_column_count_array[3] = meSegW;
-    sequence_control_set_ptr->me_segment_column_count_array[4] = meSegW;
-    sequence_control_set_ptr->me_segment_column_count_array[5] = meSegW;
-
-    // EncDec segments
-    sequence_control_set_ptr->enc_dec_segment_row_count_array[0] = encDecSegH;
-    sequence_control_set_ptr->enc_dec_segment_row_count_array[1] = encDecSegH;
-    sequence_control_set_ptr->enc_dec_segment_row_count_array[2] = encDecSegH;
-    sequence_control_set_ptr->enc_dec_segment_row_count_array[3] = encDecSegH;
-    sequence_control_set_ptr->enc_dec_segment_row_count_array[4] = encDecSegH;
-    sequence_control_set_ptr->enc_dec_segment_row_count_array[5] = encDecSegH;
-
-    sequence_control_set_ptr->enc_dec_segment_col_count_array[0] = encDecSegW;
-    sequence_control_set_ptr->enc_dec_segment_col_count_array[1] = encDecSegW;
-    sequence_control_set_ptr->enc_dec_segment_col_count_array[2] = encDecSegW;
-    sequence_control_set_ptr->enc_dec_segment_col_count_array[3] = encDecSegW;
-    sequence_control_set_ptr->enc_dec_segment_col_count_array[4] = encDecSegW;
-    sequence_control_set_ptr->enc_dec_segment_col_count_array[5] = encDecSegW;
-
-    sequence_control_set_ptr->cdef_segment_column_count = meSegW;
-    sequence_control_set_ptr->cdef_segment_row_count    = meSegH;
-
-    //since restoration unit size is same for Luma and Chroma, Luma segments and chroma segments do not correspond to the same area!
-    //to keep proper processing, segments have to be configured based on chroma resolution.
-    uint32_t unit_size                                  = 256;
-    uint32_t rest_seg_w                                 = MAX((sequence_control_set_ptr->max_input_luma_width /2 + (unit_size >> 1)) / unit_size, 1);
-    uint32_t rest_seg_h                                 = MAX((sequence_control_set_ptr->max_input_luma_height/2 + (unit_size >> 1)) / unit_size, 1);
-    sequence_control_set_ptr->rest_segment_column_count = MIN(rest_seg_w,6);
-    sequence_control_set_ptr->rest_segment_row_count    = MIN(rest_seg_h,4);
+    // DLF segments are SB rows of the picture, see dlf_run_segments()
+    sequence_control_set_ptr->dlf_segment_row_count = MAX(MIN(encDecSegH, 8), 1);
 
     //#====================== Data Structures and Picture Buffers ======================
 #if BUG_FIX_LOOKAHEAD
@@ -618,41 +782,58 @@ EbErrorType load_default_buffer_configuration_settings(
     sequence_control_set_ptr->rest_fifo_init_count                        = 300;
     //#====================== Processes number ======================
     sequence_control_set_ptr->total_process_init_count                    = 0;
+    if (sequence_control_set_ptr->static_config.unified_thread_pool || sequence_control_set_ptr->host_thread_budget) {
+        set_unified_thread_pool_process_count(sequence_control_set_ptr, core_count);
+    } else {
 #if NEW_BUFF_CFG
-    if (core_count > 1){
-        sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->picture_analysis_process_init_count            = MAX(MIN(15, core_count >> 1), core_count / 6));
-        sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->motion_estimation_process_init_count           = MAX(MIN(20, core_count >> 1), core_count / 3));
-        sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->source_based_operations_process_init_count     = MAX(MIN(3, core_count >> 1), core_count / 12));
-        sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->mode_decision_configuration_process_init_count = MAX(MIN(3, core_count >> 1), core_count / 12));
-        sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->enc_dec_process_init_count                     = MAX(MIN(40, core_count >> 1), core_count));
-        sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->entropy_coding_process_init_count              = MAX(MIN(3, core_count >> 1), core_count / 12));
-        sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->dlf_process_init_count                         = MAX(MIN(40, core_count >> 1), core_count));
-        sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->cdef_process_init_count                        = MAX(MIN(40, core_count >> 1), core_count));
-        sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->rest_process_init_count                        = MAX(MIN(40, core_count >> 1), core_count));
-    }else{
-        sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->picture_analysis_process_init_count            = 1);
-        sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->motion_estimation_process_init_count           = 1);
-        sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->source_based_operations_process_init_count     = 1);
-        sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->mode_decision_configuration_process_init_count = 1);
-        sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->enc_dec_process_init_count                     = 1);
-        sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->entropy_coding_process_init_count              = 1);
-        sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->dlf_process_init_count                         = 1);
-        sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->cdef_process_init_count                        = 1);
-        sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->rest_process_init_count                        = 1);
-    }
+        if (core_count > 1) {
+            sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->picture_analysis_process_init_count            = MAX(MIN(15, core_count >> 1), core_count / 6));
+            sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->motion_estimation_process_init_count           = MAX(MIN(20, core_count >> 1), core_count / 3));
+            sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->source_based_operations_process_init_count     = MAX(MIN(3, core_count >> 1), core_count / 12));
+            sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->mode_decision_configuration_process_init_count = MAX(MIN(3, core_count >> 1), core_count / 12));
+            sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->enc_dec_process_init_count                     = MAX(MIN(40, core_count >> 1), core_count));
+            sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->entropy_coding_process_init_count              = MAX(MIN(3, core_count >> 1), core_count / 12));
+            sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->dlf_process_init_count                         = MAX(MIN(40, core_count >> 1), core_count));
+            sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->cdef_process_init_count                        = MAX(MIN(40, core_count >> 1), core_count));
+            sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->rest_process_init_count                        = MAX(MIN(40, core_count >> 1), core_count));
+        } else {
+            sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->picture_analysis_process_init_count            = 1);
+            sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->motion_estimation_process_init_count           = 1);
+            sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->source_based_operations_process_init_count     = 1);
+            sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->mode_decision_configuration_process_init_count = 1);
+            sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->enc_dec_process_init_count                     = 1);
+            sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->entropy_coding_process_init_count              = 1);
+            sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->dlf_process_init_count                         = 1);
+            sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->cdef_process_init_count                        = 1);
+            sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->rest_process_init_count                        = 1);
+        }
 #else
-    sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->picture_analysis_process_init_count = MAX(MIN(15, core_count), core_count / 6));
-    sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->motion_estimation_process_init_count = MAX(MIN(20, core_count), core_count / 3));
-    sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->source_based_operations_process_init_count = MAX(MIN(3, core_count), core_count / 12));
-    sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->mode_decision_configuration_process_init_count = MAX(MIN(3, core_count), core_count / 12));
-    sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->enc_dec_process_init_count = MAX(MIN(40, core_count), core_count));
-    sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->entropy_coding_process_init_count = MAX(MIN(3, core_count), core_count / 12));
-    sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->dlf_process_init_count = MAX(MIN(40, core_count), core_count));
-    sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->cdef_process_init_count = MAX(MIN(40, core_count), core_count));
-    sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->rest_process_init_count = MAX(MIN(40, core_count), core_count));
+        sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->picture_analysis_process_init_count = MAX(MIN(15, core_count), core_count / 6));
+        sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->motion_estimation_process_init_count = MAX(MIN(20, core_count), core_count / 3));
+        sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->source_based_operations_process_init_count = MAX(MIN(3, core_count), core_count / 12));
+        sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->mode_decision_configuration_process_init_count = MAX(MIN(3, core_count), core_count / 12));
+        sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->enc_dec_process_init_count = MAX(MIN(40, core_count), core_count));
+        sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->entropy_coding_process_init_count = MAX(MIN(3, core_count), core_count / 12));
+        sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->dlf_process_init_count = MAX(MIN(40, core_count), core_count));
+        sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->cdef_process_init_count = MAX(MIN(40, core_count), core_count));
+        sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->rest_process_init_count = MAX(MIN(40, core_count), core_count));
 #endif
+    }
 
     sequence_control_set_ptr->total_process_init_count += 6; // single processes count
+
+    // In the low memory mode, queues carrying one task per picture are sized for the
+    // pictures in flight. EncDec tasks add one row feedback task per segment row,
+    // Picture Analysis tasks the helpers each thread may have queued.
+    if (sequence_control_set_ptr->static_config.low_memory) {
+        sequence_control_set_ptr->resource_coordination_fifo_init_count = MIN(sequence_control_set_ptr->resource_coordination_fifo_init_count,
+            sequence_control_set_ptr->picture_control_set_pool_init_count + sequence_control_set_ptr->picture_analysis_process_init_count *
+            (MIN(sequence_control_set_ptr->picture_analysis_process_init_count, sequence_control_set_ptr->pa_segment_row_count) - 1));
+        sequence_control_set_ptr->picture_analysis_fifo_init_count = MIN(sequence_control_set_ptr->picture_analysis_fifo_init_count,
+            sequence_control_set_ptr->picture_control_set_pool_init_count);
+        sequence_control_set_ptr->mode_decision_configuration_fifo_init_count = MIN(sequence_control_set_ptr->mode_decision_configuration_fifo_init_count,
+            sequence_control_set_ptr->picture_control_set_pool_init_count_child * (encDecSegH + 1) + sequence_control_set_ptr->enc_dec_process_init_count);
+    }
     printf("Number of logical cores available: %u\nNumber of PPCS %u\n", core_count, sequence_control_set_ptr->picture_control_set_pool_init_count);
 
     return return_error;
@@ -768,6 +949,8 @@ static EbErrorType eb_enc_handle_ctor(
     total_lib_memory                        = &enc_handle_ptr->total_lib_memory;
     memory_map                              = enc_handle_ptr->memory_map;
     memory_map_index                        = &enc_handle_ptr->memory_map_index;
+    eb_numa_placement_init(&enc_handle_ptr->numa_placement, EB_NUMA_POLICY_DEFAULT, 0);
+    numa_placement                          = &enc_handle_ptr->numa_placement;
     lib_malloc_count                        = 0;
     lib_thread_count                        = 0;
     lib_mutex_count                         = 0;
@@ -900,7 +1083,23 @@ static EbErrorType eb_enc_handle_ctor(
     }
 #endif
 
+    enc_handle_ptr->pipeline_stats_ptr = (EbPipelineStats*)EB_NULL;
+    EB_MEMSET(enc_handle_ptr->stage_thread_priority, 0, sizeof(enc_handle_ptr->stage_thread_priority));
+    enc_handle_ptr->kernel_thread_priority_array = (EbKernelThreadPriority*)EB_NULL;
+    enc_handle_ptr->kernel_thread_count = 0;
+    EB_MEMSET(&enc_handle_ptr->memory_usage, 0, sizeof(enc_handle_ptr->memory_usage));
+
+    // Zero-copy input is off until the application installs a release callback
+    enc_handle_ptr->release_input_buffer = (eb_release_input_buffer)EB_NULL;
+    enc_handle_ptr->input_buffer_priv_data = EB_NULL;
+
+    enc_handle_ptr->host_channel_ptr = (EbHostChannel*)EB_NULL;
+    enc_handle_ptr->ladder_ptr = (EbLadderContext*)EB_NULL;
+    enc_handle_ptr->ladder_rendition_ptr = (EbLadderRendition*)EB_NULL;
+    enc_handle_ptr->kernel_dispatch_attached = EB_FALSE;
+
     // Initialize Sequence Control Set Instance Array
+    memory_map_category = EB_MEMORY_SEQUENCE_CONTROL_SET;
     EB_MALLOC(EbSequenceControlSetInstance**, enc_handle_ptr->sequence_control_set_instance_array, sizeof(EbSequenceControlSetInstance*) * enc_handle_ptr->encode_instance_total_count, EB_N_PTR);
 #if MEM_MAP_OPT
     return_error = eb_sequence_control_set_instance_ctor(&enc_handle_ptr->sequence_control_set_instance_array[0]);
@@ -914,6 +1113,7 @@ static EbErrorType eb_enc_handle_ctor(
         }
     }
 #endif
+    memory_map_category = EB_MEMORY_OTHER;
     return EB_ErrorNone;
 }
 
@@ -921,6 +1121,10 @@ EbErrorType EbInputBufferHeaderCtor(
     EbPtr *objectDblPtr,
     EbPtr  objectInitDataPtr);
 
+static void ReleaseZeroCopyInputBuffer(
+    EbPtr object_ptr,
+    EbPtr callback_data);
+
 EbErrorType EbOutputReconBufferHeaderCtor(
     EbPtr *objectDblPtr,
     EbPtr  objectInitDataPtr);
@@ -972,7 +1176,101 @@ EbErrorType RestResultsCtor(
     return EB_ErrorNone;
 }
 
-void init_fn_ptr(void);
+/**********************************
+* Kernel threads of every stage and
+* their input fifos, one per thread
+**********************************/
+static void get_stage_input_fifos(
+    EbEncHandle  *enc_handle_ptr,
+    uint32_t      stage_process_count[EB_PIPELINE_STAGE_COUNT],
+    EbFifo      **stage_input_fifo_ptr_array[EB_PIPELINE_STAGE_COUNT])
+{
+    SequenceControlSet *sequence_control_set_ptr = enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr;
+
+    stage_process_count[EB_STAGE_RESOURCE_COORDINATION]       = EB_ResourceCoordinationProcessInitCount;
+    stage_process_count[EB_STAGE_PICTURE_ANALYSIS]            = sequence_control_set_ptr->picture_analysis_process_init_count;
+    stage_process_count[EB_STAGE_PICTURE_DECISION]            = EB_PictureDecisionProcessInitCount;
+    stage_process_count[EB_STAGE_MOTION_ESTIMATION]           = sequence_control_set_ptr->motion_estimation_process_init_count;
+    stage_process_count[EB_STAGE_INITIAL_RATE_CONTROL]        = EB_InitialRateControlProcessInitCount;
+    stage_process_count[EB_STAGE_SOURCE_BASED_OPERATIONS]     = sequence_control_set_ptr->source_based_operations_process_init_count;
+    stage_process_count[EB_STAGE_PICTURE_MANAGER]             = EB_PictureManagerProcessInitCount;
+    stage_process_count[EB_STAGE_RATE_CONTROL]                = EB_RateControlProcessInitCount;
+    stage_process_count[EB_STAGE_MODE_DECISION_CONFIGURATION] = sequence_control_set_ptr->mode_decision_configuration_process_init_count;
+    stage_process_count[EB_STAGE_ENC_DEC]                     = sequence_control_set_ptr->enc_dec_process_init_count;
+    stage_process_count[EB_STAGE_DLF]                         = sequence_control_set_ptr->dlf_process_init_count;
+    stage_process_count[EB_STAGE_CDEF]                        = sequence_control_set_ptr->cdef_process_init_count;
+    stage_process_count[EB_STAGE_REST]                        = sequence_control_set_ptr->rest_process_init_count;
+    stage_process_count[EB_STAGE_ENTROPY_CODING]              = sequence_control_set_ptr->entropy_coding_process_init_count;
+    stage_process_count[EB_STAGE_PACKETIZATION]               = EB_PacketizationProcessInitCount;
+
+    stage_input_fifo_ptr_array[EB_STAGE_RESOURCE_COORDINATION]       = enc_handle_ptr->input_buffer_consumer_fifo_ptr_array;
+    stage_input_fifo_ptr_array[EB_STAGE_PICTURE_ANALYSIS]            = enc_handle_ptr->resource_coordination_results_consumer_fifo_ptr_array;
+    stage_input_fifo_ptr_array[EB_STAGE_PICTURE_DECISION]            = enc_handle_ptr->picture_analysis_results_consumer_fifo_ptr_array;
+    stage_input_fifo_ptr_array[EB_STAGE_MOTION_ESTIMATION]           = enc_handle_ptr->picture_decision_results_consumer_fifo_ptr_array;
+    stage_input_fifo_ptr_array[EB_STAGE_INITIAL_RATE_CONTROL]        = enc_handle_ptr->motion_estimation_results_consumer_fifo_ptr_array;
+    stage_input_fifo_ptr_array[EB_STAGE_SOURCE_BASED_OPERATIONS]     = enc_handle_ptr->initial_rate_control_results_consumer_fifo_ptr_array;
+    stage_input_fifo_ptr_array[EB_STAGE_PICTURE_MANAGER]             = enc_handle_ptr->picture_demux_results_consumer_fifo_ptr_array;
+    stage_input_fifo_ptr_array[EB_STAGE_RATE_CONTROL]                = enc_handle_ptr->rate_control_tasks_consumer_fifo_ptr_array;
+    stage_input_fifo_ptr_array[EB_STAGE_MODE_DECISION_CONFIGURATION] = enc_handle_ptr->rate_control_results_consumer_fifo_ptr_array;
+    stage_input_fifo_ptr_array[EB_STAGE_ENC_DEC]                     = enc_handle_ptr->enc_dec_tasks_consumer_fifo_ptr_array;
+    stage_input_fifo_ptr_array[EB_STAGE_DLF]                         = enc_handle_ptr->enc_dec_results_consumer_fifo_ptr_array;
+    stage_input_fifo_ptr_array[EB_STAGE_CDEF]                        = enc_handle_ptr->dlf_results_consumer_fifo_ptr_array;
+    stage_input_fifo_ptr_array[EB_STAGE_REST]                        = enc_handle_ptr->cdef_results_consumer_fifo_ptr_array;
+    stage_input_fifo_ptr_array[EB_STAGE_ENTROPY_CODING]              = enc_handle_ptr->rest_results_consumer_fifo_ptr_array;
+    stage_input_fifo_ptr_array[EB_STAGE_PACKETIZATION]               = enc_handle_ptr->entropy_coding_results_consumer_fifo_ptr_array;
+}
+
+/**********************************
+* Pipeline statistics: one entry per
+* kernel thread, hooked to the input
+* fifo of the thread
+**********************************/
+static EbErrorType pipeline_stats_ctor(
+    EbEncHandle *enc_handle_ptr)
+{
+    SequenceControlSet *sequence_control_set_ptr = enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr;
+    uint32_t            stage_process_count[EB_PIPELINE_STAGE_COUNT];
+    EbFifo            **stage_input_fifo_ptr_array[EB_PIPELINE_STAGE_COUNT];
+    EbErrorType         return_error;
+    uint32_t            stage;
+
+    get_stage_input_fifos(enc_handle_ptr, stage_process_count, stage_input_fifo_ptr_array);
+
+    return_error = eb_pipeline_stats_ctor(
+        &enc_handle_ptr->pipeline_stats_ptr,
+        sequence_control_set_ptr->static_config.pipeline_stats,
+        stage_process_count);
+    if (return_error == EB_ErrorInsufficientResources)
+        return EB_ErrorInsufficientResources;
+
+    for (stage = 0; stage < EB_PIPELINE_STAGE_COUNT; ++stage)
+        eb_pipeline_stats_attach(enc_handle_ptr->pipeline_stats_ptr, (EbPipelineStage)stage, stage_input_fifo_ptr_array[stage]);
+
+    enc_handle_ptr->sequence_control_set_instance_array[0]->encode_context_ptr->pipeline_stats_ptr = enc_handle_ptr->pipeline_stats_ptr;
+
+    return EB_ErrorNone;
+}
+
+/**********************************
+* Host context: every kernel thread
+* holds a shared worker between two
+* reads of its input fifo
+**********************************/
+static void host_channel_attach_fifos(
+    EbEncHandle *enc_handle_ptr)
+{
+    uint32_t            stage_process_count[EB_PIPELINE_STAGE_COUNT];
+    EbFifo            **stage_input_fifo_ptr_array[EB_PIPELINE_STAGE_COUNT];
+    uint32_t            stage;
+    uint32_t            process_index;
+
+    get_stage_input_fifos(enc_handle_ptr, stage_process_count, stage_input_fifo_ptr_array);
+
+    for (stage = 0; stage < EB_PIPELINE_STAGE_COUNT; ++stage) {
+        for (process_index = 0; process_index < stage_process_count[stage]; ++process_index)
+            stage_input_fifo_ptr_array[stage][process_index]->host_channel_ptr = enc_handle_ptr->host_channel_ptr;
+    }
+}
 
 /**********************************
 * Initialize Encoder Library
@@ -1005,25 +1303,32 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
         enc_handle_ptr->sequence_control_set_instance_array[0]->encode_context_ptr->asm_type = enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->static_config.asm_type;
     }
 
-    setup_rtcd_internal(enc_handle_ptr->sequence_control_set_instance_array[0]->encode_context_ptr->asm_type);
-    asmSetConvolveAsmTable();
-
-    init_intra_dc_predictors_c_internal();
+    // The kernels are shared by the process: an encoder initialized while others
+    // run must use their asm type, and no override is taken until it is deinitialized
+    return_error = eb_kernel_dispatch_attach(
+        enc_handle_ptr->sequence_control_set_instance_array[0]->encode_context_ptr->asm_type,
+        GetCpuAsmType());
+    if (return_error != EB_ErrorNone)
+        return return_error;
+    enc_handle_ptr->kernel_dispatch_attached = EB_TRUE;
 
-    asmSetConvolveHbdAsmTable();
+    EbSetNumaMemoryPolicy(enc_handle_ptr, &enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->static_config);
 
-    init_intra_predictors_internal();
     EbSequenceControlSetInitData scs_init;
     scs_init.sb_size = enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->static_config.super_block_size;
+    scs_init.max_picture_width = 0;
+    scs_init.max_picture_height = 0;
+    if (enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->static_config.low_memory) {
+        scs_init.max_picture_width = enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->max_input_luma_width;
+        scs_init.max_picture_height = enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->max_input_luma_height;
+    }
 
     build_blk_geom(scs_init.sb_size == 128);
 
-    av1_init_me_luts();
-    init_fn_ptr();
-
     /************************************
     * Sequence Control Set
     ************************************/
+    memory_map_category = EB_MEMORY_SEQUENCE_CONTROL_SET;
     return_error = eb_system_resource_ctor(
         &enc_handle_ptr->sequence_control_set_pool_ptr,
         enc_handle_ptr->sequence_control_set_pool_total_count,
@@ -1042,6 +1347,7 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
     /************************************
     * Picture Control Set: Parent
     ************************************/
+    memory_map_category = EB_MEMORY_PICTURE_CONTROL_SET_PARENT;
     EB_MALLOC(EbSystemResource**, enc_handle_ptr->picture_parent_control_set_pool_ptr_array, sizeof(EbSystemResource*)  * enc_handle_ptr->encode_instance_total_count, EB_N_PTR);
 
 
@@ -1104,6 +1410,7 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
     /************************************
     * Picture Control Set: Child
     ************************************/
+    memory_map_category = EB_MEMORY_PICTURE_CONTROL_SET;
     EB_MALLOC(EbSystemResource**, enc_handle_ptr->picture_control_set_pool_ptr_array, sizeof(EbSystemResource*)  * enc_handle_ptr->encode_instance_total_count, EB_N_PTR);
 
     EB_MALLOC(EbFifo***, enc_handle_ptr->picture_control_set_pool_producer_fifo_ptr_dbl_array, sizeof(EbSystemResource**) * enc_handle_ptr->encode_instance_total_count, EB_N_PTR);
@@ -1135,7 +1442,22 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
         inputData.color_format = color_format;
         inputData.sb_sz = enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->sb_sz;
         inputData.sb_size_pix = scs_init.sb_size;
+        inputData.max_block_count = get_max_block_count(enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr);
         inputData.max_depth = enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->max_sb_depth;
+        // Upper bound of the tile grid: above MAX_TILE_WIDTH / MAX_TILE_AREA the picture is split into at least two tiles
+        inputData.tile_column_count = (uint16_t)(1 << MAX(enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->static_config.tile_columns,
+            inputData.picture_width > MAX_TILE_WIDTH ? 1 : 0));
+        inputData.tile_row_count = (uint16_t)(1 << MAX(enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->static_config.tile_rows,
+            (uint32_t)inputData.picture_width * inputData.picture_height > MAX_TILE_AREA ? 1 : 0));
+        // Largest tile: a smaller picture, or one split further to fit the tile limits,
+        // never has larger tiles than the configured grid over the largest picture
+        {
+            const uint32_t sb_size = scs_init.sb_size;
+            const uint32_t tile_columns = enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->static_config.tile_columns;
+            const uint32_t tile_rows = enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->static_config.tile_rows;
+            inputData.max_tile_width = (uint16_t)(((((inputData.picture_width + sb_size - 1) / sb_size) + (1 << tile_columns) - 1) >> tile_columns) * sb_size);
+            inputData.max_tile_height = (uint16_t)(((((inputData.picture_height + sb_size - 1) / sb_size) + (1 << tile_rows) - 1) >> tile_rows) * sb_size);
+        }
 #if MEMORY_FOOTPRINT_OPT_ME_MV
         inputData.cdf_mode = enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->static_config.cdf_mode;
 #endif
@@ -1157,6 +1479,7 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
     /************************************
     * Picture Buffers
     ************************************/
+    memory_map_category = EB_MEMORY_REFERENCE_PICTURES;
 
     // Allocate Resource Arrays
     EB_MALLOC(EbSystemResource**, enc_handle_ptr->reference_picture_pool_ptr_array, sizeof(EbSystemResource*) * enc_handle_ptr->encode_instance_total_count, EB_N_PTR);
@@ -1205,8 +1528,12 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
 
 
         EbReferenceObjectDescInitDataStructure.reference_picture_desc_init_data = referencePictureBufferDescInitData;
+        EbReferenceObjectDescInitDataStructure.sb_total_count = get_sb_total_count(enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr);
+        // The hash tables (4 MB each) are only kept when screen content is forced on
+        EbReferenceObjectDescInitDataStructure.hash_table_enable = (EbBool)(enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->static_config.screen_content_mode == 1);
 
         // Reference Picture Buffers
+        memory_map_category = EB_MEMORY_REFERENCE_PICTURES;
         return_error = eb_system_resource_ctor(
             &enc_handle_ptr->reference_picture_pool_ptr_array[instance_index],
             enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->reference_picture_buffer_init_count,//enc_handle_ptr->reference_picture_pool_total_count,
@@ -1261,8 +1588,10 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
         EbPaReferenceObjectDescInitDataStructure.reference_picture_desc_init_data = referencePictureBufferDescInitData;
         EbPaReferenceObjectDescInitDataStructure.quarter_picture_desc_init_data = quarterDecimPictureBufferDescInitData;
         EbPaReferenceObjectDescInitDataStructure.sixteenth_picture_desc_init_data = sixteenthDecimPictureBufferDescInitData;
+        EbPaReferenceObjectDescInitDataStructure.sb_total_count = get_sb_total_count(enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr);
 
         // Reference Picture Buffers
+        memory_map_category = EB_MEMORY_PA_REFERENCE_PICTURES;
         return_error = eb_system_resource_ctor(
             &enc_handle_ptr->pa_reference_picture_pool_ptr_array[instance_index],
             enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->pa_reference_picture_buffer_init_count,
@@ -1285,6 +1614,7 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
     /************************************
     * System Resource Managers & Fifos
     ************************************/
+    memory_map_category = EB_MEMORY_INPUT_OUTPUT_BUFFERS;
 
     // EbBufferHeaderType Input
     return_error = eb_system_resource_ctor(
@@ -1296,11 +1626,18 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
         &enc_handle_ptr->input_buffer_consumer_fifo_ptr_array,
         EB_TRUE,
         EbInputBufferHeaderCtor,
-        enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr);
+        enc_handle_ptr);
 
     if (return_error == EB_ErrorInsufficientResources) {
         return EB_ErrorInsufficientResources;
     }
+    // Hand zero-copy pictures back to the application once the pipeline is done with them
+    if (enc_handle_ptr->release_input_buffer) {
+        eb_system_resource_set_release_callback(
+            enc_handle_ptr->input_buffer_resource_ptr,
+            ReleaseZeroCopyInputBuffer,
+            enc_handle_ptr);
+    }
     // EbBufferHeaderType Output Stream
     EB_MALLOC(EbSystemResource**, enc_handle_ptr->output_stream_buffer_resource_ptr_array, sizeof(EbSystemResource*) * enc_handle_ptr->encode_instance_total_count, EB_N_PTR);
     EB_MALLOC(EbFifo***, enc_handle_ptr->output_stream_buffer_producer_fifo_ptr_dbl_array, sizeof(EbFifo**)          * enc_handle_ptr->encode_instance_total_count, EB_N_PTR);
@@ -1345,13 +1682,15 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
     }
 
     // Resource Coordination Results
+    memory_map_category = EB_MEMORY_PIPELINE_QUEUES;
     {
         ResourceCoordinationResultInitData resourceCoordinationResultInitData;
 
         return_error = eb_system_resource_ctor(
             &enc_handle_ptr->resource_coordination_results_resource_ptr,
             enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->resource_coordination_fifo_init_count,
-            EB_ResourceCoordinationProcessInitCount,
+            EB_ResourceCoordinationProcessInitCount +
+            enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->picture_analysis_process_init_count, // Picture Analysis segment helpers
             enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->picture_analysis_process_init_count,
             &enc_handle_ptr->resource_coordination_results_producer_fifo_ptr_array,
             &enc_handle_ptr->resource_coordination_results_consumer_fifo_ptr_array,
@@ -1449,7 +1788,7 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
         return_error = eb_system_resource_ctor(
             &enc_handle_ptr->picture_demux_results_resource_ptr,
             enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->picture_demux_fifo_init_count,
-            enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->source_based_operations_process_init_count + enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->rest_process_init_count,
+            enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->source_based_operations_process_init_count + enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->rest_process_init_count + enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->enc_dec_process_init_count,
             EB_PictureManagerProcessInitCount,
             &enc_handle_ptr->picture_demux_results_producer_fifo_ptr_array,
             &enc_handle_ptr->picture_demux_results_consumer_fifo_ptr_array,
@@ -1533,7 +1872,8 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
         return_error = eb_system_resource_ctor(
             &enc_handle_ptr->enc_dec_results_resource_ptr,
             enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->enc_dec_fifo_init_count,
-            enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->enc_dec_process_init_count,
+            enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->enc_dec_process_init_count +
+            enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->dlf_process_init_count, // EncDec + DLF segment helpers
             enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->dlf_process_init_count,
             &enc_handle_ptr->enc_dec_results_producer_fifo_ptr_array,
             &enc_handle_ptr->enc_dec_results_consumer_fifo_ptr_array,
@@ -1552,7 +1892,8 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
         return_error = eb_system_resource_ctor(
             &enc_handle_ptr->dlf_results_resource_ptr,
             enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->dlf_fifo_init_count,
-            enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->dlf_process_init_count,
+            enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->dlf_process_init_count +
+            enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->cdef_process_init_count, // DLF + CDEF segment helpers
             enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->cdef_process_init_count,
             &enc_handle_ptr->dlf_results_producer_fifo_ptr_array,
             &enc_handle_ptr->dlf_results_consumer_fifo_ptr_array,
@@ -1570,7 +1911,8 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
         return_error = eb_system_resource_ctor(
             &enc_handle_ptr->cdef_results_resource_ptr,
             enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->cdef_fifo_init_count,
-            enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->cdef_process_init_count,
+            enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->cdef_process_init_count +
+            enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->rest_process_init_count, // CDEF + Rest segment helpers
             enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->rest_process_init_count,
             &enc_handle_ptr->cdef_results_producer_fifo_ptr_array,
             &enc_handle_ptr->cdef_results_consumer_fifo_ptr_array,
@@ -1631,6 +1973,7 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
     // svt Output Buffer Fifo Ptrs
     for (instance_index = 0; instance_index < enc_handle_ptr->encode_instance_total_count; ++instance_index) {
         enc_handle_ptr->sequence_control_set_instance_array[instance_index]->encode_context_ptr->stream_output_fifo_ptr     = (enc_handle_ptr->output_stream_buffer_producer_fifo_ptr_dbl_array[instance_index])[0];
+        enc_handle_ptr->sequence_control_set_instance_array[instance_index]->encode_context_ptr->fragment_output_fifo_ptr   = (enc_handle_ptr->output_stream_buffer_producer_fifo_ptr_dbl_array[instance_index])[1];
         if (enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->static_config.recon_enabled)
             enc_handle_ptr->sequence_control_set_instance_array[instance_index]->encode_context_ptr->recon_output_fifo_ptr      = (enc_handle_ptr->output_recon_buffer_producer_fifo_ptr_dbl_array[instance_index])[0];
     }
@@ -1640,6 +1983,7 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
     ************************************/
 
     // Resource Coordination Context
+    memory_map_category = EB_MEMORY_KERNEL_CONTEXTS;
     return_error = resource_coordination_context_ctor(
         (ResourceCoordinationContext**)&enc_handle_ptr->resource_coordination_context_ptr,
         enc_handle_ptr->input_buffer_consumer_fifo_ptr_array[0],
@@ -1675,7 +2019,11 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
             EB_TRUE,
             (PictureAnalysisContext**)&enc_handle_ptr->picture_analysis_context_ptr_array[processIndex],
             enc_handle_ptr->resource_coordination_results_consumer_fifo_ptr_array[processIndex],
-            enc_handle_ptr->picture_analysis_results_producer_fifo_ptr_array[processIndex]);
+            enc_handle_ptr->picture_analysis_results_producer_fifo_ptr_array[processIndex],
+            enc_handle_ptr->resource_coordination_results_producer_fifo_ptr_array[
+                EB_ResourceCoordinationProcessInitCount + processIndex], // feedback to Picture Analysis
+            enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->pa_segment_row_count,
+            enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->picture_analysis_process_init_count - 1);
 
         if (return_error == EB_ErrorInsufficientResources) {
             return EB_ErrorInsufficientResources;
@@ -1807,13 +2155,15 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
             enc_handle_ptr->enc_dec_results_producer_fifo_ptr_array[processIndex],
             enc_handle_ptr->enc_dec_tasks_producer_fifo_ptr_array[EncDecPortLookup(ENCDEC_INPUT_PORT_ENCDEC, processIndex)],
             enc_handle_ptr->picture_demux_results_producer_fifo_ptr_array[
-                enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->source_based_operations_process_init_count+
-                //1 +
-                    processIndex], // Add port lookup logic here JMJ
+                enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->source_based_operations_process_init_count +
+                enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->rest_process_init_count +
+                    processIndex], // Own producers, after the ones of Rest
             is16bit,
             color_format,
             enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->max_input_luma_width,
-            enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->max_input_luma_height
+            enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->max_input_luma_height,
+            get_sb_total_count(enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr),
+            get_max_block_count(enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr)
         );
 
         if (return_error == EB_ErrorInsufficientResources) {
@@ -1829,10 +2179,14 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
             (DlfContext**)&enc_handle_ptr->dlf_context_ptr_array[processIndex],
             enc_handle_ptr->enc_dec_results_consumer_fifo_ptr_array[processIndex],
             enc_handle_ptr->dlf_results_producer_fifo_ptr_array[processIndex],             //output to EC
+            enc_handle_ptr->enc_dec_results_producer_fifo_ptr_array[
+                enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->enc_dec_process_init_count + processIndex], // feedback to DLF
             is16bit,
             color_format,
             enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->max_input_luma_width,
-            enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->max_input_luma_height
+            enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->max_input_luma_height,
+            enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->dlf_segment_row_count,
+            enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->dlf_process_init_count - 1
         );
 
         if (return_error == EB_ErrorInsufficientResources) {
@@ -1848,9 +2202,13 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
             (CdefContext_t**)&enc_handle_ptr->cdef_context_ptr_array[processIndex],
             enc_handle_ptr->dlf_results_consumer_fifo_ptr_array[processIndex],
             enc_handle_ptr->cdef_results_producer_fifo_ptr_array[processIndex],
+            enc_handle_ptr->dlf_results_producer_fifo_ptr_array[
+                enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->dlf_process_init_count + processIndex], // feedback to CDEF
             is16bit,
             enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->max_input_luma_width,
-            enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->max_input_luma_height
+            enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->max_input_luma_height,
+            enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->cdef_segment_row_count,
+            enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->cdef_process_init_count - 1
         );
 
         if (return_error == EB_ErrorInsufficientResources) {
@@ -1867,10 +2225,14 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
             enc_handle_ptr->rest_results_producer_fifo_ptr_array[processIndex],
             enc_handle_ptr->picture_demux_results_producer_fifo_ptr_array[
                 /*enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->source_based_operations_process_init_count*/ 1+ processIndex],
+            enc_handle_ptr->cdef_results_producer_fifo_ptr_array[
+                enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->cdef_process_init_count + processIndex], // feedback to Rest
             is16bit,
             color_format,
             enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->max_input_luma_width,
-            enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->max_input_luma_height
+            enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->max_input_luma_height,
+            enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->rest_segment_row_count,
+            enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->rest_process_init_count - 1
         );
 
         if (return_error == EB_ErrorInsufficientResources) {
@@ -1903,96 +2265,176 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
     if (return_error == EB_ErrorInsufficientResources) {
         return EB_ErrorInsufficientResources;
     }
+    // Pipeline Statistics
+    memory_map_category = EB_MEMORY_OTHER;
+    if (enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->static_config.pipeline_stats) {
+        return_error = pipeline_stats_ctor(enc_handle_ptr);
+        if (return_error == EB_ErrorInsufficientResources) {
+            return EB_ErrorInsufficientResources;
+        }
+    }
+
+    if (enc_handle_ptr->host_channel_ptr)
+        host_channel_attach_fifos(enc_handle_ptr);
+
+    // Runtime Reconfiguration
+    enc_handle_ptr->sequence_control_set_instance_array[0]->encode_context_ptr->target_bit_rate =
+        enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->static_config.target_bit_rate;
+    enc_handle_ptr->sequence_control_set_instance_array[0]->encode_context_ptr->intra_period_length =
+        enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->intra_period_length;
+    enc_handle_ptr->sequence_control_set_instance_array[0]->encode_context_ptr->active_intra_period_length =
+        enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->intra_period_length;
+
+    // Second Pass Statistics
+    if (enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->static_config.pass == 2) {
+        SequenceControlSet *sequence_control_set_ptr = enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr;
+        EncodeContext      *encode_context_ptr = enc_handle_ptr->sequence_control_set_instance_array[0]->encode_context_ptr;
+        const uint32_t      sb_count =
+            ((sequence_control_set_ptr->max_input_luma_width + sequence_control_set_ptr->sb_sz - 1) / sequence_control_set_ptr->sb_sz) *
+            ((sequence_control_set_ptr->max_input_luma_height + sequence_control_set_ptr->sb_sz - 1) / sequence_control_set_ptr->sb_sz);
+
+        return_error = eb_pass_stats_ctor(
+            &encode_context_ptr->pass_stats_ptr,
+            enc_handle_ptr->pass_stats_buffer,
+            enc_handle_ptr->pass_stats_size,
+            sb_count);
+        if (return_error == EB_ErrorInsufficientResources)
+            return EB_ErrorInsufficientResources;
+        if (return_error != EB_ErrorNone) {
+            SVT_LOG("Error: the second pass needs the statistics of a first pass of the same input, see eb_svt_enc_set_pass_stats()\n");
+            return EB_ErrorBadParameter;
+        }
+        if (sequence_control_set_ptr->static_config.frames_to_be_encoded > 0 &&
+            encode_context_ptr->pass_stats_ptr->picture_count != sequence_control_set_ptr->static_config.frames_to_be_encoded)
+            SVT_LOG("SVT [WARNING]: the first pass statistics cover %llu pictures, %llu are to be encoded\n",
+                (unsigned long long)encode_context_ptr->pass_stats_ptr->picture_count,
+                (unsigned long long)sequence_control_set_ptr->static_config.frames_to_be_encoded);
+    }
+    enc_handle_ptr->pass_stats_buffer = (const uint8_t*)EB_NULL;
+    enc_handle_ptr->pass_stats_size = 0;
+
     /************************************
     * Thread Handles
     ************************************/
     EbSvtAv1EncConfiguration   *config_ptr = &enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->static_config;
 
+    // The host context bounds the kernel threads of all its channels
+    if (enc_handle_ptr->host_channel_ptr) {
+        const uint32_t thread_count = enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->total_process_init_count;
+
+        if (eb_host_channel_reserve_threads(enc_handle_ptr->host_channel_ptr, thread_count) != EB_ErrorNone) {
+            SVT_LOG("Error: the host context has no room for the %u kernel threads of the encoder, see max_thread_count\n", thread_count);
+            return EB_ErrorInsufficientResources;
+        }
+    }
+
     EbSetThreadManagementParameters(config_ptr);
 
+    EB_MALLOC(EbKernelThreadPriority*, enc_handle_ptr->kernel_thread_priority_array, sizeof(EbKernelThreadPriority) * enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->total_process_init_count, EB_N_PTR);
+    enc_handle_ptr->kernel_thread_count = 0;
+
     // Resource Coordination
-    EB_CREATETHREAD(EbHandle, enc_handle_ptr->resource_coordination_thread_handle, sizeof(EbHandle), EB_THREAD, resource_coordination_kernel, enc_handle_ptr->resource_coordination_context_ptr);
+    set_stage_thread_priority(enc_handle_ptr, config_ptr, EB_STAGE_RESOURCE_COORDINATION);
+    EB_CREATETHREAD(EbHandle, enc_handle_ptr->resource_coordination_thread_handle, sizeof(EbHandle), EB_THREAD, resource_coordination_kernel, enc_handle_ptr->resource_coordination_context_ptr, &enc_handle_ptr->stage_thread_priority[EB_STAGE_RESOURCE_COORDINATION].requested, kernel_thread_priority(enc_handle_ptr, EB_STAGE_RESOURCE_COORDINATION));
 
     // Picture Analysis
+    set_stage_thread_priority(enc_handle_ptr, config_ptr, EB_STAGE_PICTURE_ANALYSIS);
     EB_MALLOC(EbHandle*, enc_handle_ptr->picture_analysis_thread_handle_array, sizeof(EbHandle) * enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->picture_analysis_process_init_count, EB_N_PTR);
 
     for (processIndex = 0; processIndex < enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->picture_analysis_process_init_count; ++processIndex) {
-        EB_CREATETHREAD(EbHandle, enc_handle_ptr->picture_analysis_thread_handle_array[processIndex], sizeof(EbHandle), EB_THREAD, picture_analysis_kernel, enc_handle_ptr->picture_analysis_context_ptr_array[processIndex]);
+        EB_CREATETHREAD(EbHandle, enc_handle_ptr->picture_analysis_thread_handle_array[processIndex], sizeof(EbHandle), EB_THREAD, picture_analysis_kernel, enc_handle_ptr->picture_analysis_context_ptr_array[processIndex], &enc_handle_ptr->stage_thread_priority[EB_STAGE_PICTURE_ANALYSIS].requested, kernel_thread_priority(enc_handle_ptr, EB_STAGE_PICTURE_ANALYSIS));
     }
 
     // Picture Decision
-    EB_CREATETHREAD(EbHandle, enc_handle_ptr->picture_decision_thread_handle, sizeof(EbHandle), EB_THREAD, picture_decision_kernel, enc_handle_ptr->picture_decision_context_ptr);
+    set_stage_thread_priority(enc_handle_ptr, config_ptr, EB_STAGE_PICTURE_DECISION);
+    EB_CREATETHREAD(EbHandle, enc_handle_ptr->picture_decision_thread_handle, sizeof(EbHandle), EB_THREAD, picture_decision_kernel, enc_handle_ptr->picture_decision_context_ptr, &enc_handle_ptr->stage_thread_priority[EB_STAGE_PICTURE_DECISION].requested, kernel_thread_priority(enc_handle_ptr, EB_STAGE_PICTURE_DECISION));
 
     // Motion Estimation
+    set_stage_thread_priority(enc_handle_ptr, config_ptr, EB_STAGE_MOTION_ESTIMATION);
     EB_MALLOC(EbHandle*, enc_handle_ptr->motion_estimation_thread_handle_array, sizeof(EbHandle) * enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->motion_estimation_process_init_count, EB_N_PTR);
 
     for (processIndex = 0; processIndex < enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->motion_estimation_process_init_count; ++processIndex) {
-        EB_CREATETHREAD(EbHandle, enc_handle_ptr->motion_estimation_thread_handle_array[processIndex], sizeof(EbHandle), EB_THREAD, motion_estimation_kernel, enc_handle_ptr->motion_estimation_context_ptr_array[processIndex]);
+        EB_CREATETHREAD(EbHandle, enc_handle_ptr->motion_estimation_thread_handle_array[processIndex], sizeof(EbHandle), EB_THREAD, motion_estimation_kernel, enc_handle_ptr->motion_estimation_context_ptr_array[processIndex], &enc_handle_ptr->stage_thread_priority[EB_STAGE_MOTION_ESTIMATION].requested, kernel_thread_priority(enc_handle_ptr, EB_STAGE_MOTION_ESTIMATION));
     }
 
     // Initial Rate Control
-    EB_CREATETHREAD(EbHandle, enc_handle_ptr->initial_rate_control_thread_handle, sizeof(EbHandle), EB_THREAD, initial_rate_control_kernel, enc_handle_ptr->initial_rate_control_context_ptr);
+    set_stage_thread_priority(enc_handle_ptr, config_ptr, EB_STAGE_INITIAL_RATE_CONTROL);
+    EB_CREATETHREAD(EbHandle, enc_handle_ptr->initial_rate_control_thread_handle, sizeof(EbHandle), EB_THREAD, initial_rate_control_kernel, enc_handle_ptr->initial_rate_control_context_ptr, &enc_handle_ptr->stage_thread_priority[EB_STAGE_INITIAL_RATE_CONTROL].requested, kernel_thread_priority(enc_handle_ptr, EB_STAGE_INITIAL_RATE_CONTROL));
 
     // Source Based Oprations
+    set_stage_thread_priority(enc_handle_ptr, config_ptr, EB_STAGE_SOURCE_BASED_OPERATIONS);
     EB_MALLOC(EbHandle*, enc_handle_ptr->source_based_operations_thread_handle_array, sizeof(EbHandle) * enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->source_based_operations_process_init_count, EB_N_PTR);
 
     for (processIndex = 0; processIndex < enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->source_based_operations_process_init_count; ++processIndex) {
-        EB_CREATETHREAD(EbHandle, enc_handle_ptr->source_based_operations_thread_handle_array[processIndex], sizeof(EbHandle), EB_THREAD, source_based_operations_kernel, enc_handle_ptr->source_based_operations_context_ptr_array[processIndex]);
+        EB_CREATETHREAD(EbHandle, enc_handle_ptr->source_based_operations_thread_handle_array[processIndex], sizeof(EbHandle), EB_THREAD, source_based_operations_kernel, enc_handle_ptr->source_based_operations_context_ptr_array[processIndex], &enc_handle_ptr->stage_thread_priority[EB_STAGE_SOURCE_BASED_OPERATIONS].requested, kernel_thread_priority(enc_handle_ptr, EB_STAGE_SOURCE_BASED_OPERATIONS));
     }
 
     // Picture Manager
-    EB_CREATETHREAD(EbHandle, enc_handle_ptr->picture_manager_thread_handle, sizeof(EbHandle), EB_THREAD, picture_manager_kernel, enc_handle_ptr->picture_manager_context_ptr);
+    set_stage_thread_priority(enc_handle_ptr, config_ptr, EB_STAGE_PICTURE_MANAGER);
+    EB_CREATETHREAD(EbHandle, enc_handle_ptr->picture_manager_thread_handle, sizeof(EbHandle), EB_THREAD, picture_manager_kernel, enc_handle_ptr->picture_manager_context_ptr, &enc_handle_ptr->stage_thread_priority[EB_STAGE_PICTURE_MANAGER].requested, kernel_thread_priority(enc_handle_ptr, EB_STAGE_PICTURE_MANAGER));
 
     // Rate Control
-    EB_CREATETHREAD(EbHandle, enc_handle_ptr->rate_control_thread_handle, sizeof(EbHandle), EB_THREAD, rate_control_kernel, enc_handle_ptr->rate_control_context_ptr);
+    set_stage_thread_priority(enc_handle_ptr, config_ptr, EB_STAGE_RATE_CONTROL);
+    EB_CREATETHREAD(EbHandle, enc_handle_ptr->rate_control_thread_handle, sizeof(EbHandle), EB_THREAD, rate_control_kernel, enc_handle_ptr->rate_control_context_ptr, &enc_handle_ptr->stage_thread_priority[EB_STAGE_RATE_CONTROL].requested, kernel_thread_priority(enc_handle_ptr, EB_STAGE_RATE_CONTROL));
 
     // Mode Decision Configuration Process
+    set_stage_thread_priority(enc_handle_ptr, config_ptr, EB_STAGE_MODE_DECISION_CONFIGURATION);
     EB_MALLOC(EbHandle*, enc_handle_ptr->mode_decision_configuration_thread_handle_array, sizeof(EbHandle) * enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->mode_decision_configuration_process_init_count, EB_N_PTR);
 
     for (processIndex = 0; processIndex < enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->mode_decision_configuration_process_init_count; ++processIndex) {
-        EB_CREATETHREAD(EbHandle, enc_handle_ptr->mode_decision_configuration_thread_handle_array[processIndex], sizeof(EbHandle), EB_THREAD, mode_decision_configuration_kernel, enc_handle_ptr->mode_decision_configuration_context_ptr_array[processIndex]);
+        EB_CREATETHREAD(EbHandle, enc_handle_ptr->mode_decision_configuration_thread_handle_array[processIndex], sizeof(EbHandle), EB_THREAD, mode_decision_configuration_kernel, enc_handle_ptr->mode_decision_configuration_context_ptr_array[processIndex], &enc_handle_ptr->stage_thread_priority[EB_STAGE_MODE_DECISION_CONFIGURATION].requested, kernel_thread_priority(enc_handle_ptr, EB_STAGE_MODE_DECISION_CONFIGURATION));
     }
 
     // EncDec Process
+    set_stage_thread_priority(enc_handle_ptr, config_ptr, EB_STAGE_ENC_DEC);
     EB_MALLOC(EbHandle*, enc_handle_ptr->enc_dec_thread_handle_array, sizeof(EbHandle) * enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->enc_dec_process_init_count, EB_N_PTR);
 
     for (processIndex = 0; processIndex < enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->enc_dec_process_init_count; ++processIndex) {
-        EB_CREATETHREAD(EbHandle, enc_handle_ptr->enc_dec_thread_handle_array[processIndex], sizeof(EbHandle), EB_THREAD, enc_dec_kernel, enc_handle_ptr->enc_dec_context_ptr_array[processIndex]);
+        EB_CREATETHREAD(EbHandle, enc_handle_ptr->enc_dec_thread_handle_array[processIndex], sizeof(EbHandle), EB_THREAD, enc_dec_kernel, enc_handle_ptr->enc_dec_context_ptr_array[processIndex], &enc_handle_ptr->stage_thread_priority[EB_STAGE_ENC_DEC].requested, kernel_thread_priority(enc_handle_ptr, EB_STAGE_ENC_DEC));
     }
 
     // Dlf Process
+    set_stage_thread_priority(enc_handle_ptr, config_ptr, EB_STAGE_DLF);
     EB_MALLOC(EbHandle*, enc_handle_ptr->dlf_thread_handle_array, sizeof(EbHandle) * enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->dlf_process_init_count, EB_N_PTR);
 
     for (processIndex = 0; processIndex < enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->dlf_process_init_count; ++processIndex) {
-        EB_CREATETHREAD(EbHandle, enc_handle_ptr->dlf_thread_handle_array[processIndex], sizeof(EbHandle), EB_THREAD, dlf_kernel, enc_handle_ptr->dlf_context_ptr_array[processIndex]);
+        EB_CREATETHREAD(EbHandle, enc_handle_ptr->dlf_thread_handle_array[processIndex], sizeof(EbHandle), EB_THREAD, dlf_kernel, enc_handle_ptr->dlf_context_ptr_array[processIndex], &enc_handle_ptr->stage_thread_priority[EB_STAGE_DLF].requested, kernel_thread_priority(enc_handle_ptr, EB_STAGE_DLF));
     }
 
 
     // Cdef Process
+    set_stage_thread_priority(enc_handle_ptr, config_ptr, EB_STAGE_CDEF);
     EB_MALLOC(EbHandle*, enc_handle_ptr->cdef_thread_handle_array, sizeof(EbHandle) * enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->cdef_process_init_count, EB_N_PTR);
 
     for (processIndex = 0; processIndex < enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->cdef_process_init_count; ++processIndex) {
-        EB_CREATETHREAD(EbHandle, enc_handle_ptr->cdef_thread_handle_array[processIndex], sizeof(EbHandle), EB_THREAD, cdef_kernel, enc_handle_ptr->cdef_context_ptr_array[processIndex]);
+        EB_CREATETHREAD(EbHandle, enc_handle_ptr->cdef_thread_handle_array[processIndex], sizeof(EbHandle), EB_THREAD, cdef_kernel, enc_handle_ptr->cdef_context_ptr_array[processIndex], &enc_handle_ptr->stage_thread_priority[EB_STAGE_CDEF].requested, kernel_thread_priority(enc_handle_ptr, EB_STAGE_CDEF));
     }
 
     // Rest Process
+    set_stage_thread_priority(enc_handle_ptr, config_ptr, EB_STAGE_REST);
     EB_MALLOC(EbHandle*, enc_handle_ptr->rest_thread_handle_array, sizeof(EbHandle) * enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->rest_process_init_count, EB_N_PTR);
 
     for (processIndex = 0; processIndex < enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->rest_process_init_count; ++processIndex) {
-        EB_CREATETHREAD(EbHandle, enc_handle_ptr->rest_thread_handle_array[processIndex], sizeof(EbHandle), EB_THREAD, rest_kernel, enc_handle_ptr->rest_context_ptr_array[processIndex]);
+        EB_CREATETHREAD(EbHandle, enc_handle_ptr->rest_thread_handle_array[processIndex], sizeof(EbHandle), EB_THREAD, rest_kernel, enc_handle_ptr->rest_context_ptr_array[processIndex], &enc_handle_ptr->stage_thread_priority[EB_STAGE_REST].requested, kernel_thread_priority(enc_handle_ptr, EB_STAGE_REST));
     }
 
     // Entropy Coding Process
+    set_stage_thread_priority(enc_handle_ptr, config_ptr, EB_STAGE_ENTROPY_CODING);
     EB_MALLOC(EbHandle*, enc_handle_ptr->entropy_coding_thread_handle_array, sizeof(EbHandle) * enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->entropy_coding_process_init_count, EB_N_PTR);
 
     for (processIndex = 0; processIndex < enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->entropy_coding_process_init_count; ++processIndex) {
-        EB_CREATETHREAD(EbHandle, enc_handle_ptr->entropy_coding_thread_handle_array[processIndex], sizeof(EbHandle), EB_THREAD, entropy_coding_kernel, enc_handle_ptr->entropy_coding_context_ptr_array[processIndex]);
+        EB_CREATETHREAD(EbHandle, enc_handle_ptr->entropy_coding_thread_handle_array[processIndex], sizeof(EbHandle), EB_THREAD, entropy_coding_kernel, enc_handle_ptr->entropy_coding_context_ptr_array[processIndex], &enc_handle_ptr->stage_thread_priority[EB_STAGE_ENTROPY_CODING].requested, kernel_thread_priority(enc_handle_ptr, EB_STAGE_ENTROPY_CODING));
     }
 
     // Packetization
-    EB_CREATETHREAD(EbHandle, enc_handle_ptr->packetization_thread_handle, sizeof(EbHandle), EB_THREAD, packetization_kernel, enc_handle_ptr->packetization_context_ptr);
+    set_stage_thread_priority(enc_handle_ptr, config_ptr, EB_STAGE_PACKETIZATION);
+    EB_CREATETHREAD(EbHandle, enc_handle_ptr->packetization_thread_handle, sizeof(EbHandle), EB_THREAD, packetization_kernel, enc_handle_ptr->packetization_context_ptr, &enc_handle_ptr->stage_thread_priority[EB_STAGE_PACKETIZATION].requested, kernel_thread_priority(enc_handle_ptr, EB_STAGE_PACKETIZATION));
 
+    report_thread_priority(enc_handle_ptr);
 
+    collect_memory_usage(enc_handle_ptr);
+    if (config_ptr->low_memory)
+        report_memory_usage(enc_handle_ptr);
 #if DISPLAY_MEMORY
     EB_MEMORY();
 #endif
@@ -2094,6 +2536,24 @@ EB_API EbErrorType eb_deinit_encoder(EbComponentType *svt_enc_component){
         }
     }
 #endif
+    // The kernel threads are gone, the workers they held go back to the host
+    if (enc_handle_ptr && enc_handle_ptr->host_channel_ptr) {
+        eb_host_channel_detach(enc_handle_ptr->host_channel_ptr);
+        enc_handle_ptr->host_channel_ptr = (EbHostChannel*)EB_NULL;
+    }
+    // Likewise for the ladder, the renditions still running get no more scene changes
+    if (enc_handle_ptr && enc_handle_ptr->ladder_rendition_ptr) {
+        eb_ladder_rendition_detach(enc_handle_ptr->ladder_rendition_ptr);
+        enc_handle_ptr->ladder_rendition_ptr = (EbLadderRendition*)EB_NULL;
+    }
+    if (enc_handle_ptr && enc_handle_ptr->ladder_ptr) {
+        eb_ladder_leader_detach(enc_handle_ptr->ladder_ptr);
+        enc_handle_ptr->ladder_ptr = (EbLadderContext*)EB_NULL;
+    }
+    if (enc_handle_ptr && enc_handle_ptr->kernel_dispatch_attached) {
+        eb_kernel_dispatch_detach();
+        enc_handle_ptr->kernel_dispatch_attached = EB_FALSE;
+    }
     return return_error;
 }
 
@@ -2153,6 +2613,15 @@ EbErrorType eb_h265_enc_component_de_init(EbComponentType  *svt_enc_component)
     EbErrorType       return_error = EB_ErrorNone;
 
     if (svt_enc_component->p_component_private) {
+        // Attached, but eb_deinit_encoder() was not called
+        if (((EbEncHandle *)svt_enc_component->p_component_private)->host_channel_ptr)
+            eb_host_channel_detach(((EbEncHandle *)svt_enc_component->p_component_private)->host_channel_ptr);
+        if (((EbEncHandle *)svt_enc_component->p_component_private)->ladder_rendition_ptr)
+            eb_ladder_rendition_detach(((EbEncHandle *)svt_enc_component->p_component_private)->ladder_rendition_ptr);
+        if (((EbEncHandle *)svt_enc_component->p_component_private)->ladder_ptr)
+            eb_ladder_leader_detach(((EbEncHandle *)svt_enc_component->p_component_private)->ladder_ptr);
+        if (((EbEncHandle *)svt_enc_component->p_component_private)->kernel_dispatch_attached)
+            eb_kernel_dispatch_detach();
         free((EbEncHandle *)svt_enc_component->p_component_private);
     }
     else {
@@ -2409,6 +2878,8 @@ void CopyApiFromApp(
     // Deblock Filter
     sequence_control_set_ptr->static_config.disable_dlf_flag = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->disable_dlf_flag;
 #endif
+    sequence_control_set_ptr->static_config.filter_row_pipeline = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->filter_row_pipeline;
+    sequence_control_set_ptr->static_config.inter_picture_wavefront = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->inter_picture_wavefront;
 
     // Local Warped Motion
 #if ENABLE_WARPED_MV
@@ -2457,11 +2928,17 @@ void CopyApiFromApp(
     // Adaptive Loop Filter
     sequence_control_set_ptr->static_config.tile_rows = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->tile_rows;
     sequence_control_set_ptr->static_config.tile_columns = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->tile_columns;
+    // The first pass outputs no bitstream
+    sequence_control_set_ptr->static_config.tile_group_output = (((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->pass == 1) ? EB_FALSE :
+        ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->tile_group_output;
 
 
     // Rate Control
     sequence_control_set_ptr->static_config.scene_change_detection = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->scene_change_detection;
-    sequence_control_set_ptr->static_config.rate_control_mode = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->rate_control_mode;
+    sequence_control_set_ptr->static_config.pass = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->pass;
+    // The first pass only collects statistics
+    sequence_control_set_ptr->static_config.rate_control_mode = (sequence_control_set_ptr->static_config.pass == 1) ? 0 :
+        ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->rate_control_mode;
     sequence_control_set_ptr->static_config.look_ahead_distance = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->look_ahead_distance;
     sequence_control_set_ptr->static_config.frames_to_be_encoded = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->frames_to_be_encoded;
     sequence_control_set_ptr->static_config.frame_rate = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->frame_rate;
@@ -2514,8 +2991,15 @@ void CopyApiFromApp(
     sequence_control_set_ptr->static_config.active_channel_count = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->active_channel_count;
     sequence_control_set_ptr->static_config.logical_processors = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->logical_processors;
     sequence_control_set_ptr->static_config.target_socket = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->target_socket;
+    sequence_control_set_ptr->static_config.unified_thread_pool = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->unified_thread_pool;
+    sequence_control_set_ptr->static_config.numa_memory_policy = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->numa_memory_policy;
+    sequence_control_set_ptr->static_config.low_memory = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->low_memory;
+    sequence_control_set_ptr->static_config.thread_policy = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->thread_policy;
+    sequence_control_set_ptr->static_config.thread_priority = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->thread_priority;
+    EB_MEMCPY(sequence_control_set_ptr->static_config.stage_priority_boost, ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->stage_priority_boost, sizeof(sequence_control_set_ptr->static_config.stage_priority_boost));
     sequence_control_set_ptr->qp = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->qp;
     sequence_control_set_ptr->static_config.recon_enabled = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->recon_enabled;
+    sequence_control_set_ptr->static_config.pipeline_stats = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->pipeline_stats;
 
     // Extract frame rate from Numerator and Denominator if not 0
     if (sequence_control_set_ptr->static_config.frame_rate_numerator != 0 && sequence_control_set_ptr->static_config.frame_rate_denominator != 0) {
@@ -2675,6 +3159,16 @@ static EbErrorType VerifySettings(
         return_error = EB_ErrorBadParameter;
     }
 
+    if (config->filter_row_pipeline > 1) {
+        SVT_LOG("Error Instance %u: Invalid FilterRowPipeline. FilterRowPipeline must be [0 - 1]\n", channelNumber + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->inter_picture_wavefront > 1) {
+        SVT_LOG("Error Instance %u: Invalid InterPictureWavefront. InterPictureWavefront must be [0 - 1]\n", channelNumber + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
     if (config->use_default_me_hme > 1) {
         SVT_LOG("Error Instance %u: invalid use_default_me_hme. use_default_me_hme must be [0 - 1]\n", channelNumber + 1);
         return_error = EB_ErrorBadParameter;
@@ -2803,6 +3297,10 @@ static EbErrorType VerifySettings(
         SVT_LOG("Error Instance %u: Log2Tile rows/cols must be [0 - 6] \n", channelNumber + 1);
         return_error = EB_ErrorBadParameter;
     }
+    if (config->tile_group_output > 1) {
+        SVT_LOG("Error Instance %u: TileGroupOutput must be [0 - 1] \n", channelNumber + 1);
+        return_error = EB_ErrorBadParameter;
+    }
 
     if (config->scene_change_detection > 1) {
         SVT_LOG("Error Instance %u: The scene change detection must be [0 - 1] \n", channelNumber + 1);
@@ -2821,6 +3319,13 @@ static EbErrorType VerifySettings(
         return_error = EB_ErrorBadParameter;
     }
 
+    if (config->pass > 2) {
+        SVT_LOG("Error instance %u: Pass must be [0 - 2]\n", channelNumber + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+    if (config->pass == 2 && config->rate_control_mode != 2)
+        SVT_LOG("SVT [WARNING]: Instance %u: The first pass statistics are only used with rate control mode 2\n", channelNumber + 1);
+
     if (config->improve_sharpness > 1) {
         SVT_LOG("Error instance %u : Invalid ImproveSharpness. ImproveSharpness must be [0 - 1]\n", channelNumber + 1);
         return_error = EB_ErrorBadParameter;
@@ -2885,6 +3390,53 @@ static EbErrorType VerifySettings(
         return_error = EB_ErrorBadParameter;
     }
 
+    if (config->unified_thread_pool != 0 && config->unified_thread_pool != 1) {
+        SVT_LOG("Error instance %u: Invalid unified_thread_pool. unified_thread_pool must be [0 - 1] \n", channelNumber + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->numa_memory_policy > 2) {
+        SVT_LOG("Error instance %u: Invalid numa_memory_policy. numa_memory_policy must be [0 - 2] \n", channelNumber + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->numa_memory_policy == 1 && config->target_socket == -1) {
+        SVT_LOG("Error instance %u: numa_memory_policy 1 requires target_socket to be set \n", channelNumber + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->low_memory != 0 && config->low_memory != 1) {
+        SVT_LOG("Error instance %u: Invalid low_memory. low_memory must be [0 - 1] \n", channelNumber + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->thread_policy > EB_THREAD_POLICY_REALTIME) {
+        SVT_LOG("Error instance %u: Invalid thread_policy. thread_policy must be [0 - 2] \n", channelNumber + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->thread_policy == EB_THREAD_POLICY_NICE && (config->thread_priority < -20 || config->thread_priority > 19)) {
+        SVT_LOG("Error instance %u: Invalid thread_priority. The nice value must be [-20 - 19] \n", channelNumber + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->thread_policy == EB_THREAD_POLICY_REALTIME && (config->thread_priority < 1 || config->thread_priority > 99)) {
+        SVT_LOG("Error instance %u: Invalid thread_priority. The real-time priority must be [1 - 99] \n", channelNumber + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    for (uint32_t stage = 0; stage < EB_PIPELINE_STAGE_COUNT; ++stage) {
+        if (config->stage_priority_boost[stage] < -99 || config->stage_priority_boost[stage] > 99) {
+            SVT_LOG("Error instance %u: Invalid stage_priority_boost[%u]. stage_priority_boost must be [-99 - 99] \n", channelNumber + 1, stage);
+            return_error = EB_ErrorBadParameter;
+        }
+    }
+
+    if (config->pipeline_stats > 2) {
+        SVT_LOG("Error instance %u: Invalid pipeline_stats. pipeline_stats must be [0 - 2] \n", channelNumber + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
     return return_error;
 }
 
@@ -2913,12 +3465,14 @@ EbErrorType eb_svt_enc_init_parameter(
     config_ptr->stat_report = 0;
     config_ptr->tile_rows = 0;
     config_ptr->tile_columns = 0;
+    config_ptr->tile_group_output = EB_FALSE;
 
     config_ptr->qp = 50;
     config_ptr->use_qp_file = EB_FALSE;
     config_ptr->scene_change_detection = 0;
     config_ptr->rate_control_mode = 0;
     config_ptr->look_ahead_distance = (uint32_t)~0;
+    config_ptr->pass = 0;
     config_ptr->target_bit_rate = 7000000;
     config_ptr->max_qp_allowed = 63;
 #if RC
@@ -2933,6 +3487,8 @@ EbErrorType eb_svt_enc_init_parameter(
     config_ptr->hierarchical_levels = 4;
     config_ptr->pred_structure = EB_PRED_RANDOM_ACCESS;
     config_ptr->disable_dlf_flag = EB_FALSE;
+    config_ptr->filter_row_pipeline = EB_FALSE;
+    config_ptr->inter_picture_wavefront = EB_FALSE;
 #if ENABLE_WARPED_MV
     config_ptr->enable_warped_motion = EB_TRUE;
 #else
@@ -2995,11 +3551,19 @@ EbErrorType eb_svt_enc_init_parameter(
     // Channel info
     config_ptr->logical_processors = 0;
     config_ptr->target_socket = -1;
+    config_ptr->unified_thread_pool = EB_FALSE;
+    config_ptr->numa_memory_policy = 0;
+    config_ptr->low_memory = EB_FALSE;
+    config_ptr->thread_policy = EB_THREAD_POLICY_NORMAL;
+    config_ptr->thread_priority = 0;
+    for (uint32_t stage = 0; stage < EB_PIPELINE_STAGE_COUNT; ++stage)
+        config_ptr->stage_priority_boost[stage] = 0;
     config_ptr->channel_id = 0;
     config_ptr->active_channel_count = 1;
 
     // Debug info
     config_ptr->recon_enabled = 0;
+    config_ptr->pipeline_stats = 0;
 
     return return_error;
 }
@@ -3047,6 +3611,14 @@ static void print_lib_params(
         SVT_LOG("\nSVT [config]: RCMode / TargetBitrate / LookaheadDistance / SceneChange\t\t: Constraint VBR / %d / %d / %d ", config->target_bit_rate, config->look_ahead_distance, config->scene_change_detection);
     else
         SVT_LOG("\nSVT [config]: BRC Mode / QP  / LookaheadDistance / SceneChange\t\t\t: CQP / %d / %d / %d ", scs->qp, config->look_ahead_distance, config->scene_change_detection);
+    if (config->pass)
+        SVT_LOG("\nSVT [config]: Pass \t\t\t\t\t\t\t\t: %d ", config->pass);
+    if (config->filter_row_pipeline)
+        SVT_LOG("\nSVT [config]: FilterRowPipeline \t\t\t\t\t\t\t: %d ", config->filter_row_pipeline);
+    if (config->inter_picture_wavefront)
+        SVT_LOG("\nSVT [config]: InterPictureWavefront \t\t\t\t\t\t: %d ", config->inter_picture_wavefront);
+    if (config->tile_group_output)
+        SVT_LOG("\nSVT [config]: Log2TileRows / Log2TileCols / TileGroupOutput \t\t\t: %d / %d / %d ", config->tile_rows, config->tile_columns, config->tile_group_output);
 #ifdef DEBUG_BUFFERS
     SVT_LOG("\nSVT [config]: INPUT / OUTPUT \t\t\t\t\t\t\t: %d / %d", scs->input_buffer_fifo_init_count, scs->output_stream_buffer_fifo_init_count);
     SVT_LOG("\nSVT [config]: CPCS / PAREF / REF \t\t\t\t\t\t: %d / %d / %d", scs->picture_control_set_pool_init_count_child, scs->pa_reference_picture_buffer_init_count, scs->reference_picture_buffer_init_count);
@@ -3144,6 +3716,9 @@ EB_API EbErrorType eb_svt_enc_set_parameter(
         pEncCompData->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->max_ref_count,
         pEncCompData->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->max_temporal_layers);
 
+    pEncCompData->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->host_thread_budget = pEncCompData->host_channel_ptr ?
+        eb_host_channel_thread_budget(pEncCompData->host_channel_ptr) : 0;
+
     return_error = load_default_buffer_configuration_settings(
         pEncCompData->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr);
 
@@ -3155,6 +3730,170 @@ EB_API EbErrorType eb_svt_enc_set_parameter(
 
     return return_error;
 }
+
+/**********************************
+* Reconfigure
+**********************************/
+#if defined(__linux__) || defined(__APPLE__)
+__attribute__((visibility("default")))
+#endif
+EB_API EbErrorType eb_svt_enc_reconfigure(
+    EbComponentType              *svt_enc_component,
+    EbSvtAv1EncConfiguration     *pComponentParameterStructure)
+{
+    EbEncHandle                  *enc_handle_ptr;
+    SequenceControlSet           *sequence_control_set_ptr;
+    EncodeContext                *encode_context_ptr;
+    EbSvtAv1EncConfiguration     *config;
+    EbBool                        resize_flag;
+    EbErrorType                   return_error = EB_ErrorNone;
+
+    if (svt_enc_component == NULL || pComponentParameterStructure == NULL)
+        return EB_ErrorBadParameter;
+
+    enc_handle_ptr = (EbEncHandle*)svt_enc_component->p_component_private;
+    sequence_control_set_ptr = enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr;
+    encode_context_ptr = enc_handle_ptr->sequence_control_set_instance_array[0]->encode_context_ptr;
+    config = &sequence_control_set_ptr->static_config;
+
+    eb_block_on_mutex(enc_handle_ptr->sequence_control_set_instance_array[0]->config_mutex);
+
+    resize_flag = (EbBool)(pComponentParameterStructure->source_width != config->source_width ||
+        pComponentParameterStructure->source_height != config->source_height);
+
+    if (pComponentParameterStructure->target_bit_rate != encode_context_ptr->target_bit_rate && config->rate_control_mode == 0) {
+        SVT_LOG("Error: the target bit rate can only be changed with rate control\n");
+        return_error = EB_ErrorBadParameter;
+    }
+    if (pComponentParameterStructure->intra_period_length != encode_context_ptr->intra_period_length) {
+        if (config->rate_control_mode) {
+            SVT_LOG("Error: the intra period can only be changed without rate control\n");
+            return_error = EB_ErrorBadParameter;
+        }
+        if (pComponentParameterStructure->intra_period_length < -1 || pComponentParameterStructure->intra_period_length > 255) {
+            SVT_LOG("Error: the intra period must be [-1 - 255]\n");
+            return_error = EB_ErrorBadParameter;
+        }
+    }
+    if (resize_flag) {
+        if (pComponentParameterStructure->source_width % 8 || pComponentParameterStructure->source_height % 8 ||
+            pComponentParameterStructure->source_width < 64 || pComponentParameterStructure->source_height < 64 ||
+            pComponentParameterStructure->source_width > sequence_control_set_ptr->max_input_luma_width ||
+            pComponentParameterStructure->source_height > sequence_control_set_ptr->max_input_luma_height) {
+            SVT_LOG("Error: the new size must be multiples of 8, from 64 up to %u x %u\n",
+                sequence_control_set_ptr->max_input_luma_width, sequence_control_set_ptr->max_input_luma_height);
+            return_error = EB_ErrorBadParameter;
+        }
+        if (sequence_control_set_ptr->max_input_pad_right || sequence_control_set_ptr->max_input_pad_bottom) {
+            SVT_LOG("Error: the size can only be changed when the configured one is a multiple of 8\n");
+            return_error = EB_ErrorBadParameter;
+        }
+        if (config->film_grain_denoise_strength || config->pass) {
+            SVT_LOG("Error: the size can not be changed with film grain denoising or two-pass encoding\n");
+            return_error = EB_ErrorBadParameter;
+        }
+    }
+
+    if (return_error == EB_ErrorNone) {
+        encode_context_ptr->target_bit_rate = pComponentParameterStructure->target_bit_rate;
+        encode_context_ptr->intra_period_length = pComponentParameterStructure->intra_period_length;
+
+        // Stamped on the pictures sent from now on, see CopyInputBuffer()
+        config->source_width = pComponentParameterStructure->source_width;
+        config->source_height = pComponentParameterStructure->source_height;
+    }
+
+    eb_release_mutex(enc_handle_ptr->sequence_control_set_instance_array[0]->config_mutex);
+
+    return return_error;
+}
+
+/**********************************
+* ABR Ladder
+**********************************/
+#if defined(__linux__) || defined(__APPLE__)
+__attribute__((visibility("default")))
+#endif
+EB_API EbErrorType eb_svt_enc_attach_ladder(
+    EbComponentType         *svt_enc_component,
+    EbComponentType         *leader_component)
+{
+    EbEncHandle                  *enc_handle_ptr;
+    EbEncHandle                  *leader_handle_ptr;
+    EncodeContext                *encode_context_ptr;
+    EncodeContext                *leader_encode_context_ptr;
+    EbSvtAv1EncConfiguration     *config;
+    EbSvtAv1EncConfiguration     *leader_config;
+    EbErrorType                   return_error;
+
+    if (svt_enc_component == NULL || leader_component == NULL || svt_enc_component == leader_component)
+        return EB_ErrorBadParameter;
+
+    enc_handle_ptr = (EbEncHandle*)svt_enc_component->p_component_private;
+    leader_handle_ptr = (EbEncHandle*)leader_component->p_component_private;
+    encode_context_ptr = enc_handle_ptr->sequence_control_set_instance_array[0]->encode_context_ptr;
+    leader_encode_context_ptr = leader_handle_ptr->sequence_control_set_instance_array[0]->encode_context_ptr;
+    config = &enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->static_config;
+    leader_config = &leader_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->static_config;
+
+    if (enc_handle_ptr->ladder_ptr || enc_handle_ptr->ladder_rendition_ptr || leader_handle_ptr->ladder_rendition_ptr) {
+        SVT_LOG("Error: a ladder rendition can not lead or follow another ladder\n");
+        return EB_ErrorBadParameter;
+    }
+    if (!encode_context_ptr->initial_picture || !leader_encode_context_ptr->initial_picture) {
+        SVT_LOG("Error: the ladder must be set before any picture is sent\n");
+        return EB_ErrorBadParameter;
+    }
+    if (!leader_config->scene_change_detection) {
+        SVT_LOG("Error: the ladder leader must run the scene change detection\n");
+        return EB_ErrorBadParameter;
+    }
+    // The same scene changes then give the same GOP structure
+    if (config->intra_period_length != leader_config->intra_period_length ||
+        config->intra_refresh_type != leader_config->intra_refresh_type ||
+        config->hierarchical_levels != leader_config->hierarchical_levels ||
+        config->pred_structure != leader_config->pred_structure) {
+        SVT_LOG("Error: a ladder rendition must have the intra period, intra refresh type, hierarchical levels and prediction structure of its leader\n");
+        return EB_ErrorBadParameter;
+    }
+
+    if (leader_handle_ptr->ladder_ptr == (EbLadderContext*)EB_NULL) {
+        return_error = eb_ladder_context_ctor(&leader_handle_ptr->ladder_ptr);
+        if (return_error != EB_ErrorNone)
+            return return_error;
+        leader_encode_context_ptr->ladder_ptr = leader_handle_ptr->ladder_ptr;
+    }
+
+    return_error = eb_ladder_rendition_attach(leader_handle_ptr->ladder_ptr, &enc_handle_ptr->ladder_rendition_ptr);
+    if (return_error != EB_ErrorNone)
+        return return_error;
+    encode_context_ptr->ladder_rendition_ptr = enc_handle_ptr->ladder_rendition_ptr;
+
+    return EB_ErrorNone;
+}
+
+/**********************************
+* Set Pass Statistics
+**********************************/
+#if defined(__linux__) || defined(__APPLE__)
+__attribute__((visibility("default")))
+#endif
+EB_API EbErrorType eb_svt_enc_set_pass_stats(
+    EbComponentType              *svt_enc_component,
+    const uint8_t                *stats,
+    uint64_t                      size)
+{
+    EbEncHandle *enc_handle_ptr;
+
+    if (svt_enc_component == NULL || stats == NULL || size == 0)
+        return EB_ErrorBadParameter;
+
+    enc_handle_ptr = (EbEncHandle*)svt_enc_component->p_component_private;
+    enc_handle_ptr->pass_stats_buffer = stats;
+    enc_handle_ptr->pass_stats_size = size;
+
+    return EB_ErrorNone;
+}
 #if defined(__linux__) || defined(__APPLE__)
 __attribute__((visibility("default")))
 #endif
@@ -3281,8 +4020,8 @@ static EbErrorType CopyFrameBuffer(
             //efficient copy - final
             //compressed 2Bit in 1D format
             {
-                uint16_t luma2BitWidth = sequence_control_set_ptr->max_input_luma_width / 4;
-                uint16_t lumaHeight = sequence_control_set_ptr->max_input_luma_height;
+                uint16_t luma2BitWidth = input_picture_ptr->width / 4;
+                uint16_t lumaHeight = input_picture_ptr->height;
 
                 uint16_t sourceLuma2BitStride = sourceLumaStride / 4;
                 uint16_t sourceChroma2BitStride = sourceLuma2BitStride >> 1;
@@ -3349,10 +4088,63 @@ static EbErrorType CopyFrameBuffer(
     }
     return return_error;
 }
+/***********************************************
+**** Point the library picture descriptor at the
+**** application planes (zero-copy input). The
+**** application border receives the padding.
+************************************************/
+static void AliasFrameBuffer(
+    SequenceControlSet            *sequence_control_set_ptr,
+    EbBufferHeaderType            *dst,
+    EbBufferHeaderType            *src)
+{
+    EbPictureBufferDesc           *input_picture_ptr = (EbPictureBufferDesc*)dst->p_buffer;
+    EbSvtIOFormat                 *inputPtr = (EbSvtIOFormat*)src->p_buffer;
+    uint32_t                       lumaBufferOffset = inputPtr->y_stride * sequence_control_set_ptr->top_padding + sequence_control_set_ptr->left_padding;
+    uint32_t                       chromaBufferOffset = inputPtr->cb_stride * (sequence_control_set_ptr->top_padding >> 1) + (sequence_control_set_ptr->left_padding >> 1);
+
+    input_picture_ptr->buffer_y = inputPtr->luma - lumaBufferOffset;
+    input_picture_ptr->buffer_cb = inputPtr->cb - chromaBufferOffset;
+    input_picture_ptr->buffer_cr = inputPtr->cr - chromaBufferOffset;
+    input_picture_ptr->stride_y = (uint16_t)inputPtr->y_stride;
+    input_picture_ptr->stride_cb = (uint16_t)inputPtr->cb_stride;
+    input_picture_ptr->stride_cr = (uint16_t)inputPtr->cr_stride;
+
+    // Keep the application header until the release callback
+    dst->wrapper_ptr = (void*)src;
+}
+
+/***********************************************
+**** Check that an application picture can be
+**** referenced in place
+************************************************/
+static EbErrorType CheckZeroCopyInputBuffer(
+    SequenceControlSet            *sequence_control_set_ptr,
+    EbBufferHeaderType            *src)
+{
+    EbSvtIOFormat                 *inputPtr = (EbSvtIOFormat*)src->p_buffer;
+    uint32_t                       minLumaStride = sequence_control_set_ptr->max_input_luma_width + sequence_control_set_ptr->left_padding + sequence_control_set_ptr->right_padding;
+
+    if (sequence_control_set_ptr->left_padding > EB_INPUT_BUFFER_BORDER || sequence_control_set_ptr->top_padding > EB_INPUT_BUFFER_BORDER ||
+        sequence_control_set_ptr->right_padding > EB_INPUT_BUFFER_BORDER || sequence_control_set_ptr->bot_padding > EB_INPUT_BUFFER_BORDER)
+        return EB_ErrorBadParameter;
+    if (inputPtr->luma == NULL || inputPtr->cb == NULL || inputPtr->cr == NULL)
+        return EB_ErrorBadParameter;
+    if (inputPtr->y_stride < minLumaStride || inputPtr->y_stride > 0xFFFF)
+        return EB_ErrorBadParameter;
+    if (inputPtr->cb_stride != inputPtr->cr_stride || inputPtr->cb_stride < (minLumaStride >> 1))
+        return EB_ErrorBadParameter;
+
+    return EB_ErrorNone;
+}
+
 static void CopyInputBuffer(
     SequenceControlSet*    sequenceControlSet,
     EbBufferHeaderType*     dst,
-    EbBufferHeaderType*     src
+    EbBufferHeaderType*     src,
+    EbBool                  zero_copy,
+    uint32_t                source_width,
+    uint32_t                source_height
 )
 {
     // Copy the higher level structure
@@ -3365,9 +4157,18 @@ static void CopyInputBuffer(
     dst->qp = src->qp;
     dst->pic_type = src->pic_type;
 
+    // Size of the picture, see eb_svt_enc_reconfigure(). The padding is only
+    // set for the configured size, which is then never changed
+    ((EbPictureBufferDesc*)dst->p_buffer)->width = (uint16_t)(source_width + sequenceControlSet->max_input_pad_right);
+    ((EbPictureBufferDesc*)dst->p_buffer)->height = (uint16_t)(source_height + sequenceControlSet->max_input_pad_bottom);
+
     // Copy the picture buffer
-    if (src->p_buffer != NULL)
-        CopyFrameBuffer(sequenceControlSet, dst->p_buffer, src->p_buffer);
+    if (src->p_buffer != NULL) {
+        if (zero_copy)
+            AliasFrameBuffer(sequenceControlSet, dst, src);
+        else
+            CopyFrameBuffer(sequenceControlSet, dst->p_buffer, src->p_buffer);
+    }
 }
 
 /**********************************
@@ -3381,7 +4182,18 @@ EB_API EbErrorType eb_svt_enc_send_picture(
     EbBufferHeaderType   *p_buffer)
 {
     EbEncHandle          *enc_handle_ptr = (EbEncHandle*)svt_enc_component->p_component_private;
+    SequenceControlSet   *sequence_control_set_ptr = enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr;
     EbObjectWrapper      *ebWrapperPtr;
+    EbBool                zero_copy = EB_FALSE;
+    uint32_t              source_width;
+    uint32_t              source_height;
+
+    // Only 8-bit pictures are referenced in place, 10-bit ones need unpacking
+    if (enc_handle_ptr->release_input_buffer && p_buffer != NULL && p_buffer->p_buffer != NULL) {
+        zero_copy = (EbBool)(sequence_control_set_ptr->static_config.encoder_bit_depth == EB_8BIT);
+        if (zero_copy && CheckZeroCopyInputBuffer(sequence_control_set_ptr, p_buffer) != EB_ErrorNone)
+            return EB_ErrorBadParameter;
+    }
 
     // Take the buffer and put it into our internal queue structure
     eb_get_empty_object(
@@ -3389,16 +4201,243 @@ EB_API EbErrorType eb_svt_enc_send_picture(
         &ebWrapperPtr);
 
     if (p_buffer != NULL) {
+        // Both dimensions from the same eb_svt_enc_reconfigure() call
+        eb_block_on_mutex(enc_handle_ptr->sequence_control_set_instance_array[0]->config_mutex);
+        source_width = sequence_control_set_ptr->static_config.source_width;
+        source_height = sequence_control_set_ptr->static_config.source_height;
+        eb_release_mutex(enc_handle_ptr->sequence_control_set_instance_array[0]->config_mutex);
+
         CopyInputBuffer(
-            enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr,
+            sequence_control_set_ptr,
             (EbBufferHeaderType*)ebWrapperPtr->object_ptr,
-            p_buffer);
+            p_buffer,
+            zero_copy,
+            source_width,
+            source_height);
     }
 
     eb_post_full_object(ebWrapperPtr);
 
+    // Copied pictures are not referenced by the library anymore
+    if (enc_handle_ptr->release_input_buffer && !zero_copy && p_buffer != NULL && p_buffer->p_buffer != NULL)
+        enc_handle_ptr->release_input_buffer(p_buffer, enc_handle_ptr->input_buffer_priv_data);
+
+    return EB_ErrorNone;
+}
+
+/**********************************
+* Zero-copy input callbacks
+**********************************/
+#if defined(__linux__) || defined(__APPLE__)
+__attribute__((visibility("default")))
+#endif
+EB_API EbErrorType eb_svt_enc_set_input_buffer_callbacks(
+    EbComponentType             *svt_enc_component,
+    eb_release_input_buffer      release_buffer,
+    void                        *priv_data)
+{
+    EbEncHandle *enc_handle_ptr;
+
+    if (svt_enc_component == NULL || release_buffer == NULL)
+        return EB_ErrorBadParameter;
+
+    enc_handle_ptr = (EbEncHandle*)svt_enc_component->p_component_private;
+    enc_handle_ptr->release_input_buffer = release_buffer;
+    enc_handle_ptr->input_buffer_priv_data = priv_data;
+
+    return EB_ErrorNone;
+}
+
+/**********************************
+* Host Context
+**********************************/
+#if defined(__linux__) || defined(__APPLE__)
+__attribute__((visibility("default")))
+#endif
+EB_API EbErrorType eb_svt_host_context_create(
+    EbSvtHostContext               **host_context,
+    const EbSvtHostConfiguration    *config_ptr)
+{
+    uint32_t worker_count;
+
+    if (host_context == NULL || config_ptr == NULL)
+        return EB_ErrorBadParameter;
+
+    if (InitThreadManagmentParams() != EB_ErrorNone)
+        return EB_ErrorInsufficientResources;
+    worker_count = config_ptr->worker_count ? config_ptr->worker_count : GetNumProcessors();
+
+    return eb_host_context_ctor(host_context, worker_count, config_ptr->channel_count, config_ptr->max_thread_count);
+}
+
+#if defined(__linux__) || defined(__APPLE__)
+__attribute__((visibility("default")))
+#endif
+EB_API EbErrorType eb_svt_enc_attach_host_context(
+    EbComponentType         *svt_enc_component,
+    EbSvtHostContext        *host_context,
+    uint32_t                 weight)
+{
+    EbEncHandle *enc_handle_ptr;
+
+    if (svt_enc_component == NULL || host_context == NULL)
+        return EB_ErrorBadParameter;
+
+    enc_handle_ptr = (EbEncHandle*)svt_enc_component->p_component_private;
+    if (enc_handle_ptr->host_channel_ptr) {
+        SVT_LOG("Error: the encoder is already attached to a host context\n");
+        return EB_ErrorBadParameter;
+    }
+
+    return eb_host_channel_attach(host_context, weight, &enc_handle_ptr->host_channel_ptr);
+}
+
+#if defined(__linux__) || defined(__APPLE__)
+__attribute__((visibility("default")))
+#endif
+EB_API EbErrorType eb_svt_host_context_destroy(
+    EbSvtHostContext        *host_context)
+{
+    EbErrorType return_error;
+
+    if (host_context == NULL)
+        return EB_ErrorBadParameter;
+
+    return_error = eb_host_context_dtor(host_context);
+    if (return_error != EB_ErrorNone)
+        SVT_LOG("Error: host context destroyed before the encoders attached to it\n");
+
+    return return_error;
+}
+
+/**********************************
+* Kernel Dispatch
+**********************************/
+#if defined(__linux__) || defined(__APPLE__)
+__attribute__((visibility("default")))
+#endif
+EB_API const char *eb_svt_kernel_name(
+    uint32_t                 index)
+{
+    return eb_kernel_dispatch_name(index);
+}
+
+#if defined(__linux__) || defined(__APPLE__)
+__attribute__((visibility("default")))
+#endif
+EB_API EbErrorType eb_svt_kernel_query(
+    const char              *kernel_name,
+    EbKernelIsa             *isa_ptr,
+    uint32_t                *available_mask)
+{
+    eb_kernel_dispatch_init(GetCpuAsmType(), GetCpuAsmType());
+    return eb_kernel_dispatch_query(kernel_name, isa_ptr, available_mask);
+}
+
+#if defined(__linux__) || defined(__APPLE__)
+__attribute__((visibility("default")))
+#endif
+EB_API EbErrorType eb_svt_kernel_override(
+    const char              *kernel_name,
+    EbKernelIsa              isa)
+{
+    eb_kernel_dispatch_init(GetCpuAsmType(), GetCpuAsmType());
+    return eb_kernel_dispatch_override(kernel_name, isa);
+}
+
+/**********************************
+* Memory Usage
+**********************************/
+#if defined(__linux__) || defined(__APPLE__)
+__attribute__((visibility("default")))
+#endif
+EB_API EbErrorType eb_svt_enc_get_memory_usage(
+    EbComponentType      *svt_enc_component,
+    EbMemoryUsage        *memory_usage)
+{
+    EbEncHandle *enc_handle_ptr;
+
+    if (svt_enc_component == NULL || memory_usage == NULL)
+        return EB_ErrorBadParameter;
+
+    enc_handle_ptr = (EbEncHandle*)svt_enc_component->p_component_private;
+    EB_MEMCPY(memory_usage, &enc_handle_ptr->memory_usage, sizeof(EbMemoryUsage));
+
     return EB_ErrorNone;
 }
+
+/**********************************
+* Thread Scheduling
+**********************************/
+#if defined(__linux__) || defined(__APPLE__)
+__attribute__((visibility("default")))
+#endif
+EB_API EbErrorType eb_svt_enc_get_thread_priority(
+    EbComponentType         *svt_enc_component,
+    EbStageThreadPriority   *stage_priority_array)
+{
+    EbEncHandle *enc_handle_ptr;
+
+    if (svt_enc_component == NULL || stage_priority_array == NULL)
+        return EB_ErrorBadParameter;
+
+    enc_handle_ptr = (EbEncHandle*)svt_enc_component->p_component_private;
+    EB_MEMCPY(stage_priority_array, enc_handle_ptr->stage_thread_priority, sizeof(enc_handle_ptr->stage_thread_priority));
+
+    return EB_ErrorNone;
+}
+
+/**********************************
+* Pipeline Statistics
+**********************************/
+#if defined(__linux__) || defined(__APPLE__)
+__attribute__((visibility("default")))
+#endif
+EB_API EbErrorType eb_svt_enc_get_stats(
+    EbComponentType      *svt_enc_component,
+    EbSvtAv1EncStats     *stats)
+{
+    EbEncHandle *enc_handle_ptr;
+
+    if (svt_enc_component == NULL || stats == NULL)
+        return EB_ErrorBadParameter;
+
+    enc_handle_ptr = (EbEncHandle*)svt_enc_component->p_component_private;
+    if (enc_handle_ptr->pipeline_stats_ptr == NULL)
+        return EB_ErrorBadParameter;
+
+    eb_pipeline_stats_get(enc_handle_ptr->pipeline_stats_ptr, stats);
+
+    return EB_ErrorNone;
+}
+
+#if defined(__linux__) || defined(__APPLE__)
+__attribute__((visibility("default")))
+#endif
+EB_API EbErrorType eb_svt_enc_write_trace(
+    EbComponentType      *svt_enc_component,
+    const char           *file_name)
+{
+    EbEncHandle *enc_handle_ptr;
+    EbErrorType  return_error;
+    FILE        *trace_file;
+
+    if (svt_enc_component == NULL || file_name == NULL)
+        return EB_ErrorBadParameter;
+
+    enc_handle_ptr = (EbEncHandle*)svt_enc_component->p_component_private;
+    if (enc_handle_ptr->pipeline_stats_ptr == NULL || enc_handle_ptr->pipeline_stats_ptr->trace_event_array == NULL)
+        return EB_ErrorBadParameter;
+
+    FOPEN(trace_file, file_name, "w");
+    if (trace_file == NULL)
+        return EB_ErrorBadParameter;
+
+    return_error = eb_pipeline_stats_write_trace(enc_handle_ptr->pipeline_stats_ptr, trace_file);
+    fclose(trace_file);
+
+    return return_error;
+}
 static void CopyOutputReconBuffer(
     EbBufferHeaderType   *dst,
     EbBufferHeaderType   *src
@@ -3448,14 +4487,19 @@ EB_API EbErrorType eb_svt_get_packet(
 
         packet = (EbBufferHeaderType*)ebWrapperPtr->object_ptr;
 
-        if (packet->flags != EB_BUFFERFLAG_EOS &&
-            packet->flags != EB_BUFFERFLAG_SHOW_EXT &&
-            packet->flags != EB_BUFFERFLAG_HAS_TD &&
-            packet->flags != (EB_BUFFERFLAG_SHOW_EXT | EB_BUFFERFLAG_EOS) &&
-            packet->flags != (EB_BUFFERFLAG_SHOW_EXT | EB_BUFFERFLAG_HAS_TD) &&
-            packet->flags != (EB_BUFFERFLAG_SHOW_EXT | EB_BUFFERFLAG_HAS_TD | EB_BUFFERFLAG_EOS) &&
-            packet->flags != (EB_BUFFERFLAG_HAS_TD | EB_BUFFERFLAG_EOS) &&
-            packet->flags != 0) {
+        // EB_BUFFERFLAG_LAST_FRAGMENT goes with any of the flags below
+        const uint32_t flags = packet->flags & ~(uint32_t)EB_BUFFERFLAG_LAST_FRAGMENT;
+
+        if (flags != EB_BUFFERFLAG_EOS &&
+            flags != EB_BUFFERFLAG_SHOW_EXT &&
+            flags != EB_BUFFERFLAG_HAS_TD &&
+            flags != (EB_BUFFERFLAG_SHOW_EXT | EB_BUFFERFLAG_EOS) &&
+            flags != (EB_BUFFERFLAG_SHOW_EXT | EB_BUFFERFLAG_HAS_TD) &&
+            flags != (EB_BUFFERFLAG_SHOW_EXT | EB_BUFFERFLAG_HAS_TD | EB_BUFFERFLAG_EOS) &&
+            flags != (EB_BUFFERFLAG_HAS_TD | EB_BUFFERFLAG_EOS) &&
+            flags != EB_BUFFERFLAG_PASS_STATS &&
+            flags != (EB_BUFFERFLAG_PASS_STATS | EB_BUFFERFLAG_EOS) &&
+            flags != 0) {
             return_error = EB_ErrorMax;
         }
 
@@ -3574,8 +4618,6 @@ EbErrorType init_svt_av1_encoder_handle(
     printf("LIB Build date: %s %s\n", __DATE__, __TIME__);
     printf("-------------------------------------------\n");
 
-    SwitchToRealTime();
-
     // Set Component Size & Version
     svt_enc_component->size = sizeof(EbComponentType);
 
@@ -3588,7 +4630,8 @@ EbErrorType init_svt_av1_encoder_handle(
 }
 static EbErrorType allocate_frame_buffer(
     SequenceControlSet       *sequence_control_set_ptr,
-    EbBufferHeaderType        *inputBuffer)
+    EbBufferHeaderType        *inputBuffer,
+    EbBool                     zero_copy)
 {
     EbErrorType   return_error = EB_ErrorNone;
     EbPictureBufferDescInitData input_picture_buffer_desc_init_data;
@@ -3616,6 +4659,10 @@ static EbErrorType allocate_frame_buffer(
 
     input_picture_buffer_desc_init_data.buffer_enable_mask = PICTURE_BUFFER_DESC_FULL_MASK;
 
+    // Zero-copy 8-bit pictures point the descriptor at the application planes
+    if (zero_copy && !is16bit)
+        input_picture_buffer_desc_init_data.buffer_enable_mask = 0;
+
     if (is16bit && config->compressed_ten_bit_format == 1) {
         input_picture_buffer_desc_init_data.split_mode = EB_FALSE;  //do special allocation for 2bit data down below.
     }
@@ -3646,7 +4693,8 @@ EbErrorType EbInputBufferHeaderCtor(
     EbPtr  objectInitDataPtr)
 {
     EbBufferHeaderType* inputBuffer;
-    SequenceControlSet        *sequence_control_set_ptr = (SequenceControlSet*)objectInitDataPtr;
+    EbEncHandle               *enc_handle_ptr = (EbEncHandle*)objectInitDataPtr;
+    SequenceControlSet        *sequence_control_set_ptr = enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr;
     EB_MALLOC(EbBufferHeaderType*, inputBuffer, sizeof(EbBufferHeaderType), EB_N_PTR);
     *objectDblPtr = (EbPtr)inputBuffer;
     // Initialize Header
@@ -3654,13 +4702,34 @@ EbErrorType EbInputBufferHeaderCtor(
 
     allocate_frame_buffer(
         sequence_control_set_ptr,
-        inputBuffer);
+        inputBuffer,
+        (EbBool)(enc_handle_ptr->release_input_buffer != EB_NULL));
 
     inputBuffer->p_app_private = NULL;
+    // Application header referenced in zero-copy mode
+    inputBuffer->wrapper_ptr = NULL;
 
     return EB_ErrorNone;
 }
 
+/**************************************
+* Zero-copy input release hook, called when
+* the last pipeline stage releases the
+* input buffer header
+**************************************/
+static void ReleaseZeroCopyInputBuffer(
+    EbPtr object_ptr,
+    EbPtr callback_data)
+{
+    EbEncHandle          *enc_handle_ptr = (EbEncHandle*)callback_data;
+    EbBufferHeaderType   *inputBuffer = (EbBufferHeaderType*)object_ptr;
+    EbBufferHeaderType   *appBuffer = (EbBufferHeaderType*)inputBuffer->wrapper_ptr;
+
+    inputBuffer->wrapper_ptr = NULL;
+    if (appBuffer)
+        enc_handle_ptr->release_input_buffer(appBuffer, enc_handle_ptr->input_buffer_priv_data);
+}
+
 /**************************************
 * EbBufferHeaderType Constructor
 **************************************/
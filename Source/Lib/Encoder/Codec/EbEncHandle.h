@@ -11,11 +11,23 @@
 #include "EbPictureBufferDesc.h"
 #include "EbSystemResourceManager.h"
 #include "EbSequenceControlSet.h"
+#include "EbPipelineStats.h"
+#include "EbHostContext.h"
+#include "EbLadderContext.h"
 
 #include "EbResourceCoordinationResults.h"
 #include "EbPictureDemuxResults.h"
 #include "EbRateControlResults.h"
 
+/**************************************
+ * Scheduling applied by a kernel thread
+ **************************************/
+typedef struct EbKernelThreadPriority
+{
+    EbPipelineStage                           stage;
+    EbThreadPriority                          applied;
+} EbKernelThreadPriority;
+
 /**************************************
  * Component Private Data
  **************************************/
@@ -159,6 +171,36 @@ typedef struct EbEncHandle
     // Callbacks
     EbCallback                          **app_callback_ptr_array;
 
+    // Pipeline Statistics
+    EbPipelineStats                        *pipeline_stats_ptr;
+
+    // Thread scheduling, per EbPipelineStage and per kernel thread
+    EbStageThreadPriority                   stage_thread_priority[EB_PIPELINE_STAGE_COUNT];
+    EbKernelThreadPriority                 *kernel_thread_priority_array;
+    uint32_t                                kernel_thread_count;
+
+    // Allocations of eb_init_encoder(), per EbMemoryCategory
+    EbMemoryUsage                           memory_usage;
+
+    // Zero-copy input
+    eb_release_input_buffer                 release_input_buffer;
+    void                                   *input_buffer_priv_data;
+
+    // Shared workers, NULL when not attached to a host context
+    EbHostChannel                          *host_channel_ptr;
+
+    // ABR ladder, see eb_svt_enc_attach_ladder(): the context when leading,
+    // the rendition when following, NULL otherwise
+    EbLadderContext                        *ladder_ptr;
+    EbLadderRendition                      *ladder_rendition_ptr;
+
+    // Runs on the kernels of the process, see eb_kernel_dispatch_attach()
+    EbBool                                  kernel_dispatch_attached;
+
+    // First pass statistics of a second pass, read by eb_init_encoder()
+    const uint8_t                          *pass_stats_buffer;
+    uint64_t                                pass_stats_size;
+
     // Memory Map
 #if MEM_MAP_OPT
     EbMemoryMapEntry                       *memory_map_init_address;
@@ -166,6 +208,7 @@ typedef struct EbEncHandle
     EbMemoryMapEntry                       *memory_map;
     uint32_t                                memory_map_index;
     uint64_t                                total_lib_memory;
+    EbNumaPlacement                         numa_placement;
 
 } EbEncHandle;
 
@@ -0,0 +1,851 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+#include "EbKernelDispatch.h"
+#include "EbThreads.h"
+
+#define RTCD_C
+#include "aom_dsp_rtcd.h"
+
+void asmSetConvolveAsmTable(void);
+void asmSetConvolveHbdAsmTable(void);
+void init_intra_dc_predictors_c_internal(void);
+void init_intra_predictors_internal(void);
+void av1_init_me_luts(void);
+void init_fn_ptr(void);
+
+typedef void(*EbKernelFn)(void);
+
+typedef struct KernelEntry
+{
+    const char               *name;
+    EbKernelFn               *pointer;
+} KernelEntry;
+
+#define KERNEL(name) { #name, (EbKernelFn*)&name }
+
+// Every pointer set by setup_rtcd_flags()
+static const KernelEntry kernel_table[] = {
+    KERNEL(apply_selfguided_restoration),
+    KERNEL(av1_wiener_convolve_add_src),
+    KERNEL(av1_highbd_wiener_convolve_add_src),
+    KERNEL(av1_selfguided_restoration),
+    KERNEL(cdef_find_dir),
+    KERNEL(cdef_filter_block),
+    KERNEL(compute_cdef_dist),
+    KERNEL(copy_rect8_8bit_to_16bit),
+    KERNEL(av1_compute_stats),
+    KERNEL(av1_compute_stats_highbd),
+    KERNEL(av1_lowbd_pixel_proj_error),
+    KERNEL(av1_highbd_pixel_proj_error),
+    KERNEL(av1_filter_intra_edge_high),
+    KERNEL(av1_highbd_convolve_2d_copy_sr),
+    KERNEL(av1_highbd_jnt_convolve_2d_copy),
+    KERNEL(av1_highbd_convolve_y_sr),
+    KERNEL(av1_highbd_convolve_2d_sr),
+    KERNEL(av1_highbd_jnt_convolve_2d),
+    KERNEL(av1_highbd_jnt_convolve_x),
+    KERNEL(av1_highbd_jnt_convolve_y),
+    KERNEL(av1_highbd_convolve_x_sr),
+    KERNEL(subtract_average),
+    KERNEL(av1_filter_intra_edge),
+    KERNEL(eb_smooth_v_predictor),
+    KERNEL(eb_smooth_h_predictor),
+    KERNEL(get_proj_subspace),
+    KERNEL(search_one_dual),
+    KERNEL(aom_mse16x16),
+    KERNEL(av1_convolve_2d_copy_sr),
+    KERNEL(av1_convolve_2d_sr),
+    KERNEL(av1_jnt_convolve_2d_copy),
+    KERNEL(av1_convolve_x_sr),
+    KERNEL(av1_convolve_y_sr),
+    KERNEL(av1_jnt_convolve_x),
+    KERNEL(av1_jnt_convolve_y),
+    KERNEL(av1_jnt_convolve_2d),
+    KERNEL(aom_quantize_b),
+    KERNEL(aom_quantize_b_32x32),
+    KERNEL(aom_highbd_quantize_b_32x32),
+    KERNEL(aom_highbd_quantize_b),
+    KERNEL(av1_inv_txfm2d_add_16x16),
+    KERNEL(av1_inv_txfm2d_add_32x32),
+    KERNEL(av1_inv_txfm2d_add_4x4),
+    KERNEL(av1_inv_txfm2d_add_64x64),
+    KERNEL(av1_inv_txfm2d_add_8x8),
+    KERNEL(av1_inv_txfm2d_add_8x16),
+    KERNEL(av1_inv_txfm2d_add_16x8),
+    KERNEL(av1_inv_txfm2d_add_16x32),
+    KERNEL(av1_inv_txfm2d_add_32x16),
+    KERNEL(av1_inv_txfm2d_add_32x8),
+    KERNEL(av1_inv_txfm2d_add_8x32),
+    KERNEL(av1_inv_txfm2d_add_32x64),
+    KERNEL(av1_inv_txfm2d_add_64x32),
+    KERNEL(av1_inv_txfm2d_add_16x64),
+    KERNEL(av1_inv_txfm2d_add_64x16),
+    KERNEL(av1_inv_txfm2d_add_4x8),
+    KERNEL(av1_inv_txfm2d_add_8x4),
+    KERNEL(av1_inv_txfm2d_add_4x16),
+    KERNEL(av1_inv_txfm2d_add_16x4),
+    KERNEL(av1_inv_txfm_add),
+    KERNEL(highbd_variance64),
+    KERNEL(aom_highbd_8_mse16x16),
+    KERNEL(av1_upsample_intra_edge),
+    KERNEL(aom_highbd_smooth_v_predictor_16x16),
+    KERNEL(aom_highbd_smooth_v_predictor_16x32),
+    KERNEL(aom_highbd_smooth_v_predictor_16x4),
+    KERNEL(aom_highbd_smooth_v_predictor_16x64),
+    KERNEL(aom_highbd_smooth_v_predictor_16x8),
+    KERNEL(aom_highbd_smooth_v_predictor_2x2),
+    KERNEL(aom_highbd_smooth_v_predictor_32x16),
+    KERNEL(aom_highbd_smooth_v_predictor_32x32),
+    KERNEL(aom_highbd_smooth_v_predictor_32x64),
+    KERNEL(aom_highbd_smooth_v_predictor_32x8),
+    KERNEL(aom_highbd_smooth_v_predictor_4x16),
+    KERNEL(aom_highbd_smooth_v_predictor_4x4),
+    KERNEL(aom_highbd_smooth_v_predictor_4x8),
+    KERNEL(aom_highbd_smooth_v_predictor_64x16),
+    KERNEL(aom_highbd_smooth_v_predictor_64x32),
+    KERNEL(aom_highbd_smooth_v_predictor_64x64),
+    KERNEL(aom_highbd_smooth_v_predictor_8x16),
+    KERNEL(aom_highbd_smooth_v_predictor_8x32),
+    KERNEL(aom_highbd_smooth_v_predictor_8x4),
+    KERNEL(aom_highbd_smooth_v_predictor_8x8),
+    KERNEL(cfl_predict_lbd),
+    KERNEL(cfl_predict_hbd),
+    KERNEL(av1_dr_prediction_z1),
+    KERNEL(av1_dr_prediction_z2),
+    KERNEL(av1_dr_prediction_z3),
+    KERNEL(av1_highbd_dr_prediction_z1),
+    KERNEL(av1_highbd_dr_prediction_z2),
+    KERNEL(av1_highbd_dr_prediction_z3),
+    KERNEL(av1_get_nz_map_contexts),
+    KERNEL(ResidualKernel),
+    KERNEL(av1_txb_init_levels),
+    KERNEL(aom_paeth_predictor_16x16),
+    KERNEL(aom_paeth_predictor_16x32),
+    KERNEL(aom_paeth_predictor_16x4),
+    KERNEL(aom_paeth_predictor_16x64),
+    KERNEL(aom_paeth_predictor_16x8),
+    KERNEL(aom_paeth_predictor_32x16),
+    KERNEL(aom_paeth_predictor_32x32),
+    KERNEL(aom_paeth_predictor_32x64),
+    KERNEL(aom_paeth_predictor_32x8),
+    KERNEL(aom_paeth_predictor_4x16),
+    KERNEL(aom_paeth_predictor_4x4),
+    KERNEL(aom_paeth_predictor_4x8),
+    KERNEL(aom_paeth_predictor_64x16),
+    KERNEL(aom_paeth_predictor_64x32),
+    KERNEL(aom_paeth_predictor_64x64),
+    KERNEL(aom_paeth_predictor_8x16),
+    KERNEL(aom_paeth_predictor_8x32),
+    KERNEL(aom_paeth_predictor_8x4),
+    KERNEL(aom_paeth_predictor_8x8),
+    KERNEL(aom_highbd_paeth_predictor_16x16),
+    KERNEL(aom_highbd_paeth_predictor_16x32),
+    KERNEL(aom_highbd_paeth_predictor_16x4),
+    KERNEL(aom_highbd_paeth_predictor_16x64),
+    KERNEL(aom_highbd_paeth_predictor_16x8),
+    KERNEL(aom_highbd_paeth_predictor_2x2),
+    KERNEL(aom_highbd_paeth_predictor_32x16),
+    KERNEL(aom_highbd_paeth_predictor_32x32),
+    KERNEL(aom_highbd_paeth_predictor_32x64),
+    KERNEL(aom_highbd_paeth_predictor_32x8),
+    KERNEL(aom_highbd_paeth_predictor_4x16),
+    KERNEL(aom_highbd_paeth_predictor_4x4),
+    KERNEL(aom_highbd_paeth_predictor_4x8),
+    KERNEL(aom_highbd_paeth_predictor_64x16),
+    KERNEL(aom_highbd_paeth_predictor_64x32),
+    KERNEL(aom_highbd_paeth_predictor_64x64),
+    KERNEL(aom_highbd_paeth_predictor_8x16),
+    KERNEL(aom_highbd_paeth_predictor_8x32),
+    KERNEL(aom_highbd_paeth_predictor_8x4),
+    KERNEL(aom_highbd_paeth_predictor_8x8),
+    KERNEL(aom_dc_predictor_4x4),
+    KERNEL(aom_dc_predictor_8x8),
+    KERNEL(aom_dc_predictor_16x16),
+    KERNEL(aom_dc_predictor_32x32),
+    KERNEL(aom_dc_predictor_64x64),
+    KERNEL(aom_dc_predictor_32x16),
+    KERNEL(aom_dc_predictor_32x64),
+    KERNEL(aom_dc_predictor_64x16),
+    KERNEL(aom_dc_predictor_8x16),
+    KERNEL(aom_dc_predictor_8x32),
+    KERNEL(aom_dc_predictor_8x4),
+    KERNEL(aom_dc_predictor_64x32),
+    KERNEL(aom_dc_predictor_16x32),
+    KERNEL(aom_dc_predictor_16x4),
+    KERNEL(aom_dc_predictor_16x64),
+    KERNEL(aom_dc_predictor_16x8),
+    KERNEL(aom_dc_predictor_32x8),
+    KERNEL(aom_dc_predictor_4x16),
+    KERNEL(aom_dc_predictor_4x8),
+    KERNEL(aom_dc_top_predictor_4x4),
+    KERNEL(aom_dc_top_predictor_8x8),
+    KERNEL(aom_dc_top_predictor_16x16),
+    KERNEL(aom_dc_top_predictor_32x32),
+    KERNEL(aom_dc_top_predictor_64x64),
+    KERNEL(aom_dc_top_predictor_16x32),
+    KERNEL(aom_dc_top_predictor_16x4),
+    KERNEL(aom_dc_top_predictor_16x64),
+    KERNEL(aom_dc_top_predictor_16x8),
+    KERNEL(aom_dc_top_predictor_32x16),
+    KERNEL(aom_dc_top_predictor_32x64),
+    KERNEL(aom_dc_top_predictor_32x8),
+    KERNEL(aom_dc_top_predictor_4x16),
+    KERNEL(aom_dc_top_predictor_4x8),
+    KERNEL(aom_dc_top_predictor_64x16),
+    KERNEL(aom_dc_top_predictor_64x32),
+    KERNEL(aom_dc_top_predictor_8x16),
+    KERNEL(aom_dc_top_predictor_8x32),
+    KERNEL(aom_dc_top_predictor_8x4),
+    KERNEL(aom_dc_left_predictor_4x4),
+    KERNEL(aom_dc_left_predictor_8x8),
+    KERNEL(aom_dc_left_predictor_16x16),
+    KERNEL(aom_dc_left_predictor_32x32),
+    KERNEL(aom_dc_left_predictor_64x64),
+    KERNEL(aom_dc_left_predictor_16x32),
+    KERNEL(aom_dc_left_predictor_16x4),
+    KERNEL(aom_dc_left_predictor_16x64),
+    KERNEL(aom_dc_left_predictor_16x8),
+    KERNEL(aom_dc_left_predictor_32x16),
+    KERNEL(aom_dc_left_predictor_32x64),
+    KERNEL(aom_dc_left_predictor_64x16),
+    KERNEL(aom_dc_left_predictor_64x32),
+    KERNEL(aom_dc_left_predictor_32x8),
+    KERNEL(aom_dc_left_predictor_4x16),
+    KERNEL(aom_dc_left_predictor_4x8),
+    KERNEL(aom_dc_left_predictor_8x16),
+    KERNEL(aom_dc_left_predictor_8x32),
+    KERNEL(aom_dc_left_predictor_8x4),
+    KERNEL(aom_dc_128_predictor_4x4),
+    KERNEL(aom_dc_128_predictor_8x8),
+    KERNEL(aom_dc_128_predictor_16x16),
+    KERNEL(aom_dc_128_predictor_32x32),
+    KERNEL(aom_dc_128_predictor_64x64),
+    KERNEL(aom_dc_128_predictor_16x32),
+    KERNEL(aom_dc_128_predictor_16x4),
+    KERNEL(aom_dc_128_predictor_16x64),
+    KERNEL(aom_dc_128_predictor_16x8),
+    KERNEL(aom_dc_128_predictor_32x16),
+    KERNEL(aom_dc_128_predictor_32x64),
+    KERNEL(aom_dc_128_predictor_32x8),
+    KERNEL(aom_dc_128_predictor_4x16),
+    KERNEL(aom_dc_128_predictor_4x8),
+    KERNEL(aom_dc_128_predictor_64x16),
+    KERNEL(aom_dc_128_predictor_64x32),
+    KERNEL(aom_dc_128_predictor_8x16),
+    KERNEL(aom_dc_128_predictor_8x32),
+    KERNEL(aom_dc_128_predictor_8x4),
+    KERNEL(aom_smooth_h_predictor_16x32),
+    KERNEL(aom_smooth_h_predictor_16x4),
+    KERNEL(aom_smooth_h_predictor_16x64),
+    KERNEL(aom_smooth_h_predictor_16x8),
+    KERNEL(aom_smooth_h_predictor_32x16),
+    KERNEL(aom_smooth_h_predictor_32x64),
+    KERNEL(aom_smooth_h_predictor_32x8),
+    KERNEL(aom_smooth_h_predictor_4x16),
+    KERNEL(aom_smooth_h_predictor_4x8),
+    KERNEL(aom_smooth_h_predictor_64x16),
+    KERNEL(aom_smooth_h_predictor_64x32),
+    KERNEL(aom_smooth_h_predictor_8x16),
+    KERNEL(aom_smooth_h_predictor_8x32),
+    KERNEL(aom_smooth_h_predictor_8x4),
+    KERNEL(aom_smooth_h_predictor_64x64),
+    KERNEL(aom_smooth_h_predictor_32x32),
+    KERNEL(aom_smooth_h_predictor_16x16),
+    KERNEL(aom_smooth_h_predictor_8x8),
+    KERNEL(aom_smooth_h_predictor_4x4),
+    KERNEL(aom_smooth_v_predictor_16x32),
+    KERNEL(aom_smooth_v_predictor_16x4),
+    KERNEL(aom_smooth_v_predictor_16x64),
+    KERNEL(aom_smooth_v_predictor_16x8),
+    KERNEL(aom_smooth_v_predictor_32x16),
+    KERNEL(aom_smooth_v_predictor_32x64),
+    KERNEL(aom_smooth_v_predictor_32x8),
+    KERNEL(aom_smooth_v_predictor_4x16),
+    KERNEL(aom_smooth_v_predictor_4x8),
+    KERNEL(aom_smooth_v_predictor_64x16),
+    KERNEL(aom_smooth_v_predictor_64x32),
+    KERNEL(aom_smooth_v_predictor_8x16),
+    KERNEL(aom_smooth_v_predictor_8x32),
+    KERNEL(aom_smooth_v_predictor_8x4),
+    KERNEL(aom_smooth_v_predictor_64x64),
+    KERNEL(aom_smooth_v_predictor_32x32),
+    KERNEL(aom_smooth_v_predictor_16x16),
+    KERNEL(aom_smooth_v_predictor_8x8),
+    KERNEL(aom_smooth_v_predictor_4x4),
+    KERNEL(aom_smooth_predictor_16x32),
+    KERNEL(aom_smooth_predictor_16x4),
+    KERNEL(aom_smooth_predictor_16x64),
+    KERNEL(aom_smooth_predictor_16x8),
+    KERNEL(aom_smooth_predictor_32x16),
+    KERNEL(aom_smooth_predictor_32x64),
+    KERNEL(aom_smooth_predictor_32x8),
+    KERNEL(aom_smooth_predictor_4x16),
+    KERNEL(aom_smooth_predictor_4x8),
+    KERNEL(aom_smooth_predictor_64x16),
+    KERNEL(aom_smooth_predictor_64x32),
+    KERNEL(aom_smooth_predictor_8x16),
+    KERNEL(aom_smooth_predictor_8x32),
+    KERNEL(aom_smooth_predictor_8x4),
+    KERNEL(aom_smooth_predictor_64x64),
+    KERNEL(aom_smooth_predictor_32x32),
+    KERNEL(aom_smooth_predictor_16x16),
+    KERNEL(aom_smooth_predictor_8x8),
+    KERNEL(aom_smooth_predictor_4x4),
+    KERNEL(aom_v_predictor_4x4),
+    KERNEL(aom_v_predictor_8x8),
+    KERNEL(aom_v_predictor_16x16),
+    KERNEL(aom_v_predictor_32x32),
+    KERNEL(aom_v_predictor_64x64),
+    KERNEL(aom_v_predictor_16x32),
+    KERNEL(aom_v_predictor_16x4),
+    KERNEL(aom_v_predictor_16x64),
+    KERNEL(aom_v_predictor_16x8),
+    KERNEL(aom_v_predictor_32x16),
+    KERNEL(aom_v_predictor_32x64),
+    KERNEL(aom_v_predictor_32x8),
+    KERNEL(aom_v_predictor_4x16),
+    KERNEL(aom_v_predictor_4x8),
+    KERNEL(aom_v_predictor_64x16),
+    KERNEL(aom_v_predictor_64x32),
+    KERNEL(aom_v_predictor_8x16),
+    KERNEL(aom_v_predictor_8x32),
+    KERNEL(aom_v_predictor_8x4),
+    KERNEL(aom_h_predictor_4x4),
+    KERNEL(aom_h_predictor_8x8),
+    KERNEL(aom_h_predictor_16x16),
+    KERNEL(aom_h_predictor_32x32),
+    KERNEL(aom_h_predictor_64x64),
+    KERNEL(aom_h_predictor_16x32),
+    KERNEL(aom_h_predictor_16x4),
+    KERNEL(aom_h_predictor_16x64),
+    KERNEL(aom_h_predictor_16x8),
+    KERNEL(aom_h_predictor_32x16),
+    KERNEL(aom_h_predictor_32x64),
+    KERNEL(aom_h_predictor_32x8),
+    KERNEL(aom_h_predictor_4x16),
+    KERNEL(aom_h_predictor_4x8),
+    KERNEL(aom_h_predictor_64x16),
+    KERNEL(aom_h_predictor_64x32),
+    KERNEL(aom_h_predictor_8x16),
+    KERNEL(aom_h_predictor_8x32),
+    KERNEL(aom_h_predictor_8x4),
+    KERNEL(aom_sad4x4),
+    KERNEL(aom_sad4x4x4d),
+    KERNEL(aom_sad4x16),
+    KERNEL(aom_sad4x16x4d),
+    KERNEL(aom_sad4x8),
+    KERNEL(aom_sad4x8x4d),
+    KERNEL(aom_sad64x128),
+    KERNEL(aom_sad64x128x4d),
+    KERNEL(aom_sad64x16),
+    KERNEL(aom_sad64x16x4d),
+    KERNEL(aom_sad64x32),
+    KERNEL(aom_sad64x32x4d),
+    KERNEL(aom_sad64x64),
+    KERNEL(aom_sad64x64x4d),
+    KERNEL(aom_sad8x16),
+    KERNEL(aom_sad8x16x4d),
+    KERNEL(aom_sad8x32),
+    KERNEL(aom_sad8x32x4d),
+    KERNEL(aom_sad8x8),
+    KERNEL(aom_sad8x8x4d),
+    KERNEL(aom_sad16x4),
+    KERNEL(aom_sad16x4x4d),
+    KERNEL(aom_sad32x8),
+    KERNEL(aom_sad32x8x4d),
+    KERNEL(aom_sad16x64),
+    KERNEL(aom_sad16x64x4d),
+    KERNEL(aom_sad128x128),
+    KERNEL(aom_sad128x128x4d),
+    KERNEL(aom_sad128x64),
+    KERNEL(aom_sad128x64x4d),
+    KERNEL(aom_sad32x16),
+    KERNEL(aom_sad32x16x4d),
+    KERNEL(aom_sad16x32),
+    KERNEL(aom_sad16x32x4d),
+    KERNEL(aom_sad32x64),
+    KERNEL(aom_sad32x64x4d),
+    KERNEL(aom_sad32x32),
+    KERNEL(aom_sad32x32x4d),
+    KERNEL(aom_sad16x16),
+    KERNEL(aom_sad16x16x4d),
+    KERNEL(aom_sad16x8),
+    KERNEL(aom_sad16x8x4d),
+    KERNEL(aom_sad8x4),
+    KERNEL(aom_sad8x4x4d),
+    KERNEL(aom_variance4x4),
+    KERNEL(aom_variance4x8),
+    KERNEL(aom_variance4x16),
+    KERNEL(aom_variance8x4),
+    KERNEL(aom_variance8x8),
+    KERNEL(aom_variance8x16),
+    KERNEL(aom_variance8x32),
+    KERNEL(aom_variance16x4),
+    KERNEL(aom_variance16x8),
+    KERNEL(aom_variance16x16),
+    KERNEL(aom_variance16x32),
+    KERNEL(aom_variance16x64),
+    KERNEL(aom_variance32x8),
+    KERNEL(aom_variance32x16),
+    KERNEL(aom_variance32x32),
+    KERNEL(aom_variance32x64),
+    KERNEL(aom_variance64x16),
+    KERNEL(aom_variance64x32),
+    KERNEL(aom_variance64x64),
+    KERNEL(aom_variance64x128),
+    KERNEL(aom_variance128x64),
+    KERNEL(aom_variance128x128),
+    KERNEL(aom_quantize_b_64x64),
+    KERNEL(aom_highbd_quantize_b_64x64),
+    KERNEL(av1_fwd_txfm2d_16x8),
+    KERNEL(av1_fwd_txfm2d_8x16),
+    KERNEL(av1_fwd_txfm2d_16x4),
+    KERNEL(av1_fwd_txfm2d_4x16),
+    KERNEL(av1_fwd_txfm2d_8x4),
+    KERNEL(av1_fwd_txfm2d_4x8),
+    KERNEL(av1_fwd_txfm2d_32x16),
+    KERNEL(av1_fwd_txfm2d_32x8),
+    KERNEL(av1_fwd_txfm2d_8x32),
+    KERNEL(av1_fwd_txfm2d_16x32),
+    KERNEL(av1_fwd_txfm2d_32x64),
+    KERNEL(av1_fwd_txfm2d_64x32),
+    KERNEL(av1_fwd_txfm2d_16x64),
+    KERNEL(av1_fwd_txfm2d_64x16),
+    KERNEL(av1_fwd_txfm2d_64x64),
+    KERNEL(av1_fwd_txfm2d_32x32),
+    KERNEL(av1_fwd_txfm2d_16x16),
+    KERNEL(av1_fwd_txfm2d_8x8),
+    KERNEL(av1_fwd_txfm2d_4x4),
+    KERNEL(aom_highbd_v_predictor_16x16),
+    KERNEL(aom_highbd_v_predictor_16x32),
+    KERNEL(aom_highbd_v_predictor_16x4),
+    KERNEL(aom_highbd_v_predictor_16x64),
+    KERNEL(aom_highbd_v_predictor_16x8),
+    KERNEL(aom_highbd_v_predictor_2x2),
+    KERNEL(aom_highbd_v_predictor_32x16),
+    KERNEL(aom_highbd_v_predictor_32x32),
+    KERNEL(aom_highbd_v_predictor_32x64),
+    KERNEL(aom_highbd_v_predictor_32x8),
+    KERNEL(aom_highbd_v_predictor_4x16),
+    KERNEL(aom_highbd_v_predictor_4x4),
+    KERNEL(aom_highbd_v_predictor_4x8),
+    KERNEL(aom_highbd_v_predictor_64x16),
+    KERNEL(aom_highbd_v_predictor_64x32),
+    KERNEL(aom_highbd_v_predictor_8x32),
+    KERNEL(aom_highbd_v_predictor_64x64),
+    KERNEL(aom_highbd_v_predictor_8x16),
+    KERNEL(aom_highbd_v_predictor_8x4),
+    KERNEL(aom_highbd_v_predictor_8x8),
+    KERNEL(aom_highbd_smooth_predictor_16x16),
+    KERNEL(aom_highbd_smooth_predictor_16x32),
+    KERNEL(aom_highbd_smooth_predictor_16x4),
+    KERNEL(aom_highbd_smooth_predictor_16x64),
+    KERNEL(aom_highbd_smooth_predictor_16x8),
+    KERNEL(aom_highbd_smooth_predictor_2x2),
+    KERNEL(aom_highbd_smooth_predictor_32x16),
+    KERNEL(aom_highbd_smooth_predictor_32x32),
+    KERNEL(aom_highbd_smooth_predictor_32x64),
+    KERNEL(aom_highbd_smooth_predictor_32x8),
+    KERNEL(aom_highbd_smooth_predictor_4x16),
+    KERNEL(aom_highbd_smooth_predictor_4x4),
+    KERNEL(aom_highbd_smooth_predictor_4x8),
+    KERNEL(aom_highbd_smooth_predictor_64x16),
+    KERNEL(aom_highbd_smooth_predictor_64x32),
+    KERNEL(aom_highbd_smooth_predictor_64x64),
+    KERNEL(aom_highbd_smooth_predictor_8x16),
+    KERNEL(aom_highbd_smooth_predictor_8x32),
+    KERNEL(aom_highbd_smooth_predictor_8x4),
+    KERNEL(aom_highbd_smooth_predictor_8x8),
+    KERNEL(aom_highbd_smooth_h_predictor_16x16),
+    KERNEL(aom_highbd_smooth_h_predictor_16x32),
+    KERNEL(aom_highbd_smooth_h_predictor_16x4),
+    KERNEL(aom_highbd_smooth_h_predictor_16x64),
+    KERNEL(aom_highbd_smooth_h_predictor_16x8),
+    KERNEL(aom_highbd_smooth_h_predictor_2x2),
+    KERNEL(aom_highbd_smooth_h_predictor_32x16),
+    KERNEL(aom_highbd_smooth_h_predictor_32x32),
+    KERNEL(aom_highbd_smooth_h_predictor_32x64),
+    KERNEL(aom_highbd_smooth_h_predictor_32x8),
+    KERNEL(aom_highbd_smooth_h_predictor_4x16),
+    KERNEL(aom_highbd_smooth_h_predictor_4x4),
+    KERNEL(aom_highbd_smooth_h_predictor_4x8),
+    KERNEL(aom_highbd_smooth_h_predictor_64x16),
+    KERNEL(aom_highbd_smooth_h_predictor_64x32),
+    KERNEL(aom_highbd_smooth_h_predictor_64x64),
+    KERNEL(aom_highbd_smooth_h_predictor_8x16),
+    KERNEL(aom_highbd_smooth_h_predictor_8x32),
+    KERNEL(aom_highbd_smooth_h_predictor_8x4),
+    KERNEL(aom_highbd_smooth_h_predictor_8x8),
+    KERNEL(aom_highbd_dc_128_predictor_16x16),
+    KERNEL(aom_highbd_dc_128_predictor_16x32),
+    KERNEL(aom_highbd_dc_128_predictor_16x4),
+    KERNEL(aom_highbd_dc_128_predictor_16x64),
+    KERNEL(aom_highbd_dc_128_predictor_16x8),
+    KERNEL(aom_highbd_dc_128_predictor_2x2),
+    KERNEL(aom_highbd_dc_128_predictor_32x16),
+    KERNEL(aom_highbd_dc_128_predictor_32x32),
+    KERNEL(aom_highbd_dc_128_predictor_32x64),
+    KERNEL(aom_highbd_dc_128_predictor_32x8),
+    KERNEL(aom_highbd_dc_128_predictor_4x16),
+    KERNEL(aom_highbd_dc_128_predictor_4x4),
+    KERNEL(aom_highbd_dc_128_predictor_4x8),
+    KERNEL(aom_highbd_dc_128_predictor_8x32),
+    KERNEL(aom_highbd_dc_128_predictor_64x16),
+    KERNEL(aom_highbd_dc_128_predictor_64x32),
+    KERNEL(aom_highbd_dc_128_predictor_64x64),
+    KERNEL(aom_highbd_dc_128_predictor_8x16),
+    KERNEL(aom_highbd_dc_128_predictor_8x4),
+    KERNEL(aom_highbd_dc_128_predictor_8x8),
+    KERNEL(aom_highbd_dc_left_predictor_16x16),
+    KERNEL(aom_highbd_dc_left_predictor_16x32),
+    KERNEL(aom_highbd_dc_left_predictor_16x4),
+    KERNEL(aom_highbd_dc_left_predictor_16x64),
+    KERNEL(aom_highbd_dc_left_predictor_16x8),
+    KERNEL(aom_highbd_dc_left_predictor_2x2),
+    KERNEL(aom_highbd_dc_left_predictor_32x16),
+    KERNEL(aom_highbd_dc_left_predictor_32x32),
+    KERNEL(aom_highbd_dc_left_predictor_32x64),
+    KERNEL(aom_highbd_dc_left_predictor_32x8),
+    KERNEL(aom_highbd_dc_left_predictor_4x16),
+    KERNEL(aom_highbd_dc_left_predictor_4x4),
+    KERNEL(aom_highbd_dc_left_predictor_4x8),
+    KERNEL(aom_highbd_dc_left_predictor_8x32),
+    KERNEL(aom_highbd_dc_left_predictor_64x16),
+    KERNEL(aom_highbd_dc_left_predictor_64x32),
+    KERNEL(aom_highbd_dc_left_predictor_64x64),
+    KERNEL(aom_highbd_dc_left_predictor_8x16),
+    KERNEL(aom_highbd_dc_left_predictor_8x4),
+    KERNEL(aom_highbd_dc_left_predictor_8x8),
+    KERNEL(aom_highbd_dc_predictor_16x16),
+    KERNEL(aom_highbd_dc_predictor_16x32),
+    KERNEL(aom_highbd_dc_predictor_16x4),
+    KERNEL(aom_highbd_dc_predictor_16x64),
+    KERNEL(aom_highbd_dc_predictor_16x8),
+    KERNEL(aom_highbd_dc_predictor_2x2),
+    KERNEL(aom_highbd_dc_predictor_32x16),
+    KERNEL(aom_highbd_dc_predictor_32x32),
+    KERNEL(aom_highbd_dc_predictor_32x64),
+    KERNEL(aom_highbd_dc_predictor_32x8),
+    KERNEL(aom_highbd_dc_predictor_4x16),
+    KERNEL(aom_highbd_dc_predictor_4x4),
+    KERNEL(aom_highbd_dc_predictor_4x8),
+    KERNEL(aom_highbd_dc_predictor_64x16),
+    KERNEL(aom_highbd_dc_predictor_64x32),
+    KERNEL(aom_highbd_dc_predictor_64x64),
+    KERNEL(aom_highbd_dc_predictor_8x16),
+    KERNEL(aom_highbd_dc_predictor_8x4),
+    KERNEL(aom_highbd_dc_predictor_8x8),
+    KERNEL(aom_highbd_dc_predictor_8x32),
+    KERNEL(aom_highbd_dc_top_predictor_16x16),
+    KERNEL(aom_highbd_dc_top_predictor_16x32),
+    KERNEL(aom_highbd_dc_top_predictor_16x4),
+    KERNEL(aom_highbd_dc_top_predictor_16x64),
+    KERNEL(aom_highbd_dc_top_predictor_16x8),
+    KERNEL(aom_highbd_dc_top_predictor_2x2),
+    KERNEL(aom_highbd_dc_top_predictor_32x16),
+    KERNEL(aom_highbd_dc_top_predictor_32x32),
+    KERNEL(aom_highbd_dc_top_predictor_32x64),
+    KERNEL(aom_highbd_dc_top_predictor_32x8),
+    KERNEL(aom_highbd_dc_top_predictor_4x16),
+    KERNEL(aom_highbd_dc_top_predictor_4x4),
+    KERNEL(aom_highbd_dc_top_predictor_4x8),
+    KERNEL(aom_highbd_dc_top_predictor_64x16),
+    KERNEL(aom_highbd_dc_top_predictor_64x32),
+    KERNEL(aom_highbd_dc_top_predictor_64x64),
+    KERNEL(aom_highbd_dc_top_predictor_8x16),
+    KERNEL(aom_highbd_dc_top_predictor_8x32),
+    KERNEL(aom_highbd_dc_top_predictor_8x4),
+    KERNEL(aom_highbd_dc_top_predictor_8x8),
+    KERNEL(aom_highbd_h_predictor_16x4),
+    KERNEL(aom_highbd_h_predictor_16x64),
+    KERNEL(aom_highbd_h_predictor_16x8),
+    KERNEL(aom_highbd_h_predictor_2x2),
+    KERNEL(aom_highbd_h_predictor_32x16),
+    KERNEL(aom_highbd_h_predictor_32x32),
+    KERNEL(aom_highbd_h_predictor_32x64),
+    KERNEL(aom_highbd_h_predictor_32x8),
+    KERNEL(aom_highbd_h_predictor_4x16),
+    KERNEL(aom_highbd_h_predictor_4x4),
+    KERNEL(aom_highbd_h_predictor_4x8),
+    KERNEL(aom_highbd_h_predictor_64x16),
+    KERNEL(aom_highbd_h_predictor_64x32),
+    KERNEL(aom_highbd_h_predictor_8x32),
+    KERNEL(aom_highbd_h_predictor_64x64),
+    KERNEL(aom_highbd_h_predictor_8x16),
+    KERNEL(aom_highbd_h_predictor_8x4),
+    KERNEL(aom_highbd_h_predictor_8x8),
+    KERNEL(aom_highbd_h_predictor_16x16),
+    KERNEL(aom_highbd_h_predictor_16x32),
+    KERNEL(aom_fft2x2_float),
+    KERNEL(aom_fft4x4_float),
+    KERNEL(aom_fft16x16_float),
+    KERNEL(aom_fft32x32_float),
+    KERNEL(aom_fft8x8_float),
+    KERNEL(aom_ifft16x16_float),
+    KERNEL(aom_ifft32x32_float),
+    KERNEL(aom_ifft8x8_float),
+    KERNEL(aom_ifft2x2_float),
+    KERNEL(aom_ifft4x4_float),
+    KERNEL(aom_noise_tx_filter_block),
+    KERNEL(aom_noise_window_block),
+    KERNEL(aom_noise_accumulate_block),
+    KERNEL(aom_flat_block_fit_plane),
+    KERNEL(aom_flat_block_stats_x4),
+    KERNEL(aom_noise_add_observation),
+};
+
+#undef KERNEL
+
+#define KERNEL_COUNT (sizeof(kernel_table) / sizeof(kernel_table[0]))
+
+// Implementation of each kernel for each instruction set, NULL where it has none
+static EbKernelFn   kernel_choice[EB_KERNEL_ISA_COUNT][KERNEL_COUNT];
+static EbKernelIsa  max_isa;
+static EbAsm        dispatch_asm_type;
+static EbBool       dispatch_ready = EB_FALSE;
+static uint32_t     dispatch_encoder_count = 0;     // encoders between attach and detach
+static EbHandle     dispatch_mutex;
+
+static const int32_t isa_flags[EB_KERNEL_ISA_COUNT] = {
+    0,
+    HAS_MMX | HAS_SSE | HAS_SSE2 | HAS_SSE3 | HAS_SSSE3 | HAS_SSE4_1 | HAS_SSE4_2 | HAS_AVX,
+    HAS_MMX | HAS_SSE | HAS_SSE2 | HAS_SSE3 | HAS_SSSE3 | HAS_SSE4_1 | HAS_SSE4_2 | HAS_AVX | HAS_AVX2
+};
+
+#ifdef _WIN32
+static INIT_ONCE dispatch_once = INIT_ONCE_STATIC_INIT;
+
+static BOOL CALLBACK create_dispatch_mutex(PINIT_ONCE once, PVOID parameter, PVOID *context)
+{
+    (void)once;
+    (void)parameter;
+    (void)context;
+    dispatch_mutex = eb_create_mutex();
+    return TRUE;
+}
+#else
+static pthread_once_t dispatch_once = PTHREAD_ONCE_INIT;
+
+static void create_dispatch_mutex(void)
+{
+    dispatch_mutex = eb_create_mutex();
+}
+#endif
+
+static void lock_dispatch(void)
+{
+#ifdef _WIN32
+    InitOnceExecuteOnce(&dispatch_once, create_dispatch_mutex, NULL, NULL);
+#else
+    pthread_once(&dispatch_once, create_dispatch_mutex);
+#endif
+    eb_block_on_mutex(dispatch_mutex);
+}
+
+/**************************************
+ * Tables built from the kernel pointers
+ * (convolve, intra, ME variance), to be
+ * rebuilt whenever one of them changes
+ **************************************/
+static void init_derived_tables(void)
+{
+    asmSetConvolveAsmTable();
+
+    init_intra_dc_predictors_c_internal();
+
+    asmSetConvolveHbdAsmTable();
+
+    init_intra_predictors_internal();
+
+    init_fn_ptr();
+}
+
+static int32_t find_kernel(
+    const char               *kernel_name)
+{
+    uint32_t index;
+
+    if (kernel_name == NULL)
+        return -1;
+    for (index = 0; index < KERNEL_COUNT; ++index) {
+        if (strcmp(kernel_table[index].name, kernel_name) == 0)
+            return (int32_t)index;
+    }
+    return -1;
+}
+
+/**************************************
+ * Records the implementation of every
+ * kernel for each instruction set, then
+ * selects the asm_type ones. Called with
+ * the mutex held.
+ **************************************/
+static void kernel_dispatch_setup(
+    EbAsm                     asm_type,
+    EbAsm                     cpu_asm_type)
+{
+    uint32_t isa;
+    uint32_t index;
+
+    max_isa = (cpu_asm_type == ASM_AVX2) ? EB_KERNEL_ISA_AVX2 : EB_KERNEL_ISA_SSE;
+    for (isa = 0; isa < EB_KERNEL_ISA_COUNT; ++isa) {
+        for (index = 0; index < KERNEL_COUNT; ++index)
+            *kernel_table[index].pointer = (EbKernelFn)NULL;
+        setup_rtcd_flags(isa_flags[isa]);
+        for (index = 0; index < KERNEL_COUNT; ++index)
+            kernel_choice[isa][index] = *kernel_table[index].pointer;
+    }
+
+    setup_rtcd_internal(asm_type);
+    init_derived_tables();
+    av1_init_me_luts();
+
+    dispatch_asm_type = asm_type;
+    dispatch_ready = EB_TRUE;
+}
+
+/**************************************
+ * eb_kernel_dispatch_init
+ **************************************/
+EbAsm eb_kernel_dispatch_init(
+    EbAsm                     asm_type,
+    EbAsm                     cpu_asm_type)
+{
+    lock_dispatch();
+    if (dispatch_ready == EB_FALSE)
+        kernel_dispatch_setup(asm_type, cpu_asm_type);
+    asm_type = dispatch_asm_type;
+    eb_release_mutex(dispatch_mutex);
+
+    return asm_type;
+}
+
+/**************************************
+ * eb_kernel_dispatch_attach
+ *   The kernels are switched to asm_type
+ *   when no other encoder runs them. The
+ *   table is shared by the process, so an
+ *   encoder asking for another asm type
+ *   than the running ones is rejected.
+ **************************************/
+EbErrorType eb_kernel_dispatch_attach(
+    EbAsm                     asm_type,
+    EbAsm                     cpu_asm_type)
+{
+    EbErrorType return_error = EB_ErrorNone;
+
+    lock_dispatch();
+    if (dispatch_ready == EB_FALSE)
+        kernel_dispatch_setup(asm_type, cpu_asm_type);
+    else if (asm_type != dispatch_asm_type) {
+        if (dispatch_encoder_count == 0) {
+            setup_rtcd_internal(asm_type);
+            init_derived_tables();
+            dispatch_asm_type = asm_type;
+        } else {
+            SVT_LOG("SVT [ERROR]: asm type %d requested, the encoders running use %d\n",
+                (int32_t)asm_type, (int32_t)dispatch_asm_type);
+            return_error = EB_ErrorBadParameter;
+        }
+    }
+    if (return_error == EB_ErrorNone)
+        ++dispatch_encoder_count;
+    eb_release_mutex(dispatch_mutex);
+
+    return return_error;
+}
+
+/**************************************
+ * eb_kernel_dispatch_detach
+ **************************************/
+void eb_kernel_dispatch_detach(void)
+{
+    lock_dispatch();
+    if (dispatch_encoder_count)
+        --dispatch_encoder_count;
+    eb_release_mutex(dispatch_mutex);
+}
+
+/**************************************
+ * eb_kernel_dispatch_name
+ **************************************/
+const char *eb_kernel_dispatch_name(
+    uint32_t                  index)
+{
+    return index < KERNEL_COUNT ? kernel_table[index].name : (const char*)NULL;
+}
+
+/**************************************
+ * eb_kernel_dispatch_query
+ **************************************/
+EbErrorType eb_kernel_dispatch_query(
+    const char               *kernel_name,
+    EbKernelIsa              *isa_ptr,
+    uint32_t                 *available_mask)
+{
+    const int32_t index = find_kernel(kernel_name);
+    uint32_t      mask = 0;
+    int32_t       isa;
+
+    if (index < 0 || isa_ptr == NULL)
+        return EB_ErrorBadParameter;
+
+    lock_dispatch();
+    *isa_ptr = EB_KERNEL_ISA_C;
+    for (isa = 0; isa < EB_KERNEL_ISA_COUNT; ++isa) {
+        if (kernel_choice[isa][index] == *kernel_table[index].pointer) {
+            *isa_ptr = (EbKernelIsa)isa;
+            break;
+        }
+    }
+    // An instruction set with the implementation of the one below adds none
+    for (isa = 0; isa < EB_KERNEL_ISA_COUNT; ++isa) {
+        if (kernel_choice[isa][index] &&
+            (isa == EB_KERNEL_ISA_C || kernel_choice[isa][index] != kernel_choice[isa - 1][index]))
+            mask |= 1 << isa;
+    }
+    eb_release_mutex(dispatch_mutex);
+
+    if (available_mask)
+        *available_mask = mask;
+    return EB_ErrorNone;
+}
+
+/**************************************
+ * eb_kernel_dispatch_override
+ **************************************/
+EbErrorType eb_kernel_dispatch_override(
+    const char               *kernel_name,
+    EbKernelIsa               isa)
+{
+    const int32_t index = find_kernel(kernel_name);
+    EbErrorType   return_error = EB_ErrorNone;
+
+    if (index < 0 || (uint32_t)isa >= EB_KERNEL_ISA_COUNT)
+        return EB_ErrorBadParameter;
+
+    lock_dispatch();
+    // The kernels and the tables built from them are read without a lock
+    if (dispatch_encoder_count)
+        return_error = EB_ErrorUndefined;
+    else if (isa > max_isa || kernel_choice[isa][index] == (EbKernelFn)NULL)
+        return_error = EB_ErrorBadParameter;
+    else if (*kernel_table[index].pointer != kernel_choice[isa][index]) {
+        *kernel_table[index].pointer = kernel_choice[isa][index];
+        init_derived_tables();
+    }
+    eb_release_mutex(dispatch_mutex);
+
+    return return_error;
+}
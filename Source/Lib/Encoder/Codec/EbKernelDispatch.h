@@ -0,0 +1,49 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#ifndef EbKernelDispatch_h
+#define EbKernelDispatch_h
+
+#include "EbDefinitions.h"
+#include "EbSvtAv1Enc.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    /**************************************
+     * Extern Function Declarations
+     **************************************/
+    // Sets the kernel pointers of the process up for asm_type on the first
+    // call, and returns the asm type they were set up for
+    extern EbAsm eb_kernel_dispatch_init(
+        EbAsm                     asm_type,
+        EbAsm                     cpu_asm_type);
+
+    // Sets the kernel pointers up for an encoder; fails when other encoders
+    // already run them for another asm type
+    extern EbErrorType eb_kernel_dispatch_attach(
+        EbAsm                     asm_type,
+        EbAsm                     cpu_asm_type);
+
+    extern void eb_kernel_dispatch_detach(void);
+
+    extern const char *eb_kernel_dispatch_name(
+        uint32_t                  index);
+
+    extern EbErrorType eb_kernel_dispatch_query(
+        const char               *kernel_name,
+        EbKernelIsa              *isa_ptr,
+        uint32_t                 *available_mask);
+
+    // Fails while an encoder is attached
+    extern EbErrorType eb_kernel_dispatch_override(
+        const char               *kernel_name,
+        EbKernelIsa               isa);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // EbKernelDispatch_h
@@ -0,0 +1,153 @@
+/*
+ * Copyright(c) 2019 Netflix, Inc.
+ * SPDX - License - Identifier: BSD - 2 - Clause - Patent
+ */
+
+/******************************************************************************
+ * @file AppInputReaderTest.cc
+ *
+ * @brief Unit test for the input readers of the encoder app:
+ * - input_reader_open
+ * - input_reader_read_frame
+ * - input_reader_close
+ *
+ ******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include "gtest/gtest.h"
+#include "random.h"
+
+extern "C" {
+#include "EbAppContext.h"
+#include "EbAppInputReader.h"
+}
+
+/**
+ * @brief Unit test for the memory mapped and O_DIRECT input readers
+ *
+ * Test strategy:
+ * A raw 4:2:0 file larger than the O_DIRECT read block is read frame by
+ * frame the way the AsyncIo reader thread fills its queue: up to
+ * APP_INPUT_QUEUE_DEPTH frames are read before the oldest one is consumed.
+ *
+ * Expected result:
+ * Every consumed frame matches the frame read with fread, the default
+ * reader, including the frames that were queued while the aligned buffer of
+ * the O_DIRECT reader was refilled.
+ *
+ * Test coverage:
+ * InputReader 1 and 2, 8-bit 4:2:0, several refills of the O_DIRECT buffer
+ * and the loop back to the start of the file.
+ */
+namespace {
+
+const uint32_t width = 352;
+const uint32_t height = 288;
+const uint32_t luma_size = width * height;
+const uint32_t chroma_size = luma_size >> 2;
+const uint32_t frame_size = luma_size + 2 * chroma_size;
+// Enough frames for two refills of the O_DIRECT buffer
+const uint32_t frame_count =
+    2 * INPUT_READER_DIRECT_BLOCK_SIZE / frame_size + 2 * APP_INPUT_QUEUE_DEPTH;
+const char *file_name = "app_input_reader_test.yuv";
+
+class AppInputReaderTest : public ::testing::TestWithParam<InputReaderMode> {
+  protected:
+    void SetUp() override {
+        svt_av1_test_tool::SVTRandom rnd(0, 255);
+        FILE *file = fopen(file_name, "wb");
+        ASSERT_NE(file, nullptr);
+        frames_.resize((size_t)frame_count * frame_size);
+        for (size_t i = 0; i < frames_.size(); ++i)
+            frames_[i] = (uint8_t)rnd.random();
+        ASSERT_EQ(fwrite(frames_.data(), 1, frames_.size(), file),
+                  frames_.size());
+        fclose(file);
+
+        memset(&config_, 0, sizeof(config_));
+        config_.input_file = fopen(file_name, "rb");
+        ASSERT_NE(config_.input_file, nullptr);
+        strcpy(config_.input_file_name, file_name);
+        config_.error_log_file = stderr;
+        config_.buffered_input = -1;
+        config_.encoder_bit_depth = 8;
+        config_.encoder_color_format = EB_YUV420;
+        config_.input_padded_width = width;
+        config_.input_padded_height = height;
+        config_.input_reader = GetParam();
+
+        // Frame buffers of the queue slots, as AllocateInputBuffers()
+        for (uint32_t i = 0; i < APP_INPUT_QUEUE_DEPTH; ++i) {
+            planes_[i].resize(frame_size);
+            memset(&inputs_[i], 0, sizeof(inputs_[i]));
+            inputs_[i].luma = planes_[i].data();
+            inputs_[i].cb = inputs_[i].luma + luma_size;
+            inputs_[i].cr = inputs_[i].cb + chroma_size;
+            memset(&headers_[i], 0, sizeof(headers_[i]));
+            headers_[i].size = sizeof(EbBufferHeaderType);
+            headers_[i].p_buffer = (uint8_t *)&inputs_[i];
+        }
+    }
+
+    void TearDown() override {
+        input_reader_close(&config_);
+        if (config_.input_file)
+            fclose(config_.input_file);
+        remove(file_name);
+    }
+
+    void check_frame(const EbBufferHeaderType &header, uint32_t frame_index) {
+        const EbSvtIOFormat *input = (const EbSvtIOFormat *)header.p_buffer;
+        const uint8_t *ref = frames_.data() +
+                             (size_t)(frame_index % frame_count) * frame_size;
+
+        ASSERT_EQ(header.n_filled_len, frame_size);
+        ASSERT_EQ(memcmp(input->luma, ref, luma_size), 0)
+            << "luma of frame " << frame_index;
+        ASSERT_EQ(memcmp(input->cb, ref + luma_size, chroma_size), 0)
+            << "cb of frame " << frame_index;
+        ASSERT_EQ(memcmp(input->cr, ref + luma_size + chroma_size, chroma_size),
+                  0)
+            << "cr of frame " << frame_index;
+    }
+
+    std::vector<uint8_t> frames_;
+    std::vector<uint8_t> planes_[APP_INPUT_QUEUE_DEPTH];
+    EbSvtIOFormat inputs_[APP_INPUT_QUEUE_DEPTH];
+    EbBufferHeaderType headers_[APP_INPUT_QUEUE_DEPTH];
+    EbConfig config_;
+};
+
+TEST_P(AppInputReaderTest, QueuedFramesMatchFread) {
+    const uint32_t read_count = frame_count + APP_INPUT_QUEUE_DEPTH;
+    uint32_t read_index;
+
+    ASSERT_EQ(input_reader_open(&config_), EB_ErrorNone);
+    if (config_.input_reader_ptr == nullptr ||
+        config_.input_reader_ptr->mode != GetParam()) {
+        printf("InputReader %d is not available here, skipped\n",
+               (int)GetParam());
+        return;
+    }
+
+    // Keep APP_INPUT_QUEUE_DEPTH frames read ahead of the one consumed
+    for (read_index = 0; read_index < read_count; ++read_index) {
+        const uint32_t slot = read_index % APP_INPUT_QUEUE_DEPTH;
+
+        if (read_index >= APP_INPUT_QUEUE_DEPTH)
+            check_frame(headers_[slot], read_index - APP_INPUT_QUEUE_DEPTH);
+        input_reader_read_frame(&config_, 0, &headers_[slot]);
+    }
+    for (read_index = read_count - APP_INPUT_QUEUE_DEPTH;
+         read_index < read_count;
+         ++read_index)
+        check_frame(headers_[read_index % APP_INPUT_QUEUE_DEPTH], read_index);
+}
+
+INSTANTIATE_TEST_CASE_P(AppInputReader, AppInputReaderTest,
+                        ::testing::Values(INPUT_READER_MMAP,
+                                          INPUT_READER_DIRECT));
+
+}  // namespace
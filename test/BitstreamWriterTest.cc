@@ -24,7 +24,7 @@
  * - aom_write_symbols
  * - aom_write_literal
  * - aom_start_encode
- * - aom_stop_encode
+ * - aom_stop_encode, which refuses data larger than the buffer
  *
  * Test strategy:
  * Verify by writing bits/values and reading bits/values in paris,
@@ -80,7 +80,7 @@ class BitstreamWriterTest : public ::testing::Test {
                 generate_random_bits(test_bits, total_bits, bit_gen_method);
 
                 // encode the bits
-                aom_start_encode(&bw, bw_buffer);
+                aom_start_encode(&bw, bw_buffer, buffer_size);
                 for (int i = 0; i < total_bits; ++i) {
                     aom_write(&bw, test_bits[i], static_cast<int>(probas[i]));
                 }
@@ -181,7 +181,7 @@ TEST(Entropy_BitstreamWriter, write_literal_extreme_int) {
     uint8_t stream_buffer[buffer_size];
     AomWriter bw;
 
-    aom_start_encode(&bw, stream_buffer);
+    aom_start_encode(&bw, stream_buffer, buffer_size);
     aom_write_literal(&bw, max_int, 32);
     aom_write_literal(&bw, min_int, 32);
     aom_stop_encode(&bw);
@@ -209,7 +209,7 @@ TEST(Entropy_BitstreamWriter, write_symbol_no_update) {
     std::bernoulli_distribution rnd(0.5);
     std::mt19937 gen(deterministic_seeds);
 
-    aom_start_encode(&bw, stream_buffer);
+    aom_start_encode(&bw, stream_buffer, buffer_size);
     for (int i = 0; i < 500; ++i) {
         aom_write_symbol(&bw, rnd(gen), fc.txb_skip_cdf[0][0], 2);
         aom_write_symbol(&bw, rnd(gen), fc.txb_skip_cdf[0][0], 2);
@@ -246,7 +246,7 @@ TEST(Entropy_BitstreamWriter, write_symbol_with_update) {
     std::bernoulli_distribution rnd(0.5);
     std::mt19937 gen(deterministic_seeds);
 
-    aom_start_encode(&bw, stream_buffer);
+    aom_start_encode(&bw, stream_buffer, buffer_size);
     for (int i = 0; i < 500; ++i) {
         aom_write_symbol(&bw, rnd(gen), fc.txb_skip_cdf[0][0], 2);
         aom_write_symbol(&bw, rnd(gen), fc.txb_skip_cdf[0][0], 2);
@@ -268,4 +268,22 @@ TEST(Entropy_BitstreamWriter, write_symbol_with_update) {
                   rnd(gen));
     }
 }
+
+TEST(Entropy_BitstreamWriter, write_overflow) {
+    AomWriter bw = {0};
+    const int buffer_size = 16;
+    uint8_t stream_buffer[buffer_size * 2];
+    memset(stream_buffer, 0xa5, sizeof(stream_buffer));
+
+    // 1024 raw bits can not fit in 16 bytes
+    aom_start_encode(&bw, stream_buffer, buffer_size);
+    for (int i = 0; i < 32; ++i)
+        aom_write_literal(&bw, 0x5a5a5a5a, 32);
+    EXPECT_LT(aom_stop_encode(&bw), 0) << "overflow not reported";
+
+    // nothing is written past, or in, the buffer
+    EXPECT_EQ(bw.pos, 0u);
+    for (int i = 0; i < buffer_size * 2; ++i)
+        ASSERT_EQ(stream_buffer[i], 0xa5) << "buffer written at " << i;
+}
 }  // namespace
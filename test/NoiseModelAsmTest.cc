@@ -0,0 +1,299 @@
+/*
+ * Copyright(c) 2019 Intel Corporation
+ * SPDX - License - Identifier: BSD - 2 - Clause - Patent
+ */
+
+/******************************************************************************
+ * @file NoiseModelAsmTest.cc
+ *
+ * @brief Unit test for the film grain denoising and noise modeling:
+ * - aom_noise_tx_filter_block_avx2
+ * - aom_noise_window_block_avx2
+ * - aom_noise_accumulate_block_avx2
+ * - aom_flat_block_fit_plane_avx2
+ * - aom_flat_block_stats_x4_avx2
+ * - aom_noise_add_observation_avx2
+ * - aom_wiener_denoise_2d and aom_flat_block_finder_run on worker threads
+ *
+ ******************************************************************************/
+
+#include <random>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+// Workaround to eliminate the compiling warning on linux
+// The macro will conflict with definition in gtest.h
+#ifdef __USE_GNU
+#undef __USE_GNU  // defined in EbThreads.h
+#endif
+#ifdef _GNU_SOURCE
+#undef _GNU_SOURCE  // defined in EbThreads.h
+#endif
+
+#include "EbDefinitions.h"
+#include "EbKernelDispatch.h"
+#include "noise_model.h"
+#include "noise_util.h"
+#include "aom_dsp_rtcd.h"
+
+namespace NoiseModelAsmTest {
+const int deterministic_seed = 0x5e1d;
+
+/**
+ * @brief Unit test for the avx2 kernels of the film grain denoising and noise
+ * modeling.
+ *
+ * Test strategy:
+ * These tests use the C kernels as reference, input the same random data and
+ * compare the C outputs with the avx2 outputs, at sizes which are and are not
+ * a multiple of the vector width.
+ *
+ * Expect result:
+ * avx2 outputs should be exactly the same as C outputs, the noise model of
+ * the encoder does not depend on the instruction set.
+ *
+ * Test cases:
+ * - NoiseModelAsmTest.tx_filter_block_match
+ * - NoiseModelAsmTest.window_block_match
+ * - NoiseModelAsmTest.accumulate_block_match
+ * - NoiseModelAsmTest.flat_block_fit_plane_and_stats_match
+ * - NoiseModelAsmTest.add_observation_match
+ */
+class NoiseModelAsmTest : public ::testing::Test {
+  protected:
+    NoiseModelAsmTest() : gen_(deterministic_seed), dist_(0.0, 1.0) {
+    }
+
+    double rand_unit() {
+        return dist_(gen_);
+    }
+
+    bool supported() const {
+#if defined(__GNUC__)
+        return __builtin_cpu_supports("avx2") != 0;
+#else
+        return true;
+#endif
+    }
+
+    std::mt19937 gen_;
+    std::uniform_real_distribution<double> dist_;
+};
+
+TEST_F(NoiseModelAsmTest, tx_filter_block_match) {
+    if (!supported())
+        return;
+    for (int n = 1; n <= 1024; n = 2 * n + 1) {
+        std::vector<float> ref(2 * n), tst(2 * n), psd(n);
+        for (int i = 0; i < 2 * n; ++i) {
+            // Some tiny coefficients take the eps path of the filter
+            ref[i] = tst[i] = (float)((rand_unit() - 0.5) *
+                                      ((i % 7) == 0 ? 1e-3 : 1.0));
+        }
+        for (int i = 0; i < n; ++i)
+            psd[i] = (float)(rand_unit() * 0.3);
+
+        aom_noise_tx_filter_block_c(ref.data(), psd.data(), n);
+        aom_noise_tx_filter_block_avx2(tst.data(), psd.data(), n);
+        ASSERT_EQ(0, memcmp(ref.data(), tst.data(), sizeof(float) * 2 * n))
+            << "mismatch at n " << n;
+    }
+}
+
+TEST_F(NoiseModelAsmTest, window_block_match) {
+    if (!supported())
+        return;
+    for (int n = 1; n <= 1024; n += 7) {
+        std::vector<double> block_d(n);
+        std::vector<float> window(n), ref(n), tst(n);
+        for (int i = 0; i < n; ++i) {
+            block_d[i] = rand_unit() - 0.5;
+            window[i] = (float)rand_unit();
+        }
+
+        aom_noise_window_block_c(block_d.data(), window.data(), ref.data(), n);
+        aom_noise_window_block_avx2(
+            block_d.data(), window.data(), tst.data(), n);
+        ASSERT_EQ(0, memcmp(ref.data(), tst.data(), sizeof(float) * n))
+            << "mismatch at n " << n;
+    }
+}
+
+TEST_F(NoiseModelAsmTest, accumulate_block_match) {
+    if (!supported())
+        return;
+    const int stride = 70;
+    for (int bs = 2; bs <= 32; bs *= 2) {
+        std::vector<float> block(bs * bs), window(bs * bs);
+        std::vector<double> plane_d(bs * bs);
+        std::vector<float> ref(stride * bs + 3), tst(stride * bs + 3);
+        for (int i = 0; i < bs * bs; ++i) {
+            block[i] = (float)(rand_unit() - 0.5);
+            window[i] = (float)rand_unit();
+            plane_d[i] = rand_unit();
+        }
+        for (size_t i = 0; i < ref.size(); ++i)
+            ref[i] = tst[i] = (float)rand_unit();
+
+        aom_noise_accumulate_block_c(block.data(), plane_d.data(),
+                                     window.data(), bs, ref.data() + 3, stride);
+        aom_noise_accumulate_block_avx2(block.data(), plane_d.data(),
+                                        window.data(), bs, tst.data() + 3,
+                                        stride);
+        ASSERT_EQ(0, memcmp(ref.data(), tst.data(), sizeof(float) * ref.size()))
+            << "mismatch at block size " << bs;
+    }
+}
+
+TEST_F(NoiseModelAsmTest, flat_block_fit_plane_and_stats_match) {
+    if (!supported())
+        return;
+    for (int bs = 8; bs <= 64; bs *= 2) {
+        const int n = bs * bs;
+        aom_flat_block_finder_t block_finder;
+        std::vector<double> plane_ref(n), plane_tst(n);
+        std::vector<double> ref[4], tst[4];
+        const double *ref_ptr[4], *tst_ptr[4];
+        double stats_ref[20], stats_tst[20];
+
+        ASSERT_NE(0, aom_flat_block_finder_init(&block_finder, bs, 8, 0));
+        for (int k = 0; k < 4; ++k) {
+            ref[k].resize(n);
+            for (int i = 0; i < n; ++i)
+                ref[k][i] = rand_unit() * (k + 1) + (i % bs) * 0.01;
+            tst[k] = ref[k];
+
+            aom_flat_block_fit_plane_c(block_finder.A, block_finder.AtA_inv,
+                                       plane_ref.data(), ref[k].data(), n);
+            aom_flat_block_fit_plane_avx2(block_finder.A,
+                                          block_finder.AtA_inv,
+                                          plane_tst.data(), tst[k].data(), n);
+            ASSERT_EQ(0, memcmp(plane_ref.data(), plane_tst.data(),
+                                sizeof(double) * n))
+                << "plane mismatch at block size " << bs;
+            ASSERT_EQ(0, memcmp(ref[k].data(), tst[k].data(),
+                                sizeof(double) * n))
+                << "block mismatch at block size " << bs;
+            ref_ptr[k] = ref[k].data();
+            tst_ptr[k] = tst[k].data();
+        }
+
+        aom_flat_block_stats_x4_c(ref_ptr, bs, stats_ref);
+        aom_flat_block_stats_x4_avx2(tst_ptr, bs, stats_tst);
+        ASSERT_EQ(0, memcmp(stats_ref, stats_tst, sizeof(stats_ref)))
+            << "stats mismatch at block size " << bs;
+        aom_flat_block_finder_free(&block_finder);
+    }
+}
+
+TEST_F(NoiseModelAsmTest, add_observation_match) {
+    if (!supported())
+        return;
+    const double norm_sq = 255.0 * 255.0;
+    for (int n = 1; n <= 30; ++n) {
+        std::vector<double> buffer(n), A_ref(n * n), b_ref(n);
+        for (int i = 0; i < n; ++i)
+            buffer[i] = rand_unit() * 50 - 25;
+        for (int i = 0; i < n * n; ++i)
+            A_ref[i] = rand_unit();
+        for (int i = 0; i < n; ++i)
+            b_ref[i] = rand_unit();
+        std::vector<double> A_tst(A_ref), b_tst(b_ref);
+
+        aom_noise_add_observation_c(
+            buffer.data(), 3.7, norm_sq, n, A_ref.data(), b_ref.data());
+        aom_noise_add_observation_avx2(
+            buffer.data(), 3.7, norm_sq, n, A_tst.data(), b_tst.data());
+        ASSERT_EQ(0, memcmp(A_ref.data(), A_tst.data(), sizeof(double) * n * n))
+            << "A mismatch at n " << n;
+        ASSERT_EQ(0, memcmp(b_ref.data(), b_tst.data(), sizeof(double) * n))
+            << "b mismatch at n " << n;
+    }
+}
+
+/** Runs the block rows on 4 threads, each taking every 4th row backwards */
+static void thread_runner(void *runner_ctx,
+                          void (*process)(void *job, int32_t index), void *job,
+                          int32_t count) {
+    const int thread_count = 4;
+    std::vector<std::thread> threads;
+    (void)runner_ctx;
+    for (int t = 0; t < thread_count; ++t) {
+        threads.emplace_back([=]() {
+            for (int32_t i = count - 1 - t; i >= 0; i -= thread_count)
+                process(job, i);
+        });
+    }
+    for (std::thread &thread : threads)
+        thread.join();
+}
+
+/**
+ * @brief The denoised planes and the flat blocks do not depend on the order
+ * and the threads the block rows run on.
+ *
+ * Test case:
+ * - NoiseModelAsmTest.wiener_denoise_threads_match
+ */
+TEST_F(NoiseModelAsmTest, wiener_denoise_threads_match) {
+    const int width = 400, height = 232, block_size = 32;
+    int32_t strides[3] = {width + 16, width / 2 + 8, width / 2 + 8};
+    int32_t chroma_sub[2] = {1, 1};
+    std::vector<uint8_t> data[3], ref[3], tst[3];
+    std::vector<float> psd[3];
+    uint8_t *ref_ptr[3], *tst_ptr[3];
+    const uint8_t *data_ptr[3];
+    float *psd_ptr[3];
+
+    eb_kernel_dispatch_init(ASM_NON_AVX2, ASM_NON_AVX2);
+
+    for (int c = 0; c < 3; ++c) {
+        const int h = c ? height / 2 : height;
+        data[c].resize(strides[c] * h);
+        // A step edge and noise, so that some blocks are flat and some not
+        for (int i = 0; i < strides[c] * h; ++i) {
+            data[c][i] = (uint8_t)(((i % strides[c]) < width / 2 ? 158 : 98) +
+                                   (int)(rand_unit() * 21) - 10);
+        }
+        ref[c].assign(strides[c] * h, 0);
+        tst[c].assign(strides[c] * h, 0);
+        psd[c].assign(block_size * block_size,
+                      aom_noise_psd_get_default_value(
+                          c ? block_size / 2 : block_size, 2.5f));
+        data_ptr[c] = data[c].data();
+        ref_ptr[c] = ref[c].data();
+        tst_ptr[c] = tst[c].data();
+        psd_ptr[c] = psd[c].data();
+    }
+
+    ASSERT_NE(0, aom_wiener_denoise_2d(data_ptr, ref_ptr, width, height,
+                                       strides, chroma_sub, psd_ptr,
+                                       block_size, 8, 0, NULL, NULL));
+    ASSERT_NE(0, aom_wiener_denoise_2d(data_ptr, tst_ptr, width, height,
+                                       strides, chroma_sub, psd_ptr,
+                                       block_size, 8, 0, thread_runner, NULL));
+    for (int c = 0; c < 3; ++c)
+        ASSERT_EQ(ref[c], tst[c]) << "denoised plane " << c << " mismatch";
+
+    aom_flat_block_finder_t block_finder;
+    const int num_blocks = ((width + block_size - 1) / block_size) *
+                           ((height + block_size - 1) / block_size);
+    std::vector<uint8_t> flat_ref(num_blocks), flat_tst(num_blocks);
+    ASSERT_NE(0, aom_flat_block_finder_init(&block_finder, block_size, 8, 0));
+    const int count_ref = aom_flat_block_finder_run(&block_finder, data_ptr[0],
+                                                    width, height, strides[0],
+                                                    flat_ref.data(), NULL, NULL);
+    const int count_tst = aom_flat_block_finder_run(
+        &block_finder, data_ptr[0], width, height, strides[0], flat_tst.data(),
+        thread_runner, NULL);
+    aom_flat_block_finder_free(&block_finder);
+    ASSERT_EQ(count_ref, count_tst);
+    ASSERT_EQ(flat_ref, flat_tst);
+}
+
+}  // namespace NoiseModelAsmTest
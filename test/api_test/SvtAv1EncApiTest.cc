@@ -84,6 +84,10 @@ TEST(EncApiTest, check_null_pointer) {
     EXPECT_EQ(EB_ErrorBadParameter, eb_svt_enc_stream_header(nullptr, nullptr));
     // get end of sequence NAL with null pointer
     EXPECT_EQ(EB_ErrorBadParameter, eb_svt_enc_eos_nal(nullptr, nullptr));
+    // reconfigure encoder with null pointer
+    EXPECT_EQ(EB_ErrorBadParameter, eb_svt_enc_reconfigure(nullptr, nullptr));
+    // attach a ladder rendition with null pointer
+    EXPECT_EQ(EB_ErrorBadParameter, eb_svt_enc_attach_ladder(nullptr, nullptr));
     // EXPECT_EQ(EB_ErrorBadParameter, eb_svt_enc_send_picture(nullptr,
     // nullptr)); EXPECT_EQ(EB_ErrorBadParameter, eb_svt_get_packet(nullptr,
     // nullptr, 0)); EXPECT_EQ(EB_ErrorBadParameter, eb_svt_get_recon(nullptr,
@@ -188,4 +192,104 @@ TEST(EncApiTest, DISABLED_repeat_normal_setup) {
     }
 }
 
+/** @brief kernel_override is a api test case
+ * EncApiTest.kernel_override is a api test case for switching a dispatched
+ * kernel to another implementation and back
+ *
+ * Test strategy: <br>
+ * Enumerate the kernels, query each one, switch one to its C implementation
+ * and restore it, then pass invalid kernel names and instruction sets.
+ *
+ * Expect result: <br>
+ * The query reports the implementation selected last, and invalid input
+ * reports EB_ErrorBadParameter.
+ *
+ * Test coverage:
+ * eb_svt_kernel_name, eb_svt_kernel_query and eb_svt_kernel_override.
+ */
+TEST(EncApiTest, kernel_override) {
+    uint32_t kernel_count = 0;
+    EbKernelIsa isa;
+    uint32_t available_mask;
+
+    while (eb_svt_kernel_name(kernel_count) != nullptr) {
+        ASSERT_EQ(EB_ErrorNone,
+                  eb_svt_kernel_query(eb_svt_kernel_name(kernel_count),
+                                      &isa,
+                                      &available_mask));
+        EXPECT_NE(0u, available_mask & (1u << isa))
+            << eb_svt_kernel_name(kernel_count);
+        ++kernel_count;
+    }
+    ASSERT_GT(kernel_count, 0u);
+
+    const char *kernel_name = eb_svt_kernel_name(0);
+    EbKernelIsa original_isa;
+    ASSERT_EQ(EB_ErrorNone,
+              eb_svt_kernel_query(kernel_name, &original_isa, nullptr));
+    ASSERT_EQ(EB_ErrorNone,
+              eb_svt_kernel_override(kernel_name, EB_KERNEL_ISA_C));
+    ASSERT_EQ(EB_ErrorNone, eb_svt_kernel_query(kernel_name, &isa, nullptr));
+    EXPECT_EQ(EB_KERNEL_ISA_C, isa);
+    ASSERT_EQ(EB_ErrorNone, eb_svt_kernel_override(kernel_name, original_isa));
+    ASSERT_EQ(EB_ErrorNone, eb_svt_kernel_query(kernel_name, &isa, nullptr));
+    EXPECT_EQ(original_isa, isa);
+
+    EXPECT_EQ(EB_ErrorBadParameter,
+              eb_svt_kernel_override("no_such_kernel", EB_KERNEL_ISA_C));
+    EXPECT_EQ(EB_ErrorBadParameter,
+              eb_svt_kernel_override(kernel_name, EB_KERNEL_ISA_COUNT));
+    EXPECT_EQ(EB_ErrorBadParameter,
+              eb_svt_kernel_query(nullptr, &isa, nullptr));
+    EXPECT_EQ(EB_ErrorBadParameter,
+              eb_svt_kernel_query(kernel_name, nullptr, nullptr));
+}
+
+/** @brief kernel_override_while_encoding is a api test case
+ * EncApiTest.kernel_override_while_encoding is a api test case for checking
+ * the kernels can not be switched under an initialized encoder
+ *
+ * Test strategy: <br>
+ * Initialize an encoder, switch a kernel to its C implementation, then
+ * deinitialize the encoder and switch it again.
+ *
+ * Expect result: <br>
+ * The override reports EB_ErrorUndefined and leaves the kernel as is while
+ * the encoder is initialized, and succeeds once it is deinitialized.
+ *
+ * Test coverage:
+ * eb_svt_kernel_override, eb_init_encoder and eb_deinit_encoder.
+ */
+TEST(EncApiTest, kernel_override_while_encoding) {
+    SvtAv1Context context = {0};
+    const char *kernel_name = eb_svt_kernel_name(0);
+    EbKernelIsa original_isa;
+    EbKernelIsa isa;
+
+    ASSERT_NE(nullptr, kernel_name);
+    ASSERT_EQ(EB_ErrorNone,
+              eb_svt_kernel_query(kernel_name, &original_isa, nullptr));
+
+    ASSERT_EQ(
+        EB_ErrorNone,
+        eb_init_handle(&context.enc_handle, &context, &context.enc_params));
+    context.enc_params.source_width = 320;
+    context.enc_params.source_height = 240;
+    ASSERT_EQ(EB_ErrorNone,
+              eb_svt_enc_set_parameter(context.enc_handle, &context.enc_params));
+    ASSERT_EQ(EB_ErrorNone, eb_init_encoder(context.enc_handle));
+
+    EXPECT_EQ(EB_ErrorUndefined,
+              eb_svt_kernel_override(kernel_name, EB_KERNEL_ISA_C));
+    ASSERT_EQ(EB_ErrorNone, eb_svt_kernel_query(kernel_name, &isa, nullptr));
+    EXPECT_EQ(original_isa, isa);
+
+    EXPECT_EQ(EB_ErrorNone, eb_deinit_encoder(context.enc_handle));
+    EXPECT_EQ(EB_ErrorNone, eb_deinit_handle(context.enc_handle));
+
+    EXPECT_EQ(EB_ErrorNone,
+              eb_svt_kernel_override(kernel_name, EB_KERNEL_ISA_C));
+    EXPECT_EQ(EB_ErrorNone, eb_svt_kernel_override(kernel_name, original_isa));
+}
+
 }  // namespace
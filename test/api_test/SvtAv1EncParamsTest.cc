@@ -248,6 +248,14 @@ PARAM_TEST(EncParamEnableQPScaleTest);
 DEFINE_PARAM_TEST_CLASS(EncParamDisableDlfTest, disable_dlf_flag);
 PARAM_TEST(EncParamDisableDlfTest);
 
+/** Test case for filter_row_pipeline*/
+DEFINE_PARAM_TEST_CLASS(EncParamFilterRowPipelineTest, filter_row_pipeline);
+PARAM_TEST(EncParamFilterRowPipelineTest);
+
+/** Test case for inter_picture_wavefront*/
+DEFINE_PARAM_TEST_CLASS(EncParamInterPictureWavefrontTest, inter_picture_wavefront);
+PARAM_TEST(EncParamInterPictureWavefrontTest);
+
 /** Test case for enable_denoise_flag*/
 DEFINE_PARAM_TEST_CLASS(EncParamEnableDenoiseTest, enable_denoise_flag);
 PARAM_TEST(EncParamEnableDenoiseTest);
@@ -313,6 +321,10 @@ PARAM_TEST(EncParamMaxQPAllowTest);
 DEFINE_PARAM_TEST_CLASS(EncParamMinQPAllowTest, min_qp_allowed);
 PARAM_TEST(EncParamMinQPAllowTest);
 
+/** Test case for pass*/
+DEFINE_PARAM_TEST_CLASS(EncParamPassTest, pass);
+PARAM_TEST(EncParamPassTest);
+
 /** Test case for high_dynamic_range_input*/
 DEFINE_PARAM_TEST_CLASS(EncParamHighDynamicRangeInputTest,
                         high_dynamic_range_input);
@@ -358,6 +370,26 @@ PARAM_TEST(EncParamLogicalProcessorsTest);
 DEFINE_PARAM_TEST_CLASS(EncParamTargetSocketTest, target_socket);
 PARAM_TEST(EncParamTargetSocketTest);
 
+/** Test case for unified_thread_pool*/
+DEFINE_PARAM_TEST_CLASS(EncParamUnifiedThreadPoolTest, unified_thread_pool);
+PARAM_TEST(EncParamUnifiedThreadPoolTest);
+
+/** Test case for numa_memory_policy*/
+DEFINE_PARAM_TEST_CLASS(EncParamNumaMemoryPolicyTest, numa_memory_policy);
+PARAM_TEST(EncParamNumaMemoryPolicyTest);
+
+/** Test case for low_memory*/
+DEFINE_PARAM_TEST_CLASS(EncParamLowMemoryTest, low_memory);
+PARAM_TEST(EncParamLowMemoryTest);
+
+/** Test case for thread_policy*/
+DEFINE_PARAM_TEST_CLASS(EncParamThreadPolicyTest, thread_policy);
+PARAM_TEST(EncParamThreadPolicyTest);
+
+/** Test case for pipeline_stats*/
+DEFINE_PARAM_TEST_CLASS(EncParamPipelineStatsTest, pipeline_stats);
+PARAM_TEST(EncParamPipelineStatsTest);
+
 /** Test case for recon_enabled*/
 DEFINE_PARAM_TEST_CLASS(EncParamReconEnabledTest, recon_enabled);
 PARAM_TEST(EncParamReconEnabledTest);
@@ -370,5 +402,9 @@ PARAM_TEST(EncParamTileColsTest);
 /** Test case for tile_rows*/
 DEFINE_PARAM_TEST_CLASS(EncParamTileRowsTest, tile_rows);
 PARAM_TEST(EncParamTileRowsTest);
+
+/** Test case for tile_group_output*/
+DEFINE_PARAM_TEST_CLASS(EncParamTileGroupOutputTest, tile_group_output);
+PARAM_TEST(EncParamTileGroupOutputTest);
 #endif
 }  // namespace
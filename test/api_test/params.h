@@ -480,6 +480,35 @@ static const vector<EbBool> invalid_disable_dlf_flag = {
     // none
 };
 
+/* Run the in-loop filters by superblock rows instead of whole pictures.
+ *
+ * Default is 0. */
+static const vector<EbBool> default_filter_row_pipeline = {
+    EB_FALSE,
+};
+static const vector<EbBool> valid_filter_row_pipeline = {
+    EB_FALSE,
+    EB_TRUE,
+};
+static const vector<EbBool> invalid_filter_row_pipeline = {
+    // none
+};
+
+/* Start Encode Decode of a picture once the rows of its references reached
+ * by its motion vectors are final.
+ *
+ * Default is 0. */
+static const vector<EbBool> default_inter_picture_wavefront = {
+    EB_FALSE,
+};
+static const vector<EbBool> valid_inter_picture_wavefront = {
+    EB_FALSE,
+    EB_TRUE,
+};
+static const vector<EbBool> invalid_inter_picture_wavefront = {
+    // none
+};
+
 /* Denoise the input picture when noise levels are too high
  * Flag to enable the denoising
  *
@@ -748,6 +777,22 @@ static const vector<uint32_t> invalid_min_qp_allowed = {
     (MAX_QP_VALUE + 1),
 };
 
+/* Two pass encoding: 0 single pass, 1 first pass, 2 second pass. The
+ * statistics of a second pass are only read by eb_init_encoder().
+ *
+ * Default is 0. */
+static const vector<uint32_t> default_pass = {
+    0,
+};
+static const vector<uint32_t> valid_pass = {
+    0,
+    1,
+    2,
+};
+static const vector<uint32_t> invalid_pass = {
+    3,
+};
+
 // Tresholds
 /* Flag to signal that the input yuv is HDR10 BT2020 using SMPTE ST2048,
  * requires
@@ -955,6 +1000,82 @@ static const vector<int32_t> invalid_target_socket = {
     2,
 };
 
+/* Split one budget of logical_processors threads between the stages with
+ * fixed per-stage weights.
+ *
+ * Default is 0. */
+static const vector<EbBool> default_unified_thread_pool = {
+    EB_FALSE,
+};
+static const vector<EbBool> valid_unified_thread_pool = {
+    EB_FALSE,
+    EB_TRUE,
+};
+static const vector<EbBool> invalid_unified_thread_pool = {
+    2,
+};
+
+/* NUMA placement of the large buffers: 0 first touch, 1 bind to the nodes
+ * of target_socket, 2 interleave across the nodes of all sockets.
+ *
+ * Default is 0. */
+static const vector<uint32_t> default_numa_memory_policy = {
+    0,
+};
+static const vector<uint32_t> valid_numa_memory_policy = {
+    0,
+    2,
+};
+static const vector<uint32_t> invalid_numa_memory_policy = {
+    3,
+};
+
+/* Size the per-SB buffers from the configured resolution and SB size
+ * instead of the largest supported picture.
+ *
+ * Default is 0. */
+static const vector<EbBool> default_low_memory = {
+    EB_FALSE,
+};
+static const vector<EbBool> valid_low_memory = {
+    EB_FALSE,
+    EB_TRUE,
+};
+static const vector<EbBool> invalid_low_memory = {
+    2,
+};
+
+/* Scheduling policy of the kernel threads: 0 normal, 1 nice value, 2
+ * SCHED_FIFO. thread_priority stays 0, which is valid for 0 and 1.
+ *
+ * Default is 0. */
+static const vector<uint32_t> default_thread_policy = {
+    0,
+};
+static const vector<uint32_t> valid_thread_policy = {
+    0,
+    1,
+};
+static const vector<uint32_t> invalid_thread_policy = {
+    3,
+};
+
+/* Collect per-stage pipeline statistics (1) and additionally record the
+ * latest kernel tasks for eb_svt_enc_write_trace() (2).
+ *
+ * Default is 0. */
+static const vector<uint32_t> default_pipeline_stats = {
+    0,
+};
+static const vector<uint32_t> valid_pipeline_stats = {
+    0,
+    1,
+    2,
+};
+static const vector<uint32_t> invalid_pipeline_stats = {
+    3,
+};
+
 // Debug tools
 
 /* Output reconstructed yuv used for debug purposes. The value is set through
@@ -1008,6 +1129,21 @@ static const vector<int32_t> invalid_tile_rows = {
     -1,
     7,
 };
+
+/* Output the tiles of a picture as OBU_TILE_GROUP packets as soon as they are
+ * coded.
+ *
+ * Default is 0. */
+static const vector<EbBool> default_tile_group_output = {
+    EB_FALSE,
+};
+static const vector<EbBool> valid_tile_group_output = {
+    EB_FALSE,
+    EB_TRUE,
+};
+static const vector<EbBool> invalid_tile_group_output = {
+    // none
+};
 #endif
 
 }  // namespace svt_av1_test_params
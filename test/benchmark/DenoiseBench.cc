@@ -0,0 +1,318 @@
+/*
+ * Copyright(c) 2019 Intel Corporation
+ * SPDX - License - Identifier: BSD - 2 - Clause - Patent
+ */
+
+/******************************************************************************
+ * @file DenoiseBench.cc
+ *
+ * @brief Benchmark of the film grain denoising and noise modeling run by
+ * Picture Analysis: aom_denoise_and_model_run() on synthetic noisy 1080p and
+ * 4K 8-bit pictures, with the C and the AVX2 kernels and on 1 to N threads,
+ * reported in ms per frame.
+ *
+ * Usage: SvtAv1DenoiseBench [--frames <n>] [--threads <n>] [--isa <c|avx2>]
+ *        [--noise-level <n>]
+ *
+ ******************************************************************************/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "EbDefinitions.h"
+#include "EbKernelDispatch.h"
+#include "EbPictureBufferDesc.h"
+#include "noise_model.h"
+
+// Memory map of EB_MALLOC, set up by the encoder handle otherwise
+extern "C" uint32_t *memory_map_index;
+extern "C" uint64_t *total_lib_memory;
+extern "C" EbAsm GetCpuAsmType();
+
+namespace {
+
+/** Workers sharing the block rows of a job with the calling thread */
+class RowPool {
+  public:
+    explicit RowPool(int thread_count) {
+        for (int i = 1; i < thread_count; i++)
+            workers_.emplace_back([this]() { work(); });
+    }
+
+    ~RowPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            quit_ = true;
+        }
+        wake_.notify_all();
+        for (std::thread &worker : workers_)
+            worker.join();
+    }
+
+    /** aom_denoise_runner_t, returns when every row of the job is done */
+    static void run(void *runner_ctx, void (*process)(void *job, int32_t index),
+                    void *job, int32_t count) {
+        RowPool *pool = static_cast<RowPool *>(runner_ctx);
+        std::unique_lock<std::mutex> lock(pool->mutex_);
+
+        pool->process_ = process;
+        pool->job_ = job;
+        pool->count_ = count;
+        pool->next_ = 0;
+        pool->done_ = 0;
+        pool->generation_++;
+        lock.unlock();
+        pool->wake_.notify_all();
+
+        pool->take_rows();
+
+        // No worker is left in the job when the next one starts
+        lock.lock();
+        pool->finished_.wait(lock, [pool]() {
+            return pool->done_ == pool->count_ && pool->active_ == 0;
+        });
+    }
+
+  private:
+    void take_rows() {
+        int32_t rows = 0;
+        for (int32_t index; (index = next_.fetch_add(1)) < count_; rows++)
+            process_(job_, index);
+        std::lock_guard<std::mutex> lock(mutex_);
+        done_ += rows;
+        if (done_ == count_)
+            finished_.notify_all();
+    }
+
+    void work() {
+        uint64_t seen = 0;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                wake_.wait(lock, [&]() { return quit_ || generation_ != seen; });
+                if (quit_)
+                    return;
+                seen = generation_;
+                active_++;
+            }
+            take_rows();
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (--active_ == 0)
+                finished_.notify_all();
+        }
+    }
+
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable finished_;
+    void (*process_)(void *job, int32_t index) = nullptr;
+    void *job_ = nullptr;
+    int32_t count_ = 0;
+    std::atomic<int32_t> next_{0};
+    int32_t done_ = 0;
+    int32_t active_ = 0;
+    uint64_t generation_ = 0;
+    bool quit_ = false;
+};
+
+struct Resolution {
+    const char *name;
+    uint16_t width;
+    uint16_t height;
+};
+
+const Resolution resolutions[] = {
+    {"1080p", 1920, 1080},
+    {"4K", 3840, 2160},
+};
+
+/** Smooth gradients with flat areas, plus gaussian noise */
+void fill_picture(std::vector<uint8_t> planes[3], const uint16_t strides[3],
+                  uint16_t width, uint16_t height, double sigma) {
+    std::mt19937 gen(0x4b1d);
+    std::normal_distribution<double> noise(0.0, sigma);
+
+    for (int c = 0; c < 3; c++) {
+        const int w = c ? width >> 1 : width;
+        const int h = c ? height >> 1 : height;
+        planes[c].assign((size_t)strides[c] * h, 0);
+        for (int y = 0; y < h; y++) {
+            for (int x = 0; x < w; x++) {
+                const double base =
+                    (x < w / 2) ? 128.0 : 64.0 + 128.0 * y / h;
+                const int v = (int)(base + noise(gen) + 0.5);
+                planes[c][(size_t)y * strides[c] + x] =
+                    (uint8_t)(v < 0 ? 0 : v > 255 ? 255 : v);
+            }
+        }
+    }
+}
+
+/** Points every kernel at its isa implementation, C when there is none */
+void select_isa(EbKernelIsa isa) {
+    const char *name;
+    for (uint32_t i = 0; (name = eb_kernel_dispatch_name(i)) != NULL; i++) {
+        if (eb_kernel_dispatch_override(name, isa) != EB_ErrorNone)
+            eb_kernel_dispatch_override(name, EB_KERNEL_ISA_C);
+    }
+}
+
+/** Time per frame in ms of the denoising and modeling of frames pictures */
+double time_denoise(const Resolution &res, int frames, int threads,
+                    EbAsm asm_type, uint16_t noise_level) {
+    using clock = std::chrono::steady_clock;
+    const uint16_t strides[3] = {res.width, (uint16_t)(res.width >> 1),
+                                 (uint16_t)(res.width >> 1)};
+    std::vector<uint8_t> source[3], planes[3];
+    denoise_and_model_init_data_t init_data;
+    EbPictureBufferDesc picture;
+    EbPtr denoise_and_model;
+    aom_film_grain_t film_grain;
+
+    fill_picture(source, strides, res.width, res.height,
+                 noise_level / 10.0 * 2);
+
+    memset(&init_data, 0, sizeof(init_data));
+    init_data.noise_level = noise_level;
+    init_data.encoder_bit_depth = EB_8BIT;
+    init_data.encoder_color_format = EB_YUV420;
+    init_data.width = res.width;
+    init_data.height = res.height;
+    init_data.stride_y = strides[0];
+    init_data.stride_cb = strides[1];
+    init_data.stride_cr = strides[2];
+    if (denoise_and_model_ctor(&denoise_and_model, &init_data) !=
+        EB_ErrorNone) {
+        fprintf(stderr, "Could not allocate the denoiser\n");
+        return -1;
+    }
+
+    for (int c = 0; c < 3; c++)
+        planes[c] = source[c];
+    memset(&picture, 0, sizeof(picture));
+    picture.buffer_y = planes[0].data();
+    picture.buffer_cb = planes[1].data();
+    picture.buffer_cr = planes[2].data();
+    picture.stride_y = strides[0];
+    picture.stride_cb = strides[1];
+    picture.stride_cr = strides[2];
+    picture.width = picture.max_width = res.width;
+    picture.height = picture.max_height = res.height;
+    picture.bit_depth = EB_8BIT;
+    picture.color_format = EB_YUV420;
+
+    RowPool pool(threads);
+    double total = 0;
+
+    // The first frame warms up the caches and is not timed
+    for (int frame = 0; frame <= frames; frame++) {
+        // The picture is denoised in place
+        for (int c = 0; c < 3; c++)
+            memcpy(planes[c].data(), source[c].data(), source[c].size());
+
+        const clock::time_point start = clock::now();
+        aom_denoise_and_model_run(
+            (struct aom_denoise_and_model_t *)denoise_and_model, &picture,
+            &film_grain, 0, asm_type, threads > 1 ? RowPool::run : NULL,
+            threads > 1 ? &pool : NULL);
+        if (frame)
+            total += std::chrono::duration<double>(clock::now() - start).count();
+    }
+
+    aom_denoise_and_model_free(
+        (struct aom_denoise_and_model_t *)denoise_and_model, 0);
+    return total * 1e3 / frames;
+}
+
+void print_usage(void) {
+    printf(
+        "Usage: SvtAv1DenoiseBench [options]\n"
+        "  --frames <n>       timed frames per measurement (default 10)\n"
+        "  --threads <n>      largest number of threads (default: the CPUs)\n"
+        "  --isa <isa>        only the c or avx2 kernels\n"
+        "  --noise-level <n>  film grain denoise strength, 1 to 50 (default "
+        "25)\n");
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    int frames = 10;
+    int max_threads = (int)std::thread::hardware_concurrency();
+    const char *isa = NULL;
+    int noise_level = 25;
+    uint32_t map_index = 0;
+    uint64_t lib_memory = 0;
+
+    for (int i = 1; i < argc; i++) {
+        const bool has_value = i + 1 < argc;
+        if (!strcmp(argv[i], "--frames") && has_value)
+            frames = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--threads") && has_value)
+            max_threads = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--isa") && has_value)
+            isa = argv[++i];
+        else if (!strcmp(argv[i], "--noise-level") && has_value)
+            noise_level = atoi(argv[++i]);
+        else {
+            print_usage();
+            return 1;
+        }
+    }
+    if (frames <= 0 || noise_level < 1 || noise_level > 50) {
+        print_usage();
+        return 1;
+    }
+    if (max_threads < 1)
+        max_threads = 1;
+
+    memory_map_index = &map_index;
+    total_lib_memory = &lib_memory;
+
+    const EbAsm cpu_asm_type = GetCpuAsmType();
+    const bool avx2 = cpu_asm_type == ASM_AVX2;
+    eb_kernel_dispatch_init(cpu_asm_type, cpu_asm_type);
+
+    printf("resolution,isa,threads,ms_per_frame,speedup_vs_c_1_thread\n");
+    for (const Resolution &res : resolutions) {
+        double reference_ms = 0;
+        for (int pass = 0; pass < 2; pass++) {
+            const char *pass_isa = pass ? "avx2" : "c";
+            if (pass && !avx2) {
+                fprintf(stderr, "Skipping avx2: not supported by the CPU\n");
+                continue;
+            }
+            if (isa && strcmp(isa, pass_isa))
+                continue;
+            select_isa(pass ? EB_KERNEL_ISA_AVX2 : EB_KERNEL_ISA_C);
+
+            // 1, 2, 4... threads, and all of them
+            for (int threads = 1; threads <= max_threads;
+                 threads = (threads < max_threads && threads * 2 > max_threads)
+                               ? max_threads
+                               : threads * 2) {
+                const double ms = time_denoise(
+                    res, frames, threads, pass ? ASM_AVX2 : ASM_NON_AVX2,
+                    (uint16_t)noise_level);
+                if (ms < 0)
+                    return 1;
+                if (!pass && threads == 1)
+                    reference_ms = ms;
+                printf("%s,%s,%d,%.2f,%.2f\n", res.name, pass_isa, threads, ms,
+                       reference_ms > 0 ? reference_ms / ms : 0);
+                fflush(stdout);
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,1792 @@
+/*
+ * Copyright(c) 2019 Intel Corporation
+ * SPDX - License - Identifier: BSD - 2 - Clause - Patent
+ */
+
+/******************************************************************************
+ * @file KernelBench.cc
+ *
+ * @brief Micro-benchmark of the kernels dispatched by setup_rtcd_internal():
+ * every C and SIMD implementation of a kernel is timed on the same data,
+ * across block sizes and bit depths, and reported as CSV or JSON with its
+ * speedup over the C implementation.
+ *
+ * Usage: SvtAv1KernelBench [--filter <kernel substring>] [--isa <c|sse2|
+ *        ssse3|sse4_1|avx2>] [--min-time <ms>] [--format <csv|json>]
+ *        [--output <file>] [--list]
+ *
+ ******************************************************************************/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <map>
+#include <random>
+#include <string>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#include "EbDefinitions.h"
+#include "EbCdef.h"
+#include "convolve.h"
+#include "aom_dsp_rtcd.h"
+
+// filter.h redefines InterpFilter, only the helper is needed here
+extern "C" InterpFilterParams av1_get_interp_filter_params_with_block_size(
+    const InterpFilter interp_filter, const int32_t w);
+
+namespace {
+
+/** Kernels sharing a prototype share a harness */
+enum KernelFamily {
+    Sad,
+    SadX4d,
+    Variance,
+    Intra,
+    IntraHbd,
+    FwdTxfm,
+    InvTxfm,
+    InvTxfmEob,
+    InvTxfmRect,
+    Convolve,
+    ConvolveHbd,
+    Quantize,
+    QuantizeHbd,
+    CdefDir,
+    CdefFilter,
+    TxbInitLevels,
+    Residual,
+    FAMILY_COUNT
+};
+
+using SadFn = uint32_t (*)(const uint8_t *src_ptr, int src_stride,
+                           const uint8_t *ref_ptr, int ref_stride);
+using SadX4dFn = void (*)(const uint8_t *src_ptr, int src_stride,
+                          const uint8_t *const ref_ptr[], int ref_stride,
+                          uint32_t *sad_array);
+using VarianceFn = uint32_t (*)(const uint8_t *src_ptr, int source_stride,
+                                const uint8_t *ref_ptr, int ref_stride,
+                                uint32_t *sse);
+using IntraFn = void (*)(uint8_t *dst, ptrdiff_t y_stride,
+                         const uint8_t *above, const uint8_t *left);
+using IntraHbdFn = void (*)(uint16_t *dst, ptrdiff_t y_stride,
+                            const uint16_t *above, const uint16_t *left,
+                            int32_t bd);
+using FwdTxfmFn = void (*)(int16_t *input, int32_t *output,
+                           uint32_t input_stride, TxType transform_type,
+                           uint8_t bit_depth);
+using InvTxfmFn = void (*)(const int32_t *input, uint16_t *output,
+                           int32_t stride, TxType tx_type, int32_t bd);
+using InvTxfmEobFn = void (*)(const int32_t *input, uint16_t *output,
+                              int32_t stride, TxType tx_type, TxSize tx_size,
+                              int32_t eob, int32_t bd);
+using InvTxfmRectFn = void (*)(const int32_t *input, uint16_t *output,
+                               int32_t stride, TxType tx_type,
+                               TxSize tx_size, int32_t bd);
+using ConvolveFn = void (*)(const uint8_t *src, int32_t src_stride,
+                            uint8_t *dst, int32_t dst_stride, int32_t w,
+                            int32_t h, InterpFilterParams *filter_params_x,
+                            InterpFilterParams *filter_params_y,
+                            const int32_t subpel_x_q4,
+                            const int32_t subpel_y_q4,
+                            ConvolveParams *conv_params);
+using ConvolveHbdFn = void (*)(const uint16_t *src, int32_t src_stride,
+                               uint16_t *dst, int32_t dst_stride, int32_t w,
+                               int32_t h,
+                               const InterpFilterParams *filter_params_x,
+                               const InterpFilterParams *filter_params_y,
+                               const int32_t subpel_x_q4,
+                               const int32_t subpel_y_q4,
+                               ConvolveParams *conv_params, int32_t bd);
+using QuantizeFn = void (*)(const TranLow *coeff_ptr, intptr_t n_coeffs,
+                            int32_t skip_block, const int16_t *zbin_ptr,
+                            const int16_t *round_ptr,
+                            const int16_t *quant_ptr,
+                            const int16_t *quant_shift_ptr,
+                            TranLow *qcoeff_ptr, TranLow *dqcoeff_ptr,
+                            const int16_t *dequant_ptr, uint16_t *eob_ptr,
+                            const int16_t *scan, const int16_t *iscan);
+using QuantizeHbdFn = QuantizeFn;
+using CdefDirFn = int32_t (*)(const uint16_t *img, int32_t stride,
+                              int32_t *var, int32_t coeff_shift);
+using CdefFilterFn = void (*)(uint8_t *dst8, uint16_t *dst16, int32_t dstride,
+                              const uint16_t *in, int32_t pri_strength,
+                              int32_t sec_strength, int32_t dir,
+                              int32_t pri_damping, int32_t sec_damping,
+                              int32_t bsize, int32_t max,
+                              int32_t coeff_shift);
+using TxbInitLevelsFn = void (*)(const TranLow *const coeff,
+                                 const int32_t width, const int32_t height,
+                                 uint8_t *const levels);
+using ResidualFn = void (*)(uint8_t *input, uint32_t input_stride,
+                            uint8_t *pred, uint32_t pred_stride,
+                            int16_t *residual, uint32_t residual_stride,
+                            uint32_t area_width, uint32_t area_height);
+
+using BenchFn = void (*)(void);
+
+/** Bit depths each family is timed at, and its name in the report */
+struct FamilyInfo {
+    const char *name;
+    int bit_depths[2];
+};
+
+const FamilyInfo family_info[FAMILY_COUNT] = {
+    {"sad", {8, 0}},
+    {"sad_x4d", {8, 0}},
+    {"variance", {8, 0}},
+    {"intra", {8, 0}},
+    {"intra_hbd", {10, 0}},
+    {"fwd_txfm", {8, 10}},
+    {"inv_txfm", {8, 10}},
+    {"inv_txfm", {8, 10}},
+    {"inv_txfm", {8, 10}},
+    {"convolve", {8, 0}},
+    {"convolve_hbd", {10, 0}},
+    {"quantize", {8, 0}},
+    {"quantize_hbd", {10, 0}},
+    {"cdef_dir", {8, 10}},
+    {"cdef_filter", {8, 10}},
+    {"txb_init_levels", {8, 0}},
+    {"residual", {8, 0}},
+};
+
+/** One implementation of a kernel at one block size */
+struct KernelEntry {
+    KernelFamily family;
+    const char *kernel;
+    const char *isa;
+    int width;
+    int height;
+    BenchFn fn;
+};
+
+// The static_cast rejects an implementation whose prototype does not match
+// the harness of its family
+#define BENCH_IMPL(family, kernel, isa, w, h, impl)                   \
+    {                                                                 \
+        family, #kernel, #isa, w, h,                                  \
+            reinterpret_cast<BenchFn>(static_cast<family##Fn>(impl)) \
+    }
+#define BENCH(family, kernel, isa, w, h) \
+    BENCH_IMPL(family, kernel, isa, w, h, kernel##_##isa)
+
+// Implementations assigned in setup_rtcd_internal(), in the same order
+const KernelEntry kernel_table[] = {
+    BENCH(Sad, aom_sad4x4, c, 4, 4),
+    BENCH(Sad, aom_sad4x4, avx2, 4, 4),
+    BENCH(Sad, aom_sad4x16, c, 4, 16),
+    BENCH(Sad, aom_sad4x16, avx2, 4, 16),
+    BENCH(Sad, aom_sad4x8, c, 4, 8),
+    BENCH(Sad, aom_sad4x8, avx2, 4, 8),
+    BENCH(Sad, aom_sad64x128, c, 64, 128),
+    BENCH(Sad, aom_sad64x128, avx2, 64, 128),
+    BENCH(Sad, aom_sad64x16, c, 64, 16),
+    BENCH(Sad, aom_sad64x16, avx2, 64, 16),
+    BENCH(Sad, aom_sad64x32, c, 64, 32),
+    BENCH(Sad, aom_sad64x32, avx2, 64, 32),
+    BENCH(Sad, aom_sad64x64, c, 64, 64),
+    BENCH(Sad, aom_sad64x64, avx2, 64, 64),
+    BENCH(Sad, aom_sad8x16, c, 8, 16),
+    BENCH(Sad, aom_sad8x16, avx2, 8, 16),
+    BENCH(Sad, aom_sad8x32, c, 8, 32),
+    BENCH(Sad, aom_sad8x32, avx2, 8, 32),
+    BENCH(Sad, aom_sad8x8, c, 8, 8),
+    BENCH(Sad, aom_sad8x8, avx2, 8, 8),
+    BENCH(Sad, aom_sad16x4, c, 16, 4),
+    BENCH(Sad, aom_sad16x4, avx2, 16, 4),
+    BENCH(Sad, aom_sad32x8, c, 32, 8),
+    BENCH(Sad, aom_sad32x8, avx2, 32, 8),
+    BENCH(Sad, aom_sad16x64, c, 16, 64),
+    BENCH(Sad, aom_sad16x64, avx2, 16, 64),
+    BENCH(Sad, aom_sad128x128, c, 128, 128),
+    BENCH(Sad, aom_sad128x128, avx2, 128, 128),
+    BENCH(Sad, aom_sad128x64, c, 128, 64),
+    BENCH(Sad, aom_sad128x64, avx2, 128, 64),
+    BENCH(Sad, aom_sad32x16, c, 32, 16),
+    BENCH(Sad, aom_sad32x16, avx2, 32, 16),
+    BENCH(Sad, aom_sad16x32, c, 16, 32),
+    BENCH(Sad, aom_sad16x32, avx2, 16, 32),
+    BENCH(Sad, aom_sad32x64, c, 32, 64),
+    BENCH(Sad, aom_sad32x64, avx2, 32, 64),
+    BENCH(Sad, aom_sad32x32, c, 32, 32),
+    BENCH(Sad, aom_sad32x32, avx2, 32, 32),
+    BENCH(Sad, aom_sad16x16, c, 16, 16),
+    BENCH(Sad, aom_sad16x16, avx2, 16, 16),
+    BENCH(Sad, aom_sad16x8, c, 16, 8),
+    BENCH(Sad, aom_sad16x8, avx2, 16, 8),
+    BENCH(Sad, aom_sad8x4, c, 8, 4),
+    BENCH(Sad, aom_sad8x4, avx2, 8, 4),
+    BENCH(SadX4d, aom_sad4x4x4d, c, 4, 4),
+    BENCH(SadX4d, aom_sad4x4x4d, avx2, 4, 4),
+    BENCH(SadX4d, aom_sad4x16x4d, c, 4, 16),
+    BENCH(SadX4d, aom_sad4x16x4d, avx2, 4, 16),
+    BENCH(SadX4d, aom_sad4x8x4d, c, 4, 8),
+    BENCH(SadX4d, aom_sad4x8x4d, avx2, 4, 8),
+    BENCH(SadX4d, aom_sad64x128x4d, c, 64, 128),
+    BENCH(SadX4d, aom_sad64x128x4d, avx2, 64, 128),
+    BENCH(SadX4d, aom_sad64x16x4d, c, 64, 16),
+    BENCH(SadX4d, aom_sad64x16x4d, avx2, 64, 16),
+    BENCH(SadX4d, aom_sad64x32x4d, c, 64, 32),
+    BENCH(SadX4d, aom_sad64x32x4d, avx2, 64, 32),
+    BENCH(SadX4d, aom_sad64x64x4d, c, 64, 64),
+    BENCH(SadX4d, aom_sad64x64x4d, avx2, 64, 64),
+    BENCH(SadX4d, aom_sad8x16x4d, c, 8, 16),
+    BENCH(SadX4d, aom_sad8x16x4d, avx2, 8, 16),
+    BENCH(SadX4d, aom_sad8x32x4d, c, 8, 32),
+    BENCH(SadX4d, aom_sad8x32x4d, avx2, 8, 32),
+    BENCH(SadX4d, aom_sad8x8x4d, c, 8, 8),
+    BENCH(SadX4d, aom_sad8x8x4d, avx2, 8, 8),
+    BENCH(SadX4d, aom_sad16x4x4d, c, 16, 4),
+    BENCH(SadX4d, aom_sad16x4x4d, avx2, 16, 4),
+    BENCH(SadX4d, aom_sad32x8x4d, c, 32, 8),
+    BENCH(SadX4d, aom_sad32x8x4d, avx2, 32, 8),
+    BENCH(SadX4d, aom_sad16x64x4d, c, 16, 64),
+    BENCH(SadX4d, aom_sad16x64x4d, avx2, 16, 64),
+    BENCH(SadX4d, aom_sad128x128x4d, c, 128, 128),
+    BENCH(SadX4d, aom_sad128x128x4d, avx2, 128, 128),
+    BENCH(SadX4d, aom_sad128x64x4d, c, 128, 64),
+    BENCH(SadX4d, aom_sad128x64x4d, avx2, 128, 64),
+    BENCH(SadX4d, aom_sad32x16x4d, c, 32, 16),
+    BENCH(SadX4d, aom_sad32x16x4d, avx2, 32, 16),
+    BENCH(SadX4d, aom_sad16x32x4d, c, 16, 32),
+    BENCH(SadX4d, aom_sad16x32x4d, avx2, 16, 32),
+    BENCH(SadX4d, aom_sad32x64x4d, c, 32, 64),
+    BENCH(SadX4d, aom_sad32x64x4d, avx2, 32, 64),
+    BENCH(SadX4d, aom_sad32x32x4d, c, 32, 32),
+    BENCH(SadX4d, aom_sad32x32x4d, avx2, 32, 32),
+    BENCH(SadX4d, aom_sad16x16x4d, c, 16, 16),
+    BENCH(SadX4d, aom_sad16x16x4d, avx2, 16, 16),
+    BENCH(SadX4d, aom_sad16x8x4d, c, 16, 8),
+    BENCH(SadX4d, aom_sad16x8x4d, avx2, 16, 8),
+    BENCH(SadX4d, aom_sad8x4x4d, c, 8, 4),
+    BENCH(SadX4d, aom_sad8x4x4d, avx2, 8, 4),
+    BENCH(Variance, aom_mse16x16, c, 16, 16),
+    BENCH(Variance, aom_mse16x16, avx2, 16, 16),
+    BENCH(Variance, aom_variance4x4, c, 4, 4),
+    BENCH(Variance, aom_variance4x4, sse2, 4, 4),
+    BENCH(Variance, aom_variance4x8, c, 4, 8),
+    BENCH(Variance, aom_variance4x8, sse2, 4, 8),
+    BENCH(Variance, aom_variance4x16, c, 4, 16),
+    BENCH(Variance, aom_variance4x16, sse2, 4, 16),
+    BENCH(Variance, aom_variance8x4, c, 8, 4),
+    BENCH(Variance, aom_variance8x4, sse2, 8, 4),
+    BENCH(Variance, aom_variance8x8, c, 8, 8),
+    BENCH(Variance, aom_variance8x8, sse2, 8, 8),
+    BENCH(Variance, aom_variance8x16, c, 8, 16),
+    BENCH(Variance, aom_variance8x16, sse2, 8, 16),
+    BENCH(Variance, aom_variance8x32, c, 8, 32),
+    BENCH(Variance, aom_variance8x32, sse2, 8, 32),
+    BENCH(Variance, aom_variance16x4, c, 16, 4),
+    BENCH(Variance, aom_variance16x4, avx2, 16, 4),
+    BENCH(Variance, aom_variance16x8, c, 16, 8),
+    BENCH(Variance, aom_variance16x8, avx2, 16, 8),
+    BENCH(Variance, aom_variance16x16, c, 16, 16),
+    BENCH(Variance, aom_variance16x16, avx2, 16, 16),
+    BENCH(Variance, aom_variance16x32, c, 16, 32),
+    BENCH(Variance, aom_variance16x32, avx2, 16, 32),
+    BENCH(Variance, aom_variance16x64, c, 16, 64),
+    BENCH(Variance, aom_variance16x64, avx2, 16, 64),
+    BENCH(Variance, aom_variance32x8, c, 32, 8),
+    BENCH(Variance, aom_variance32x8, avx2, 32, 8),
+    BENCH(Variance, aom_variance32x16, c, 32, 16),
+    BENCH(Variance, aom_variance32x16, avx2, 32, 16),
+    BENCH(Variance, aom_variance32x32, c, 32, 32),
+    BENCH(Variance, aom_variance32x32, avx2, 32, 32),
+    BENCH(Variance, aom_variance32x64, c, 32, 64),
+    BENCH(Variance, aom_variance32x64, avx2, 32, 64),
+    BENCH(Variance, aom_variance64x16, c, 64, 16),
+    BENCH(Variance, aom_variance64x16, avx2, 64, 16),
+    BENCH(Variance, aom_variance64x32, c, 64, 32),
+    BENCH(Variance, aom_variance64x32, avx2, 64, 32),
+    BENCH(Variance, aom_variance64x64, c, 64, 64),
+    BENCH(Variance, aom_variance64x64, avx2, 64, 64),
+    BENCH(Variance, aom_variance64x128, c, 64, 128),
+    BENCH(Variance, aom_variance64x128, avx2, 64, 128),
+    BENCH(Variance, aom_variance128x64, c, 128, 64),
+    BENCH(Variance, aom_variance128x64, avx2, 128, 64),
+    BENCH(Variance, aom_variance128x128, c, 128, 128),
+    BENCH(Variance, aom_variance128x128, avx2, 128, 128),
+    BENCH(Intra, aom_paeth_predictor_16x16, c, 16, 16),
+    BENCH(Intra, aom_paeth_predictor_16x16, ssse3, 16, 16),
+    BENCH(Intra, aom_paeth_predictor_16x16, avx2, 16, 16),
+    BENCH(Intra, aom_paeth_predictor_16x32, c, 16, 32),
+    BENCH(Intra, aom_paeth_predictor_16x32, ssse3, 16, 32),
+    BENCH(Intra, aom_paeth_predictor_16x32, avx2, 16, 32),
+    BENCH(Intra, aom_paeth_predictor_16x4, c, 16, 4),
+    BENCH(Intra, aom_paeth_predictor_16x4, ssse3, 16, 4),
+    BENCH(Intra, aom_paeth_predictor_16x64, c, 16, 64),
+    BENCH(Intra, aom_paeth_predictor_16x64, ssse3, 16, 64),
+    BENCH(Intra, aom_paeth_predictor_16x64, avx2, 16, 64),
+    BENCH(Intra, aom_paeth_predictor_16x8, c, 16, 8),
+    BENCH(Intra, aom_paeth_predictor_16x8, ssse3, 16, 8),
+    BENCH(Intra, aom_paeth_predictor_16x8, avx2, 16, 8),
+    BENCH(Intra, aom_paeth_predictor_32x16, c, 32, 16),
+    BENCH(Intra, aom_paeth_predictor_32x16, ssse3, 32, 16),
+    BENCH(Intra, aom_paeth_predictor_32x16, avx2, 32, 16),
+    BENCH(Intra, aom_paeth_predictor_32x32, c, 32, 32),
+    BENCH(Intra, aom_paeth_predictor_32x32, ssse3, 32, 32),
+    BENCH(Intra, aom_paeth_predictor_32x32, avx2, 32, 32),
+    BENCH(Intra, aom_paeth_predictor_32x64, c, 32, 64),
+    BENCH(Intra, aom_paeth_predictor_32x64, ssse3, 32, 64),
+    BENCH(Intra, aom_paeth_predictor_32x64, avx2, 32, 64),
+    BENCH(Intra, aom_paeth_predictor_32x8, c, 32, 8),
+    BENCH(Intra, aom_paeth_predictor_32x8, ssse3, 32, 8),
+    BENCH(Intra, aom_paeth_predictor_4x16, c, 4, 16),
+    BENCH(Intra, aom_paeth_predictor_4x16, ssse3, 4, 16),
+    BENCH(Intra, aom_paeth_predictor_4x4, c, 4, 4),
+    BENCH(Intra, aom_paeth_predictor_4x4, ssse3, 4, 4),
+    BENCH(Intra, aom_paeth_predictor_4x8, c, 4, 8),
+    BENCH(Intra, aom_paeth_predictor_4x8, ssse3, 4, 8),
+    BENCH(Intra, aom_paeth_predictor_64x16, c, 64, 16),
+    BENCH(Intra, aom_paeth_predictor_64x16, ssse3, 64, 16),
+    BENCH(Intra, aom_paeth_predictor_64x16, avx2, 64, 16),
+    BENCH(Intra, aom_paeth_predictor_64x32, c, 64, 32),
+    BENCH(Intra, aom_paeth_predictor_64x32, ssse3, 64, 32),
+    BENCH(Intra, aom_paeth_predictor_64x32, avx2, 64, 32),
+    BENCH(Intra, aom_paeth_predictor_64x64, c, 64, 64),
+    BENCH(Intra, aom_paeth_predictor_64x64, ssse3, 64, 64),
+    BENCH(Intra, aom_paeth_predictor_64x64, avx2, 64, 64),
+    BENCH(Intra, aom_paeth_predictor_8x16, c, 8, 16),
+    BENCH(Intra, aom_paeth_predictor_8x16, ssse3, 8, 16),
+    BENCH(Intra, aom_paeth_predictor_8x32, c, 8, 32),
+    BENCH(Intra, aom_paeth_predictor_8x32, ssse3, 8, 32),
+    BENCH(Intra, aom_paeth_predictor_8x4, c, 8, 4),
+    BENCH(Intra, aom_paeth_predictor_8x4, ssse3, 8, 4),
+    BENCH(Intra, aom_paeth_predictor_8x8, c, 8, 8),
+    BENCH(Intra, aom_paeth_predictor_8x8, ssse3, 8, 8),
+    BENCH(Intra, aom_dc_predictor_4x4, c, 4, 4),
+    BENCH(Intra, aom_dc_predictor_4x4, sse2, 4, 4),
+    BENCH(Intra, aom_dc_predictor_8x8, c, 8, 8),
+    BENCH(Intra, aom_dc_predictor_8x8, sse2, 8, 8),
+    BENCH(Intra, aom_dc_predictor_16x16, c, 16, 16),
+    BENCH(Intra, aom_dc_predictor_16x16, sse2, 16, 16),
+    BENCH(Intra, aom_dc_predictor_32x32, c, 32, 32),
+    BENCH(Intra, aom_dc_predictor_32x32, avx2, 32, 32),
+    BENCH(Intra, aom_dc_predictor_64x64, c, 64, 64),
+    BENCH(Intra, aom_dc_predictor_64x64, avx2, 64, 64),
+    BENCH(Intra, aom_dc_predictor_32x16, c, 32, 16),
+    BENCH(Intra, aom_dc_predictor_32x16, avx2, 32, 16),
+    BENCH(Intra, aom_dc_predictor_32x64, c, 32, 64),
+    BENCH(Intra, aom_dc_predictor_32x64, avx2, 32, 64),
+    BENCH(Intra, aom_dc_predictor_64x16, c, 64, 16),
+    BENCH(Intra, aom_dc_predictor_64x16, avx2, 64, 16),
+    BENCH(Intra, aom_dc_predictor_8x16, c, 8, 16),
+    BENCH(Intra, aom_dc_predictor_8x16, sse2, 8, 16),
+    BENCH(Intra, aom_dc_predictor_8x32, c, 8, 32),
+    BENCH(Intra, aom_dc_predictor_8x32, sse2, 8, 32),
+    BENCH(Intra, aom_dc_predictor_8x4, c, 8, 4),
+    BENCH(Intra, aom_dc_predictor_8x4, sse2, 8, 4),
+    BENCH(Intra, aom_dc_predictor_64x32, c, 64, 32),
+    BENCH(Intra, aom_dc_predictor_64x32, avx2, 64, 32),
+    BENCH(Intra, aom_dc_predictor_16x32, c, 16, 32),
+    BENCH(Intra, aom_dc_predictor_16x32, sse2, 16, 32),
+    BENCH(Intra, aom_dc_predictor_16x4, c, 16, 4),
+    BENCH(Intra, aom_dc_predictor_16x4, sse2, 16, 4),
+    BENCH(Intra, aom_dc_predictor_16x64, c, 16, 64),
+    BENCH(Intra, aom_dc_predictor_16x64, sse2, 16, 64),
+    BENCH(Intra, aom_dc_predictor_16x8, c, 16, 8),
+    BENCH(Intra, aom_dc_predictor_16x8, sse2, 16, 8),
+    BENCH(Intra, aom_dc_predictor_32x8, c, 32, 8),
+    BENCH(Intra, aom_dc_predictor_32x8, sse2, 32, 8),
+    BENCH(Intra, aom_dc_predictor_4x16, c, 4, 16),
+    BENCH(Intra, aom_dc_predictor_4x16, sse2, 4, 16),
+    BENCH(Intra, aom_dc_predictor_4x8, c, 4, 8),
+    BENCH(Intra, aom_dc_predictor_4x8, sse2, 4, 8),
+    BENCH(Intra, aom_dc_top_predictor_4x4, c, 4, 4),
+    BENCH(Intra, aom_dc_top_predictor_4x4, sse2, 4, 4),
+    BENCH(Intra, aom_dc_top_predictor_8x8, c, 8, 8),
+    BENCH(Intra, aom_dc_top_predictor_8x8, sse2, 8, 8),
+    BENCH(Intra, aom_dc_top_predictor_16x16, c, 16, 16),
+    BENCH(Intra, aom_dc_top_predictor_16x16, sse2, 16, 16),
+    BENCH(Intra, aom_dc_top_predictor_32x32, c, 32, 32),
+    BENCH(Intra, aom_dc_top_predictor_32x32, avx2, 32, 32),
+    BENCH(Intra, aom_dc_top_predictor_64x64, c, 64, 64),
+    BENCH(Intra, aom_dc_top_predictor_64x64, avx2, 64, 64),
+    BENCH(Intra, aom_dc_top_predictor_16x32, c, 16, 32),
+    BENCH(Intra, aom_dc_top_predictor_16x32, sse2, 16, 32),
+    BENCH(Intra, aom_dc_top_predictor_16x4, c, 16, 4),
+    BENCH(Intra, aom_dc_top_predictor_16x4, sse2, 16, 4),
+    BENCH(Intra, aom_dc_top_predictor_16x64, c, 16, 64),
+    BENCH(Intra, aom_dc_top_predictor_16x64, sse2, 16, 64),
+    BENCH(Intra, aom_dc_top_predictor_16x8, c, 16, 8),
+    BENCH(Intra, aom_dc_top_predictor_16x8, sse2, 16, 8),
+    BENCH(Intra, aom_dc_top_predictor_32x16, c, 32, 16),
+    BENCH(Intra, aom_dc_top_predictor_32x16, avx2, 32, 16),
+    BENCH(Intra, aom_dc_top_predictor_32x64, c, 32, 64),
+    BENCH(Intra, aom_dc_top_predictor_32x64, avx2, 32, 64),
+    BENCH(Intra, aom_dc_top_predictor_32x8, c, 32, 8),
+    BENCH(Intra, aom_dc_top_predictor_32x8, sse2, 32, 8),
+    BENCH(Intra, aom_dc_top_predictor_4x16, c, 4, 16),
+    BENCH(Intra, aom_dc_top_predictor_4x16, sse2, 4, 16),
+    BENCH(Intra, aom_dc_top_predictor_4x8, c, 4, 8),
+    BENCH(Intra, aom_dc_top_predictor_4x8, sse2, 4, 8),
+    BENCH(Intra, aom_dc_top_predictor_64x16, c, 64, 16),
+    BENCH(Intra, aom_dc_top_predictor_64x16, avx2, 64, 16),
+    BENCH(Intra, aom_dc_top_predictor_64x32, c, 64, 32),
+    BENCH(Intra, aom_dc_top_predictor_64x32, avx2, 64, 32),
+    BENCH(Intra, aom_dc_top_predictor_8x16, c, 8, 16),
+    BENCH(Intra, aom_dc_top_predictor_8x16, sse2, 8, 16),
+    BENCH(Intra, aom_dc_top_predictor_8x32, c, 8, 32),
+    BENCH(Intra, aom_dc_top_predictor_8x32, sse2, 8, 32),
+    BENCH(Intra, aom_dc_top_predictor_8x4, c, 8, 4),
+    BENCH(Intra, aom_dc_top_predictor_8x4, sse2, 8, 4),
+    BENCH(Intra, aom_dc_left_predictor_4x4, c, 4, 4),
+    BENCH(Intra, aom_dc_left_predictor_4x4, sse2, 4, 4),
+    BENCH(Intra, aom_dc_left_predictor_8x8, c, 8, 8),
+    BENCH(Intra, aom_dc_left_predictor_8x8, sse2, 8, 8),
+    BENCH(Intra, aom_dc_left_predictor_16x16, c, 16, 16),
+    BENCH(Intra, aom_dc_left_predictor_16x16, sse2, 16, 16),
+    BENCH(Intra, aom_dc_left_predictor_32x32, c, 32, 32),
+    BENCH(Intra, aom_dc_left_predictor_32x32, avx2, 32, 32),
+    BENCH(Intra, aom_dc_left_predictor_64x64, c, 64, 64),
+    BENCH(Intra, aom_dc_left_predictor_64x64, avx2, 64, 64),
+    BENCH(Intra, aom_dc_left_predictor_16x32, c, 16, 32),
+    BENCH(Intra, aom_dc_left_predictor_16x32, sse2, 16, 32),
+    BENCH(Intra, aom_dc_left_predictor_16x4, c, 16, 4),
+    BENCH(Intra, aom_dc_left_predictor_16x4, sse2, 16, 4),
+    BENCH(Intra, aom_dc_left_predictor_16x64, c, 16, 64),
+    BENCH(Intra, aom_dc_left_predictor_16x64, sse2, 16, 64),
+    BENCH(Intra, aom_dc_left_predictor_16x8, c, 16, 8),
+    BENCH(Intra, aom_dc_left_predictor_16x8, sse2, 16, 8),
+    BENCH(Intra, aom_dc_left_predictor_32x16, c, 32, 16),
+    BENCH(Intra, aom_dc_left_predictor_32x16, avx2, 32, 16),
+    BENCH(Intra, aom_dc_left_predictor_32x64, c, 32, 64),
+    BENCH(Intra, aom_dc_left_predictor_32x64, avx2, 32, 64),
+    BENCH(Intra, aom_dc_left_predictor_64x16, c, 64, 16),
+    BENCH(Intra, aom_dc_left_predictor_64x16, avx2, 64, 16),
+    BENCH(Intra, aom_dc_left_predictor_64x32, c, 64, 32),
+    BENCH(Intra, aom_dc_left_predictor_64x32, avx2, 64, 32),
+    BENCH(Intra, aom_dc_left_predictor_32x8, c, 32, 8),
+    BENCH(Intra, aom_dc_left_predictor_32x8, sse2, 32, 8),
+    BENCH(Intra, aom_dc_left_predictor_4x16, c, 4, 16),
+    BENCH(Intra, aom_dc_left_predictor_4x16, sse2, 4, 16),
+    BENCH(Intra, aom_dc_left_predictor_4x8, c, 4, 8),
+    BENCH(Intra, aom_dc_left_predictor_4x8, sse2, 4, 8),
+    BENCH(Intra, aom_dc_left_predictor_8x16, c, 8, 16),
+    BENCH(Intra, aom_dc_left_predictor_8x16, sse2, 8, 16),
+    BENCH(Intra, aom_dc_left_predictor_8x32, c, 8, 32),
+    BENCH(Intra, aom_dc_left_predictor_8x32, sse2, 8, 32),
+    BENCH(Intra, aom_dc_left_predictor_8x4, c, 8, 4),
+    BENCH(Intra, aom_dc_left_predictor_8x4, sse2, 8, 4),
+    BENCH(Intra, aom_dc_128_predictor_4x4, c, 4, 4),
+    BENCH(Intra, aom_dc_128_predictor_4x4, sse2, 4, 4),
+    BENCH(Intra, aom_dc_128_predictor_8x8, c, 8, 8),
+    BENCH(Intra, aom_dc_128_predictor_8x8, sse2, 8, 8),
+    BENCH(Intra, aom_dc_128_predictor_16x16, c, 16, 16),
+    BENCH(Intra, aom_dc_128_predictor_16x16, sse2, 16, 16),
+    BENCH(Intra, aom_dc_128_predictor_32x32, c, 32, 32),
+    BENCH(Intra, aom_dc_128_predictor_32x32, avx2, 32, 32),
+    BENCH(Intra, aom_dc_128_predictor_64x64, c, 64, 64),
+    BENCH(Intra, aom_dc_128_predictor_64x64, avx2, 64, 64),
+    BENCH(Intra, aom_dc_128_predictor_16x32, c, 16, 32),
+    BENCH(Intra, aom_dc_128_predictor_16x32, sse2, 16, 32),
+    BENCH(Intra, aom_dc_128_predictor_16x4, c, 16, 4),
+    BENCH(Intra, aom_dc_128_predictor_16x4, sse2, 16, 4),
+    BENCH(Intra, aom_dc_128_predictor_16x64, c, 16, 64),
+    BENCH(Intra, aom_dc_128_predictor_16x64, sse2, 16, 64),
+    BENCH(Intra, aom_dc_128_predictor_16x8, c, 16, 8),
+    BENCH(Intra, aom_dc_128_predictor_16x8, sse2, 16, 8),
+    BENCH(Intra, aom_dc_128_predictor_32x16, c, 32, 16),
+    BENCH(Intra, aom_dc_128_predictor_32x16, avx2, 32, 16),
+    BENCH(Intra, aom_dc_128_predictor_32x64, c, 32, 64),
+    BENCH(Intra, aom_dc_128_predictor_32x64, avx2, 32, 64),
+    BENCH(Intra, aom_dc_128_predictor_32x8, c, 32, 8),
+    BENCH(Intra, aom_dc_128_predictor_32x8, sse2, 32, 8),
+    BENCH(Intra, aom_dc_128_predictor_4x16, c, 4, 16),
+    BENCH(Intra, aom_dc_128_predictor_4x16, sse2, 4, 16),
+    BENCH(Intra, aom_dc_128_predictor_4x8, c, 4, 8),
+    BENCH(Intra, aom_dc_128_predictor_4x8, sse2, 4, 8),
+    BENCH(Intra, aom_dc_128_predictor_64x16, c, 64, 16),
+    BENCH(Intra, aom_dc_128_predictor_64x16, avx2, 64, 16),
+    BENCH(Intra, aom_dc_128_predictor_64x32, c, 64, 32),
+    BENCH(Intra, aom_dc_128_predictor_64x32, avx2, 64, 32),
+    BENCH(Intra, aom_dc_128_predictor_8x16, c, 8, 16),
+    BENCH(Intra, aom_dc_128_predictor_8x16, sse2, 8, 16),
+    BENCH(Intra, aom_dc_128_predictor_8x32, c, 8, 32),
+    BENCH(Intra, aom_dc_128_predictor_8x32, sse2, 8, 32),
+    BENCH(Intra, aom_dc_128_predictor_8x4, c, 8, 4),
+    BENCH(Intra, aom_dc_128_predictor_8x4, sse2, 8, 4),
+    BENCH(Intra, aom_smooth_h_predictor_16x32, c, 16, 32),
+    BENCH(Intra, aom_smooth_h_predictor_16x32, ssse3, 16, 32),
+    BENCH(Intra, aom_smooth_h_predictor_16x4, c, 16, 4),
+    BENCH(Intra, aom_smooth_h_predictor_16x4, ssse3, 16, 4),
+    BENCH(Intra, aom_smooth_h_predictor_16x64, c, 16, 64),
+    BENCH(Intra, aom_smooth_h_predictor_16x64, ssse3, 16, 64),
+    BENCH(Intra, aom_smooth_h_predictor_16x8, c, 16, 8),
+    BENCH(Intra, aom_smooth_h_predictor_16x8, ssse3, 16, 8),
+    BENCH(Intra, aom_smooth_h_predictor_32x16, c, 32, 16),
+    BENCH(Intra, aom_smooth_h_predictor_32x16, ssse3, 32, 16),
+    BENCH(Intra, aom_smooth_h_predictor_32x64, c, 32, 64),
+    BENCH(Intra, aom_smooth_h_predictor_32x64, ssse3, 32, 64),
+    BENCH(Intra, aom_smooth_h_predictor_32x8, c, 32, 8),
+    BENCH(Intra, aom_smooth_h_predictor_32x8, ssse3, 32, 8),
+    BENCH(Intra, aom_smooth_h_predictor_4x16, c, 4, 16),
+    BENCH(Intra, aom_smooth_h_predictor_4x16, ssse3, 4, 16),
+    BENCH(Intra, aom_smooth_h_predictor_4x8, c, 4, 8),
+    BENCH(Intra, aom_smooth_h_predictor_4x8, ssse3, 4, 8),
+    BENCH(Intra, aom_smooth_h_predictor_64x16, c, 64, 16),
+    BENCH(Intra, aom_smooth_h_predictor_64x16, ssse3, 64, 16),
+    BENCH(Intra, aom_smooth_h_predictor_64x32, c, 64, 32),
+    BENCH(Intra, aom_smooth_h_predictor_64x32, ssse3, 64, 32),
+    BENCH(Intra, aom_smooth_h_predictor_8x16, c, 8, 16),
+    BENCH(Intra, aom_smooth_h_predictor_8x16, ssse3, 8, 16),
+    BENCH(Intra, aom_smooth_h_predictor_8x32, c, 8, 32),
+    BENCH(Intra, aom_smooth_h_predictor_8x32, ssse3, 8, 32),
+    BENCH(Intra, aom_smooth_h_predictor_8x4, c, 8, 4),
+    BENCH(Intra, aom_smooth_h_predictor_8x4, ssse3, 8, 4),
+    BENCH(Intra, aom_smooth_h_predictor_64x64, c, 64, 64),
+    BENCH(Intra, aom_smooth_h_predictor_64x64, ssse3, 64, 64),
+    BENCH(Intra, aom_smooth_h_predictor_32x32, c, 32, 32),
+    BENCH(Intra, aom_smooth_h_predictor_32x32, ssse3, 32, 32),
+    BENCH(Intra, aom_smooth_h_predictor_16x16, c, 16, 16),
+    BENCH(Intra, aom_smooth_h_predictor_16x16, ssse3, 16, 16),
+    BENCH(Intra, aom_smooth_h_predictor_8x8, c, 8, 8),
+    BENCH(Intra, aom_smooth_h_predictor_8x8, ssse3, 8, 8),
+    BENCH(Intra, aom_smooth_h_predictor_4x4, c, 4, 4),
+    BENCH(Intra, aom_smooth_h_predictor_4x4, ssse3, 4, 4),
+    BENCH(Intra, aom_smooth_v_predictor_16x32, ssse3, 16, 32),
+    BENCH(Intra, aom_smooth_v_predictor_16x4, c, 16, 4),
+    BENCH(Intra, aom_smooth_v_predictor_16x4, ssse3, 16, 4),
+    BENCH(Intra, aom_smooth_v_predictor_16x64, c, 16, 64),
+    BENCH(Intra, aom_smooth_v_predictor_16x64, ssse3, 16, 64),
+    BENCH(Intra, aom_smooth_v_predictor_16x8, c, 16, 8),
+    BENCH(Intra, aom_smooth_v_predictor_16x8, ssse3, 16, 8),
+    BENCH(Intra, aom_smooth_v_predictor_32x16, c, 32, 16),
+    BENCH(Intra, aom_smooth_v_predictor_32x16, ssse3, 32, 16),
+    BENCH(Intra, aom_smooth_v_predictor_32x64, c, 32, 64),
+    BENCH(Intra, aom_smooth_v_predictor_32x64, ssse3, 32, 64),
+    BENCH(Intra, aom_smooth_v_predictor_32x8, c, 32, 8),
+    BENCH(Intra, aom_smooth_v_predictor_32x8, ssse3, 32, 8),
+    BENCH(Intra, aom_smooth_v_predictor_4x16, c, 4, 16),
+    BENCH(Intra, aom_smooth_v_predictor_4x16, ssse3, 4, 16),
+    BENCH(Intra, aom_smooth_v_predictor_4x8, c, 4, 8),
+    BENCH(Intra, aom_smooth_v_predictor_4x8, ssse3, 4, 8),
+    BENCH(Intra, aom_smooth_v_predictor_64x16, c, 64, 16),
+    BENCH(Intra, aom_smooth_v_predictor_64x16, ssse3, 64, 16),
+    BENCH(Intra, aom_smooth_v_predictor_64x32, c, 64, 32),
+    BENCH(Intra, aom_smooth_v_predictor_64x32, ssse3, 64, 32),
+    BENCH(Intra, aom_smooth_v_predictor_8x16, c, 8, 16),
+    BENCH(Intra, aom_smooth_v_predictor_8x16, ssse3, 8, 16),
+    BENCH(Intra, aom_smooth_v_predictor_8x32, c, 8, 32),
+    BENCH(Intra, aom_smooth_v_predictor_8x32, ssse3, 8, 32),
+    BENCH(Intra, aom_smooth_v_predictor_8x4, c, 8, 4),
+    BENCH(Intra, aom_smooth_v_predictor_8x4, ssse3, 8, 4),
+    BENCH(Intra, aom_smooth_v_predictor_64x64, c, 64, 64),
+    BENCH(Intra, aom_smooth_v_predictor_64x64, ssse3, 64, 64),
+    BENCH(Intra, aom_smooth_v_predictor_32x32, c, 32, 32),
+    BENCH(Intra, aom_smooth_v_predictor_32x32, ssse3, 32, 32),
+    BENCH(Intra, aom_smooth_v_predictor_16x16, c, 16, 16),
+    BENCH(Intra, aom_smooth_v_predictor_16x16, ssse3, 16, 16),
+    BENCH(Intra, aom_smooth_v_predictor_8x8, c, 8, 8),
+    BENCH(Intra, aom_smooth_v_predictor_8x8, ssse3, 8, 8),
+    BENCH(Intra, aom_smooth_v_predictor_4x4, c, 4, 4),
+    BENCH(Intra, aom_smooth_v_predictor_4x4, ssse3, 4, 4),
+    BENCH(Intra, aom_smooth_predictor_16x32, c, 16, 32),
+    BENCH(Intra, aom_smooth_predictor_16x32, ssse3, 16, 32),
+    BENCH(Intra, aom_smooth_predictor_16x4, c, 16, 4),
+    BENCH(Intra, aom_smooth_predictor_16x4, ssse3, 16, 4),
+    BENCH(Intra, aom_smooth_predictor_16x64, c, 16, 64),
+    BENCH(Intra, aom_smooth_predictor_16x64, ssse3, 16, 64),
+    BENCH(Intra, aom_smooth_predictor_16x8, c, 16, 8),
+    BENCH(Intra, aom_smooth_predictor_16x8, ssse3, 16, 8),
+    BENCH(Intra, aom_smooth_predictor_32x16, c, 32, 16),
+    BENCH(Intra, aom_smooth_predictor_32x16, ssse3, 32, 16),
+    BENCH(Intra, aom_smooth_predictor_32x64, c, 32, 64),
+    BENCH(Intra, aom_smooth_predictor_32x64, ssse3, 32, 64),
+    BENCH(Intra, aom_smooth_predictor_32x8, c, 32, 8),
+    BENCH(Intra, aom_smooth_predictor_32x8, ssse3, 32, 8),
+    BENCH(Intra, aom_smooth_predictor_4x16, c, 4, 16),
+    BENCH(Intra, aom_smooth_predictor_4x16, ssse3, 4, 16),
+    BENCH(Intra, aom_smooth_predictor_4x8, c, 4, 8),
+    BENCH(Intra, aom_smooth_predictor_4x8, ssse3, 4, 8),
+    BENCH(Intra, aom_smooth_predictor_64x16, c, 64, 16),
+    BENCH(Intra, aom_smooth_predictor_64x16, ssse3, 64, 16),
+    BENCH(Intra, aom_smooth_predictor_64x32, c, 64, 32),
+    BENCH(Intra, aom_smooth_predictor_64x32, ssse3, 64, 32),
+    BENCH(Intra, aom_smooth_predictor_8x16, c, 8, 16),
+    BENCH(Intra, aom_smooth_predictor_8x16, ssse3, 8, 16),
+    BENCH(Intra, aom_smooth_predictor_8x32, c, 8, 32),
+    BENCH(Intra, aom_smooth_predictor_8x32, ssse3, 8, 32),
+    BENCH(Intra, aom_smooth_predictor_8x4, c, 8, 4),
+    BENCH(Intra, aom_smooth_predictor_8x4, ssse3, 8, 4),
+    BENCH(Intra, aom_smooth_predictor_64x64, c, 64, 64),
+    BENCH(Intra, aom_smooth_predictor_64x64, ssse3, 64, 64),
+    BENCH(Intra, aom_smooth_predictor_32x32, c, 32, 32),
+    BENCH(Intra, aom_smooth_predictor_32x32, ssse3, 32, 32),
+    BENCH(Intra, aom_smooth_predictor_16x16, c, 16, 16),
+    BENCH(Intra, aom_smooth_predictor_16x16, ssse3, 16, 16),
+    BENCH(Intra, aom_smooth_predictor_8x8, c, 8, 8),
+    BENCH(Intra, aom_smooth_predictor_8x8, ssse3, 8, 8),
+    BENCH(Intra, aom_smooth_predictor_4x4, c, 4, 4),
+    BENCH(Intra, aom_smooth_predictor_4x4, ssse3, 4, 4),
+    BENCH(Intra, aom_v_predictor_4x4, c, 4, 4),
+    BENCH(Intra, aom_v_predictor_4x4, sse2, 4, 4),
+    BENCH(Intra, aom_v_predictor_8x8, c, 8, 8),
+    BENCH(Intra, aom_v_predictor_8x8, sse2, 8, 8),
+    BENCH(Intra, aom_v_predictor_16x16, c, 16, 16),
+    BENCH(Intra, aom_v_predictor_16x16, sse2, 16, 16),
+    BENCH(Intra, aom_v_predictor_32x32, c, 32, 32),
+    BENCH(Intra, aom_v_predictor_32x32, avx2, 32, 32),
+    BENCH(Intra, aom_v_predictor_64x64, c, 64, 64),
+    BENCH(Intra, aom_v_predictor_64x64, avx2, 64, 64),
+    BENCH(Intra, aom_v_predictor_16x32, c, 16, 32),
+    BENCH(Intra, aom_v_predictor_16x32, sse2, 16, 32),
+    BENCH(Intra, aom_v_predictor_16x4, c, 16, 4),
+    BENCH(Intra, aom_v_predictor_16x4, sse2, 16, 4),
+    BENCH(Intra, aom_v_predictor_16x64, c, 16, 64),
+    BENCH(Intra, aom_v_predictor_16x64, sse2, 16, 64),
+    BENCH(Intra, aom_v_predictor_16x8, c, 16, 8),
+    BENCH(Intra, aom_v_predictor_16x8, sse2, 16, 8),
+    BENCH(Intra, aom_v_predictor_32x16, c, 32, 16),
+    BENCH(Intra, aom_v_predictor_32x16, avx2, 32, 16),
+    BENCH(Intra, aom_v_predictor_32x64, c, 32, 64),
+    BENCH(Intra, aom_v_predictor_32x64, avx2, 32, 64),
+    BENCH(Intra, aom_v_predictor_32x8, c, 32, 8),
+    BENCH(Intra, aom_v_predictor_32x8, sse2, 32, 8),
+    BENCH(Intra, aom_v_predictor_4x16, c, 4, 16),
+    BENCH(Intra, aom_v_predictor_4x16, sse2, 4, 16),
+    BENCH(Intra, aom_v_predictor_4x8, c, 4, 8),
+    BENCH(Intra, aom_v_predictor_4x8, sse2, 4, 8),
+    BENCH(Intra, aom_v_predictor_64x16, c, 64, 16),
+    BENCH(Intra, aom_v_predictor_64x16, avx2, 64, 16),
+    BENCH(Intra, aom_v_predictor_64x32, c, 64, 32),
+    BENCH(Intra, aom_v_predictor_64x32, avx2, 64, 32),
+    BENCH(Intra, aom_v_predictor_8x16, c, 8, 16),
+    BENCH(Intra, aom_v_predictor_8x16, sse2, 8, 16),
+    BENCH(Intra, aom_v_predictor_8x32, c, 8, 32),
+    BENCH(Intra, aom_v_predictor_8x32, sse2, 8, 32),
+    BENCH(Intra, aom_v_predictor_8x4, c, 8, 4),
+    BENCH(Intra, aom_v_predictor_8x4, sse2, 8, 4),
+    BENCH(Intra, aom_h_predictor_4x4, c, 4, 4),
+    BENCH(Intra, aom_h_predictor_4x4, sse2, 4, 4),
+    BENCH(Intra, aom_h_predictor_8x8, c, 8, 8),
+    BENCH(Intra, aom_h_predictor_8x8, sse2, 8, 8),
+    BENCH(Intra, aom_h_predictor_16x16, c, 16, 16),
+    BENCH(Intra, aom_h_predictor_16x16, sse2, 16, 16),
+    BENCH(Intra, aom_h_predictor_32x32, c, 32, 32),
+    BENCH(Intra, aom_h_predictor_32x32, avx2, 32, 32),
+    BENCH(Intra, aom_h_predictor_64x64, c, 64, 64),
+    BENCH(Intra, aom_h_predictor_64x64, sse2, 64, 64),
+    BENCH(Intra, aom_h_predictor_16x32, c, 16, 32),
+    BENCH(Intra, aom_h_predictor_16x32, sse2, 16, 32),
+    BENCH(Intra, aom_h_predictor_16x4, c, 16, 4),
+    BENCH(Intra, aom_h_predictor_16x4, sse2, 16, 4),
+    BENCH(Intra, aom_h_predictor_16x64, c, 16, 64),
+    BENCH(Intra, aom_h_predictor_16x64, sse2, 16, 64),
+    BENCH(Intra, aom_h_predictor_16x8, c, 16, 8),
+    BENCH(Intra, aom_h_predictor_16x8, sse2, 16, 8),
+    BENCH(Intra, aom_h_predictor_32x16, c, 32, 16),
+    BENCH(Intra, aom_h_predictor_32x16, sse2, 32, 16),
+    BENCH(Intra, aom_h_predictor_32x64, c, 32, 64),
+    BENCH(Intra, aom_h_predictor_32x64, sse2, 32, 64),
+    BENCH(Intra, aom_h_predictor_32x8, c, 32, 8),
+    BENCH(Intra, aom_h_predictor_32x8, sse2, 32, 8),
+    BENCH(Intra, aom_h_predictor_4x16, c, 4, 16),
+    BENCH(Intra, aom_h_predictor_4x16, sse2, 4, 16),
+    BENCH(Intra, aom_h_predictor_4x8, c, 4, 8),
+    BENCH(Intra, aom_h_predictor_4x8, sse2, 4, 8),
+    BENCH(Intra, aom_h_predictor_64x16, c, 64, 16),
+    BENCH(Intra, aom_h_predictor_64x16, sse2, 64, 16),
+    BENCH(Intra, aom_h_predictor_64x32, c, 64, 32),
+    BENCH(Intra, aom_h_predictor_64x32, sse2, 64, 32),
+    BENCH(Intra, aom_h_predictor_8x16, c, 8, 16),
+    BENCH(Intra, aom_h_predictor_8x16, sse2, 8, 16),
+    BENCH(Intra, aom_h_predictor_8x32, c, 8, 32),
+    BENCH(Intra, aom_h_predictor_8x32, sse2, 8, 32),
+    BENCH(Intra, aom_h_predictor_8x4, c, 8, 4),
+    BENCH(Intra, aom_h_predictor_8x4, sse2, 8, 4),
+    BENCH(IntraHbd, aom_highbd_smooth_v_predictor_16x16, c, 16, 16),
+    BENCH(IntraHbd, aom_highbd_smooth_v_predictor_16x16, avx2, 16, 16),
+    BENCH(IntraHbd, aom_highbd_smooth_v_predictor_16x32, c, 16, 32),
+    BENCH(IntraHbd, aom_highbd_smooth_v_predictor_16x32, avx2, 16, 32),
+    BENCH(IntraHbd, aom_highbd_smooth_v_predictor_16x4, c, 16, 4),
+    BENCH(IntraHbd, aom_highbd_smooth_v_predictor_16x4, avx2, 16, 4),
+    BENCH(IntraHbd, aom_highbd_smooth_v_predictor_16x64, c, 16, 64),
+    BENCH(IntraHbd, aom_highbd_smooth_v_predictor_16x64, avx2, 16, 64),
+    BENCH(IntraHbd, aom_highbd_smooth_v_predictor_16x8, c, 16, 8),
+    BENCH(IntraHbd, aom_highbd_smooth_v_predictor_16x8, avx2, 16, 8),
+    BENCH(IntraHbd, aom_highbd_smooth_v_predictor_2x2, c, 2, 2),
+    BENCH(IntraHbd, aom_highbd_smooth_v_predictor_32x16, c, 32, 16),
+    BENCH(IntraHbd, aom_highbd_smooth_v_predictor_32x16, avx2, 32, 16),
+    BENCH(IntraHbd, aom_highbd_smooth_v_predictor_32x32, c, 32, 32),
+    BENCH(IntraHbd, aom_highbd_smooth_v_predictor_32x32, avx2, 32, 32),
+    BENCH(IntraHbd, aom_highbd_smooth_v_predictor_32x64, c, 32, 64),
+    BENCH(IntraHbd, aom_highbd_smooth_v_predictor_32x64, avx2, 32, 64),
+    BENCH(IntraHbd, aom_highbd_smooth_v_predictor_32x8, c, 32, 8),
+    BENCH(IntraHbd, aom_highbd_smooth_v_predictor_32x8, avx2, 32, 8),
+    BENCH(IntraHbd, aom_highbd_smooth_v_predictor_4x16, c, 4, 16),
+    BENCH(IntraHbd, aom_highbd_smooth_v_predictor_4x16, ssse3, 4, 16),
+    BENCH(IntraHbd, aom_highbd_smooth_v_predictor_4x4, c, 4, 4),
+    BENCH(IntraHbd, aom_highbd_smooth_v_predictor_4x4, ssse3, 4, 4),
+    BENCH(IntraHbd, aom_highbd_smooth_v_predictor_4x8, c, 4, 8),
+    BENCH(IntraHbd, aom_highbd_smooth_v_predictor_4x8, ssse3, 4, 8),
+    BENCH(IntraHbd, aom_highbd_smooth_v_predictor_64x16, c, 64, 16),
+    BENCH(IntraHbd, aom_highbd_smooth_v_predictor_64x16, avx2, 64, 16),
+    BENCH(IntraHbd, aom_highbd_smooth_v_predictor_64x32, c, 64, 32),
+    BENCH(IntraHbd, aom_highbd_smooth_v_predictor_64x32, avx2, 64, 32),
+    BENCH(IntraHbd, aom_highbd_smooth_v_predictor_64x64, c, 64, 64),
+    BENCH(IntraHbd, aom_highbd_smooth_v_predictor_64x64, avx2, 64, 64),
+    BENCH(IntraHbd, aom_highbd_smooth_v_predictor_8x16, c, 8, 16),
+    BENCH(IntraHbd, aom_highbd_smooth_v_predictor_8x16, avx2, 8, 16),
+    BENCH(IntraHbd, aom_highbd_smooth_v_predictor_8x32, c, 8, 32),
+    BENCH(IntraHbd, aom_highbd_smooth_v_predictor_8x32, avx2, 8, 32),
+    BENCH(IntraHbd, aom_highbd_smooth_v_predictor_8x4, c, 8, 4),
+    BENCH(IntraHbd, aom_highbd_smooth_v_predictor_8x4, avx2, 8, 4),
+    BENCH(IntraHbd, aom_highbd_smooth_v_predictor_8x8, c, 8, 8),
+    BENCH(IntraHbd, aom_highbd_smooth_v_predictor_8x8, avx2, 8, 8),
+    BENCH(IntraHbd, aom_highbd_paeth_predictor_16x16, c, 16, 16),
+    BENCH(IntraHbd, aom_highbd_paeth_predictor_16x16, avx2, 16, 16),
+    BENCH(IntraHbd, aom_highbd_paeth_predictor_16x32, c, 16, 32),
+    BENCH(IntraHbd, aom_highbd_paeth_predictor_16x32, avx2, 16, 32),
+    BENCH(IntraHbd, aom_highbd_paeth_predictor_16x4, c, 16, 4),
+    BENCH(IntraHbd, aom_highbd_paeth_predictor_16x4, avx2, 16, 4),
+    BENCH(IntraHbd, aom_highbd_paeth_predictor_16x64, c, 16, 64),
+    BENCH(IntraHbd, aom_highbd_paeth_predictor_16x64, avx2, 16, 64),
+    BENCH(IntraHbd, aom_highbd_paeth_predictor_16x8, c, 16, 8),
+    BENCH(IntraHbd, aom_highbd_paeth_predictor_16x8, avx2, 16, 8),
+    BENCH(IntraHbd, aom_highbd_paeth_predictor_2x2, c, 2, 2),
+    BENCH(IntraHbd, aom_highbd_paeth_predictor_2x2, avx2, 2, 2),
+    BENCH(IntraHbd, aom_highbd_paeth_predictor_32x16, c, 32, 16),
+    BENCH(IntraHbd, aom_highbd_paeth_predictor_32x16, avx2, 32, 16),
+    BENCH(IntraHbd, aom_highbd_paeth_predictor_32x32, c, 32, 32),
+    BENCH(IntraHbd, aom_highbd_paeth_predictor_32x32, avx2, 32, 32),
+    BENCH(IntraHbd, aom_highbd_paeth_predictor_32x64, c, 32, 64),
+    BENCH(IntraHbd, aom_highbd_paeth_predictor_32x64, avx2, 32, 64),
+    BENCH(IntraHbd, aom_highbd_paeth_predictor_32x8, c, 32, 8),
+    BENCH(IntraHbd, aom_highbd_paeth_predictor_32x8, avx2, 32, 8),
+    BENCH(IntraHbd, aom_highbd_paeth_predictor_4x16, c, 4, 16),
+    BENCH(IntraHbd, aom_highbd_paeth_predictor_4x16, avx2, 4, 16),
+    BENCH(IntraHbd, aom_highbd_paeth_predictor_4x4, c, 4, 4),
+    BENCH(IntraHbd, aom_highbd_paeth_predictor_4x4, avx2, 4, 4),
+    BENCH(IntraHbd, aom_highbd_paeth_predictor_4x8, c, 4, 8),
+    BENCH(IntraHbd, aom_highbd_paeth_predictor_4x8, avx2, 4, 8),
+    BENCH(IntraHbd, aom_highbd_paeth_predictor_64x16, c, 64, 16),
+    BENCH(IntraHbd, aom_highbd_paeth_predictor_64x16, avx2, 64, 16),
+    BENCH(IntraHbd, aom_highbd_paeth_predictor_64x32, c, 64, 32),
+    BENCH(IntraHbd, aom_highbd_paeth_predictor_64x32, avx2, 64, 32),
+    BENCH(IntraHbd, aom_highbd_paeth_predictor_64x64, c, 64, 64),
+    BENCH(IntraHbd, aom_highbd_paeth_predictor_64x64, avx2, 64, 64),
+    BENCH(IntraHbd, aom_highbd_paeth_predictor_8x16, c, 8, 16),
+    BENCH(IntraHbd, aom_highbd_paeth_predictor_8x16, avx2, 8, 16),
+    BENCH(IntraHbd, aom_highbd_paeth_predictor_8x32, c, 8, 32),
+    BENCH(IntraHbd, aom_highbd_paeth_predictor_8x32, avx2, 8, 32),
+    BENCH(IntraHbd, aom_highbd_paeth_predictor_8x4, c, 8, 4),
+    BENCH(IntraHbd, aom_highbd_paeth_predictor_8x4, avx2, 8, 4),
+    BENCH(IntraHbd, aom_highbd_paeth_predictor_8x8, c, 8, 8),
+    BENCH(IntraHbd, aom_highbd_paeth_predictor_8x8, avx2, 8, 8),
+    BENCH(IntraHbd, aom_highbd_v_predictor_16x16, c, 16, 16),
+    BENCH(IntraHbd, aom_highbd_v_predictor_16x16, avx2, 16, 16),
+    BENCH(IntraHbd, aom_highbd_v_predictor_16x32, c, 16, 32),
+    BENCH(IntraHbd, aom_highbd_v_predictor_16x32, avx2, 16, 32),
+    BENCH(IntraHbd, aom_highbd_v_predictor_16x4, c, 16, 4),
+    BENCH(IntraHbd, aom_highbd_v_predictor_16x4, avx2, 16, 4),
+    BENCH(IntraHbd, aom_highbd_v_predictor_16x64, c, 16, 64),
+    BENCH(IntraHbd, aom_highbd_v_predictor_16x64, avx2, 16, 64),
+    BENCH(IntraHbd, aom_highbd_v_predictor_16x8, c, 16, 8),
+    BENCH(IntraHbd, aom_highbd_v_predictor_16x8, avx2, 16, 8),
+    BENCH(IntraHbd, aom_highbd_v_predictor_2x2, c, 2, 2),
+    BENCH(IntraHbd, aom_highbd_v_predictor_32x16, c, 32, 16),
+    BENCH(IntraHbd, aom_highbd_v_predictor_32x16, avx2, 32, 16),
+    BENCH(IntraHbd, aom_highbd_v_predictor_32x32, c, 32, 32),
+    BENCH(IntraHbd, aom_highbd_v_predictor_32x32, avx2, 32, 32),
+    BENCH(IntraHbd, aom_highbd_v_predictor_32x64, c, 32, 64),
+    BENCH(IntraHbd, aom_highbd_v_predictor_32x64, avx2, 32, 64),
+    BENCH(IntraHbd, aom_highbd_v_predictor_32x8, c, 32, 8),
+    BENCH(IntraHbd, aom_highbd_v_predictor_32x8, avx2, 32, 8),
+    BENCH(IntraHbd, aom_highbd_v_predictor_4x16, c, 4, 16),
+    BENCH(IntraHbd, aom_highbd_v_predictor_4x16, sse2, 4, 16),
+    BENCH(IntraHbd, aom_highbd_v_predictor_4x4, c, 4, 4),
+    BENCH(IntraHbd, aom_highbd_v_predictor_4x4, sse2, 4, 4),
+    BENCH(IntraHbd, aom_highbd_v_predictor_4x8, c, 4, 8),
+    BENCH(IntraHbd, aom_highbd_v_predictor_4x8, sse2, 4, 8),
+    BENCH(IntraHbd, aom_highbd_v_predictor_64x16, c, 64, 16),
+    BENCH(IntraHbd, aom_highbd_v_predictor_64x16, avx2, 64, 16),
+    BENCH(IntraHbd, aom_highbd_v_predictor_64x32, c, 64, 32),
+    BENCH(IntraHbd, aom_highbd_v_predictor_64x32, avx2, 64, 32),
+    BENCH(IntraHbd, aom_highbd_v_predictor_8x32, c, 8, 32),
+    BENCH(IntraHbd, aom_highbd_v_predictor_8x32, sse2, 8, 32),
+    BENCH(IntraHbd, aom_highbd_v_predictor_64x64, c, 64, 64),
+    BENCH(IntraHbd, aom_highbd_v_predictor_64x64, avx2, 64, 64),
+    BENCH(IntraHbd, aom_highbd_v_predictor_8x16, c, 8, 16),
+    BENCH(IntraHbd, aom_highbd_v_predictor_8x16, sse2, 8, 16),
+    BENCH(IntraHbd, aom_highbd_v_predictor_8x4, c, 8, 4),
+    BENCH(IntraHbd, aom_highbd_v_predictor_8x4, sse2, 8, 4),
+    BENCH(IntraHbd, aom_highbd_v_predictor_8x8, c, 8, 8),
+    BENCH(IntraHbd, aom_highbd_v_predictor_8x8, sse2, 8, 8),
+    BENCH(IntraHbd, aom_highbd_smooth_predictor_16x16, c, 16, 16),
+    BENCH(IntraHbd, aom_highbd_smooth_predictor_16x16, avx2, 16, 16),
+    BENCH(IntraHbd, aom_highbd_smooth_predictor_16x32, c, 16, 32),
+    BENCH(IntraHbd, aom_highbd_smooth_predictor_16x32, avx2, 16, 32),
+    BENCH(IntraHbd, aom_highbd_smooth_predictor_16x4, c, 16, 4),
+    BENCH(IntraHbd, aom_highbd_smooth_predictor_16x4, avx2, 16, 4),
+    BENCH(IntraHbd, aom_highbd_smooth_predictor_16x64, c, 16, 64),
+    BENCH(IntraHbd, aom_highbd_smooth_predictor_16x64, avx2, 16, 64),
+    BENCH(IntraHbd, aom_highbd_smooth_predictor_16x8, c, 16, 8),
+    BENCH(IntraHbd, aom_highbd_smooth_predictor_16x8, avx2, 16, 8),
+    BENCH(IntraHbd, aom_highbd_smooth_predictor_2x2, c, 2, 2),
+    BENCH(IntraHbd, aom_highbd_smooth_predictor_32x16, c, 32, 16),
+    BENCH(IntraHbd, aom_highbd_smooth_predictor_32x16, avx2, 32, 16),
+    BENCH(IntraHbd, aom_highbd_smooth_predictor_32x32, c, 32, 32),
+    BENCH(IntraHbd, aom_highbd_smooth_predictor_32x32, avx2, 32, 32),
+    BENCH(IntraHbd, aom_highbd_smooth_predictor_32x64, c, 32, 64),
+    BENCH(IntraHbd, aom_highbd_smooth_predictor_32x64, avx2, 32, 64),
+    BENCH(IntraHbd, aom_highbd_smooth_predictor_32x8, c, 32, 8),
+    BENCH(IntraHbd, aom_highbd_smooth_predictor_32x8, avx2, 32, 8),
+    BENCH(IntraHbd, aom_highbd_smooth_predictor_4x16, c, 4, 16),
+    BENCH(IntraHbd, aom_highbd_smooth_predictor_4x16, ssse3, 4, 16),
+    BENCH(IntraHbd, aom_highbd_smooth_predictor_4x4, c, 4, 4),
+    BENCH(IntraHbd, aom_highbd_smooth_predictor_4x4, ssse3, 4, 4),
+    BENCH(IntraHbd, aom_highbd_smooth_predictor_4x8, c, 4, 8),
+    BENCH(IntraHbd, aom_highbd_smooth_predictor_4x8, ssse3, 4, 8),
+    BENCH(IntraHbd, aom_highbd_smooth_predictor_64x16, c, 64, 16),
+    BENCH(IntraHbd, aom_highbd_smooth_predictor_64x16, avx2, 64, 16),
+    BENCH(IntraHbd, aom_highbd_smooth_predictor_64x32, c, 64, 32),
+    BENCH(IntraHbd, aom_highbd_smooth_predictor_64x32, avx2, 64, 32),
+    BENCH(IntraHbd, aom_highbd_smooth_predictor_64x64, c, 64, 64),
+    BENCH(IntraHbd, aom_highbd_smooth_predictor_64x64, avx2, 64, 64),
+    BENCH(IntraHbd, aom_highbd_smooth_predictor_8x16, c, 8, 16),
+    BENCH(IntraHbd, aom_highbd_smooth_predictor_8x16, avx2, 8, 16),
+    BENCH(IntraHbd, aom_highbd_smooth_predictor_8x32, c, 8, 32),
+    BENCH(IntraHbd, aom_highbd_smooth_predictor_8x32, avx2, 8, 32),
+    BENCH(IntraHbd, aom_highbd_smooth_predictor_8x4, c, 8, 4),
+    BENCH(IntraHbd, aom_highbd_smooth_predictor_8x4, avx2, 8, 4),
+    BENCH(IntraHbd, aom_highbd_smooth_predictor_8x8, c, 8, 8),
+    BENCH(IntraHbd, aom_highbd_smooth_predictor_8x8, avx2, 8, 8),
+    BENCH(IntraHbd, aom_highbd_smooth_h_predictor_16x16, c, 16, 16),
+    BENCH(IntraHbd, aom_highbd_smooth_h_predictor_16x16, avx2, 16, 16),
+    BENCH(IntraHbd, aom_highbd_smooth_h_predictor_16x32, c, 16, 32),
+    BENCH(IntraHbd, aom_highbd_smooth_h_predictor_16x32, avx2, 16, 32),
+    BENCH(IntraHbd, aom_highbd_smooth_h_predictor_16x4, c, 16, 4),
+    BENCH(IntraHbd, aom_highbd_smooth_h_predictor_16x4, avx2, 16, 4),
+    BENCH(IntraHbd, aom_highbd_smooth_h_predictor_16x64, c, 16, 64),
+    BENCH(IntraHbd, aom_highbd_smooth_h_predictor_16x64, avx2, 16, 64),
+    BENCH(IntraHbd, aom_highbd_smooth_h_predictor_16x8, c, 16, 8),
+    BENCH(IntraHbd, aom_highbd_smooth_h_predictor_16x8, avx2, 16, 8),
+    BENCH(IntraHbd, aom_highbd_smooth_h_predictor_2x2, c, 2, 2),
+    BENCH(IntraHbd, aom_highbd_smooth_h_predictor_32x16, c, 32, 16),
+    BENCH(IntraHbd, aom_highbd_smooth_h_predictor_32x16, avx2, 32, 16),
+    BENCH(IntraHbd, aom_highbd_smooth_h_predictor_32x32, c, 32, 32),
+    BENCH(IntraHbd, aom_highbd_smooth_h_predictor_32x32, avx2, 32, 32),
+    BENCH(IntraHbd, aom_highbd_smooth_h_predictor_32x64, c, 32, 64),
+    BENCH(IntraHbd, aom_highbd_smooth_h_predictor_32x64, avx2, 32, 64),
+    BENCH(IntraHbd, aom_highbd_smooth_h_predictor_32x8, c, 32, 8),
+    BENCH(IntraHbd, aom_highbd_smooth_h_predictor_32x8, avx2, 32, 8),
+    BENCH(IntraHbd, aom_highbd_smooth_h_predictor_4x16, c, 4, 16),
+    BENCH(IntraHbd, aom_highbd_smooth_h_predictor_4x16, ssse3, 4, 16),
+    BENCH(IntraHbd, aom_highbd_smooth_h_predictor_4x4, c, 4, 4),
+    BENCH(IntraHbd, aom_highbd_smooth_h_predictor_4x4, ssse3, 4, 4),
+    BENCH(IntraHbd, aom_highbd_smooth_h_predictor_4x8, c, 4, 8),
+    BENCH(IntraHbd, aom_highbd_smooth_h_predictor_4x8, ssse3, 4, 8),
+    BENCH(IntraHbd, aom_highbd_smooth_h_predictor_64x16, c, 64, 16),
+    BENCH(IntraHbd, aom_highbd_smooth_h_predictor_64x16, avx2, 64, 16),
+    BENCH(IntraHbd, aom_highbd_smooth_h_predictor_64x32, c, 64, 32),
+    BENCH(IntraHbd, aom_highbd_smooth_h_predictor_64x32, avx2, 64, 32),
+    BENCH(IntraHbd, aom_highbd_smooth_h_predictor_64x64, c, 64, 64),
+    BENCH(IntraHbd, aom_highbd_smooth_h_predictor_64x64, avx2, 64, 64),
+    BENCH(IntraHbd, aom_highbd_smooth_h_predictor_8x16, c, 8, 16),
+    BENCH(IntraHbd, aom_highbd_smooth_h_predictor_8x16, avx2, 8, 16),
+    BENCH(IntraHbd, aom_highbd_smooth_h_predictor_8x32, c, 8, 32),
+    BENCH(IntraHbd, aom_highbd_smooth_h_predictor_8x32, avx2, 8, 32),
+    BENCH(IntraHbd, aom_highbd_smooth_h_predictor_8x4, c, 8, 4),
+    BENCH(IntraHbd, aom_highbd_smooth_h_predictor_8x4, avx2, 8, 4),
+    BENCH(IntraHbd, aom_highbd_smooth_h_predictor_8x8, c, 8, 8),
+    BENCH(IntraHbd, aom_highbd_smooth_h_predictor_8x8, avx2, 8, 8),
+    BENCH(IntraHbd, aom_highbd_dc_128_predictor_16x16, c, 16, 16),
+    BENCH(IntraHbd, aom_highbd_dc_128_predictor_16x16, avx2, 16, 16),
+    BENCH(IntraHbd, aom_highbd_dc_128_predictor_16x32, c, 16, 32),
+    BENCH(IntraHbd, aom_highbd_dc_128_predictor_16x32, avx2, 16, 32),
+    BENCH(IntraHbd, aom_highbd_dc_128_predictor_16x4, c, 16, 4),
+    BENCH(IntraHbd, aom_highbd_dc_128_predictor_16x4, avx2, 16, 4),
+    BENCH(IntraHbd, aom_highbd_dc_128_predictor_16x64, c, 16, 64),
+    BENCH(IntraHbd, aom_highbd_dc_128_predictor_16x64, avx2, 16, 64),
+    BENCH(IntraHbd, aom_highbd_dc_128_predictor_16x8, c, 16, 8),
+    BENCH(IntraHbd, aom_highbd_dc_128_predictor_16x8, avx2, 16, 8),
+    BENCH(IntraHbd, aom_highbd_dc_128_predictor_2x2, c, 2, 2),
+    BENCH(IntraHbd, aom_highbd_dc_128_predictor_32x16, c, 32, 16),
+    BENCH(IntraHbd, aom_highbd_dc_128_predictor_32x16, avx2, 32, 16),
+    BENCH(IntraHbd, aom_highbd_dc_128_predictor_32x32, c, 32, 32),
+    BENCH(IntraHbd, aom_highbd_dc_128_predictor_32x32, avx2, 32, 32),
+    BENCH(IntraHbd, aom_highbd_dc_128_predictor_32x64, c, 32, 64),
+    BENCH(IntraHbd, aom_highbd_dc_128_predictor_32x64, avx2, 32, 64),
+    BENCH(IntraHbd, aom_highbd_dc_128_predictor_32x8, c, 32, 8),
+    BENCH(IntraHbd, aom_highbd_dc_128_predictor_32x8, avx2, 32, 8),
+    BENCH(IntraHbd, aom_highbd_dc_128_predictor_4x16, c, 4, 16),
+    BENCH(IntraHbd, aom_highbd_dc_128_predictor_4x16, sse2, 4, 16),
+    BENCH(IntraHbd, aom_highbd_dc_128_predictor_4x4, c, 4, 4),
+    BENCH(IntraHbd, aom_highbd_dc_128_predictor_4x4, sse2, 4, 4),
+    BENCH(IntraHbd, aom_highbd_dc_128_predictor_4x8, c, 4, 8),
+    BENCH(IntraHbd, aom_highbd_dc_128_predictor_4x8, sse2, 4, 8),
+    BENCH(IntraHbd, aom_highbd_dc_128_predictor_8x32, c, 8, 32),
+    BENCH(IntraHbd, aom_highbd_dc_128_predictor_8x32, sse2, 8, 32),
+    BENCH(IntraHbd, aom_highbd_dc_128_predictor_64x16, c, 64, 16),
+    BENCH(IntraHbd, aom_highbd_dc_128_predictor_64x16, avx2, 64, 16),
+    BENCH(IntraHbd, aom_highbd_dc_128_predictor_64x32, c, 64, 32),
+    BENCH(IntraHbd, aom_highbd_dc_128_predictor_64x32, avx2, 64, 32),
+    BENCH(IntraHbd, aom_highbd_dc_128_predictor_64x64, c, 64, 64),
+    BENCH(IntraHbd, aom_highbd_dc_128_predictor_64x64, avx2, 64, 64),
+    BENCH(IntraHbd, aom_highbd_dc_128_predictor_8x16, c, 8, 16),
+    BENCH(IntraHbd, aom_highbd_dc_128_predictor_8x16, sse2, 8, 16),
+    BENCH(IntraHbd, aom_highbd_dc_128_predictor_8x4, c, 8, 4),
+    BENCH(IntraHbd, aom_highbd_dc_128_predictor_8x4, sse2, 8, 4),
+    BENCH(IntraHbd, aom_highbd_dc_128_predictor_8x8, c, 8, 8),
+    BENCH(IntraHbd, aom_highbd_dc_128_predictor_8x8, sse2, 8, 8),
+    BENCH(IntraHbd, aom_highbd_dc_left_predictor_16x16, c, 16, 16),
+    BENCH(IntraHbd, aom_highbd_dc_left_predictor_16x16, avx2, 16, 16),
+    BENCH(IntraHbd, aom_highbd_dc_left_predictor_16x32, c, 16, 32),
+    BENCH(IntraHbd, aom_highbd_dc_left_predictor_16x32, avx2, 16, 32),
+    BENCH(IntraHbd, aom_highbd_dc_left_predictor_16x4, c, 16, 4),
+    BENCH(IntraHbd, aom_highbd_dc_left_predictor_16x4, avx2, 16, 4),
+    BENCH(IntraHbd, aom_highbd_dc_left_predictor_16x64, c, 16, 64),
+    BENCH(IntraHbd, aom_highbd_dc_left_predictor_16x64, avx2, 16, 64),
+    BENCH(IntraHbd, aom_highbd_dc_left_predictor_16x8, c, 16, 8),
+    BENCH(IntraHbd, aom_highbd_dc_left_predictor_16x8, avx2, 16, 8),
+    BENCH(IntraHbd, aom_highbd_dc_left_predictor_2x2, c, 2, 2),
+    BENCH(IntraHbd, aom_highbd_dc_left_predictor_32x16, c, 32, 16),
+    BENCH(IntraHbd, aom_highbd_dc_left_predictor_32x16, avx2, 32, 16),
+    BENCH(IntraHbd, aom_highbd_dc_left_predictor_32x32, c, 32, 32),
+    BENCH(IntraHbd, aom_highbd_dc_left_predictor_32x32, avx2, 32, 32),
+    BENCH(IntraHbd, aom_highbd_dc_left_predictor_32x64, c, 32, 64),
+    BENCH(IntraHbd, aom_highbd_dc_left_predictor_32x64, avx2, 32, 64),
+    BENCH(IntraHbd, aom_highbd_dc_left_predictor_32x8, c, 32, 8),
+    BENCH(IntraHbd, aom_highbd_dc_left_predictor_32x8, avx2, 32, 8),
+    BENCH(IntraHbd, aom_highbd_dc_left_predictor_4x16, c, 4, 16),
+    BENCH(IntraHbd, aom_highbd_dc_left_predictor_4x16, sse2, 4, 16),
+    BENCH(IntraHbd, aom_highbd_dc_left_predictor_4x4, c, 4, 4),
+    BENCH(IntraHbd, aom_highbd_dc_left_predictor_4x4, sse2, 4, 4),
+    BENCH(IntraHbd, aom_highbd_dc_left_predictor_4x8, c, 4, 8),
+    BENCH(IntraHbd, aom_highbd_dc_left_predictor_4x8, sse2, 4, 8),
+    BENCH(IntraHbd, aom_highbd_dc_left_predictor_8x32, c, 8, 32),
+    BENCH(IntraHbd, aom_highbd_dc_left_predictor_8x32, sse2, 8, 32),
+    BENCH(IntraHbd, aom_highbd_dc_left_predictor_64x16, c, 64, 16),
+    BENCH(IntraHbd, aom_highbd_dc_left_predictor_64x16, avx2, 64, 16),
+    BENCH(IntraHbd, aom_highbd_dc_left_predictor_64x32, c, 64, 32),
+    BENCH(IntraHbd, aom_highbd_dc_left_predictor_64x32, avx2, 64, 32),
+    BENCH(IntraHbd, aom_highbd_dc_left_predictor_64x64, c, 64, 64),
+    BENCH(IntraHbd, aom_highbd_dc_left_predictor_64x64, avx2, 64, 64),
+    BENCH(IntraHbd, aom_highbd_dc_left_predictor_8x16, c, 8, 16),
+    BENCH(IntraHbd, aom_highbd_dc_left_predictor_8x16, sse2, 8, 16),
+    BENCH(IntraHbd, aom_highbd_dc_left_predictor_8x4, c, 8, 4),
+    BENCH(IntraHbd, aom_highbd_dc_left_predictor_8x4, sse2, 8, 4),
+    BENCH(IntraHbd, aom_highbd_dc_left_predictor_8x8, c, 8, 8),
+    BENCH(IntraHbd, aom_highbd_dc_left_predictor_8x8, sse2, 8, 8),
+    BENCH(IntraHbd, aom_highbd_dc_predictor_16x16, c, 16, 16),
+    BENCH(IntraHbd, aom_highbd_dc_predictor_16x16, avx2, 16, 16),
+    BENCH(IntraHbd, aom_highbd_dc_predictor_16x32, c, 16, 32),
+    BENCH(IntraHbd, aom_highbd_dc_predictor_16x32, avx2, 16, 32),
+    BENCH(IntraHbd, aom_highbd_dc_predictor_16x4, c, 16, 4),
+    BENCH(IntraHbd, aom_highbd_dc_predictor_16x4, avx2, 16, 4),
+    BENCH(IntraHbd, aom_highbd_dc_predictor_16x64, c, 16, 64),
+    BENCH(IntraHbd, aom_highbd_dc_predictor_16x64, avx2, 16, 64),
+    BENCH(IntraHbd, aom_highbd_dc_predictor_16x8, c, 16, 8),
+    BENCH(IntraHbd, aom_highbd_dc_predictor_16x8, avx2, 16, 8),
+    BENCH(IntraHbd, aom_highbd_dc_predictor_2x2, c, 2, 2),
+    BENCH(IntraHbd, aom_highbd_dc_predictor_32x16, c, 32, 16),
+    BENCH(IntraHbd, aom_highbd_dc_predictor_32x16, avx2, 32, 16),
+    BENCH(IntraHbd, aom_highbd_dc_predictor_32x32, c, 32, 32),
+    BENCH(IntraHbd, aom_highbd_dc_predictor_32x32, avx2, 32, 32),
+    BENCH(IntraHbd, aom_highbd_dc_predictor_32x64, c, 32, 64),
+    BENCH(IntraHbd, aom_highbd_dc_predictor_32x64, avx2, 32, 64),
+    BENCH(IntraHbd, aom_highbd_dc_predictor_32x8, c, 32, 8),
+    BENCH(IntraHbd, aom_highbd_dc_predictor_32x8, avx2, 32, 8),
+    BENCH(IntraHbd, aom_highbd_dc_predictor_4x16, c, 4, 16),
+    BENCH(IntraHbd, aom_highbd_dc_predictor_4x16, sse2, 4, 16),
+    BENCH(IntraHbd, aom_highbd_dc_predictor_4x4, c, 4, 4),
+    BENCH(IntraHbd, aom_highbd_dc_predictor_4x4, sse2, 4, 4),
+    BENCH(IntraHbd, aom_highbd_dc_predictor_4x8, c, 4, 8),
+    BENCH(IntraHbd, aom_highbd_dc_predictor_4x8, sse2, 4, 8),
+    BENCH(IntraHbd, aom_highbd_dc_predictor_64x16, c, 64, 16),
+    BENCH(IntraHbd, aom_highbd_dc_predictor_64x16, avx2, 64, 16),
+    BENCH(IntraHbd, aom_highbd_dc_predictor_64x32, c, 64, 32),
+    BENCH(IntraHbd, aom_highbd_dc_predictor_64x32, avx2, 64, 32),
+    BENCH(IntraHbd, aom_highbd_dc_predictor_64x64, c, 64, 64),
+    BENCH(IntraHbd, aom_highbd_dc_predictor_64x64, avx2, 64, 64),
+    BENCH(IntraHbd, aom_highbd_dc_predictor_8x16, c, 8, 16),
+    BENCH(IntraHbd, aom_highbd_dc_predictor_8x16, sse2, 8, 16),
+    BENCH(IntraHbd, aom_highbd_dc_predictor_8x4, c, 8, 4),
+    BENCH(IntraHbd, aom_highbd_dc_predictor_8x4, sse2, 8, 4),
+    BENCH(IntraHbd, aom_highbd_dc_predictor_8x8, c, 8, 8),
+    BENCH(IntraHbd, aom_highbd_dc_predictor_8x8, sse2, 8, 8),
+    BENCH(IntraHbd, aom_highbd_dc_predictor_8x32, c, 8, 32),
+    BENCH(IntraHbd, aom_highbd_dc_predictor_8x32, sse2, 8, 32),
+    BENCH(IntraHbd, aom_highbd_dc_top_predictor_16x16, c, 16, 16),
+    BENCH(IntraHbd, aom_highbd_dc_top_predictor_16x16, avx2, 16, 16),
+    BENCH(IntraHbd, aom_highbd_dc_top_predictor_16x32, c, 16, 32),
+    BENCH(IntraHbd, aom_highbd_dc_top_predictor_16x32, avx2, 16, 32),
+    BENCH(IntraHbd, aom_highbd_dc_top_predictor_16x4, c, 16, 4),
+    BENCH(IntraHbd, aom_highbd_dc_top_predictor_16x4, avx2, 16, 4),
+    BENCH(IntraHbd, aom_highbd_dc_top_predictor_16x64, c, 16, 64),
+    BENCH(IntraHbd, aom_highbd_dc_top_predictor_16x64, avx2, 16, 64),
+    BENCH(IntraHbd, aom_highbd_dc_top_predictor_16x8, c, 16, 8),
+    BENCH(IntraHbd, aom_highbd_dc_top_predictor_16x8, avx2, 16, 8),
+    BENCH(IntraHbd, aom_highbd_dc_top_predictor_2x2, c, 2, 2),
+    BENCH(IntraHbd, aom_highbd_dc_top_predictor_32x16, c, 32, 16),
+    BENCH(IntraHbd, aom_highbd_dc_top_predictor_32x16, avx2, 32, 16),
+    BENCH(IntraHbd, aom_highbd_dc_top_predictor_32x32, c, 32, 32),
+    BENCH(IntraHbd, aom_highbd_dc_top_predictor_32x32, avx2, 32, 32),
+    BENCH(IntraHbd, aom_highbd_dc_top_predictor_32x64, c, 32, 64),
+    BENCH(IntraHbd, aom_highbd_dc_top_predictor_32x64, avx2, 32, 64),
+    BENCH(IntraHbd, aom_highbd_dc_top_predictor_32x8, c, 32, 8),
+    BENCH(IntraHbd, aom_highbd_dc_top_predictor_32x8, avx2, 32, 8),
+    BENCH(IntraHbd, aom_highbd_dc_top_predictor_4x16, c, 4, 16),
+    BENCH(IntraHbd, aom_highbd_dc_top_predictor_4x16, sse2, 4, 16),
+    BENCH(IntraHbd, aom_highbd_dc_top_predictor_4x4, c, 4, 4),
+    BENCH(IntraHbd, aom_highbd_dc_top_predictor_4x4, sse2, 4, 4),
+    BENCH(IntraHbd, aom_highbd_dc_top_predictor_4x8, c, 4, 8),
+    BENCH(IntraHbd, aom_highbd_dc_top_predictor_4x8, sse2, 4, 8),
+    BENCH(IntraHbd, aom_highbd_dc_top_predictor_64x16, c, 64, 16),
+    BENCH(IntraHbd, aom_highbd_dc_top_predictor_64x16, avx2, 64, 16),
+    BENCH(IntraHbd, aom_highbd_dc_top_predictor_64x32, c, 64, 32),
+    BENCH(IntraHbd, aom_highbd_dc_top_predictor_64x32, avx2, 64, 32),
+    BENCH(IntraHbd, aom_highbd_dc_top_predictor_64x64, c, 64, 64),
+    BENCH(IntraHbd, aom_highbd_dc_top_predictor_64x64, avx2, 64, 64),
+    BENCH(IntraHbd, aom_highbd_dc_top_predictor_8x16, c, 8, 16),
+    BENCH(IntraHbd, aom_highbd_dc_top_predictor_8x16, sse2, 8, 16),
+    BENCH(IntraHbd, aom_highbd_dc_top_predictor_8x32, c, 8, 32),
+    BENCH(IntraHbd, aom_highbd_dc_top_predictor_8x4, c, 8, 4),
+    BENCH(IntraHbd, aom_highbd_dc_top_predictor_8x4, sse2, 8, 4),
+    BENCH(IntraHbd, aom_highbd_dc_top_predictor_8x8, c, 8, 8),
+    BENCH(IntraHbd, aom_highbd_dc_top_predictor_8x8, sse2, 8, 8),
+    BENCH(IntraHbd, aom_highbd_h_predictor_16x4, c, 16, 4),
+    BENCH(IntraHbd, aom_highbd_h_predictor_16x4, avx2, 16, 4),
+    BENCH(IntraHbd, aom_highbd_h_predictor_16x64, c, 16, 64),
+    BENCH(IntraHbd, aom_highbd_h_predictor_16x64, avx2, 16, 64),
+    BENCH(IntraHbd, aom_highbd_h_predictor_16x8, c, 16, 8),
+    BENCH(IntraHbd, aom_highbd_h_predictor_16x8, sse2, 16, 8),
+    BENCH(IntraHbd, aom_highbd_h_predictor_2x2, c, 2, 2),
+    BENCH(IntraHbd, aom_highbd_h_predictor_32x16, c, 32, 16),
+    BENCH(IntraHbd, aom_highbd_h_predictor_32x16, sse2, 32, 16),
+    BENCH(IntraHbd, aom_highbd_h_predictor_32x32, c, 32, 32),
+    BENCH(IntraHbd, aom_highbd_h_predictor_32x32, sse2, 32, 32),
+    BENCH(IntraHbd, aom_highbd_h_predictor_32x64, c, 32, 64),
+    BENCH(IntraHbd, aom_highbd_h_predictor_32x64, avx2, 32, 64),
+    BENCH(IntraHbd, aom_highbd_h_predictor_32x8, c, 32, 8),
+    BENCH(IntraHbd, aom_highbd_h_predictor_32x8, avx2, 32, 8),
+    BENCH(IntraHbd, aom_highbd_h_predictor_4x16, c, 4, 16),
+    BENCH(IntraHbd, aom_highbd_h_predictor_4x16, sse2, 4, 16),
+    BENCH(IntraHbd, aom_highbd_h_predictor_4x4, c, 4, 4),
+    BENCH(IntraHbd, aom_highbd_h_predictor_4x4, sse2, 4, 4),
+    BENCH(IntraHbd, aom_highbd_h_predictor_4x8, c, 4, 8),
+    BENCH(IntraHbd, aom_highbd_h_predictor_4x8, sse2, 4, 8),
+    BENCH(IntraHbd, aom_highbd_h_predictor_64x16, c, 64, 16),
+    BENCH(IntraHbd, aom_highbd_h_predictor_64x16, avx2, 64, 16),
+    BENCH(IntraHbd, aom_highbd_h_predictor_64x32, c, 64, 32),
+    BENCH(IntraHbd, aom_highbd_h_predictor_64x32, avx2, 64, 32),
+    BENCH(IntraHbd, aom_highbd_h_predictor_8x32, c, 8, 32),
+    BENCH(IntraHbd, aom_highbd_h_predictor_8x32, sse2, 8, 32),
+    BENCH(IntraHbd, aom_highbd_h_predictor_64x64, c, 64, 64),
+    BENCH(IntraHbd, aom_highbd_h_predictor_64x64, avx2, 64, 64),
+    BENCH(IntraHbd, aom_highbd_h_predictor_8x16, c, 8, 16),
+    BENCH(IntraHbd, aom_highbd_h_predictor_8x16, sse2, 8, 16),
+    BENCH(IntraHbd, aom_highbd_h_predictor_8x4, c, 8, 4),
+    BENCH(IntraHbd, aom_highbd_h_predictor_8x4, sse2, 8, 4),
+    BENCH(IntraHbd, aom_highbd_h_predictor_8x8, c, 8, 8),
+    BENCH(IntraHbd, aom_highbd_h_predictor_8x8, sse2, 8, 8),
+    BENCH(IntraHbd, aom_highbd_h_predictor_16x16, c, 16, 16),
+    BENCH(IntraHbd, aom_highbd_h_predictor_16x16, sse2, 16, 16),
+    BENCH(IntraHbd, aom_highbd_h_predictor_16x32, c, 16, 32),
+    BENCH(IntraHbd, aom_highbd_h_predictor_16x32, sse2, 16, 32),
+    BENCH(FwdTxfm, av1_fwd_txfm2d_16x8, c, 16, 8),
+    BENCH(FwdTxfm, av1_fwd_txfm2d_16x8, avx2, 16, 8),
+    BENCH(FwdTxfm, av1_fwd_txfm2d_8x16, c, 8, 16),
+    BENCH(FwdTxfm, av1_fwd_txfm2d_8x16, avx2, 8, 16),
+    BENCH(FwdTxfm, av1_fwd_txfm2d_16x4, c, 16, 4),
+    BENCH(FwdTxfm, av1_fwd_txfm2d_16x4, avx2, 16, 4),
+    BENCH(FwdTxfm, av1_fwd_txfm2d_4x16, c, 4, 16),
+    BENCH(FwdTxfm, av1_fwd_txfm2d_4x16, avx2, 4, 16),
+    BENCH(FwdTxfm, av1_fwd_txfm2d_8x4, c, 8, 4),
+    BENCH(FwdTxfm, av1_fwd_txfm2d_8x4, avx2, 8, 4),
+    BENCH(FwdTxfm, av1_fwd_txfm2d_4x8, c, 4, 8),
+    BENCH(FwdTxfm, av1_fwd_txfm2d_4x8, avx2, 4, 8),
+    BENCH(FwdTxfm, av1_fwd_txfm2d_32x16, c, 32, 16),
+    BENCH(FwdTxfm, av1_fwd_txfm2d_32x16, avx2, 32, 16),
+    BENCH(FwdTxfm, av1_fwd_txfm2d_32x8, c, 32, 8),
+    BENCH(FwdTxfm, av1_fwd_txfm2d_32x8, avx2, 32, 8),
+    BENCH(FwdTxfm, av1_fwd_txfm2d_8x32, c, 8, 32),
+    BENCH(FwdTxfm, av1_fwd_txfm2d_8x32, avx2, 8, 32),
+    BENCH(FwdTxfm, av1_fwd_txfm2d_16x32, c, 16, 32),
+    BENCH(FwdTxfm, av1_fwd_txfm2d_16x32, avx2, 16, 32),
+    BENCH(FwdTxfm, av1_fwd_txfm2d_32x64, c, 32, 64),
+    BENCH(FwdTxfm, av1_fwd_txfm2d_32x64, avx2, 32, 64),
+    BENCH(FwdTxfm, av1_fwd_txfm2d_64x32, c, 64, 32),
+    BENCH(FwdTxfm, av1_fwd_txfm2d_64x32, avx2, 64, 32),
+    BENCH(FwdTxfm, av1_fwd_txfm2d_16x64, c, 16, 64),
+    BENCH(FwdTxfm, av1_fwd_txfm2d_16x64, avx2, 16, 64),
+    BENCH(FwdTxfm, av1_fwd_txfm2d_64x16, c, 64, 16),
+    BENCH(FwdTxfm, av1_fwd_txfm2d_64x16, avx2, 64, 16),
+    BENCH_IMPL(FwdTxfm, av1_fwd_txfm2d_64x64, c, 64, 64, Av1TransformTwoD_64x64_c),
+    BENCH(FwdTxfm, av1_fwd_txfm2d_64x64, avx2, 64, 64),
+    BENCH_IMPL(FwdTxfm, av1_fwd_txfm2d_32x32, c, 32, 32, Av1TransformTwoD_32x32_c),
+    BENCH(FwdTxfm, av1_fwd_txfm2d_32x32, avx2, 32, 32),
+    BENCH_IMPL(FwdTxfm, av1_fwd_txfm2d_16x16, c, 16, 16, Av1TransformTwoD_16x16_c),
+    BENCH(FwdTxfm, av1_fwd_txfm2d_16x16, avx2, 16, 16),
+    BENCH_IMPL(FwdTxfm, av1_fwd_txfm2d_8x8, c, 8, 8, Av1TransformTwoD_8x8_c),
+    BENCH(FwdTxfm, av1_fwd_txfm2d_8x8, avx2, 8, 8),
+    BENCH_IMPL(FwdTxfm, av1_fwd_txfm2d_4x4, c, 4, 4, Av1TransformTwoD_4x4_c),
+    BENCH(FwdTxfm, av1_fwd_txfm2d_4x4, sse4_1, 4, 4),
+    BENCH(InvTxfm, av1_inv_txfm2d_add_16x16, c, 16, 16),
+    BENCH(InvTxfm, av1_inv_txfm2d_add_16x16, avx2, 16, 16),
+    BENCH(InvTxfm, av1_inv_txfm2d_add_32x32, c, 32, 32),
+    BENCH(InvTxfm, av1_inv_txfm2d_add_32x32, avx2, 32, 32),
+    BENCH(InvTxfm, av1_inv_txfm2d_add_4x4, c, 4, 4),
+    BENCH(InvTxfm, av1_inv_txfm2d_add_4x4, avx2, 4, 4),
+    BENCH(InvTxfm, av1_inv_txfm2d_add_64x64, c, 64, 64),
+    BENCH(InvTxfm, av1_inv_txfm2d_add_64x64, sse4_1, 64, 64),
+    BENCH(InvTxfm, av1_inv_txfm2d_add_8x8, c, 8, 8),
+    BENCH(InvTxfm, av1_inv_txfm2d_add_8x8, avx2, 8, 8),
+    BENCH(InvTxfmEob, av1_inv_txfm2d_add_8x16, c, 8, 16),
+    BENCH_IMPL(InvTxfmEob, av1_inv_txfm2d_add_8x16, avx2, 8, 16, av1_highbd_inv_txfm_add_avx2),
+    BENCH(InvTxfmEob, av1_inv_txfm2d_add_16x8, c, 16, 8),
+    BENCH_IMPL(InvTxfmEob, av1_inv_txfm2d_add_16x8, avx2, 16, 8, av1_highbd_inv_txfm_add_avx2),
+    BENCH(InvTxfmEob, av1_inv_txfm2d_add_16x32, c, 16, 32),
+    BENCH_IMPL(InvTxfmEob, av1_inv_txfm2d_add_16x32, avx2, 16, 32, av1_highbd_inv_txfm_add_avx2),
+    BENCH(InvTxfmEob, av1_inv_txfm2d_add_32x16, c, 32, 16),
+    BENCH_IMPL(InvTxfmEob, av1_inv_txfm2d_add_32x16, avx2, 32, 16, av1_highbd_inv_txfm_add_avx2),
+    BENCH(InvTxfmEob, av1_inv_txfm2d_add_32x8, c, 32, 8),
+    BENCH_IMPL(InvTxfmEob, av1_inv_txfm2d_add_32x8, avx2, 32, 8, av1_highbd_inv_txfm_add_avx2),
+    BENCH(InvTxfmEob, av1_inv_txfm2d_add_8x32, c, 8, 32),
+    BENCH_IMPL(InvTxfmEob, av1_inv_txfm2d_add_8x32, avx2, 8, 32, av1_highbd_inv_txfm_add_avx2),
+    BENCH(InvTxfmEob, av1_inv_txfm2d_add_32x64, c, 32, 64),
+    BENCH_IMPL(InvTxfmEob, av1_inv_txfm2d_add_32x64, avx2, 32, 64, av1_highbd_inv_txfm_add_avx2),
+    BENCH(InvTxfmEob, av1_inv_txfm2d_add_64x32, c, 64, 32),
+    BENCH_IMPL(InvTxfmEob, av1_inv_txfm2d_add_64x32, avx2, 64, 32, av1_highbd_inv_txfm_add_avx2),
+    BENCH(InvTxfmEob, av1_inv_txfm2d_add_16x64, c, 16, 64),
+    BENCH_IMPL(InvTxfmEob, av1_inv_txfm2d_add_16x64, avx2, 16, 64, av1_highbd_inv_txfm_add_avx2),
+    BENCH(InvTxfmEob, av1_inv_txfm2d_add_64x16, c, 64, 16),
+    BENCH_IMPL(InvTxfmEob, av1_inv_txfm2d_add_64x16, avx2, 64, 16, av1_highbd_inv_txfm_add_avx2),
+    BENCH(InvTxfmRect, av1_inv_txfm2d_add_4x8, c, 4, 8),
+    BENCH(InvTxfmRect, av1_inv_txfm2d_add_4x8, sse4_1, 4, 8),
+    BENCH(InvTxfmRect, av1_inv_txfm2d_add_8x4, c, 8, 4),
+    BENCH(InvTxfmRect, av1_inv_txfm2d_add_8x4, sse4_1, 8, 4),
+    BENCH(InvTxfmRect, av1_inv_txfm2d_add_4x16, c, 4, 16),
+    BENCH(InvTxfmRect, av1_inv_txfm2d_add_4x16, sse4_1, 4, 16),
+    BENCH(InvTxfmRect, av1_inv_txfm2d_add_16x4, c, 16, 4),
+    BENCH(InvTxfmRect, av1_inv_txfm2d_add_16x4, sse4_1, 16, 4),
+    BENCH(Convolve, av1_convolve_2d_copy_sr, c, 4, 4),
+    BENCH(Convolve, av1_convolve_2d_copy_sr, c, 8, 8),
+    BENCH(Convolve, av1_convolve_2d_copy_sr, c, 16, 16),
+    BENCH(Convolve, av1_convolve_2d_copy_sr, c, 32, 32),
+    BENCH(Convolve, av1_convolve_2d_copy_sr, c, 64, 64),
+    BENCH(Convolve, av1_convolve_2d_copy_sr, c, 128, 128),
+    BENCH(Convolve, av1_convolve_2d_copy_sr, avx2, 4, 4),
+    BENCH(Convolve, av1_convolve_2d_copy_sr, avx2, 8, 8),
+    BENCH(Convolve, av1_convolve_2d_copy_sr, avx2, 16, 16),
+    BENCH(Convolve, av1_convolve_2d_copy_sr, avx2, 32, 32),
+    BENCH(Convolve, av1_convolve_2d_copy_sr, avx2, 64, 64),
+    BENCH(Convolve, av1_convolve_2d_copy_sr, avx2, 128, 128),
+    BENCH(Convolve, av1_convolve_2d_sr, c, 4, 4),
+    BENCH(Convolve, av1_convolve_2d_sr, c, 8, 8),
+    BENCH(Convolve, av1_convolve_2d_sr, c, 16, 16),
+    BENCH(Convolve, av1_convolve_2d_sr, c, 32, 32),
+    BENCH(Convolve, av1_convolve_2d_sr, c, 64, 64),
+    BENCH(Convolve, av1_convolve_2d_sr, c, 128, 128),
+    BENCH(Convolve, av1_convolve_2d_sr, avx2, 4, 4),
+    BENCH(Convolve, av1_convolve_2d_sr, avx2, 8, 8),
+    BENCH(Convolve, av1_convolve_2d_sr, avx2, 16, 16),
+    BENCH(Convolve, av1_convolve_2d_sr, avx2, 32, 32),
+    BENCH(Convolve, av1_convolve_2d_sr, avx2, 64, 64),
+    BENCH(Convolve, av1_convolve_2d_sr, avx2, 128, 128),
+    BENCH(Convolve, av1_jnt_convolve_2d_copy, c, 4, 4),
+    BENCH(Convolve, av1_jnt_convolve_2d_copy, c, 8, 8),
+    BENCH(Convolve, av1_jnt_convolve_2d_copy, c, 16, 16),
+    BENCH(Convolve, av1_jnt_convolve_2d_copy, c, 32, 32),
+    BENCH(Convolve, av1_jnt_convolve_2d_copy, c, 64, 64),
+    BENCH(Convolve, av1_jnt_convolve_2d_copy, c, 128, 128),
+    BENCH(Convolve, av1_jnt_convolve_2d_copy, avx2, 4, 4),
+    BENCH(Convolve, av1_jnt_convolve_2d_copy, avx2, 8, 8),
+    BENCH(Convolve, av1_jnt_convolve_2d_copy, avx2, 16, 16),
+    BENCH(Convolve, av1_jnt_convolve_2d_copy, avx2, 32, 32),
+    BENCH(Convolve, av1_jnt_convolve_2d_copy, avx2, 64, 64),
+    BENCH(Convolve, av1_jnt_convolve_2d_copy, avx2, 128, 128),
+    BENCH(Convolve, av1_convolve_x_sr, c, 4, 4),
+    BENCH(Convolve, av1_convolve_x_sr, c, 8, 8),
+    BENCH(Convolve, av1_convolve_x_sr, c, 16, 16),
+    BENCH(Convolve, av1_convolve_x_sr, c, 32, 32),
+    BENCH(Convolve, av1_convolve_x_sr, c, 64, 64),
+    BENCH(Convolve, av1_convolve_x_sr, c, 128, 128),
+    BENCH(Convolve, av1_convolve_x_sr, avx2, 4, 4),
+    BENCH(Convolve, av1_convolve_x_sr, avx2, 8, 8),
+    BENCH(Convolve, av1_convolve_x_sr, avx2, 16, 16),
+    BENCH(Convolve, av1_convolve_x_sr, avx2, 32, 32),
+    BENCH(Convolve, av1_convolve_x_sr, avx2, 64, 64),
+    BENCH(Convolve, av1_convolve_x_sr, avx2, 128, 128),
+    BENCH(Convolve, av1_convolve_y_sr, c, 4, 4),
+    BENCH(Convolve, av1_convolve_y_sr, c, 8, 8),
+    BENCH(Convolve, av1_convolve_y_sr, c, 16, 16),
+    BENCH(Convolve, av1_convolve_y_sr, c, 32, 32),
+    BENCH(Convolve, av1_convolve_y_sr, c, 64, 64),
+    BENCH(Convolve, av1_convolve_y_sr, c, 128, 128),
+    BENCH(Convolve, av1_convolve_y_sr, avx2, 4, 4),
+    BENCH(Convolve, av1_convolve_y_sr, avx2, 8, 8),
+    BENCH(Convolve, av1_convolve_y_sr, avx2, 16, 16),
+    BENCH(Convolve, av1_convolve_y_sr, avx2, 32, 32),
+    BENCH(Convolve, av1_convolve_y_sr, avx2, 64, 64),
+    BENCH(Convolve, av1_convolve_y_sr, avx2, 128, 128),
+    BENCH(Convolve, av1_jnt_convolve_x, c, 4, 4),
+    BENCH(Convolve, av1_jnt_convolve_x, c, 8, 8),
+    BENCH(Convolve, av1_jnt_convolve_x, c, 16, 16),
+    BENCH(Convolve, av1_jnt_convolve_x, c, 32, 32),
+    BENCH(Convolve, av1_jnt_convolve_x, c, 64, 64),
+    BENCH(Convolve, av1_jnt_convolve_x, c, 128, 128),
+    BENCH(Convolve, av1_jnt_convolve_x, avx2, 4, 4),
+    BENCH(Convolve, av1_jnt_convolve_x, avx2, 8, 8),
+    BENCH(Convolve, av1_jnt_convolve_x, avx2, 16, 16),
+    BENCH(Convolve, av1_jnt_convolve_x, avx2, 32, 32),
+    BENCH(Convolve, av1_jnt_convolve_x, avx2, 64, 64),
+    BENCH(Convolve, av1_jnt_convolve_x, avx2, 128, 128),
+    BENCH(Convolve, av1_jnt_convolve_y, c, 4, 4),
+    BENCH(Convolve, av1_jnt_convolve_y, c, 8, 8),
+    BENCH(Convolve, av1_jnt_convolve_y, c, 16, 16),
+    BENCH(Convolve, av1_jnt_convolve_y, c, 32, 32),
+    BENCH(Convolve, av1_jnt_convolve_y, c, 64, 64),
+    BENCH(Convolve, av1_jnt_convolve_y, c, 128, 128),
+    BENCH(Convolve, av1_jnt_convolve_y, avx2, 4, 4),
+    BENCH(Convolve, av1_jnt_convolve_y, avx2, 8, 8),
+    BENCH(Convolve, av1_jnt_convolve_y, avx2, 16, 16),
+    BENCH(Convolve, av1_jnt_convolve_y, avx2, 32, 32),
+    BENCH(Convolve, av1_jnt_convolve_y, avx2, 64, 64),
+    BENCH(Convolve, av1_jnt_convolve_y, avx2, 128, 128),
+    BENCH(Convolve, av1_jnt_convolve_2d, c, 4, 4),
+    BENCH(Convolve, av1_jnt_convolve_2d, c, 8, 8),
+    BENCH(Convolve, av1_jnt_convolve_2d, c, 16, 16),
+    BENCH(Convolve, av1_jnt_convolve_2d, c, 32, 32),
+    BENCH(Convolve, av1_jnt_convolve_2d, c, 64, 64),
+    BENCH(Convolve, av1_jnt_convolve_2d, c, 128, 128),
+    BENCH(Convolve, av1_jnt_convolve_2d, avx2, 4, 4),
+    BENCH(Convolve, av1_jnt_convolve_2d, avx2, 8, 8),
+    BENCH(Convolve, av1_jnt_convolve_2d, avx2, 16, 16),
+    BENCH(Convolve, av1_jnt_convolve_2d, avx2, 32, 32),
+    BENCH(Convolve, av1_jnt_convolve_2d, avx2, 64, 64),
+    BENCH(Convolve, av1_jnt_convolve_2d, avx2, 128, 128),
+    BENCH(ConvolveHbd, av1_highbd_convolve_2d_copy_sr, c, 4, 4),
+    BENCH(ConvolveHbd, av1_highbd_convolve_2d_copy_sr, c, 8, 8),
+    BENCH(ConvolveHbd, av1_highbd_convolve_2d_copy_sr, c, 16, 16),
+    BENCH(ConvolveHbd, av1_highbd_convolve_2d_copy_sr, c, 32, 32),
+    BENCH(ConvolveHbd, av1_highbd_convolve_2d_copy_sr, c, 64, 64),
+    BENCH(ConvolveHbd, av1_highbd_convolve_2d_copy_sr, c, 128, 128),
+    BENCH(ConvolveHbd, av1_highbd_convolve_2d_copy_sr, avx2, 4, 4),
+    BENCH(ConvolveHbd, av1_highbd_convolve_2d_copy_sr, avx2, 8, 8),
+    BENCH(ConvolveHbd, av1_highbd_convolve_2d_copy_sr, avx2, 16, 16),
+    BENCH(ConvolveHbd, av1_highbd_convolve_2d_copy_sr, avx2, 32, 32),
+    BENCH(ConvolveHbd, av1_highbd_convolve_2d_copy_sr, avx2, 64, 64),
+    BENCH(ConvolveHbd, av1_highbd_convolve_2d_copy_sr, avx2, 128, 128),
+    BENCH(ConvolveHbd, av1_highbd_jnt_convolve_2d_copy, c, 4, 4),
+    BENCH(ConvolveHbd, av1_highbd_jnt_convolve_2d_copy, c, 8, 8),
+    BENCH(ConvolveHbd, av1_highbd_jnt_convolve_2d_copy, c, 16, 16),
+    BENCH(ConvolveHbd, av1_highbd_jnt_convolve_2d_copy, c, 32, 32),
+    BENCH(ConvolveHbd, av1_highbd_jnt_convolve_2d_copy, c, 64, 64),
+    BENCH(ConvolveHbd, av1_highbd_jnt_convolve_2d_copy, c, 128, 128),
+    BENCH(ConvolveHbd, av1_highbd_jnt_convolve_2d_copy, avx2, 4, 4),
+    BENCH(ConvolveHbd, av1_highbd_jnt_convolve_2d_copy, avx2, 8, 8),
+    BENCH(ConvolveHbd, av1_highbd_jnt_convolve_2d_copy, avx2, 16, 16),
+    BENCH(ConvolveHbd, av1_highbd_jnt_convolve_2d_copy, avx2, 32, 32),
+    BENCH(ConvolveHbd, av1_highbd_jnt_convolve_2d_copy, avx2, 64, 64),
+    BENCH(ConvolveHbd, av1_highbd_jnt_convolve_2d_copy, avx2, 128, 128),
+    BENCH(ConvolveHbd, av1_highbd_convolve_y_sr, c, 4, 4),
+    BENCH(ConvolveHbd, av1_highbd_convolve_y_sr, c, 8, 8),
+    BENCH(ConvolveHbd, av1_highbd_convolve_y_sr, c, 16, 16),
+    BENCH(ConvolveHbd, av1_highbd_convolve_y_sr, c, 32, 32),
+    BENCH(ConvolveHbd, av1_highbd_convolve_y_sr, c, 64, 64),
+    BENCH(ConvolveHbd, av1_highbd_convolve_y_sr, c, 128, 128),
+    BENCH(ConvolveHbd, av1_highbd_convolve_y_sr, avx2, 4, 4),
+    BENCH(ConvolveHbd, av1_highbd_convolve_y_sr, avx2, 8, 8),
+    BENCH(ConvolveHbd, av1_highbd_convolve_y_sr, avx2, 16, 16),
+    BENCH(ConvolveHbd, av1_highbd_convolve_y_sr, avx2, 32, 32),
+    BENCH(ConvolveHbd, av1_highbd_convolve_y_sr, avx2, 64, 64),
+    BENCH(ConvolveHbd, av1_highbd_convolve_y_sr, avx2, 128, 128),
+    BENCH(ConvolveHbd, av1_highbd_convolve_2d_sr, c, 4, 4),
+    BENCH(ConvolveHbd, av1_highbd_convolve_2d_sr, c, 8, 8),
+    BENCH(ConvolveHbd, av1_highbd_convolve_2d_sr, c, 16, 16),
+    BENCH(ConvolveHbd, av1_highbd_convolve_2d_sr, c, 32, 32),
+    BENCH(ConvolveHbd, av1_highbd_convolve_2d_sr, c, 64, 64),
+    BENCH(ConvolveHbd, av1_highbd_convolve_2d_sr, c, 128, 128),
+    BENCH(ConvolveHbd, av1_highbd_convolve_2d_sr, avx2, 4, 4),
+    BENCH(ConvolveHbd, av1_highbd_convolve_2d_sr, avx2, 8, 8),
+    BENCH(ConvolveHbd, av1_highbd_convolve_2d_sr, avx2, 16, 16),
+    BENCH(ConvolveHbd, av1_highbd_convolve_2d_sr, avx2, 32, 32),
+    BENCH(ConvolveHbd, av1_highbd_convolve_2d_sr, avx2, 64, 64),
+    BENCH(ConvolveHbd, av1_highbd_convolve_2d_sr, avx2, 128, 128),
+    BENCH(ConvolveHbd, av1_highbd_jnt_convolve_2d, c, 4, 4),
+    BENCH(ConvolveHbd, av1_highbd_jnt_convolve_2d, c, 8, 8),
+    BENCH(ConvolveHbd, av1_highbd_jnt_convolve_2d, c, 16, 16),
+    BENCH(ConvolveHbd, av1_highbd_jnt_convolve_2d, c, 32, 32),
+    BENCH(ConvolveHbd, av1_highbd_jnt_convolve_2d, c, 64, 64),
+    BENCH(ConvolveHbd, av1_highbd_jnt_convolve_2d, c, 128, 128),
+    BENCH(ConvolveHbd, av1_highbd_jnt_convolve_2d, avx2, 4, 4),
+    BENCH(ConvolveHbd, av1_highbd_jnt_convolve_2d, avx2, 8, 8),
+    BENCH(ConvolveHbd, av1_highbd_jnt_convolve_2d, avx2, 16, 16),
+    BENCH(ConvolveHbd, av1_highbd_jnt_convolve_2d, avx2, 32, 32),
+    BENCH(ConvolveHbd, av1_highbd_jnt_convolve_2d, avx2, 64, 64),
+    BENCH(ConvolveHbd, av1_highbd_jnt_convolve_2d, avx2, 128, 128),
+    BENCH(ConvolveHbd, av1_highbd_jnt_convolve_x, c, 4, 4),
+    BENCH(ConvolveHbd, av1_highbd_jnt_convolve_x, c, 8, 8),
+    BENCH(ConvolveHbd, av1_highbd_jnt_convolve_x, c, 16, 16),
+    BENCH(ConvolveHbd, av1_highbd_jnt_convolve_x, c, 32, 32),
+    BENCH(ConvolveHbd, av1_highbd_jnt_convolve_x, c, 64, 64),
+    BENCH(ConvolveHbd, av1_highbd_jnt_convolve_x, c, 128, 128),
+    BENCH(ConvolveHbd, av1_highbd_jnt_convolve_x, avx2, 4, 4),
+    BENCH(ConvolveHbd, av1_highbd_jnt_convolve_x, avx2, 8, 8),
+    BENCH(ConvolveHbd, av1_highbd_jnt_convolve_x, avx2, 16, 16),
+    BENCH(ConvolveHbd, av1_highbd_jnt_convolve_x, avx2, 32, 32),
+    BENCH(ConvolveHbd, av1_highbd_jnt_convolve_x, avx2, 64, 64),
+    BENCH(ConvolveHbd, av1_highbd_jnt_convolve_x, avx2, 128, 128),
+    BENCH(ConvolveHbd, av1_highbd_jnt_convolve_y, c, 4, 4),
+    BENCH(ConvolveHbd, av1_highbd_jnt_convolve_y, c, 8, 8),
+    BENCH(ConvolveHbd, av1_highbd_jnt_convolve_y, c, 16, 16),
+    BENCH(ConvolveHbd, av1_highbd_jnt_convolve_y, c, 32, 32),
+    BENCH(ConvolveHbd, av1_highbd_jnt_convolve_y, c, 64, 64),
+    BENCH(ConvolveHbd, av1_highbd_jnt_convolve_y, c, 128, 128),
+    BENCH(ConvolveHbd, av1_highbd_jnt_convolve_y, avx2, 4, 4),
+    BENCH(ConvolveHbd, av1_highbd_jnt_convolve_y, avx2, 8, 8),
+    BENCH(ConvolveHbd, av1_highbd_jnt_convolve_y, avx2, 16, 16),
+    BENCH(ConvolveHbd, av1_highbd_jnt_convolve_y, avx2, 32, 32),
+    BENCH(ConvolveHbd, av1_highbd_jnt_convolve_y, avx2, 64, 64),
+    BENCH(ConvolveHbd, av1_highbd_jnt_convolve_y, avx2, 128, 128),
+    BENCH(ConvolveHbd, av1_highbd_convolve_x_sr, c, 4, 4),
+    BENCH(ConvolveHbd, av1_highbd_convolve_x_sr, c, 8, 8),
+    BENCH(ConvolveHbd, av1_highbd_convolve_x_sr, c, 16, 16),
+    BENCH(ConvolveHbd, av1_highbd_convolve_x_sr, c, 32, 32),
+    BENCH(ConvolveHbd, av1_highbd_convolve_x_sr, c, 64, 64),
+    BENCH(ConvolveHbd, av1_highbd_convolve_x_sr, c, 128, 128),
+    BENCH(ConvolveHbd, av1_highbd_convolve_x_sr, avx2, 4, 4),
+    BENCH(ConvolveHbd, av1_highbd_convolve_x_sr, avx2, 8, 8),
+    BENCH(ConvolveHbd, av1_highbd_convolve_x_sr, avx2, 16, 16),
+    BENCH(ConvolveHbd, av1_highbd_convolve_x_sr, avx2, 32, 32),
+    BENCH(ConvolveHbd, av1_highbd_convolve_x_sr, avx2, 64, 64),
+    BENCH(ConvolveHbd, av1_highbd_convolve_x_sr, avx2, 128, 128),
+    BENCH_IMPL(Quantize, aom_quantize_b, c, 16, 16, aom_quantize_b_c_II),
+    BENCH_IMPL(Quantize, aom_quantize_b, avx2, 16, 16, aom_highbd_quantize_b_avx2),
+    BENCH_IMPL(Quantize, aom_quantize_b_32x32, c, 32, 32, aom_quantize_b_32x32_c_II),
+    BENCH_IMPL(Quantize, aom_quantize_b_32x32, avx2, 32, 32, aom_highbd_quantize_b_32x32_avx2),
+    BENCH_IMPL(Quantize, aom_quantize_b_64x64, c, 64, 64, aom_quantize_b_64x64_c_II),
+    BENCH_IMPL(Quantize, aom_quantize_b_64x64, avx2, 64, 64, aom_highbd_quantize_b_64x64_avx2),
+    BENCH(QuantizeHbd, aom_highbd_quantize_b_32x32, c, 32, 32),
+    BENCH(QuantizeHbd, aom_highbd_quantize_b_32x32, avx2, 32, 32),
+    BENCH(QuantizeHbd, aom_highbd_quantize_b, c, 16, 16),
+    BENCH(QuantizeHbd, aom_highbd_quantize_b, avx2, 16, 16),
+    BENCH(QuantizeHbd, aom_highbd_quantize_b_64x64, c, 64, 64),
+    BENCH(QuantizeHbd, aom_highbd_quantize_b_64x64, avx2, 64, 64),
+    BENCH(CdefDir, cdef_find_dir, c, 8, 8),
+    BENCH(CdefDir, cdef_find_dir, avx2, 8, 8),
+    BENCH(CdefFilter, cdef_filter_block, c, 8, 8),
+    BENCH(CdefFilter, cdef_filter_block, avx2, 8, 8),
+    BENCH(TxbInitLevels, av1_txb_init_levels, c, 4, 4),
+    BENCH(TxbInitLevels, av1_txb_init_levels, c, 8, 8),
+    BENCH(TxbInitLevels, av1_txb_init_levels, c, 16, 16),
+    BENCH(TxbInitLevels, av1_txb_init_levels, c, 32, 32),
+    BENCH(TxbInitLevels, av1_txb_init_levels, avx2, 4, 4),
+    BENCH(TxbInitLevels, av1_txb_init_levels, avx2, 8, 8),
+    BENCH(TxbInitLevels, av1_txb_init_levels, avx2, 16, 16),
+    BENCH(TxbInitLevels, av1_txb_init_levels, avx2, 32, 32),
+    BENCH_IMPL(Residual, ResidualKernel, c, 4, 4, residual_kernel_c),
+    BENCH_IMPL(Residual, ResidualKernel, c, 8, 8, residual_kernel_c),
+    BENCH_IMPL(Residual, ResidualKernel, c, 16, 16, residual_kernel_c),
+    BENCH_IMPL(Residual, ResidualKernel, c, 32, 32, residual_kernel_c),
+    BENCH_IMPL(Residual, ResidualKernel, c, 64, 64, residual_kernel_c),
+    BENCH_IMPL(Residual, ResidualKernel, c, 128, 128, residual_kernel_c),
+    BENCH(Residual, ResidualKernel, avx2, 4, 4),
+    BENCH(Residual, ResidualKernel, avx2, 8, 8),
+    BENCH(Residual, ResidualKernel, avx2, 16, 16),
+    BENCH(Residual, ResidualKernel, avx2, 32, 32),
+    BENCH(Residual, ResidualKernel, avx2, 64, 64),
+    BENCH(Residual, ResidualKernel, avx2, 128, 128),
+};
+
+/** Data of the harnesses, refilled for each bit depth */
+const int kStride = 320;
+const int kRows = 128 + 16;
+const int kBorder = 8;
+
+DECLARE_ALIGNED(64, uint8_t, src8[kRows * kStride]);
+DECLARE_ALIGNED(64, uint8_t, ref8[kRows * kStride]);
+DECLARE_ALIGNED(64, uint8_t, dst8[kRows * kStride]);
+DECLARE_ALIGNED(64, uint16_t, src16[kRows * kStride]);
+DECLARE_ALIGNED(64, uint16_t, dst16[kRows * kStride]);
+DECLARE_ALIGNED(64, uint8_t, above8[2 * MAX_SB_SIZE + 32]);
+DECLARE_ALIGNED(64, uint8_t, left8[2 * MAX_SB_SIZE + 32]);
+DECLARE_ALIGNED(64, uint16_t, above16[2 * MAX_SB_SIZE + 32]);
+DECLARE_ALIGNED(64, uint16_t, left16[2 * MAX_SB_SIZE + 32]);
+DECLARE_ALIGNED(64, ConvBufType, conv_dst[MAX_SB_SQUARE]);
+DECLARE_ALIGNED(64, int16_t, residual16[MAX_SB_SQUARE]);
+DECLARE_ALIGNED(64, int32_t, coeff[MAX_SB_SQUARE]);
+DECLARE_ALIGNED(64, int32_t, qcoeff[MAX_SB_SQUARE]);
+DECLARE_ALIGNED(64, int32_t, dqcoeff[MAX_SB_SQUARE]);
+DECLARE_ALIGNED(64, int16_t, scan[MAX_SB_SQUARE]);
+DECLARE_ALIGNED(64, uint8_t, levels[TX_PAD_2D]);
+DECLARE_ALIGNED(64, uint16_t, cdef_in[CDEF_INBUF_SIZE]);
+
+// Quantizer of a mid-range qindex, {DC, AC}
+const int16_t zbin[2] = {21, 26};
+const int16_t round_q[2] = {15, 18};
+const int16_t quant[2] = {-16384, -21846};
+const int16_t quant_shift[2] = {16384, 16384};
+const int16_t dequant[2] = {40, 48};
+
+void prepare_buffers(int bd) {
+    std::mt19937 gen(0xa42b);
+    std::uniform_int_distribution<int> pixel(0, (1 << bd) - 1);
+    std::uniform_int_distribution<int> residual(-(1 << bd) + 1,
+                                                (1 << bd) - 1);
+    std::uniform_int_distribution<int> level(-(256 << (bd - 8)),
+                                             256 << (bd - 8));
+
+    for (int i = 0; i < kRows * kStride; i++) {
+        src8[i] = (uint8_t)pixel(gen);
+        ref8[i] = (uint8_t)pixel(gen);
+        dst8[i] = (uint8_t)pixel(gen);
+        src16[i] = (uint16_t)pixel(gen);
+        dst16[i] = (uint16_t)pixel(gen);
+    }
+    for (int i = 0; i < 2 * MAX_SB_SIZE + 32; i++) {
+        above8[i] = (uint8_t)pixel(gen);
+        left8[i] = (uint8_t)pixel(gen);
+        above16[i] = (uint16_t)pixel(gen);
+        left16[i] = (uint16_t)pixel(gen);
+    }
+    for (int i = 0; i < MAX_SB_SQUARE; i++) {
+        residual16[i] = (int16_t)residual(gen);
+        coeff[i] = level(gen);
+        scan[i] = (int16_t)i;
+    }
+    for (int i = 0; i < CDEF_INBUF_SIZE; i++)
+        cdef_in[i] = (uint16_t)pixel(gen);
+}
+
+TxSize get_tx_size(int width, int height) {
+    for (int tx_size = 0; tx_size < TX_SIZES_ALL; tx_size++) {
+        if (tx_size_wide[tx_size] == width && tx_size_high[tx_size] == height)
+            return (TxSize)tx_size;
+    }
+    return TX_INVALID;
+}
+
+/** Calls the implementation iterations times */
+void run_kernel(const KernelEntry &entry, int bd, uint64_t iterations) {
+    const int w = entry.width;
+    const int h = entry.height;
+    uint8_t *const src = src8 + kBorder * kStride + kBorder;
+    uint8_t *const ref = ref8 + kBorder * kStride + kBorder;
+    uint16_t *const src_hbd = src16 + kBorder * kStride + kBorder;
+    volatile uint32_t sink = 0;
+
+    switch (entry.family) {
+    case Sad: {
+        SadFn fn = reinterpret_cast<SadFn>(entry.fn);
+        for (uint64_t i = 0; i < iterations; i++)
+            sink += fn(src, kStride, ref + 1, kStride);
+        break;
+    }
+    case SadX4d: {
+        SadX4dFn fn = reinterpret_cast<SadX4dFn>(entry.fn);
+        const uint8_t *const refs[4] = {ref, ref + 1, ref + 2, ref + 3};
+        uint32_t sad_array[4];
+        for (uint64_t i = 0; i < iterations; i++)
+            fn(src, kStride, refs, kStride, sad_array);
+        sink += sad_array[0];
+        break;
+    }
+    case Variance: {
+        VarianceFn fn = reinterpret_cast<VarianceFn>(entry.fn);
+        uint32_t sse;
+        for (uint64_t i = 0; i < iterations; i++)
+            sink += fn(src, kStride, ref, kStride, &sse);
+        break;
+    }
+    case Intra: {
+        IntraFn fn = reinterpret_cast<IntraFn>(entry.fn);
+        for (uint64_t i = 0; i < iterations; i++)
+            fn(dst8, kStride, above8 + 16, left8 + 16);
+        break;
+    }
+    case IntraHbd: {
+        IntraHbdFn fn = reinterpret_cast<IntraHbdFn>(entry.fn);
+        for (uint64_t i = 0; i < iterations; i++)
+            fn(dst16, kStride, above16 + 16, left16 + 16, bd);
+        break;
+    }
+    case FwdTxfm: {
+        FwdTxfmFn fn = reinterpret_cast<FwdTxfmFn>(entry.fn);
+        for (uint64_t i = 0; i < iterations; i++)
+            fn(residual16, qcoeff, w, DCT_DCT, (uint8_t)bd);
+        break;
+    }
+    case InvTxfm: {
+        InvTxfmFn fn = reinterpret_cast<InvTxfmFn>(entry.fn);
+        for (uint64_t i = 0; i < iterations; i++)
+            fn(coeff, dst16, kStride, DCT_DCT, bd);
+        break;
+    }
+    case InvTxfmEob: {
+        InvTxfmEobFn fn = reinterpret_cast<InvTxfmEobFn>(entry.fn);
+        const int32_t eob = AOMMIN(w, 32) * AOMMIN(h, 32);
+        for (uint64_t i = 0; i < iterations; i++)
+            fn(coeff, dst16, kStride, DCT_DCT, get_tx_size(w, h), eob, bd);
+        break;
+    }
+    case InvTxfmRect: {
+        InvTxfmRectFn fn = reinterpret_cast<InvTxfmRectFn>(entry.fn);
+        for (uint64_t i = 0; i < iterations; i++)
+            fn(coeff, dst16, kStride, DCT_DCT, get_tx_size(w, h), bd);
+        break;
+    }
+    case Convolve:
+    case ConvolveHbd: {
+        InterpFilterParams filter_x =
+            av1_get_interp_filter_params_with_block_size(EIGHTTAP_REGULAR, w);
+        InterpFilterParams filter_y =
+            av1_get_interp_filter_params_with_block_size(EIGHTTAP_REGULAR, h);
+        const int32_t is_compound = strstr(entry.kernel, "jnt") != NULL;
+        const int32_t subpel =
+            strstr(entry.kernel, "copy") != NULL ? 0 : SUBPEL_SHIFTS / 2;
+        ConvolveParams conv_params = get_conv_params_no_round(
+            0, 0, 0, conv_dst, MAX_SB_SIZE, is_compound, bd);
+        if (entry.family == Convolve) {
+            ConvolveFn fn = reinterpret_cast<ConvolveFn>(entry.fn);
+            for (uint64_t i = 0; i < iterations; i++)
+                fn(src, kStride, dst8, kStride, w, h, &filter_x, &filter_y,
+                   subpel, subpel, &conv_params);
+        } else {
+            ConvolveHbdFn fn = reinterpret_cast<ConvolveHbdFn>(entry.fn);
+            for (uint64_t i = 0; i < iterations; i++)
+                fn(src_hbd, kStride, dst16, kStride, w, h, &filter_x,
+                   &filter_y, subpel, subpel, &conv_params, bd);
+        }
+        break;
+    }
+    case Quantize:
+    case QuantizeHbd: {
+        QuantizeFn fn = reinterpret_cast<QuantizeFn>(entry.fn);
+        const intptr_t n_coeffs = AOMMIN(w, 32) * AOMMIN(h, 32);
+        uint16_t eob;
+        for (uint64_t i = 0; i < iterations; i++)
+            fn(coeff, n_coeffs, 0, zbin, round_q, quant, quant_shift, qcoeff,
+               dqcoeff, dequant, &eob, scan, scan);
+        sink += eob;
+        break;
+    }
+    case CdefDir: {
+        CdefDirFn fn = reinterpret_cast<CdefDirFn>(entry.fn);
+        int32_t var;
+        for (uint64_t i = 0; i < iterations; i++)
+            sink += fn(src_hbd, kStride, &var, bd - 8);
+        break;
+    }
+    case CdefFilter: {
+        CdefFilterFn fn = reinterpret_cast<CdefFilterFn>(entry.fn);
+        const int32_t coeff_shift = bd - 8;
+        const uint16_t *in =
+            cdef_in + CDEF_VBORDER * CDEF_BSTRIDE + CDEF_HBORDER;
+        for (uint64_t i = 0; i < iterations; i++)
+            fn(bd == 8 ? dst8 : NULL, bd == 8 ? NULL : dst16, kStride, in,
+               4 << coeff_shift, 2 << coeff_shift, 2, 5 + coeff_shift,
+               3 + coeff_shift, BLOCK_8X8, (256 << coeff_shift) - 1,
+               coeff_shift);
+        break;
+    }
+    case TxbInitLevels: {
+        TxbInitLevelsFn fn = reinterpret_cast<TxbInitLevelsFn>(entry.fn);
+        for (uint64_t i = 0; i < iterations; i++)
+            fn(coeff, w, h, levels);
+        break;
+    }
+    case Residual: {
+        ResidualFn fn = reinterpret_cast<ResidualFn>(entry.fn);
+        for (uint64_t i = 0; i < iterations; i++)
+            fn(src, kStride, ref, kStride, residual16, MAX_SB_SIZE, w, h);
+        break;
+    }
+    default: break;
+    }
+    (void)sink;
+}
+
+bool isa_supported(const char *isa) {
+    if (!strcmp(isa, "c"))
+        return true;
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    if (!strcmp(isa, "sse2"))
+        return (info[3] >> 26) & 1;
+    if (!strcmp(isa, "ssse3"))
+        return (info[2] >> 9) & 1;
+    if (!strcmp(isa, "sse4_1"))
+        return (info[2] >> 19) & 1;
+    if (!strcmp(isa, "avx2")) {
+        // AVX2 also needs the OS to save the YMM registers
+        if (!((info[2] >> 27) & 1) || (_xgetbv(0) & 6) != 6)
+            return false;
+        __cpuidex(info, 7, 0);
+        return (info[1] >> 5) & 1;
+    }
+    return false;
+#else
+    if (!strcmp(isa, "sse2"))
+        return __builtin_cpu_supports("sse2");
+    if (!strcmp(isa, "ssse3"))
+        return __builtin_cpu_supports("ssse3");
+    if (!strcmp(isa, "sse4_1"))
+        return __builtin_cpu_supports("sse4.1");
+    if (!strcmp(isa, "avx2"))
+        return __builtin_cpu_supports("avx2");
+    return false;
+#endif
+}
+
+/** Time per call in ns, over at least min_time_s and best of 3 runs */
+double time_kernel(const KernelEntry &entry, int bd, double min_time_s,
+                   uint64_t *iterations) {
+    using clock = std::chrono::steady_clock;
+    uint64_t count = 1;
+    double elapsed;
+
+    // Warm up the caches and find the iteration count
+    for (;;) {
+        const clock::time_point start = clock::now();
+        run_kernel(entry, bd, count);
+        elapsed =
+            std::chrono::duration<double>(clock::now() - start).count();
+        if (elapsed >= min_time_s)
+            break;
+        count *= elapsed < min_time_s / 16 ? 16 : 2;
+    }
+    for (int run = 0; run < 2; run++) {
+        const clock::time_point start = clock::now();
+        run_kernel(entry, bd, count);
+        elapsed = AOMMIN(
+            elapsed,
+            std::chrono::duration<double>(clock::now() - start).count());
+    }
+    *iterations = count;
+    return elapsed * 1e9 / count;
+}
+
+void print_usage(void) {
+    printf(
+        "Usage: SvtAv1KernelBench [options]\n"
+        "  --filter <str>     only the kernels whose name contains str\n"
+        "  --isa <isa>        only the c, sse2, ssse3, sse4_1 or avx2 "
+        "implementations\n"
+        "  --min-time <ms>    minimum time of each measurement (default 20)\n"
+        "  --format <fmt>     csv (default) or json\n"
+        "  --output <file>    write the results to file instead of stdout\n"
+        "  --list             list the implementations without timing them\n");
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    const char *filter = NULL;
+    const char *isa = NULL;
+    double min_time_ms = 20;
+    bool json = false;
+    bool list = false;
+    FILE *out = stdout;
+
+    for (int i = 1; i < argc; i++) {
+        const bool has_value = i + 1 < argc;
+        if (!strcmp(argv[i], "--filter") && has_value)
+            filter = argv[++i];
+        else if (!strcmp(argv[i], "--isa") && has_value)
+            isa = argv[++i];
+        else if (!strcmp(argv[i], "--min-time") && has_value)
+            min_time_ms = atof(argv[++i]);
+        else if (!strcmp(argv[i], "--format") && has_value)
+            json = !strcmp(argv[++i], "json");
+        else if (!strcmp(argv[i], "--output") && has_value) {
+            out = fopen(argv[++i], "w");
+            if (out == NULL) {
+                fprintf(stderr, "Could not open %s\n", argv[i]);
+                return 1;
+            }
+        } else if (!strcmp(argv[i], "--list"))
+            list = true;
+        else {
+            print_usage();
+            return 1;
+        }
+    }
+    if (min_time_ms <= 0) {
+        print_usage();
+        return 1;
+    }
+
+    // Time of the C implementation of each kernel, size and bit depth
+    std::map<std::string, double> c_time_ns;
+    int prepared_bd = 0;
+    bool first = true;
+
+    if (json && !list)
+        fprintf(out, "[\n");
+    else if (!list)
+        fprintf(out,
+                "family,kernel,isa,width,height,bit_depth,iterations,ns_per_"
+                "call,speedup_vs_c\n");
+
+    for (const KernelEntry &entry : kernel_table) {
+        if (filter && !strstr(entry.kernel, filter))
+            continue;
+        if (isa && strcmp(entry.isa, isa) && strcmp(entry.isa, "c"))
+            continue;
+        if (list) {
+            printf("%s %s %dx%d\n", entry.kernel, entry.isa, entry.width,
+                   entry.height);
+            continue;
+        }
+        if (!isa_supported(entry.isa)) {
+            fprintf(stderr, "Skipping %s_%s: %s not supported by the CPU\n",
+                    entry.kernel, entry.isa, entry.isa);
+            continue;
+        }
+
+        for (int bd : family_info[entry.family].bit_depths) {
+            if (bd == 0)
+                break;
+            if (bd != prepared_bd) {
+                prepare_buffers(bd);
+                prepared_bd = bd;
+            }
+
+            uint64_t iterations;
+            const double ns =
+                time_kernel(entry, bd, min_time_ms / 1000, &iterations);
+            const std::string key = std::string(entry.kernel) + "/" +
+                                    std::to_string(entry.width) + "x" +
+                                    std::to_string(entry.height) + "/" +
+                                    std::to_string(bd);
+            double speedup = 0;
+            if (!strcmp(entry.isa, "c"))
+                c_time_ns[key] = ns;
+            if (c_time_ns.count(key))
+                speedup = c_time_ns[key] / ns;
+
+            // A speedup of 0 means the kernel has no C implementation
+            if (json)
+                fprintf(out,
+                        "%s  {\"family\": \"%s\", \"kernel\": \"%s\", "
+                        "\"isa\": \"%s\", \"width\": %d, \"height\": %d, "
+                        "\"bit_depth\": %d, \"iterations\": %llu, "
+                        "\"ns_per_call\": %.2f, \"speedup_vs_c\": %.2f}",
+                        first ? "" : ",\n",
+                        family_info[entry.family].name, entry.kernel,
+                        entry.isa, entry.width, entry.height, bd,
+                        (unsigned long long)iterations, ns, speedup);
+            else
+                fprintf(out, "%s,%s,%s,%d,%d,%d,%llu,%.2f,%.2f\n",
+                        family_info[entry.family].name, entry.kernel,
+                        entry.isa, entry.width, entry.height, bd,
+                        (unsigned long long)iterations, ns, speedup);
+            first = false;
+            fflush(out);
+        }
+    }
+    if (json && !list)
+        fprintf(out, "\n]\n");
+
+    if (out != stdout)
+        fclose(out);
+    return 0;
+}
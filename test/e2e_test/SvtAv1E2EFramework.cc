@@ -12,6 +12,7 @@
  *
  ******************************************************************************/
 
+#include <memory>
 #include "EbSvtAv1Enc.h"
 #include "Y4mVideoSource.h"
 #include "YuvVideoSource.h"
@@ -289,6 +290,8 @@ void SvtAv1E2ETestFramework::run_encode_process() {
             {
                 TimeAutoCount counter(ENCODING, collect_);
                 if (frame != nullptr && frame_count) {
+                    update_encoder(video_src_->get_frame_count() -
+                                   frame_count);
                     frame_count--;
                     // Fill in Buffers Header control data
                     av1enc_ctx_.input_picture_buffer->p_buffer = frame;
@@ -585,6 +588,7 @@ void SvtAv1E2ETestFramework::decode_compress_data(const uint8_t *data,
     VideoFrame ref_frame;
     memset(&ref_frame, 0, sizeof(ref_frame));
     while (refer_dec_->get_frame(ref_frame) == RefDecoder::REF_CODEC_OK) {
+        check_decoded_frame(ref_frame);
         if (recon_sink_) {
             // compare tools
             if (ref_compare_ == nullptr) {
@@ -689,6 +693,299 @@ void SvtAv1E2ETestFramework::get_recon_frame(bool &is_eos) {
     } while (true);
 }
 
+void SvtAv1E2ETestFramework::encode_to_stream(
+    const EbSvtAv1EncConfiguration &config, std::vector<uint8_t> &stream,
+    const std::vector<uint8_t> *pass_stats) {
+    std::unique_ptr<VideoSource> src(prepare_video_src(GetParam()));
+    ASSERT_NE(src, nullptr) << "video source create failed!";
+    ASSERT_EQ(src->open_source(start_pos_, frames_to_test_), EB_ErrorNone);
+
+    EbComponentType *handle = nullptr;
+    EbSvtAv1EncConfiguration params;
+    ASSERT_EQ(eb_init_handle(&handle, nullptr, &params), EB_ErrorNone);
+    ASSERT_NE(handle, nullptr) << "eb_init_handle return null handle.";
+    params = config;
+    params.encoder_color_format = EB_YUV420;
+    params.recon_enabled = 0;
+    ASSERT_EQ(eb_svt_enc_set_parameter(handle, &params), EB_ErrorNone);
+    if (pass_stats) {
+        ASSERT_EQ(eb_svt_enc_set_pass_stats(
+                      handle, pass_stats->data(), pass_stats->size()),
+                  EB_ErrorNone);
+    }
+    ASSERT_EQ(eb_init_encoder(handle), EB_ErrorNone);
+
+    stream.clear();
+    EbBufferHeaderType input;
+    memset(&input, 0, sizeof(input));
+    input.size = sizeof(input);
+    input.pic_type = EB_AV1_INVALID_PICTURE;
+    bool eos = false;
+    for (uint32_t i = 0; i <= src->get_frame_count(); i++) {
+        if (i < src->get_frame_count()) {
+            EbSvtIOFormat *frame = get_stream_frame(src.get());
+            ASSERT_NE(frame, nullptr) << "can not read frame " << i;
+            input.p_buffer = (uint8_t *)frame;
+            input.n_filled_len = src->get_frame_size();
+            input.flags = 0;
+            input.pts = i;
+        } else {
+            input.p_buffer = nullptr;
+            input.n_filled_len = 0;
+            input.flags = EB_BUFFERFLAG_EOS;
+        }
+        ASSERT_EQ(eb_svt_enc_send_picture(handle, &input), EB_ErrorNone)
+            << "eb_svt_enc_send_picture error at: " << i;
+
+        // Drain the output so the encoder never runs out of buffers, then
+        // wait for the rest after the last frame
+        const uint8_t pic_send_done = (input.flags & EB_BUFFERFLAG_EOS) ? 1 : 0;
+        while (!eos) {
+            EbBufferHeaderType *out = nullptr;
+            const EbErrorType ret =
+                eb_svt_get_packet(handle, &out, pic_send_done);
+            ASSERT_NE(ret, EB_ErrorMax) << "Error while encoding";
+            if (ret == EB_NoErrorEmptyQueue || out == nullptr)
+                break;
+            if (out->n_filled_len)
+                stream.insert(stream.end(),
+                              out->p_buffer,
+                              out->p_buffer + out->n_filled_len);
+            eos = (out->flags & EB_BUFFERFLAG_EOS) != 0;
+            eb_svt_release_out_buffer(&out);
+        }
+    }
+    EXPECT_TRUE(eos) << "the encoder did not output the end of stream";
+
+    EXPECT_EQ(eb_deinit_encoder(handle), EB_ErrorNone);
+    EXPECT_EQ(eb_deinit_handle(handle), EB_ErrorNone);
+    src->close_source();
+}
+
+void SvtAv1E2ETestFramework::encode_ladder(
+    const std::vector<EbSvtAv1EncConfiguration> &configs,
+    std::vector<LadderOutput> &outputs) {
+    std::unique_ptr<VideoSource> src(prepare_video_src(GetParam()));
+    ASSERT_NE(src, nullptr) << "video source create failed!";
+    ASSERT_EQ(src->open_source(start_pos_, frames_to_test_), EB_ErrorNone);
+
+    const size_t count = configs.size();
+    std::vector<EbComponentType *> handles(count, nullptr);
+    std::vector<std::unique_ptr<RefDecoder>> decoders(count);
+    std::vector<bool> eos(count, false);
+    outputs.assign(count, LadderOutput());
+
+    // The handles are created one after the other, then run together
+    for (size_t r = 0; r < count; r++) {
+        EbSvtAv1EncConfiguration params;
+        ASSERT_EQ(eb_init_handle(&handles[r], nullptr, &params), EB_ErrorNone);
+        ASSERT_NE(handles[r], nullptr) << "eb_init_handle return null handle.";
+        params = configs[r];
+        params.encoder_color_format = EB_YUV420;
+        params.recon_enabled = 0;
+        params.tile_columns = 0;
+        params.tile_rows = 0;
+        ASSERT_EQ(eb_svt_enc_set_parameter(handles[r], &params), EB_ErrorNone);
+        ASSERT_EQ(eb_init_encoder(handles[r]), EB_ErrorNone);
+        decoders[r].reset(create_reference_decoder());
+        ASSERT_NE(decoders[r], nullptr) << "can not create reference decoder!!";
+        outputs[r].decoded_frames = 0;
+        outputs[r].byte_count = 0;
+    }
+    for (size_t r = 1; r < count; r++) {
+        ASSERT_EQ(eb_svt_enc_attach_ladder(handles[r], handles[0]),
+                  EB_ErrorNone)
+            << "eb_svt_enc_attach_ladder failed for rendition " << r;
+    }
+
+    EbBufferHeaderType input;
+    memset(&input, 0, sizeof(input));
+    input.size = sizeof(input);
+    input.pic_type = EB_AV1_INVALID_PICTURE;
+    for (uint32_t i = 0; i <= src->get_frame_count(); i++) {
+        if (i < src->get_frame_count()) {
+            EbSvtIOFormat *frame = src->get_next_frame();
+            ASSERT_NE(frame, nullptr) << "can not read frame " << i;
+            input.p_buffer = (uint8_t *)frame;
+            input.n_filled_len = src->get_frame_size();
+            input.flags = 0;
+            input.pts = i;
+        } else {
+            input.p_buffer = nullptr;
+            input.n_filled_len = 0;
+            input.flags = EB_BUFFERFLAG_EOS;
+        }
+        // The leader gets each frame first, the renditions wait for its
+        // scene change decisions
+        for (size_t r = 0; r < count; r++) {
+            ASSERT_EQ(eb_svt_enc_send_picture(handles[r], &input),
+                      EB_ErrorNone)
+                << "eb_svt_enc_send_picture error at: " << i;
+        }
+
+        const uint8_t pic_send_done = (input.flags & EB_BUFFERFLAG_EOS) ? 1 : 0;
+        for (size_t r = 0; r < count; r++) {
+            while (!eos[r]) {
+                EbBufferHeaderType *out = nullptr;
+                const EbErrorType ret =
+                    eb_svt_get_packet(handles[r], &out, pic_send_done);
+                ASSERT_NE(ret, EB_ErrorMax) << "Error while encoding";
+                if (ret == EB_NoErrorEmptyQueue || out == nullptr)
+                    break;
+                if (out->n_filled_len) {
+                    if (out->pic_type == EB_AV1_KEY_PICTURE)
+                        outputs[r].key_frames.push_back(out->pts);
+                    outputs[r].byte_count += out->n_filled_len;
+
+                    // A packet showing an existing frame is decoded as two
+                    // temporal units, as in process_compress_data()
+                    uint32_t part_sizes[2] = {out->n_filled_len, 0};
+                    if (out->flags & EB_BUFFERFLAG_SHOW_EXT) {
+                        part_sizes[1] = OBU_FRAME_HEADER_SIZE + TD_SIZE;
+                        part_sizes[0] -= part_sizes[1];
+                    }
+                    const uint8_t *part = out->p_buffer;
+                    for (int p = 0; p < 2 && part_sizes[p]; p++) {
+                        ASSERT_EQ(decoders[r]->process_data(part, part_sizes[p]),
+                                  RefDecoder::REF_CODEC_OK);
+                        part += part_sizes[p];
+                        VideoFrame frame;
+                        memset(&frame, 0, sizeof(frame));
+                        while (decoders[r]->get_frame(frame) ==
+                               RefDecoder::REF_CODEC_OK)
+                            outputs[r].decoded_frames++;
+                    }
+                }
+                eos[r] = (out->flags & EB_BUFFERFLAG_EOS) != 0;
+                eb_svt_release_out_buffer(&out);
+            }
+        }
+    }
+    for (size_t r = 0; r < count; r++)
+        EXPECT_TRUE(eos[r]) << "encoder " << r << " did not output the end of stream";
+
+    // The leader is deinitialized last
+    for (size_t r = count; r-- > 0;) {
+        EXPECT_EQ(eb_deinit_encoder(handles[r]), EB_ErrorNone);
+        EXPECT_EQ(eb_deinit_handle(handles[r]), EB_ErrorNone);
+    }
+    src->close_source();
+}
+
+void SvtAv1E2ETestFramework::encode_and_decode(
+    const EbSvtAv1EncConfiguration &config, DecodedOutput &output) {
+    std::unique_ptr<VideoSource> src(prepare_video_src(GetParam()));
+    ASSERT_NE(src, nullptr) << "video source create failed!";
+    ASSERT_EQ(src->open_source(start_pos_, frames_to_test_), EB_ErrorNone);
+    std::unique_ptr<RefDecoder> decoder(create_reference_decoder());
+    ASSERT_NE(decoder, nullptr) << "can not create reference decoder!!";
+
+    EbComponentType *handle = nullptr;
+    EbSvtAv1EncConfiguration params;
+    ASSERT_EQ(eb_init_handle(&handle, nullptr, &params), EB_ErrorNone);
+    ASSERT_NE(handle, nullptr) << "eb_init_handle return null handle.";
+    params = config;
+    params.encoder_color_format = EB_YUV420;
+    params.recon_enabled = 0;
+    ASSERT_EQ(eb_svt_enc_set_parameter(handle, &params), EB_ErrorNone);
+    ASSERT_EQ(eb_init_encoder(handle), EB_ErrorNone);
+
+    output.frames.clear();
+    output.packet_count = 0;
+    output.picture_count = 0;
+    std::vector<uint8_t> picture;
+    EbBufferHeaderType input;
+    memset(&input, 0, sizeof(input));
+    input.size = sizeof(input);
+    input.pic_type = EB_AV1_INVALID_PICTURE;
+    bool eos = false;
+    for (uint32_t i = 0; i <= src->get_frame_count(); i++) {
+        if (i < src->get_frame_count()) {
+            EbSvtIOFormat *frame = src->get_next_frame();
+            ASSERT_NE(frame, nullptr) << "can not read frame " << i;
+            input.p_buffer = (uint8_t *)frame;
+            input.n_filled_len = src->get_frame_size();
+            input.flags = 0;
+            input.pts = i;
+        } else {
+            input.p_buffer = nullptr;
+            input.n_filled_len = 0;
+            input.flags = EB_BUFFERFLAG_EOS;
+        }
+        ASSERT_EQ(eb_svt_enc_send_picture(handle, &input), EB_ErrorNone)
+            << "eb_svt_enc_send_picture error at: " << i;
+
+        const uint8_t pic_send_done = (input.flags & EB_BUFFERFLAG_EOS) ? 1 : 0;
+        while (!eos) {
+            EbBufferHeaderType *out = nullptr;
+            const EbErrorType ret =
+                eb_svt_get_packet(handle, &out, pic_send_done);
+            ASSERT_NE(ret, EB_ErrorMax) << "Error while encoding";
+            if (ret == EB_NoErrorEmptyQueue || out == nullptr)
+                break;
+            eos = (out->flags & EB_BUFFERFLAG_EOS) != 0;
+            if (out->n_filled_len == 0) {
+                eb_svt_release_out_buffer(&out);
+                continue;
+            }
+            output.packet_count++;
+            picture.insert(picture.end(),
+                           out->p_buffer,
+                           out->p_buffer + out->n_filled_len);
+            const uint32_t flags = out->flags;
+            eb_svt_release_out_buffer(&out);
+            if (config.tile_group_output &&
+                !(flags & EB_BUFFERFLAG_LAST_FRAGMENT))
+                continue;
+            output.picture_count++;
+
+            // A picture showing an existing frame is decoded as two temporal
+            // units, as in process_compress_data(), the frame shown is in the
+            // packet that completes the picture
+            uint32_t part_sizes[2] = {(uint32_t)picture.size(), 0};
+            if (flags & EB_BUFFERFLAG_SHOW_EXT) {
+                part_sizes[1] = OBU_FRAME_HEADER_SIZE + TD_SIZE;
+                part_sizes[0] -= part_sizes[1];
+            }
+            const uint8_t *part = picture.data();
+            for (int p = 0; p < 2 && part_sizes[p]; p++) {
+                ASSERT_EQ(decoder->process_data(part, part_sizes[p]),
+                          RefDecoder::REF_CODEC_OK)
+                    << "can not decode picture " << output.picture_count - 1;
+                part += part_sizes[p];
+                VideoFrame frame;
+                memset(&frame, 0, sizeof(frame));
+                while (decoder->get_frame(frame) == RefDecoder::REF_CODEC_OK) {
+                    // 4:2:0, as set above
+                    const uint32_t sample_size =
+                        frame.bits_per_sample > 8 ? 2 : 1;
+                    std::vector<uint8_t> planes;
+                    for (int plane = 0; plane < 3; plane++) {
+                        const uint32_t shift = plane ? 1 : 0;
+                        const uint32_t width =
+                            ((frame.disp_width + shift) >> shift) * sample_size;
+                        const uint32_t height =
+                            (frame.disp_height + shift) >> shift;
+                        for (uint32_t y = 0; y < height; y++) {
+                            const uint8_t *row =
+                                frame.planes[plane] + y * frame.stride[plane];
+                            planes.insert(planes.end(), row, row + width);
+                        }
+                    }
+                    output.frames.push_back(planes);
+                }
+            }
+            picture.clear();
+        }
+    }
+    EXPECT_TRUE(eos) << "the encoder did not output the end of stream";
+    EXPECT_TRUE(picture.empty()) << "the last picture was not completed";
+
+    EXPECT_EQ(eb_deinit_encoder(handle), EB_ErrorNone);
+    EXPECT_EQ(eb_deinit_handle(handle), EB_ErrorNone);
+    src->close_source();
+}
+
 SvtAv1E2ETestFramework::IvfFile::IvfFile(std::string path) {
     FOPEN(file, path.c_str(), "wb");
     byte_count_since_ivf = 0;
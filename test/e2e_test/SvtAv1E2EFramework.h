@@ -15,6 +15,7 @@
 #ifndef _SVT_AV1_E2E_FRAMEWORK_H_
 #define _SVT_AV1_E2E_FRAMEWORK_H_
 
+#include <vector>
 #include "E2eTestVectors.h"
 #include "ReconSink.h"
 #include "PerformanceCollect.h"
@@ -126,6 +127,63 @@ class SvtAv1E2ETestFramework : public SvtAv1E2ETestBase {
      * @param is_eos  flag of recon frames is eos
      * into decoder */
     virtual void get_recon_frame(bool &is_eos);
+    /** change the encoder settings before a frame is sent, does nothing
+     * unless overridden
+     * @param frame_index  index of the frame to send, from 0 */
+    virtual void update_encoder(const uint32_t frame_index) {
+        (void)frame_index;
+    }
+    /** check a video frame output by the reference decoder, does nothing
+     * unless overridden
+     * @param frame  video frame from reference decoder */
+    virtual void check_decoded_frame(const VideoFrame &frame) {
+        (void)frame;
+    }
+    /** encode the test frames with a separate encoder, for the tests comparing
+     * the output of two encoder settings
+     * @param config  encoder settings, usually av1enc_ctx_.enc_params
+     * changed by the test
+     * @param stream  the compressed data of every output packet, in order,
+     * or the statistics of a first pass (pass 1)
+     * @param pass_stats  the statistics given to a second pass (pass 2) */
+    void encode_to_stream(const EbSvtAv1EncConfiguration &config,
+                          std::vector<uint8_t> &stream,
+                          const std::vector<uint8_t> *pass_stats = nullptr);
+    /** the frame encode_to_stream() sends next, the next frame of the
+     * source unless overridden
+     * @param src  source of the test frames */
+    virtual EbSvtIOFormat *get_stream_frame(VideoSource *src) {
+        return src->get_next_frame();
+    }
+    /** output of an encoder of a ladder, see encode_ladder() */
+    typedef struct LadderOutput {
+        std::vector<uint64_t> key_frames; /**< pts of the key frames */
+        uint32_t decoded_frames; /**< frames output by the reference decoder */
+        uint64_t byte_count;     /**< size of the compressed data */
+    } LadderOutput;
+    /** encode the test frames with a ladder of separate encoders, the first
+     * one leads and the others are attached to it as renditions
+     * (eb_svt_enc_attach_ladder), and decode the output of each one with its
+     * own reference decoder
+     * @param configs  encoder settings of the leader, then of the renditions
+     * @param outputs  the output of each encoder, in the order of configs */
+    void encode_ladder(const std::vector<EbSvtAv1EncConfiguration> &configs,
+                       std::vector<LadderOutput> &outputs);
+    /** output of encode_and_decode() */
+    typedef struct DecodedOutput {
+        /** the planes of each decoded frame, in display order */
+        std::vector<std::vector<uint8_t>> frames;
+        uint32_t packet_count;  /**< packets with compressed data */
+        uint32_t picture_count; /**< pictures the packets were joined to */
+    } DecodedOutput;
+    /** encode the test frames with a separate encoder, join the packets of
+     * each picture, several with tile_group_output, and decode the pictures
+     * with a reference decoder
+     * @param config  encoder settings, usually av1enc_ctx_.enc_params
+     * changed by the test
+     * @param output  the decoded frames and the packet counts */
+    void encode_and_decode(const EbSvtAv1EncConfiguration &config,
+                           DecodedOutput &output);
 
   protected:
     ReconSink *recon_sink_; /**< reconstruction frame collection */
@@ -12,6 +12,8 @@
  *
  ******************************************************************************/
 
+#include <algorithm>
+#include <string.h>
 #include "EbSvtAv1Enc.h"
 #include "gtest/gtest.h"
 #include "SvtAv1E2EFramework.h"
@@ -212,3 +214,422 @@ TEST_P(SvtAv1E2EConformanceTest, run_conformance_test) {
 INSTANTIATE_TEST_CASE_P(
     SVT_AV1, SvtAv1E2EConformanceTest,
     ::testing::ValuesIn(generate_vector_from_config("comformance_test.cfg")));
+
+/**
+ * @brief SVT-AV1 encoder E2E test with changing the encoder settings in the
+ * middle of the stream
+ *
+ * Test strategy:
+ * Setup SVT-AV1 encoder with default parameter and a fixed intra period, and
+ * encode the input YUV data frames. Halfway, call eb_svt_enc_reconfigure() to
+ * change the target bit rate (with rate control) or the intra period (without)
+ * along with a smaller resolution, and decode the output with the reference
+ * decoder
+ *
+ * Expect result:
+ * No error from encoding progress, the reference decoder decodes every frame,
+ * with the configured size before the change and the new one after it
+ *
+ * Test coverage:
+ * Smoking test vectors
+ */
+class SvtAv1E2EReconfigureTest : public SvtAv1E2ETestFramework {
+  protected:
+    SvtAv1E2EReconfigureTest() {
+        change_index_ = 0;
+        decoded_count_ = 0;
+        new_width_ = 0;
+        new_height_ = 0;
+        new_bit_rate_ = 0;
+        new_intra_period_ = 0;
+    }
+
+    /** initialization for test */
+    void init_test() override {
+        // create reference decoder
+        refer_dec_ = create_reference_decoder();
+        ASSERT_NE(refer_dec_, nullptr) << "can not create reference decoder!!";
+
+        av1enc_ctx_.enc_params.intra_period_length = 31;
+        SvtAv1E2ETestFramework::init_test();
+
+        // Half the size, multiple of 8 and at least 64
+        new_width_ =
+            std::max(64u, (av1enc_ctx_.enc_params.source_width / 2) & ~7u);
+        new_height_ =
+            std::max(64u, (av1enc_ctx_.enc_params.source_height / 2) & ~7u);
+        change_index_ = video_src_->get_frame_count() / 2;
+    }
+
+    /** reconfigure the encoder before the frame at change_index_ */
+    void update_encoder(const uint32_t frame_index) override {
+        if (frame_index != change_index_)
+            return;
+        EbSvtAv1EncConfiguration config = av1enc_ctx_.enc_params;
+        config.source_width = new_width_;
+        config.source_height = new_height_;
+        if (new_bit_rate_)
+            config.target_bit_rate = new_bit_rate_;
+        if (new_intra_period_)
+            config.intra_period_length = new_intra_period_;
+        ASSERT_EQ(EB_ErrorNone,
+                  eb_svt_enc_reconfigure(av1enc_ctx_.enc_handle, &config))
+            << "eb_svt_enc_reconfigure failed at " << frame_index;
+    }
+
+    /** the frames are output in display order, the size changes with the
+     * frame at change_index_ */
+    void check_decoded_frame(const VideoFrame &frame) override {
+        if (decoded_count_ < change_index_) {
+            EXPECT_EQ(av1enc_ctx_.enc_params.source_width, frame.disp_width);
+            EXPECT_EQ(av1enc_ctx_.enc_params.source_height, frame.disp_height);
+        } else {
+            EXPECT_EQ(new_width_, frame.disp_width);
+            EXPECT_EQ(new_height_, frame.disp_height);
+        }
+        decoded_count_++;
+    }
+
+    void run_reconfigure_test() {
+        if (new_width_ >= av1enc_ctx_.enc_params.source_width &&
+            new_height_ >= av1enc_ctx_.enc_params.source_height) {
+            printf("Skipping: the vector is too small to be downsized\n");
+            return;
+        }
+        run_encode_process();
+        EXPECT_EQ(video_src_->get_frame_count(), decoded_count_)
+            << "not every frame was decoded";
+    }
+
+  protected:
+    uint32_t change_index_;     /**< index of the first frame reconfigured */
+    uint32_t decoded_count_;    /**< frames output by the reference decoder */
+    uint32_t new_width_;        /**< source_width after the change */
+    uint32_t new_height_;       /**< source_height after the change */
+    uint32_t new_bit_rate_;     /**< target_bit_rate after the change, or 0 */
+    int32_t new_intra_period_;  /**< intra_period_length after it, or 0 */
+};
+
+TEST_P(SvtAv1E2EReconfigureTest, run_bit_rate_and_size_change_test) {
+    av1enc_ctx_.enc_params.rate_control_mode = 1;
+    av1enc_ctx_.enc_params.target_bit_rate = 1000000;
+    new_bit_rate_ = 500000;
+    init_test();
+    run_reconfigure_test();
+    close_test();
+}
+
+TEST_P(SvtAv1E2EReconfigureTest, run_intra_period_and_size_change_test) {
+    new_intra_period_ = 7;
+    init_test();
+    run_reconfigure_test();
+    close_test();
+}
+
+INSTANTIATE_TEST_CASE_P(
+    SVT_AV1, SvtAv1E2EReconfigureTest,
+    ::testing::ValuesIn(generate_vector_from_config("smoking_test.cfg")));
+
+/**
+ * @brief SVT-AV1 encoder E2E test of the bitstream independence from the
+ * kernel threads
+ *
+ * Test strategy:
+ * For each configuration of determinism_features, encode the input YUV data
+ * frames twice: with the default threads, where the work of a picture is
+ * shared by several threads of a stage (tiles, filter rows, analysis
+ * segments, denoiser rows), and with one thread per stage, where each stage
+ * handles its work in order. The encoder has no single threaded path, the
+ * stages still run concurrently in both runs.
+ *
+ * Expect result:
+ * No error from encoding progress and, for every configuration, the two
+ * bitstreams are identical, and identical to the default configuration when
+ * the feature must not change it
+ *
+ * Test coverage:
+ * Smoking test vectors, the stacked frames in 8-bit 4:2:0 only
+ */
+namespace {
+
+/** a configuration whose bitstream must not depend on the threads */
+typedef struct DeterminismFeature {
+    const char *name;
+    void (*setup)(EbSvtAv1EncConfiguration &config);
+    uint32_t stack_height; /**< frames stacked up to this height, 0 for none */
+    bool matches_default;  /**< same bitstream as the default configuration */
+} DeterminismFeature;
+
+const DeterminismFeature determinism_features[] = {
+    // The tiles of a picture entropy coded by several threads at once
+    {"2x2 tiles",
+     [](EbSvtAv1EncConfiguration &config) {
+         config.tile_columns = 1;
+         config.tile_rows = 1;
+     },
+     0,
+     false},
+    // The statistics of a first pass
+    {"first pass",
+     [](EbSvtAv1EncConfiguration &config) { config.pass = 1; },
+     0,
+     false},
+    // The SB rows reach the CDEF search in any order, the default preset
+    // deblocks in Encode Decode already
+    {"filter row pipeline",
+     [](EbSvtAv1EncConfiguration &config) {
+         config.filter_row_pipeline = EB_TRUE;
+     },
+     0,
+     true},
+    // The candidates are limited to the reference rows waited for, whatever
+    // their progress
+    {"inter picture wavefront",
+     [](EbSvtAv1EncConfiguration &config) {
+         config.inter_picture_wavefront = EB_TRUE;
+     },
+     0,
+     false},
+    // Picture Analysis is split into segments from 2048 rows
+    {"Picture Analysis segments",
+     [](EbSvtAv1EncConfiguration &config) { (void)config; },
+     2048,
+     false},
+    // The block rows of the denoiser and the noise model
+    {"film grain denoising",
+     [](EbSvtAv1EncConfiguration &config) {
+         config.film_grain_denoise_strength = 10;
+     },
+     0,
+     false},
+};
+
+}  // namespace
+
+class SvtAv1E2EDeterminismTest : public SvtAv1E2ETestFramework {
+  protected:
+    SvtAv1E2EDeterminismTest() {
+        repeat_ = 1;
+        memset(&stacked_, 0, sizeof(stacked_));
+    }
+
+    /** the frame of the source repeated repeat_ times from top to bottom */
+    EbSvtIOFormat *get_stream_frame(VideoSource *src) override {
+        EbSvtIOFormat *frame = src->get_next_frame();
+        if (frame == nullptr || repeat_ == 1)
+            return frame;
+        const uint32_t height = src->get_height_with_padding();
+        stack_plane(luma_, frame->luma, frame->y_stride * height);
+        stack_plane(cb_, frame->cb, frame->cb_stride * (height >> 1));
+        stack_plane(cr_, frame->cr, frame->cr_stride * (height >> 1));
+        stacked_ = *frame;
+        stacked_.luma = luma_.data();
+        stacked_.cb = cb_.data();
+        stacked_.cr = cr_.data();
+        stacked_.height = height * repeat_;
+        return &stacked_;
+    }
+
+    void stack_plane(std::vector<uint8_t> &dst, const uint8_t *src,
+                     size_t size) {
+        dst.resize(size * repeat_);
+        for (uint32_t i = 0; i < repeat_; i++)
+            memcpy(&dst[size * i], src, size);
+    }
+
+  protected:
+    uint32_t repeat_;          /**< copies of a frame in a stacked frame */
+    EbSvtIOFormat stacked_;    /**< frame sent by encode_to_stream() */
+    std::vector<uint8_t> luma_, cb_, cr_; /**< planes of stacked_ */
+};
+
+TEST_P(SvtAv1E2EDeterminismTest, run_threads_match_one_thread_per_stage_test) {
+    std::vector<uint8_t> reference;
+    ASSERT_NO_FATAL_FAILURE(
+        encode_to_stream(av1enc_ctx_.enc_params, reference));
+    ASSERT_FALSE(reference.empty()) << "no compressed data";
+
+    for (const DeterminismFeature &feature : determinism_features) {
+        SCOPED_TRACE(feature.name);
+        EbSvtAv1EncConfiguration config = av1enc_ctx_.enc_params;
+        feature.setup(config);
+        repeat_ = 1;
+        if (feature.stack_height) {
+            if (video_src_->get_bit_depth() != 8 ||
+                video_src_->get_image_format() != IMG_FMT_420) {
+                printf("Skipping %s: the frames are stacked in 8-bit 4:2:0 "
+                       "only\n",
+                       feature.name);
+                continue;
+            }
+            repeat_ = (feature.stack_height + config.source_height - 1) /
+                      config.source_height;
+            config.source_height *= repeat_;
+        }
+        std::vector<uint8_t> threaded;
+        ASSERT_NO_FATAL_FAILURE(encode_to_stream(config, threaded));
+
+        config.unified_thread_pool = EB_TRUE;
+        config.logical_processors = 1;
+        std::vector<uint8_t> one_per_stage;
+        ASSERT_NO_FATAL_FAILURE(encode_to_stream(config, one_per_stage));
+
+        ASSERT_FALSE(threaded.empty()) << "no output for " << feature.name;
+        EXPECT_TRUE(threaded == one_per_stage)
+            << "the " << feature.name << " output depends on the threads, "
+            << threaded.size() << " bytes vs " << one_per_stage.size();
+        if (feature.matches_default) {
+            EXPECT_TRUE(threaded == reference)
+                << "the " << feature.name
+                << " output differs from the default configuration, "
+                << threaded.size() << " bytes vs " << reference.size();
+        }
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(
+    SVT_AV1, SvtAv1E2EDeterminismTest,
+    ::testing::ValuesIn(generate_vector_from_config("smoking_test.cfg")));
+
+/**
+ * @brief SVT-AV1 encoder E2E test of the second pass of a two-pass encoding
+ *
+ * Test strategy:
+ * Run the first pass of the input YUV data frames, then run the second pass
+ * twice with its statistics, at a target bit rate and with one thread per
+ * stage
+ *
+ * Expect result:
+ * No error from encoding progress and the second passes output the same
+ * bitstream
+ *
+ * Test coverage:
+ * Smoking test vectors
+ */
+class SvtAv1E2ETwoPassTest : public SvtAv1E2ETestFramework {};
+
+TEST_P(SvtAv1E2ETwoPassTest, run_two_pass_repeatable_test) {
+    EbSvtAv1EncConfiguration config = av1enc_ctx_.enc_params;
+    config.pass = 1;
+    std::vector<uint8_t> stats;
+    ASSERT_NO_FATAL_FAILURE(encode_to_stream(config, stats));
+    ASSERT_FALSE(stats.empty()) << "no first pass statistics";
+
+    // The rate control feedback follows the thread timing, the second
+    // passes run on one thread per stage
+    config.unified_thread_pool = EB_TRUE;
+    config.logical_processors = 1;
+    config.pass = 2;
+    config.rate_control_mode = 2;
+    config.target_bit_rate = 1000000;
+    std::vector<uint8_t> first, second;
+    ASSERT_NO_FATAL_FAILURE(encode_to_stream(config, first, &stats));
+    ASSERT_NO_FATAL_FAILURE(encode_to_stream(config, second, &stats));
+
+    ASSERT_FALSE(first.empty()) << "no compressed data";
+    EXPECT_TRUE(first == second)
+        << "the second passes of the same statistics differ, " << first.size()
+        << " bytes vs " << second.size();
+}
+
+INSTANTIATE_TEST_CASE_P(
+    SVT_AV1, SvtAv1E2ETwoPassTest,
+    ::testing::ValuesIn(generate_vector_from_config("smoking_test.cfg")));
+
+/**
+ * @brief SVT-AV1 encoder E2E test of an ABR ladder
+ *
+ * Test strategy:
+ * Setup a leader encoder with scene change detection and two renditions at
+ * higher QPs attached to it, send every input YUV frame to the three of them
+ * and decode each output with its own reference decoder
+ *
+ * Expect result:
+ * No error from encoding progress, every output decodes to all the frames,
+ * the renditions code fewer bytes than the leader and every encoder has its
+ * key frames at the same pictures, the scene changes of the leader
+ *
+ * Test coverage:
+ * Smoking test vectors
+ */
+class SvtAv1E2ELadderTest : public SvtAv1E2ETestFramework {};
+
+TEST_P(SvtAv1E2ELadderTest, run_ladder_shares_key_frames_test) {
+    EbSvtAv1EncConfiguration leader = av1enc_ctx_.enc_params;
+    leader.scene_change_detection = 1;
+    leader.qp = 30;
+    std::vector<EbSvtAv1EncConfiguration> configs(3, leader);
+    configs[1].scene_change_detection = 0;
+    configs[1].qp = 40;
+    configs[2].scene_change_detection = 0;
+    configs[2].qp = 50;
+
+    std::vector<LadderOutput> outputs;
+    ASSERT_NO_FATAL_FAILURE(encode_ladder(configs, outputs));
+
+    for (size_t r = 0; r < outputs.size(); r++) {
+        EXPECT_EQ(video_src_->get_frame_count(), outputs[r].decoded_frames)
+            << "not every frame of encoder " << r << " was decoded";
+        ASSERT_FALSE(outputs[r].key_frames.empty())
+            << "encoder " << r << " output no key frame";
+        EXPECT_TRUE(outputs[r].key_frames == outputs[0].key_frames)
+            << "rendition " << r << " does not follow the leader key frames";
+        if (r) {
+            EXPECT_LT(outputs[r].byte_count, outputs[r - 1].byte_count)
+                << "rendition " << r << " at a higher QP is not smaller";
+        }
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(
+    SVT_AV1, SvtAv1E2ELadderTest,
+    ::testing::ValuesIn(generate_vector_from_config("smoking_test.cfg")));
+
+/**
+ * @brief SVT-AV1 encoder E2E test of the tile groups output as soon as their
+ * tiles are entropy coded (tile_group_output)
+ *
+ * Test strategy:
+ * Encode the input YUV data frames with 2x2 tiles, with and without tile
+ * group output. Join the packets of each picture, up to the one flagged
+ * EB_BUFFERFLAG_LAST_FRAGMENT with tile group output, and decode both
+ * outputs with the reference decoder
+ *
+ * Expect result:
+ * No error from encoding or decoding progress, every packet belongs to a
+ * picture completed by a flagged packet, and the fragmented output decodes to
+ * the same frames as the output of one packet per picture: the tile groups
+ * only change how the tiles are packetized
+ *
+ * Test coverage:
+ * Smoking test vectors
+ */
+class SvtAv1E2ETileGroupTest : public SvtAv1E2ETestFramework {};
+
+TEST_P(SvtAv1E2ETileGroupTest, run_tile_groups_match_frames_test) {
+    EbSvtAv1EncConfiguration config = av1enc_ctx_.enc_params;
+    config.tile_columns = 1;
+    config.tile_rows = 1;
+    DecodedOutput frames;
+    ASSERT_NO_FATAL_FAILURE(encode_and_decode(config, frames));
+
+    config.tile_group_output = EB_TRUE;
+    DecodedOutput tile_groups;
+    ASSERT_NO_FATAL_FAILURE(encode_and_decode(config, tile_groups));
+
+    ASSERT_FALSE(frames.frames.empty()) << "no decoded frame";
+    EXPECT_EQ(frames.packet_count, frames.picture_count);
+    EXPECT_EQ(tile_groups.picture_count, frames.picture_count)
+        << "the tile groups do not complete every picture";
+    EXPECT_GE(tile_groups.packet_count, tile_groups.picture_count);
+    ASSERT_EQ(tile_groups.frames.size(), frames.frames.size())
+        << "the tile groups do not decode to every frame";
+    for (size_t i = 0; i < frames.frames.size(); i++) {
+        EXPECT_TRUE(tile_groups.frames[i] == frames.frames[i])
+            << "frame " << i << " decoded from the tile groups differs";
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(
+    SVT_AV1, SvtAv1E2ETileGroupTest,
+    ::testing::ValuesIn(generate_vector_from_config("smoking_test.cfg")));
@@ -0,0 +1,24 @@
+/*
+ * Copyright(c) 2019 Netflix, Inc.
+ * SPDX - License - Identifier: BSD - 2 - Clause - Patent
+ */
+
+/******************************************************************************
+ * @file LockedFifoMemoryMap.c
+ *
+ * @brief Memory map globals of the library for the locked FIFO tests, which
+ * do not link the encoder handle that defines them.
+ *
+ ******************************************************************************/
+#include "EbDefinitions.h"
+
+EbMemoryMapEntry *memory_map;
+uint32_t *memory_map_index;
+uint64_t *total_lib_memory;
+struct EbNumaPlacement *numa_placement;
+
+uint32_t lib_malloc_count = 0;
+uint32_t lib_thread_count = 0;
+uint32_t lib_semaphore_count = 0;
+uint32_t lib_mutex_count = 0;
+uint32_t memory_map_category = EB_MEMORY_OTHER;